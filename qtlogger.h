@@ -17,6 +17,7 @@
 // #define QTLOGGER_ANDROIDLOG
 // #define QTLOGGER_SYSLOG
 // #define QTLOGGER_JOURNAL
+// #define QTLOGGER_SQL
 
 #define QTLOGGER_DECL_SPEC inline
 
@@ -65,6 +66,35 @@
 #    include <QThread>
 #endif
 
+// threadinfo.h
+
+#include <QString>
+
+namespace QtLogger {
+
+namespace ThreadInfo {
+
+// System id of the calling thread: gettid() on Linux and Android, pthread_threadid_np() on macOS
+// and iOS, GetCurrentThreadId() on Windows, the native thread handle elsewhere. Resolved once per
+// thread and then served from thread local storage, so capturing it with every message costs a
+// single load.
+QTLOGGER_EXPORT quint64 currentId();
+
+// Name of the thread with the system id, looked up when a message is formatted: the object name
+// of its QThread, or the name of the thread in the system when it got its id. A new object name
+// is taken from QThread::objectNameChanged; a thread renamed in the system only, e.g. by
+// pthread_setname_np(), calls refreshCurrent(). Empty for threads that never got their id.
+QTLOGGER_EXPORT QString name(quint64 id);
+
+// Resolves the name of the calling thread again, e.g. after it was renamed in the system
+QTLOGGER_EXPORT void refreshCurrent();
+
+} // namespace ThreadInfo
+
+} // namespace QtLogger
+
+// end threadinfo.h
+
 namespace QtLogger {
 
 class QTLOGGER_EXPORT LogMessage
@@ -79,6 +109,32 @@ public:
     {
     }
 
+    // Restores a message captured earlier, e.g. read back from a binary log. The context strings
+    // are copied, the steady time is derived from the given time, the thread metadata is empty.
+    LogMessage(QtMsgType type, const QMessageLogContext &context, const QString &message,
+               const QDateTime &time, quintptr qthreadptr = 0) noexcept
+        : m_file(context.file),
+          m_function(context.function),
+          m_category(context.category),
+          m_type(type),
+          m_context(m_file.constData(), context.line, m_function.constData(),
+                    m_category.constData()),
+          m_message(message),
+          m_time(time),
+          m_steadyTime(std::chrono::steady_clock::now()
+                       - std::chrono::milliseconds(time.msecsTo(QDateTime::currentDateTime())))
+#ifndef QTLOGGER_NO_THREAD
+          ,
+          m_qthreadptr(qthreadptr)
+#endif
+          ,
+          m_osThreadId(0)
+    {
+#ifdef QTLOGGER_NO_THREAD
+        Q_UNUSED(qthreadptr)
+#endif
+    }
+
     inline LogMessage(const LogMessage &lmsg) noexcept
         : m_file(lmsg.m_context.file),
           m_function(lmsg.m_context.function),
@@ -92,8 +148,12 @@ public:
 #ifndef QTLOGGER_NO_THREAD
           m_qthreadptr(lmsg.m_qthreadptr),
 #endif
+          m_osThreadId(lmsg.m_osThreadId),
           m_formattedMessage(lmsg.m_formattedMessage),
-          m_attributes(lmsg.m_attributes)
+          m_plainFormattedMessage(lmsg.m_plainFormattedMessage),
+          m_formattedData(lmsg.m_formattedData),
+          m_attributes(lmsg.m_attributes),
+          m_backtrace(lmsg.m_backtrace)
     {
     }
 
@@ -130,6 +190,10 @@ public:
 #endif
     }
 
+    // System id of the thread that logged the message and its current name, see ThreadInfo
+    inline quint64 osThreadId() const { return m_osThreadId; }
+    inline QString threadName() const { return ThreadInfo::name(m_osThreadId); }
+
     // Formatted message
 
     inline QString formattedMessage() const
@@ -139,9 +203,38 @@ public:
     inline void setFormattedMessage(const QString &formattedMessage)
     {
         m_formattedMessage = formattedMessage;
+        m_plainFormattedMessage.clear();
+        m_formattedData.clear();
     }
     inline bool isFormatted() const { return !m_formattedMessage.isNull(); }
 
+    // Formatters that style the message for a terminal, e.g. PrettyFormatter with colors, render it
+    // without the escape sequences in the same pass. Sinks that don't write to a terminal, like
+    // the file sinks, use the plain message.
+
+    inline QString plainFormattedMessage() const
+    {
+        return m_plainFormattedMessage.isNull() ? formattedMessage() : m_plainFormattedMessage;
+    }
+    inline void setFormattedMessage(const QString &formattedMessage,
+                                    const QString &plainFormattedMessage)
+    {
+        m_formattedMessage = formattedMessage;
+        m_plainFormattedMessage = plainFormattedMessage;
+        m_formattedData.clear();
+    }
+
+    // Output of a binary formatter, the last formatter replaces the formatted message or data
+
+    inline QByteArray formattedData() const { return m_formattedData; }
+    inline void setFormattedData(const QByteArray &formattedData)
+    {
+        m_formattedData = formattedData;
+        m_formattedMessage.clear();
+        m_plainFormattedMessage.clear();
+    }
+    inline bool hasFormattedData() const { return !m_formattedData.isNull(); }
+
     // Custom attributes
 
     inline QVariant attribute(const QString &name) const { return m_attributes.value(name); }
@@ -168,6 +261,13 @@ public:
     inline bool hasAttribute(const QString &name) const { return m_attributes.contains(name); }
     inline QVariantHash attributes() const { return m_attributes; }
 
+    // Raw return addresses captured by the logger, innermost call first, see backtrace.h. Kept
+    // apart from the attributes, they are only meaningful within the process that logged them.
+
+    inline QList<quintptr> backtrace() const { return m_backtrace; }
+    inline void setBacktrace(const QList<quintptr> &addresses) { m_backtrace = addresses; }
+    inline bool hasBacktrace() const { return !m_backtrace.isEmpty(); }
+
     // All message attributes including: type, line, file, function, category, message,
     // time, threadId and all custom attributes
     QVariantHash allAttributes() const;
@@ -187,11 +287,33 @@ private:
 #ifndef QTLOGGER_NO_THREAD
     const quintptr m_qthreadptr = reinterpret_cast<quintptr>(QThread::currentThreadId());
 #endif
+    const quint64 m_osThreadId = ThreadInfo::currentId();
 
     QString m_formattedMessage;
+    QString m_plainFormattedMessage;
+    QByteArray m_formattedData;
     QVariantHash m_attributes;
+    QList<quintptr> m_backtrace;
 };
 
+// Orders the message types by severity, from 0 for debug to 4 for fatal
+inline int qtMsgTypePriority(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return 0;
+    case QtInfoMsg:
+        return 1;
+    case QtWarningMsg:
+        return 2;
+    case QtCriticalMsg:
+        return 3;
+    case QtFatalMsg:
+        return 4;
+    }
+    return -1;
+}
+
 inline QString qtMsgTypeToString(QtMsgType type, const QString &a_default = QStringLiteral("debug"))
 {
     static const auto map = QHash<QtMsgType, QString> {
@@ -315,6 +437,120 @@ using AppInfoAttrsPtr = QSharedPointer<AppInfoAttrs>;
 
 // end appinfoattrs.h
 
+// backtraceattr.h
+
+#include <QSharedPointer>
+
+// backtrace.h
+
+#include <QList>
+#include <QString>
+
+/*
+ * Backtraces in two steps:
+ *
+ *   capture  - the raw return addresses of the calling thread, only unwinding the stack. The
+ *              logger attaches them to messages at or above the capture level before the message
+ *              leaves the thread that logged it.
+ *   resolve  - function and module of every address, looked up once and then served from a
+ *              process wide cache. Done by BacktraceAttr and SentryFormatter, which run in the
+ *              thread of the logger.
+ *
+ * Addresses are captured with backtrace() on glibc and macOS and CaptureStackBackTrace() on
+ * Windows, elsewhere backtraces are empty. Function names need exported symbols (-rdynamic on
+ * Linux), on Windows only the module is resolved.
+ */
+
+namespace QtLogger {
+
+namespace Backtrace {
+
+constexpr int DefaultDepth = 32;
+constexpr int MaxDepth = 256;
+constexpr int MaxCacheSize = 8192;
+
+struct Frame
+{
+    quintptr address = 0;
+    QString function;
+    QString module;
+    quintptr symbolAddress = 0;
+    quintptr moduleAddress = 0;
+};
+
+// Raw return addresses of the calling thread, without the frame of capture() itself and the
+// skipped ones
+QTLOGGER_EXPORT QList<quintptr> capture(int depth = DefaultDepth, int skip = 0);
+
+// Captures the addresses into LogMessage::backtrace() when capturing is enabled for its type and
+// it has none. Called by the logger in the thread that logged the message.
+QTLOGGER_EXPORT void attach(LogMessage &lmsg, int skip = 0);
+
+// Messages at or above the level get a backtrace; with several requests the lowest level and the
+// largest depth are used. The capture is process wide: every message logged at or above the level
+// unwinds the stack of its thread, so a request for QtDebugMsg makes all logging slower. Every
+// enableCapture() is undone by a releaseCapture() with the same arguments, disableCapture() drops
+// all requests.
+QTLOGGER_EXPORT void enableCapture(QtMsgType minLevel = QtCriticalMsg, int depth = DefaultDepth);
+QTLOGGER_EXPORT void releaseCapture(QtMsgType minLevel = QtCriticalMsg, int depth = DefaultDepth);
+QTLOGGER_EXPORT void disableCapture();
+QTLOGGER_EXPORT bool isCaptureEnabled(QtMsgType type);
+
+// Function and module of the address, cached
+QTLOGGER_EXPORT Frame resolve(quintptr address);
+QTLOGGER_EXPORT QList<Frame> resolve(const QList<quintptr> &addresses);
+
+// "function+0x1f (module)", or the address for unknown functions
+QTLOGGER_EXPORT QString formatFrame(const Frame &frame);
+
+QTLOGGER_EXPORT int cacheSize();
+QTLOGGER_EXPORT void clearCache();
+
+} // namespace Backtrace
+
+} // namespace QtLogger
+
+// end backtrace.h
+
+#include "../filters/levelfilter.h"
+#include "../logger_global.h"
+
+namespace QtLogger {
+
+// Symbolized backtrace of the messages at or above a level, one frame per line with the innermost
+// call first. The handler enables the capture in the logger while it exists (see backtrace.h):
+// the thread that logs the message only records the raw return addresses, they are resolved here,
+// in the thread of the logger, through a cache of address to symbol. Messages that reach the handler
+// without addresses, e.g. not logged through the logger, get no backtrace.
+class QTLOGGER_EXPORT BacktraceAttr : public AttrHandler
+{
+public:
+    explicit BacktraceAttr(QtMsgType minLevel = QtCriticalMsg,
+                           int depth = Backtrace::DefaultDepth,
+                           const QString &name = QStringLiteral("backtrace"));
+    ~BacktraceAttr() override;
+
+    QVariantHash attributes(const LogMessage &lmsg) override;
+
+    QtMsgType minLevel() const { return m_minLevel; }
+    int depth() const { return m_depth; }
+    QString name() const { return m_name; }
+
+private:
+    Q_DISABLE_COPY(BacktraceAttr)
+
+    QtMsgType m_minLevel;
+    int m_depth;
+    QString m_name;
+    LevelFilter m_levelFilter;
+};
+
+using BacktraceAttrPtr = QSharedPointer<BacktraceAttr>;
+
+} // namespace QtLogger
+
+// end backtraceattr.h
+
 // functionattrhandler.h
 
 #include <QSharedPointer>
@@ -340,8 +576,86 @@ using FunctionAttrHandlerPtr = QSharedPointer<FunctionAttrHandler>;
 
 // end functionattrhandler.h
 
+// messagetemplateattr.h
+
+#include <optional>
+
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+#include <QStringList>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#endif
+
+namespace QtLogger {
+
+// Online message template mining in the spirit of the Drain algorithm. Messages are split into
+// space separated tokens, routed by token count and first token to a small group of templates and
+// merged into the most similar one; tokens that differ become the <*> wildcard. The id of the
+// matched template is attached to the message, the variable tokens are its parameters.
+class QTLOGGER_EXPORT MessageTemplateAttr : public AttrHandler
+{
+public:
+    struct Template
+    {
+        int id = -1;
+        QString text;
+        quint64 count = 0;
+    };
+
+    static constexpr double DefaultSimilarityThreshold = 0.4;
+    static constexpr int DefaultMaxTemplates = 1000;
+    static constexpr int MaxTemplatesPerGroup = 100;
+
+    explicit MessageTemplateAttr(const QString &name = QStringLiteral("template_id"),
+                                 double similarityThreshold = DefaultSimilarityThreshold,
+                                 int maxTemplates = DefaultMaxTemplates);
+
+    QVariantHash attributes(const LogMessage &lmsg) override;
+
+    QString name() const { return m_name; }
+
+    // Snapshot of all templates with their message counts, ordered by id
+    QList<Template> templates() const;
+    QString templateText(int id) const;
+
+    static QString wildcard() { return QStringLiteral("<*>"); }
+
+    // Values of the wildcard tokens of the template in the message, or nothing if the message
+    // doesn't match the template
+    static std::optional<QStringList> parameters(const QString &templateText,
+                                                 const QString &message);
+    // Message with the wildcard tokens of the template replaced by the parameters
+    static QString applyParameters(const QString &templateText, const QStringList &parameters);
+
+private:
+    int match(const QStringList &tokens);
+
+    QString m_name;
+    double m_similarityThreshold;
+    int m_maxTemplates;
+
+    QList<QStringList> m_templates;
+    QList<quint64> m_counts;
+    // token count -> first token -> template ids
+    QHash<int, QHash<QString, QList<int>>> m_groups;
+
+#ifndef QTLOGGER_NO_THREAD
+    mutable QMutex m_mutex;
+#endif
+};
+
+using MessageTemplateAttrPtr = QSharedPointer<MessageTemplateAttr>;
+
+} // namespace QtLogger
+
+// end messagetemplateattr.h
+
 // seqnumberattr.h
 
+#include <QAtomicInt>
 #include <QSharedPointer>
 
 namespace QtLogger {
@@ -354,7 +668,7 @@ public:
 
 private:
     QString m_name;
-    int m_count = 0;
+    QAtomicInt m_count;
 };
 
 using SeqNumberAttrPtr = QSharedPointer<SeqNumberAttr>;
@@ -385,6 +699,216 @@ using SysInfoAttrsPtr = QSharedPointer<SysInfoAttrs>;
 } // namespace QtLogger
 // end sysinfoattrs.h
 
+// binarylog.h
+
+#include <optional>
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QScopedPointer>
+#include <QVariant>
+#include <QtEndian>
+
+#include <cstring>
+
+QT_FORWARD_DECLARE_CLASS(QIODevice)
+
+/*
+ * Binary log format (written by BinaryLogWriter for BinaryFileSink and LocalSocketSink):
+ *
+ *   file     := (header frame*)*
+ *   header   := 'H' "QTLB" <u8 version> <svarint base time, ms since epoch>
+ *               Starts every file and every session appended to a file. Resets the dictionaries
+ *               and the time base.
+ *   frame    := <u8 kind> <varint payload length> <payload>
+ *
+ *   'C' callsite := <varint id> <str file> <varint line> <str function> <str category>
+ *   'T' thread   := <varint id> <varint qthreadptr>
+ *   'R' record   := <svarint time delta, ms> <u8 type> <varint callsite id> <varint thread id>
+ *                   <str message> <varint attribute count> (<str name> <value>)*
+ *   'P' template := <varint id> <str text>
+ *                   Written again when the template of the id is generalized.
+ *   'M' templated record := like 'R', but with <varint template id> <varint param count> <str param>*
+ *                   instead of <str message>; see MessageTemplateAttr
+ *   'A' attributes := <varint count> (<str name> <value>)*
+ *                   Attributes of the session, added to every following record that doesn't have
+ *                   an attribute with the same name.
+ *
+ *   str      := <varint length> <UTF-8 bytes>
+ *   value    := <u8 tag> <payload>, see BinaryLog::ValueTag
+ *
+ * Varints are LEB128, signed varints are zigzag encoded. Callsite, thread and template dictionaries
+ * are per file, so every file can be decoded on its own.
+ *
+ * A frame whose payload doesn't decode to exactly its length, of an unknown kind or with a message
+ * type above QtInfoMsg is skipped. After an implausible length the reader continues at the next
+ * header.
+ */
+
+namespace QtLogger {
+
+namespace BinaryLog {
+
+constexpr char Magic[] = "QTLB";
+constexpr quint8 Version = 1;
+constexpr quint64 MaxFrameSize = 64 * 1024 * 1024;
+
+enum FrameKind : char {
+    HeaderFrame = 'H',
+    CallsiteFrame = 'C',
+    ThreadFrame = 'T',
+    RecordFrame = 'R',
+    TemplateFrame = 'P',
+    TemplatedRecordFrame = 'M',
+    AttributesFrame = 'A'
+};
+
+enum ValueTag : quint8 {
+    NullValue = 0,
+    BoolValue = 1,
+    IntValue = 2,
+    UIntValue = 3,
+    DoubleValue = 4,
+    StringValue = 5,
+    DateTimeValue = 6,
+    BytesValue = 7
+};
+
+inline void writeVarUInt(QByteArray &out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+inline void writeVarInt(QByteArray &out, qint64 value)
+{
+    writeVarUInt(out, (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63));
+}
+
+inline void writeBytes(QByteArray &out, const QByteArray &bytes)
+{
+    writeVarUInt(out, static_cast<quint64>(bytes.size()));
+    out.append(bytes);
+}
+
+inline void writeString(QByteArray &out, const QString &str)
+{
+    writeBytes(out, str.toUtf8());
+}
+
+inline void writeValue(QByteArray &out, const QVariant &value)
+{
+    if (!value.isValid()) {
+        out.append(static_cast<char>(NullValue));
+        return;
+    }
+
+    switch (value.userType()) {
+    case QMetaType::Bool:
+        out.append(static_cast<char>(BoolValue));
+        out.append(static_cast<char>(value.toBool() ? 1 : 0));
+        break;
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+    case QMetaType::Short:
+    case QMetaType::SChar:
+        out.append(static_cast<char>(IntValue));
+        writeVarInt(out, value.toLongLong());
+        break;
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+    case QMetaType::UShort:
+    case QMetaType::UChar:
+        out.append(static_cast<char>(UIntValue));
+        writeVarUInt(out, value.toULongLong());
+        break;
+    case QMetaType::Double:
+    case QMetaType::Float: {
+        out.append(static_cast<char>(DoubleValue));
+        const double d = value.toDouble();
+        quint64 bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        const auto le = qToLittleEndian(bits);
+        out.append(reinterpret_cast<const char *>(&le), sizeof(le));
+        break;
+    }
+    case QMetaType::QDateTime:
+        out.append(static_cast<char>(DateTimeValue));
+        writeVarInt(out, value.toDateTime().toMSecsSinceEpoch());
+        break;
+    case QMetaType::QByteArray:
+        out.append(static_cast<char>(BytesValue));
+        writeBytes(out, value.toByteArray());
+        break;
+    default:
+        out.append(static_cast<char>(StringValue));
+        writeString(out, value.toString());
+        break;
+    }
+}
+
+} // namespace BinaryLog
+
+// Encodes messages as binary log frames. The callsite, thread and template dictionaries are kept
+// between messages, so the output of all encode() calls since the last reset() is one session.
+class QTLOGGER_EXPORT BinaryLogWriter
+{
+public:
+    BinaryLogWriter();
+    ~BinaryLogWriter();
+
+    // Record frame of the message, preceded by the session header and dictionary frames as needed
+    QByteArray encode(const LogMessage &lmsg);
+
+    // The next message starts a new session, e.g. in a new file or on a new connection
+    void reset();
+
+    // Messages with an id of these templates are stored as the template id and the parameters
+    void setMessageTemplates(const MessageTemplateAttrPtr &messageTemplates);
+    MessageTemplateAttrPtr messageTemplates() const;
+
+    // Written once after the session header instead of with every message
+    void setSessionAttributes(const QVariantHash &attributes);
+    QVariantHash sessionAttributes() const;
+
+private:
+    class BinaryLogWriterPrivate;
+    QScopedPointer<BinaryLogWriterPrivate> d;
+    Q_DISABLE_COPY(BinaryLogWriter)
+};
+
+class QTLOGGER_EXPORT BinaryLogReader
+{
+public:
+    explicit BinaryLogReader(const QString &path);
+    explicit BinaryLogReader(QIODevice *device);
+    ~BinaryLogReader();
+
+    // False if the file can't be opened or doesn't start with a binary log header
+    bool isValid() const;
+    QString errorString() const;
+
+    // Next message of the log, or nothing at the end of the log
+    std::optional<LogMessage> next();
+
+    // Number of damaged frames and regions skipped so far
+    int damagedFrames() const;
+
+private:
+    class BinaryLogReaderPrivate;
+    QScopedPointer<BinaryLogReaderPrivate> d;
+    Q_DISABLE_COPY(BinaryLogReader)
+};
+
+} // namespace QtLogger
+
+// end binarylog.h
+
 // filter.h
 
 #include <QSharedPointer>
@@ -436,6 +960,10 @@ using CategoryFilterPtr = QSharedPointer<CategoryFilter>;
 
 // duplicatefilter.h
 
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#endif
+
 namespace QtLogger {
 
 class QTLOGGER_EXPORT DuplicateFilter : public Filter
@@ -445,6 +973,9 @@ public:
 
 private:
     QString m_lastMessage;
+#ifndef QTLOGGER_NO_THREAD
+    QMutex m_mutex;
+#endif
 };
 
 using DuplicateFilterPtr = QSharedPointer<DuplicateFilter>;
@@ -492,21 +1023,10 @@ public:
     explicit LevelFilter(QtMsgType minLevel = QtDebugMsg) : m_minLevel(minLevel) { }
 
     bool filter(const LogMessage &lmsg) override {
-        return priority(lmsg.type()) >= priority(m_minLevel);
+        return qtMsgTypePriority(lmsg.type()) >= qtMsgTypePriority(m_minLevel);
     }
 
 private:
-    static int priority(QtMsgType type) {
-        switch (type) {
-            case QtDebugMsg:    return 0;
-            case QtInfoMsg:     return 1;
-            case QtWarningMsg:  return 2;
-            case QtCriticalMsg: return 3;
-            case QtFatalMsg:    return 4;
-        }
-        return -1;
-    }
-
     QtMsgType m_minLevel;
 };
 
@@ -554,44 +1074,108 @@ public:
 
     virtual QString format(const LogMessage &lmsg) = 0;
 
+    // Formatters styling the message for a terminal also render it without the escape sequences
+    // into plainMessage, in the same pass; see LogMessage::plainFormattedMessage()
+    virtual QString formatStyled(const LogMessage &lmsg, QString &plainMessage)
+    {
+        Q_UNUSED(plainMessage)
+        return format(lmsg);
+    }
+
     HandlerType type() const override final { return HandlerType::Formatter; }
 
     bool process(LogMessage &lmsg) override final
     {
-        lmsg.setFormattedMessage(format(lmsg));
+        QString plainMessage;
+        const auto formattedMessage = formatStyled(lmsg, plainMessage);
+        lmsg.setFormattedMessage(formattedMessage, plainMessage);
         return true;
     }
 };
 
 using FormatterPtr = QSharedPointer<Formatter>;
 
+// Formatter producing bytes instead of text, e.g. CBOR. Sinks based on IODeviceSink write the
+// bytes as is.
+class QTLOGGER_EXPORT BinaryFormatter : public Handler
+{
+public:
+    virtual ~BinaryFormatter() = default;
+
+    virtual QByteArray format(const LogMessage &lmsg) = 0;
+
+    HandlerType type() const override final { return HandlerType::Formatter; }
+
+    bool process(LogMessage &lmsg) override final
+    {
+        lmsg.setFormattedData(format(lmsg));
+        return true;
+    }
+};
+
+using BinaryFormatterPtr = QSharedPointer<BinaryFormatter>;
+
 } // namespace QtLogger
 
 // end formatter.h
 
-// functionformatter.h
+// cborformatter.h
 
-#include <functional>
+#include <QtGlobal>
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
 
 #include <QSharedPointer>
 
 namespace QtLogger {
 
-class QTLOGGER_EXPORT FunctionFormatter : public Formatter
+using CborFormatterPtr = QSharedPointer<class CborFormatter>;
+
+// Streams the message fields and attributes as a CBOR map with the same keys as JsonFormatter.
+// Time is written as an epoch based date/time (tag 1), attributes keep their types.
+class QTLOGGER_EXPORT CborFormatter : public BinaryFormatter
 {
 public:
-    using Function = std::function<QString(const LogMessage &)>;
-
-    FunctionFormatter(const Function &func) : m_func(func) { }
+    CborFormatter() = default;
 
-    QString format(const LogMessage &lmsg) override { return m_func(lmsg); }
+    static CborFormatterPtr instance()
+    {
+        static const auto s_instance = CborFormatterPtr::create();
+        return s_instance;
+    }
 
-private:
-    Function m_func;
+    QByteArray format(const LogMessage &lmsg) override;
 };
 
-using FunctionFormatterPtr = QSharedPointer<FunctionFormatter>;
-
+} // namespace QtLogger
+
+#endif // QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+
+// end cborformatter.h
+
+// functionformatter.h
+
+#include <functional>
+
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+class QTLOGGER_EXPORT FunctionFormatter : public Formatter
+{
+public:
+    using Function = std::function<QString(const LogMessage &)>;
+
+    FunctionFormatter(const Function &func) : m_func(func) { }
+
+    QString format(const LogMessage &lmsg) override { return m_func(lmsg); }
+
+private:
+    Function m_func;
+};
+
+using FunctionFormatterPtr = QSharedPointer<FunctionFormatter>;
+
 } // namespace QtLogger
 
 // end functionformatter.h
@@ -625,6 +1209,41 @@ private:
 
 // end jsonformatter.h
 
+// logfmtformatter.h
+
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+using LogfmtFormatterPtr = QSharedPointer<class LogfmtFormatter>;
+
+// Formats messages as logfmt key=value pairs:
+//   time=2024-01-15T14:30:45.123 level=warning category=net msg="Connection timeout" seq_number=1
+// Values are quoted only if they are empty or contain spaces, '=', '"' or control characters,
+// control characters are escaped inside quotes, so each record stays on a single line. Attributes
+// named as the fields (time, level, category, msg and the callsite keys) get an attr_ prefix.
+class QTLOGGER_EXPORT LogfmtFormatter : public Formatter
+{
+public:
+    // With withCallsite, file=, line= and func= are added for messages with a file name
+    explicit LogfmtFormatter(bool withCallsite = false);
+
+    static LogfmtFormatterPtr instance()
+    {
+        static const auto s_instance = LogfmtFormatterPtr::create();
+        return s_instance;
+    }
+
+    QString format(const LogMessage &lmsg) override;
+
+private:
+    bool m_withCallsite = false;
+};
+
+} // namespace QtLogger
+
+// end logfmtformatter.h
+
 // patternformatter.h
 
 #include <QSharedPointer>
@@ -642,6 +1261,14 @@ public:
 
     QString format(const LogMessage &lmsg) override;
 
+protected:
+    enum class Syntax {
+        QtLogger,
+        Qt // qSetMessagePattern(), see QtMessagePatternFormatter
+    };
+
+    PatternFormatter(const QString &pattern, Syntax syntax);
+
 private:
     class PatternFormatterPrivate;
     QScopedPointer<PatternFormatterPrivate> d;
@@ -654,8 +1281,13 @@ private:
 
 // prettyformatter.h
 
+#include <QAtomicInt>
 #include <QHash>
 
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#endif
+
 namespace QtLogger {
 
 using PrettyFormatterPtr = QSharedPointer<class PrettyFormatter>;
@@ -669,17 +1301,37 @@ public:
         return s_instance;
     }
 
+    // Threads beyond are given the index of the least recently used one
+    static constexpr int MaxThreads = 256;
+
     explicit PrettyFormatter(bool colorize = false, int maxCategoryWidth = 15);
 
     QString format(const LogMessage &lmsg) override;
+    QString formatStyled(const LogMessage &lmsg, QString &plainMessage) override;
 
 private:
+    // Also renders the message without colors into plain, if set
+    QString render(const LogMessage &lmsg, QString *plain);
+    int threadIndex(quint64 threadId, int *threadsCount);
+    int updateCategoryWidth(int categoryFormatLength);
+
     bool m_colorize = false;
     int m_maxCategoryWidth = 15;
 
-    QHash<int, int> m_threads;
+    struct ThreadEntry
+    {
+        int index;
+        quint64 lastUse;
+    };
+
+    // Shared between producer threads when formatting in the caller thread
+    QHash<quint64, ThreadEntry> m_threads;
     int m_threadsIndex = 0;
-    int m_categoryWidth = 0;
+    quint64 m_threadsClock = 0;
+    QAtomicInt m_categoryWidth = 0;
+#ifndef QTLOGGER_NO_THREAD
+    QMutex m_threadsMutex;
+#endif
 };
 
 } // namespace QtLogger
@@ -716,6 +1368,34 @@ private:
 
 // end qtlogmessageformatter.h
 
+// qtmessagepatternformatter.h
+
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+using QtMessagePatternFormatterPtr = QSharedPointer<class QtMessagePatternFormatter>;
+
+// Formats messages like qFormatLogMessage() with a pattern of qSetMessagePattern(), but compiled
+// into the tokens of PatternFormatter: no global pattern and no lock of Qt, and a pattern of its
+// own for every pipeline. Supports all placeholders of Qt, %{backtrace} uses the backtrace captured
+// with the message (see backtrace.h). While a formatter with %{backtrace} exists, the logger
+// unwinds the stack for every message of the process, as Qt does. Other placeholders are
+// attributes, as in PatternFormatter.
+//
+// Without a pattern, the one Qt would use: QT_MESSAGE_PATTERN or the default of Qt.
+class QTLOGGER_EXPORT QtMessagePatternFormatter : public PatternFormatter
+{
+public:
+    explicit QtMessagePatternFormatter(const QString &pattern = QString());
+
+    static QString defaultPattern();
+};
+
+} // namespace QtLogger
+
+// end qtmessagepatternformatter.h
+
 // sentryformatter.h
 
 #include <QSharedPointer>
@@ -853,6 +1533,7 @@ inline QList<QPair<QByteArray, QByteArray>> sentryHeaders()
 
 #include <QScopedPointer>
 #include <QSharedPointer>
+#include <QStringList>
 
 // filesink.h
 
@@ -897,16 +1578,49 @@ using QIODevicePtr = QSharedPointer<QIODevice>;
 class QTLOGGER_EXPORT IODeviceSink : public Sink
 {
 public:
+    enum class Framing {
+        Newline, // Text followed by a newline, binary formatter output as is
+        LengthPrefixed // 32-bit big-endian length followed by the text or binary output
+    };
+
     explicit IODeviceSink(const QIODevicePtr &device);
 
     void send(const LogMessage &lmsg) override;
 
+    Framing framing() const;
+    // LengthPrefixed disables the text mode of the device, so the frames are written unchanged.
+    // Newline enables it again if it was disabled by the sink.
+    void setFraming(Framing framing);
+
+    // Writes the formatted message without terminal colors (LogMessage::plainFormattedMessage()).
+    // Off by default, file sinks enable it.
+    bool plainText() const;
+    void setPlainText(bool enabled);
+
+    // Bytes of a message in the framing, also used by sinks writing to sockets. Newline text is in
+    // the local 8-bit encoding unless utf8Text is set, length-prefixed text in UTF-8, binary
+    // formatter output is used as is.
+    static QByteArray frame(const LogMessage &lmsg, Framing framing, bool plainText,
+                            bool utf8Text = false);
+
 protected:
+    // Bytes written to the device for a single message
+    virtual QByteArray encode(const LogMessage &lmsg);
+
     const QIODevicePtr &device() const;
     void setDevice(const QIODevicePtr &device);
 
+    // Disables the text mode of the device before writing binary output and enables it again
+    // before writing newline-framed text, called by send()
+    void updateTextMode(const LogMessage &lmsg);
+
 private:
+    void updateTextMode();
+
     QIODevicePtr m_device;
+    Framing m_framing = Framing::Newline;
+    bool m_plainText = false;
+    bool m_textModeSuspended = false; // Text mode of the device disabled by updateTextMode()
 };
 
 using IODeviceSinkPtr = QSharedPointer<IODeviceSink>;
@@ -928,6 +1642,8 @@ public:
     bool flush() override;
 
 protected:
+    FileSink(const QString &path, QIODevice::OpenMode openMode);
+
     QFile *file() const;
 };
 
@@ -950,7 +1666,12 @@ public:
         None = 0x00,
         RotationOnStartup = 0x01,
         RotationDaily = 0x02,
-        Compression = 0x04
+        Compression = 0x04,
+        TimeIndex = 0x08, // Writes a time index next to each file, see timeindex.h
+        BlockCompression = 0x10, // Compression with a block index for random access, implies
+                                 // TimeIndex, see seekablegzip.h
+        TermIndex = 0x20 // Writes a bloom filter and term index of each rotated file, implies
+                         // TimeIndex, see termindex.h
     };
 
     Q_DECLARE_FLAGS(Options, Option)
@@ -962,6 +1683,22 @@ public:
     ~RotatingFileSink() override;
 
     void send(const LogMessage &lmsg) override;
+    bool flush() override;
+
+    // An index entry is written at most every intervalBytes of the log or intervalMsecs of message
+    // time, only used with the TimeIndex option
+    void setTimeIndexInterval(int intervalBytes, int intervalMsecs);
+
+    // Uncompressed size of the blocks written with the BlockCompression option
+    void setCompressionBlockSize(int blockSize);
+
+protected:
+    RotatingFileSink(const QString &path, int maxFileSize, int maxFileCount, Options options,
+                     QIODevice::OpenMode openMode);
+
+    // True if encode() writes binary log records, whose message and attributes go to the term
+    // index. Otherwise the tokens of the written bytes are indexed, as a search reads them.
+    virtual bool writesBinaryLog() const;
 
 private:
     class RotatingFileSinkPrivate;
@@ -1092,6 +1829,246 @@ using SortedPipelinePtr = QSharedPointer<SortedPipeline>;
 
 // end sortedpipeline.h
 
+// batchsignalsink.h
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QVector>
+
+namespace QtLogger {
+
+// Emits log messages in batches, for receivers that can't handle a signal per message.
+//
+// send() can be called from any thread. Messages are queued and emitted with messages() in the
+// thread of the sink, at most interval ms after the first queued one, or as soon as maxBatchSize
+// messages are queued. When the thread of the sink falls behind, e.g. a GUI thread busy with a slow
+// receiver, messages pile up; with a maximum pending count the oldest ones are dropped instead.
+class QTLOGGER_EXPORT BatchSignalSink : public QObject, public Sink
+{
+    Q_OBJECT
+
+public:
+    constexpr static int DefaultInterval = 100; // ms
+    constexpr static int DefaultMaxBatchSize = 1000;
+
+    explicit BatchSignalSink(int interval = DefaultInterval,
+                             int maxBatchSize = DefaultMaxBatchSize, QObject *parent = nullptr);
+    ~BatchSignalSink() override;
+
+    void send(const LogMessage &lmsg) override;
+
+    // Emits the queued messages when called in the thread of the sink, otherwise schedules it
+    bool flush() override;
+
+    int interval() const;
+    int maxBatchSize() const;
+
+    // 0 keeps all messages until they are emitted
+    int maxPendingCount() const;
+    void setMaxPendingCount(int count);
+
+    quint64 droppedCount() const;
+
+Q_SIGNALS:
+    void messages(const QVector<QtLogger::LogMessage> &lmsgs);
+
+private:
+    Q_INVOKABLE void startFlushTimer();
+
+    class BatchSignalSinkPrivate;
+    QScopedPointer<BatchSignalSinkPrivate> d;
+};
+
+using BatchSignalSinkPtr = QSharedPointer<BatchSignalSink>;
+
+} // namespace QtLogger
+
+// end batchsignalsink.h
+
+// segmentedlogsink.h
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+// Appends messages to a segmented log in a directory (see segmentedlog.h), followed by local
+// agents with SegmentedLogConsumer.
+//
+// Every message is a record with its own offset, written with a single write, so it survives a
+// crash of the application and consumers see it right away. When a segment reaches segmentSize a
+// new one is started, and the segments all consumers have committed are removed. With maxSize, the
+// oldest segments are removed when the log grows larger, even if a slow consumer hasn't read them.
+// There must be a single writer per directory, which the logger guarantees for the sinks of one
+// pipeline.
+class QTLOGGER_EXPORT SegmentedLogSink : public Sink
+{
+public:
+    static constexpr qint64 DefaultSegmentSize = 16 * 1024 * 1024;
+
+    explicit SegmentedLogSink(const QString &path, qint64 segmentSize = DefaultSegmentSize,
+                              qint64 maxSize = 0);
+    ~SegmentedLogSink() override;
+
+    void send(const LogMessage &lmsg) override;
+
+    // False if the directory or the current segment can't be written
+    bool isValid() const;
+    QString errorString() const;
+
+    QString path() const;
+    qint64 segmentSize() const;
+    qint64 maxSize() const;
+
+    // Offset of the next message
+    qint64 nextOffset() const;
+
+    // Removes the segments read by all consumers, and the oldest ones beyond the maximum size.
+    // Called whenever a new segment is started.
+    void removeOldSegments();
+
+private:
+    class SegmentedLogSinkPrivate;
+    QScopedPointer<SegmentedLogSinkPrivate> d;
+    Q_DISABLE_COPY(SegmentedLogSink)
+};
+
+using SegmentedLogSinkPtr = QSharedPointer<SegmentedLogSink>;
+
+} // namespace QtLogger
+
+// end segmentedlogsink.h
+
+// sharedmemorysink.h
+
+#include <QtGlobal>
+
+#ifndef QT_NO_SHAREDMEMORY
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+// Writes messages into a shared memory ring buffer (see sharedmemoryring.h) for a reader in another
+// process that formats and writes them, e.g. with SharedMemoryReader or qtlogger-cat --shm.
+//
+// After the segment is created in the constructor, sending a message only encodes it and copies it
+// into the ring, without system calls or locks. The writer never waits for readers: slow readers
+// lose the oldest messages and see them as overruns. There is a single writer per segment: a sink
+// whose key is in use by a live writer, in this or in another process, is not valid.
+class QTLOGGER_EXPORT SharedMemorySink : public Sink
+{
+public:
+    static constexpr int DefaultSlotCount = 8192;
+    static constexpr int DefaultSlotSize = 512;
+
+    explicit SharedMemorySink(const QString &key, int slotCount = DefaultSlotCount,
+                              int slotSize = DefaultSlotSize);
+    ~SharedMemorySink() override;
+
+    void send(const LogMessage &lmsg) override;
+
+    // False if the shared memory segment couldn't be created
+    bool isValid() const;
+    QString errorString() const;
+
+    QString key() const;
+    int slotCount() const;
+    int slotSize() const;
+
+    // Messages larger than the whole ring, not written
+    quint64 dropped() const;
+
+private:
+    class SharedMemorySinkPrivate;
+    QScopedPointer<SharedMemorySinkPrivate> d;
+    Q_DISABLE_COPY(SharedMemorySink)
+};
+
+using SharedMemorySinkPtr = QSharedPointer<SharedMemorySink>;
+
+} // namespace QtLogger
+
+#endif // QT_NO_SHAREDMEMORY
+
+// end sharedmemorysink.h
+
+#ifdef QTLOGGER_NETWORK
+
+// gelfsink.h
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+// Sends messages to Graylog in GELF 1.1 format.
+//
+// UDP: one datagram per message, compressed with zlib or gzip if enabled; messages larger than
+// the chunk size are split into GELF chunks (at most 128).
+// TCP: null-byte terminated messages without compression; messages sent within one event loop
+// iteration are written as a single batch.
+//
+// The socket is owned by a thread of the sink and never blocks the calling thread. Messages sent
+// before the connection is established, or over TCP while the server hasn't read the last batch,
+// are kept in a bounded buffer, the oldest ones are dropped when it's full.
+class QTLOGGER_EXPORT GelfSink : public Sink
+{
+public:
+    enum class Transport { Udp, Tcp };
+    enum class Compression { None, Zlib, Gzip };
+
+    static constexpr quint16 DefaultPort = 12201;
+    static constexpr int DefaultChunkSize = 8192;
+    static constexpr int DefaultMaxBufferSize = 4 * 1024 * 1024;
+
+    explicit GelfSink(const QString &host, quint16 port = DefaultPort,
+                      Transport transport = Transport::Udp);
+    ~GelfSink() override;
+
+    void send(const LogMessage &lmsg) override;
+    bool flush() override;
+
+    Transport transport() const;
+
+    // UDP only, GELF over TCP doesn't support compression
+    Compression compression() const;
+    void setCompression(Compression compression);
+
+    // Maximum UDP datagram size including the 12 bytes of the chunk header
+    int chunkSize() const;
+    void setChunkSize(int chunkSize);
+
+    int maxBufferSize() const;
+    void setMaxBufferSize(int maxBufferSize);
+
+    // Value of the GELF "host" field, the machine host name by default
+    QString hostName() const;
+    void setHostName(const QString &hostName);
+
+    // GELF 1.1 JSON of the message. Custom attributes become additional fields prefixed with '_'.
+    static QByteArray toGelf(const LogMessage &lmsg, const QString &hostName);
+
+private:
+    class GelfSinkPrivate;
+    QScopedPointer<GelfSinkPrivate> d;
+    Q_DISABLE_COPY(GelfSink)
+};
+
+using GelfSinkPtr = QSharedPointer<GelfSink>;
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
+
+// end gelfsink.h
+
+#endif
+
 QT_FORWARD_DECLARE_CLASS(QIODevice)
 
 namespace QtLogger {
@@ -1105,9 +2082,12 @@ public:
     }
 
     SimplePipeline &addSeqNumber(const QString &name = QStringLiteral("seq_number"));
+    SimplePipeline &addMessageTemplates(const QString &name = QStringLiteral("template_id"));
     SimplePipeline &addAppInfo();
     SimplePipeline &addAppUuid(const QString &name = QStringLiteral("app_uuid"));
     SimplePipeline &addSysInfo();
+    SimplePipeline &addBacktrace(QtMsgType minLevel = QtCriticalMsg,
+                                 int depth = Backtrace::DefaultDepth);
 #ifdef QTLOGGER_NETWORK
     SimplePipeline &addHostInfo();
 #endif
@@ -1122,8 +2102,13 @@ public:
     SimplePipeline &format(std::function<QString(const LogMessage &)> func);
     SimplePipeline &format(const QString &pattern);
     SimplePipeline &formatByQt();
+    SimplePipeline &formatByQtPattern(const QString &pattern = QString());
     SimplePipeline &formatPretty(bool colorize = false, int maxCategoryWidth = 15);
     SimplePipeline &formatToJson(bool compact = false);
+    SimplePipeline &formatToLogfmt(bool withCallsite = false);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+    SimplePipeline &formatToCbor();
+#endif
     SimplePipeline &formatToSentry(const QString &sdkName = QStringLiteral("qtlogger.sentry"),
                                    const QString &sdkVersion = QStringLiteral("1.0.0"));
 
@@ -1137,12 +2122,37 @@ public:
 #endif
     SimplePipeline &sendToPlatformStdLog();
     SimplePipeline &sendToFile(const QString &fileName, int maxFileSize = 0, int maxFileCount = 0, RotatingFileSink::Options options = RotatingFileSink::None);
+    SimplePipeline &sendToBinaryFile(const QString &fileName, int maxFileSize = 0, int maxFileCount = 0, RotatingFileSink::Options options = RotatingFileSink::None);
+    SimplePipeline &sendToRecording(const QString &fileName, quint64 maxCount = 0);
     SimplePipeline &sendToIODevice(const QIODevicePtr &device);
+    SimplePipeline &sendToSegmentedLog(const QString &path,
+                                       qint64 segmentSize = SegmentedLogSink::DefaultSegmentSize,
+                                       qint64 maxSize = 0);
+#ifndef QT_NO_SHAREDMEMORY
+    SimplePipeline &sendToSharedMemory(const QString &key,
+                                       int slotCount = SharedMemorySink::DefaultSlotCount,
+                                       int slotSize = SharedMemorySink::DefaultSlotSize);
+#endif
+#ifdef QTLOGGER_SQL
+    SimplePipeline &sendToSqlite(const QString &fileName, qint64 maxRowCount = 0, int maxAge = 0);
+#endif
     SimplePipeline &sendToSignal(QObject *receiver, const char *method);
+    SimplePipeline &sendToBatchSignal(QObject *receiver, const char *method,
+                                      int interval = BatchSignalSink::DefaultInterval,
+                                      int maxBatchSize = BatchSignalSink::DefaultMaxBatchSize);
 #ifdef QTLOGGER_NETWORK
     SimplePipeline &sendToHttp(const QString &url);
     SimplePipeline &sendToHttp(const QString &url,
                                const QList<QPair<QByteArray, QByteArray>> &headers);
+    SimplePipeline &sendToGelf(const QString &host, quint16 port = GelfSink::DefaultPort,
+                               GelfSink::Transport transport = GelfSink::Transport::Udp,
+                               GelfSink::Compression compression = GelfSink::Compression::None);
+    SimplePipeline &sendToLocalSocket(const QString &serverName);
+    SimplePipeline &sendToTcp(const QString &host, quint16 port,
+                              IODeviceSink::Framing framing = IODeviceSink::Framing::Newline);
+    SimplePipeline &sendToOtlp(const QString &endpoint);
+    SimplePipeline &sendToOtlp(const QString &endpoint,
+                               const QList<QPair<QByteArray, QByteArray>> &headers);
 #endif
 #ifdef Q_OS_WIN
     SimplePipeline &sendToWinDebug();
@@ -1177,6 +2187,7 @@ using SimplePipelinePtr = QSharedPointer<SimplePipeline>;
 
 // ownthreadhandler.h
 
+#include <optional>
 #include <type_traits>
 
 #include <QAtomicInt>
@@ -1209,6 +2220,51 @@ public:
 
     bool ownThreadIsRunning() const { return m_thread && m_thread->isRunning(); }
 
+    // When enabled, the leading attribute handlers, filters and formatters of the pipeline run
+    // synchronously in the calling thread and only the remaining sinks and nested pipelines are
+    // queued to the own thread. The leading handlers must be thread-safe. Sinks at the very start
+    // of the pipeline, e.g. a RecordingSink, don't end the leading handlers: they get the message
+    // as it was logged in the own thread.
+    OwnThreadHandler<BaseHandler> &setFormatInCallerThread(bool enabled)
+    {
+        static_assert(std::is_base_of<Pipeline, BaseHandler>::value,
+                      "Formatting in the caller thread requires a Pipeline");
+        m_formatInCallerThread.storeRelease(enabled ? 1 : 0);
+        return *this;
+    }
+
+    bool formatInCallerThread() const { return m_formatInCallerThread.loadAcquire() != 0; }
+
+    // Messages at or above the level take a separate lane: the worker handles them before the
+    // next queued message and flushes the sinks after them, so they don't wait behind a backlog.
+    // When ordered, they keep their place among the queued messages and only the sinks are
+    // flushed after them, writing out the backlog before them as well.
+    OwnThreadHandler<BaseHandler> &setPriorityLane(QtMsgType minLevel = QtWarningMsg,
+                                                   bool ordered = false)
+    {
+        m_priorityLaneLevel.storeRelease(minLevel);
+        m_priorityLane.storeRelease(ordered ? PriorityLaneOrdered : PriorityLaneBypass);
+        return *this;
+    }
+
+    OwnThreadHandler<BaseHandler> &disablePriorityLane()
+    {
+        m_priorityLane.storeRelease(PriorityLaneDisabled);
+        return *this;
+    }
+
+    bool hasPriorityLane() const { return m_priorityLane.loadAcquire() != PriorityLaneDisabled; }
+
+    QtMsgType priorityLaneLevel() const
+    {
+        return static_cast<QtMsgType>(m_priorityLaneLevel.loadAcquire());
+    }
+
+    bool priorityLaneOrdered() const
+    {
+        return m_priorityLane.loadAcquire() == PriorityLaneOrdered;
+    }
+
     OwnThreadHandler<BaseHandler> &moveToOwnThread()
     {
         QMutexLocker locker(&m_mutex);
@@ -1273,30 +2329,190 @@ public:
 
     bool process(LogMessage &lmsg) override
     {
+        if constexpr (std::is_base_of<Pipeline, BaseHandler>::value) {
+            if (formatInCallerThread()) {
+                return processInCallerThread(lmsg, BaseHandler::handlers());
+            }
+        }
+
         QMutexLocker locker(&m_mutex);
 
         if (m_worker) {
-            m_pendingCount.fetchAndAddOrdered(1);
-            QCoreApplication::postEvent(m_worker, new LogEvent(lmsg));
+            postLogEvent(new LogEvent(lmsg));
         } else {
             BaseHandler::process(lmsg);
         }
         return true;
     }
 
-private:
-    struct LogEvent : public QEvent
+protected:
+    bool processInCallerThread(LogMessage &lmsg, const QList<HandlerPtr> &handlers)
     {
-        LogEvent(const LogMessage &lmsg) : QEvent(type()), lmsg(lmsg) { }
+        int leading = 0;
+        while (leading < handlers.size()
+               && (!handlers.at(leading)
+                   || handlers.at(leading)->type() == Handler::HandlerType::Sink)) {
+            ++leading;
+        }
 
-        static QEvent::Type type()
-        {
-            static QEvent::Type _type = static_cast<QEvent::Type>(QEvent::registerEventType());
-            return _type;
+        std::optional<LogMessage> unprocessed;
+        if (leading > 0)
+            unprocessed = lmsg;
+
+        int first = leading;
+        bool passed = true;
+        for (; first < handlers.size(); ++first) {
+            const auto &handler = handlers.at(first);
+            if (!handler)
+                continue;
+            if (handler->type() == Handler::HandlerType::Sink
+                || handler->type() == Handler::HandlerType::Pipeline)
+                break;
+            if (!handler->process(lmsg)) {
+                passed = false;
+                break;
+            }
         }
 
-        LogMessage lmsg;
-    };
+        const auto tail = passed ? handlers.mid(first) : QList<HandlerPtr>();
+        if (!unprocessed && tail.isEmpty())
+            return true;
+
+        QMutexLocker locker(&m_mutex);
+
+        if (unprocessed)
+            processInOwnThread(*unprocessed, handlers.mid(0, leading));
+        if (!tail.isEmpty())
+            processInOwnThread(lmsg, tail);
+        return true;
+    }
+
+private:
+    enum PriorityLane { PriorityLaneDisabled, PriorityLaneBypass, PriorityLaneOrdered };
+
+    struct LogEvent;
+
+    static void processHandlers(LogMessage &lmsg, const QList<HandlerPtr> &handlers)
+    {
+        for (const auto &handler : handlers) {
+            if (!handler)
+                continue;
+            if (!handler->process(lmsg))
+                break;
+        }
+    }
+
+    static void flushHandlers(const QList<HandlerPtr> &handlers)
+    {
+        for (const auto &handler : handlers) {
+            if (auto sink = handler.dynamicCast<Sink>()) {
+                sink->flush();
+            } else if (auto pipeline = handler.dynamicCast<Pipeline>()) {
+                flushHandlers(std::as_const(*pipeline).handlers());
+            }
+        }
+    }
+
+    // Called with m_mutex locked
+    void processInOwnThread(LogMessage &lmsg, const QList<HandlerPtr> &handlers)
+    {
+        if (m_worker) {
+            postLogEvent(new LogEvent(lmsg, handlers));
+        } else {
+            processHandlers(lmsg, handlers);
+        }
+    }
+
+    // Called with m_mutex locked
+    void postLogEvent(LogEvent *event)
+    {
+        m_pendingCount.fetchAndAddOrdered(1);
+
+        const auto lane = m_priorityLane.loadAcquire();
+        if (lane == PriorityLaneDisabled
+            || qtMsgTypePriority(event->lmsg.type()) < qtMsgTypePriority(priorityLaneLevel())) {
+            QCoreApplication::postEvent(m_worker, event);
+            return;
+        }
+
+        if (lane == PriorityLaneOrdered) {
+            event->flush = true;
+            QCoreApplication::postEvent(m_worker, event);
+            return;
+        }
+
+        {
+            QMutexLocker locker(&m_priorityMutex);
+            m_priorityEvents.append(event);
+            m_priorityCount.storeRelease(static_cast<int>(m_priorityEvents.size()));
+        }
+
+        // Wakes the worker when the queue is empty, the lane is drained before any queued event
+        QCoreApplication::postEvent(m_worker, new QEvent(LogEvent::type()), Qt::HighEventPriority);
+    }
+
+    void processLogEvent(LogEvent *event)
+    {
+        if (event->handlers.isEmpty()) {
+            BaseHandler::process(event->lmsg);
+        } else {
+            processHandlers(event->lmsg, event->handlers);
+        }
+
+        if (event->flush)
+            flushSinks();
+    }
+
+    // Called in the own thread before every queued event
+    void processPriorityEvents()
+    {
+        if (m_priorityCount.loadAcquire() == 0)
+            return;
+
+        QList<LogEvent *> events;
+        {
+            QMutexLocker locker(&m_priorityMutex);
+            events.swap(m_priorityEvents);
+            m_priorityCount.storeRelease(0);
+        }
+
+        for (const auto event : std::as_const(events)) {
+            processLogEvent(event);
+        }
+        flushSinks();
+
+        qDeleteAll(events);
+        m_pendingCount.fetchAndSubOrdered(static_cast<int>(events.size()));
+    }
+
+    void flushSinks()
+    {
+        if constexpr (std::is_base_of<Pipeline, BaseHandler>::value) {
+            flushHandlers(BaseHandler::handlers());
+        } else if constexpr (std::is_base_of<Sink, BaseHandler>::value) {
+            BaseHandler::flush();
+        }
+    }
+
+    struct LogEvent : public QEvent
+    {
+        LogEvent(const LogMessage &lmsg, const QList<HandlerPtr> &handlers = {})
+            : QEvent(type()), lmsg(lmsg), handlers(handlers)
+        {
+        }
+
+        static QEvent::Type type()
+        {
+            static QEvent::Type _type = static_cast<QEvent::Type>(QEvent::registerEventType());
+            return _type;
+        }
+
+        LogMessage lmsg;
+        // Rest of the pipeline when the leading handlers already ran in the caller thread
+        QList<HandlerPtr> handlers;
+        // Flushes the sinks after the message, for messages of the ordered priority lane
+        bool flush = false;
+    };
 
     class Worker : public QObject
     {
@@ -1306,9 +2522,12 @@ private:
         void customEvent(QEvent *event) override
         {
             if (event->type() == LogEvent::type()) {
+                m_handler->processPriorityEvents();
+
+                // Otherwise a wake-up for the priority lane
                 auto logEvent = dynamic_cast<LogEvent *>(event);
                 if (logEvent) {
-                    m_handler->BaseHandler::process(logEvent->lmsg);
+                    m_handler->processLogEvent(logEvent);
                     m_handler->m_pendingCount.fetchAndSubOrdered(1);
                 }
             }
@@ -1323,6 +2542,13 @@ private:
     Worker *m_worker = nullptr;
     QMutex m_mutex;
     QAtomicInt m_pendingCount;
+    QAtomicInt m_formatInCallerThread;
+
+    QAtomicInt m_priorityLane;
+    QAtomicInt m_priorityLaneLevel { QtWarningMsg };
+    QMutex m_priorityMutex;
+    QList<LogEvent *> m_priorityEvents;
+    QAtomicInt m_priorityCount;
 };
 
 } // namespace QtLogger
@@ -1401,3251 +2627,13662 @@ inline Logger &operator<<(Logger *logger, const Pipeline &pipeline)
 
 // end logger.h
 
-// messagepatterns.h
+// logreplay.h
+
+#include <QScopedPointer>
+#include <QString>
 
 namespace QtLogger {
 
-constexpr char DefaultMessagePattern[] = "%{if-category}%{category}: %{endif}"
-                                         "%{message}";
+// Replays a recorded workload (RecordingSink, or any binary log of BinaryFileSink) into a handler,
+// e.g. a Logger or Pipeline configured like the application, and measures it.
+//
+// The whole recording is loaded before the replay, so decoding doesn't add to the measurement.
+// Messages keep their recorded time, thread, callsite and attributes. With the original pacing they
+// are sent at the recorded intervals, scaled by the speed; the latency of a message is measured
+// from the time it was due, so a handler that falls behind the load is charged for the wait of the
+// following messages. As fast as possible, the latency is the time spent in process(). For a
+// handler with its own thread, only the time to queue the messages is measured.
+class QTLOGGER_EXPORT LogReplay
+{
+public:
+    enum class Pacing {
+        Original, // Recorded intervals between the messages
+        Fast // As fast as possible
+    };
 
-constexpr char PrettyMessagePattern[] = "%{time dd.MM.yyyy hh:mm:ss.zzz} "
-                                        "%{if-debug} %{endif}"
-                                        "%{if-info}I%{endif}"
-                                        "%{if-warning}W%{endif}"
-                                        "%{if-critical}E%{endif}"
-                                        "%{if-fatal}F%{endif} "
-                                        "[%{category}] %{message}";
+    struct Stats
+    {
+        quint64 count = 0;
+        // From the first message sent to the last one processed, nanoseconds
+        qint64 elapsed = 0;
+        // Messages per second
+        double throughput = 0;
+
+        // Nanoseconds
+        qint64 minLatency = 0;
+        qint64 meanLatency = 0;
+        qint64 p50Latency = 0;
+        qint64 p90Latency = 0;
+        qint64 p99Latency = 0;
+        qint64 p999Latency = 0;
+        qint64 maxLatency = 0;
+    };
 
-} // namespace QtLogger
+    explicit LogReplay(const QString &path);
+    ~LogReplay();
 
-// end messagepatterns.h
+    // False if the recording can't be read
+    bool isValid() const;
+    QString errorString() const;
 
-// platformstdsink.h
+    // Messages of the recording
+    int count() const;
+    // From the first to the last message of the recording, milliseconds
+    qint64 duration() const;
 
-#include <QSharedPointer>
+    Pacing pacing() const;
+    void setPacing(Pacing pacing);
 
-#if defined(QTLOGGER_ANDROIDLOG)
+    // Factor for the recorded intervals with the original pacing, e.g. 2 replays twice as fast
+    double speed() const;
+    void setSpeed(double speed);
 
-// androidlogsink.h
+    // Sends every message of the recording to the handler
+    Stats run(Handler &handler) const;
 
-#ifdef QTLOGGER_ANDROIDLOG
+private:
+    class LogReplayPrivate;
+    QScopedPointer<LogReplayPrivate> d;
+    Q_DISABLE_COPY(LogReplay)
+};
+
+} // namespace QtLogger
 
+// end logreplay.h
+
+// logsearch.h
+
+#include <QDateTime>
+#include <QList>
+#include <QRegularExpression>
+#include <QScopedPointer>
 #include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
 
 namespace QtLogger {
 
-class QTLOGGER_EXPORT AndroidLogSink : public Sink
+// Searches a log and its rotated files, plain and compressed with
+// RotatingFileSink::BlockCompression, in a thread pool.
+//
+// Every plain file and every block of a compressed text file is searched by its own task, a
+// compressed binary log by one task, as its dictionaries are only written once. The time indexes
+// (RotatingFileSink::TimeIndex) are used to skip files, blocks and parts of files outside the time
+// range, the term indexes (RotatingFileSink::TermIndex) to skip them if they don't have the
+// terms of the query. The matches of the tasks of a file are merged in time order and passed on
+// file by file, oldest first. Plain files are read in chunks.
+//
+// Binary logs (BinaryFileSink) are matched message by message. Text logs are matched line by line:
+// a line gets the time of the time index entry before it, so the time range applies with the
+// granularity of the index. The time range can't be applied to text logs without a time index,
+// they are searched completely and reported by warnings(). Level and category conditions can't be checked in text logs, the text
+// logs of a query with them are reported by errors() instead of being searched. Compressed files
+// without a block index can't be read.
+class QTLOGGER_EXPORT LogSearch
 {
 public:
-    void send(const LogMessage &lmsg) override;
-};
-
-using AndroidLogSinkPtr = QSharedPointer<AndroidLogSink>;
+    struct Query
+    {
+        // Invalid times don't limit the range
+        QDateTime from;
+        QDateTime to;
+
+        // Binary logs only, text logs are reported by errors()
+        QtMsgType minLevel = QtDebugMsg;
+        // Category name, '*' matches any characters; empty matches all
+        QString category;
+
+        // Substring of the message or line, and a regular expression, both must match if set
+        QString text;
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive;
+        QRegularExpression regex;
+
+        // Terms that must all be tokens of the message or line, or values of attributes of binary
+        // log messages, case insensitive. See termindex.h for tokens; files and ranges without
+        // them are skipped by their term index (RotatingFileSink::TermIndex).
+        QStringList terms;
+    };
 
-} // namespace QtLogger
+    struct Match
+    {
+        // Milliseconds since epoch, 0 for text lines of files without a time index, which are
+        // merged in file order after the matches before them
+        qint64 time = 0;
+        QString fileName;
+        // The line of a text log, without the line break
+        QString line;
+        // The message of a binary log
+        QSharedPointer<const LogMessage> message;
+    };
 
-#endif // QTLOGGER_ANDROIDLOG
+    // The path of the active log file, as given to the sink
+    explicit LogSearch(const QString &logFileName);
+    ~LogSearch();
 
-// end androidlogsink.h
+    // Files that are searched, oldest first
+    QStringList files() const;
 
-#elif defined(QTLOGGER_OSLOG)
+    // 0 uses QThread::idealThreadCount()
+    int maxThreadCount() const;
+    void setMaxThreadCount(int maxThreadCount);
 
-// oslogsink.h
+    QList<Match> search(const Query &query) const;
 
-#ifdef QTLOGGER_OSLOG
+    // Calls the callback with the matches of every file as soon as the file and the files before it
+    // are searched, on the calling thread
+    void search(const Query &query, const std::function<void(const Match &)> &callback) const;
 
-#include <QSharedPointer>
+    // Files that couldn't be read or searched by the last search, as "<file>: <reason>"
+    QStringList errors() const;
 
-namespace QtLogger {
+    // Files the time range of the last search couldn't be applied to, as "<file>: <reason>"
+    QStringList warnings() const;
 
-class QTLOGGER_EXPORT OslogSink : public Sink
-{
-public:
-    void send(const LogMessage &lmsg);
+private:
+    class LogSearchPrivate;
+    QScopedPointer<LogSearchPrivate> d;
+    Q_DISABLE_COPY(LogSearch)
 };
 
-using OslogSinkPtr = QSharedPointer<OslogSink>;
-
 } // namespace QtLogger
 
-#endif // QTLOGGER_OSLOG
+// end logsearch.h
 
-// end oslogsink.h
+// messagepatterns.h
 
-#else
+namespace QtLogger {
 
-// stderrsink.h
+constexpr char DefaultMessagePattern[] = "%{if-category}%{category}: %{endif}"
+                                         "%{message}";
 
-#include <QSharedPointer>
+constexpr char PrettyMessagePattern[] = "%{time dd.MM.yyyy hh:mm:ss.zzz} "
+                                        "%{if-debug} %{endif}"
+                                        "%{if-info}I%{endif}"
+                                        "%{if-warning}W%{endif}"
+                                        "%{if-critical}E%{endif}"
+                                        "%{if-fatal}F%{endif} "
+                                        "[%{category}] %{message}";
 
-// coloredconsole.h
+} // namespace QtLogger
 
-#include <QString>
-#include <qlogging.h>
+// end messagepatterns.h
 
-namespace QtLogger {
+// seekablegzip.h
 
-enum class ColorMode {
-    Auto, // Enable colors if output is a TTY
-    Always, // Always enable colors
-    Never // Never use colors
-};
+#include <QByteArray>
+#include <QIODevice>
+#include <QList>
+#include <QScopedPointer>
+#include <QString>
 
-class QTLOGGER_EXPORT ColoredConsole
-{
-public:
-    explicit ColoredConsole(ColorMode colorMode = ColorMode::Auto);
-    virtual ~ColoredConsole();
+/*
+ * Seekable gzip file: a sequence of gzip members, each holding an independently compressed block
+ * of about blockSize bytes of the log, so the file is still read by gunzip and zcat. Blocks
+ * start at message boundaries.
+ *
+ * The block index is written next to it as "<file>.gz.gzi":
+ *
+ *   file  := "QTLZ" <u8 version> <3 reserved bytes> <i64 uncompressed size> block*
+ *   block := <i64 uncompressed offset> <i64 compressed offset> <i64 time, ms since epoch>
+ *            <u32 adler-32 of the uncompressed block> <4 reserved bytes>
+ *
+ * Integers are little endian. The time is the time of the first message of the block taken from
+ * the time index of the log (see timeindex.h), 0 if the log has none.
+ */
 
-    void setColorMode(ColorMode mode);
-    ColorMode colorMode() const;
-    bool colorsEnabled() const;
+namespace QtLogger {
 
-    static QString colorPrefix(QtMsgType type);
-    static QString colorReset();
-    static QString colorize(const QString &message, QtMsgType type);
-    static bool isStdOutTty();
-    static bool isStdErrTty();
+namespace SeekableGzip {
 
-protected:
-    virtual bool isTty() const = 0;
+constexpr char Magic[] = "QTLZ";
+constexpr quint8 Version = 1;
+constexpr int HeaderSize = 16;
+constexpr int EntrySize = 32;
 
-    void updateColorsEnabled();
+constexpr int DefaultBlockSize = 1 * 1024 * 1024; // 1 MB
 
-    ColorMode m_colorMode = ColorMode::Auto;
-    bool m_colorsEnabled = false;
+struct Block
+{
+    qint64 uncompressedOffset;
+    qint64 compressedOffset;
+    qint64 time;
+    quint32 adler32;
 };
 
-} // namespace QtLogger
+inline QString indexFileName(const QString &gzFileName)
+{
+    return gzFileName + QStringLiteral(".gzi");
+}
 
-// end coloredconsole.h
+// A complete gzip member with the deflated data
+QTLOGGER_EXPORT QByteArray member(const QByteArray &data, int compressionLevel = 5,
+                                  quint32 *adler32 = nullptr);
 
-namespace QtLogger {
+// Compresses the file into "<file>.gz" with its block index, the file itself is kept
+QTLOGGER_EXPORT bool compress(const QString &fileName, int blockSize = DefaultBlockSize);
 
-class QTLOGGER_EXPORT StdErrSink : public Sink, public ColoredConsole
+} // namespace SeekableGzip
+
+// Read-only random access to the uncompressed contents of a seekable gzip file.
+//
+// Only the blocks holding the requested range are read and decompressed, the last one is cached.
+// block() does not change the device, so blocks can also be decompressed in parallel.
+class QTLOGGER_EXPORT SeekableGzipFile : public QIODevice
 {
 public:
-    explicit StdErrSink(ColorMode colorMode = ColorMode::Never);
+    explicit SeekableGzipFile(const QString &gzFileName);
+    ~SeekableGzipFile() override;
 
-    void send(const LogMessage &lmsg) override;
-    bool flush() override;
+    QString fileName() const;
+
+    // Fails if the file has no valid block index
+    bool open(OpenMode mode) override;
+    void close() override;
+
+    bool isSequential() const override;
+    qint64 size() const override;
+
+    const QList<SeekableGzip::Block> &blocks() const;
+    // The block holding the uncompressed offset, -1 if out of range
+    int blockAt(qint64 offset) const;
+    // The uncompressed data of a block, empty on error
+    QByteArray block(int index) const;
 
 protected:
-    bool isTty() const override;
-};
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 readLineData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
 
-using StdErrSinkPtr = QSharedPointer<StdErrSink>;
+private:
+    class SeekableGzipFilePrivate;
+    QScopedPointer<SeekableGzipFilePrivate> d;
+    Q_DISABLE_COPY(SeekableGzipFile)
+};
 
 } // namespace QtLogger
 
-// end stderrsink.h
+// end seekablegzip.h
 
-#endif
+// segmentedlog.h
+
+#include <optional>
+
+#include <QList>
+#include <QObject>
+#include <QScopedPointer>
+#include <QString>
+
+/*
+ * Segmented log (written by SegmentedLogSink, read by SegmentedLogConsumer):
+ *
+ *   directory := <segment>* <cursor>*
+ *   segment   := "<base offset, 20 digits>.seg"
+ *                "QTLS" <u8 version> <3 reserved bytes> <i64 base offset> record*
+ *   record    := <u32 size> <binary log session of one message, see binarylog.h>
+ *   cursor    := "<consumer name>.cursor", decimal text "<offset> [<segment base> <position>]"
+ *
+ * Every record has an offset: the first record of a segment has the base offset of the segment,
+ * the following ones count up, and the next segment starts with the offset after the last record
+ * of the previous one. Integers are little endian. A cursor holds the committed offset and, when
+ * known, the segment and byte position of the record with it, so a restarted consumer seeks
+ * straight to the record instead of skipping every record before it.
+ *
+ * The writer appends every record with a single write and starts a new segment when the current
+ * one is full. A record cut short by a crash is removed when the writer opens the log again.
+ * Segments before the slowest committed cursor are removed; with a maximum size, the oldest
+ * segments are removed even if not all consumers have read them.
+ */
 
 namespace QtLogger {
 
-#if defined(QTLOGGER_ANDROIDLOG)
-using PlatformStdSink = AndroidLogSink;
-#elif defined(QTLOGGER_OSLOG)
-using PlatformStdSink = OslogSink;
-#else
-using PlatformStdSink = StdErrSink;
-#endif
+namespace SegmentedLog {
 
-using PlatformStdSinkPtr = QSharedPointer<PlatformStdSink>;
+constexpr char Magic[] = "QTLS";
+constexpr quint8 Version = 1;
+constexpr int HeaderSize = 16;
+constexpr int RecordHeaderSize = 4;
 
-}
+QTLOGGER_EXPORT QString segmentFileName(const QString &path, qint64 baseOffset);
+QTLOGGER_EXPORT QString cursorFileName(const QString &path, const QString &name);
 
-// end platformstdsink.h
+// Base offsets of the segments in the directory, ascending
+QTLOGGER_EXPORT QList<qint64> segments(const QString &path);
 
-// signalsink.h
+// Committed offsets of all consumers of the log
+QTLOGGER_EXPORT QList<qint64> committedOffsets(const QString &path);
 
-#include <QObject>
+// Letters, digits, '_', '-' and '.'
+QTLOGGER_EXPORT bool isValidConsumerName(const QString &name);
 
-namespace QtLogger {
+// Removes the cursor of a consumer that is gone, so it no longer holds back the retention
+QTLOGGER_EXPORT bool removeCursor(const QString &path, const QString &name);
 
-class QTLOGGER_EXPORT SignalSink : public QObject, public Sink
+} // namespace SegmentedLog
+
+// Follows a segmented log from its committed offset, in the same or in another process than the
+// writer. Every consumer has a name and its own cursor: after a restart it continues with the first
+// message it didn't commit. A new consumer starts with the oldest message in the log.
+class QTLOGGER_EXPORT SegmentedLogConsumer : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit SignalSink(QObject *parent = nullptr);
+    SegmentedLogConsumer(const QString &path, const QString &name, QObject *parent = nullptr);
+    ~SegmentedLogConsumer() override;
 
-    void send(const LogMessage &lmsg) override;
+    // False if the name isn't a valid consumer name
+    bool isValid() const;
 
-Q_SIGNALS:
-    void message(const QtLogger::LogMessage &lmsg);
-};
+    QString path() const;
+    QString name() const;
 
-using SignalSinkPtr = QSharedPointer<SignalSink>;
+    // Offset of the next message
+    qint64 position() const;
+    // Continues with the message at the offset. Seeking ahead within the open segment or to the
+    // committed offset is direct, other offsets skip the records from the start of their segment.
+    void seek(qint64 offset);
 
-} // namespace QtLogger
+    // Next message, or nothing if there are no new messages
+    std::optional<LogMessage> next();
 
-// end signalsink.h
+    // Stores the position, messages before it are not read again and may be removed
+    bool commit();
+    qint64 committedOffset() const;
 
-// stdoutsink.h
+    // Messages removed by the maximum size of the log before they were read
+    quint64 lostCount() const;
 
-#include <QSharedPointer>
+    // Waits until there is a new message, polling the log; -1 waits without a timeout
+    bool waitForReadyRead(int msecs);
 
-namespace QtLogger {
+Q_SIGNALS:
+    // The log was written to, emitted in the thread of the consumer when it has an event loop
+    void readyRead();
 
-class QTLOGGER_EXPORT StdOutSink : public Sink, public ColoredConsole
-{
-public:
-    explicit StdOutSink(ColorMode colorMode = ColorMode::Never);
-
-    void send(const LogMessage &lmsg) override;
-    bool flush() override;
-
-protected:
-    bool isTty() const override;
+private:
+    class SegmentedLogConsumerPrivate;
+    QScopedPointer<SegmentedLogConsumerPrivate> d;
 };
 
-using StdOutSinkPtr = QSharedPointer<StdOutSink>;
-
 } // namespace QtLogger
 
-// end stdoutsink.h
+// end segmentedlog.h
 
-// utils.h
+// sharedmemoryring.h
 
-#include <qlogging.h>
+#include <QtGlobal>
 
-namespace QtLogger {
+#ifndef QT_NO_SHAREDMEMORY
 
-/** Set global filter rules
- *
- *  Format:  "[<category>|*].[debug|info|warning|critical]=true|false;..."
- *  Example: "app.*.debug=false;app.logger.debug=true"
- */
+#include <atomic>
+#include <optional>
 
-QTLOGGER_EXPORT void setFilterRules(const QString &rules);
+#include <QScopedPointer>
+#include <QString>
 
-/** Set global message pattern
+/*
+ * Shared memory ring buffer (written by SharedMemorySink, read by SharedMemoryReader):
  *
- * Following placeholders are supported:
- * %{appname} %{category} %{file} %{function} %{line} %{message} %{pid} %{threadid}
- * %{qthreadptr} %{type} %{time process} %{time boot} %{time [format]} %{backtrace [depth=N]
- * [separator="..."]}
+ *   segment := <header, 64 bytes> <slot>{slot count}
+ *   slot    := <atomic u64 state> <u64 record seq> <u32 record size> <u32 record slots> <payload>
+ *
+ * A record is a binary log session of a single message (see binarylog.h) stored in one or more
+ * consecutive slots. Slots are numbered by an ever increasing slot sequence, slot n lives at index
+ * n % slot count. Only the first slot of a record has a non-zero record slots field.
+ *
+ * Every slot is a seqlock: the writer sets its state to 2n + 1 while writing slot n and to 2n + 2
+ * when done, then publishes the record by advancing the header head. The writer never waits for
+ * readers and overwrites the oldest slots; readers detect overwritten slots by their state and
+ * count the records they lost from the gaps in the record sequence.
+ *
+ * There is a single writer. It claims the ring by storing its token (process id << 32 | sink
+ * number in the process) in the header writer field with a compare-and-swap and clears it when
+ * done. A ring whose writer process is gone is taken over by the next writer.
  */
 
-QTLOGGER_EXPORT QString setMessagePattern(const QString &messagePattern);
+namespace QtLogger {
 
-QTLOGGER_EXPORT QString restorePreviousMessagePattern();
+namespace SharedMemoryRing {
 
-} // namespace QtLogger
+constexpr quint32 Magic = 0x524c5451; // "QTLR"
+constexpr quint32 Version = 2;
 
-// end utils.h
+static_assert(std::atomic<quint64>::is_always_lock_free,
+              "The shared memory ring buffer requires lock-free 64-bit atomics");
 
-#ifdef QTLOGGER_NETWORK
+struct Header
+{
+    quint32 magic;
+    quint32 version;
+    quint32 slotSize;
+    quint32 slotCount;
+    std::atomic<quint64> head; // Next slot sequence
+    std::atomic<quint64> nextRecord; // Next record sequence
+    std::atomic<quint64> dropped; // Records larger than the ring
+    std::atomic<quint64> writer; // Token of the writing sink, 0 if none
+    char reserved[16];
+};
 
-// hostinfoattrs.h
+struct Slot
+{
+    std::atomic<quint64> state;
+    quint64 record;
+    quint32 size;
+    quint32 slots;
+};
 
-#ifdef QTLOGGER_NETWORK
+constexpr int HeaderSize = sizeof(Header);
+constexpr int SlotHeaderSize = sizeof(Slot);
 
-#include <QSharedPointer>
+static_assert(HeaderSize == 64, "Unexpected shared memory ring header size");
+static_assert(SlotHeaderSize == 24, "Unexpected shared memory ring slot header size");
 
-namespace QtLogger {
+inline qint64 segmentSize(int slotCount, int slotSize)
+{
+    return HeaderSize + static_cast<qint64>(slotCount) * slotSize;
+}
 
-class QTLOGGER_EXPORT HostInfoAttrs : public AttrHandler
+} // namespace SharedMemoryRing
+
+// Reads the messages of a SharedMemorySink, in the same or in another process. Reading never
+// blocks or slows down the writer: records overwritten before they were read are counted as
+// overruns and skipped.
+class QTLOGGER_EXPORT SharedMemoryReader
 {
 public:
-    HostInfoAttrs();
+    explicit SharedMemoryReader(const QString &key);
+    ~SharedMemoryReader();
 
-    QVariantHash attributes(const LogMessage &lmsg) override;
+    // False if the segment doesn't exist or isn't a ring buffer
+    bool isValid() const;
+    QString errorString() const;
+
+    // Next message, or nothing if there are no new messages. Starts with the oldest message
+    // still in the ring.
+    std::optional<LogMessage> next();
+
+    // Skips all messages written so far
+    void skipToLatest();
+
+    // Records lost because the reader was too slow
+    quint64 overruns() const;
+    // Records the writer dropped because they don't fit into the ring
+    quint64 dropped() const;
 
 private:
-    QVariantHash m_attrs;
+    class SharedMemoryReaderPrivate;
+    QScopedPointer<SharedMemoryReaderPrivate> d;
+    Q_DISABLE_COPY(SharedMemoryReader)
 };
 
-using HostInfoAttrsPtr = QSharedPointer<HostInfoAttrs>;
-
 } // namespace QtLogger
 
-#endif // QTLOGGER_NETWORK
-
-// end hostinfoattrs.h
+#endif // QT_NO_SHAREDMEMORY
 
-// httpsink.h
+// end sharedmemoryring.h
 
-#ifdef QTLOGGER_NETWORK
+// binaryfilesink.h
 
-#include <QNetworkRequest>
+#include <QScopedPointer>
 #include <QSharedPointer>
-#include <QPointer>
-#include <QUrl>
-
-QT_FORWARD_DECLARE_CLASS(QNetworkAccessManager)
 
 namespace QtLogger {
 
-class QTLOGGER_EXPORT HttpSink : public Sink
+// Writes messages in the compact binary format described in binarylog.h. The formatted message is
+// not used: the raw message, its callsite and attributes are stored, so any formatter can be
+// applied later when the log is read back with BinaryLogReader.
+class QTLOGGER_EXPORT BinaryFileSink : public RotatingFileSink
 {
 public:
-    using Headers = QList<QPair<QByteArray, QByteArray>>;
-
-    explicit HttpSink(const QUrl &url);
-    HttpSink(const QUrl &url, const Headers &headers);
-    ~HttpSink();
+    explicit BinaryFileSink(const QString &path,
+                            int maxFileSize = DefaultMaxFileSize,
+                            int maxFileCount = DefaultMaxFileCount,
+                            Options options = Option::None);
+    ~BinaryFileSink() override;
 
-    void send(const LogMessage &lmsg) override;
+    // Messages with an id of these templates are stored as the template id and the parameters
+    void setMessageTemplates(const MessageTemplateAttrPtr &messageTemplates);
+    MessageTemplateAttrPtr messageTemplates() const;
 
-    void setNetworkAccessManager(QNetworkAccessManager *manager);
-    void setRequest(const QNetworkRequest &request);
-    void setHeaders(const Headers &headers);
+protected:
+    QByteArray encode(const LogMessage &lmsg) override;
+    bool writesBinaryLog() const override;
 
 private:
-    void init();
-
-    QUrl m_url;
-    Headers m_headers;
-    QPointer<QNetworkAccessManager> m_manager;
-    QNetworkRequest m_request;
+    class BinaryFileSinkPrivate;
+    QScopedPointer<BinaryFileSinkPrivate> d;
+    Q_DISABLE_COPY(BinaryFileSink)
 };
 
-using HttpSinkPtr = QSharedPointer<HttpSink>;
+using BinaryFileSinkPtr = QSharedPointer<BinaryFileSink>;
 
 } // namespace QtLogger
 
-#endif // QTLOGGER_NETWORK
-
-// end httpsink.h
-
-#endif
-
-#ifdef Q_OS_WIN
-
-// windebugsink.h
+// end binaryfilesink.h
 
-#ifdef Q_OS_WIN
+// logmodelsink.h
 
+#include <QAbstractListModel>
+#include <QScopedPointer>
 #include <QSharedPointer>
 
 namespace QtLogger {
 
-class QTLOGGER_EXPORT WinDebugSink : public Sink
+// List model of the latest messages for in-app log viewers.
+//
+// send() can be called from any thread. Messages are queued and inserted in the thread of the model
+// once per flush interval, a frame by default, with one beginInsertRows() per batch. They are
+// stored compactly in chunks; when more than maxCount messages are stored, the oldest chunk is
+// dropped, so memory stays bounded however many messages arrive.
+//
+// The rows are the messages matching the filter, kept in an index: new messages are checked when
+// they are inserted, and a filter that narrows the current one only checks the rows it matched.
+class QTLOGGER_EXPORT LogModelSink : public QAbstractListModel, public Sink
 {
-public:
-    void send(const LogMessage &lmsg) override;
-};
-
-using WinDebugSinkPtr = QSharedPointer<WinDebugSink>;
-
-} // namespace QtLogger
+    Q_OBJECT
 
-#endif
+public:
+    constexpr static int DefaultMaxCount = 1000000;
+    constexpr static int DefaultFlushInterval = 16; // ms
 
-// end windebugsink.h
+    enum Role
+    {
+        TimeRole = Qt::UserRole + 1,
+        TypeRole,
+        CategoryRole,
+        FileRole,
+        LineRole,
+        FunctionRole,
+        MessageRole,
+        FormattedMessageRole,
+        ThreadIdRole,
+        AttributesRole
+    };
 
-#endif
+    struct RowFilter
+    {
+        QtMsgType minLevel = QtDebugMsg;
+        // Category name, '*' matches any characters; empty matches all
+        QString category;
+        // Substring of the formatted message
+        QString text;
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive;
+    };
 
-#ifdef QTLOGGER_IOSLOG
+    explicit LogModelSink(int maxCount = DefaultMaxCount, QObject *parent = nullptr);
+    ~LogModelSink() override;
 
-#endif
+    void send(const LogMessage &lmsg) override;
 
-#ifdef QTLOGGER_ANDROIDLOG
+    // Inserts the queued messages when called in the thread of the model, otherwise schedules it
+    bool flush() override;
 
-#endif
+    int maxCount() const;
 
-#ifdef QTLOGGER_SYSLOG
+    int flushInterval() const;
+    void setFlushInterval(int msecs);
 
-// syslogsink.h
+    // Stored messages, matching the filter or not
+    int totalCount() const;
+    // Messages dropped before they were inserted, because the model thread didn't keep up
+    quint64 droppedCount() const;
 
-#ifdef QTLOGGER_SYSLOG
+    RowFilter rowFilter() const;
+    void setRowFilter(const RowFilter &filter);
 
-#include <QSharedPointer>
+    // The next row from fromRow on, or the previous one, with the text in the formatted message;
+    // -1 if there is none.
+    //
+    // The messages with the text are kept in an index like the rows. A new text checks every
+    // stored message once, up to maxCount, in the calling thread; a text that extends the previous
+    // one only checks the messages it matched, and finding the same text again is a lookup. Until
+    // clearFind(), every inserted message is also checked for the text.
+    int find(const QString &text, int fromRow = 0, bool backward = false,
+             Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive) const;
+    // Drops the index of find()
+    void clearFind();
 
-// Syslog options
-// See syslog.h for more information
-#define QTLOGGER_SYSLOG_LOG_PID  0x01
-#define QTLOGGER_SYSLOG_LOG_USER (1 << 3)
+    void clear();
 
-namespace QtLogger {
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
 
-class QTLOGGER_EXPORT SyslogSink : public Sink
-{
-public:
-    explicit SyslogSink(const QString &ident, int option = QTLOGGER_SYSLOG_LOG_PID,
-                        int facility = QTLOGGER_SYSLOG_LOG_USER);
-    ~SyslogSink();
+private:
+    Q_INVOKABLE void startFlushTimer();
 
-    void send(const LogMessage &lmsg) override;
+    class LogModelSinkPrivate;
+    QScopedPointer<LogModelSinkPrivate> d;
 };
 
-using SyslogSinkPtr = QSharedPointer<SyslogSink>;
+using LogModelSinkPtr = QSharedPointer<LogModelSink>;
 
 } // namespace QtLogger
 
-#endif // QTLOGGER_SYSLOG
+// end logmodelsink.h
 
-// end syslogsink.h
+// platformstdsink.h
 
-#endif
+#include <QSharedPointer>
 
-#ifdef QTLOGGER_SDJOURNAL
+#if defined(QTLOGGER_ANDROIDLOG)
 
-// sdjournalsink.h
+// androidlogsink.h
 
-#ifdef QTLOGGER_SDJOURNAL
+#ifdef QTLOGGER_ANDROIDLOG
 
 #include <QSharedPointer>
 
 namespace QtLogger {
 
-class QTLOGGER_EXPORT SdJournalSink : public Sink
+class QTLOGGER_EXPORT AndroidLogSink : public Sink
 {
 public:
     void send(const LogMessage &lmsg) override;
 };
 
-using SdJournalSinkPtr = QSharedPointer<SdJournalSink>;
+using AndroidLogSinkPtr = QSharedPointer<AndroidLogSink>;
 
 } // namespace QtLogger
 
-#endif // QTLOGGER_SDJOURNAL
+#endif // QTLOGGER_ANDROIDLOG
 
-// end sdjournalsink.h
+// end androidlogsink.h
 
-#endif
+#elif defined(QTLOGGER_OSLOG)
 
-// appinfoattrs.cpp
+// oslogsink.h
 
-#include <QCoreApplication>
+#ifdef QTLOGGER_OSLOG
+
+#include <QSharedPointer>
 
 namespace QtLogger {
 
-QTLOGGER_DECL_SPEC
-AppInfoAttrs::AppInfoAttrs()
+class QTLOGGER_EXPORT OslogSink : public Sink
 {
-    m_attrs = QVariantHash {
-        { QStringLiteral("appname"), QCoreApplication::applicationName() },
-        { QStringLiteral("appversion"), QCoreApplication::applicationVersion() },
-        { QStringLiteral("appdir"), QCoreApplication::applicationDirPath() },
-        { QStringLiteral("apppath"), QCoreApplication::applicationFilePath() },
-        { QStringLiteral("pid"), QCoreApplication::applicationPid() },
-    };
-}
+public:
+    void send(const LogMessage &lmsg);
+};
 
-QTLOGGER_DECL_SPEC
-QVariantHash AppInfoAttrs::attributes(const LogMessage &lmsg)
-{
-    Q_UNUSED(lmsg)
-    return m_attrs;
-}
+using OslogSinkPtr = QSharedPointer<OslogSink>;
 
 } // namespace QtLogger
 
-// appuuidattr.cpp
+#endif // QTLOGGER_OSLOG
 
-// appuuidattr.h
+// end oslogsink.h
 
-//
+#else
+
+// stderrsink.h
 
 #include <QSharedPointer>
 
+// coloredconsole.h
+
+#include <QString>
+#include <qlogging.h>
+
 namespace QtLogger {
 
-class QTLOGGER_EXPORT AppUuidAttr : public AttrHandler
+enum class ColorMode {
+    Auto, // Enable colors if output is a TTY
+    Always, // Always enable colors
+    Never // Never use colors
+};
+
+class QTLOGGER_EXPORT ColoredConsole
 {
 public:
-    explicit AppUuidAttr(const QString &name = QStringLiteral("app_uuid"));
-    QVariantHash attributes(const LogMessage &lmsg) override;
+    explicit ColoredConsole(ColorMode colorMode = ColorMode::Auto);
+    virtual ~ColoredConsole();
 
-private:
-    QString m_name;
-    QString m_uuid;
-};
+    void setColorMode(ColorMode mode);
+    ColorMode colorMode() const;
+    bool colorsEnabled() const;
 
-using AppUuidAttrPtr = QSharedPointer<AppUuidAttr>;
+    static QString colorPrefix(QtMsgType type);
+    static QString colorReset();
+    static QString colorize(const QString &message, QtMsgType type);
+    static bool isStdOutTty();
+    static bool isStdErrTty();
+
+protected:
+    virtual bool isTty() const = 0;
+
+    void updateColorsEnabled();
+
+    ColorMode m_colorMode = ColorMode::Auto;
+    bool m_colorsEnabled = false;
+};
 
 } // namespace QtLogger
-// end appuuidattr.h
 
-#include <QCoreApplication>
-#include <QSettings>
-#include <QUuid>
+// end coloredconsole.h
 
 namespace QtLogger {
 
-QTLOGGER_DECL_SPEC
-AppUuidAttr::AppUuidAttr(const QString &name) : m_name(name)
+class QTLOGGER_EXPORT StdErrSink : public Sink, public ColoredConsole
 {
-    QSettings settings(QSettings::UserScope, QCoreApplication::organizationName(),
-                       QCoreApplication::applicationName());
+public:
+    explicit StdErrSink(ColorMode colorMode = ColorMode::Never);
 
-    auto uuid = settings.value(QStringLiteral("app_uuid")).toString();
+    void send(const LogMessage &lmsg) override;
+    bool flush() override;
 
-    if (uuid.isEmpty()) {
-#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
-        uuid = QUuid::createUuid().toString(QUuid::WithoutBraces);
+protected:
+    bool isTty() const override;
+};
+
+using StdErrSinkPtr = QSharedPointer<StdErrSink>;
+
+} // namespace QtLogger
+
+// end stderrsink.h
+
+#endif
+
+namespace QtLogger {
+
+#if defined(QTLOGGER_ANDROIDLOG)
+using PlatformStdSink = AndroidLogSink;
+#elif defined(QTLOGGER_OSLOG)
+using PlatformStdSink = OslogSink;
 #else
-        uuid = QUuid::createUuid().toString();
-        uuid.remove(QLatin1Char('{')).remove(QLatin1Char('}'));
+using PlatformStdSink = StdErrSink;
 #endif
-        settings.setValue(QStringLiteral("app_uuid"), uuid);
-    }
 
-    m_uuid = uuid;
+using PlatformStdSinkPtr = QSharedPointer<PlatformStdSink>;
+
 }
 
-QTLOGGER_DECL_SPEC
-QVariantHash AppUuidAttr::attributes(const LogMessage &lmsg)
+// end platformstdsink.h
+
+// recordingsink.h
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+// Records a workload for LogReplay: the raw messages with their time, thread, callsite and
+// attributes are written to a single binary log file (see binarylog.h), which is truncated when the
+// sink is created. Placed first in a pipeline, it records the traffic before any filter. With
+// maxCount, only the first messages are recorded, so a sample of production traffic can be taken
+// without limiting the recording by hand.
+class QTLOGGER_EXPORT RecordingSink : public FileSink
 {
-    Q_UNUSED(lmsg)
-    return { { m_name, m_uuid } };
-}
+public:
+    explicit RecordingSink(const QString &path, quint64 maxCount = 0);
+    ~RecordingSink() override;
+
+    void send(const LogMessage &lmsg) override;
+
+    // False if the file can't be written
+    bool isValid() const;
+
+    quint64 maxCount() const;
+    // Messages recorded so far
+    quint64 count() const;
+
+protected:
+    QByteArray encode(const LogMessage &lmsg) override;
+
+private:
+    class RecordingSinkPrivate;
+    QScopedPointer<RecordingSinkPrivate> d;
+    Q_DISABLE_COPY(RecordingSink)
+};
+
+using RecordingSinkPtr = QSharedPointer<RecordingSink>;
 
 } // namespace QtLogger
 
-// hostinfoattrs.cpp
+// end recordingsink.h
 
-#ifdef QTLOGGER_NETWORK
+// signalsink.h
 
-#    include <QHostInfo>
+#include <QObject>
 
 namespace QtLogger {
 
-QTLOGGER_DECL_SPEC
-HostInfoAttrs::HostInfoAttrs()
+class QTLOGGER_EXPORT SignalSink : public QObject, public Sink
 {
-    m_attrs = QVariantHash {
-        { QStringLiteral("host_name"), QHostInfo::localHostName() },
-    };
-}
+    Q_OBJECT
 
-QTLOGGER_DECL_SPEC
-QVariantHash HostInfoAttrs::attributes(const LogMessage &lmsg)
-{
-    Q_UNUSED(lmsg)
-    return m_attrs;
-}
+public:
+    explicit SignalSink(QObject *parent = nullptr);
+
+    void send(const LogMessage &lmsg) override;
+
+Q_SIGNALS:
+    void message(const QtLogger::LogMessage &lmsg);
+};
+
+using SignalSinkPtr = QSharedPointer<SignalSink>;
 
 } // namespace QtLogger
 
-#endif // QTLOGGER_NETWORK
+// end signalsink.h
 
-// seqnumberattr.cpp
+// sinkthread.h
+
+#include <functional>
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QString>
 
 namespace QtLogger {
 
-QTLOGGER_DECL_SPEC
-SeqNumberAttr::SeqNumberAttr(const QString &name) : m_name(name) { }
+// The thread of a sink that owns its sockets, timers or database connection.
+//
+// A sink is called from the thread of an async logger, and with a synchronous logger from every
+// thread that logs. The objects of the sink are created and used only by the functions run in its
+// own thread, so they never move between the sending threads. Settings used by the functions are
+// changed with run(), the rest of the state shared with the sending threads, such as a queue they
+// fill, is guarded by a mutex of the sink. Functions are run in the order they were posted, the
+// ones posted within one event loop iteration of the thread are run in a row.
+//
+// The thread is started by the first function and runs an event loop while the application exists,
+// before and after that it only runs the functions. It is stopped only by stop() or the
+// destructor, so the messages the logger processes while the application quits still reach the
+// sink: the pending functions are completed and the objects are destroyed in the thread. With
+// QTLOGGER_NO_THREAD all functions run directly.
+class QTLOGGER_EXPORT SinkThread
+{
+public:
+    explicit SinkThread(const QString &name);
+    ~SinkThread();
 
-QTLOGGER_DECL_SPEC
-QVariantHash SeqNumberAttr::attributes(const LogMessage &lmsg)
+    // Parent of the objects of the sink, only valid in the functions
+    QObject *context() const;
+
+    // Queues the function to the thread
+    void post(std::function<void()> function);
+
+    // Runs the function in the thread and waits for it to complete
+    void run(const std::function<void()> &function);
+
+    // Completes the pending functions and stops the thread, later functions are dropped
+    void stop();
+
+private:
+    class SinkThreadPrivate;
+    QScopedPointer<SinkThreadPrivate> d;
+    Q_DISABLE_COPY(SinkThread)
+};
+
+} // namespace QtLogger
+
+// end sinkthread.h
+
+// stdoutsink.h
+
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+class QTLOGGER_EXPORT StdOutSink : public Sink, public ColoredConsole
 {
-    Q_UNUSED(lmsg)
-    return { { m_name, m_count++ } };
-}
+public:
+    explicit StdOutSink(ColorMode colorMode = ColorMode::Never);
+
+    void send(const LogMessage &lmsg) override;
+    bool flush() override;
+
+protected:
+    bool isTty() const override;
+};
+
+using StdOutSinkPtr = QSharedPointer<StdOutSink>;
 
 } // namespace QtLogger
 
-// sysinfoattrs.cpp
+// end stdoutsink.h
 
-#include <QSysInfo>
+// termindex.h
+
+#include <QHash>
+#include <QList>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVariantHash>
+
+/*
+ * Term index sidecar format (written by RotatingFileSink when a file is rotated, as
+ * "<log file>.tix"):
+ *
+ *   file  := "QTLT" <u8 version> <u8 hash count> <2 reserved bytes> <u32 bloom size in bytes>
+ *            <bloom filter> <u32 term count> term*
+ *   term  := <u16 size> <utf-8 term> <u32 range count> <i64 range offset>*
+ *
+ * Integers are little endian. The bloom filter holds all terms, so a reader can rule out a term by
+ * reading only the header and the filter. The ranges of a term are the offsets of the time index
+ * entries (see timeindex.h) after which a message with the term was written, so they also select
+ * the blocks of a seekable gzip file. Like the time index, the index keeps the name of the
+ * uncompressed file.
+ *
+ * The terms are those LogSearch matches, so a search finds the same messages with and without the
+ * index: the tokens of the lines of a text log as written, and for a binary log the tokens of the
+ * message text and the values of all attributes, both the whole value and its tokens. Tokens are
+ * runs of letters, digits, '_', '-' and '.' not starting or ending with '-' or '.'. Terms are lower
+ * case and at most MaxTermLength characters.
+ *
+ * The writer keeps the ranges of all terms in memory until the file is rotated. High-cardinality
+ * text, e.g. ids and numbers, can have more than TermIndexWriter::maxRangeCount(); the terms are
+ * then dropped and no index is written for the file, a search reads all of it.
+ */
 
 namespace QtLogger {
 
-QTLOGGER_DECL_SPEC
-SysInfoAttrs::SysInfoAttrs()
+namespace TermIndex {
+
+constexpr char Magic[] = "QTLT";
+constexpr quint8 Version = 1;
+constexpr int HeaderSize = 12;
+
+constexpr int BitsPerTerm = 10;
+constexpr int HashCount = 7;
+constexpr int MaxTermLength = 128;
+
+inline QString indexFileName(const QString &logFileName)
 {
-    m_attrs = QVariantHash {
-        { QStringLiteral("os_name"), QSysInfo::productType() },
-        { QStringLiteral("os_version"), QSysInfo::productVersion() },
-        { QStringLiteral("kernel_type"), QSysInfo::kernelType() },
-        { QStringLiteral("kernel_version"), QSysInfo::kernelVersion() },
-        { QStringLiteral("cpu_arch"), QSysInfo::currentCpuArchitecture() },
-        { QStringLiteral("build_abi"), QSysInfo::buildAbi() },
-        { QStringLiteral("build_cpu_arch"), QSysInfo::buildCpuArchitecture() },
-        { QStringLiteral("pretty_product_name"), QSysInfo::prettyProductName() },
-        { QStringLiteral("machine_host_name"), QSysInfo::machineHostName() },
-#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
-        { QStringLiteral("machine_unique_id"), QString::fromLatin1(QSysInfo::machineUniqueId()) },
-        { QStringLiteral("boot_unique_id"), QString::fromLatin1(QSysInfo::bootUniqueId()) },
-#endif
-    };
+    return logFileName + QStringLiteral(".tix");
 }
 
-QTLOGGER_DECL_SPEC
-QVariantHash SysInfoAttrs::attributes(const LogMessage &lmsg)
+QTLOGGER_EXPORT QString normalizeTerm(const QString &term);
+QTLOGGER_EXPORT QStringList tokenize(const QString &text);
+
+// Tokens of the text and the values of the attributes, whole and tokenized
+QTLOGGER_EXPORT QStringList terms(const QString &text,
+                                  const QVariantHash &attributes = QVariantHash());
+
+} // namespace TermIndex
+
+// Collects the terms of the messages of one log file and writes its index
+class QTLOGGER_EXPORT TermIndexWriter
 {
-    Q_UNUSED(lmsg)
-    return m_attrs;
-}
+public:
+    static constexpr int DefaultMaxRangeCount = 1024 * 1024;
 
-} // namespace QtLogger
+    TermIndexWriter();
+    ~TermIndexWriter();
 
-// configure.cpp
+    // Adds the terms of a binary log record written after the time index entry at rangeOffset:
+    // its message text and attributes
+    void add(const LogMessage &lmsg, qint64 rangeOffset);
 
-#include <QLoggingCategory>
-#include <QRegularExpression>
-#include <QUrl>
-#include <QtCore/QtGlobal>
+    // Adds the terms of text written after the time index entry at rangeOffset
+    void addText(const QString &text, qint64 rangeOffset);
 
-#ifdef QTLOGGER_NETWORK
+    // Limit of the ranges of all terms kept in memory, every term has at least one
+    int maxRangeCount() const;
+    void setMaxRangeCount(int count);
 
-#endif
+    // Ranges of all terms added since the last reset, 0 after the limit was exceeded
+    int rangeCount() const;
 
-#ifdef QTLOGGER_SYSLOG
+    // False if the terms added since the last reset exceeded maxRangeCount() and were dropped
+    bool isComplete() const;
 
-#endif
+    // Writes the index of the terms added since the last reset, false if it isn't complete
+    bool write(const QString &indexFileName) const;
+    void reset();
 
-#ifdef QTLOGGER_SDJOURNAL
+private:
+    class TermIndexWriterPrivate;
+    QScopedPointer<TermIndexWriterPrivate> d;
+    Q_DISABLE_COPY(TermIndexWriter)
+};
 
-#endif
+// Reads the bloom filter of a term index right away and its terms on first use
+class QTLOGGER_EXPORT TermIndexReader
+{
+public:
+    explicit TermIndexReader(const QString &indexFileName);
+    ~TermIndexReader();
 
-#ifdef QTLOGGER_OSLOG
+    bool isValid() const;
 
-#endif
+    // False if the file has no message with the term, true if it may have
+    bool mayContain(const QString &term) const;
 
-#ifdef QTLOGGER_ANDROIDLOG
+    // Range offsets of the messages with the term, in ascending order
+    QList<qint64> ranges(const QString &term) const;
 
-#endif
+private:
+    class TermIndexReaderPrivate;
+    QScopedPointer<TermIndexReaderPrivate> d;
+    Q_DISABLE_COPY(TermIndexReader)
+};
 
-#ifndef QTLOGGER_NO_THREAD
+} // namespace QtLogger
 
-#endif
+// end termindex.h
+
+// timeindex.h
+
+#include <QDateTime>
+#include <QList>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+
+/*
+ * Time index sidecar format (written by FileSink next to the log file as "<log file>.idx"):
+ *
+ *   file  := "QTLI" <u8 version> <3 reserved bytes> entry*
+ *   entry := <i64 time, ms since epoch> <i64 byte offset in the log file>
+ *
+ * Integers are little endian. An entry is written for the first message of a file and then for
+ * the first message after the interval in bytes or in time has passed. Entry times never decrease,
+ * so an index can be binary searched even if messages arrive slightly out of order.
+ *
+ * Rotated files keep their index: "app.log.idx" becomes "app.2024-05-15.1.log.idx". Offsets refer
+ * to the uncompressed file, also after "app.2024-05-15.1.log" is compressed.
+ */
 
 namespace QtLogger {
 
-QTLOGGER_DECL_SPEC
-void configure(Pipeline *pipeline, const QString &path, int maxFileSize, int maxFileCount,
-               RotatingFileSink::Options options, bool async)
-{
-    if (!pipeline) {
-        return;
-    }
+namespace TimeIndex {
 
-    *pipeline << PrettyFormatterPtr::create(true);
-    *pipeline << PlatformStdSinkPtr::create();
+constexpr char Magic[] = "QTLI";
+constexpr quint8 Version = 1;
+constexpr int HeaderSize = 8;
+constexpr int EntrySize = 16;
 
-    if (!path.isEmpty()) {
-        *pipeline << FunctionFormatterPtr::create([](const LogMessage &lmsg) {
-            auto fmsg = lmsg.formattedMessage();
-            static const QRegularExpression ansiEscape(QStringLiteral("\033\\[[0-9;]*m"));
-            fmsg.remove(ansiEscape);
-            return fmsg;
-        });
+constexpr int DefaultIntervalBytes = 64 * 1024;
+constexpr int DefaultIntervalMsecs = 1000;
 
-        if (maxFileSize > 0 || options.testFlag(RotatingFileSink::RotationOnStartup)
-            || options.testFlag(RotatingFileSink::RotationDaily)) {
-            *pipeline << RotatingFileSinkPtr::create(path, maxFileSize, maxFileCount, options);
-        } else {
-            *pipeline << FileSinkPtr::create(path);
-        }
-    }
+struct Entry
+{
+    qint64 time;
+    qint64 offset;
+};
 
-#ifndef QTLOGGER_NO_THREAD
-    if (async) {
-        auto *ownThreadLogger = dynamic_cast<OwnThreadHandler<SimplePipeline> *>(pipeline);
-        if (ownThreadLogger) {
-            ownThreadLogger->moveToOwnThread();
-        }
-    }
-#else
-    Q_UNUSED(async)
-#endif
+inline QString indexFileName(const QString &logFileName)
+{
+    return logFileName + QStringLiteral(".idx");
 }
 
-QTLOGGER_DECL_SPEC
-void configure(Pipeline *pipeline, const QSettings &settings, const QString &group)
+// Entries of an index file, empty if the file is missing or invalid
+QTLOGGER_EXPORT QList<Entry> readEntries(const QString &indexFileName);
+
+} // namespace TimeIndex
+
+class QTLOGGER_EXPORT TimeIndexWriter
 {
-    if (!pipeline) {
-        return;
-    }
+public:
+    TimeIndexWriter(int intervalBytes = TimeIndex::DefaultIntervalBytes,
+                    int intervalMsecs = TimeIndex::DefaultIntervalMsecs);
+    ~TimeIndexWriter();
 
-    const auto filterRules = settings.value(group + QStringLiteral("/filter_rules")).toString();
-    if (!filterRules.isEmpty()) {
-#ifdef QTLOGGER_DEBUG
-        std::cerr << "configure: filterRules: " << filterRules.toStdString() << std::endl;
-#endif
-        *pipeline << CategoryFilterPtr::create(filterRules);
-    }
+    int intervalBytes() const;
+    int intervalMsecs() const;
 
-    const auto regExpFilter = settings.value(group + QStringLiteral("/regexp_filter")).toString();
-    if (!regExpFilter.isEmpty()) {
-#ifdef QTLOGGER_DEBUG
-        std::cerr << "configure: filter: " << regExpFilter.toStdString() << std::endl;
-#endif
-        *pipeline << RegExpFilterPtr::create(regExpFilter);
-    }
+    // Called before a message is written at the offset of the log file. A new index is started
+    // at offset 0, otherwise an existing index is continued.
+    void add(const QString &logFileName, const QDateTime &time, qint64 offset);
 
-    const auto messagePattern =
-            settings.value(group + QStringLiteral("/message_pattern")).toString();
-    if (!messagePattern.isEmpty()) {
-#ifdef QTLOGGER_DEBUG
-        std::cerr << "configure: messagePattern: " << messagePattern.toStdString() << std::endl;
-#endif
-        *pipeline << PatternFormatterPtr::create(messagePattern);
-    } else {
-        *pipeline << PrettyFormatter::instance();
-    }
+    // Offset of the last entry written, -1 if there is none
+    qint64 lastOffset() const;
 
-    const auto stdout = settings.value(group + QStringLiteral("/stdout"), false).toBool();
-    const auto stdoutColor =
-            settings.value(group + QStringLiteral("/stdout_color"), false).toBool();
-    if (stdout || stdoutColor) {
-#ifdef QTLOGGER_DEBUG
-        std::cerr << "configure: stdout (color=" << stdoutColor << ")" << std::endl;
-#endif
-        *pipeline << StdOutSinkPtr::create(stdoutColor ? ColorMode::Auto : ColorMode::Never);
-    }
+    // Closes the index, e.g. before the log file is renamed
+    void close();
+    bool flush();
 
-    const auto stderr = settings.value(group + QStringLiteral("/stderr"), false).toBool();
-    const auto stderrColor =
-            settings.value(group + QStringLiteral("/stderr_color"), false).toBool();
-    if (stderr || stderrColor) {
-#ifdef QTLOGGER_DEBUG
-        std::cerr << "configure: stderr (color=" << stderrColor << ")" << std::endl;
-#endif
-        *pipeline << StdErrSinkPtr::create(stderrColor ? ColorMode::Auto : ColorMode::Never);
-    }
+private:
+    class TimeIndexWriterPrivate;
+    QScopedPointer<TimeIndexWriterPrivate> d;
+    Q_DISABLE_COPY(TimeIndexWriter)
+};
 
-    if (settings.value(group + QStringLiteral("/platform_std_log"), true).toBool()) {
-#ifdef QTLOGGER_DEBUG
-        std::cerr << "configure: platform_std_log" << std::endl;
-#endif
-        *pipeline << PlatformStdSinkPtr::create();
-    }
+// Reads a text log and its rotated files from a point in time.
+//
+// seek() finds the newest file whose index has an entry before the time and binary searches it for
+// the last such entry, so reading starts at a message shortly before the time instead of at the
+// start of the oldest file. Newer files without an index are read after it, and all files are read
+// from the start if none has such an entry. Compressed files
+// are read if they have a block index (RotatingFileSink::BlockCompression), decompressing only the
+// blocks from the position on.
+class QTLOGGER_EXPORT TimeIndexReader
+{
+public:
+    // The path of the active log file, as given to the sink
+    explicit TimeIndexReader(const QString &logFileName);
+    ~TimeIndexReader();
 
-#ifdef QTLOGGER_SYSLOG
-    const auto syslogIdent = settings.value(group + QStringLiteral("/syslog_ident")).toString();
-    if (!syslogIdent.isEmpty()) {
-#    ifdef QTLOGGER_DEBUG
-        std::cerr << "configure: syslogIdent: " << syslogIdent.toStdString() << std::endl;
-#    endif
-        *pipeline << SyslogSinkPtr::create(syslogIdent);
-    }
-#endif
+    // Files of the log that can be read, oldest first
+    QStringList files() const;
 
-#ifdef QTLOGGER_SDJOURNAL
-    if (settings.value(group + QStringLiteral("/sdjournal"), false).toBool()) {
-#    ifdef QTLOGGER_DEBUG
-        std::cerr << "configure: sd-journal" << std::endl;
-#    endif
-        *pipeline << SdJournalSinkPtr::create();
-    }
-#endif
+    bool seek(const QDateTime &time);
 
-    const auto path = settings.value(group + QStringLiteral("/path")).toString();
-    if (!path.isEmpty()) {
-        const auto maxFileSize = settings.value(group + QStringLiteral("/max_file_size"),
-                                                RotatingFileSink::DefaultMaxFileSize)
-                                         .toInt();
+    QString fileName() const;
+    qint64 offset() const;
 
-        const auto maxFileCount = settings.value(group + QStringLiteral("/max_file_count"),
-                                                 RotatingFileSink::DefaultMaxFileCount)
-                                          .toInt();
+    // Lines from the current position on, continuing with the next files; reads to the end
+    // without seek()
+    bool atEnd();
+    QByteArray readLine();
 
-        const auto rotateOnStartup =
-                settings.value(group + QStringLiteral("/rotate_on_startup"), true).toBool();
+private:
+    class TimeIndexReaderPrivate;
+    QScopedPointer<TimeIndexReaderPrivate> d;
+    Q_DISABLE_COPY(TimeIndexReader)
+};
 
-        const auto rotateDaily =
-                settings.value(group + QStringLiteral("/rotate_daily"), false).toBool();
+} // namespace QtLogger
 
-        const auto compress =
-                settings.value(group + QStringLiteral("/compress_old_files"), false).toBool();
+// end timeindex.h
 
-#ifdef QTLOGGER_DEBUG
-        std::cerr << "configure: path: " << path.toStdString() << " maxFileSize: " << maxFileSize
-                  << " maxFileCount: " << maxFileCount << " rotateOnStartup: " << rotateOnStartup
-                  << " rotateDaily: " << rotateDaily << " compress: " << compress << std::endl;
-#endif
+// utils.h
 
-        RotatingFileSink::Options options = RotatingFileSink::Option::None;
-        if (rotateOnStartup)
-            options |= RotatingFileSink::RotationOnStartup;
-        if (rotateDaily)
-            options |= RotatingFileSink::RotationDaily;
-        if (compress)
-            options |= RotatingFileSink::Option::Compression;
+#include <qlogging.h>
 
-        *pipeline << RotatingFileSinkPtr::create(path, maxFileSize, maxFileCount, options);
-    }
+namespace QtLogger {
 
-#ifdef QTLOGGER_NETWORK
-    const auto httpUrl = settings.value(group + QStringLiteral("/http_url")).toString();
-    if (!httpUrl.isEmpty()) {
-        const auto httpMsgFormat = settings.value(group + QStringLiteral("/http_msg_format"),
-                                                  QStringLiteral("default"))
-                                           .toString();
-        // TODO: add support for http_msg_format (json)
-        *pipeline << HttpSinkPtr::create(QUrl(httpUrl));
-    }
-#endif
+/** Set global filter rules
+ *
+ *  Format:  "[<category>|*].[debug|info|warning|critical]=true|false;..."
+ *  Example: "app.*.debug=false;app.logger.debug=true"
+ */
 
-#ifndef QTLOGGER_NO_THREAD
-    if (settings.value(group + QStringLiteral("/async"), false).toBool()) {
-#    ifdef QTLOGGER_DEBUG
-        std::cerr << "configure: async" << std::endl;
-#    endif
-        auto *ownThreadLogger = dynamic_cast<OwnThreadHandler<SimplePipeline> *>(pipeline);
-        if (ownThreadLogger) {
-            ownThreadLogger->moveToOwnThread();
-        }
-    }
-#endif
-}
+QTLOGGER_EXPORT void setFilterRules(const QString &rules);
 
-QTLOGGER_DECL_SPEC
-void configureFromIniFile(Pipeline *pipeline, const QString &path, const QString &group)
-{
-    configure(pipeline, QSettings(path, QSettings::IniFormat), group);
-}
+/** Set global message pattern
+ *
+ * Following placeholders are supported:
+ * %{appname} %{category} %{file} %{function} %{line} %{message} %{pid} %{threadid}
+ * %{qthreadptr} %{type} %{time process} %{time boot} %{time [format]} %{backtrace [depth=N]
+ * [separator="..."]}
+ *
+ * %{backtrace} symbolizes the stack in the calling thread; BacktraceAttr only captures the return
+ * addresses there and resolves them in the thread of the logger.
+ */
+
+QTLOGGER_EXPORT QString setMessagePattern(const QString &messagePattern);
+
+QTLOGGER_EXPORT QString restorePreviousMessagePattern();
 
 } // namespace QtLogger
 
-// categoryfilter.cpp
+// end utils.h
 
-#include <QRegularExpression>
-#include <qlogging.h>
+#ifdef QTLOGGER_NETWORK
+
+// hostinfoattrs.h
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QSharedPointer>
 
 namespace QtLogger {
 
-struct CategoryFilter::Rule
+class QTLOGGER_EXPORT HostInfoAttrs : public AttrHandler
 {
-    QRegularExpression category;
-    QtMsgType type;
-    bool typeMatch;
-    bool enabled;
+public:
+    HostInfoAttrs();
 
-    bool matches(const QString &category, QtMsgType messageType) const;
+    QVariantHash attributes(const LogMessage &lmsg) override;
+
+private:
+    QVariantHash m_attrs;
 };
 
-QTLOGGER_DECL_SPEC
-CategoryFilter::CategoryFilter(const QString &a_rules)
-{
-    auto rules = a_rules;
-    rules.replace(";", "\n");
-    parseRules(rules);
-}
+using HostInfoAttrsPtr = QSharedPointer<HostInfoAttrs>;
 
-QTLOGGER_DECL_SPEC
-void CategoryFilter::parseRules(const QString &rules)
-{
-#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-    const auto lines = rules.split('\n', Qt::SkipEmptyParts);
-#else
-    const auto lines = rules.split('\n', QString::SkipEmptyParts);
-#endif
-    for (const auto &line : lines) {
-        const auto ruleRegex = QRegularExpression(
-                R"(^\s*(\S+?)(?:\.(debug|info|warning|critical))?\s*=\s*(true|false)\s*$)");
+} // namespace QtLogger
 
-        const auto match = ruleRegex.match(line);
+#endif // QTLOGGER_NETWORK
 
-        if (!match.hasMatch())
-            continue;
+// end hostinfoattrs.h
 
-        auto rule = QSharedPointer<Rule>::create();
+// logcollector.h
 
-        auto category = match.captured(1);
-        category = QRegularExpression::escape(category);
-        category.replace("\\*", ".*");
+#ifdef QTLOGGER_NETWORK
 
-        rule->category = QRegularExpression("^" + category + "$");
-        rule->type = stringToQtMsgType(match.captured(2));
-        rule->typeMatch = !match.captured(2).isEmpty();
-        rule->enabled = match.captured(3) == "true";
+#include <QScopedPointer>
+#include <QString>
 
-        m_rules.append(rule);
-    }
-}
+namespace QtLogger {
 
-QTLOGGER_DECL_SPEC
-bool CategoryFilter::Rule::matches(const QString &category, QtMsgType messageType) const
+// Receives messages from the LocalSocketSinks of many processes and passes them to one pipeline,
+// so the log files of a host are written and rotated by a single process. The received messages
+// have the appname and pid attributes of their process.
+//
+// Connections are served in the thread of the collector, which needs an event loop. The sinks
+// of the pipeline are flushed after every batch of received messages.
+class QTLOGGER_EXPORT LogCollector
 {
-    return this->category.match(category).hasMatch() && (!typeMatch || type == messageType);
-}
+public:
+    LogCollector();
+    ~LogCollector();
 
-QTLOGGER_DECL_SPEC
-bool CategoryFilter::filter(const LogMessage &lmsg)
-{
-    bool enabled = true;
-    for (const auto &rule : std::as_const(m_rules)) {
-        if (rule->matches(lmsg.category(), lmsg.type())) {
-            enabled = rule->enabled;
-        }
-    }
-    return enabled;
-}
+    // Pipeline for the received messages, e.g. collector.pipeline().formatPretty().sendToFile(...)
+    SimplePipeline &pipeline();
 
-} // namespace QtLogger
+    bool listen(const QString &serverName);
+    void close();
+    bool isListening() const;
 
-// duplicatefilter.cpp
+    QString serverName() const;
+    QString errorString() const;
 
-namespace QtLogger {
+    int connectionCount() const;
+    quint64 messageCount() const;
 
-QTLOGGER_DECL_SPEC
-bool DuplicateFilter::filter(const LogMessage &lmsg)
-{
-    if (lmsg.message() == m_lastMessage) {
-        return false;
-    }
+private:
+    class LogCollectorPrivate;
+    QScopedPointer<LogCollectorPrivate> d;
+    Q_DISABLE_COPY(LogCollector)
+};
 
-    m_lastMessage = lmsg.message();
+} // namespace QtLogger
 
-    return true;
-}
+#endif // QTLOGGER_NETWORK
 
-} // namespace QtLogger
+// end logcollector.h
 
-// regexpfilter.cpp
+// httpsink.h
 
-#include <QRegularExpression>
+#ifdef QTLOGGER_NETWORK
 
-namespace QtLogger {
+#include <QNetworkRequest>
+#include <QSharedPointer>
+#include <QPointer>
+#include <QUrl>
 
-QTLOGGER_DECL_SPEC
-RegExpFilter::RegExpFilter(const QRegularExpression &regExp) : m_regExp(regExp) { }
+QT_FORWARD_DECLARE_CLASS(QNetworkAccessManager)
 
-QTLOGGER_DECL_SPEC
-QtLogger::RegExpFilter::RegExpFilter(const QString &regExp) : m_regExp(QRegularExpression(regExp))
-{
-}
+namespace QtLogger {
 
-QTLOGGER_DECL_SPEC
-bool RegExpFilter::filter(const LogMessage &lmsg)
+class QTLOGGER_EXPORT HttpSink : public Sink
 {
-    return m_regExp.match(lmsg.message()).hasMatch();
-}
+public:
+    using Headers = QList<QPair<QByteArray, QByteArray>>;
+
+    explicit HttpSink(const QUrl &url);
+    HttpSink(const QUrl &url, const Headers &headers);
+    ~HttpSink();
+
+    void send(const LogMessage &lmsg) override;
+
+    void setNetworkAccessManager(QNetworkAccessManager *manager);
+    void setRequest(const QNetworkRequest &request);
+    void setHeaders(const Headers &headers);
+
+private:
+    void init();
+
+    QUrl m_url;
+    Headers m_headers;
+    QPointer<QNetworkAccessManager> m_manager;
+    QNetworkRequest m_request;
+};
+
+using HttpSinkPtr = QSharedPointer<HttpSink>;
 
 } // namespace QtLogger
 
-// jsonformatter.cpp
+#endif // QTLOGGER_NETWORK
 
-#include <QCoreApplication>
-#include <QJsonDocument>
-#include <QJsonObject>
+// end httpsink.h
+
+// localsocketsink.h
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QScopedPointer>
+#include <QSharedPointer>
 
 namespace QtLogger {
 
-JsonFormatter::JsonFormatter(bool compact)
-    : m_compact(compact)
+// Streams messages to a LogCollector over a local socket (a Unix domain socket, a named pipe on
+// Windows) in the binary log format. Every connection is a binary log session that starts with the
+// appname and pid attributes of the process, the collector adds them to the received messages.
+//
+// Messages sent until the thread of the sink gets to them are written as a single batch. The socket
+// lives in that thread and never blocks the calling thread: messages are queued by the calling
+// thread in a bounded queue, the oldest ones are dropped when it's full, e.g. until the collector
+// accepts the connection or while a slow collector hasn't read the previous batch. Messages the
+// socket hasn't sent when the connection is lost are queued again for the next one.
+class QTLOGGER_EXPORT LocalSocketSink : public Sink
 {
-}
+public:
+    static constexpr int DefaultMaxPendingCount = 10000;
 
-QTLOGGER_DECL_SPEC
-QString JsonFormatter::format(const LogMessage &lmsg)
-{
-    QJsonObject obj;
+    explicit LocalSocketSink(const QString &serverName);
+    ~LocalSocketSink() override;
 
-    const auto attrs = lmsg.allAttributes();
-    for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
-        obj.insert(it.key(), QJsonValue::fromVariant(it.value()));
-    }
+    void send(const LogMessage &lmsg) override;
+    bool flush() override;
 
-    return QString::fromUtf8(QJsonDocument(obj).toJson(m_compact ? QJsonDocument::Compact
-                                                                 : QJsonDocument::Indented));
-}
+    QString serverName() const;
+
+    // Maximum number of queued messages, e.g. while not connected
+    int maxPendingCount() const;
+    void setMaxPendingCount(int count);
+
+private:
+    class LocalSocketSinkPrivate;
+    QScopedPointer<LocalSocketSinkPrivate> d;
+    Q_DISABLE_COPY(LocalSocketSink)
+};
+
+using LocalSocketSinkPtr = QSharedPointer<LocalSocketSink>;
 
 } // namespace QtLogger
 
-// patternformatter.cpp
+#endif // QTLOGGER_NETWORK
 
-#include <optional>
+// end localsocketsink.h
+
+// otlpsink.h
 
+#ifdef QTLOGGER_NETWORK
+
+#include <QJsonObject>
+#include <QList>
+#include <QPair>
+#include <QScopedPointer>
 #include <QSharedPointer>
+#include <QUrl>
+#include <QVariantHash>
 
 namespace QtLogger {
 
-namespace {
+// Exports messages to an OpenTelemetry collector as OTLP/HTTP JSON.
+//
+// Messages are mapped to OTLP log records and exported in batches like the batch log record
+// processor of the OpenTelemetry SDKs: a batch is sent when maxExportBatchSize() records are
+// queued or scheduleDelay() has passed, one export at a time. Records arriving while the queue
+// holds maxQueueSize() records are dropped.
+//
+// The network access manager lives in a thread of the sink, so the sending threads need no event
+// loop. Records are queued in the calling thread.
+class QTLOGGER_EXPORT OtlpSink : public Sink
+{
+public:
+    using Headers = QList<QPair<QByteArray, QByteArray>>;
 
-static const auto g_processStartTime = std::chrono::steady_clock::now();
+    static constexpr int DefaultMaxQueueSize = 2048;
+    static constexpr int DefaultMaxExportBatchSize = 512;
+    static constexpr int DefaultScheduleDelay = 1000; // ms
+    static constexpr int DefaultExportTimeout = 30000; // ms
 
-static const QChar DEL_MARKER = QChar(0x200B);
+    // An endpoint without a path gets the OTLP logs path "/v1/logs"
+    explicit OtlpSink(const QUrl &endpoint);
+    OtlpSink(const QUrl &endpoint, const Headers &headers);
+    ~OtlpSink() override;
 
-class Token
-{
-public:
-    virtual ~Token() = default;
-    virtual size_t estimatedLength() const = 0;
-    virtual bool checkCondition(const LogMessage &) const { return true; }
-    virtual void appendToString(const LogMessage &lmsg, QString &dest) const = 0;
-};
+    void send(const LogMessage &lmsg) override;
+    // Starts the export of all queued records
+    bool flush() override;
 
-class ConditionToken : public Token
-{
-public:
-    bool checkCondition(const LogMessage &lmsg) const override
-    {
-        if (!m_hasCondition) {
-            return true;
-        }
-        return lmsg.type() == m_condition;
-    }
+    QUrl endpoint() const;
+    void setHeaders(const Headers &headers);
 
-    QtMsgType condition() const { return m_condition; }
+    // Attributes of the resource the records belong to, defaultResourceAttributes() by default
+    QVariantHash resourceAttributes() const;
+    void setResourceAttributes(const QVariantHash &attributes);
 
-    void setCondition(QtMsgType condition)
-    {
-        m_condition = condition;
-        m_hasCondition = true;
-    }
+    int maxQueueSize() const;
+    void setMaxQueueSize(int maxQueueSize);
+
+    int maxExportBatchSize() const;
+    void setMaxExportBatchSize(int maxExportBatchSize);
+
+    int scheduleDelay() const;
+    void setScheduleDelay(int msecs);
+
+    int exportTimeout() const;
+    void setExportTimeout(int msecs);
+
+    // Records accepted by the collector, and records dropped because the queue was full or the
+    // export failed
+    quint64 exportedCount() const;
+    quint64 droppedCount() const;
+
+    // SysInfoAttrs and AppInfoAttrs with OpenTelemetry semantic convention names
+    static QVariantHash defaultResourceAttributes();
+
+    // OTLP LogRecord of a message
+    static QJsonObject toLogRecord(const LogMessage &lmsg);
+
+    // ExportLogsServiceRequest with the messages grouped into scopes by category
+    static QByteArray exportRequest(const QList<LogMessage> &messages,
+                                    const QVariantHash &resourceAttributes);
 
 private:
-    QtMsgType m_condition = QtDebugMsg;
-    bool m_hasCondition = false;
+    class OtlpSinkPrivate;
+    QScopedPointer<OtlpSinkPrivate> d;
+    Q_DISABLE_COPY(OtlpSink)
 };
 
-class FormattedToken : public ConditionToken
+using OtlpSinkPtr = QSharedPointer<OtlpSink>;
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
+
+// end otlpsink.h
+
+// tcpsink.h
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+// Streams formatted messages to a TCP server, framed by IODeviceSink::frame() without terminal
+// colors. Text is sent in UTF-8 with both framings.
+//
+// Frames are queued in a bounded buffer and written in batches: everything sent within one event
+// loop iteration goes to the socket with a single write, and at most 64 KB are handed to the
+// socket until it has sent them, so a slow peer fills the buffer of the sink instead of the socket.
+// When the buffer is full, messages are dropped according to the drop policy.
+//
+// The socket lives in a thread of the sink, so the sending threads need no event loop. Lost
+// connections are reestablished with exponential backoff; frames already handed to the socket
+// when the connection is lost are lost with it.
+class QTLOGGER_EXPORT TcpSink : public Sink
 {
 public:
-    enum class Alignment { None, Left, Right, Center };
-    enum class TruncateMode { None, Truncate, TruncateOnly };
+    using Framing = IODeviceSink::Framing;
 
-    struct FormatSpec
-    {
-        QChar fill = QLatin1Char(' ');
-        Alignment align = Alignment::None;
-        int width = 0;
-        TruncateMode truncateMode = TruncateMode::None;
+    enum class DropPolicy {
+        DropOldest, // Discard the oldest queued messages to make room
+        DropNewest // Discard the message being sent
     };
 
-    void setFormatSpec(const FormatSpec &spec) { m_spec = spec; }
+    static constexpr int DefaultMaxBufferSize = 4 * 1024 * 1024;
+    static constexpr int DefaultMinReconnectDelay = 100; // ms
+    static constexpr int DefaultMaxReconnectDelay = 30000; // ms
 
-    static std::optional<FormatSpec> parseFormatSpec(const QString &specString)
-    {
-        if (specString.isEmpty())
-            return std::nullopt;
+    TcpSink(const QString &host, quint16 port, Framing framing = Framing::Newline);
+    ~TcpSink() override;
 
-        QString s = specString;
-        int pos = 0;
-        FormatSpec spec;
-        bool hasExplicitFill = false;
-        bool hasTruncateSuffix = false;
+    void send(const LogMessage &lmsg) override;
+    bool flush() override;
 
-        if (s.endsWith(QLatin1Char('!'))) {
-            hasTruncateSuffix = true;
-            s.chop(1);
-            if (s.isEmpty())
-                return std::nullopt;
-        }
+    QString host() const;
+    quint16 port() const;
+    Framing framing() const;
 
-        // Check if we have fill + align (fill is any char, align is <, >, ^)
-        if (s.length() >= 2) {
-            QChar possibleAlign = s.at(1);
-            if (QStringLiteral("<^>").contains(possibleAlign)) {
-                spec.fill = s.at(0);
-                spec.align = charToAlignment(possibleAlign);
-                hasExplicitFill = true;
-                pos = 2;
-            }
-        }
+    int maxBufferSize() const;
+    void setMaxBufferSize(int maxBufferSize);
 
-        // If no fill+align found, check for just align
-        if (spec.align == Alignment::None && !s.isEmpty()) {
-            QChar possibleAlign = s.at(0);
-            if (QStringLiteral("<^>").contains(possibleAlign)) {
-                spec.align = charToAlignment(possibleAlign);
-                pos = 1;
-            }
-        }
+    DropPolicy dropPolicy() const;
+    void setDropPolicy(DropPolicy dropPolicy);
 
-        // If no align found, check if it's just a number (only valid with !)
-        if (spec.align == Alignment::None && hasTruncateSuffix) {
-            // Try to parse entire remaining string as width
-            bool ok;
-            spec.width = s.toInt(&ok);
-            if (ok && spec.width > 0) {
-                spec.truncateMode = TruncateMode::TruncateOnly;
-                return spec;
-            }
-            return std::nullopt;
-        }
+    // The delay starts at the minimum and doubles after every failed attempt
+    int minReconnectDelay() const;
+    int maxReconnectDelay() const;
+    void setReconnectDelay(int minDelay, int maxDelay);
 
-        // If no align found at all (and not truncate-only), this is not a valid format spec
-        if (spec.align == Alignment::None)
-            return std::nullopt;
+    bool isConnected() const;
+    quint64 droppedCount() const;
 
-        // Parse width (remaining characters should be digits)
-        if (pos >= s.length())
-            return std::nullopt;
+private:
+    class TcpSinkPrivate;
+    QScopedPointer<TcpSinkPrivate> d;
+    Q_DISABLE_COPY(TcpSink)
+};
 
-        QString widthStr = s.mid(pos);
-        bool ok;
-        spec.width = widthStr.toInt(&ok);
-        if (!ok || spec.width <= 0)
-            return std::nullopt;
+using TcpSinkPtr = QSharedPointer<TcpSink>;
 
-        // Determine truncate mode
-        if (hasTruncateSuffix) {
-            spec.truncateMode = hasExplicitFill ? TruncateMode::Truncate : TruncateMode::TruncateOnly;
-        }
+} // namespace QtLogger
 
-        return spec;
-    }
+#endif // QTLOGGER_NETWORK
 
-    bool hasFormatSpec() const
-    {
-        return m_spec.width > 0
-               && (m_spec.align != Alignment::None
-                   || m_spec.truncateMode == TruncateMode::TruncateOnly);
-    }
+// end tcpsink.h
 
-    static Alignment charToAlignment(QChar ch)
-    {
-        switch (ch.unicode()) {
-        case '<':
-            return Alignment::Left;
-        case '>':
-            return Alignment::Right;
-        case '^':
-            return Alignment::Center;
-        default:
-            return Alignment::None;
-        }
-    }
+#endif
 
-    int formatWidth() const { return m_spec.width; }
+#ifdef Q_OS_WIN
 
-protected:
-    QString applyPadding(const QString &value) const
-    {
-        if (m_spec.width <= 0) {
-            return value;
-        }
+// windebugsink.h
 
-        if (m_spec.truncateMode == TruncateMode::TruncateOnly) {
-            if (value.length() <= m_spec.width) {
-                return value;
-            }
-            if (m_spec.align == Alignment::Right) {
-                return value.right(m_spec.width);
-            } else {
-                return value.left(m_spec.width);
-            }
-        }
+#ifdef Q_OS_WIN
 
-        if (m_spec.align == Alignment::None) {
-            return value;
-        }
+#include <QSharedPointer>
 
-        QString val = value;
+namespace QtLogger {
 
-        if (m_spec.truncateMode == TruncateMode::Truncate
-            && val.length() > m_spec.width) {
-            if (m_spec.align == Alignment::Right) {
-                val = val.right(m_spec.width);
-            } else {
-                val = val.left(m_spec.width);
-            }
-        }
+class QTLOGGER_EXPORT WinDebugSink : public Sink
+{
+public:
+    void send(const LogMessage &lmsg) override;
+};
 
-        if (val.length() >= m_spec.width) {
-            return val;
-        }
+using WinDebugSinkPtr = QSharedPointer<WinDebugSink>;
 
-        int padding = m_spec.width - val.length();
-        QString result;
-        result.reserve(m_spec.width);
+} // namespace QtLogger
 
-        switch (m_spec.align) {
-        case Alignment::Left:
-            result.append(val);
-            result.append(QString(padding, m_spec.fill));
-            break;
-        case Alignment::Right:
-            result.append(QString(padding, m_spec.fill));
-            result.append(val);
-            break;
-        case Alignment::Center: {
-            int leftPad = padding / 2;
-            int rightPad = padding - leftPad;
-            result.append(QString(leftPad, m_spec.fill));
-            result.append(val);
-            result.append(QString(rightPad, m_spec.fill));
-            break;
-        }
-        case Alignment::None:
-            return val;
-        }
+#endif
 
-        return result;
-    }
+// end windebugsink.h
 
-private:
-    FormatSpec m_spec;
-};
+#endif
 
-class LiteralToken : public FormattedToken
-{
-public:
-    explicit LiteralToken(const QString &text) : m_text(text) { }
+#ifdef QTLOGGER_IOSLOG
 
-    void appendToString(const LogMessage &, QString &dest) const override
-    {
-        int removeCount = 0;
-        while (!dest.isEmpty() && dest.at(dest.size() - 1) == DEL_MARKER) {
-            dest.chop(1);
-            removeCount++;
-        }
+#endif
 
-        if (removeCount > 0 && removeCount < m_text.size()) {
-            dest.append(m_text.mid(removeCount));
-        } else if (removeCount == 0) {
-            dest.append(m_text);
-        }
+#ifdef QTLOGGER_ANDROIDLOG
 
-        // If removeCount >= m_text.size(), append nothing
-    }
+#endif
 
-    size_t estimatedLength() const override { return m_text.size(); }
+#ifdef QTLOGGER_SYSLOG
 
-private:
-    QString m_text;
-};
+// syslogsink.h
 
-class MessageToken : public FormattedToken
-{
-public:
-    MessageToken() { }
+#ifdef QTLOGGER_SYSLOG
 
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
-    {
-        dest.append(applyPadding(lmsg.message()));
-    }
+#include <QSharedPointer>
 
-    size_t estimatedLength() const override
-    {
-        return hasFormatSpec() ? formatWidth() : 50; // Estimated average message length
-    }
-};
+// Syslog options
+// See syslog.h for more information
+#define QTLOGGER_SYSLOG_LOG_PID  0x01
+#define QTLOGGER_SYSLOG_LOG_USER (1 << 3)
 
-class TypeToken : public FormattedToken
+namespace QtLogger {
+
+class QTLOGGER_EXPORT SyslogSink : public Sink
 {
 public:
-    TypeToken() { }
-
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
-    {
-        dest.append(applyPadding(qtMsgTypeToString(lmsg.type())));
-    }
+    explicit SyslogSink(const QString &ident, int option = QTLOGGER_SYSLOG_LOG_PID,
+                        int facility = QTLOGGER_SYSLOG_LOG_USER);
+    ~SyslogSink();
 
-    size_t estimatedLength() const override
-    {
-        return hasFormatSpec() ? formatWidth() : 8; // Maximum length of "critical"
-    }
+    void send(const LogMessage &lmsg) override;
 };
 
-class LineToken : public FormattedToken
-{
-public:
-    LineToken() { }
+using SyslogSinkPtr = QSharedPointer<SyslogSink>;
 
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
-    {
-        dest.append(applyPadding(QString::number(lmsg.line())));
-    }
+} // namespace QtLogger
 
-    size_t estimatedLength() const override
-    {
-        return hasFormatSpec() ? formatWidth() : 5; // Maximum length of "99999"
-    }
-};
+#endif // QTLOGGER_SYSLOG
 
-class FileToken : public FormattedToken
-{
-public:
-    FileToken() { }
+// end syslogsink.h
 
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
-    {
-        dest.append(applyPadding(lmsg.file()));
-    }
+#endif
 
-    size_t estimatedLength() const override
-    {
-        return hasFormatSpec() ? formatWidth() : 20; // Maximum length of "path/to/file.cpp"
-    }
-};
+#ifdef QTLOGGER_SDJOURNAL
 
-class ShortFileToken : public FormattedToken
+// sdjournalsink.h
+
+#ifdef QTLOGGER_SDJOURNAL
+
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+class QTLOGGER_EXPORT SdJournalSink : public Sink
 {
 public:
-    ShortFileToken(const QString &baseDir = QString()) : m_baseDir(baseDir) { }
+    void send(const LogMessage &lmsg) override;
+};
 
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
-    {
-        QString file = lmsg.file();
-        QString value;
-        if (m_baseDir.isEmpty()) {
-            // No basedir specified - return only filename without directory
-            int lastSlash = file.lastIndexOf(QLatin1Char('/'));
-            if (lastSlash == -1) {
-                lastSlash = file.lastIndexOf(QLatin1Char('\\'));
-            }
-            if (lastSlash != -1) {
-                value = file.mid(lastSlash + 1);
-            } else {
-                value = file;
-            }
-        } else {
-            // Strip basedir prefix if present
-            if (file.startsWith(m_baseDir)) {
-                QString result = file.mid(m_baseDir.length());
-                // Remove leading slash if present
-                if (result.startsWith(QLatin1Char('/')) || result.startsWith(QLatin1Char('\\'))) {
-                    result = result.mid(1);
-                }
-                value = result;
-            } else {
-                value = file;
-            }
-        }
-        dest.append(applyPadding(value));
-    }
+using SdJournalSinkPtr = QSharedPointer<SdJournalSink>;
 
-    size_t estimatedLength() const override
-    {
-        return hasFormatSpec() ? formatWidth() : 20;
-    }
+} // namespace QtLogger
 
-private:
-    QString m_baseDir;
-};
+#endif // QTLOGGER_SDJOURNAL
 
-class FunctionToken : public FormattedToken
+// end sdjournalsink.h
+
+#endif
+
+#ifdef QTLOGGER_SQL
+
+// sqlitesink.h
+
+#ifdef QTLOGGER_SQL
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+// Stores messages in an SQLite database through the QSQLITE driver of QtSql.
+//
+// Rows go to the "logs" table with indexed time, level and category columns, the custom
+// attributes are stored as a JSON object. The formatted message is not used.
+//
+// Rows are inserted with a prepared statement in one transaction per batch: a batch is committed
+// when it holds batchSize() rows or its first row is older than batchInterval(). The database is
+// opened in WAL mode with incremental auto-vacuum, and the retention limits are applied with
+// every commit.
+//
+// The database is opened once, in a thread of the sink that owns the connection and commits
+// incomplete batches, so the sending threads need no event loop. A complete batch is committed
+// before send() returns.
+class QTLOGGER_EXPORT SqliteSink : public Sink
 {
 public:
-    FunctionToken(bool cleanup = true) : m_cleanup(cleanup) { }
+    static constexpr int DefaultBatchSize = 1000;
+    static constexpr int DefaultBatchInterval = 1000; // ms
 
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
-    {
-        QString value;
-        if (m_cleanup) {
-            value = QString::fromLatin1(cleanup(lmsg.function()));
-        } else {
-            value = QString::fromLatin1(lmsg.function());
-        }
-        dest.append(applyPadding(value));
-    }
+    explicit SqliteSink(const QString &fileName);
+    ~SqliteSink() override;
 
-    size_t estimatedLength() const override
-    {
-        if (hasFormatSpec())
-            return formatWidth();
-        return m_cleanup ? 20 : 40;
-    }
+    void send(const LogMessage &lmsg) override;
+    // Commits the pending rows
+    bool flush() override;
 
-private:
-    bool m_cleanup;
+    QString fileName() const;
+    // The database is opened with the first message
+    bool isOpen() const;
 
-    static QByteArray cleanup(QByteArray func)
-    {
-        if (func.isEmpty())
-            return func;
+    int batchSize() const;
+    void setBatchSize(int batchSize);
 
-        // Helper lambda: find balanced bracket in reverse
-        auto findBalancedReverse = [&func](char open, char close, int startPos) -> int {
-            if (startPos <= 0)
-                return -1;
-            int count = 1;
-            int pos = startPos - 1;
-            while (pos >= 0 && count > 0) {
-                char c = func.at(pos);
-                if (c == close)
-                    ++count;
-                else if (c == open)
-                    --count;
-                --pos;
-            }
-            return (count == 0) ? pos + 1 : -1;
-        };
+    int batchInterval() const;
+    void setBatchInterval(int msecs);
 
-        // Remove compiler metadata like [with T = int]
-        if (func.endsWith(']') && !func.startsWith('+') && !func.startsWith('-')) {
-            int openBracket = findBalancedReverse('[', ']', func.size() - 1);
-            if (openBracket != -1)
-                func.truncate(openBracket);
-        }
-        while (func.endsWith(' '))
-            func.chop(1);
+    // Retention: the oldest rows beyond the row count and rows older than the age (in seconds)
+    // are deleted, 0 disables the limit
+    qint64 maxRowCount() const;
+    void setMaxRowCount(qint64 maxRowCount);
 
-        // Normalize operator spacing
+    int maxAge() const;
+    void setMaxAge(int secs);
+
+private:
+    class SqliteSinkPrivate;
+    QScopedPointer<SqliteSinkPrivate> d;
+    Q_DISABLE_COPY(SqliteSink)
+};
+
+using SqliteSinkPtr = QSharedPointer<SqliteSink>;
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_SQL
+
+// end sqlitesink.h
+
+#endif
+
+// appinfoattrs.cpp
+
+#include <QCoreApplication>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+AppInfoAttrs::AppInfoAttrs()
+{
+    m_attrs = QVariantHash {
+        { QStringLiteral("appname"), QCoreApplication::applicationName() },
+        { QStringLiteral("appversion"), QCoreApplication::applicationVersion() },
+        { QStringLiteral("appdir"), QCoreApplication::applicationDirPath() },
+        { QStringLiteral("apppath"), QCoreApplication::applicationFilePath() },
+        { QStringLiteral("pid"), QCoreApplication::applicationPid() },
+    };
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash AppInfoAttrs::attributes(const LogMessage &lmsg)
+{
+    Q_UNUSED(lmsg)
+    return m_attrs;
+}
+
+} // namespace QtLogger
+
+// appuuidattr.cpp
+
+// appuuidattr.h
+
+//
+
+#include <QSharedPointer>
+
+namespace QtLogger {
+
+class QTLOGGER_EXPORT AppUuidAttr : public AttrHandler
+{
+public:
+    explicit AppUuidAttr(const QString &name = QStringLiteral("app_uuid"));
+    QVariantHash attributes(const LogMessage &lmsg) override;
+
+private:
+    QString m_name;
+    QString m_uuid;
+};
+
+using AppUuidAttrPtr = QSharedPointer<AppUuidAttr>;
+
+} // namespace QtLogger
+// end appuuidattr.h
+
+#include <QCoreApplication>
+#include <QSettings>
+#include <QUuid>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+AppUuidAttr::AppUuidAttr(const QString &name) : m_name(name)
+{
+    QSettings settings(QSettings::UserScope, QCoreApplication::organizationName(),
+                       QCoreApplication::applicationName());
+
+    auto uuid = settings.value(QStringLiteral("app_uuid")).toString();
+
+    if (uuid.isEmpty()) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+        uuid = QUuid::createUuid().toString(QUuid::WithoutBraces);
+#else
+        uuid = QUuid::createUuid().toString();
+        uuid.remove(QLatin1Char('{')).remove(QLatin1Char('}'));
+#endif
+        settings.setValue(QStringLiteral("app_uuid"), uuid);
+    }
+
+    m_uuid = uuid;
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash AppUuidAttr::attributes(const LogMessage &lmsg)
+{
+    Q_UNUSED(lmsg)
+    return { { m_name, m_uuid } };
+}
+
+} // namespace QtLogger
+
+// backtraceattr.cpp
+
+#include <QStringList>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+BacktraceAttr::BacktraceAttr(QtMsgType minLevel, int depth, const QString &name)
+    : m_minLevel(minLevel), m_depth(depth), m_name(name), m_levelFilter(minLevel)
+{
+    Backtrace::enableCapture(minLevel, depth);
+}
+
+QTLOGGER_DECL_SPEC
+BacktraceAttr::~BacktraceAttr()
+{
+    Backtrace::releaseCapture(m_minLevel, m_depth);
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash BacktraceAttr::attributes(const LogMessage &lmsg)
+{
+    if (!m_levelFilter.filter(lmsg))
+        return {};
+
+    // Capturing here would record the stack of the logger thread for an asynchronous logger
+    const auto addresses = lmsg.backtrace();
+    if (addresses.isEmpty())
+        return {};
+
+    // The logger captures the largest depth of all handlers
+    const auto count = qMin(static_cast<int>(addresses.size()), m_depth);
+
+    QStringList frames;
+    frames.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        frames.append(Backtrace::formatFrame(Backtrace::resolve(addresses.at(i))));
+    }
+
+    return { { m_name, frames.join(QLatin1Char('\n')) } };
+}
+
+} // namespace QtLogger
+
+// hostinfoattrs.cpp
+
+#ifdef QTLOGGER_NETWORK
+
+#    include <QHostInfo>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+HostInfoAttrs::HostInfoAttrs()
+{
+    m_attrs = QVariantHash {
+        { QStringLiteral("host_name"), QHostInfo::localHostName() },
+    };
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash HostInfoAttrs::attributes(const LogMessage &lmsg)
+{
+    Q_UNUSED(lmsg)
+    return m_attrs;
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
+
+// messagetemplateattr.cpp
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutexLocker>
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+// Splitting on single spaces keeps empty tokens, so joining with a space restores the message
+QStringList tokenize(const QString &message)
+{
+    return message.split(QLatin1Char(' '));
+}
+
+bool hasDigit(const QString &token)
+{
+    for (const auto &ch : token) {
+        if (ch.isDigit())
+            return true;
+    }
+    return false;
+}
+
+// Tokens with digits are likely parameters, they must not split the templates into groups
+QString groupKey(const QStringList &tokens)
+{
+    const auto &first = tokens.first();
+    return hasDigit(first) ? MessageTemplateAttr::wildcard() : first;
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+MessageTemplateAttr::MessageTemplateAttr(const QString &name, double similarityThreshold,
+                                         int maxTemplates)
+    : m_name(name), m_similarityThreshold(similarityThreshold), m_maxTemplates(maxTemplates)
+{
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash MessageTemplateAttr::attributes(const LogMessage &lmsg)
+{
+    const auto tokens = tokenize(lmsg.message());
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&m_mutex);
+#endif
+
+    const auto id = match(tokens);
+    if (id < 0)
+        return {};
+
+    return { { m_name, id } };
+}
+
+QTLOGGER_DECL_SPEC
+int MessageTemplateAttr::match(const QStringList &tokens)
+{
+    const auto wildcard = MessageTemplateAttr::wildcard();
+    const auto key = groupKey(tokens);
+    const auto group = m_groups.value(tokens.size()).value(key);
+
+    int bestId = -1;
+    double bestSimilarity = -1.0;
+    int bestWildcards = -1;
+
+    for (const auto id : std::as_const(group)) {
+        const auto &tmpl = m_templates.at(id);
+
+        int same = 0;
+        int wildcards = 0;
+        for (int i = 0; i < tokens.size(); ++i) {
+            if (tmpl.at(i) == wildcard)
+                ++wildcards;
+            else if (tmpl.at(i) == tokens.at(i))
+                ++same;
+        }
+
+        const auto similarity = static_cast<double>(same) / tokens.size();
+        if (similarity > bestSimilarity
+            || (similarity == bestSimilarity && wildcards > bestWildcards)) {
+            bestId = id;
+            bestSimilarity = similarity;
+            bestWildcards = wildcards;
+        }
+    }
+
+    if (bestId >= 0 && bestSimilarity >= m_similarityThreshold) {
+        auto &tmpl = m_templates[bestId];
+        for (int i = 0; i < tokens.size(); ++i) {
+            if (tmpl.at(i) != tokens.at(i))
+                tmpl[i] = wildcard;
+        }
+        ++m_counts[bestId];
+        return bestId;
+    }
+
+    if (m_templates.size() >= m_maxTemplates || group.size() >= MaxTemplatesPerGroup)
+        return -1;
+
+    const auto id = static_cast<int>(m_templates.size());
+    m_templates.append(tokens);
+    m_counts.append(1);
+    m_groups[tokens.size()][key].append(id);
+
+    return id;
+}
+
+QTLOGGER_DECL_SPEC
+QList<MessageTemplateAttr::Template> MessageTemplateAttr::templates() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&m_mutex);
+#endif
+
+    QList<Template> result;
+    result.reserve(m_templates.size());
+
+    for (int id = 0; id < m_templates.size(); ++id) {
+        Template tmpl;
+        tmpl.id = id;
+        tmpl.text = m_templates.at(id).join(QLatin1Char(' '));
+        tmpl.count = m_counts.at(id);
+        result.append(tmpl);
+    }
+
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+QString MessageTemplateAttr::templateText(int id) const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&m_mutex);
+#endif
+
+    if (id < 0 || id >= m_templates.size())
+        return {};
+
+    return m_templates.at(id).join(QLatin1Char(' '));
+}
+
+QTLOGGER_DECL_SPEC
+std::optional<QStringList> MessageTemplateAttr::parameters(const QString &templateText,
+                                                           const QString &message)
+{
+    const auto wildcard = MessageTemplateAttr::wildcard();
+    const auto tmpl = tokenize(templateText);
+    const auto tokens = tokenize(message);
+
+    if (tmpl.size() != tokens.size())
+        return std::nullopt;
+
+    QStringList result;
+    result.reserve(tmpl.size());
+
+    for (int i = 0; i < tmpl.size(); ++i) {
+        if (tmpl.at(i) == wildcard)
+            result.append(tokens.at(i));
+        else if (tmpl.at(i) != tokens.at(i))
+            return std::nullopt;
+    }
+
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+QString MessageTemplateAttr::applyParameters(const QString &templateText,
+                                             const QStringList &parameters)
+{
+    const auto wildcard = MessageTemplateAttr::wildcard();
+    auto tokens = tokenize(templateText);
+
+    int param = 0;
+    for (auto &token : tokens) {
+        if (token == wildcard && param < parameters.size())
+            token = parameters.at(param++);
+    }
+
+    return tokens.join(QLatin1Char(' '));
+}
+
+} // namespace QtLogger
+
+// seqnumberattr.cpp
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+SeqNumberAttr::SeqNumberAttr(const QString &name) : m_name(name) { }
+
+QTLOGGER_DECL_SPEC
+QVariantHash SeqNumberAttr::attributes(const LogMessage &lmsg)
+{
+    Q_UNUSED(lmsg)
+    return { { m_name, m_count.fetchAndAddOrdered(1) } };
+}
+
+} // namespace QtLogger
+
+// sysinfoattrs.cpp
+
+#include <QSysInfo>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+SysInfoAttrs::SysInfoAttrs()
+{
+    m_attrs = QVariantHash {
+        { QStringLiteral("os_name"), QSysInfo::productType() },
+        { QStringLiteral("os_version"), QSysInfo::productVersion() },
+        { QStringLiteral("kernel_type"), QSysInfo::kernelType() },
+        { QStringLiteral("kernel_version"), QSysInfo::kernelVersion() },
+        { QStringLiteral("cpu_arch"), QSysInfo::currentCpuArchitecture() },
+        { QStringLiteral("build_abi"), QSysInfo::buildAbi() },
+        { QStringLiteral("build_cpu_arch"), QSysInfo::buildCpuArchitecture() },
+        { QStringLiteral("pretty_product_name"), QSysInfo::prettyProductName() },
+        { QStringLiteral("machine_host_name"), QSysInfo::machineHostName() },
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+        { QStringLiteral("machine_unique_id"), QString::fromLatin1(QSysInfo::machineUniqueId()) },
+        { QStringLiteral("boot_unique_id"), QString::fromLatin1(QSysInfo::bootUniqueId()) },
+#endif
+    };
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash SysInfoAttrs::attributes(const LogMessage &lmsg)
+{
+    Q_UNUSED(lmsg)
+    return m_attrs;
+}
+
+} // namespace QtLogger
+
+// backtrace.cpp
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QPair>
+#include <QVarLengthArray>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+#if defined(Q_OS_WIN)
+#    include <qt_windows.h>
+#elif !defined(Q_OS_ANDROID) && __has_include(<execinfo.h>)
+#    include <execinfo.h>
+#    define QTLOGGER_BACKTRACE_EXECINFO
+#endif
+
+#if !defined(Q_OS_WIN) && __has_include(<dlfcn.h>)
+#    include <dlfcn.h>
+#    define QTLOGGER_BACKTRACE_DLADDR
+#endif
+
+#if __has_include(<cxxabi.h>)
+#    include <cxxabi.h>
+#    include <cstdlib>
+#    define QTLOGGER_BACKTRACE_DEMANGLE
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int BacktraceDisabled = 5;
+
+QAtomicInt g_backtraceMinPriority(BacktraceDisabled);
+QAtomicInt g_backtraceDepth(0);
+
+// Capture requests of the handlers, the atomics above hold the lowest level and largest depth
+struct BacktraceRequests
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    QList<QPair<int, int>> requests; // priority, depth
+
+    void apply()
+    {
+        auto minPriority = BacktraceDisabled;
+        auto depth = 0;
+        for (const auto &request : std::as_const(requests)) {
+            minPriority = qMin(minPriority, request.first);
+            depth = qMax(depth, request.second);
+        }
+        g_backtraceMinPriority.storeRelease(minPriority);
+        g_backtraceDepth.storeRelease(depth);
+    }
+};
+
+BacktraceRequests &backtraceRequests()
+{
+    static BacktraceRequests requests;
+    return requests;
+}
+
+struct BacktraceCache
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    QHash<quintptr, Backtrace::Frame> frames;
+};
+
+BacktraceCache &backtraceCache()
+{
+    static BacktraceCache cache;
+    return cache;
+}
+
+Backtrace::Frame resolveUncached(quintptr address)
+{
+    Backtrace::Frame frame;
+    frame.address = address;
+
+#if defined(QTLOGGER_BACKTRACE_DLADDR)
+    // A return address points after the call, which may already be the next function
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void *>(address - 1), &info) == 0)
+        return frame;
+
+    if (info.dli_fname)
+        frame.module = QString::fromLocal8Bit(info.dli_fname);
+    frame.moduleAddress = reinterpret_cast<quintptr>(info.dli_fbase);
+
+    if (info.dli_sname) {
+        frame.symbolAddress = reinterpret_cast<quintptr>(info.dli_saddr);
+        frame.function = QString::fromLatin1(info.dli_sname);
+
+#    if defined(QTLOGGER_BACKTRACE_DEMANGLE)
+        auto status = 0;
+        auto demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        if (status == 0 && demangled)
+            frame.function = QString::fromUtf8(demangled);
+        std::free(demangled);
+#    endif
+    }
+#elif defined(Q_OS_WIN)
+    HMODULE module = nullptr;
+    if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS
+                                    | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                            reinterpret_cast<LPCWSTR>(address - 1), &module))
+        return frame;
+
+    wchar_t path[MAX_PATH];
+    const auto size = GetModuleFileNameW(module, path, MAX_PATH);
+    frame.module = QString::fromWCharArray(path, static_cast<int>(size));
+    frame.moduleAddress = reinterpret_cast<quintptr>(module);
+#endif
+
+    return frame;
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+Q_NEVER_INLINE QList<quintptr> Backtrace::capture(int depth, int skip)
+{
+    depth = qBound(0, depth, MaxDepth);
+    skip = qBound(0, skip, MaxDepth);
+
+    QList<quintptr> addresses;
+    if (depth == 0)
+        return addresses;
+
+    // One more for the frame of capture()
+    QVarLengthArray<void *, DefaultDepth + 8> frames(depth + skip + 1);
+
+#if defined(QTLOGGER_BACKTRACE_EXECINFO)
+    const auto count = ::backtrace(frames.data(), frames.size());
+#elif defined(Q_OS_WIN)
+    const auto count = static_cast<int>(
+            CaptureStackBackTrace(0, static_cast<DWORD>(frames.size()), frames.data(), nullptr));
+#else
+    const auto count = 0;
+#endif
+
+    addresses.reserve(qMax(count - skip - 1, 0));
+    for (int i = skip + 1; i < count; ++i) {
+        addresses.append(reinterpret_cast<quintptr>(frames.at(i)));
+    }
+
+    return addresses;
+}
+
+QTLOGGER_DECL_SPEC
+void Backtrace::attach(LogMessage &lmsg, int skip)
+{
+    if (!isCaptureEnabled(lmsg.type()) || lmsg.hasBacktrace())
+        return;
+
+    // Without the frame of attach()
+    const auto addresses = capture(g_backtraceDepth.loadAcquire(), skip + 1);
+    if (!addresses.isEmpty())
+        lmsg.setBacktrace(addresses);
+}
+
+QTLOGGER_DECL_SPEC
+void Backtrace::enableCapture(QtMsgType minLevel, int depth)
+{
+    auto &requests = backtraceRequests();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&requests.mutex);
+#endif
+    requests.requests.append({ qtMsgTypePriority(minLevel), qBound(0, depth, MaxDepth) });
+    requests.apply();
+}
+
+QTLOGGER_DECL_SPEC
+void Backtrace::releaseCapture(QtMsgType minLevel, int depth)
+{
+    auto &requests = backtraceRequests();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&requests.mutex);
+#endif
+    const auto index = requests.requests.indexOf(
+            { qtMsgTypePriority(minLevel), qBound(0, depth, MaxDepth) });
+    if (index < 0)
+        return;
+    requests.requests.removeAt(index);
+    requests.apply();
+}
+
+QTLOGGER_DECL_SPEC
+void Backtrace::disableCapture()
+{
+    auto &requests = backtraceRequests();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&requests.mutex);
+#endif
+    requests.requests.clear();
+    requests.apply();
+}
+
+QTLOGGER_DECL_SPEC
+bool Backtrace::isCaptureEnabled(QtMsgType type)
+{
+    return qtMsgTypePriority(type) >= g_backtraceMinPriority.loadAcquire();
+}
+
+QTLOGGER_DECL_SPEC
+Backtrace::Frame Backtrace::resolve(quintptr address)
+{
+    auto &cache = backtraceCache();
+
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&cache.mutex);
+#endif
+        const auto it = cache.frames.constFind(address);
+        if (it != cache.frames.cend())
+            return it.value();
+    }
+
+    // Resolved without the lock, two threads may resolve the same address at worst
+    const auto frame = resolveUncached(address);
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&cache.mutex);
+#endif
+
+    // Addresses of unloaded modules may be reused, so the cache is bounded rather than permanent
+    if (cache.frames.size() >= MaxCacheSize)
+        cache.frames.clear();
+    cache.frames.insert(address, frame);
+
+    return frame;
+}
+
+QTLOGGER_DECL_SPEC
+QList<Backtrace::Frame> Backtrace::resolve(const QList<quintptr> &addresses)
+{
+    QList<Frame> frames;
+    frames.reserve(addresses.size());
+    for (const auto address : addresses) {
+        frames.append(resolve(address));
+    }
+    return frames;
+}
+
+QTLOGGER_DECL_SPEC
+QString Backtrace::formatFrame(const Frame &frame)
+{
+    QString text;
+
+    if (!frame.function.isEmpty()) {
+        text = frame.function;
+        if (frame.symbolAddress && frame.address >= frame.symbolAddress) {
+            text += QStringLiteral("+0x")
+                    + QString::number(static_cast<qulonglong>(frame.address - frame.symbolAddress),
+                                      16);
+        }
+    } else {
+        text = QStringLiteral("0x") + QString::number(static_cast<qulonglong>(frame.address), 16);
+    }
+
+    if (!frame.module.isEmpty()) {
+        const auto slash = qMax(frame.module.lastIndexOf(QLatin1Char('/')),
+                                frame.module.lastIndexOf(QLatin1Char('\\')));
+        text += QStringLiteral(" (") + frame.module.mid(slash + 1) + QLatin1Char(')');
+    }
+
+    return text;
+}
+
+QTLOGGER_DECL_SPEC
+int Backtrace::cacheSize()
+{
+    auto &cache = backtraceCache();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&cache.mutex);
+#endif
+    return static_cast<int>(cache.frames.size());
+}
+
+QTLOGGER_DECL_SPEC
+void Backtrace::clearCache()
+{
+    auto &cache = backtraceCache();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&cache.mutex);
+#endif
+    cache.frames.clear();
+}
+
+} // namespace QtLogger
+
+// binarylog.cpp
+
+#include <QFile>
+#include <QHash>
+#include <QIODevice>
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int BinaryLogReadChunkSize = 64 * 1024;
+
+class BinaryLogCursor
+{
+public:
+    BinaryLogCursor(const QByteArray &data, int pos, int end)
+        : m_data(data), m_pos(pos), m_end(end)
+    {
+    }
+
+    bool ok() const { return m_ok; }
+    int pos() const { return m_pos; }
+    bool atEnd() const { return m_pos >= m_end; }
+
+    // A read failed because the data ended, not because it is damaged
+    bool truncated() const { return m_truncated; }
+
+    quint8 readByte()
+    {
+        if (!m_ok)
+            return 0;
+        if (m_pos >= m_end) {
+            m_ok = false;
+            m_truncated = true;
+            return 0;
+        }
+        return static_cast<quint8>(m_data.at(m_pos++));
+    }
+
+    quint64 readVarUInt()
+    {
+        quint64 value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const auto byte = readByte();
+            if (!m_ok)
+                return 0;
+            value |= static_cast<quint64>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+        m_ok = false;
+        return 0;
+    }
+
+    qint64 readVarInt()
+    {
+        const auto value = readVarUInt();
+        return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+    }
+
+    QByteArray readRaw(quint64 size)
+    {
+        if (!m_ok)
+            return {};
+        if (size > static_cast<quint64>(m_end - m_pos)) {
+            m_ok = false;
+            m_truncated = true;
+            return {};
+        }
+        const auto result = m_data.mid(m_pos, static_cast<int>(size));
+        m_pos += static_cast<int>(size);
+        return result;
+    }
+
+    QByteArray readBytes() { return readRaw(readVarUInt()); }
+
+    QString readString() { return QString::fromUtf8(readBytes()); }
+
+    QVariant readValue()
+    {
+        const auto tag = readByte();
+        if (!m_ok)
+            return {};
+
+        switch (tag) {
+        case BinaryLog::NullValue:
+            return {};
+        case BinaryLog::BoolValue:
+            return readByte() != 0;
+        case BinaryLog::IntValue:
+            return readVarInt();
+        case BinaryLog::UIntValue:
+            return readVarUInt();
+        case BinaryLog::DoubleValue: {
+            const auto raw = readRaw(sizeof(quint64));
+            if (!m_ok)
+                return {};
+            const auto bits = qFromLittleEndian<quint64>(raw.constData());
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        case BinaryLog::StringValue:
+            return readString();
+        case BinaryLog::DateTimeValue:
+            return QDateTime::fromMSecsSinceEpoch(readVarInt());
+        case BinaryLog::BytesValue:
+            return readBytes();
+        default:
+            // Decoding can't continue after a value of unknown size
+            m_ok = false;
+            return {};
+        }
+    }
+
+private:
+    const QByteArray &m_data;
+    int m_pos;
+    int m_end;
+    bool m_ok = true;
+    bool m_truncated = false;
+};
+
+} // namespace
+
+class BinaryLogWriter::BinaryLogWriterPrivate
+{
+public:
+    QByteArray encode(const LogMessage &lmsg)
+    {
+        const auto time = lmsg.time().toMSecsSinceEpoch();
+
+        QByteArray out;
+        out.reserve(lmsg.message().size() + 32);
+
+        if (!m_headerWritten)
+            writeHeader(out, time);
+
+        const auto callsiteId = callsite(out, lmsg);
+        const auto threadId = thread(out, lmsg.qthreadptr());
+
+        int templateId = -1;
+        std::optional<QStringList> params;
+        if (messageTemplates && lmsg.hasAttribute(messageTemplates->name())) {
+            templateId = lmsg.attribute(messageTemplates->name()).toInt();
+            const auto text = messageTemplates->templateText(templateId);
+            params = MessageTemplateAttr::parameters(text, lmsg.message());
+            if (params)
+                writeTemplate(out, templateId, text);
+        }
+
+        const auto start = beginFrame(out, params ? BinaryLog::TemplatedRecordFrame
+                                                  : BinaryLog::RecordFrame);
+        BinaryLog::writeVarInt(out, time - m_lastTime);
+        out.append(static_cast<char>(lmsg.type()));
+        BinaryLog::writeVarUInt(out, callsiteId);
+        BinaryLog::writeVarUInt(out, threadId);
+        if (params) {
+            BinaryLog::writeVarUInt(out, static_cast<quint64>(templateId));
+            BinaryLog::writeVarUInt(out, static_cast<quint64>(params->size()));
+            for (const auto &param : std::as_const(*params)) {
+                BinaryLog::writeString(out, param);
+            }
+        } else {
+            BinaryLog::writeString(out, lmsg.message());
+        }
+
+        const auto attrs = lmsg.attributes();
+        BinaryLog::writeVarUInt(out, static_cast<quint64>(attrs.size()));
+        for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
+            BinaryLog::writeString(out, it.key());
+            BinaryLog::writeValue(out, it.value());
+        }
+        endFrame(out, start);
+
+        m_lastTime = time;
+
+        return out;
+    }
+
+    void reset() { m_headerWritten = false; }
+
+    MessageTemplateAttrPtr messageTemplates;
+    QVariantHash sessionAttributes;
+
+private:
+    // The payload is written after the kind, endFrame() inserts its length in front of it
+    static int beginFrame(QByteArray &out, BinaryLog::FrameKind kind)
+    {
+        out.append(static_cast<char>(kind));
+        return out.size();
+    }
+
+    static void endFrame(QByteArray &out, int start)
+    {
+        QByteArray length;
+        BinaryLog::writeVarUInt(length, static_cast<quint64>(out.size() - start));
+        out.insert(start, length);
+    }
+
+    void writeHeader(QByteArray &out, qint64 time)
+    {
+        m_callsites.clear();
+        m_threads.clear();
+        m_templates.clear();
+        m_lastTime = time;
+
+        out.append(static_cast<char>(BinaryLog::HeaderFrame));
+        out.append(BinaryLog::Magic, 4);
+        out.append(static_cast<char>(BinaryLog::Version));
+        BinaryLog::writeVarInt(out, time);
+
+        if (!sessionAttributes.isEmpty()) {
+            const auto start = beginFrame(out, BinaryLog::AttributesFrame);
+            BinaryLog::writeVarUInt(out, static_cast<quint64>(sessionAttributes.size()));
+            for (auto it = sessionAttributes.cbegin(); it != sessionAttributes.cend(); ++it) {
+                BinaryLog::writeString(out, it.key());
+                BinaryLog::writeValue(out, it.value());
+            }
+            endFrame(out, start);
+        }
+
+        m_headerWritten = true;
+    }
+
+    // Callsites are compared by content, the context pointers of a message copied to another
+    // thread point to its own buffers
+    quint64 callsite(QByteArray &out, const LogMessage &lmsg)
+    {
+        QByteArray key;
+        key.reserve(128);
+        key.append(lmsg.file()).append('\0');
+        key.append(lmsg.function()).append('\0');
+        key.append(lmsg.category()).append('\0');
+        key.append(QByteArray::number(lmsg.line()));
+
+        auto it = m_callsites.constFind(key);
+        if (it != m_callsites.constEnd())
+            return it.value();
+
+        const auto id = static_cast<quint64>(m_callsites.size());
+        m_callsites.insert(key, id);
+
+        const auto start = beginFrame(out, BinaryLog::CallsiteFrame);
+        BinaryLog::writeVarUInt(out, id);
+        BinaryLog::writeBytes(out, QByteArray(lmsg.file()));
+        BinaryLog::writeVarUInt(out, static_cast<quint64>(qMax(lmsg.line(), 0)));
+        BinaryLog::writeBytes(out, QByteArray(lmsg.function()));
+        BinaryLog::writeBytes(out, QByteArray(lmsg.category()));
+        endFrame(out, start);
+
+        return id;
+    }
+
+    // Templates are only generalized, the text is written again when it changed since the last use
+    void writeTemplate(QByteArray &out, int id, const QString &text)
+    {
+        auto it = m_templates.find(id);
+        if (it != m_templates.end() && it.value() == text)
+            return;
+
+        m_templates.insert(id, text);
+
+        const auto start = beginFrame(out, BinaryLog::TemplateFrame);
+        BinaryLog::writeVarUInt(out, static_cast<quint64>(id));
+        BinaryLog::writeString(out, text);
+        endFrame(out, start);
+    }
+
+    quint64 thread(QByteArray &out, quintptr qthreadptr)
+    {
+        auto it = m_threads.constFind(qthreadptr);
+        if (it != m_threads.constEnd())
+            return it.value();
+
+        const auto id = static_cast<quint64>(m_threads.size());
+        m_threads.insert(qthreadptr, id);
+
+        const auto start = beginFrame(out, BinaryLog::ThreadFrame);
+        BinaryLog::writeVarUInt(out, id);
+        BinaryLog::writeVarUInt(out, static_cast<quint64>(qthreadptr));
+        endFrame(out, start);
+
+        return id;
+    }
+
+    QHash<QByteArray, quint64> m_callsites;
+    QHash<quintptr, quint64> m_threads;
+    QHash<int, QString> m_templates;
+    qint64 m_lastTime = 0;
+    bool m_headerWritten = false;
+};
+
+QTLOGGER_DECL_SPEC
+BinaryLogWriter::BinaryLogWriter() : d(new BinaryLogWriterPrivate) { }
+
+QTLOGGER_DECL_SPEC
+BinaryLogWriter::~BinaryLogWriter() = default;
+
+QTLOGGER_DECL_SPEC
+QByteArray BinaryLogWriter::encode(const LogMessage &lmsg)
+{
+    return d->encode(lmsg);
+}
+
+QTLOGGER_DECL_SPEC
+void BinaryLogWriter::reset()
+{
+    d->reset();
+}
+
+QTLOGGER_DECL_SPEC
+void BinaryLogWriter::setMessageTemplates(const MessageTemplateAttrPtr &messageTemplates)
+{
+    d->messageTemplates = messageTemplates;
+}
+
+QTLOGGER_DECL_SPEC
+MessageTemplateAttrPtr BinaryLogWriter::messageTemplates() const
+{
+    return d->messageTemplates;
+}
+
+QTLOGGER_DECL_SPEC
+void BinaryLogWriter::setSessionAttributes(const QVariantHash &attributes)
+{
+    d->sessionAttributes = attributes;
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash BinaryLogWriter::sessionAttributes() const
+{
+    return d->sessionAttributes;
+}
+
+class BinaryLogReader::BinaryLogReaderPrivate
+{
+public:
+    struct Callsite
+    {
+        QByteArray file;
+        int line = 0;
+        QByteArray function;
+        QByteArray category;
+    };
+
+    enum class FrameResult { Message, Dictionary, Incomplete, Skipped, Damaged, Unsupported };
+
+    void init()
+    {
+        if (!device || !device->isOpen()) {
+            error = QStringLiteral("Device is not open");
+            return;
+        }
+
+        while (buffer.size() < 5 && readMore()) { }
+
+        if (buffer.size() < 5 || buffer.at(0) != BinaryLog::HeaderFrame
+            || !buffer.mid(1, 4).startsWith(BinaryLog::Magic)) {
+            error = QStringLiteral("Not a binary log");
+            return;
+        }
+
+        valid = true;
+    }
+
+    bool readMore()
+    {
+        if (pos > 0) {
+            buffer.remove(0, pos);
+            pos = 0;
+        }
+
+        const auto chunk = device->read(BinaryLogReadChunkSize);
+        if (chunk.isEmpty())
+            return false;
+
+        buffer.append(chunk);
+        return true;
+    }
+
+    static QByteArray headerMarker()
+    {
+        return QByteArray(1, BinaryLog::HeaderFrame) + BinaryLog::Magic;
+    }
+
+    // Moves to the next header at or after the position. Without one in the data read so far, the
+    // search continues in the next call.
+    bool resync(int from)
+    {
+        const auto marker = headerMarker();
+
+        for (;;) {
+            const auto index = static_cast<int>(buffer.indexOf(marker, from));
+            if (index >= 0) {
+                pos = index;
+                resyncing = false;
+                return true;
+            }
+
+            // Keeps the bytes that may be the start of a marker split between reads
+            pos = qMax(from, static_cast<int>(buffer.size() - marker.size()) + 1);
+            if (!readMore()) {
+                resyncing = true;
+                return false;
+            }
+            from = pos;
+        }
+    }
+
+    FrameResult parseHeader(BinaryLogCursor &cursor)
+    {
+        const auto magic = cursor.readRaw(4);
+        const auto version = cursor.readByte();
+        const auto baseTime = cursor.readVarInt();
+        if (!cursor.ok())
+            return cursor.truncated() ? FrameResult::Incomplete : FrameResult::Damaged;
+        if (!magic.startsWith(BinaryLog::Magic))
+            return FrameResult::Damaged;
+        if (version > BinaryLog::Version) {
+            error = QStringLiteral("Unsupported binary log version");
+            return FrameResult::Unsupported;
+        }
+
+        callsites.clear();
+        threads.clear();
+        templates.clear();
+        sessionAttributes.clear();
+        lastTime = baseTime;
+        pos = cursor.pos();
+        return FrameResult::Dictionary;
+    }
+
+    FrameResult parseFrame(std::optional<LogMessage> &result)
+    {
+        BinaryLogCursor cursor(buffer, pos, buffer.size());
+
+        const auto kind = static_cast<char>(cursor.readByte());
+        if (!cursor.ok())
+            return FrameResult::Incomplete;
+
+        if (kind == BinaryLog::HeaderFrame)
+            return parseHeader(cursor);
+
+        const auto length = cursor.readVarUInt();
+        if (!cursor.ok())
+            return cursor.truncated() ? FrameResult::Incomplete : FrameResult::Damaged;
+        if (length > BinaryLog::MaxFrameSize)
+            return FrameResult::Damaged;
+        if (length > static_cast<quint64>(buffer.size() - cursor.pos()))
+            return FrameResult::Incomplete;
+
+        const auto end = cursor.pos() + static_cast<int>(length);
+        BinaryLogCursor payload(buffer, cursor.pos(), end);
+
+        const auto frameResult = parsePayload(kind, payload, result);
+        if (frameResult == FrameResult::Damaged)
+            return frameResult;
+
+        // A frame cut short by a crash spans the header of the next session
+        const auto header = frameResult == FrameResult::Skipped
+                                ? static_cast<int>(buffer.indexOf(headerMarker(), pos + 1))
+                                : -1;
+        pos = header >= 0 && header < end ? header : end;
+        return frameResult;
+    }
+
+    // A payload that doesn't decode to exactly its length is skipped, the length or the payload is
+    // damaged
+    FrameResult parsePayload(char kind, BinaryLogCursor &cursor, std::optional<LogMessage> &result)
+    {
+        switch (kind) {
+        case BinaryLog::CallsiteFrame: {
+            const auto id = cursor.readVarUInt();
+            Callsite callsite;
+            callsite.file = cursor.readBytes();
+            callsite.line = static_cast<int>(cursor.readVarUInt());
+            callsite.function = cursor.readBytes();
+            callsite.category = cursor.readBytes();
+            if (!cursor.ok() || !cursor.atEnd())
+                return FrameResult::Skipped;
+            callsites.insert(id, callsite);
+            return FrameResult::Dictionary;
+        }
+        case BinaryLog::ThreadFrame: {
+            const auto id = cursor.readVarUInt();
+            const auto qthreadptr = cursor.readVarUInt();
+            if (!cursor.ok() || !cursor.atEnd())
+                return FrameResult::Skipped;
+            threads.insert(id, static_cast<quintptr>(qthreadptr));
+            return FrameResult::Dictionary;
+        }
+        case BinaryLog::TemplateFrame: {
+            const auto id = cursor.readVarUInt();
+            const auto text = cursor.readString();
+            if (!cursor.ok() || !cursor.atEnd())
+                return FrameResult::Skipped;
+            templates.insert(id, text);
+            return FrameResult::Dictionary;
+        }
+        case BinaryLog::AttributesFrame: {
+            const auto count = cursor.readVarUInt();
+            QVariantHash attrs;
+            for (quint64 i = 0; i < count && cursor.ok(); ++i) {
+                const auto name = cursor.readString();
+                attrs.insert(name, cursor.readValue());
+            }
+            if (!cursor.ok() || !cursor.atEnd())
+                return FrameResult::Skipped;
+            sessionAttributes = attrs;
+            return FrameResult::Dictionary;
+        }
+        case BinaryLog::RecordFrame:
+        case BinaryLog::TemplatedRecordFrame: {
+            const auto time = lastTime + cursor.readVarInt();
+            const auto type = cursor.readByte();
+            const auto callsiteId = cursor.readVarUInt();
+            const auto threadId = cursor.readVarUInt();
+            QString message;
+            if (kind == BinaryLog::TemplatedRecordFrame) {
+                const auto templateId = cursor.readVarUInt();
+                const auto paramCount = cursor.readVarUInt();
+                QStringList params;
+                for (quint64 i = 0; i < paramCount && cursor.ok(); ++i) {
+                    params.append(cursor.readString());
+                }
+                message = MessageTemplateAttr::applyParameters(templates.value(templateId), params);
+            } else {
+                message = cursor.readString();
+            }
+            const auto attrCount = cursor.readVarUInt();
+            QVariantHash attrs = sessionAttributes;
+            for (quint64 i = 0; i < attrCount && cursor.ok(); ++i) {
+                const auto name = cursor.readString();
+                attrs.insert(name, cursor.readValue());
+            }
+            if (!cursor.ok() || !cursor.atEnd() || type > QtInfoMsg)
+                return FrameResult::Skipped;
+
+            const auto callsite = callsites.value(callsiteId);
+            const QMessageLogContext context(callsite.file.constData(), callsite.line,
+                                             callsite.function.constData(),
+                                             callsite.category.constData());
+
+            result.emplace(static_cast<QtMsgType>(type), context, message, QDateTime::fromMSecsSinceEpoch(time),
+                           threads.value(threadId));
+            result->setAttributes(attrs);
+
+            lastTime = time;
+            return FrameResult::Message;
+        }
+        default:
+            // A frame of an unknown kind still has a length to skip it by
+            return FrameResult::Skipped;
+        }
+    }
+
+    QIODevice *device = nullptr;
+    QScopedPointer<QFile> file;
+
+    QByteArray buffer;
+    int pos = 0;
+
+    QString error;
+    bool valid = false;
+    bool resyncing = false;
+    int damagedFrames = 0;
+
+    QHash<quint64, Callsite> callsites;
+    QHash<quint64, quintptr> threads;
+    QHash<quint64, QString> templates;
+    QVariantHash sessionAttributes;
+    qint64 lastTime = 0;
+};
+
+QTLOGGER_DECL_SPEC
+BinaryLogReader::BinaryLogReader(const QString &path) : d(new BinaryLogReaderPrivate)
+{
+    d->file.reset(new QFile(path));
+    if (!d->file->open(QIODevice::ReadOnly)) {
+        d->error = d->file->errorString();
+        return;
+    }
+    d->device = d->file.data();
+    d->init();
+}
+
+QTLOGGER_DECL_SPEC
+BinaryLogReader::BinaryLogReader(QIODevice *device) : d(new BinaryLogReaderPrivate)
+{
+    d->device = device;
+    d->init();
+}
+
+QTLOGGER_DECL_SPEC
+BinaryLogReader::~BinaryLogReader() = default;
+
+QTLOGGER_DECL_SPEC
+bool BinaryLogReader::isValid() const
+{
+    return d->valid;
+}
+
+QTLOGGER_DECL_SPEC
+QString BinaryLogReader::errorString() const
+{
+    return d->error;
+}
+
+QTLOGGER_DECL_SPEC
+std::optional<LogMessage> BinaryLogReader::next()
+{
+    std::optional<LogMessage> result;
+
+    if (!d->valid)
+        return result;
+
+    if (d->resyncing && !d->resync(d->pos))
+        return result;
+
+    while (true) {
+        switch (d->parseFrame(result)) {
+        case BinaryLogReaderPrivate::FrameResult::Message:
+            return result;
+        case BinaryLogReaderPrivate::FrameResult::Dictionary:
+            break;
+        case BinaryLogReaderPrivate::FrameResult::Incomplete:
+            if (d->readMore())
+                break;
+
+            // A truncated last frame, e.g. of a file that is still being written, ends the log. In
+            // a file followed by another session it was cut short by a crash and is skipped.
+            if (d->device->isSequential()
+                || d->buffer.indexOf(BinaryLogReaderPrivate::headerMarker(), d->pos + 1) < 0)
+                return result;
+            ++d->damagedFrames;
+            if (!d->resync(d->pos + 1))
+                return result;
+            break;
+        case BinaryLogReaderPrivate::FrameResult::Damaged:
+            ++d->damagedFrames;
+            if (!d->resync(d->pos + 1))
+                return result;
+            break;
+        case BinaryLogReaderPrivate::FrameResult::Skipped:
+            ++d->damagedFrames;
+            break;
+        case BinaryLogReaderPrivate::FrameResult::Unsupported:
+            d->valid = false;
+            return result;
+        }
+    }
+}
+
+QTLOGGER_DECL_SPEC
+int BinaryLogReader::damagedFrames() const
+{
+    return d->damagedFrames;
+}
+
+} // namespace QtLogger
+
+// configure.cpp
+
+#include <QLoggingCategory>
+#include <QUrl>
+#include <QtCore/QtGlobal>
+
+#ifdef QTLOGGER_NETWORK
+
+#endif
+
+#ifdef QTLOGGER_SYSLOG
+
+#endif
+
+#ifdef QTLOGGER_SDJOURNAL
+
+#endif
+
+#ifdef QTLOGGER_SQL
+
+#endif
+
+#ifdef QTLOGGER_OSLOG
+
+#endif
+
+#ifdef QTLOGGER_ANDROIDLOG
+
+#endif
+
+#ifndef QTLOGGER_NO_THREAD
+
+#endif
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+void configure(Pipeline *pipeline, const QString &path, int maxFileSize, int maxFileCount,
+               RotatingFileSink::Options options, bool async)
+{
+    if (!pipeline) {
+        return;
+    }
+
+    *pipeline << PrettyFormatterPtr::create(true);
+    *pipeline << PlatformStdSinkPtr::create();
+
+    // The file sinks write the rendering without colors of the same pass
+    if (!path.isEmpty()) {
+        if (maxFileSize > 0 || options.testFlag(RotatingFileSink::RotationOnStartup)
+            || options.testFlag(RotatingFileSink::RotationDaily)
+            || options.testFlag(RotatingFileSink::TimeIndex)
+            || options.testFlag(RotatingFileSink::TermIndex)) {
+            *pipeline << RotatingFileSinkPtr::create(path, maxFileSize, maxFileCount, options);
+        } else {
+            *pipeline << FileSinkPtr::create(path);
+        }
+    }
+
+#ifndef QTLOGGER_NO_THREAD
+    if (async) {
+        auto *ownThreadLogger = dynamic_cast<OwnThreadHandler<SimplePipeline> *>(pipeline);
+        if (ownThreadLogger) {
+            ownThreadLogger->moveToOwnThread();
+        }
+    }
+#else
+    Q_UNUSED(async)
+#endif
+}
+
+QTLOGGER_DECL_SPEC
+void configure(Pipeline *pipeline, const QSettings &settings, const QString &group)
+{
+    if (!pipeline) {
+        return;
+    }
+
+    // First, so the workload is recorded before the filters. With format_in_caller_thread, it gets
+    // the messages in the own thread and the filters and formatters still run in the caller thread.
+    const auto recordingPath = settings.value(group + QStringLiteral("/recording_path")).toString();
+    if (!recordingPath.isEmpty()) {
+        const auto maxCount =
+                settings.value(group + QStringLiteral("/recording_max_count"), 0).toULongLong();
+        *pipeline << RecordingSinkPtr::create(recordingPath, maxCount);
+    }
+
+    const auto filterRules = settings.value(group + QStringLiteral("/filter_rules")).toString();
+    if (!filterRules.isEmpty()) {
+#ifdef QTLOGGER_DEBUG
+        std::cerr << "configure: filterRules: " << filterRules.toStdString() << std::endl;
+#endif
+        *pipeline << CategoryFilterPtr::create(filterRules);
+    }
+
+    const auto regExpFilter = settings.value(group + QStringLiteral("/regexp_filter")).toString();
+    if (!regExpFilter.isEmpty()) {
+#ifdef QTLOGGER_DEBUG
+        std::cerr << "configure: filter: " << regExpFilter.toStdString() << std::endl;
+#endif
+        *pipeline << RegExpFilterPtr::create(regExpFilter);
+    }
+
+    const auto messagePattern =
+            settings.value(group + QStringLiteral("/message_pattern")).toString();
+    if (!messagePattern.isEmpty()) {
+#ifdef QTLOGGER_DEBUG
+        std::cerr << "configure: messagePattern: " << messagePattern.toStdString() << std::endl;
+#endif
+        *pipeline << PatternFormatterPtr::create(messagePattern);
+    } else {
+        *pipeline << PrettyFormatter::instance();
+    }
+
+    const auto stdout = settings.value(group + QStringLiteral("/stdout"), false).toBool();
+    const auto stdoutColor =
+            settings.value(group + QStringLiteral("/stdout_color"), false).toBool();
+    if (stdout || stdoutColor) {
+#ifdef QTLOGGER_DEBUG
+        std::cerr << "configure: stdout (color=" << stdoutColor << ")" << std::endl;
+#endif
+        *pipeline << StdOutSinkPtr::create(stdoutColor ? ColorMode::Auto : ColorMode::Never);
+    }
+
+    const auto stderr = settings.value(group + QStringLiteral("/stderr"), false).toBool();
+    const auto stderrColor =
+            settings.value(group + QStringLiteral("/stderr_color"), false).toBool();
+    if (stderr || stderrColor) {
+#ifdef QTLOGGER_DEBUG
+        std::cerr << "configure: stderr (color=" << stderrColor << ")" << std::endl;
+#endif
+        *pipeline << StdErrSinkPtr::create(stderrColor ? ColorMode::Auto : ColorMode::Never);
+    }
+
+    if (settings.value(group + QStringLiteral("/platform_std_log"), true).toBool()) {
+#ifdef QTLOGGER_DEBUG
+        std::cerr << "configure: platform_std_log" << std::endl;
+#endif
+        *pipeline << PlatformStdSinkPtr::create();
+    }
+
+#ifdef QTLOGGER_SYSLOG
+    const auto syslogIdent = settings.value(group + QStringLiteral("/syslog_ident")).toString();
+    if (!syslogIdent.isEmpty()) {
+#    ifdef QTLOGGER_DEBUG
+        std::cerr << "configure: syslogIdent: " << syslogIdent.toStdString() << std::endl;
+#    endif
+        *pipeline << SyslogSinkPtr::create(syslogIdent);
+    }
+#endif
+
+#ifdef QTLOGGER_SDJOURNAL
+    if (settings.value(group + QStringLiteral("/sdjournal"), false).toBool()) {
+#    ifdef QTLOGGER_DEBUG
+        std::cerr << "configure: sd-journal" << std::endl;
+#    endif
+        *pipeline << SdJournalSinkPtr::create();
+    }
+#endif
+
+    const auto path = settings.value(group + QStringLiteral("/path")).toString();
+    if (!path.isEmpty()) {
+        const auto maxFileSize = settings.value(group + QStringLiteral("/max_file_size"),
+                                                RotatingFileSink::DefaultMaxFileSize)
+                                         .toInt();
+
+        const auto maxFileCount = settings.value(group + QStringLiteral("/max_file_count"),
+                                                 RotatingFileSink::DefaultMaxFileCount)
+                                          .toInt();
+
+        const auto rotateOnStartup =
+                settings.value(group + QStringLiteral("/rotate_on_startup"), true).toBool();
+
+        const auto rotateDaily =
+                settings.value(group + QStringLiteral("/rotate_daily"), false).toBool();
+
+        const auto compress =
+                settings.value(group + QStringLiteral("/compress_old_files"), false).toBool();
+
+        // Compressed files are seekable when a block size is given
+        const auto compressionBlockSize =
+                settings.value(group + QStringLiteral("/compression_block_size"), 0).toInt();
+
+        const auto timeIndex = settings.value(group + QStringLiteral("/time_index"), false).toBool();
+
+        const auto termIndex = settings.value(group + QStringLiteral("/term_index"), false).toBool();
+
+#ifdef QTLOGGER_DEBUG
+        std::cerr << "configure: path: " << path.toStdString() << " maxFileSize: " << maxFileSize
+                  << " maxFileCount: " << maxFileCount << " rotateOnStartup: " << rotateOnStartup
+                  << " rotateDaily: " << rotateDaily << " compress: " << compress
+                  << " compressionBlockSize: " << compressionBlockSize
+                  << " timeIndex: " << timeIndex << " termIndex: " << termIndex << std::endl;
+#endif
+
+        RotatingFileSink::Options options = RotatingFileSink::Option::None;
+        if (rotateOnStartup)
+            options |= RotatingFileSink::RotationOnStartup;
+        if (rotateDaily)
+            options |= RotatingFileSink::RotationDaily;
+        if (compress && compressionBlockSize > 0)
+            options |= RotatingFileSink::Option::BlockCompression;
+        else if (compress)
+            options |= RotatingFileSink::Option::Compression;
+        if (timeIndex)
+            options |= RotatingFileSink::Option::TimeIndex;
+        if (termIndex)
+            options |= RotatingFileSink::Option::TermIndex;
+
+        auto sink = RotatingFileSinkPtr::create(path, maxFileSize, maxFileCount, options);
+        if (compressionBlockSize > 0)
+            sink->setCompressionBlockSize(compressionBlockSize);
+
+        *pipeline << sink;
+    }
+
+    const auto segmentedLogPath =
+            settings.value(group + QStringLiteral("/segmented_log_path")).toString();
+    if (!segmentedLogPath.isEmpty()) {
+        const auto segmentSize =
+                settings.value(group + QStringLiteral("/segmented_log_segment_size"),
+                               SegmentedLogSink::DefaultSegmentSize)
+                        .toLongLong();
+        const auto maxSize =
+                settings.value(group + QStringLiteral("/segmented_log_max_size"), 0).toLongLong();
+        *pipeline << SegmentedLogSinkPtr::create(segmentedLogPath, segmentSize, maxSize);
+    }
+
+#ifndef QT_NO_SHAREDMEMORY
+    const auto sharedMemoryKey =
+            settings.value(group + QStringLiteral("/shared_memory_key")).toString();
+    if (!sharedMemoryKey.isEmpty()) {
+        const auto slotCount = settings.value(group + QStringLiteral("/shared_memory_slots"),
+                                              SharedMemorySink::DefaultSlotCount)
+                                       .toInt();
+        *pipeline << SharedMemorySinkPtr::create(sharedMemoryKey, slotCount);
+    }
+#endif
+
+#ifdef QTLOGGER_SQL
+    const auto sqliteFile = settings.value(group + QStringLiteral("/sqlite_file")).toString();
+    if (!sqliteFile.isEmpty()) {
+        auto sink = SqliteSinkPtr::create(sqliteFile);
+        sink->setMaxRowCount(
+                settings.value(group + QStringLiteral("/sqlite_max_rows"), 0).toLongLong());
+        sink->setMaxAge(settings.value(group + QStringLiteral("/sqlite_max_age"), 0).toInt());
+        *pipeline << sink;
+    }
+#endif
+
+#ifdef QTLOGGER_NETWORK
+    const auto httpUrl = settings.value(group + QStringLiteral("/http_url")).toString();
+    if (!httpUrl.isEmpty()) {
+        const auto httpMsgFormat = settings.value(group + QStringLiteral("/http_msg_format"),
+                                                  QStringLiteral("default"))
+                                           .toString();
+        // TODO: add support for http_msg_format (json)
+        *pipeline << HttpSinkPtr::create(QUrl(httpUrl));
+    }
+
+    const auto gelfHost = settings.value(group + QStringLiteral("/gelf_host")).toString();
+    if (!gelfHost.isEmpty()) {
+        const auto gelfPort = settings.value(group + QStringLiteral("/gelf_port"),
+                                             GelfSink::DefaultPort)
+                                      .toUInt();
+        const auto gelfTransport = settings.value(group + QStringLiteral("/gelf_transport"),
+                                                  QStringLiteral("udp"))
+                                           .toString();
+        const auto gelfCompression = settings.value(group + QStringLiteral("/gelf_compression"),
+                                                    QStringLiteral("none"))
+                                             .toString();
+
+        auto sink = GelfSinkPtr::create(gelfHost, static_cast<quint16>(gelfPort),
+                                        gelfTransport == QLatin1String("tcp")
+                                                ? GelfSink::Transport::Tcp
+                                                : GelfSink::Transport::Udp);
+        if (gelfCompression == QLatin1String("zlib"))
+            sink->setCompression(GelfSink::Compression::Zlib);
+        else if (gelfCompression == QLatin1String("gzip"))
+            sink->setCompression(GelfSink::Compression::Gzip);
+
+        *pipeline << sink;
+    }
+
+    const auto localSocket = settings.value(group + QStringLiteral("/local_socket")).toString();
+    if (!localSocket.isEmpty()) {
+        *pipeline << LocalSocketSinkPtr::create(localSocket);
+    }
+
+    const auto tcpHost = settings.value(group + QStringLiteral("/tcp_host")).toString();
+    const auto tcpPort = settings.value(group + QStringLiteral("/tcp_port"), 0).toUInt();
+    if (!tcpHost.isEmpty() && tcpPort > 0) {
+        const auto tcpFraming = settings.value(group + QStringLiteral("/tcp_framing"),
+                                               QStringLiteral("newline"))
+                                        .toString();
+        *pipeline << TcpSinkPtr::create(tcpHost, static_cast<quint16>(tcpPort),
+                                        tcpFraming == QLatin1String("length")
+                                                ? TcpSink::Framing::LengthPrefixed
+                                                : TcpSink::Framing::Newline);
+    }
+
+    const auto otlpEndpoint = settings.value(group + QStringLiteral("/otlp_endpoint")).toString();
+    if (!otlpEndpoint.isEmpty()) {
+        auto sink = OtlpSinkPtr::create(QUrl(otlpEndpoint));
+        sink->setMaxExportBatchSize(settings.value(group + QStringLiteral("/otlp_batch_size"),
+                                                   OtlpSink::DefaultMaxExportBatchSize)
+                                            .toInt());
+        sink->setScheduleDelay(settings.value(group + QStringLiteral("/otlp_schedule_delay"),
+                                              OtlpSink::DefaultScheduleDelay)
+                                       .toInt());
+        *pipeline << sink;
+    }
+#endif
+
+#ifndef QTLOGGER_NO_THREAD
+    if (settings.value(group + QStringLiteral("/async"), false).toBool()) {
+#    ifdef QTLOGGER_DEBUG
+        std::cerr << "configure: async" << std::endl;
+#    endif
+        auto *ownThreadLogger = dynamic_cast<OwnThreadHandler<SimplePipeline> *>(pipeline);
+        if (ownThreadLogger) {
+            ownThreadLogger->setFormatInCallerThread(
+                    settings.value(group + QStringLiteral("/format_in_caller_thread"), false)
+                            .toBool());
+            const auto priorityLaneLevel =
+                    settings.value(group + QStringLiteral("/priority_lane_level")).toString();
+            if (!priorityLaneLevel.isEmpty()) {
+                ownThreadLogger->setPriorityLane(
+                        stringToQtMsgType(priorityLaneLevel, QtWarningMsg),
+                        settings.value(group + QStringLiteral("/priority_lane_ordered"), false)
+                                .toBool());
+            }
+            ownThreadLogger->moveToOwnThread();
+        }
+    }
+#endif
+}
+
+QTLOGGER_DECL_SPEC
+void configureFromIniFile(Pipeline *pipeline, const QString &path, const QString &group)
+{
+    configure(pipeline, QSettings(path, QSettings::IniFormat), group);
+}
+
+} // namespace QtLogger
+
+// categoryfilter.cpp
+
+#include <QRegularExpression>
+#include <qlogging.h>
+
+namespace QtLogger {
+
+struct CategoryFilter::Rule
+{
+    QRegularExpression category;
+    QtMsgType type;
+    bool typeMatch;
+    bool enabled;
+
+    bool matches(const QString &category, QtMsgType messageType) const;
+};
+
+QTLOGGER_DECL_SPEC
+CategoryFilter::CategoryFilter(const QString &a_rules)
+{
+    auto rules = a_rules;
+    rules.replace(";", "\n");
+    parseRules(rules);
+}
+
+QTLOGGER_DECL_SPEC
+void CategoryFilter::parseRules(const QString &rules)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    const auto lines = rules.split('\n', Qt::SkipEmptyParts);
+#else
+    const auto lines = rules.split('\n', QString::SkipEmptyParts);
+#endif
+    for (const auto &line : lines) {
+        const auto ruleRegex = QRegularExpression(
+                R"(^\s*(\S+?)(?:\.(debug|info|warning|critical))?\s*=\s*(true|false)\s*$)");
+
+        const auto match = ruleRegex.match(line);
+
+        if (!match.hasMatch())
+            continue;
+
+        auto rule = QSharedPointer<Rule>::create();
+
+        auto category = match.captured(1);
+        category = QRegularExpression::escape(category);
+        category.replace("\\*", ".*");
+
+        rule->category = QRegularExpression("^" + category + "$");
+        rule->type = stringToQtMsgType(match.captured(2));
+        rule->typeMatch = !match.captured(2).isEmpty();
+        rule->enabled = match.captured(3) == "true";
+
+        m_rules.append(rule);
+    }
+}
+
+QTLOGGER_DECL_SPEC
+bool CategoryFilter::Rule::matches(const QString &category, QtMsgType messageType) const
+{
+    return this->category.match(category).hasMatch() && (!typeMatch || type == messageType);
+}
+
+QTLOGGER_DECL_SPEC
+bool CategoryFilter::filter(const LogMessage &lmsg)
+{
+    bool enabled = true;
+    for (const auto &rule : std::as_const(m_rules)) {
+        if (rule->matches(lmsg.category(), lmsg.type())) {
+            enabled = rule->enabled;
+        }
+    }
+    return enabled;
+}
+
+} // namespace QtLogger
+
+// duplicatefilter.cpp
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutexLocker>
+#endif
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+bool DuplicateFilter::filter(const LogMessage &lmsg)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&m_mutex);
+#endif
+
+    if (lmsg.message() == m_lastMessage) {
+        return false;
+    }
+
+    m_lastMessage = lmsg.message();
+
+    return true;
+}
+
+} // namespace QtLogger
+
+// regexpfilter.cpp
+
+#include <QRegularExpression>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+RegExpFilter::RegExpFilter(const QRegularExpression &regExp) : m_regExp(regExp) { }
+
+QTLOGGER_DECL_SPEC
+QtLogger::RegExpFilter::RegExpFilter(const QString &regExp) : m_regExp(QRegularExpression(regExp))
+{
+}
+
+QTLOGGER_DECL_SPEC
+bool RegExpFilter::filter(const LogMessage &lmsg)
+{
+    return m_regExp.match(lmsg.message()).hasMatch();
+}
+
+} // namespace QtLogger
+
+// cborformatter.cpp
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+
+#include <QCborStreamWriter>
+#include <QDateTime>
+
+namespace QtLogger {
+
+namespace {
+
+void appendUtf8(QCborStreamWriter &writer, const char *str)
+{
+    writer.appendTextString(str ? str : "", str ? static_cast<qsizetype>(qstrlen(str)) : 0);
+}
+
+void appendDateTime(QCborStreamWriter &writer, const QDateTime &dateTime)
+{
+    writer.append(QCborKnownTags::EpochDateTime);
+    writer.append(static_cast<double>(dateTime.toMSecsSinceEpoch()) / 1000.0);
+}
+
+void appendVariant(QCborStreamWriter &writer, const QVariant &value)
+{
+    if (!value.isValid()) {
+        writer.appendNull();
+        return;
+    }
+
+    switch (value.userType()) {
+    case QMetaType::Bool:
+        writer.append(value.toBool());
+        break;
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+    case QMetaType::Short:
+    case QMetaType::SChar:
+        writer.append(static_cast<qint64>(value.toLongLong()));
+        break;
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+    case QMetaType::UShort:
+    case QMetaType::UChar:
+        writer.append(static_cast<quint64>(value.toULongLong()));
+        break;
+    case QMetaType::Double:
+    case QMetaType::Float:
+        writer.append(value.toDouble());
+        break;
+    case QMetaType::QByteArray:
+        writer.append(value.toByteArray());
+        break;
+    case QMetaType::QDateTime:
+        appendDateTime(writer, value.toDateTime());
+        break;
+    case QMetaType::QStringList: {
+        const auto list = value.toStringList();
+        writer.startArray(static_cast<quint64>(list.size()));
+        for (const auto &item : list) {
+            writer.append(item);
+        }
+        writer.endArray();
+        break;
+    }
+    case QMetaType::QVariantList: {
+        const auto list = value.toList();
+        writer.startArray(static_cast<quint64>(list.size()));
+        for (const auto &item : list) {
+            appendVariant(writer, item);
+        }
+        writer.endArray();
+        break;
+    }
+    case QMetaType::QVariantMap: {
+        const auto map = value.toMap();
+        writer.startMap(static_cast<quint64>(map.size()));
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            writer.append(it.key());
+            appendVariant(writer, it.value());
+        }
+        writer.endMap();
+        break;
+    }
+    case QMetaType::QVariantHash: {
+        const auto hash = value.toHash();
+        writer.startMap(static_cast<quint64>(hash.size()));
+        for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+            writer.append(it.key());
+            appendVariant(writer, it.value());
+        }
+        writer.endMap();
+        break;
+    }
+    default:
+        writer.append(value.toString());
+        break;
+    }
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+QByteArray CborFormatter::format(const LogMessage &lmsg)
+{
+    const auto attrs = lmsg.attributes();
+
+    QByteArray result;
+    result.reserve(lmsg.message().size() + 128);
+
+    QCborStreamWriter writer(&result);
+
+    // Custom attributes override the message fields, like in LogMessage::allAttributes()
+    const auto has = [&attrs](const char *key) { return attrs.contains(QLatin1String(key)); };
+
+    quint64 count = static_cast<quint64>(attrs.size());
+    for (const auto key : { "type", "line", "file", "function", "category", "message", "time" }) {
+        if (!has(key))
+            ++count;
+    }
+#ifndef QTLOGGER_NO_THREAD
+    if (!has("threadId"))
+        ++count;
+#endif
+
+    writer.startMap(count);
+
+    if (!has("type")) {
+        writer.append(QLatin1String("type"));
+        writer.append(qtMsgTypeToString(lmsg.type()));
+    }
+    if (!has("line")) {
+        writer.append(QLatin1String("line"));
+        writer.append(static_cast<qint64>(lmsg.line()));
+    }
+    if (!has("file")) {
+        writer.append(QLatin1String("file"));
+        appendUtf8(writer, lmsg.file());
+    }
+    if (!has("function")) {
+        writer.append(QLatin1String("function"));
+        appendUtf8(writer, lmsg.function());
+    }
+    if (!has("category")) {
+        writer.append(QLatin1String("category"));
+        appendUtf8(writer, lmsg.category());
+    }
+    if (!has("message")) {
+        writer.append(QLatin1String("message"));
+        writer.append(lmsg.message());
+    }
+    if (!has("time")) {
+        writer.append(QLatin1String("time"));
+        appendDateTime(writer, lmsg.time());
+    }
+#ifndef QTLOGGER_NO_THREAD
+    if (!has("threadId")) {
+        writer.append(QLatin1String("threadId"));
+        writer.append(static_cast<quint64>(lmsg.threadId()));
+    }
+#endif
+
+    for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
+        writer.append(it.key());
+        appendVariant(writer, it.value());
+    }
+
+    writer.endMap();
+
+    return result;
+}
+
+} // namespace QtLogger
+
+#endif // QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+
+// jsonformatter.cpp
+
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace QtLogger {
+
+JsonFormatter::JsonFormatter(bool compact)
+    : m_compact(compact)
+{
+}
+
+QTLOGGER_DECL_SPEC
+QString JsonFormatter::format(const LogMessage &lmsg)
+{
+    QJsonObject obj;
+
+    const auto attrs = lmsg.allAttributes();
+    for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
+        obj.insert(it.key(), QJsonValue::fromVariant(it.value()));
+    }
+
+    return QString::fromUtf8(QJsonDocument(obj).toJson(m_compact ? QJsonDocument::Compact
+                                                                 : QJsonDocument::Indented));
+}
+
+} // namespace QtLogger
+
+// logfmtformatter.cpp
+
+#include <QDateTime>
+#include <QLocale>
+#include <QStringList>
+
+namespace QtLogger {
+
+namespace {
+
+bool needsQuoting(const QString &value)
+{
+    if (value.isEmpty())
+        return true;
+
+    for (const auto ch : value) {
+        if (ch.unicode() <= ' ' || ch == QLatin1Char('=') || ch == QLatin1Char('"')
+            || ch.unicode() == 0x7F)
+            return true;
+    }
+    return false;
+}
+
+void appendValue(QString &dest, const QString &value)
+{
+    if (!needsQuoting(value)) {
+        dest.append(value);
+        return;
+    }
+
+    dest.append(QLatin1Char('"'));
+    for (const auto ch : value) {
+        switch (ch.unicode()) {
+        case '"':
+            dest.append(QLatin1String("\\\""));
+            break;
+        case '\\':
+            dest.append(QLatin1String("\\\\"));
+            break;
+        case '\n':
+            dest.append(QLatin1String("\\n"));
+            break;
+        case '\r':
+            dest.append(QLatin1String("\\r"));
+            break;
+        case '\t':
+            dest.append(QLatin1String("\\t"));
+            break;
+        default:
+            // Other control characters would break the line of the record in a terminal or a viewer
+            if (ch.unicode() < ' ' || ch.unicode() == 0x7F)
+                dest.append(QStringLiteral("\\u%1").arg(static_cast<uint>(ch.unicode()), 4, 16,
+                                                           QLatin1Char('0')));
+            else
+                dest.append(ch);
+        }
+    }
+    dest.append(QLatin1Char('"'));
+}
+
+void appendValue(QString &dest, const char *value)
+{
+    appendValue(dest, QString::fromUtf8(value));
+}
+
+// Keys can't be quoted, characters that would break the pair are replaced. Attributes named as
+// the fields written before them get a prefix, so each key of a record is unique.
+void appendKey(QString &dest, const QString &key, bool withCallsite)
+{
+    QString name;
+    name.reserve(key.size());
+    for (const auto ch : key) {
+        if (ch.unicode() <= ' ' || ch == QLatin1Char('=') || ch == QLatin1Char('"')
+            || ch.unicode() == 0x7F)
+            name.append(QLatin1Char('_'));
+        else
+            name.append(ch);
+    }
+
+    static const QStringList fieldKeys = { QStringLiteral("time"), QStringLiteral("level"),
+                                           QStringLiteral("category"), QStringLiteral("msg") };
+    static const QStringList callsiteKeys = { QStringLiteral("file"), QStringLiteral("line"),
+                                              QStringLiteral("func") };
+
+    dest.append(QLatin1Char(' '));
+    if (fieldKeys.contains(name) || (withCallsite && callsiteKeys.contains(name)))
+        dest.append(QLatin1String("attr_"));
+    dest.append(name);
+    dest.append(QLatin1Char('='));
+}
+
+void appendVariant(QString &dest, const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::Bool:
+        dest.append(value.toBool() ? QLatin1String("true") : QLatin1String("false"));
+        break;
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+    case QMetaType::Short:
+    case QMetaType::SChar:
+        dest.append(QString::number(value.toLongLong()));
+        break;
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+    case QMetaType::UShort:
+    case QMetaType::UChar:
+        dest.append(QString::number(value.toULongLong()));
+        break;
+    case QMetaType::Double:
+    case QMetaType::Float:
+        dest.append(QString::number(value.toDouble(), 'g', QLocale::FloatingPointShortest));
+        break;
+    case QMetaType::QString:
+        appendValue(dest, value.toString());
+        break;
+    case QMetaType::QDateTime:
+        dest.append(value.toDateTime().toString(Qt::ISODateWithMs));
+        break;
+    case QMetaType::QStringList:
+        appendValue(dest, value.toStringList().join(QLatin1Char(',')));
+        break;
+    default:
+        appendValue(dest, value.toString());
+    }
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+LogfmtFormatter::LogfmtFormatter(bool withCallsite) : m_withCallsite(withCallsite) { }
+
+QTLOGGER_DECL_SPEC
+QString LogfmtFormatter::format(const LogMessage &lmsg)
+{
+    const auto attrs = lmsg.attributes();
+    const auto message = lmsg.message();
+
+    QString result;
+    result.reserve(message.size() + 96 + attrs.size() * 24);
+
+    result.append(QLatin1String("time="));
+    result.append(lmsg.time().toString(Qt::ISODateWithMs));
+
+    result.append(QLatin1String(" level="));
+    result.append(qtMsgTypeToString(lmsg.type()));
+
+    if (lmsg.category() && *lmsg.category()) {
+        result.append(QLatin1String(" category="));
+        appendValue(result, lmsg.category());
+    }
+
+    result.append(QLatin1String(" msg="));
+    appendValue(result, message);
+
+    const auto withCallsite = m_withCallsite && lmsg.file();
+    if (withCallsite) {
+        result.append(QLatin1String(" file="));
+        appendValue(result, lmsg.file());
+        result.append(QLatin1String(" line="));
+        result.append(QString::number(lmsg.line()));
+        if (lmsg.function()) {
+            result.append(QLatin1String(" func="));
+            appendValue(result, lmsg.function());
+        }
+    }
+
+    for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
+        appendKey(result, it.key(), withCallsite);
+        appendVariant(result, it.value());
+    }
+
+    return result;
+}
+
+} // namespace QtLogger
+
+// patternformatter.cpp
+
+#include <optional>
+
+#include <QCoreApplication>
+#include <QHash>
+#include <QRegularExpression>
+#include <QSharedPointer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QReadWriteLock>
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+static const auto g_processStartTime = std::chrono::steady_clock::now();
+
+static const QChar DEL_MARKER = QChar(0x200B);
+
+// Defaults of %{backtrace} in qSetMessagePattern()
+constexpr int QtBacktraceDepth = 5;
+constexpr char QtBacktraceSeparator[] = "|";
+
+// Frames of the logger and of qDebug() itself, captured in addition and dropped before formatting
+constexpr int QtBacktraceExtraDepth = 8;
+
+// Values derived from a callsite string, rendered once per distinct string. Keyed by the content
+// rather than the pointer: messages queued to the own thread of a logger carry copies of the
+// strings, and a buffer may be reused for another string. Lookups share the lock, so logging threads
+// don't serialize on a cache hit.
+class CallsiteCache
+{
+public:
+    static constexpr int MaxSize = 4096;
+
+    template<typename Render>
+    QString value(const char *key, Render render) const
+    {
+        const auto bytes = QByteArray::fromRawData(key, key ? static_cast<int>(qstrlen(key)) : 0);
+
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QReadLocker locker(&m_lock);
+#endif
+            const auto it = m_values.constFind(bytes);
+            if (it != m_values.cend())
+                return it.value();
+        }
+
+        // Rendered without the lock, two threads may render the same string at worst
+        const auto value = render(bytes);
+
+#ifndef QTLOGGER_NO_THREAD
+        QWriteLocker locker(&m_lock);
+#endif
+        if (m_values.size() >= MaxSize)
+            m_values.clear();
+        // A deep copy, the raw data belongs to the message
+        m_values.insert(QByteArray(bytes.constData(), bytes.size()), value);
+
+        return value;
+    }
+
+private:
+#ifndef QTLOGGER_NO_THREAD
+    mutable QReadWriteLock m_lock;
+#endif
+    mutable QHash<QByteArray, QString> m_values;
+};
+
+class Token
+{
+public:
+    virtual ~Token() = default;
+    virtual size_t estimatedLength() const = 0;
+    virtual bool checkCondition(const LogMessage &) const { return true; }
+    virtual void appendToString(const LogMessage &lmsg, QString &dest) const = 0;
+};
+
+class ConditionToken : public Token
+{
+public:
+    bool checkCondition(const LogMessage &lmsg) const override
+    {
+        if (m_categoryCondition && isDefaultCategory(lmsg.category())) {
+            return false;
+        }
+        if (!m_hasCondition) {
+            return true;
+        }
+        return lmsg.type() == m_condition;
+    }
+
+    QtMsgType condition() const { return m_condition; }
+
+    void setCondition(QtMsgType condition)
+    {
+        m_condition = condition;
+        m_hasCondition = true;
+    }
+
+    // %{if-category}: only messages of a category other than the default one
+    void setCategoryCondition() { m_categoryCondition = true; }
+
+private:
+    QtMsgType m_condition = QtDebugMsg;
+    bool m_hasCondition = false;
+    bool m_categoryCondition = false;
+
+    static bool isDefaultCategory(const char *category)
+    {
+        return !category || qstrcmp(category, "default") == 0;
+    }
+};
+
+class FormattedToken : public ConditionToken
+{
+public:
+    enum class Alignment { None, Left, Right, Center };
+    enum class TruncateMode { None, Truncate, TruncateOnly };
+
+    struct FormatSpec
+    {
+        QChar fill = QLatin1Char(' ');
+        Alignment align = Alignment::None;
+        int width = 0;
+        TruncateMode truncateMode = TruncateMode::None;
+    };
+
+    void setFormatSpec(const FormatSpec &spec) { m_spec = spec; }
+
+    static std::optional<FormatSpec> parseFormatSpec(const QString &specString)
+    {
+        if (specString.isEmpty())
+            return std::nullopt;
+
+        QString s = specString;
+        int pos = 0;
+        FormatSpec spec;
+        bool hasExplicitFill = false;
+        bool hasTruncateSuffix = false;
+
+        if (s.endsWith(QLatin1Char('!'))) {
+            hasTruncateSuffix = true;
+            s.chop(1);
+            if (s.isEmpty())
+                return std::nullopt;
+        }
+
+        // Check if we have fill + align (fill is any char, align is <, >, ^)
+        if (s.length() >= 2) {
+            QChar possibleAlign = s.at(1);
+            if (QStringLiteral("<^>").contains(possibleAlign)) {
+                spec.fill = s.at(0);
+                spec.align = charToAlignment(possibleAlign);
+                hasExplicitFill = true;
+                pos = 2;
+            }
+        }
+
+        // If no fill+align found, check for just align
+        if (spec.align == Alignment::None && !s.isEmpty()) {
+            QChar possibleAlign = s.at(0);
+            if (QStringLiteral("<^>").contains(possibleAlign)) {
+                spec.align = charToAlignment(possibleAlign);
+                pos = 1;
+            }
+        }
+
+        // If no align found, check if it's just a number (only valid with !)
+        if (spec.align == Alignment::None && hasTruncateSuffix) {
+            // Try to parse entire remaining string as width
+            bool ok;
+            spec.width = s.toInt(&ok);
+            if (ok && spec.width > 0) {
+                spec.truncateMode = TruncateMode::TruncateOnly;
+                return spec;
+            }
+            return std::nullopt;
+        }
+
+        // If no align found at all (and not truncate-only), this is not a valid format spec
+        if (spec.align == Alignment::None)
+            return std::nullopt;
+
+        // Parse width (remaining characters should be digits)
+        if (pos >= s.length())
+            return std::nullopt;
+
+        QString widthStr = s.mid(pos);
+        bool ok;
+        spec.width = widthStr.toInt(&ok);
+        if (!ok || spec.width <= 0)
+            return std::nullopt;
+
+        // Determine truncate mode
+        if (hasTruncateSuffix) {
+            spec.truncateMode = hasExplicitFill ? TruncateMode::Truncate : TruncateMode::TruncateOnly;
+        }
+
+        return spec;
+    }
+
+    bool hasFormatSpec() const
+    {
+        return m_spec.width > 0
+               && (m_spec.align != Alignment::None
+                   || m_spec.truncateMode == TruncateMode::TruncateOnly);
+    }
+
+    static Alignment charToAlignment(QChar ch)
+    {
+        switch (ch.unicode()) {
+        case '<':
+            return Alignment::Left;
+        case '>':
+            return Alignment::Right;
+        case '^':
+            return Alignment::Center;
+        default:
+            return Alignment::None;
+        }
+    }
+
+    int formatWidth() const { return m_spec.width; }
+
+protected:
+    QString applyPadding(const QString &value) const
+    {
+        if (m_spec.width <= 0) {
+            return value;
+        }
+
+        if (m_spec.truncateMode == TruncateMode::TruncateOnly) {
+            if (value.length() <= m_spec.width) {
+                return value;
+            }
+            if (m_spec.align == Alignment::Right) {
+                return value.right(m_spec.width);
+            } else {
+                return value.left(m_spec.width);
+            }
+        }
+
+        if (m_spec.align == Alignment::None) {
+            return value;
+        }
+
+        QString val = value;
+
+        if (m_spec.truncateMode == TruncateMode::Truncate
+            && val.length() > m_spec.width) {
+            if (m_spec.align == Alignment::Right) {
+                val = val.right(m_spec.width);
+            } else {
+                val = val.left(m_spec.width);
+            }
+        }
+
+        if (val.length() >= m_spec.width) {
+            return val;
+        }
+
+        int padding = m_spec.width - val.length();
+        QString result;
+        result.reserve(m_spec.width);
+
+        switch (m_spec.align) {
+        case Alignment::Left:
+            result.append(val);
+            result.append(QString(padding, m_spec.fill));
+            break;
+        case Alignment::Right:
+            result.append(QString(padding, m_spec.fill));
+            result.append(val);
+            break;
+        case Alignment::Center: {
+            int leftPad = padding / 2;
+            int rightPad = padding - leftPad;
+            result.append(QString(leftPad, m_spec.fill));
+            result.append(val);
+            result.append(QString(rightPad, m_spec.fill));
+            break;
+        }
+        case Alignment::None:
+            return val;
+        }
+
+        return result;
+    }
+
+private:
+    FormatSpec m_spec;
+};
+
+class LiteralToken : public FormattedToken
+{
+public:
+    explicit LiteralToken(const QString &text) : m_text(text) { }
+
+    void appendToString(const LogMessage &, QString &dest) const override
+    {
+        int removeCount = 0;
+        while (!dest.isEmpty() && dest.at(dest.size() - 1) == DEL_MARKER) {
+            dest.chop(1);
+            removeCount++;
+        }
+
+        if (removeCount > 0 && removeCount < m_text.size()) {
+            dest.append(m_text.mid(removeCount));
+        } else if (removeCount == 0) {
+            dest.append(m_text);
+        }
+
+        // If removeCount >= m_text.size(), append nothing
+    }
+
+    size_t estimatedLength() const override { return m_text.size(); }
+
+private:
+    QString m_text;
+};
+
+class MessageToken : public FormattedToken
+{
+public:
+    MessageToken() { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        dest.append(applyPadding(lmsg.message()));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 50; // Estimated average message length
+    }
+};
+
+class TypeToken : public FormattedToken
+{
+public:
+    TypeToken() { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        dest.append(applyPadding(qtMsgTypeToString(lmsg.type())));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 8; // Maximum length of "critical"
+    }
+};
+
+class LineToken : public FormattedToken
+{
+public:
+    LineToken() { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        dest.append(applyPadding(QString::number(lmsg.line())));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 5; // Maximum length of "99999"
+    }
+};
+
+class FileToken : public FormattedToken
+{
+public:
+    explicit FileToken(const QString &unknown = QString()) : m_unknown(unknown) { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        dest.append(applyPadding(lmsg.file() ? QString::fromUtf8(lmsg.file()) : m_unknown));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 20; // Maximum length of "path/to/file.cpp"
+    }
+
+private:
+    QString m_unknown;
+};
+
+class ShortFileToken : public FormattedToken
+{
+public:
+    ShortFileToken(const QString &baseDir = QString()) : m_baseDir(baseDir) { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        dest.append(applyPadding(m_cache.value(lmsg.file(), [this](const QByteArray &file) {
+            return shortFile(QString::fromUtf8(file));
+        })));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 20;
+    }
+
+private:
+    QString m_baseDir;
+    CallsiteCache m_cache;
+
+    QString shortFile(const QString &file) const
+    {
+        QString value;
+        if (m_baseDir.isEmpty()) {
+            // No basedir specified - return only filename without directory
+            int lastSlash = file.lastIndexOf(QLatin1Char('/'));
+            if (lastSlash == -1) {
+                lastSlash = file.lastIndexOf(QLatin1Char('\\'));
+            }
+            if (lastSlash != -1) {
+                value = file.mid(lastSlash + 1);
+            } else {
+                value = file;
+            }
+        } else {
+            // Strip basedir prefix if present
+            if (file.startsWith(m_baseDir)) {
+                QString result = file.mid(m_baseDir.length());
+                // Remove leading slash if present
+                if (result.startsWith(QLatin1Char('/')) || result.startsWith(QLatin1Char('\\'))) {
+                    result = result.mid(1);
+                }
+                value = result;
+            } else {
+                value = file;
+            }
+        }
+        return value;
+    }
+};
+
+class FunctionToken : public FormattedToken
+{
+public:
+    explicit FunctionToken(bool cleanup = true, const QString &unknown = QString())
+        : m_cleanup(cleanup), m_unknown(unknown)
+    {
+    }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        if (!lmsg.function()) {
+            dest.append(applyPadding(m_unknown));
+            return;
+        }
+
+        dest.append(applyPadding(m_cache.value(lmsg.function(), [this](const QByteArray &function) {
+            return QString::fromLatin1(m_cleanup ? cleanup(function) : function);
+        })));
+    }
+
+    size_t estimatedLength() const override
+    {
+        if (hasFormatSpec())
+            return formatWidth();
+        return m_cleanup ? 20 : 40;
+    }
+
+    // Also used for the frames of %{backtrace}
+    static QByteArray cleanup(QByteArray func)
+    {
+        if (func.isEmpty())
+            return func;
+
+        // Helper lambda: find balanced bracket in reverse
+        auto findBalancedReverse = [&func](char open, char close, int startPos) -> int {
+            if (startPos <= 0)
+                return -1;
+            int count = 1;
+            int pos = startPos - 1;
+            while (pos >= 0 && count > 0) {
+                char c = func.at(pos);
+                if (c == close)
+                    ++count;
+                else if (c == open)
+                    --count;
+                --pos;
+            }
+            return (count == 0) ? pos + 1 : -1;
+        };
+
+        // Remove compiler metadata like [with T = int]
+        if (func.endsWith(']') && !func.startsWith('+') && !func.startsWith('-')) {
+            int openBracket = findBalancedReverse('[', ']', func.size() - 1);
+            if (openBracket != -1)
+                func.truncate(openBracket);
+        }
+        while (func.endsWith(' '))
+            func.chop(1);
+
+        // Normalize operator spacing
         func.replace("operator ", "operator");
 
-        // Try to handle function pointer return types: returntype (*name(args))(return_args)
-        bool handledFunctionPointer = false;
-        int parenOpenIdx = func.indexOf(")(");
-        if (parenOpenIdx != -1) {
-            int ptrParen = func.indexOf("(*");
-            if (ptrParen != -1 && ptrParen < parenOpenIdx) {
-                int nameStart = ptrParen + 2;
-                int parenDepth = 0;
-                int argsParen = -1;
-                for (int i = nameStart; i < parenOpenIdx; ++i) {
-                    char c = func.at(i);
-                    if (c == '(') {
-                        if (parenDepth == 0)
-                            argsParen = i;
-                        ++parenDepth;
-                    } else if (c == ')') {
-                        --parenDepth;
-                    }
-                }
-                if (argsParen != -1 && argsParen > nameStart) {
-                    func = func.mid(nameStart, argsParen - nameStart);
-                    handledFunctionPointer = true;
-                }
+        // Try to handle function pointer return types: returntype (*name(args))(return_args)
+        bool handledFunctionPointer = false;
+        int parenOpenIdx = func.indexOf(")(");
+        if (parenOpenIdx != -1) {
+            int ptrParen = func.indexOf("(*");
+            if (ptrParen != -1 && ptrParen < parenOpenIdx) {
+                int nameStart = ptrParen + 2;
+                int parenDepth = 0;
+                int argsParen = -1;
+                for (int i = nameStart; i < parenOpenIdx; ++i) {
+                    char c = func.at(i);
+                    if (c == '(') {
+                        if (parenDepth == 0)
+                            argsParen = i;
+                        ++parenDepth;
+                    } else if (c == ')') {
+                        --parenDepth;
+                    }
+                }
+                if (argsParen != -1 && argsParen > nameStart) {
+                    func = func.mid(nameStart, argsParen - nameStart);
+                    handledFunctionPointer = true;
+                }
+            }
+        }
+
+        if (!handledFunctionPointer) {
+            // Remove function arguments
+            int end = func.lastIndexOf(')');
+            if (end != -1) {
+                int openParen = findBalancedReverse('(', ')', end);
+                if (openParen != -1) {
+                    bool isOperatorCall = false;
+                    if (openParen >= 8 && func.mid(openParen - 8, 8) == "operator") {
+                        // Check that 'operator' is not part of a longer identifier
+                        if (openParen == 8) {
+                            isOperatorCall = true;
+                        } else {
+                            char prevChar = func.at(openParen - 9);
+                            if (!QChar::isLetterOrNumber(prevChar) && prevChar != '_') {
+                                isOperatorCall = true;
+                            }
+                        }
+                    }
+                    if (!isOperatorCall)
+                        func.truncate(openParen);
+                }
+            }
+
+            // Remove trailing qualifiers
+            static const char *const qualifiers[] = { " const", " volatile", " noexcept",
+                                                      " override", " final" };
+            bool found;
+            do {
+                found = false;
+                for (const char *qual : qualifiers) {
+                    if (func.endsWith(qual)) {
+                        func.chop(static_cast<int>(qstrlen(qual)));
+                        found = true;
+                        break;
+                    }
+                }
+            } while (found);
+
+            // Extract function name (remove return type)
+            int operatorPos = func.lastIndexOf("operator");
+            if (operatorPos != -1) {
+                int scanPos = operatorPos - 1;
+                while (scanPos >= 0 && func.at(scanPos) == ' ')
+                    --scanPos;
+
+                bool extracted = false;
+                while (scanPos >= 0) {
+                    if (scanPos >= 1 && func.at(scanPos) == ':' && func.at(scanPos - 1) == ':') {
+                        scanPos -= 2;
+                        while (scanPos >= 0 && func.at(scanPos) == ' ')
+                            --scanPos;
+                        if (scanPos >= 0 && func.at(scanPos) == ')') {
+                            int op = findBalancedReverse('(', ')', scanPos + 1);
+                            if (op != -1) {
+                                scanPos = op - 1;
+                                continue;
+                            }
+                        }
+                        if (scanPos >= 0 && func.at(scanPos) == '>') {
+                            int oa = findBalancedReverse('<', '>', scanPos + 1);
+                            if (oa != -1) {
+                                scanPos = oa - 1;
+                                continue;
+                            }
+                        }
+                        while (scanPos >= 0
+                               && (QChar(func.at(scanPos)).isLetterOrNumber()
+                                   || func.at(scanPos) == '_'))
+                            --scanPos;
+                    } else if (func.at(scanPos) == ' ') {
+                        func = func.mid(scanPos + 1);
+                        extracted = true;
+                        break;
+                    } else {
+                        break;
+                    }
+                }
+                if (!extracted) {
+                    int firstSpace = func.indexOf(' ');
+                    if (firstSpace != -1 && firstSpace < operatorPos)
+                        func = func.mid(firstSpace + 1);
+                }
+            } else {
+                int pos = func.size() - 1;
+                int parenCount = 0, angleCount = 0;
+                while (pos >= 0) {
+                    char c = func.at(pos);
+                    if (c == ')') {
+                        ++parenCount;
+                        --pos;
+                        continue;
+                    }
+                    if (c == '(' && parenCount > 0) {
+                        --parenCount;
+                        --pos;
+                        continue;
+                    }
+                    if (c == '>') {
+                        ++angleCount;
+                        --pos;
+                        continue;
+                    }
+                    if (c == '<' && angleCount > 0) {
+                        --angleCount;
+                        --pos;
+                        continue;
+                    }
+                    if (parenCount > 0 || angleCount > 0) {
+                        --pos;
+                        continue;
+                    }
+                    if (c == ' ') {
+                        func = func.mid(pos + 1);
+                        break;
+                    }
+                    --pos;
+                }
+            }
+            while (func.startsWith('*') || func.startsWith('&') || func.startsWith(' '))
+                func = func.mid(1);
+        }
+
+        // Remove empty parentheses before :: (e.g., method():: -> method::)
+        int pos = 0;
+        while ((pos = func.indexOf("()::", pos)) != -1) {
+            if (pos >= 8 && func.mid(pos - 8, 8) == "operator") {
+                pos += 4;
+                continue;
+            }
+            int angleDepth = 0;
+            bool insideTemplate = false;
+            for (int i = pos - 1; i >= 0; --i) {
+                if (func.at(i) == '>')
+                    ++angleDepth;
+                else if (func.at(i) == '<') {
+                    if (angleDepth == 0) {
+                        insideTemplate = true;
+                        break;
+                    }
+                    --angleDepth;
+                }
+            }
+            if (insideTemplate) {
+                pos += 4;
+                continue;
+            }
+            func.remove(pos, 2);
+        }
+
+        // Remove template parameters
+        while (true) {
+            int closeAngle = func.lastIndexOf('>');
+            if (closeAngle == -1)
+                break;
+            int opCheck = func.lastIndexOf("operator", closeAngle);
+            if (opCheck != -1) {
+                int operatorEnd = opCheck + 8;
+                if (operatorEnd <= closeAngle) {
+                    bool isOperatorSymbol = true;
+                    static const QByteArray operatorChars("=!+-*/%^&|~<>");
+                    for (int i = operatorEnd; i <= closeAngle; ++i) {
+                        char ch = func.at(i);
+                        if (!operatorChars.contains(ch)) {
+                            isOperatorSymbol = false;
+                            break;
+                        }
+                    }
+                    if (isOperatorSymbol)
+                        break;
+                }
+            }
+            int openAngle = findBalancedReverse('<', '>', closeAngle);
+            if (openAngle == -1)
+                break;
+            if (openAngle >= 8 && func.mid(openAngle - 8, 8) == "operator")
+                break;
+            if (func.mid(openAngle + 1, closeAngle - openAngle - 1).startsWith("lambda"))
+                break;
+            func.remove(openAngle, closeAngle - openAngle + 1);
+        }
+
+        return func;
+    }
+
+private:
+    bool m_cleanup;
+    QString m_unknown;
+    CallsiteCache m_cache;
+};
+
+class CategoryToken : public FormattedToken
+{
+public:
+    CategoryToken() { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        dest.append(applyPadding(lmsg.category()));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 20; // Maximum length of "categoryName"
+    }
+};
+
+class TimeToken : public FormattedToken
+{
+public:
+    explicit TimeToken(const QString &format = QString(), bool qtSyntax = false)
+        : m_format(format), m_qtSyntax(qtSyntax)
+    {
+    }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        QString value;
+        if (m_qtSyntax) {
+            value = qtTime(lmsg);
+        } else if (m_format == QLatin1String("process")) {
+            // Time since process started in seconds
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    lmsg.steadyTime() - g_processStartTime);
+            double seconds = duration.count() / 1000.0;
+            value = QString::number(seconds, 'f', 3);
+        } else if (m_format == QLatin1String("boot")) {
+            // Time since system boot in seconds using steady_clock epoch
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    lmsg.steadyTime().time_since_epoch());
+            double seconds = duration.count() / 1000.0;
+            value = QString::number(seconds, 'f', 3);
+        } else if (m_format.isEmpty()) {
+            value = lmsg.time().toString(Qt::ISODate);
+        } else {
+            value = lmsg.time().toString(m_format);
+        }
+        dest.append(applyPadding(value));
+    }
+
+    size_t estimatedLength() const override
+    {
+        if (hasFormatSpec())
+            return formatWidth();
+        if (m_format == QLatin1String("process") || m_format == QLatin1String("boot")) {
+            return 15; // Enough for "123456789.123"
+        }
+        return m_format.isEmpty() ? 20 : m_format.length() * 2; // Estimated length based on format
+    }
+
+private:
+    QString m_format;
+    bool m_qtSyntax;
+
+    // As qFormatLogMessage() prints them
+    QString qtTime(const LogMessage &lmsg) const
+    {
+        auto duration = std::chrono::milliseconds(0);
+        if (m_format == QLatin1String("process")) {
+            duration = std::chrono::duration_cast<std::chrono::milliseconds>(lmsg.steadyTime()
+                                                                             - g_processStartTime);
+        } else if (m_format == QLatin1String("boot")) {
+            duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    lmsg.steadyTime().time_since_epoch());
+        } else if (m_format.isEmpty()) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            return lmsg.time().toString(Qt::ISODateWithMs);
+#else
+            return lmsg.time().toString(Qt::ISODate);
+#endif
+        } else {
+            return lmsg.time().toString(m_format);
+        }
+
+        const auto ms = static_cast<quint64>(duration.count());
+        return QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000));
+    }
+};
+
+class ThreadIdToken : public FormattedToken
+{
+public:
+    ThreadIdToken() { }
+
+    // The system id, like Qt prints it; restored messages only have the id of the QThread
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        const auto id = lmsg.osThreadId() ? lmsg.osThreadId() : lmsg.threadId();
+        dest.append(applyPadding(QString::number(id)));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 10; // Maximum length of "9999999999"
+    }
+};
+
+class QThreadPtrToken : public FormattedToken
+{
+public:
+    QThreadPtrToken() { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        QString value = QStringLiteral("0x") + QString::number(lmsg.qthreadptr(), 16);
+        dest.append(applyPadding(value));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 18; // "0x" + 16 hex digits for 64-bit pointer
+    }
+};
+
+class ThreadNameToken : public FormattedToken
+{
+public:
+    ThreadNameToken() { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        dest.append(applyPadding(lmsg.threadName()));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 15; // Linux limits thread names to 15 bytes
+    }
+};
+
+// %{appname} and %{pid}: the attribute of AppInfoAttrs if set, otherwise of this process
+class AppInfoToken : public FormattedToken
+{
+public:
+    explicit AppInfoToken(const QString &name) : m_name(name) { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        const auto value = lmsg.attribute(m_name);
+        if (value.isValid()) {
+            dest.append(applyPadding(value.toString()));
+        } else if (m_name == QLatin1String("pid")) {
+            dest.append(applyPadding(QString::number(QCoreApplication::applicationPid())));
+        } else {
+            dest.append(applyPadding(QCoreApplication::applicationName()));
+        }
+    }
+
+    size_t estimatedLength() const override { return hasFormatSpec() ? formatWidth() : 10; }
+
+private:
+    QString m_name;
+};
+
+// %{backtrace}: the functions of the backtrace captured with the message, see backtrace.h. As in
+// Qt, every message is captured, as long as the token exists.
+class BacktraceToken : public FormattedToken
+{
+public:
+    BacktraceToken(int depth, const QString &separator) : m_depth(depth), m_separator(separator)
+    {
+        Backtrace::enableCapture(QtDebugMsg, depth + QtBacktraceExtraDepth);
+    }
+
+    ~BacktraceToken() override
+    {
+        Backtrace::releaseCapture(QtDebugMsg, m_depth + QtBacktraceExtraDepth);
+    }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        QStringList frames;
+        for (const auto &frame : Backtrace::resolve(lmsg.backtrace())) {
+            if (frames.size() >= m_depth)
+                break;
+
+            const auto module = frame.module.mid(qMax(frame.module.lastIndexOf(QLatin1Char('/')),
+                                                      frame.module.lastIndexOf(QLatin1Char('\\')))
+                                                 + 1);
+
+            // The logger and qDebug() itself
+            if (frames.isEmpty()
+                && (frame.function.startsWith(QLatin1String("QtLogger::"))
+                    || module.contains(QLatin1String("Qt5Core"))
+                    || module.contains(QLatin1String("Qt6Core"))
+                    || module == QLatin1String("QtCore")))
+                continue;
+
+            if (frame.function.isEmpty()) {
+                frames.append(QLatin1Char('?') + module + QLatin1Char('?'));
+            } else {
+                frames.append(QString::fromLatin1(FunctionToken::cleanup(frame.function.toLatin1())));
+            }
+        }
+
+        dest.append(applyPadding(frames.join(m_separator)));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : static_cast<size_t>(m_depth) * 30;
+    }
+
+private:
+    int m_depth;
+    QString m_separator;
+};
+
+class AttributeToken : public FormattedToken
+{
+public:
+    explicit AttributeToken(const QString &attributeName, bool optional = false,
+                            int removeBefore = 0, int removeAfter = 0)
+        : m_attributeName(attributeName)
+        , m_optional(optional)
+        , m_removeBefore(removeBefore)
+        , m_removeAfter(removeAfter)
+    {
+    }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        if (lmsg.hasAttribute(m_attributeName)) {
+            dest.append(applyPadding(lmsg.attribute(m_attributeName).toString()));
+            return;
+        }
+
+        if (!m_optional) {
+            QString value = QStringLiteral("%{") + m_attributeName + QStringLiteral("}");
+            dest.append(applyPadding(value));
+            return;
+        }
+
+        // Optional attribute not found: remove characters before and add ZWSP markers for removeAfter
+        if (m_removeBefore > 0 && dest.size() >= m_removeBefore) {
+            dest.chop(m_removeBefore);
+        }
+        // Append ZWSP markers to signal how many chars to remove from next token
+        for (int i = 0; i < m_removeAfter; ++i) {
+            dest.append(DEL_MARKER);
+        }
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 20; // Estimated average attribute value length
+    }
+
+private:
+    QString m_attributeName;
+    bool m_optional;
+    int m_removeBefore;
+    int m_removeAfter;
+};
+
+} // namespace
+
+class PatternFormatter::PatternFormatterPrivate
+{
+public:
+    PatternFormatterPrivate(const QString &pattern, bool qtSyntax)
+        : m_pattern(pattern), m_qtSyntax(qtSyntax)
+    {
+        parsePattern();
+    }
+
+    void parsePattern()
+    {
+        m_tokens.clear();
+
+        int pos = 0;
+        QString literalText;
+        QtMsgType currentCondition = QtDebugMsg;
+        bool hasCondition = false;
+        bool categoryCondition = false;
+
+        while (pos < m_pattern.length()) {
+            if (pos < m_pattern.length() - 1 && m_pattern[pos] == '%') {
+                if (m_pattern[pos + 1] == '{') {
+                    if (!literalText.isEmpty()) {
+                        auto token = new LiteralToken(literalText);
+                        if (hasCondition) {
+                            token->setCondition(currentCondition);
+                        }
+                        if (categoryCondition) {
+                            token->setCategoryCondition();
+                        }
+                        m_tokens.append(QSharedPointer<Token>(token));
+                        literalText.clear();
+                    }
+
+                    int closingPos = m_pattern.indexOf('}', pos + 2);
+                    if (closingPos == -1) {
+                        // No closing brace, treat as literal
+                        literalText.append('%');
+                        pos++;
+                        continue;
+                    }
+
+                    QString placeholder = m_pattern.mid(pos + 2, closingPos - pos - 2);
+
+                    std::optional<FormattedToken::FormatSpec> formatSpec;
+
+                    int lastColon = placeholder.lastIndexOf(QLatin1Char(':'));
+                    if (lastColon != -1 && lastColon < placeholder.length() - 1) {
+                        QString possibleSpec = placeholder.mid(lastColon + 1);
+                        formatSpec = FormattedToken::parseFormatSpec(possibleSpec);
+                        if (formatSpec) {
+                            placeholder = placeholder.left(lastColon);
+                        }
+                    }
+
+                    FormattedToken *token = nullptr;
+
+                    if (placeholder == QLatin1String("type")) {
+                        token = new TypeToken();
+                    } else if (placeholder == QLatin1String("line")) {
+                        token = new LineToken();
+                    } else if (placeholder == QLatin1String("file")) {
+                        token = new FileToken(m_qtSyntax ? QStringLiteral("unknown") : QString());
+                    } else if (placeholder == QLatin1String("shortfile")
+                               || placeholder.startsWith(QLatin1String("shortfile "))) {
+                        QString baseDir;
+                        if (placeholder.startsWith(QLatin1String("shortfile "))) {
+                            baseDir = placeholder.mid(10).trimmed();
+                        }
+                        token = new ShortFileToken(baseDir);
+                    } else if (placeholder == QLatin1String("function")) {
+                        // Qt cleans up the signature of %{function}
+                        token = m_qtSyntax ? new FunctionToken(true, QStringLiteral("unknown"))
+                                           : new FunctionToken(false);
+                    } else if (placeholder == QLatin1String("func")) {
+                        token = new FunctionToken(true);
+                    } else if (placeholder == QLatin1String("category")) {
+                        token = new CategoryToken();
+                    } else if (placeholder == QLatin1String("time")
+                               || placeholder.startsWith(QLatin1String("time "))) {
+                        QString timeFormat;
+                        if (placeholder.startsWith(QLatin1String("time "))) {
+                            timeFormat = placeholder.mid(5).trimmed();
+                        }
+                        token = new TimeToken(timeFormat, m_qtSyntax);
+                    } else if (placeholder == QLatin1String("threadid")) {
+                        token = new ThreadIdToken();
+                    } else if (placeholder == QLatin1String("threadname")) {
+                        token = new ThreadNameToken();
+                    } else if (placeholder == QLatin1String("qthreadptr")) {
+                        token = new QThreadPtrToken();
+                    } else if (placeholder == QLatin1String("message")) {
+                        token = new MessageToken();
+                    } else if (m_qtSyntax
+                               && (placeholder == QLatin1String("appname")
+                                   || placeholder == QLatin1String("pid"))) {
+                        token = new AppInfoToken(placeholder);
+                    } else if (m_qtSyntax
+                               && (placeholder == QLatin1String("backtrace")
+                                   || placeholder.startsWith(QLatin1String("backtrace ")))) {
+                        token = createBacktraceToken(placeholder.mid(9));
+                    } else if (placeholder == QLatin1String("if-category")) {
+                        categoryCondition = true;
+                        pos = closingPos + 1;
+                        continue;
+                    } else if (placeholder.startsWith(QLatin1String("if-"))) {
+                        // Handle conditional: %{if-debug}, %{if-warning}, etc.
+                        QString conditionType = placeholder.mid(3); // Remove "if-"
+                        currentCondition = stringToQtMsgType(conditionType, QtDebugMsg);
+                        hasCondition = true;
+                        pos = closingPos + 1;
+                        continue;
+                    } else if (placeholder == QLatin1String("endif")) {
+                        hasCondition = false;
+                        categoryCondition = false;
+                        pos = closingPos + 1;
+                        continue;
+                    } else {
+                        // Try to handle as custom attribute: %{attr} or %{attr?[N][,M]}
+                        int questionPos = placeholder.indexOf(QLatin1Char('?'));
+                        if (questionPos != -1) {
+                            QString attrName = placeholder.left(questionPos);
+                            QString suffix = placeholder.mid(questionPos + 1); // after '?'
+                            int removeBefore = 0;
+                            int removeAfter = 0;
+
+                            int commaPos = suffix.indexOf(QLatin1Char(','));
+                            if (commaPos == -1) {
+                                // Only removeBefore: %{attr?N}
+                                removeBefore = suffix.toInt();
+                            } else {
+                                // Both or only removeAfter: %{attr?N,M} or %{attr?,M}
+                                if (commaPos > 0) {
+                                    removeBefore = suffix.left(commaPos).toInt();
+                                }
+                                removeAfter = suffix.mid(commaPos + 1).toInt();
+                            }
+                            token = new AttributeToken(attrName, true, removeBefore, removeAfter);
+                        } else {
+                            token = new AttributeToken(placeholder);
+                        }
+                    }
+
+                    if (token) {
+                        if (hasCondition) {
+                            token->setCondition(currentCondition);
+                        }
+                        if (categoryCondition) {
+                            token->setCategoryCondition();
+                        }
+                        if (formatSpec) {
+                            token->setFormatSpec(*formatSpec);
+                        }
+                        m_tokens.append(QSharedPointer<Token>(token));
+                    }
+
+                    pos = closingPos + 1;
+                } else if (m_pattern[pos + 1] == '%' && !m_qtSyntax) {
+                    // Escaped %, add single % (Qt has no escape)
+                    literalText.append('%');
+                    pos += 2;
+                } else {
+                    // Just a regular %
+                    literalText.append('%');
+                    pos++;
+                }
+            } else {
+                literalText.append(m_pattern[pos]);
+                pos++;
+            }
+        }
+
+        if (!literalText.isEmpty()) {
+            auto token = new LiteralToken(literalText);
+            if (hasCondition) {
+                token->setCondition(currentCondition);
+            }
+            if (categoryCondition) {
+                token->setCategoryCondition();
+            }
+            m_tokens.append(QSharedPointer<Token>(token));
+        }
+    }
+
+    QString format(const LogMessage &lmsg)
+    {
+        if (m_tokens.isEmpty()) {
+            return lmsg.message();
+        }
+
+        size_t estimatedLength = 0;
+        for (const auto &token : std::as_const(m_tokens)) {
+            if (token->checkCondition(lmsg)) {
+                estimatedLength += token->estimatedLength();
+            }
+        }
+
+        QString result;
+        result.reserve(estimatedLength);
+
+        for (const auto &token : std::as_const(m_tokens)) {
+            if (token->checkCondition(lmsg)) {
+                token->appendToString(lmsg, result);
+            }
+        }
+
+        result.remove(DEL_MARKER);
+
+        return result;
+    }
+
+    // Arguments of %{backtrace [depth=N] [separator="..."]}
+    static FormattedToken *createBacktraceToken(const QString &args)
+    {
+        auto depth = QtBacktraceDepth;
+        auto separator = QString::fromLatin1(QtBacktraceSeparator);
+
+        static const QRegularExpression depthRx(QStringLiteral("depth=(\\d+)"));
+        static const QRegularExpression separatorRx(QStringLiteral("separator=\"([^\"]*)\""));
+
+        const auto depthMatch = depthRx.match(args);
+        if (depthMatch.hasMatch())
+            depth = qBound(1, depthMatch.captured(1).toInt(), Backtrace::MaxDepth);
+
+        const auto separatorMatch = separatorRx.match(args);
+        if (separatorMatch.hasMatch())
+            separator = separatorMatch.captured(1);
+
+        return new BacktraceToken(depth, separator);
+    }
+
+    QString m_pattern;
+    bool m_qtSyntax;
+    QList<QSharedPointer<Token>> m_tokens;
+};
+
+QTLOGGER_DECL_SPEC
+PatternFormatter::PatternFormatter(const QString &pattern)
+    : d(new PatternFormatterPrivate(pattern, false))
+{
+}
+
+QTLOGGER_DECL_SPEC
+PatternFormatter::PatternFormatter(const QString &pattern, Syntax syntax)
+    : d(new PatternFormatterPrivate(pattern, syntax == Syntax::Qt))
+{
+}
+
+QTLOGGER_DECL_SPEC
+PatternFormatter::~PatternFormatter() = default;
+
+QTLOGGER_DECL_SPEC
+QString PatternFormatter::format(const LogMessage &lmsg)
+{
+    return d->format(lmsg);
+}
+
+} // namespace QtLogger
+
+// prettyformatter.cpp
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutexLocker>
+#endif
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+PrettyFormatter::PrettyFormatter(bool colorize, int maxCategoryWidth)
+    : m_colorize(colorize), m_maxCategoryWidth(maxCategoryWidth)
+{
+}
+
+QTLOGGER_DECL_SPEC
+QString PrettyFormatter::format(const LogMessage &lmsg)
+{
+    return render(lmsg, nullptr);
+}
+
+QTLOGGER_DECL_SPEC
+QString PrettyFormatter::formatStyled(const LogMessage &lmsg, QString &plainMessage)
+{
+    return render(lmsg, m_colorize ? &plainMessage : nullptr);
+}
+
+QTLOGGER_DECL_SPEC
+QString PrettyFormatter::render(const LogMessage &lmsg, QString *plain)
+{
+    static const QString timeFormat = QStringLiteral("dd.MM.yyyy hh:mm:ss");
+    static const QChar typeLetters[] = {
+        QLatin1Char(' '), QLatin1Char('W'), QLatin1Char('E'),
+        QLatin1Char('F'), QLatin1Char('I'), QLatin1Char('S')
+    };
+
+    // ANSI color codes
+    static const QLatin1String reset("\033[0m");
+    static const QLatin1String darkGray("\033[90m");
+    static const QLatin1String bold("\033[1m");
+    static const QLatin1String green("\033[32m");
+    static const QLatin1String greenBold("\033[1;32m");
+    static const QLatin1String orange("\033[38;5;172m");
+    static const QLatin1String darkOrange("\033[38;5;208m");
+    static const QLatin1String redBold("\033[1;31m");
+    static const QLatin1String darkRedBold("\033[1;38;5;88m");
+
+    static const QLatin1Char space(' ');
+    static const QLatin1Char bracketOpen('[');
+    static const QLatin1Char bracketClose(']');
+    static const QLatin1Char letterT('T');
+
+    const auto type = lmsg.type();
+    const auto threadId = lmsg.threadId();
+    const auto categoryRaw = lmsg.category();
+    const bool isDefaultCategory = (qstrcmp(categoryRaw, "default") == 0);
+
+    // Pre-calculate category string once if needed
+    QString category;
+    if (!isDefaultCategory) {
+        category = QString::fromUtf8(categoryRaw);
+    }
+
+    // Estimate result size to minimize reallocations
+    // DateTime(19) + space(1) + type(1) + space(1) + thread(~5) + category(~20) + message
+    const int estimatedSize = 30 + category.size() + 4 + lmsg.message().size()
+                              + (m_colorize ? 80 : 0);
+
+    QString result;
+    result.reserve(estimatedSize);
+    if (plain)
+        plain->reserve(estimatedSize);
+
+    // Text goes to both renderings, escape sequences only to the colored one
+    const auto append = [&result, plain](const auto &text) {
+        result += text;
+        if (plain)
+            *plain += text;
+    };
+
+    // DateTime
+    append(lmsg.time().toString(timeFormat));
+    append(space);
+
+    // Type letter with specific colors
+    if (m_colorize) {
+        switch (type) {
+        case QtInfoMsg:
+            result += greenBold;
+            append(typeLetters[type]);
+            result += reset;
+            break;
+        case QtWarningMsg:
+            result += darkOrange;
+            append(typeLetters[type]);
+            result += reset;
+            break;
+        case QtCriticalMsg:
+            result += redBold;
+            append(typeLetters[type]);
+            result += reset;
+            break;
+        case QtFatalMsg:
+            result += darkRedBold;
+            append(typeLetters[type]);
+            result += reset;
+            break;
+        default:
+            append(typeLetters[type]);
+            break;
+        }
+    } else {
+        append(typeLetters[type]);
+    }
+
+    append(space);
+
+    // Thread handling with optimized lookup
+    int threadsCount = 0;
+    const int index = threadIndex(threadId, &threadsCount);
+
+    if (threadsCount > 1) {
+        if (index == 0) {
+            // Calculate width needed for thread field
+            int threadWidth = 3; // "T0 " minimum
+            if (threadsCount > 10) threadWidth = 4;
+            if (threadsCount > 100) threadWidth = 5;
+            append(QString(threadWidth, space));
+        } else {
+            if (m_colorize) {
+                result += bold;
+            }
+            append(letterT);
+            append(QString::number(index));
+            append(space);
+            if (m_colorize) {
+                result += reset;
+            }
+        }
+    }
+
+    // Category output (only if not default)
+    const int categoryFormatLength = isDefaultCategory ? 0 : (category.size() + 3); // "[name] "
+    if (!isDefaultCategory) {
+        if (m_colorize) {
+            result += darkGray;
+        }
+        append(bracketOpen);
+        append(category);
+        append(bracketClose);
+        append(space);
+        if (m_colorize) {
+            result += reset;
+        }
+    }
+
+    // Space for alignment
+    if (m_maxCategoryWidth > 0) {
+        const int spaceCount = updateCategoryWidth(categoryFormatLength) - categoryFormatLength;
+        if (spaceCount > 0) {
+            append(QString(spaceCount, space));
+        }
+    }
+
+    // Message with color
+    if (m_colorize) {
+        switch (type) {
+        case QtInfoMsg:
+            result += green;
+            append(lmsg.message());
+            result += reset;
+            break;
+        case QtWarningMsg:
+            result += orange;
+            append(lmsg.message());
+            result += reset;
+            break;
+        case QtCriticalMsg:
+            result += redBold;
+            append(lmsg.message());
+            result += reset;
+            break;
+        case QtFatalMsg:
+            result += darkRedBold;
+            append(lmsg.message());
+            result += reset;
+            break;
+        default:
+            append(lmsg.message());
+            break;
+        }
+    } else {
+        append(lmsg.message());
+    }
+
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+int PrettyFormatter::threadIndex(quint64 threadId, int *threadsCount)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&m_threadsMutex);
+#endif
+
+    const auto now = ++m_threadsClock;
+
+    auto it = m_threads.find(threadId);
+    if (it == m_threads.end()) {
+        auto index = m_threadsIndex;
+        if (m_threadsIndex < MaxThreads) {
+            ++m_threadsIndex;
+        } else {
+            // Threads of pools come and go, the index of the first thread is kept
+            auto lru = m_threads.end();
+            for (auto i = m_threads.begin(); i != m_threads.end(); ++i) {
+                if (i->index != 0 && (lru == m_threads.end() || i->lastUse < lru->lastUse))
+                    lru = i;
+            }
+            index = lru->index;
+            m_threads.erase(lru);
+        }
+        it = m_threads.insert(threadId, { index, now });
+    } else {
+        it->lastUse = now;
+    }
+
+    *threadsCount = m_threadsIndex;
+    return it->index;
+}
+
+QTLOGGER_DECL_SPEC
+int PrettyFormatter::updateCategoryWidth(int categoryFormatLength)
+{
+    const int width = qMin(categoryFormatLength, m_maxCategoryWidth);
+
+    // The alignment width only grows, so a lock-free maximum is enough
+    int current = m_categoryWidth.loadAcquire();
+    while (width > current) {
+        if (m_categoryWidth.testAndSetOrdered(current, width))
+            return width;
+        current = m_categoryWidth.loadAcquire();
+    }
+
+    return current;
+}
+
+} // namespace QtLogger
+
+// qtmessagepatternformatter.cpp
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+QtMessagePatternFormatter::QtMessagePatternFormatter(const QString &pattern)
+    : PatternFormatter(pattern.isEmpty() ? defaultPattern() : pattern, Syntax::Qt)
+{
+}
+
+QTLOGGER_DECL_SPEC
+QString QtMessagePatternFormatter::defaultPattern()
+{
+    const auto pattern = QString::fromLocal8Bit(qgetenv("QT_MESSAGE_PATTERN"));
+    return pattern.isEmpty() ? QString::fromUtf8(DefaultMessagePattern) : pattern;
+}
+
+} // namespace QtLogger
+
+// sentryformatter.cpp
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUuid>
+
+namespace QtLogger {
+
+namespace {
+
+QTLOGGER_DECL_SPEC
+QString qtMsgTypeToSentryLevel(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return QStringLiteral("debug");
+    case QtInfoMsg:
+        return QStringLiteral("info");
+    case QtWarningMsg:
+        return QStringLiteral("warning");
+    case QtCriticalMsg:
+        return QStringLiteral("error");
+    case QtFatalMsg:
+        return QStringLiteral("fatal");
+    default:
+        return QStringLiteral("info");
+    }
+}
+
+QTLOGGER_DECL_SPEC
+QString sentryHexAddress(quintptr address)
+{
+    return QStringLiteral("0x") + QString::number(static_cast<qulonglong>(address), 16);
+}
+
+// Sentry stack trace interface, the frames ordered from the outermost call
+QTLOGGER_DECL_SPEC
+QJsonObject sentryStacktrace(const QList<quintptr> &addresses)
+{
+    QJsonArray frames;
+    for (auto it = addresses.crbegin(); it != addresses.crend(); ++it) {
+        const auto frame = Backtrace::resolve(*it);
+
+        QJsonObject object;
+        object[QStringLiteral("instruction_addr")] = sentryHexAddress(frame.address);
+        if (!frame.function.isEmpty())
+            object[QStringLiteral("function")] = frame.function;
+        if (frame.symbolAddress)
+            object[QStringLiteral("symbol_addr")] = sentryHexAddress(frame.symbolAddress);
+        if (!frame.module.isEmpty())
+            object[QStringLiteral("package")] = frame.module;
+        if (frame.moduleAddress)
+            object[QStringLiteral("image_addr")] = sentryHexAddress(frame.moduleAddress);
+        frames.append(object);
+    }
+
+    QJsonObject stacktrace;
+    stacktrace[QStringLiteral("frames")] = frames;
+    return stacktrace;
+}
+
+} // namespace
+
+SentryFormatter::SentryFormatter(const QString &sdkName, const QString &sdkVersion)
+    : m_sdkName(sdkName), m_sdkVersion(sdkVersion)
+{
+}
+
+QTLOGGER_DECL_SPEC
+QString SentryFormatter::format(const LogMessage &lmsg)
+{
+    QJsonObject event;
+
+    // Required: Event ID (UUID without dashes)
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+    auto eventId = QUuid::createUuid().toString(QUuid::Id128);
+#else
+    auto eventId = QUuid::createUuid().toString().remove(QLatin1Char('{')).remove(QLatin1Char('}')).remove(QLatin1Char('-'));
+#endif
+    event[QStringLiteral("event_id")] = eventId;
+
+    // Required: Timestamp in ISO 8601 format
+    event[QStringLiteral("timestamp")] = lmsg.time().toUTC().toString(Qt::ISODate);
+
+    // Platform
+    event[QStringLiteral("platform")] = QStringLiteral("native");
+
+    // Severity level
+    event[QStringLiteral("level")] = qtMsgTypeToSentryLevel(lmsg.type());
+
+    // Logger name (category)
+    auto category = QString::fromLatin1(lmsg.category());
+    if (!category.isEmpty() && category != QLatin1String("default")) {
+        event[QStringLiteral("logger")] = category;
+    }
+
+    // Message
+    QJsonObject message;
+    message[QStringLiteral("formatted")] = lmsg.message();
+    event[QStringLiteral("message")] = message;
+
+    // Transaction/culprit (function name)
+    if (lmsg.function() && strlen(lmsg.function()) > 0) {
+        event[QStringLiteral("culprit")] = QString::fromLatin1(lmsg.function());
+    }
+
+    // Tags
+    QJsonObject tags;
+    tags[QStringLiteral("qt_version")] = QString::fromLatin1(qVersion());
+    if (lmsg.hasAttribute(QStringLiteral("appname"))) {
+        tags[QStringLiteral("app_name")] = lmsg.attribute(QStringLiteral("appname")).toString();
+    }
+    if (lmsg.hasAttribute(QStringLiteral("appversion"))) {
+        tags[QStringLiteral("app_version")] = lmsg.attribute(QStringLiteral("appversion")).toString();
+    }
+    event[QStringLiteral("tags")] = tags;
+
+    // Extra context
+    QJsonObject extra;
+    extra[QStringLiteral("line")] = lmsg.line();
+    if (lmsg.file() && strlen(lmsg.file()) > 0) {
+        extra[QStringLiteral("file")] = QString::fromLatin1(lmsg.file());
+    }
+    extra[QStringLiteral("thread_id")] = QString::number(lmsg.threadId());
+
+    // Add custom attributes to extra
+    const auto attrs = lmsg.attributes();
+    for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
+        // Skip already handled attributes
+        if (it.key() == QLatin1String("appname") || it.key() == QLatin1String("appversion")
+            || it.key() == QLatin1String("os_name") || it.key() == QLatin1String("os_version")
+            || it.key() == QLatin1String("kernel_version") || it.key() == QLatin1String("build_abi")
+            || it.key() == QLatin1String("cpu_arch") || it.key() == QLatin1String("host_name")
+            || it.key() == QLatin1String("backtrace")) {
+            continue;
+        }
+        extra[it.key()] = QJsonValue::fromVariant(it.value());
+    }
+    event[QStringLiteral("extra")] = extra;
+
+    // Stack trace of the logging thread (captured by the logger, see BacktraceAttr)
+    const auto addresses = lmsg.backtrace();
+    if (!addresses.isEmpty()) {
+        QJsonObject thread;
+        thread[QStringLiteral("id")] = QString::number(lmsg.threadId());
+        thread[QStringLiteral("current")] = true;
+        thread[QStringLiteral("stacktrace")] = sentryStacktrace(addresses);
+
+        QJsonObject threads;
+        threads[QStringLiteral("values")] = QJsonArray { thread };
+        event[QStringLiteral("threads")] = threads;
+    }
+
+    // Contexts
+    QJsonObject contexts;
+
+    // OS context (from SysInfoAttrs)
+    QJsonObject osContext;
+    if (lmsg.hasAttribute(QStringLiteral("os_name"))) {
+        osContext[QStringLiteral("name")] = lmsg.attribute(QStringLiteral("os_name")).toString();
+    }
+    if (lmsg.hasAttribute(QStringLiteral("os_version"))) {
+        osContext[QStringLiteral("version")] = lmsg.attribute(QStringLiteral("os_version")).toString();
+    }
+    if (lmsg.hasAttribute(QStringLiteral("kernel_version"))) {
+        osContext[QStringLiteral("kernel_version")] = lmsg.attribute(QStringLiteral("kernel_version")).toString();
+    }
+    if (lmsg.hasAttribute(QStringLiteral("build_abi"))) {
+        osContext[QStringLiteral("build")] = lmsg.attribute(QStringLiteral("build_abi")).toString();
+    }
+    if (!osContext.isEmpty()) {
+        contexts[QStringLiteral("os")] = osContext;
+    }
+
+    // Device context
+    QJsonObject deviceContext;
+    if (lmsg.hasAttribute(QStringLiteral("cpu_arch"))) {
+        deviceContext[QStringLiteral("arch")] = lmsg.attribute(QStringLiteral("cpu_arch")).toString();
+    }
+    if (lmsg.hasAttribute(QStringLiteral("host_name"))) {
+        deviceContext[QStringLiteral("name")] = lmsg.attribute(QStringLiteral("host_name")).toString();
+    }
+    if (!deviceContext.isEmpty()) {
+        contexts[QStringLiteral("device")] = deviceContext;
+    }
+
+    // Runtime context
+    QJsonObject runtimeContext;
+    runtimeContext[QStringLiteral("name")] = QStringLiteral("Qt");
+    runtimeContext[QStringLiteral("version")] = QString::fromLatin1(qVersion());
+    contexts[QStringLiteral("runtime")] = runtimeContext;
+
+    event[QStringLiteral("contexts")] = contexts;
+
+    // SDK info
+    QJsonObject sdk;
+    sdk[QStringLiteral("name")] = m_sdkName;
+    sdk[QStringLiteral("version")] = m_sdkVersion;
+    event[QStringLiteral("sdk")] = sdk;
+
+    // Fingerprint (for grouping similar events)
+    QJsonArray fingerprint;
+    fingerprint.append(qtMsgTypeToSentryLevel(lmsg.type()));
+    fingerprint.append(category.isEmpty() ? QStringLiteral("default") : category);
+    fingerprint.append(lmsg.message().left(100)); // First 100 chars of message
+    event[QStringLiteral("fingerprint")] = fingerprint;
+
+    return QString::fromUtf8(QJsonDocument(event).toJson(QJsonDocument::Compact));
+}
+
+} // namespace QtLogger
+
+// logcollector.cpp
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QHash>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSharedPointer>
+
+#include <iostream>
+
+namespace QtLogger {
+
+class LogCollector::LogCollectorPrivate
+{
+public:
+    LogCollectorPrivate() { pipeline = SimplePipelinePtr::create(); }
+
+    ~LogCollectorPrivate() { close(); }
+
+    bool listen(const QString &serverName)
+    {
+        close();
+
+        server.reset(new QLocalServer());
+
+        QObject::connect(server.data(), &QLocalServer::newConnection, server.data(),
+                         [this] { acceptConnections(); });
+
+        // A socket file left by a crashed collector would prevent listening
+        if (!server->listen(serverName)
+            && server->serverError() == QAbstractSocket::AddressInUseError
+            && !isServerRunning(serverName) && QLocalServer::removeServer(serverName)) {
+            server->listen(serverName);
+        }
+
+        if (!server->isListening()) {
+            error = server->errorString();
+            server.reset();
+            return false;
+        }
+
+        error.clear();
+        return true;
+    }
+
+    void close()
+    {
+        const auto sockets = readers.keys();
+        for (auto *socket : sockets) {
+            socket->disconnect();
+            read(socket);
+            delete socket;
+        }
+        readers.clear();
+
+        server.reset();
+    }
+
+    SimplePipelinePtr pipeline;
+    QScopedPointer<QLocalServer> server;
+    QString error;
+    quint64 messageCount = 0;
+
+    // Readers are created when the session header has arrived
+    QHash<QLocalSocket *, QSharedPointer<BinaryLogReader>> readers;
+
+private:
+    static bool isServerRunning(const QString &serverName)
+    {
+        QLocalSocket socket;
+        socket.connectToServer(serverName);
+        return socket.waitForConnected(100);
+    }
+
+    void acceptConnections()
+    {
+        while (auto *socket = server->nextPendingConnection()) {
+            // The socket is owned by the collector, not by the server
+            socket->setParent(nullptr);
+            readers.insert(socket, {});
+
+            QObject::connect(socket, &QLocalSocket::readyRead, socket,
+                             [this, socket] { read(socket); });
+            QObject::connect(socket, &QLocalSocket::disconnected, socket, [this, socket] {
+                read(socket);
+                readers.remove(socket);
+                socket->deleteLater();
+            });
+
+            read(socket);
+        }
+    }
+
+    void read(QLocalSocket *socket)
+    {
+        auto it = readers.find(socket);
+        if (it == readers.end())
+            return;
+
+        if (!it.value()) {
+            if (socket->bytesAvailable() < 5)
+                return;
+            it.value() = QSharedPointer<BinaryLogReader>::create(socket);
+        }
+
+        const auto reader = it.value();
+        bool received = false;
+
+        while (auto lmsg = reader->next()) {
+            pipeline->process(*lmsg);
+            ++messageCount;
+            received = true;
+        }
+
+        if (received)
+            pipeline->flush();
+
+        if (!reader->isValid()) {
+            std::cerr << "LogCollector: " << qPrintable(reader->errorString()) << std::endl;
+            readers.remove(socket);
+            socket->disconnect();
+            socket->abort();
+            socket->deleteLater();
+        }
+    }
+};
+
+QTLOGGER_DECL_SPEC
+LogCollector::LogCollector() : d(new LogCollectorPrivate) { }
+
+QTLOGGER_DECL_SPEC
+LogCollector::~LogCollector() = default;
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &LogCollector::pipeline()
+{
+    return *d->pipeline;
+}
+
+QTLOGGER_DECL_SPEC
+bool LogCollector::listen(const QString &serverName)
+{
+    return d->listen(serverName);
+}
+
+QTLOGGER_DECL_SPEC
+void LogCollector::close()
+{
+    d->close();
+}
+
+QTLOGGER_DECL_SPEC
+bool LogCollector::isListening() const
+{
+    return d->server && d->server->isListening();
+}
+
+QTLOGGER_DECL_SPEC
+QString LogCollector::serverName() const
+{
+    return d->server ? d->server->serverName() : QString();
+}
+
+QTLOGGER_DECL_SPEC
+QString LogCollector::errorString() const
+{
+    return d->error;
+}
+
+QTLOGGER_DECL_SPEC
+int LogCollector::connectionCount() const
+{
+    return static_cast<int>(d->readers.size());
+}
+
+QTLOGGER_DECL_SPEC
+quint64 LogCollector::messageCount() const
+{
+    return d->messageCount;
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
+
+// logger.cpp
+
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QScopedPointer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QAtomicPointer>
+#    include <QMutexLocker>
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+#ifndef QTLOGGER_NO_THREAD
+QAtomicPointer<Logger> g_activeLogger;
+#else
+Logger *g_activeLogger = nullptr;
+#endif
+
+QtMessageHandler g_previousMessageHandler = nullptr;
+
+}
+
+QTLOGGER_DECL_SPEC
+Logger *Logger::instance()
+{
+    static QScopedPointer<Logger> s_instance;
+
+    if (!s_instance) {
+        s_instance.reset(new Logger());
+    }
+
+    return s_instance.data();
+}
+
+QTLOGGER_DECL_SPEC
+Logger::~Logger()
+{
+#ifndef QTLOGGER_NO_THREAD
+    g_activeLogger.testAndSetOrdered(this, nullptr);
+#else
+    if (g_activeLogger == this) {
+        g_activeLogger = nullptr;
+    }
+#endif
+}
+
+QTLOGGER_DECL_SPEC
+void Logger::configure(const QString &path, int maxFileSize, int maxFileCount,
+                       RotatingFileSink::Options options, bool async)
+{
+    QtLogger::configure(this, path, maxFileSize, maxFileCount, options, async);
+
+    installMessageHandler();
+}
+
+QTLOGGER_DECL_SPEC
+void Logger::configure(const QSettings &settings, const QString &group)
+{
+    QtLogger::configure(this, settings, group);
+
+    installMessageHandler();
+}
+
+QTLOGGER_DECL_SPEC
+void Logger::configureFromIniFile(const QString &path, const QString &group)
+{
+    configure(QSettings(path, QSettings::IniFormat), group);
+}
+
+QTLOGGER_DECL_SPEC
+Logger &Logger::operator<<(const HandlerPtr &handler)
+{
+    append(handler);
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+void Logger::processMessage(QtMsgType type, const QMessageLogContext &context,
+                            const QString &message)
+{
+    LogMessage lmsg(type, context, message);
+
+    // Only the raw addresses are captured here, they are resolved in the thread of the logger
+    Backtrace::attach(lmsg, 1);
+
+#ifndef QTLOGGER_NO_THREAD
+    if (formatInCallerThread()) {
+        // Only the snapshot of the handlers is taken under the lock, so the leading handlers of
+        // the pipeline run concurrently in the calling threads
+        QList<HandlerPtr> handlers;
+        {
+            QMutexLocker locker(mutex());
+            handlers = this->handlers();
+        }
+
+        processInCallerThread(lmsg, handlers);
+        return;
+    }
+
+    QMutexLocker locker(mutex());
+#endif
+
+    process(lmsg);
+}
+
+QTLOGGER_DECL_SPEC
+void Logger::messageHandler(QtMsgType type, const QMessageLogContext &context,
+                            const QString &message)
+{
+#ifndef QTLOGGER_NO_THREAD
+    auto logger = g_activeLogger.loadAcquire();
+#else
+    auto logger = g_activeLogger;
+#endif
+
+    if (!logger)
+        return;
+
+    logger->processMessage(type, context, message);
+}
+
+QTLOGGER_DECL_SPEC
+void Logger::installMessageHandler()
+{
+#ifndef QTLOGGER_NO_THREAD
+    g_activeLogger.storeRelease(this);
+#else
+    g_activeLogger = this;
+#endif
+
+    auto prev = qInstallMessageHandler(messageHandler);
+
+    if (prev != messageHandler) {
+        g_previousMessageHandler = prev;
+    }
+}
+
+QTLOGGER_DECL_SPEC
+void Logger::restorePreviousMessageHandler()
+{
+    if (!g_previousMessageHandler)
+        return;
+
+    auto prev = qInstallMessageHandler(g_previousMessageHandler);
+
+    if (prev != messageHandler) {
+        qInstallMessageHandler(prev);
+    }
+
+    g_previousMessageHandler = nullptr;
+}
+
+#ifndef QTLOGGER_NO_THREAD
+
+QTLOGGER_DECL_SPEC
+void Logger::lock() const
+{
+    mutex()->lock();
+}
+
+QTLOGGER_DECL_SPEC
+void Logger::unlock() const
+{
+    mutex()->unlock();
+}
+
+#endif
+
+} // namespace QtLogger
+
+// logreplay.cpp
+
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <algorithm>
+#include <vector>
+
+namespace QtLogger {
+
+namespace {
+
+// Sleeping is only accurate to about a millisecond, the rest of the wait is spent yielding
+constexpr qint64 LogReplaySpinTime = 2000000; // ns
+
+qint64 logReplayPercentile(const std::vector<qint64> &sorted, double percentile)
+{
+    if (sorted.empty())
+        return 0;
+
+    const auto index = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1));
+    return sorted.at(index);
+}
+
+void logReplayWaitUntil(const QElapsedTimer &timer, qint64 due)
+{
+    for (;;) {
+        const auto remaining = due - timer.nsecsElapsed();
+        if (remaining <= 0)
+            return;
+
+        if (remaining > LogReplaySpinTime)
+            QThread::usleep(static_cast<unsigned long>((remaining - LogReplaySpinTime) / 1000));
+        else
+            QThread::yieldCurrentThread();
+    }
+}
+
+} // namespace
+
+class LogReplay::LogReplayPrivate
+{
+public:
+    std::vector<LogMessage> messages;
+    QString error;
+
+    Pacing pacing = Pacing::Fast;
+    double speed = 1.0;
+};
+
+QTLOGGER_DECL_SPEC
+LogReplay::LogReplay(const QString &path) : d(new LogReplayPrivate)
+{
+    BinaryLogReader reader(path);
+    if (!reader.isValid()) {
+        d->error = reader.errorString();
+        return;
+    }
+
+    while (auto lmsg = reader.next()) {
+        d->messages.push_back(*lmsg);
+    }
+
+    // A damaged frame ends the recording, the messages before it are replayed
+    if (!reader.isValid())
+        d->error = reader.errorString();
+}
+
+QTLOGGER_DECL_SPEC
+LogReplay::~LogReplay() = default;
+
+QTLOGGER_DECL_SPEC
+bool LogReplay::isValid() const
+{
+    return d->error.isEmpty();
+}
+
+QTLOGGER_DECL_SPEC
+QString LogReplay::errorString() const
+{
+    return d->error;
+}
+
+QTLOGGER_DECL_SPEC
+int LogReplay::count() const
+{
+    return static_cast<int>(d->messages.size());
+}
+
+QTLOGGER_DECL_SPEC
+qint64 LogReplay::duration() const
+{
+    if (d->messages.empty())
+        return 0;
+
+    return d->messages.front().time().msecsTo(d->messages.back().time());
+}
+
+QTLOGGER_DECL_SPEC
+LogReplay::Pacing LogReplay::pacing() const
+{
+    return d->pacing;
+}
+
+QTLOGGER_DECL_SPEC
+void LogReplay::setPacing(Pacing pacing)
+{
+    d->pacing = pacing;
+}
+
+QTLOGGER_DECL_SPEC
+double LogReplay::speed() const
+{
+    return d->speed;
+}
+
+QTLOGGER_DECL_SPEC
+void LogReplay::setSpeed(double speed)
+{
+    if (speed > 0)
+        d->speed = speed;
+}
+
+QTLOGGER_DECL_SPEC
+LogReplay::Stats LogReplay::run(Handler &handler) const
+{
+    Stats stats;
+    if (d->messages.empty())
+        return stats;
+
+    std::vector<qint64> latencies;
+    latencies.reserve(d->messages.size());
+
+    const auto firstTime = d->messages.front().time();
+    const auto paced = d->pacing == Pacing::Original;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (const auto &recorded : d->messages) {
+        // Handlers change the message, every run starts with the recorded one
+        auto lmsg = recorded;
+
+        auto start = timer.nsecsElapsed();
+        if (paced) {
+            const auto due = static_cast<qint64>(
+                    static_cast<double>(firstTime.msecsTo(lmsg.time())) * 1000000 / d->speed);
+            logReplayWaitUntil(timer, due);
+            start = due;
+        }
+
+        handler.process(lmsg);
+
+        latencies.push_back(qMax<qint64>(timer.nsecsElapsed() - start, 0));
+    }
+
+    stats.elapsed = timer.nsecsElapsed();
+    stats.count = latencies.size();
+    stats.throughput = stats.elapsed > 0
+            ? static_cast<double>(stats.count) * 1e9 / static_cast<double>(stats.elapsed)
+            : 0;
+
+    qint64 total = 0;
+    for (const auto latency : latencies) {
+        total += latency;
+    }
+    stats.meanLatency = total / static_cast<qint64>(latencies.size());
+
+    std::sort(latencies.begin(), latencies.end());
+    stats.minLatency = latencies.front();
+    stats.maxLatency = latencies.back();
+    stats.p50Latency = logReplayPercentile(latencies, 0.5);
+    stats.p90Latency = logReplayPercentile(latencies, 0.9);
+    stats.p99Latency = logReplayPercentile(latencies, 0.99);
+    stats.p999Latency = logReplayPercentile(latencies, 0.999);
+
+    return stats;
+}
+
+} // namespace QtLogger
+
+// logsearch.cpp
+
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QRunnable>
+#    include <QThread>
+#    include <QThreadPool>
+#    include <QWaitCondition>
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace QtLogger {
+
+namespace {
+
+constexpr qint64 LogSearchReadChunkSize = 1024 * 1024;
+
+using LogSearchTask = std::function<QList<LogSearch::Match>()>;
+
+// A part of a log file from a time index entry to the next one
+struct LogSearchRange
+{
+    qint64 begin;
+    qint64 end;
+};
+
+class LogSearchMatcher
+{
+public:
+    explicit LogSearchMatcher(const LogSearch::Query &query)
+        : m_minSeverity(qtMsgTypePriority(query.minLevel)),
+          m_text(query.text),
+          m_caseSensitivity(query.caseSensitivity),
+          m_regex(query.regex)
+    {
+        if (query.from.isValid())
+            m_from = query.from.toMSecsSinceEpoch();
+        if (query.to.isValid())
+            m_to = query.to.toMSecsSinceEpoch();
+
+        if (!query.category.isEmpty()) {
+            auto pattern = QRegularExpression::escape(query.category);
+            pattern.replace(QStringLiteral("\\*"), QStringLiteral(".*"));
+            m_category = QRegularExpression(QStringLiteral("^%1$").arg(pattern));
+        }
+
+        for (const auto &term : query.terms) {
+            const auto normalized = TermIndex::normalizeTerm(term);
+            if (!normalized.isEmpty())
+                m_terms.append(normalized);
+        }
+
+        m_messageConditions = m_minSeverity > 0 || !query.category.isEmpty();
+    }
+
+    qint64 from() const { return m_from; }
+    qint64 to() const { return m_to; }
+    bool hasTimeRange() const
+    {
+        return m_from != std::numeric_limits<qint64>::min()
+                || m_to != std::numeric_limits<qint64>::max();
+    }
+    const QStringList &terms() const { return m_terms; }
+
+    // Level and category conditions can only be checked for binary logs, text logs with them are
+    // reported as not searched
+    bool hasMessageConditions() const { return m_messageConditions; }
+
+    // The messages between the times may overlap the range
+    bool overlaps(qint64 first, qint64 last) const { return last >= m_from && first <= m_to; }
+
+    bool matchesText(const QString &text, const QVariantHash &attributes = QVariantHash()) const
+    {
+        if (!m_text.isEmpty() && !text.contains(m_text, m_caseSensitivity))
+            return false;
+
+        if (!m_regex.pattern().isEmpty() && !m_regex.match(text).hasMatch())
+            return false;
+
+        if (!m_terms.isEmpty()) {
+            // The same terms as in the term index, so indexed files give the same matches
+            const auto terms = TermIndex::terms(text, attributes);
+            for (const auto &term : m_terms) {
+                if (!terms.contains(term))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool matches(const LogMessage &lmsg) const
+    {
+        const auto time = lmsg.time().toMSecsSinceEpoch();
+        if (time < m_from || time > m_to)
+            return false;
+
+        if (qtMsgTypePriority(lmsg.type()) < m_minSeverity)
+            return false;
+
+        if (!m_category.pattern().isEmpty()
+            && !m_category.match(QString::fromUtf8(lmsg.category())).hasMatch()) {
+            return false;
+        }
+
+        return matchesText(lmsg.message(), lmsg.attributes());
+    }
+
+private:
+    qint64 m_from = std::numeric_limits<qint64>::min();
+    qint64 m_to = std::numeric_limits<qint64>::max();
+    int m_minSeverity;
+    QRegularExpression m_category;
+    QString m_text;
+    Qt::CaseSensitivity m_caseSensitivity;
+    QRegularExpression m_regex;
+    QStringList m_terms;
+    bool m_messageConditions = false;
+};
+
+bool isBinaryLog(QIODevice *device)
+{
+    return device->peek(5) == QByteArray(1, BinaryLog::HeaderFrame) + BinaryLog::Magic;
+}
+
+// Offset of the first line that may be in the range, by the last index entry before it
+qint64 logSearchStartOffset(const QList<TimeIndex::Entry> &entries, qint64 from)
+{
+    const auto it = std::lower_bound(entries.cbegin(), entries.cend(), from,
+                                     [](const TimeIndex::Entry &entry, qint64 msecs) {
+                                         return entry.time < msecs;
+                                     });
+    return it == entries.cbegin() ? 0 : std::prev(it)->offset;
+}
+
+// The first entry after the offset
+QList<TimeIndex::Entry>::const_iterator logSearchEntryAfter(const QList<TimeIndex::Entry> &entries,
+                                                            qint64 offset)
+{
+    return std::upper_bound(entries.cbegin(), entries.cend(), offset,
+                            [](qint64 value, const TimeIndex::Entry &entry) {
+                                return value < entry.offset;
+                            });
+}
+
+// Ranges of the time index entries that have all terms in the term index of the log file, the
+// whole file if it has no term index. Nothing if the file doesn't have the terms.
+std::optional<QList<LogSearchRange>> logSearchTermRanges(const QString &logFileName,
+                                                         const QList<TimeIndex::Entry> &entries,
+                                                         const QStringList &terms)
+{
+    const auto whole = QList<LogSearchRange> { { 0, std::numeric_limits<qint64>::max() } };
+
+    if (terms.isEmpty())
+        return whole;
+
+    const auto termIndex = TermIndexReader(TermIndex::indexFileName(logFileName));
+    if (!termIndex.isValid())
+        return whole;
+
+    QList<qint64> offsets;
+    for (int i = 0; i < terms.size(); ++i) {
+        const auto termOffsets = termIndex.ranges(terms.at(i));
+        if (i == 0) {
+            offsets = termOffsets;
+        } else {
+            QList<qint64> common;
+            std::set_intersection(offsets.cbegin(), offsets.cend(), termOffsets.cbegin(),
+                                  termOffsets.cend(), std::back_inserter(common));
+            offsets = common;
+        }
+
+        if (offsets.isEmpty())
+            return std::nullopt;
+    }
+
+    QList<LogSearchRange> ranges;
+    for (const auto offset : std::as_const(offsets)) {
+        const auto next = logSearchEntryAfter(entries, offset);
+        const auto end = next == entries.cend() ? std::numeric_limits<qint64>::max()
+                                                : next->offset;
+
+        if (!ranges.isEmpty() && ranges.last().end == offset)
+            ranges.last().end = end;
+        else
+            ranges.append({ offset, end });
+    }
+
+    return ranges;
+}
+
+bool logSearchOverlaps(const QList<LogSearchRange> &ranges, qint64 begin, qint64 end)
+{
+    return std::any_of(ranges.cbegin(), ranges.cend(), [begin, end](const LogSearchRange &range) {
+        return range.begin < end && range.end > begin;
+    });
+}
+
+// Matches the lines of a part of a text log starting at the offset. False if the lines after it
+// are past the time range.
+bool searchText(const QByteArray &data, qint64 offset, const QString &fileName,
+                const QList<TimeIndex::Entry> &entries, const LogSearchMatcher &matcher,
+                QList<LogSearch::Match> &result)
+{
+    // The last entry at or before the offset
+    int entry = static_cast<int>(logSearchEntryAfter(entries, offset) - entries.cbegin()) - 1;
+    int pos = 0;
+
+    while (pos < data.size()) {
+        const auto newline = data.indexOf('\n', pos);
+        const int end = newline < 0 ? data.size() : newline + 1;
+        const auto lineOffset = offset + pos;
+
+        while (entry + 1 < entries.size() && entries.at(entry + 1).offset <= lineOffset) {
+            ++entry;
+        }
+
+        qint64 time = 0;
+        if (!entries.isEmpty()) {
+            time = entry >= 0 ? entries.at(entry).time : entries.first().time;
+            const auto next = entry + 1 < entries.size() ? entries.at(entry + 1).time
+                                                         : std::numeric_limits<qint64>::max();
+            if (time > matcher.to())
+                return false;
+            if (!matcher.overlaps(time, next)) {
+                pos = end;
+                continue;
+            }
+        }
+
+        auto line = QString::fromUtf8(data.constData() + pos, end - pos);
+        while (line.endsWith(QLatin1Char('\n')) || line.endsWith(QLatin1Char('\r'))) {
+            line.chop(1);
+        }
+
+        if (matcher.matchesText(line)) {
+            LogSearch::Match match;
+            match.time = time;
+            match.fileName = fileName;
+            match.line = line;
+            result.append(match);
+        }
+
+        pos = end;
+    }
+
+    return true;
+}
+
+// Matches the lines of a text log from the offset to the end offset, read in chunks of whole lines
+bool searchTextFile(QIODevice *device, qint64 offset, qint64 end, const QString &fileName,
+                    const QList<TimeIndex::Entry> &entries, const LogSearchMatcher &matcher,
+                    QList<LogSearch::Match> &result)
+{
+    if (!device->seek(offset))
+        return true;
+
+    QByteArray data;
+    while (offset + data.size() < end) {
+        const auto chunk = device->read(qMin(LogSearchReadChunkSize, end - offset - data.size()));
+        if (chunk.isEmpty())
+            break;
+        data.append(chunk);
+
+        // A line longer than a chunk is completed by the next ones
+        const auto lineEnd = data.lastIndexOf('\n') + 1;
+        if (lineEnd == 0)
+            continue;
+
+        if (!searchText(data.left(lineEnd), offset, fileName, entries, matcher, result))
+            return false;
+
+        data.remove(0, lineEnd);
+        offset += lineEnd;
+    }
+
+    return data.isEmpty() || searchText(data, offset, fileName, entries, matcher, result);
+}
+
+QList<LogSearch::Match> searchBinary(QIODevice *device, const QString &fileName,
+                                     const LogSearchMatcher &matcher)
+{
+    QList<LogSearch::Match> result;
+
+    BinaryLogReader reader(device);
+    while (auto lmsg = reader.next()) {
+        if (!matcher.matches(*lmsg))
+            continue;
+
+        LogSearch::Match match;
+        match.time = lmsg->time().toMSecsSinceEpoch();
+        match.fileName = fileName;
+        match.message = QSharedPointer<const LogMessage>::create(*lmsg);
+        result.append(match);
+    }
+
+    return result;
+}
+
+#ifndef QTLOGGER_NO_THREAD
+class LogSearchRunnable : public QRunnable
+{
+public:
+    explicit LogSearchRunnable(std::function<void()> function) : m_function(std::move(function))
+    {
+    }
+
+    void run() override { m_function(); }
+
+private:
+    std::function<void()> m_function;
+};
+#endif
+
+} // namespace
+
+class LogSearch::LogSearchPrivate
+{
+public:
+    explicit LogSearchPrivate(const QString &logFileName) : logFileName(logFileName) { }
+
+    void addError(const QString &fileName, const QString &reason)
+    {
+        const QMutexLocker locker(&mutex);
+        errors.append(QStringLiteral("%1: %2").arg(fileName, reason));
+    }
+
+    void addReadError(const QString &fileName)
+    {
+        addError(fileName, QStringLiteral("can't be read"));
+    }
+
+    // The lines don't have the level and category, so the file can't be searched
+    bool rejectsText(const QString &fileName, const LogSearchMatcher &matcher)
+    {
+        if (!matcher.hasMessageConditions())
+            return false;
+
+        addError(fileName, QStringLiteral("level and category can't be matched in a text log"));
+        return true;
+    }
+
+    // The lines of a text log only have the times of its time index
+    void checkTimeRange(const QString &fileName, const QList<TimeIndex::Entry> &entries,
+                        const LogSearchMatcher &matcher)
+    {
+        if (!entries.isEmpty() || !matcher.hasTimeRange())
+            return;
+
+        const QMutexLocker locker(&mutex);
+        warnings.append(
+                QStringLiteral("%1: no time index, the time range can't be applied").arg(fileName));
+    }
+
+    // Tasks searching one file, nothing if the file is outside the time range
+    void addTasks(std::vector<LogSearchTask> &tasks, const QString &fileName,
+                  const QList<TimeIndex::Entry> &entries, qint64 nextFileTime,
+                  const LogSearchMatcher &matcher)
+    {
+        if (!entries.isEmpty() && entries.first().offset == 0
+            && !matcher.overlaps(entries.first().time, nextFileTime)) {
+            return;
+        }
+
+        const auto compressed = fileName.endsWith(QStringLiteral(".gz"));
+
+        // Indexes keep the name of the uncompressed file
+        const auto ranges = logSearchTermRanges(
+                compressed ? fileName.left(fileName.size() - 3) : fileName, entries,
+                matcher.terms());
+        if (!ranges)
+            return;
+
+        if (!compressed) {
+            tasks.push_back([this, fileName, entries, matcher, ranges] {
+                auto file = QFile(fileName);
+                if (!file.open(QIODevice::ReadOnly)) {
+                    addReadError(fileName);
+                    return QList<Match>();
+                }
+
+                if (isBinaryLog(&file))
+                    return searchBinary(&file, fileName, matcher);
+
+                if (rejectsText(fileName, matcher))
+                    return QList<Match>();
+
+                checkTimeRange(fileName, entries, matcher);
+
+                const auto start = logSearchStartOffset(entries, matcher.from());
+
+                QList<Match> result;
+                for (const auto &range : *ranges) {
+                    if (range.end <= start)
+                        continue;
+
+                    if (!searchTextFile(&file, qMax(range.begin, start), range.end, fileName,
+                                        entries, matcher, result)) {
+                        break;
+                    }
+                }
+                return result;
+            });
+            return;
+        }
+
+        auto file = SeekableGzipFile(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            addReadError(fileName);
+            return;
+        }
+
+        // The dictionaries of a binary log are needed for all following records
+        if (isBinaryLog(&file)) {
+            tasks.push_back([this, fileName, matcher] {
+                auto file = SeekableGzipFile(fileName);
+                if (!file.open(QIODevice::ReadOnly)) {
+                    addReadError(fileName);
+                    return QList<Match>();
+                }
+                return searchBinary(&file, fileName, matcher);
+            });
+            return;
+        }
+
+        if (rejectsText(fileName, matcher))
+            return;
+
+        checkTimeRange(fileName, entries, matcher);
+
+        const auto blocks = file.blocks();
+        for (int i = 0; i < blocks.size(); ++i) {
+            if (!entries.isEmpty()) {
+                const auto next = i + 1 < blocks.size() ? blocks.at(i + 1).time : nextFileTime;
+                if (!matcher.overlaps(blocks.at(i).time, next))
+                    continue;
+            }
+
+            const auto end = i + 1 < blocks.size() ? blocks.at(i + 1).uncompressedOffset
+                                                   : file.size();
+            if (!logSearchOverlaps(*ranges, blocks.at(i).uncompressedOffset, end))
+                continue;
+
+            const auto offset = blocks.at(i).uncompressedOffset;
+            tasks.push_back([this, fileName, entries, matcher, i, offset] {
+                auto file = SeekableGzipFile(fileName);
+                if (!file.open(QIODevice::ReadOnly)) {
+                    addReadError(fileName);
+                    return QList<Match>();
+                }
+                QList<Match> result;
+                searchText(file.block(i), offset, fileName, entries, matcher, result);
+                return result;
+            });
+        }
+    }
+
+    QString logFileName;
+    int maxThreadCount = 0;
+
+    QMutex mutex;
+    QStringList errors;
+    QStringList warnings;
+};
+
+QTLOGGER_DECL_SPEC
+LogSearch::LogSearch(const QString &logFileName) : d(new LogSearchPrivate(logFileName)) { }
+
+QTLOGGER_DECL_SPEC
+LogSearch::~LogSearch() = default;
+
+QTLOGGER_DECL_SPEC
+QStringList LogSearch::files() const
+{
+    return TimeIndexReader(d->logFileName).files();
+}
+
+QTLOGGER_DECL_SPEC
+int LogSearch::maxThreadCount() const
+{
+    return d->maxThreadCount;
+}
+
+QTLOGGER_DECL_SPEC
+void LogSearch::setMaxThreadCount(int maxThreadCount)
+{
+    d->maxThreadCount = qMax(maxThreadCount, 0);
+}
+
+QTLOGGER_DECL_SPEC
+QList<LogSearch::Match> LogSearch::search(const Query &query) const
+{
+    QList<Match> matches;
+    search(query, [&matches](const Match &match) { matches.append(match); });
+    return matches;
+}
+
+QTLOGGER_DECL_SPEC
+void LogSearch::search(const Query &query, const std::function<void(const Match &)> &callback) const
+{
+    {
+        const QMutexLocker locker(&d->mutex);
+        d->errors.clear();
+        d->warnings.clear();
+    }
+
+    const auto matcher = LogSearchMatcher(query);
+    const auto fileList = files();
+
+    // Time indexes of compressed files keep the name of the uncompressed file
+    QList<QList<TimeIndex::Entry>> indexes;
+    for (auto fileName : fileList) {
+        if (fileName.endsWith(QStringLiteral(".gz")))
+            fileName.chop(3);
+        indexes.append(TimeIndex::readEntries(TimeIndex::indexFileName(fileName)));
+    }
+
+    // The tasks of the file i are fileTasks[i] to fileTasks[i + 1]
+    std::vector<LogSearchTask> tasks;
+    std::vector<size_t> fileTasks;
+    for (int i = 0; i < fileList.size(); ++i) {
+        // The next file starts after the last message of this one
+        auto nextFileTime = std::numeric_limits<qint64>::max();
+        if (i + 1 < fileList.size() && !indexes.at(i + 1).isEmpty()
+            && indexes.at(i + 1).first().offset == 0) {
+            nextFileTime = indexes.at(i + 1).first().time;
+        }
+
+        fileTasks.push_back(tasks.size());
+        d->addTasks(tasks, fileList.at(i), indexes.at(i), nextFileTime, matcher);
+    }
+    fileTasks.push_back(tasks.size());
+
+    std::vector<QList<Match>> results(tasks.size());
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex doneMutex;
+    QWaitCondition doneCondition;
+    std::vector<bool> taskDone(tasks.size(), false);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(d->maxThreadCount > 0 ? d->maxThreadCount
+                                                 : QThread::idealThreadCount());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        pool.start(new LogSearchRunnable([&, i] {
+            results[i] = tasks[i]();
+
+            const QMutexLocker locker(&doneMutex);
+            taskDone[i] = true;
+            doneCondition.wakeAll();
+        }));
+    }
+#endif
+
+    // Tasks are in file order, so the sort keeps the order of messages with the same time. Lines
+    // without a time are sorted by the time of the match before them, which keeps them in place.
+    // Rotated files don't overlap in time, the matches of a file are passed on as soon as it and
+    // the files before it are searched.
+    auto lastTime = std::numeric_limits<qint64>::min();
+    for (size_t file = 0; file + 1 < fileTasks.size(); ++file) {
+        std::vector<std::pair<qint64, Match>> sorted;
+
+        for (size_t i = fileTasks[file]; i < fileTasks[file + 1]; ++i) {
+#ifndef QTLOGGER_NO_THREAD
+            {
+                QMutexLocker locker(&doneMutex);
+                while (!taskDone[i]) {
+                    doneCondition.wait(&doneMutex);
+                }
+            }
+#else
+            results[i] = tasks[i]();
+#endif
+
+            for (auto &match : results[i]) {
+                if (match.message || match.time != 0)
+                    lastTime = match.time;
+                sorted.emplace_back(lastTime, std::move(match));
+            }
+            results[i].clear();
+        }
+
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const std::pair<qint64, Match> &a, const std::pair<qint64, Match> &b) {
+                             return a.first < b.first;
+                         });
+
+        for (const auto &entry : sorted) {
+            callback(entry.second);
+        }
+    }
+}
+
+QTLOGGER_DECL_SPEC
+QStringList LogSearch::errors() const
+{
+    const QMutexLocker locker(&d->mutex);
+    return d->errors;
+}
+
+QTLOGGER_DECL_SPEC
+QStringList LogSearch::warnings() const
+{
+    const QMutexLocker locker(&d->mutex);
+    return d->warnings;
+}
+
+} // namespace QtLogger
+
+// pipeline.cpp
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+Pipeline::Pipeline(std::initializer_list<HandlerPtr> handlers, bool scoped)
+    : m_handlers(handlers), m_scoped(scoped)
+{
+}
+
+QTLOGGER_DECL_SPEC
+void Pipeline::append(const HandlerPtr &handler)
+{
+    if (handler.isNull())
+        return;
+
+    m_handlers.append(handler);
+}
+
+QTLOGGER_DECL_SPEC
+void Pipeline::append(std::initializer_list<HandlerPtr> handlers)
+{
+    m_handlers.append(handlers);
+}
+
+QTLOGGER_DECL_SPEC
+void Pipeline::remove(const HandlerPtr &handler)
+{
+    if (handler.isNull())
+        return;
+
+    m_handlers.removeAll(handler);
+}
+
+QTLOGGER_DECL_SPEC
+void Pipeline::clear()
+{
+    m_handlers.clear();
+}
+
+QTLOGGER_DECL_SPEC
+Pipeline &Pipeline::operator<<(const HandlerPtr &handler)
+{
+    append(handler);
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+bool Pipeline::process(LogMessage &lmsg)
+{
+    QString fmsg;
+    QString plainFmsg;
+    QByteArray fdata;
+    QVariantHash attrs;
+
+    if (m_scoped) {
+        if (lmsg.isFormatted()) {
+            fmsg = lmsg.formattedMessage();
+            plainFmsg = lmsg.plainFormattedMessage();
+        }
+        fdata = lmsg.formattedData();
+        attrs = lmsg.attributes();
+    }
+
+    for (auto &handler : m_handlers) {
+        if (!handler)
+            continue;
+        if (!handler->process(lmsg))
+            break;
+    }
+
+    if (m_scoped) {
+        if (!fdata.isNull())
+            lmsg.setFormattedData(fdata);
+        else
+            lmsg.setFormattedMessage(fmsg, plainFmsg);
+        lmsg.setAttributes(attrs);
+    }
+
+    return true;
+}
+
+} // namespace QtLogger
+
+// seekablegzip.cpp
+
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int GzipHeaderSize = 10;
+constexpr int GzipTrailerSize = 8;
+
+quint32 gzipCrc32(const QByteArray &data)
+{
+    static const auto table = [] {
+        std::array<quint32, 256> result {};
+        for (quint32 i = 0; i < 256; ++i) {
+            auto value = i;
+            for (int j = 0; j < 8; ++j) {
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320 : value >> 1;
+            }
+            result[i] = value;
+        }
+        return result;
+    }();
+
+    quint32 crc = 0xFFFFFFFF;
+    for (const auto byte : data) {
+        crc = table[(crc ^ static_cast<quint8>(byte)) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+void appendLittleEndian(QByteArray &data, quint32 value)
+{
+    char bytes[sizeof(value)];
+    qToLittleEndian(value, bytes);
+    data.append(bytes, sizeof(bytes));
+}
+
+void appendLittleEndian(QByteArray &data, qint64 value)
+{
+    char bytes[sizeof(value)];
+    qToLittleEndian(value, bytes);
+    data.append(bytes, sizeof(bytes));
+}
+
+// End of the block starting at the offset: the first message after blockSize bytes
+int seekableGzipBlockEnd(const QByteArray &data, int start, int blockSize,
+                         const QList<TimeIndex::Entry> &entries)
+{
+    if (data.size() - start <= blockSize)
+        return data.size();
+
+    const auto target = start + blockSize;
+
+    const auto it = std::lower_bound(entries.cbegin(), entries.cend(), target,
+                                     [](const TimeIndex::Entry &entry, qint64 offset) {
+                                         return entry.offset < offset;
+                                     });
+    if (it != entries.cend() && it->offset < data.size())
+        return static_cast<int>(it->offset);
+
+    const auto newline = data.indexOf('\n', target - 1);
+    return newline < 0 ? data.size() : newline + 1;
+}
+
+// Time of the message at the offset, or of the last indexed message before it
+qint64 seekableGzipBlockTime(qint64 offset, const QList<TimeIndex::Entry> &entries)
+{
+    const auto it = std::upper_bound(entries.cbegin(), entries.cend(), offset,
+                                     [](qint64 value, const TimeIndex::Entry &entry) {
+                                         return value < entry.offset;
+                                     });
+    return it == entries.cbegin() ? 0 : std::prev(it)->time;
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+QByteArray SeekableGzip::member(const QByteArray &data, int compressionLevel, quint32 *adler32)
+{
+    auto result = QByteArray("\x1f\x8b" // ID1, ID2
+                             "\x08" // CM (Deflate)
+                             "\x00" // FLG
+                             "\x00\x00\x00\x00" // MTIME (0 = unknown)
+                             "\x00" // XFL
+                             "\x03", // OS (Unix)
+                             GzipHeaderSize);
+
+    if (data.isEmpty()) {
+        // A single empty final block
+        result.append("\x03\x00", 2);
+        if (adler32)
+            *adler32 = 1;
+    } else {
+        // Length (4 bytes), zlib header (2 bytes), deflate data, Adler-32 (4 bytes)
+        const auto compressed = qCompress(data, compressionLevel);
+        result.append(compressed.constData() + 6, compressed.size() - 6 - 4);
+        if (adler32)
+            *adler32 = qFromBigEndian<quint32>(compressed.constData() + compressed.size() - 4);
+    }
+
+    appendLittleEndian(result, gzipCrc32(data));
+    appendLittleEndian(result, static_cast<quint32>(data.size()));
+
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+bool SeekableGzip::compress(const QString &fileName, int blockSize)
+{
+    auto inputFile = QFile(fileName);
+    if (!inputFile.open(QIODevice::ReadOnly))
+        return false;
+
+    const auto data = inputFile.readAll();
+    inputFile.close();
+
+    const auto entries = TimeIndex::readEntries(TimeIndex::indexFileName(fileName));
+
+    const auto gzFileName = fileName + QStringLiteral(".gz");
+    auto outputFile = QFile(gzFileName);
+    auto indexFile = QFile(indexFileName(gzFileName));
+
+    if (!outputFile.open(QIODevice::WriteOnly) || !indexFile.open(QIODevice::WriteOnly)) {
+        std::cerr << "SeekableGzip: Can't create compressed file: " << gzFileName.toStdString()
+                  << std::endl;
+        outputFile.remove();
+        return false;
+    }
+
+    auto index = QByteArray(Magic, 4);
+    index.append(static_cast<char>(Version));
+    index.append(3, '\0');
+    appendLittleEndian(index, static_cast<qint64>(data.size()));
+
+    auto ok = true;
+    auto start = 0;
+
+    do {
+        const auto end = seekableGzipBlockEnd(data, start, qMax(blockSize, 1), entries);
+
+        quint32 adler32 = 0;
+        const auto gzipMember = member(data.mid(start, end - start), 5, &adler32);
+
+        appendLittleEndian(index, static_cast<qint64>(start));
+        appendLittleEndian(index, outputFile.pos());
+        appendLittleEndian(index, seekableGzipBlockTime(start, entries));
+        appendLittleEndian(index, adler32);
+        index.append(4, '\0');
+
+        ok = outputFile.write(gzipMember) == gzipMember.size();
+        start = end;
+    } while (ok && start < data.size());
+
+    ok = ok && indexFile.write(index) == index.size();
+    ok = outputFile.flush() && indexFile.flush() && ok;
+
+    if (!ok) {
+        std::cerr << "SeekableGzip: Failed to write compressed file: " << gzFileName.toStdString()
+                  << std::endl;
+        outputFile.remove();
+        indexFile.remove();
+    }
+
+    return ok;
+}
+
+class SeekableGzipFile::SeekableGzipFilePrivate
+{
+public:
+    explicit SeekableGzipFilePrivate(const QString &fileName) : fileName(fileName) { }
+
+    bool loadIndex()
+    {
+        blocks.clear();
+
+        auto file = QFile(SeekableGzip::indexFileName(fileName));
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+
+        const auto data = file.readAll();
+        if (data.size() < SeekableGzip::HeaderSize || !data.startsWith(SeekableGzip::Magic)
+            || static_cast<quint8>(data.at(4)) != SeekableGzip::Version) {
+            return false;
+        }
+
+        uncompressedSize = qFromLittleEndian<qint64>(data.constData() + 8);
+        compressedSize = QFileInfo(fileName).size();
+
+        const auto count = (data.size() - SeekableGzip::HeaderSize) / SeekableGzip::EntrySize;
+        for (int i = 0; i < count; ++i) {
+            const auto entry = data.constData() + SeekableGzip::HeaderSize
+                    + i * SeekableGzip::EntrySize;
+            blocks.append({ qFromLittleEndian<qint64>(entry),
+                            qFromLittleEndian<qint64>(entry + 8),
+                            qFromLittleEndian<qint64>(entry + 16),
+                            qFromLittleEndian<quint32>(entry + 24) });
+        }
+
+        return !blocks.isEmpty() && blocks.first().uncompressedOffset == 0;
+    }
+
+    qint64 uncompressedEnd(int index) const
+    {
+        return index + 1 < blocks.size() ? blocks.at(index + 1).uncompressedOffset
+                                         : uncompressedSize;
+    }
+
+    qint64 compressedEnd(int index) const
+    {
+        return index + 1 < blocks.size() ? blocks.at(index + 1).compressedOffset : compressedSize;
+    }
+
+    // The cached block holding the offset, nullptr on error
+    const QByteArray *cachedBlock(const SeekableGzipFile *q, qint64 offset, qint64 *blockOffset)
+    {
+        const auto index = q->blockAt(offset);
+        if (index < 0)
+            return nullptr;
+
+        if (index != cacheIndex) {
+            cache = q->block(index);
+            const auto size = uncompressedEnd(index) - blocks.at(index).uncompressedOffset;
+            cacheIndex = cache.size() == size ? index : -1;
+            if (cacheIndex < 0)
+                return nullptr;
+        }
+
+        *blockOffset = offset - blocks.at(index).uncompressedOffset;
+        return &cache;
+    }
+
+    QString fileName;
+    QList<SeekableGzip::Block> blocks;
+    qint64 uncompressedSize = 0;
+    qint64 compressedSize = 0;
+
+    QByteArray cache;
+    int cacheIndex = -1;
+};
+
+QTLOGGER_DECL_SPEC
+SeekableGzipFile::SeekableGzipFile(const QString &gzFileName)
+    : d(new SeekableGzipFilePrivate(gzFileName))
+{
+}
+
+QTLOGGER_DECL_SPEC
+SeekableGzipFile::~SeekableGzipFile() = default;
+
+QTLOGGER_DECL_SPEC
+QString SeekableGzipFile::fileName() const
+{
+    return d->fileName;
+}
+
+QTLOGGER_DECL_SPEC
+bool SeekableGzipFile::open(OpenMode mode)
+{
+    if ((mode & ReadWrite) != ReadOnly) {
+        setErrorString(QStringLiteral("Seekable gzip files are read-only"));
+        return false;
+    }
+
+    if (!d->loadIndex()) {
+        setErrorString(QStringLiteral("No valid block index"));
+        return false;
+    }
+
+    // Reads go straight to the cached block
+    return QIODevice::open(ReadOnly | Unbuffered);
+}
+
+QTLOGGER_DECL_SPEC
+void SeekableGzipFile::close()
+{
+    QIODevice::close();
+    d->cache.clear();
+    d->cacheIndex = -1;
+}
+
+QTLOGGER_DECL_SPEC
+bool SeekableGzipFile::isSequential() const
+{
+    return false;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SeekableGzipFile::size() const
+{
+    return d->uncompressedSize;
+}
+
+QTLOGGER_DECL_SPEC
+const QList<SeekableGzip::Block> &SeekableGzipFile::blocks() const
+{
+    return d->blocks;
+}
+
+QTLOGGER_DECL_SPEC
+int SeekableGzipFile::blockAt(qint64 offset) const
+{
+    if (offset < 0 || offset >= d->uncompressedSize)
+        return -1;
+
+    const auto it = std::upper_bound(d->blocks.cbegin(), d->blocks.cend(), offset,
+                                     [](qint64 value, const SeekableGzip::Block &block) {
+                                         return value < block.uncompressedOffset;
+                                     });
+    return static_cast<int>(std::distance(d->blocks.cbegin(), it)) - 1;
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray SeekableGzipFile::block(int index) const
+{
+    if (index < 0 || index >= d->blocks.size())
+        return {};
+
+    const auto &block = d->blocks.at(index);
+    const auto size = d->uncompressedEnd(index) - block.uncompressedOffset;
+    if (size <= 0)
+        return {};
+
+    auto file = QFile(d->fileName);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(block.compressedOffset))
+        return {};
+
+    const auto gzipMember = file.read(d->compressedEnd(index) - block.compressedOffset);
+    if (gzipMember.size() < GzipHeaderSize + GzipTrailerSize
+        || !gzipMember.startsWith("\x1f\x8b\x08") || gzipMember.at(3) != '\0') {
+        return {};
+    }
+
+    // qUncompress() expects the size, a zlib header and the Adler-32 around the deflate data
+    QByteArray zlibData;
+    zlibData.reserve(gzipMember.size());
+    char sizeBytes[4];
+    qToBigEndian(static_cast<quint32>(size), sizeBytes);
+    zlibData.append(sizeBytes, sizeof(sizeBytes));
+    zlibData.append("\x78\x9c", 2);
+    zlibData.append(gzipMember.constData() + GzipHeaderSize,
+                    gzipMember.size() - GzipHeaderSize - GzipTrailerSize);
+    char adlerBytes[4];
+    qToBigEndian(block.adler32, adlerBytes);
+    zlibData.append(adlerBytes, sizeof(adlerBytes));
+
+    const auto data = qUncompress(zlibData);
+    return data.size() == size ? data : QByteArray();
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SeekableGzipFile::readData(char *data, qint64 maxSize)
+{
+    auto offset = pos();
+    qint64 done = 0;
+
+    while (done < maxSize && offset < d->uncompressedSize) {
+        qint64 blockOffset = 0;
+        const auto block = d->cachedBlock(this, offset, &blockOffset);
+        if (!block)
+            return done > 0 ? done : -1;
+
+        const auto count = qMin(maxSize - done, block->size() - blockOffset);
+        std::memcpy(data + done, block->constData() + blockOffset, static_cast<size_t>(count));
+        done += count;
+        offset += count;
+    }
+
+    return done;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SeekableGzipFile::readLineData(char *data, qint64 maxSize)
+{
+    auto offset = pos();
+    qint64 done = 0;
+
+    while (done < maxSize && offset < d->uncompressedSize) {
+        qint64 blockOffset = 0;
+        const auto block = d->cachedBlock(this, offset, &blockOffset);
+        if (!block)
+            return done > 0 ? done : -1;
+
+        const auto newline = block->indexOf('\n', static_cast<int>(blockOffset));
+        const auto available = (newline < 0 ? block->size() : newline + 1) - blockOffset;
+        const auto count = qMin(maxSize - done, available);
+        std::memcpy(data + done, block->constData() + blockOffset, static_cast<size_t>(count));
+        done += count;
+        offset += count;
+
+        if (newline >= 0 && count == available)
+            break;
+    }
+
+    return done;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SeekableGzipFile::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+    return -1;
+}
+
+} // namespace QtLogger
+
+// segmentedlog.cpp
+
+#include <QBuffer>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSaveFile>
+#include <QThread>
+#include <QtEndian>
+
+#ifndef QT_NO_FILESYSTEMWATCHER
+#    include <QFileSystemWatcher>
+#endif
+
+#include <algorithm>
+#include <iostream>
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int SegmentedLogPollInterval = 10; // ms
+
+constexpr char SegmentedLogSegmentSuffix[] = ".seg";
+constexpr char SegmentedLogCursorSuffix[] = ".cursor";
+
+} // namespace
+
+namespace SegmentedLog {
+
+// Offset of a record and where it starts in its segment, if known
+struct Mark
+{
+    qint64 offset = 0;
+    qint64 segmentBase = -1;
+    qint64 filePos = -1;
+};
+
+QTLOGGER_DECL_SPEC
+std::optional<Mark> readCursor(const QString &fileName)
+{
+    auto file = QFile(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt;
+
+    const auto fields = file.readAll().simplified().split(' ');
+
+    auto ok = false;
+    auto mark = Mark();
+    mark.offset = fields.first().toLongLong(&ok);
+    if (!ok)
+        return std::nullopt;
+
+    // Cursors committed without a segment position only have the offset
+    if (fields.size() == 3) {
+        auto baseOk = false;
+        auto posOk = false;
+        const auto segmentBase = fields.at(1).toLongLong(&baseOk);
+        const auto filePos = fields.at(2).toLongLong(&posOk);
+        if (baseOk && posOk) {
+            mark.segmentBase = segmentBase;
+            mark.filePos = filePos;
+        }
+    }
+
+    return mark;
+}
+
+} // namespace SegmentedLog
+
+QTLOGGER_DECL_SPEC
+QString SegmentedLog::segmentFileName(const QString &path, qint64 baseOffset)
+{
+    return QDir(path).filePath(QStringLiteral("%1").arg(baseOffset, 20, 10, QLatin1Char('0'))
+                               + QLatin1String(SegmentedLogSegmentSuffix));
+}
+
+QTLOGGER_DECL_SPEC
+QString SegmentedLog::cursorFileName(const QString &path, const QString &name)
+{
+    return QDir(path).filePath(name + QLatin1String(SegmentedLogCursorSuffix));
+}
+
+QTLOGGER_DECL_SPEC
+QList<qint64> SegmentedLog::segments(const QString &path)
+{
+    QList<qint64> bases;
+
+    const auto suffix = QLatin1String(SegmentedLogSegmentSuffix);
+    const auto fileNames = QDir(path).entryList({ QLatin1Char('*') + suffix }, QDir::Files);
+    for (const auto &fileName : fileNames) {
+        auto ok = false;
+        const auto base = fileName.left(fileName.size() - suffix.size()).toLongLong(&ok);
+        if (ok && base >= 0)
+            bases.append(base);
+    }
+
+    std::sort(bases.begin(), bases.end());
+    return bases;
+}
+
+QTLOGGER_DECL_SPEC
+QList<qint64> SegmentedLog::committedOffsets(const QString &path)
+{
+    QList<qint64> offsets;
+
+    const auto dir = QDir(path);
+    const auto fileNames = dir.entryList(
+            { QLatin1Char('*') + QLatin1String(SegmentedLogCursorSuffix) }, QDir::Files);
+    for (const auto &fileName : fileNames) {
+        if (const auto mark = SegmentedLog::readCursor(dir.filePath(fileName)))
+            offsets.append(mark->offset);
+    }
+
+    return offsets;
+}
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLog::isValidConsumerName(const QString &name)
+{
+    if (name.isEmpty() || name.startsWith(QLatin1Char('.')))
+        return false;
+
+    return std::all_of(name.cbegin(), name.cend(), [](QChar c) {
+        return (c.unicode() < 128 && c.isLetterOrNumber()) || c == QLatin1Char('_')
+                || c == QLatin1Char('-') || c == QLatin1Char('.');
+    });
+}
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLog::removeCursor(const QString &path, const QString &name)
+{
+    if (!isValidConsumerName(name))
+        return false;
+
+    return QFile::remove(cursorFileName(path, name));
+}
+
+class SegmentedLogConsumer::SegmentedLogConsumerPrivate
+{
+public:
+    // Opens the segment with the position, or the oldest one if the position was removed
+    bool openSegment()
+    {
+        const auto bases = SegmentedLog::segments(path);
+        if (bases.isEmpty())
+            return false;
+
+        auto it = std::upper_bound(bases.cbegin(), bases.cend(), position);
+        if (it == bases.cbegin()) {
+            lostCount += static_cast<quint64>(bases.first() - position);
+            position = bases.first();
+            ++it;
+        }
+
+        segmentBase = *(it - 1);
+        file.setFileName(SegmentedLog::segmentFileName(path, segmentBase));
+        // Unbuffered, so data read ahead never goes stale when the writer cuts an incomplete record
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+            return false;
+
+        headerRead = false;
+
+#ifndef QT_NO_FILESYSTEMWATCHER
+        if (watcher)
+            watcher->addPath(file.fileName());
+#endif
+
+        return true;
+    }
+
+    void closeSegment()
+    {
+#ifndef QT_NO_FILESYSTEMWATCHER
+        if (watcher && file.isOpen())
+            watcher->removePath(file.fileName());
+#endif
+        file.close();
+    }
+
+    // Checks the header and skips the records before the position, starting from the closest
+    // known mark; false until the writer has written the header of a new segment
+    bool readHeader()
+    {
+        const auto size = file.size();
+        if (size < SegmentedLog::HeaderSize)
+            return false;
+
+        const auto header = file.read(SegmentedLog::HeaderSize);
+        if (!header.startsWith(SegmentedLog::Magic)
+            || static_cast<quint8>(header.at(4)) != SegmentedLog::Version
+            || qFromLittleEndian<qint64>(header.constData() + 8) != segmentBase) {
+            std::cerr << "SegmentedLogConsumer: Invalid segment: " << file.fileName().toStdString()
+                      << std::endl;
+            file.seek(0);
+            return false;
+        }
+
+        headerRead = true;
+
+        auto offset = segmentBase;
+        auto filePos = qint64(SegmentedLog::HeaderSize);
+        for (const auto &mark : { committedMark, seekMark }) {
+            if (mark.segmentBase == segmentBase && mark.offset > offset
+                && mark.offset <= position && mark.filePos >= SegmentedLog::HeaderSize
+                && mark.filePos <= size) {
+                offset = mark.offset;
+                filePos = mark.filePos;
+            }
+        }
+
+        if (filePos != file.pos())
+            file.seek(filePos);
+
+        // The size is read once, records the writer appends meanwhile are skipped by next()
+        char number[SegmentedLog::RecordHeaderSize];
+        while (offset < position && size - filePos >= SegmentedLog::RecordHeaderSize) {
+            if (file.read(number, sizeof(number)) != sizeof(number))
+                break;
+
+            const auto recordSize = qFromLittleEndian<quint32>(number);
+            const auto next = filePos + SegmentedLog::RecordHeaderSize + recordSize;
+            if (recordSize == 0 || next > size || !file.seek(next)) {
+                file.seek(filePos);
+                break;
+            }
+
+            filePos = next;
+            ++offset;
+        }
+
+        // The cursor is ahead of the log, e.g. after the log was removed
+        position = offset;
+
+        return true;
+    }
+
+    // Size of the complete record at the current position, 0 if there is none
+    quint32 recordSize()
+    {
+        const auto pos = file.pos();
+        const auto available = file.size() - pos;
+        if (available < SegmentedLog::RecordHeaderSize)
+            return 0;
+
+        char number[SegmentedLog::RecordHeaderSize];
+        if (file.peek(number, sizeof(number)) != sizeof(number))
+            return 0;
+
+        const auto size = qFromLittleEndian<quint32>(number);
+        if (size == 0 || available - SegmentedLog::RecordHeaderSize < size)
+            return 0;
+
+        return size;
+    }
+
+    std::optional<QByteArray> readRecord()
+    {
+        const auto size = recordSize();
+        if (size == 0)
+            return std::nullopt;
+
+        file.seek(file.pos() + SegmentedLog::RecordHeaderSize);
+        return file.read(size);
+    }
+
+    // Where the record with the position starts, if the segment with it is open
+    SegmentedLog::Mark currentMark() const
+    {
+        auto mark = SegmentedLog::Mark();
+        mark.offset = position;
+        if (file.isOpen() && headerRead) {
+            mark.segmentBase = segmentBase;
+            mark.filePos = file.pos();
+        }
+        return mark;
+    }
+
+    // True if there is a complete record to read or the next segment was started
+    bool hasRecord()
+    {
+        if (!file.isOpen() && !openSegment())
+            return false;
+
+        if (!headerRead && !readHeader())
+            return false;
+
+        return recordSize() > 0 || QFile::exists(SegmentedLog::segmentFileName(path, position));
+    }
+
+    QString path;
+    QString name;
+    bool valid = false;
+
+    QFile file;
+    qint64 segmentBase = 0;
+    bool headerRead = false;
+
+    qint64 position = 0;
+    qint64 committedOffset = 0;
+
+    // Known record positions, so reopening a segment doesn't skip every record before them
+    SegmentedLog::Mark committedMark;
+    SegmentedLog::Mark seekMark;
+    quint64 lostCount = 0;
+
+#ifndef QT_NO_FILESYSTEMWATCHER
+    QFileSystemWatcher *watcher = nullptr;
+#endif
+};
+
+QTLOGGER_DECL_SPEC
+SegmentedLogConsumer::SegmentedLogConsumer(const QString &path, const QString &name,
+                                           QObject *parent)
+    : QObject(parent), d(new SegmentedLogConsumerPrivate)
+{
+    d->path = path;
+    d->name = name;
+    d->valid = SegmentedLog::isValidConsumerName(name);
+
+    if (!d->valid) {
+        std::cerr << "SegmentedLogConsumer: Invalid consumer name: " << name.toStdString()
+                  << std::endl;
+        return;
+    }
+
+    QDir().mkpath(path);
+
+    if (const auto mark = SegmentedLog::readCursor(SegmentedLog::cursorFileName(path, name))) {
+        d->committedMark = *mark;
+        d->committedOffset = mark->offset;
+        d->position = mark->offset;
+    } else {
+        // Registers the consumer, so the retention keeps the messages it hasn't read yet
+        const auto bases = SegmentedLog::segments(path);
+        d->position = bases.isEmpty() ? 0 : bases.first();
+        commit();
+    }
+
+#ifndef QT_NO_FILESYSTEMWATCHER
+    d->watcher = new QFileSystemWatcher(this);
+    d->watcher->addPath(path);
+    QObject::connect(d->watcher, &QFileSystemWatcher::fileChanged, this,
+                     &SegmentedLogConsumer::readyRead);
+    QObject::connect(d->watcher, &QFileSystemWatcher::directoryChanged, this,
+                     &SegmentedLogConsumer::readyRead);
+#endif
+}
+
+QTLOGGER_DECL_SPEC
+SegmentedLogConsumer::~SegmentedLogConsumer() = default;
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLogConsumer::isValid() const
+{
+    return d->valid;
+}
+
+QTLOGGER_DECL_SPEC
+QString SegmentedLogConsumer::path() const
+{
+    return d->path;
+}
+
+QTLOGGER_DECL_SPEC
+QString SegmentedLogConsumer::name() const
+{
+    return d->name;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SegmentedLogConsumer::position() const
+{
+    return d->position;
+}
+
+QTLOGGER_DECL_SPEC
+void SegmentedLogConsumer::seek(qint64 offset)
+{
+    // Remembers where the current record starts, so seeking ahead in the segment continues there
+    d->seekMark = d->currentMark();
+    d->closeSegment();
+    d->position = qMax<qint64>(offset, 0);
+}
+
+QTLOGGER_DECL_SPEC
+std::optional<LogMessage> SegmentedLogConsumer::next()
+{
+    if (!d->valid)
+        return std::nullopt;
+
+    for (;;) {
+        if (!d->hasRecord())
+            return std::nullopt;
+
+        const auto data = d->readRecord();
+        if (!data) {
+            // The segment is complete, the next one starts with the position
+            d->closeSegment();
+            continue;
+        }
+
+        ++d->position;
+
+        QBuffer buffer;
+        buffer.setData(*data);
+        buffer.open(QIODevice::ReadOnly);
+
+        BinaryLogReader reader(&buffer);
+        if (auto lmsg = reader.next())
+            return lmsg;
+    }
+}
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLogConsumer::commit()
+{
+    if (!d->valid)
+        return false;
+
+    auto file = QSaveFile(SegmentedLog::cursorFileName(d->path, d->name));
+    if (!file.open(QIODevice::WriteOnly)) {
+        std::cerr << "SegmentedLogConsumer: Can't open cursor file: "
+                  << file.fileName().toStdString() << " error: " << file.errorString().toStdString()
+                  << std::endl;
+        return false;
+    }
+
+    const auto mark = d->currentMark();
+    auto text = QByteArray::number(mark.offset);
+    if (mark.filePos >= 0)
+        text += ' ' + QByteArray::number(mark.segmentBase) + ' ' + QByteArray::number(mark.filePos);
+
+    file.write(text);
+    if (!file.commit())
+        return false;
+
+    d->committedMark = mark;
+    d->committedOffset = d->position;
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SegmentedLogConsumer::committedOffset() const
+{
+    return d->committedOffset;
+}
+
+QTLOGGER_DECL_SPEC
+quint64 SegmentedLogConsumer::lostCount() const
+{
+    return d->lostCount;
+}
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLogConsumer::waitForReadyRead(int msecs)
+{
+    if (!d->valid)
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!d->hasRecord()) {
+        if (msecs >= 0 && timer.elapsed() >= msecs)
+            return false;
+        QThread::msleep(SegmentedLogPollInterval);
+    }
+
+    return true;
+}
+
+} // namespace QtLogger
+
+// sharedmemoryring.cpp
+
+#ifndef QT_NO_SHAREDMEMORY
+
+#include <QBuffer>
+#include <QSharedMemory>
+
+#include <cstring>
+
+namespace QtLogger {
+
+class SharedMemoryReader::SharedMemoryReaderPrivate
+{
+public:
+    explicit SharedMemoryReaderPrivate(const QString &key) : memory(key)
+    {
+        if (!memory.attach(QSharedMemory::ReadOnly)) {
+            error = memory.errorString();
+            return;
+        }
+
+        if (memory.size() < SharedMemoryRing::HeaderSize) {
+            error = QStringLiteral("Not a shared memory ring buffer");
+            return;
+        }
+
+        base = static_cast<const char *>(memory.constData());
+        header = reinterpret_cast<const SharedMemoryRing::Header *>(base);
+
+        if (header->magic != SharedMemoryRing::Magic
+            || header->version != SharedMemoryRing::Version || header->slotCount == 0
+            || header->slotSize <= static_cast<quint32>(SharedMemoryRing::SlotHeaderSize)
+            || memory.size() < SharedMemoryRing::segmentSize(static_cast<int>(header->slotCount),
+                                                             static_cast<int>(header->slotSize))) {
+            error = QStringLiteral("Not a shared memory ring buffer");
+            header = nullptr;
+            return;
+        }
+
+        slotCount = header->slotCount;
+        slotSize = header->slotSize;
+        payloadSize = slotSize - SharedMemoryRing::SlotHeaderSize;
+
+        // Nothing has been overwritten yet, so every lost record can be counted
+        const auto head = header->head.load(std::memory_order_acquire);
+        position = head > slotCount ? head - slotCount : 0;
+        hasNextRecord = head <= slotCount;
+    }
+
+    const SharedMemoryRing::Slot *slotAt(quint64 n) const
+    {
+        return reinterpret_cast<const SharedMemoryRing::Slot *>(
+                base + SharedMemoryRing::HeaderSize + (n % slotCount) * slotSize);
+    }
+
+    bool isComplete(quint64 n) const
+    {
+        return slotAt(n)->state.load(std::memory_order_acquire) == 2 * n + 2;
+    }
+
+    // Copies the record starting at the current position, nothing if it was overwritten meanwhile
+    std::optional<QByteArray> readRecord(quint64 &record, quint32 &slots)
+    {
+        const auto *first = slotAt(position);
+        if (!isComplete(position))
+            return {};
+
+        record = first->record;
+        slots = first->slots;
+        const auto size = first->size;
+
+        // Continuation slot, or fields torn by the writer
+        const auto expectedSlots =
+                qMax<quint64>(1, (static_cast<quint64>(size) + payloadSize - 1) / payloadSize);
+        if (slots == 0 || slots > slotCount || slots != expectedSlots)
+            return {};
+
+        QByteArray data(static_cast<int>(size), Qt::Uninitialized);
+        for (quint32 i = 0; i < slots; ++i) {
+            if (i > 0 && !isComplete(position + i))
+                return {};
+            const auto offset = i * payloadSize;
+            std::memcpy(data.data() + offset,
+                        reinterpret_cast<const char *>(slotAt(position + i))
+                                + SharedMemoryRing::SlotHeaderSize,
+                        qMin(payloadSize, size - offset));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        for (quint32 i = 0; i < slots; ++i) {
+            if (slotAt(position + i)->state.load(std::memory_order_relaxed)
+                != 2 * (position + i) + 2)
+                return {};
+        }
+
+        return data;
+    }
+
+    QSharedMemory memory;
+    QString error;
+
+    const char *base = nullptr;
+    const SharedMemoryRing::Header *header = nullptr;
+    quint64 slotCount = 0;
+    quint32 slotSize = 0;
+    quint32 payloadSize = 0;
+
+    quint64 position = 0;
+    quint64 nextRecord = 0;
+    bool hasNextRecord = false;
+    quint64 overruns = 0;
+};
+
+QTLOGGER_DECL_SPEC
+SharedMemoryReader::SharedMemoryReader(const QString &key) : d(new SharedMemoryReaderPrivate(key))
+{
+}
+
+QTLOGGER_DECL_SPEC
+SharedMemoryReader::~SharedMemoryReader() = default;
+
+QTLOGGER_DECL_SPEC
+bool SharedMemoryReader::isValid() const
+{
+    return d->header != nullptr;
+}
+
+QTLOGGER_DECL_SPEC
+QString SharedMemoryReader::errorString() const
+{
+    return d->error;
+}
+
+QTLOGGER_DECL_SPEC
+std::optional<LogMessage> SharedMemoryReader::next()
+{
+    if (!d->header)
+        return {};
+
+    while (true) {
+        const auto head = d->header->head.load(std::memory_order_acquire);
+
+        // The segment was initialized again by a new writer
+        if (head < d->position) {
+            d->position = head > d->slotCount ? head - d->slotCount : 0;
+            d->hasNextRecord = false;
+        }
+
+        if (d->position == head)
+            return {};
+
+        if (head - d->position > d->slotCount)
+            d->position = head - d->slotCount;
+
+        quint64 record = 0;
+        quint32 slots = 0;
+        const auto data = d->readRecord(record, slots);
+        if (!data) {
+            ++d->position;
+            continue;
+        }
+
+        d->position += slots;
+
+        if (d->hasNextRecord && record > d->nextRecord)
+            d->overruns += record - d->nextRecord;
+        d->nextRecord = record + 1;
+        d->hasNextRecord = true;
+
+        QBuffer buffer;
+        buffer.setData(*data);
+        buffer.open(QIODevice::ReadOnly);
+
+        BinaryLogReader reader(&buffer);
+        if (auto lmsg = reader.next())
+            return lmsg;
+    }
+}
+
+QTLOGGER_DECL_SPEC
+void SharedMemoryReader::skipToLatest()
+{
+    if (!d->header)
+        return;
+
+    // The record counter is published before head, so it never runs behind the position
+    d->position = d->header->head.load(std::memory_order_acquire);
+    d->nextRecord = d->header->nextRecord.load(std::memory_order_relaxed);
+    d->hasNextRecord = true;
+}
+
+QTLOGGER_DECL_SPEC
+quint64 SharedMemoryReader::overruns() const
+{
+    return d->overruns;
+}
+
+QTLOGGER_DECL_SPEC
+quint64 SharedMemoryReader::dropped() const
+{
+    return d->header ? d->header->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace QtLogger
+
+#endif // QT_NO_SHAREDMEMORY
+
+// simplepipeline.cpp
+
+#include <QCoreApplication>
+
+#ifdef QTLOGGER_NETWORK
+
+#endif
+
+#ifdef QTLOGGER_SYSLOG
+
+#endif
+
+#ifdef QTLOGGER_ANDROIDLOG
+
+#endif
+
+#ifdef QTLOGGER_OSLOG
+
+#endif
+
+#ifdef QTLOGGER_SDJOURNAL
+
+#endif
+
+#ifdef QTLOGGER_SQL
+
+#endif
+
+#ifdef Q_OS_WIN
+
+#endif
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::addSeqNumber(const QString &name)
+{
+    append(SeqNumberAttrPtr::create(name));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::addMessageTemplates(const QString &name)
+{
+    append(MessageTemplateAttrPtr::create(name));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::addAppInfo()
+{
+    append(AppInfoAttrsPtr::create());
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::addAppUuid(const QString &name)
+{
+    append(AppUuidAttrPtr::create(name));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::addSysInfo()
+{
+    append(SysInfoAttrsPtr::create());
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::addBacktrace(QtMsgType minLevel, int depth)
+{
+    append(BacktraceAttrPtr::create(minLevel, depth));
+    return *this;
+}
+
+#ifdef QTLOGGER_NETWORK
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::addHostInfo()
+{
+    append(HostInfoAttrsPtr::create());
+    return *this;
+}
+#endif
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::attrHandler(std::function<QVariantHash(const LogMessage &lmsg)> func)
+{
+    append(FunctionAttrHandlerPtr::create(func));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::filter(std::function<bool(const LogMessage &)> func)
+{
+    append(FunctionFilterPtr::create(func));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::filter(const QString &regexp)
+{
+    append(RegExpFilterPtr::create(regexp));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::filterLevel(QtMsgType minLevel)
+{
+    append(LevelFilterPtr::create(minLevel));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::filterCategory(const QString &rules)
+{
+    append(CategoryFilterPtr::create(rules));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::filterDuplicate()
+{
+    append(DuplicateFilterPtr::create());
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::format(std::function<QString(const LogMessage &)> func)
+{
+    append(FunctionFormatterPtr::create(func));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::format(const QString &pattern)
+{
+    if (pattern == "default")
+        append(PatternFormatterPtr::create(DefaultMessagePattern));
+    else if (pattern == "qt")
+        append(QtLogMessageFormatter::instance());
+    else if (pattern == "pretty")
+        append(PrettyFormatterPtr::create());
+    else
+        append(PatternFormatterPtr::create(pattern));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::formatByQt()
+{
+    append(QtLogMessageFormatter::instance());
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::formatByQtPattern(const QString &pattern)
+{
+    append(QtMessagePatternFormatterPtr::create(pattern));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::formatPretty(bool colorize, int maxCategoryWidth)
+{
+    append(PrettyFormatterPtr::create(colorize, maxCategoryWidth));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::formatToJson(bool compact)
+{
+    append(JsonFormatterPtr::create(compact));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::formatToLogfmt(bool withCallsite)
+{
+    append(LogfmtFormatterPtr::create(withCallsite));
+    return *this;
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::formatToCbor()
+{
+    append(CborFormatter::instance());
+    return *this;
+}
+#endif
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::formatToSentry(const QString &sdkName, const QString &sdkVersion)
+{
+    append(SentryFormatterPtr::create(sdkName, sdkVersion));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToStdOut(bool colorize)
+{
+    append(StdOutSinkPtr::create(colorize ? ColorMode::Auto : ColorMode::Never));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToStdErr(bool colorize)
+{
+    append(StdErrSinkPtr::create(colorize ? ColorMode::Auto : ColorMode::Never));
+    return *this;
+}
+
+#ifdef QTLOGGER_SYSLOG
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToSyslog()
+{
+    append(SyslogSinkPtr::create(QCoreApplication::applicationName()));
+    return *this;
+}
+#endif
+
+#ifdef QTLOGGER_SDJOURNAL
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToSdJournal()
+{
+    append(SdJournalSinkPtr::create());
+    return *this;
+}
+#endif
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToPlatformStdLog()
+{
+    append(PlatformStdSinkPtr::create());
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToFile(const QString &fileName, int maxFileSize,
+                                           int maxFileCount, RotatingFileSink::Options options)
+{
+    if (fileName.isEmpty())
+        return *this;
+
+    if (maxFileSize > 0
+        || options.testFlag(RotatingFileSink::RotationOnStartup)
+        || options.testFlag(RotatingFileSink::RotationDaily)
+        || options.testFlag(RotatingFileSink::TimeIndex)
+        || options.testFlag(RotatingFileSink::TermIndex)) {
+        append(RotatingFileSinkPtr::create(fileName, maxFileSize, maxFileCount, options));
+    }
+    else {
+        append(FileSinkPtr::create(fileName));
+    }
+
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToBinaryFile(const QString &fileName, int maxFileSize,
+                                                 int maxFileCount,
+                                                 RotatingFileSink::Options options)
+{
+    if (fileName.isEmpty())
+        return *this;
+
+    auto sink = BinaryFileSinkPtr::create(fileName, maxFileSize, maxFileCount, options);
+
+    // Store only template ids and parameters if this or a parent pipeline mines message templates
+    for (auto pipeline = this; pipeline && !sink->messageTemplates(); pipeline = pipeline->m_parent) {
+        for (const auto &handler : pipeline->handlers()) {
+            if (auto templates = handler.dynamicCast<MessageTemplateAttr>()) {
+                sink->setMessageTemplates(templates);
+                break;
+            }
+        }
+    }
+
+    append(sink);
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToRecording(const QString &fileName, quint64 maxCount)
+{
+    if (fileName.isEmpty())
+        return *this;
+
+    append(RecordingSinkPtr::create(fileName, maxCount));
+    return *this;
+}
+
+#ifndef QT_NO_SHAREDMEMORY
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToSharedMemory(const QString &key, int slotCount,
+                                                   int slotSize)
+{
+    if (key.isEmpty())
+        return *this;
+
+    append(SharedMemorySinkPtr::create(key, slotCount, slotSize));
+    return *this;
+}
+#endif
+
+#ifdef QTLOGGER_SQL
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToSqlite(const QString &fileName, qint64 maxRowCount,
+                                             int maxAge)
+{
+    if (fileName.isEmpty())
+        return *this;
+
+    auto sink = SqliteSinkPtr::create(fileName);
+    sink->setMaxRowCount(maxRowCount);
+    sink->setMaxAge(maxAge);
+    append(sink);
+    return *this;
+}
+#endif
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToIODevice(const QIODevicePtr &device)
+{
+    append(IODeviceSinkPtr::create(device));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToSegmentedLog(const QString &path, qint64 segmentSize,
+                                                   qint64 maxSize)
+{
+    if (path.isEmpty())
+        return *this;
+
+    append(SegmentedLogSinkPtr::create(path, segmentSize, maxSize));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToSignal(QObject *receiver, const char *method)
+{
+    auto sink = SignalSinkPtr::create();
+    QObject::connect(sink.data(), SIGNAL(message(QtLogger::LogMessage)), receiver, method);
+    append(sink.staticCast<Sink>());
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToBatchSignal(QObject *receiver, const char *method,
+                                                  int interval, int maxBatchSize)
+{
+    auto sink = BatchSignalSinkPtr::create(interval, maxBatchSize);
+    QObject::connect(sink.data(), SIGNAL(messages(QVector<QtLogger::LogMessage>)), receiver,
+                     method);
+    append(sink.staticCast<Sink>());
+    return *this;
+}
+
+#ifdef QTLOGGER_NETWORK
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToHttp(const QString &url)
+{
+    append(HttpSinkPtr::create(QUrl(url)));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToHttp(const QString &url,
+                                           const QList<QPair<QByteArray, QByteArray>> &headers)
+{
+    append(HttpSinkPtr::create(QUrl(url), headers));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToGelf(const QString &host, quint16 port,
+                                           GelfSink::Transport transport,
+                                           GelfSink::Compression compression)
+{
+    if (host.isEmpty())
+        return *this;
+
+    auto sink = GelfSinkPtr::create(host, port, transport);
+    sink->setCompression(compression);
+    append(sink);
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToLocalSocket(const QString &serverName)
+{
+    if (serverName.isEmpty())
+        return *this;
+
+    append(LocalSocketSinkPtr::create(serverName));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToTcp(const QString &host, quint16 port,
+                                          IODeviceSink::Framing framing)
+{
+    if (host.isEmpty())
+        return *this;
+
+    append(TcpSinkPtr::create(host, port, framing));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToOtlp(const QString &endpoint)
+{
+    append(OtlpSinkPtr::create(QUrl(endpoint)));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToOtlp(const QString &endpoint,
+                                           const QList<QPair<QByteArray, QByteArray>> &headers)
+{
+    append(OtlpSinkPtr::create(QUrl(endpoint), headers));
+    return *this;
+}
+#endif
+
+#ifdef Q_OS_WIN
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToWinDebug()
+{
+    append(WinDebugSinkPtr::create());
+    return *this;
+}
+#endif
+
+#ifdef QTLOGGER_ANDROIDLOG
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToAndroidLog()
+{
+    append(AndroidLogSinkPtr::create());
+    return *this;
+}
+#endif
+
+#ifdef QTLOGGER_OSLOG
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToOsLog()
+{
+    append(OslogSinkPtr::create());
+    return *this;
+}
+#endif
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::pipeline()
+{
+    auto pipeline = SimplePipelinePtr::create(/* scoped */ true, /* parent */ this);
+    append(pipeline);
+    return *pipeline.data();
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::end()
+{
+    if (m_parent)
+        return *m_parent;
+    else
+        return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::handler(std::function<bool(LogMessage &)> func)
+{
+    append(FunctionHandlerPtr::create(std::move(func)));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+void SimplePipeline::recursiveFlush(const Pipeline *pipeline)
+{
+    for (const auto &handler : pipeline->handlers()) {
+        if (auto sink = handler.dynamicCast<Sink>()) {
+            sink->flush();
+            continue;
+        }
+        if (auto pipeline = handler.dynamicCast<Pipeline>()) {
+            recursiveFlush(pipeline.data());
+        }
+    }
+}
+
+QTLOGGER_DECL_SPEC
+void SimplePipeline::flush()
+{
+    recursiveFlush(this);
+}
+
+} // namespace QtLogger
+
+// androidlogsink.cpp
+
+#ifdef QTLOGGER_ANDROIDLOG
+
+#include <android/log.h>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+void AndroidLogSink::send(const LogMessage &lmsg)
+{
+    auto priority = ANDROID_LOG_DEBUG;
+
+    switch (lmsg.type()) {
+    case QtDebugMsg:
+        priority = ANDROID_LOG_DEBUG;
+        break;
+    case QtInfoMsg:
+        priority = ANDROID_LOG_INFO;
+        break;
+    case QtWarningMsg:
+        priority = ANDROID_LOG_WARN;
+        break;
+    case QtCriticalMsg:
+        priority = ANDROID_LOG_ERROR;
+        break;
+    case QtFatalMsg:
+        priority = ANDROID_LOG_FATAL;
+        break;
+    };
+
+    __android_log_print(priority, lmsg.category(), "%s", qPrintable(lmsg.message()));
+
+    // TODO: use __android_log_write_log_message for API level 30 and above
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_ANDROIDLOG
+
+// batchsignalsink.cpp
+
+#include <QTimer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#    include <QThread>
+#endif
+
+#include <deque>
+
+namespace QtLogger {
+
+class BatchSignalSink::BatchSignalSinkPrivate
+{
+public:
+    BatchSignalSinkPrivate(int interval, int maxBatchSize)
+        : interval(qMax(interval, 0)), maxBatchSize(qMax(maxBatchSize, 1))
+    {
+    }
+
+    int interval;
+    int maxBatchSize;
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    std::deque<LogMessage> pending;
+    int maxPendingCount = 0;
+    quint64 droppedCount = 0;
+    bool timerScheduled = false;
+    bool flushRequested = false;
+
+    QTimer *timer = nullptr;
+};
+
+QTLOGGER_DECL_SPEC
+BatchSignalSink::BatchSignalSink(int interval, int maxBatchSize, QObject *parent)
+    : QObject(parent), d(new BatchSignalSinkPrivate(interval, maxBatchSize))
+{
+    static auto __once =
+            qRegisterMetaType<QVector<QtLogger::LogMessage>>("QVector<QtLogger::LogMessage>");
+    Q_UNUSED(__once)
+
+    d->timer = new QTimer(this);
+    d->timer->setSingleShot(true);
+    QObject::connect(d->timer, &QTimer::timeout, this, &BatchSignalSink::flush);
+}
+
+QTLOGGER_DECL_SPEC
+BatchSignalSink::~BatchSignalSink() = default;
+
+QTLOGGER_DECL_SPEC
+void BatchSignalSink::send(const LogMessage &lmsg)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+
+    if (d->maxPendingCount > 0 && d->pending.size() >= static_cast<size_t>(d->maxPendingCount)) {
+        d->pending.pop_front();
+        ++d->droppedCount;
+    }
+
+    d->pending.push_back(lmsg);
+
+    // A full batch is emitted on the next event loop iteration, not from the caller of send()
+    if (d->pending.size() >= static_cast<size_t>(d->maxBatchSize)) {
+        if (!d->flushRequested) {
+            d->flushRequested = true;
+            QMetaObject::invokeMethod(this, "startFlushTimer", Qt::QueuedConnection);
+        }
+    } else if (!d->timerScheduled) {
+        d->timerScheduled = true;
+        QMetaObject::invokeMethod(this, "startFlushTimer", Qt::QueuedConnection);
+    }
+}
+
+QTLOGGER_DECL_SPEC
+bool BatchSignalSink::flush()
+{
+    std::deque<LogMessage> pending;
+
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&d->mutex);
+
+        if (QThread::currentThread() != thread()) {
+            if (!d->flushRequested && !d->pending.empty()) {
+                d->flushRequested = true;
+                QMetaObject::invokeMethod(this, "startFlushTimer", Qt::QueuedConnection);
+            }
+            return true;
+        }
+#endif
+
+        pending.swap(d->pending);
+        d->timerScheduled = false;
+        d->flushRequested = false;
+    }
+
+    d->timer->stop();
+
+    while (!pending.empty()) {
+        const auto size = qMin(pending.size(), static_cast<size_t>(d->maxBatchSize));
+
+        QVector<LogMessage> batch;
+        batch.reserve(static_cast<int>(size));
+        for (size_t i = 0; i < size; ++i) {
+            batch.append(pending.front());
+            pending.pop_front();
+        }
+
+        Q_EMIT messages(batch);
+    }
+
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+int BatchSignalSink::interval() const
+{
+    return d->interval;
+}
+
+QTLOGGER_DECL_SPEC
+int BatchSignalSink::maxBatchSize() const
+{
+    return d->maxBatchSize;
+}
+
+QTLOGGER_DECL_SPEC
+int BatchSignalSink::maxPendingCount() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxPendingCount;
+}
+
+QTLOGGER_DECL_SPEC
+void BatchSignalSink::setMaxPendingCount(int count)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxPendingCount = qMax(count, 0);
+}
+
+QTLOGGER_DECL_SPEC
+quint64 BatchSignalSink::droppedCount() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->droppedCount;
+}
+
+QTLOGGER_DECL_SPEC
+void BatchSignalSink::startFlushTimer()
+{
+    bool flushRequested;
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&d->mutex);
+#endif
+        flushRequested = d->flushRequested;
+    }
+
+    if (flushRequested || d->interval == 0) {
+        flush();
+        return;
+    }
+
+    if (!d->timer->isActive())
+        d->timer->start(d->interval);
+}
+
+} // namespace QtLogger
+
+// binaryfilesink.cpp
+
+#include <QFile>
+
+namespace QtLogger {
+
+class BinaryFileSink::BinaryFileSinkPrivate
+{
+public:
+    BinaryLogWriter writer;
+};
+
+QTLOGGER_DECL_SPEC
+BinaryFileSink::BinaryFileSink(const QString &path, int maxFileSize, int maxFileCount,
+                               Options options)
+    : RotatingFileSink(path, maxFileSize, maxFileCount, options,
+                       QIODevice::WriteOnly | QIODevice::Append)
+    , d(new BinaryFileSinkPrivate)
+{
+}
+
+QTLOGGER_DECL_SPEC
+BinaryFileSink::~BinaryFileSink() = default;
+
+QTLOGGER_DECL_SPEC
+void BinaryFileSink::setMessageTemplates(const MessageTemplateAttrPtr &messageTemplates)
+{
+    d->writer.setMessageTemplates(messageTemplates);
+}
+
+QTLOGGER_DECL_SPEC
+MessageTemplateAttrPtr BinaryFileSink::messageTemplates() const
+{
+    return d->writer.messageTemplates();
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray BinaryFileSink::encode(const LogMessage &lmsg)
+{
+    // Every file starts with its own header and dictionaries
+    if (file()->size() == 0)
+        d->writer.reset();
+
+    return d->writer.encode(lmsg);
+}
+
+QTLOGGER_DECL_SPEC
+bool BinaryFileSink::writesBinaryLog() const
+{
+    return true;
+}
+
+} // namespace QtLogger
+
+// coloredconsole.cpp
+
+#ifdef Q_OS_WIN
+#    include <io.h>
+#    include <stdio.h>
+#    ifndef STDOUT_FILENO
+#        define STDOUT_FILENO _fileno(stdout)
+#    endif
+#    ifndef STDERR_FILENO
+#        define STDERR_FILENO _fileno(stderr)
+#    endif
+#    define isatty _isatty
+#else
+#    include <unistd.h>
+#endif
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+ColoredConsole::ColoredConsole(ColorMode colorMode) : m_colorMode(colorMode) { }
+
+QTLOGGER_DECL_SPEC
+ColoredConsole::~ColoredConsole() = default;
+
+QTLOGGER_DECL_SPEC
+void ColoredConsole::setColorMode(ColorMode mode)
+{
+    m_colorMode = mode;
+    updateColorsEnabled();
+}
+
+QTLOGGER_DECL_SPEC
+ColorMode ColoredConsole::colorMode() const
+{
+    return m_colorMode;
+}
+
+QTLOGGER_DECL_SPEC
+bool ColoredConsole::colorsEnabled() const
+{
+    return m_colorsEnabled;
+}
+
+QTLOGGER_DECL_SPEC
+QString ColoredConsole::colorPrefix(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return QStringLiteral("\033[90m"); // Gray
+    case QtInfoMsg:
+        return QStringLiteral("\033[32m"); // Green
+    case QtWarningMsg:
+        return QStringLiteral("\033[33m"); // Yellow
+    case QtCriticalMsg:
+        return QStringLiteral("\033[31m"); // Red
+    case QtFatalMsg:
+        return QStringLiteral("\033[1;91m"); // Bold bright red
+    default:
+        return QString();
+    }
+}
+
+QTLOGGER_DECL_SPEC
+QString ColoredConsole::colorReset()
+{
+    return QStringLiteral("\033[0m");
+}
+
+QTLOGGER_DECL_SPEC
+QString ColoredConsole::colorize(const QString &message, QtMsgType type)
+{
+    const QString prefix = colorPrefix(type);
+    if (prefix.isEmpty()) {
+        return message;
+    }
+    return prefix + message + colorReset();
+}
+
+QTLOGGER_DECL_SPEC
+bool ColoredConsole::isStdOutTty()
+{
+    static const bool isTty = isatty(STDOUT_FILENO) != 0;
+    return isTty;
+}
+
+QTLOGGER_DECL_SPEC
+bool ColoredConsole::isStdErrTty()
+{
+    static const bool isTty = isatty(STDERR_FILENO) != 0;
+    return isTty;
+}
+
+QTLOGGER_DECL_SPEC
+void ColoredConsole::updateColorsEnabled()
+{
+    switch (m_colorMode) {
+    case ColorMode::Always:
+        m_colorsEnabled = true;
+        break;
+    case ColorMode::Never:
+        m_colorsEnabled = false;
+        break;
+    case ColorMode::Auto:
+    default:
+        m_colorsEnabled = isTty();
+        break;
+    }
+}
+
+} // namespace QtLogger
+
+// filesink.cpp
+
+#include <QDateTime>
+#include <QFile>
+#include <QRegularExpression>
+#include <QSharedPointer>
+
+#include <iostream>
+
+namespace QtLogger {
+
+namespace {
+
+/**
+ * @brief Replaces the time pattern in the given string with the current date and time.
+ *
+ * This function searches for a time pattern in the format `%{time <format>}` within the input
+ * string. If found, it replaces the pattern with the current date and time formatted according to
+ * the specified format. If no format is specified, it defaults to "yyyyMMdd_hhmmss".
+ *
+ * @param path The input string potentially containing the time pattern.
+ * @return A new string with the time pattern replaced by the current date and time.
+ */
+
+QTLOGGER_DECL_SPEC
+QString replaceTimePattern(const QString &path)
+{
+    static auto re = QRegularExpression(QStringLiteral("(.*)%{time *(.*?)}(.*)"));
+    auto match = re.match(path);
+
+    if (!match.hasMatch())
+        return path;
+
+    auto format = match.captured(2);
+
+    if (format.isEmpty()) {
+        format = QStringLiteral("yyyyMMdd_hhmmss");
+    }
+
+    return match.captured(1) + QDateTime::currentDateTime().toString(format) + match.captured(3);
+}
+
+QTLOGGER_DECL_SPEC
+QSharedPointer<QFile> createFilePtr(const QString &path)
+{
+    return QSharedPointer<QFile>::create(replaceTimePattern(path));
+}
+
+}
+
+QTLOGGER_DECL_SPEC
+FileSink::FileSink(const QString &path)
+    : FileSink(path, QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)
+{
+}
+
+QTLOGGER_DECL_SPEC
+FileSink::FileSink(const QString &path, QIODevice::OpenMode openMode)
+    : IODeviceSink(createFilePtr(path))
+{
+    // Terminal colors are of no use in a file
+    setPlainText(true);
+
+    if (!file()->open(openMode)) {
+        std::cerr << "FileSink: Can't open log file: " << path.toStdString()
+                  << " error: " << file()->errorString().toStdString() << std::endl;
+    }
+}
+
+QTLOGGER_DECL_SPEC
+FileSink::~FileSink()
+{
+    file()->close();
+}
+
+QTLOGGER_DECL_SPEC
+bool FileSink::flush()
+{
+    return file()->flush();
+}
+
+QTLOGGER_DECL_SPEC
+QFile *FileSink::file() const
+{
+    return qobject_cast<QFile *>(device().data());
+}
+
+} // namespace QtLogger
+
+// gelfsink.cpp
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSysInfo>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+#include <QUdpSocket>
+#include <QtEndian>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int GelfChunkHeaderSize = 12;
+constexpr int GelfMaxChunks = 128;
+constexpr int GelfTcpBatchSize = 64 * 1024;
+constexpr qint64 GelfMaxExactInteger = Q_INT64_C(1) << 53;
+
+int gelfLevel(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return 7;
+    case QtInfoMsg:
+        return 6;
+    case QtWarningMsg:
+        return 4;
+    case QtCriticalMsg:
+        return 3;
+    case QtFatalMsg:
+        return 2;
+    }
+    return 7;
+}
+
+// Additional field names must match ^[\w\.\-]*$, "_id" is reserved
+QString gelfFieldName(const QString &name)
+{
+    QString result = QStringLiteral("_");
+    result.reserve(name.size() + 2);
+
+    for (const auto ch : name) {
+        if (ch.isLetterOrNumber() || ch == QLatin1Char('_') || ch == QLatin1Char('.')
+            || ch == QLatin1Char('-'))
+            result.append(ch);
+        else
+            result.append(QLatin1Char('_'));
+    }
+
+    if (result == QLatin1String("_id"))
+        result.append(QLatin1Char('_'));
+
+    return result;
+}
+
+QJsonValue gelfValue(const QVariant &value)
+{
+    switch (value.userType()) {
+    // Integers beyond 2^53 don't fit a JSON number exactly, they are sent as strings
+    case QMetaType::Long:
+    case QMetaType::LongLong: {
+        const auto number = value.toLongLong();
+        if (number >= -GelfMaxExactInteger && number <= GelfMaxExactInteger)
+            return static_cast<double>(number);
+        return QString::number(number);
+    }
+    case QMetaType::ULong:
+    case QMetaType::ULongLong: {
+        const auto number = value.toULongLong();
+        if (number <= static_cast<quint64>(GelfMaxExactInteger))
+            return static_cast<double>(number);
+        return QString::number(number);
+    }
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return value.toDouble();
+    default:
+        return value.toString();
+    }
+}
+
+QByteArray gelfCompress(const QByteArray &data, GelfSink::Compression compression)
+{
+    switch (compression) {
+    case GelfSink::Compression::None:
+        return data;
+    case GelfSink::Compression::Zlib:
+        // qCompress() prepends the uncompressed size to a zlib stream
+        return qCompress(data).mid(4);
+    case GelfSink::Compression::Gzip:
+        return SeekableGzip::member(data, -1);
+    }
+    return data;
+}
+
+} // namespace
+
+class GelfSink::GelfSinkPrivate
+{
+public:
+    GelfSinkPrivate(const QString &host, quint16 port, Transport transport)
+        : host(host),
+          port(port),
+          transport(transport),
+          hostName(QSysInfo::machineHostName()),
+          messageIdBase(static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) << 16
+                        ^ static_cast<quint64>(QCoreApplication::applicationPid()) << 48)
+    {
+    }
+
+    ~GelfSinkPrivate()
+    {
+        thread.run([this] { resetSocket(); });
+        thread.stop();
+    }
+
+    void send(const QByteArray &gelf)
+    {
+        thread.post([this, gelf] { write(gelf); });
+    }
+
+    void flush()
+    {
+        thread.run([this] {
+            if (!socket)
+                return;
+
+            writePending();
+            writeBatch();
+            socket->flush();
+        });
+    }
+
+    // GELF chunks of a message, or nothing if it needs more than 128 chunks
+    QList<QByteArray> datagrams(const QByteArray &data, int chunkSize)
+    {
+        const auto size = static_cast<int>(data.size());
+        if (size <= chunkSize)
+            return { data };
+
+        const auto payloadSize = chunkSize - GelfChunkHeaderSize;
+        const auto count = (size + payloadSize - 1) / payloadSize;
+        if (count > GelfMaxChunks)
+            return {};
+
+        const auto messageId = qToBigEndian(messageIdBase + messageCounter++);
+
+        QList<QByteArray> result;
+        result.reserve(count);
+
+        for (int i = 0; i < count; ++i) {
+            QByteArray chunk;
+            chunk.reserve(chunkSize);
+            chunk.append('\x1e').append('\x0f');
+            chunk.append(reinterpret_cast<const char *>(&messageId), sizeof(messageId));
+            chunk.append(static_cast<char>(i));
+            chunk.append(static_cast<char>(count));
+            chunk.append(data.constData() + i * payloadSize,
+                         qMin(payloadSize, size - i * payloadSize));
+            result.append(chunk);
+        }
+
+        return result;
+    }
+
+    QString host;
+    quint16 port;
+    Transport transport;
+
+    // Set by any thread, guarded by the mutex
+    Compression compression = Compression::None;
+    int chunkSize = DefaultChunkSize;
+    int maxBufferSize = DefaultMaxBufferSize;
+    QString hostName;
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+
+    SinkThread thread { QStringLiteral("GelfSink") };
+
+private:
+    // Runs in the thread of the sink
+    void write(const QByteArray &gelf)
+    {
+        auto compression = Compression::None;
+        auto chunkSize = DefaultChunkSize;
+        auto maxBufferSize = DefaultMaxBufferSize;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            compression = this->compression;
+            chunkSize = this->chunkSize;
+            maxBufferSize = this->maxBufferSize;
+        }
+
+        ensureSocket();
+
+        if (transport == Transport::Udp) {
+            const auto data = gelfCompress(gelf, compression);
+            for (const auto &datagram : datagrams(data, chunkSize)) {
+                if (socket->state() == QAbstractSocket::ConnectedState)
+                    socket->write(datagram);
+                else
+                    enqueue(datagram, maxBufferSize);
+            }
+            return;
+        }
+
+        auto frame = gelf;
+        frame.append('\0');
+
+        if (socket->state() != QAbstractSocket::ConnectedState) {
+            enqueue(frame, maxBufferSize);
+            return;
+        }
+
+        // A slow server keeps the rest in the bounded buffer instead of the socket buffer
+        if (!pending.isEmpty() || socket->bytesToWrite() + batch.size() >= GelfTcpBatchSize) {
+            enqueue(frame, maxBufferSize);
+            writePending();
+            return;
+        }
+
+        batch.append(frame);
+        scheduleBatch();
+    }
+
+    void ensureSocket()
+    {
+        if (!socket) {
+            if (transport == Transport::Udp)
+                socket = new QUdpSocket(thread.context());
+            else
+                socket = new QTcpSocket(thread.context());
+
+            QObject::connect(socket.data(), &QAbstractSocket::connected, socket.data(),
+                             [this] { writePending(); });
+
+            // The next batch of the buffer is written when the socket has sent the last one
+            if (transport == Transport::Tcp) {
+                QObject::connect(socket.data(), &QIODevice::bytesWritten, socket.data(),
+                                 [this] { writePending(); });
+            }
+        }
+
+        // Also reconnects a TCP socket closed by the server
+        if (socket->state() == QAbstractSocket::UnconnectedState)
+            socket->connectToHost(host, port);
+    }
+
+    void resetSocket()
+    {
+        if (!socket)
+            return;
+
+        socket->disconnect();
+
+        if (socket->thread() == QThread::currentThread()) {
+            writePending();
+            writeBatch();
+            while (socket->state() == QAbstractSocket::ConnectedState
+                   && socket->bytesToWrite() > 0 && socket->waitForBytesWritten(100)) {
+                writePending();
+            }
+            delete socket.data();
+        } else {
+            socket->deleteLater();
+        }
+
+        socket = nullptr;
+        batchScheduled = false;
+    }
+
+    void enqueue(const QByteArray &data, int maxBufferSize)
+    {
+        pending.append(data);
+        pendingSize += data.size();
+
+        while (pendingSize > maxBufferSize && !pending.isEmpty()) {
+            pendingSize -= pending.takeFirst().size();
+        }
+    }
+
+    void writePending()
+    {
+        if (!socket || socket->state() != QAbstractSocket::ConnectedState)
+            return;
+
+        if (transport == Transport::Udp) {
+            for (const auto &item : std::as_const(pending)) {
+                socket->write(item);
+            }
+            pending.clear();
+            pendingSize = 0;
+            return;
+        }
+
+        while (!pending.isEmpty()
+               && socket->bytesToWrite() + batch.size() < GelfTcpBatchSize) {
+            pendingSize -= pending.first().size();
+            batch.append(pending.takeFirst());
+        }
+
+        writeBatch();
+    }
+
+    void scheduleBatch()
+    {
+        if (batch.size() >= GelfTcpBatchSize) {
+            writeBatch();
+            return;
+        }
+
+        if (batchScheduled)
+            return;
+
+        batchScheduled = true;
+        QTimer::singleShot(0, socket.data(), [this] { writeBatch(); });
+    }
+
+    void writeBatch()
+    {
+        batchScheduled = false;
+
+        if (batch.isEmpty() || !socket)
+            return;
+
+        socket->write(batch);
+        batch.clear();
+    }
+
+    QPointer<QAbstractSocket> socket;
+
+    QList<QByteArray> pending;
+    qint64 pendingSize = 0;
+
+    QByteArray batch;
+    bool batchScheduled = false;
+
+    const quint64 messageIdBase;
+    quint64 messageCounter = 0;
+};
+
+QTLOGGER_DECL_SPEC
+GelfSink::GelfSink(const QString &host, quint16 port, Transport transport)
+    : d(new GelfSinkPrivate(host, port, transport))
+{
+}
+
+QTLOGGER_DECL_SPEC
+GelfSink::~GelfSink() = default;
+
+QTLOGGER_DECL_SPEC
+void GelfSink::send(const LogMessage &lmsg)
+{
+    d->send(toGelf(lmsg, hostName()));
+}
+
+QTLOGGER_DECL_SPEC
+bool GelfSink::flush()
+{
+    d->flush();
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+GelfSink::Transport GelfSink::transport() const
+{
+    return d->transport;
+}
+
+QTLOGGER_DECL_SPEC
+GelfSink::Compression GelfSink::compression() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->compression;
+}
+
+QTLOGGER_DECL_SPEC
+void GelfSink::setCompression(Compression compression)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->compression = compression;
+}
+
+QTLOGGER_DECL_SPEC
+int GelfSink::chunkSize() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->chunkSize;
+}
+
+QTLOGGER_DECL_SPEC
+void GelfSink::setChunkSize(int chunkSize)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->chunkSize = qMax(chunkSize, GelfChunkHeaderSize + 1);
+}
+
+QTLOGGER_DECL_SPEC
+int GelfSink::maxBufferSize() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxBufferSize;
+}
+
+QTLOGGER_DECL_SPEC
+void GelfSink::setMaxBufferSize(int maxBufferSize)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxBufferSize = maxBufferSize;
+}
+
+QTLOGGER_DECL_SPEC
+QString GelfSink::hostName() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->hostName;
+}
+
+QTLOGGER_DECL_SPEC
+void GelfSink::setHostName(const QString &hostName)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->hostName = hostName;
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray GelfSink::toGelf(const LogMessage &lmsg, const QString &hostName)
+{
+    QJsonObject obj;
+
+    obj.insert(QStringLiteral("version"), QStringLiteral("1.1"));
+    obj.insert(QStringLiteral("host"), hostName);
+
+    // short_message must not be empty
+    const auto message = lmsg.message();
+    obj.insert(QStringLiteral("short_message"),
+               message.isEmpty() ? QStringLiteral("-") : message);
+
+    if (lmsg.isFormatted() && lmsg.formattedMessage() != message)
+        obj.insert(QStringLiteral("full_message"), lmsg.formattedMessage());
+
+    obj.insert(QStringLiteral("timestamp"),
+               static_cast<double>(lmsg.time().toMSecsSinceEpoch()) / 1000.0);
+    obj.insert(QStringLiteral("level"), gelfLevel(lmsg.type()));
+
+    if (lmsg.category() && *lmsg.category())
+        obj.insert(QStringLiteral("_category"), QString::fromUtf8(lmsg.category()));
+    if (lmsg.file()) {
+        obj.insert(QStringLiteral("_file"), QString::fromUtf8(lmsg.file()));
+        obj.insert(QStringLiteral("_line"), lmsg.line());
+    }
+    if (lmsg.function())
+        obj.insert(QStringLiteral("_function"), QString::fromUtf8(lmsg.function()));
+#ifndef QTLOGGER_NO_THREAD
+    obj.insert(QStringLiteral("_thread_id"), QString::number(lmsg.threadId()));
+#endif
+
+    const auto attrs = lmsg.attributes();
+    for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
+        obj.insert(gelfFieldName(it.key()), gelfValue(it.value()));
+    }
+
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
+
+// httpsink.cpp
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+HttpSink::HttpSink(const QUrl &url) : m_url(url)
+{
+    init();
+}
+
+QTLOGGER_DECL_SPEC
+HttpSink::HttpSink(const QUrl &url, const Headers &headers) : m_url(url), m_headers(headers)
+{
+    init();
+}
+
+QTLOGGER_DECL_SPEC
+void HttpSink::init()
+{
+    m_manager = new QNetworkAccessManager();
+
+#ifndef QTLOGGER_NO_THREAD
+    if (m_manager->thread() != Logger::instance()->ownThread()) {
+        m_manager->moveToThread(Logger::instance()->ownThread());
+    }
+#endif
+
+    m_request.setUrl(m_url);
+    for (const auto &header : m_headers) {
+        m_request.setRawHeader(header.first, header.second);
+    }
+}
+
+QTLOGGER_DECL_SPEC
+HttpSink::~HttpSink()
+{
+    if (!m_manager.isNull()) {
+        delete m_manager.data();
+    }
+}
+
+QTLOGGER_DECL_SPEC
+void HttpSink::send(const LogMessage &lmsg)
+{
+    if (!Logger::instance()->ownThreadIsRunning()) {
+        if (!m_manager.isNull() && !m_manager->property("activeReply").isValid())
+            m_manager->deleteLater();
+        m_manager = new QNetworkAccessManager();
+    }
+
+    if (!m_request.hasRawHeader("Content-Type")) {
+        m_request.setHeader(QNetworkRequest::ContentTypeHeader,
+                            QStringLiteral("text/plain; charset=utf-8"));
+    }
+
+    auto reply = m_manager->post(m_request, lmsg.formattedMessage().toUtf8());
+
+    QObject::connect(reply, &QNetworkReply::finished, reply, &QObject::deleteLater);
+
+    if (!Logger::instance()->ownThreadIsRunning()) {
+        m_manager->setProperty("activeReply", QVariant::fromValue(reply));
+        QObject::connect(reply, &QNetworkReply::finished, m_manager, &QObject::deleteLater);
+    }
+}
+
+QTLOGGER_DECL_SPEC
+void HttpSink::setNetworkAccessManager(QNetworkAccessManager *manager)
+{
+    if (!m_manager.isNull()) {
+        delete m_manager.data();
+    }
+    m_manager = manager;
+}
+
+QTLOGGER_DECL_SPEC
+void HttpSink::setRequest(const QNetworkRequest &request)
+{
+    m_request = request;
+}
+
+QTLOGGER_DECL_SPEC
+void HttpSink::setHeaders(const Headers &headers)
+{
+    m_headers = headers;
+    for (const auto &header : m_headers) {
+        m_request.setRawHeader(header.first, header.second);
+    }
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
+
+// iodevicesink.cpp
+
+#include <QtEndian>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+IODeviceSink::IODeviceSink(const QIODevicePtr &device) : m_device(device) { }
+
+QTLOGGER_DECL_SPEC
+void IODeviceSink::send(const LogMessage &lmsg)
+{
+    if (m_device.isNull() || !m_device->isOpen()) {
+        return;
+    }
+
+    updateTextMode(lmsg);
+    m_device->write(encode(lmsg));
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray IODeviceSink::encode(const LogMessage &lmsg)
+{
+    return frame(lmsg, m_framing, m_plainText);
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray IODeviceSink::frame(const LogMessage &lmsg, Framing framing, bool plainText,
+                               bool utf8Text)
+{
+    const auto text = [&lmsg, plainText] {
+        return plainText ? lmsg.plainFormattedMessage() : lmsg.formattedMessage();
+    };
+
+    if (framing == Framing::Newline) {
+        if (lmsg.hasFormattedData())
+            return lmsg.formattedData();
+        return (utf8Text ? text().toUtf8() : text().toLocal8Bit()).append('\n');
+    }
+
+    const auto payload = lmsg.hasFormattedData() ? lmsg.formattedData() : text().toUtf8();
+
+    QByteArray result;
+    result.reserve(payload.size() + 4);
+    const auto size = qToBigEndian(static_cast<quint32>(payload.size()));
+    result.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    result.append(payload);
+
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+IODeviceSink::Framing IODeviceSink::framing() const
+{
+    return m_framing;
+}
+
+QTLOGGER_DECL_SPEC
+void IODeviceSink::setFraming(Framing framing)
+{
+    m_framing = framing;
+    updateTextMode();
+}
+
+QTLOGGER_DECL_SPEC
+bool IODeviceSink::plainText() const
+{
+    return m_plainText;
+}
+
+QTLOGGER_DECL_SPEC
+void IODeviceSink::setPlainText(bool enabled)
+{
+    m_plainText = enabled;
+}
+
+QTLOGGER_DECL_SPEC
+const QIODevicePtr &IODeviceSink::device() const
+{
+    return m_device;
+}
+
+QTLOGGER_DECL_SPEC
+void IODeviceSink::setDevice(const QIODevicePtr &device)
+{
+    m_device = device;
+    m_textModeSuspended = false;
+    updateTextMode();
+}
+
+QTLOGGER_DECL_SPEC
+void IODeviceSink::updateTextMode(const LogMessage &lmsg)
+{
+    // Newline translation of the text mode would damage binary formatter output and frames. The
+    // device may have been reopened in text mode since, e.g. by a rotation.
+    if (lmsg.hasFormattedData() || m_framing == Framing::LengthPrefixed) {
+        if (m_device->isTextModeEnabled()) {
+            m_device->setTextModeEnabled(false);
+            m_textModeSuspended = true;
+        }
+    } else if (m_textModeSuspended) {
+        // Text written after binary output gets the newline translation of the device again
+        m_device->setTextModeEnabled(true);
+        m_textModeSuspended = false;
+    }
+}
+
+QTLOGGER_DECL_SPEC
+void IODeviceSink::updateTextMode()
+{
+    if (!m_device || !m_device->isOpen())
+        return;
+
+    if (m_framing == Framing::LengthPrefixed) {
+        if (m_device->isTextModeEnabled()) {
+            m_device->setTextModeEnabled(false);
+            m_textModeSuspended = true;
+        }
+    } else if (m_textModeSuspended) {
+        m_device->setTextModeEnabled(true);
+        m_textModeSuspended = false;
+    }
+}
+
+} // namespace QtLogger
+
+// localsocketsink.cpp
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLocalSocket>
+#include <QPointer>
+#include <QThread>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int LocalSocketBatchSize = 64 * 1024;
+constexpr int LocalSocketReconnectInterval = 1000; // ms
+
+} // namespace
+
+class LocalSocketSink::LocalSocketSinkPrivate
+{
+public:
+    explicit LocalSocketSinkPrivate(const QString &serverName) : serverName(serverName)
+    {
+        writer.setSessionAttributes({
+                { QStringLiteral("appname"), QCoreApplication::applicationName() },
+                { QStringLiteral("pid"), QCoreApplication::applicationPid() },
+        });
+    }
+
+    ~LocalSocketSinkPrivate()
+    {
+        thread.run([this] { resetSocket(); });
+        thread.stop();
+    }
+
+    // The queue is filled in the calling thread, so the oldest messages are dropped before send()
+    // returns
+    void send(const LogMessage &lmsg)
+    {
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            enqueue(lmsg);
+
+            // Messages sent until the thread of the sink gets to them are written as one batch
+            if (writeScheduled)
+                return;
+            writeScheduled = true;
+        }
+
+        thread.post([this] {
+            ensureSocket();
+            writePending();
+        });
+    }
+
+    void flush()
+    {
+        thread.run([this] {
+            ensureSocket();
+            if (socket->state() == QLocalSocket::ConnectingState)
+                socket->waitForConnected(100);
+
+            writePending();
+            socket->flush();
+        });
+    }
+
+    QString serverName;
+    int maxPendingCount = DefaultMaxPendingCount;
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    SinkThread thread { QStringLiteral("LocalSocketSink") };
+
+private:
+    // The socket and the writer are used only in the thread of the sink
+    void ensureSocket()
+    {
+        if (!socket) {
+            socket = new QLocalSocket(thread.context());
+
+            QObject::connect(socket.data(), &QLocalSocket::connected, socket.data(),
+                             [this] { writePending(); });
+
+            QObject::connect(socket.data(), &QIODevice::bytesWritten, socket.data(),
+                             [this](qint64 bytes) {
+                                 sent(bytes);
+                                 writePending();
+                             });
+
+            // A new connection is a new session, the collector has lost the dictionaries
+            QObject::connect(socket.data(), &QLocalSocket::disconnected, socket.data(), [this] {
+                writer.reset();
+                requeueUnsent();
+            });
+        }
+
+        // Without a collector every message would try to connect, so retries are rate limited
+        if (socket->state() == QLocalSocket::UnconnectedState
+            && (!lastConnect.isValid() || lastConnect.elapsed() >= LocalSocketReconnectInterval)) {
+            lastConnect.start();
+            writer.reset();
+            socket->connectToServer(serverName);
+        }
+    }
+
+    void resetSocket()
+    {
+        if (!socket)
+            return;
+
+        socket->disconnect();
+
+        if (socket->thread() == QThread::currentThread()) {
+            writePending();
+            while (socket->state() == QLocalSocket::ConnectedState && socket->bytesToWrite() > 0
+                   && socket->waitForBytesWritten(100)) {
+                writePending();
+            }
+            delete socket.data();
+        } else {
+            socket->deleteLater();
+        }
+
+        socket = nullptr;
+        unsent.clear();
+        lastConnect.invalidate();
+    }
+
+    // Called with the mutex locked
+    void enqueue(const LogMessage &lmsg)
+    {
+        pending.append(lmsg);
+
+        while (pending.size() > maxPendingCount && !pending.isEmpty()) {
+            pending.removeFirst();
+        }
+    }
+
+    void writePending()
+    {
+        QList<LogMessage> items;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            writeScheduled = false;
+
+            if (!socket || socket->state() != QLocalSocket::ConnectedState)
+                return;
+
+            // A slow collector keeps the rest in the bounded queue instead of the socket buffer,
+            // the next batch is written when the socket has sent this one
+            if (socket->bytesToWrite() >= LocalSocketBatchSize)
+                return;
+
+            // The size of the messages is an estimate of the size of their frames
+            int size = 0;
+            while (!pending.isEmpty() && size < LocalSocketBatchSize) {
+                size += pending.first().message().size();
+                items.append(pending.takeFirst());
+            }
+        }
+
+        if (items.isEmpty())
+            return;
+
+        QByteArray batch;
+        for (const auto &lmsg : std::as_const(items)) {
+            const auto frame = writer.encode(lmsg);
+            batch.append(frame);
+            writtenBytes += frame.size();
+            unsent.append({ lmsg, writtenBytes });
+        }
+        socket->write(batch);
+    }
+
+    // Messages are kept until the socket has sent all of their bytes
+    void sent(qint64 bytes)
+    {
+        sentBytes += bytes;
+
+        while (!unsent.isEmpty() && unsent.first().end <= sentBytes) {
+            unsent.removeFirst();
+        }
+    }
+
+    // The messages the socket hasn't sent go to the next connection
+    void requeueUnsent()
+    {
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            for (auto it = unsent.crbegin(); it != unsent.crend(); ++it) {
+                pending.prepend(it->lmsg);
+            }
+
+            while (pending.size() > maxPendingCount && !pending.isEmpty()) {
+                pending.removeFirst();
+            }
+        }
+
+        unsent.clear();
+        writtenBytes = 0;
+        sentBytes = 0;
+    }
+
+    struct Unsent
+    {
+        LogMessage lmsg;
+        // Bytes written to the socket up to the end of the message
+        qint64 end;
+    };
+
+    QPointer<QLocalSocket> socket;
+    BinaryLogWriter writer;
+
+    QList<Unsent> unsent;
+    qint64 writtenBytes = 0;
+    qint64 sentBytes = 0;
+
+    QElapsedTimer lastConnect;
+
+    QList<LogMessage> pending;
+    bool writeScheduled = false;
+};
+
+QTLOGGER_DECL_SPEC
+LocalSocketSink::LocalSocketSink(const QString &serverName)
+    : d(new LocalSocketSinkPrivate(serverName))
+{
+}
+
+QTLOGGER_DECL_SPEC
+LocalSocketSink::~LocalSocketSink() = default;
+
+QTLOGGER_DECL_SPEC
+void LocalSocketSink::send(const LogMessage &lmsg)
+{
+    d->send(lmsg);
+}
+
+QTLOGGER_DECL_SPEC
+bool LocalSocketSink::flush()
+{
+    d->flush();
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+QString LocalSocketSink::serverName() const
+{
+    return d->serverName;
+}
+
+QTLOGGER_DECL_SPEC
+int LocalSocketSink::maxPendingCount() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxPendingCount;
+}
+
+QTLOGGER_DECL_SPEC
+void LocalSocketSink::setMaxPendingCount(int count)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxPendingCount = count;
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
+
+// logmodelsink.cpp
+
+#include <QRegularExpression>
+#include <QSet>
+#include <QTimer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#    include <QThread>
+#endif
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int LogModelChunkSize = 4096;
+constexpr int LogModelMaxInternedStrings = 4096;
+
+// A message without the copies of the context strings of LogMessage, which are shared between
+// the entries of the same callsite instead
+struct LogModelEntry
+{
+    qint64 time;
+    quint64 threadId;
+    QByteArray category;
+    QByteArray file;
+    QByteArray function;
+    QString message;
+    QString formattedMessage;
+    QVariantHash attributes;
+    int line;
+    QtMsgType type;
+
+    QString displayText() const { return formattedMessage.isNull() ? message : formattedMessage; }
+};
+
+} // namespace
+
+class LogModelSink::LogModelSinkPrivate
+{
+public:
+    explicit LogModelSinkPrivate(int maxCount)
+        : maxCount(qMax(maxCount, 1)),
+          chunkSize(qBound(1, maxCount / 4, LogModelChunkSize))
+    {
+    }
+
+    QByteArray intern(const char *string)
+    {
+        const auto value = QByteArray(string);
+        const auto it = strings.constFind(value);
+        if (it != strings.cend())
+            return *it;
+
+        if (strings.size() < LogModelMaxInternedStrings)
+            strings.insert(value);
+
+        return value;
+    }
+
+    bool isFiltering() const
+    {
+        return qtMsgTypePriority(filter.minLevel) > 0 || !filter.category.isEmpty()
+                || !filter.text.isEmpty();
+    }
+
+    bool matches(const LogModelEntry &entry) const
+    {
+        if (qtMsgTypePriority(entry.type) < qtMsgTypePriority(filter.minLevel))
+            return false;
+
+        if (!filter.category.isEmpty()
+            && !categoryRegex.match(QString::fromUtf8(entry.category)).hasMatch()) {
+            return false;
+        }
+
+        return filter.text.isEmpty()
+                || entry.displayText().contains(filter.text, filter.caseSensitivity);
+    }
+
+    bool matchesFind(const LogModelEntry &entry) const
+    {
+        return entry.displayText().contains(findText, findCaseSensitivity);
+    }
+
+    // Every text containing the new text contains the previous one
+    static bool narrowsText(const QString &previous, Qt::CaseSensitivity previousCaseSensitivity,
+                            const QString &text, Qt::CaseSensitivity caseSensitivity)
+    {
+        return text.contains(previous, previousCaseSensitivity)
+                && !(previousCaseSensitivity == Qt::CaseSensitive
+                     && caseSensitivity == Qt::CaseInsensitive);
+    }
+
+    // The previous filter matches all messages the new one matches
+    static bool narrows(const RowFilter &previous, const RowFilter &filter)
+    {
+        if (qtMsgTypePriority(filter.minLevel) < qtMsgTypePriority(previous.minLevel))
+            return false;
+
+        if (!previous.category.isEmpty() && filter.category != previous.category)
+            return false;
+
+        if (previous.text.isEmpty())
+            return true;
+
+        return narrowsText(previous.text, previous.caseSensitivity, filter.text,
+                           filter.caseSensitivity);
+    }
+
+    // Indexes the messages with the text for find(): the same text again only looks up the
+    // index, a text that narrows the previous one only checks the messages it matched
+    void updateFindIndex(const QString &text, Qt::CaseSensitivity caseSensitivity)
+    {
+        if (hasFindIndex && text == findText && caseSensitivity == findCaseSensitivity)
+            return;
+
+        const auto narrowed = hasFindIndex
+                && narrowsText(findText, findCaseSensitivity, text, caseSensitivity);
+
+        findText = text;
+        findCaseSensitivity = caseSensitivity;
+        hasFindIndex = true;
+
+        std::deque<quint64> found;
+
+        if (narrowed) {
+            for (const auto seq : findIndex) {
+                if (matchesFind(entryAt(seq)))
+                    found.push_back(seq);
+            }
+        } else {
+            auto seq = firstSeq;
+            for (const auto &chunk : chunks) {
+                for (const auto &entry : chunk) {
+                    if (matchesFind(entry))
+                        found.push_back(seq);
+                    ++seq;
+                }
+            }
+        }
+
+        findIndex.swap(found);
+    }
+
+    int totalCount() const
+    {
+        return chunks.empty() ? 0
+                              : static_cast<int>((chunks.size() - 1) * chunkSize
+                                                 + chunks.back().size());
+    }
+
+    const LogModelEntry &entryAt(quint64 seq) const
+    {
+        const auto pos = seq - firstSeq;
+        return chunks[pos / chunkSize][pos % chunkSize];
+    }
+
+    quint64 seqAt(int row) const
+    {
+        return isFiltering() ? index[static_cast<size_t>(row)] : firstSeq + row;
+    }
+
+    // Row of the message, -1 if the filter doesn't match it
+    int rowOf(quint64 seq) const
+    {
+        if (!isFiltering())
+            return static_cast<int>(seq - firstSeq);
+
+        const auto it = std::lower_bound(index.cbegin(), index.cend(), seq);
+        return it != index.cend() && *it == seq ? static_cast<int>(it - index.cbegin()) : -1;
+    }
+
+    int maxCount;
+    int chunkSize;
+    int flushInterval = LogModelSink::DefaultFlushInterval;
+
+    // Written by send() in any thread
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    std::deque<LogModelEntry> pending;
+    QSet<QByteArray> strings;
+    quint64 droppedCount = 0;
+    bool flushScheduled = false;
+
+    // Thread of the model
+    std::deque<std::vector<LogModelEntry>> chunks;
+    quint64 firstSeq = 0;
+    std::deque<quint64> index;
+    RowFilter filter;
+    QRegularExpression categoryRegex;
+    QTimer *timer = nullptr;
+
+    // Messages with the text of the last find(), sorted; kept up to date like the row index
+    QString findText;
+    Qt::CaseSensitivity findCaseSensitivity = Qt::CaseInsensitive;
+    bool hasFindIndex = false;
+    std::deque<quint64> findIndex;
+};
+
+QTLOGGER_DECL_SPEC
+LogModelSink::LogModelSink(int maxCount, QObject *parent)
+    : QAbstractListModel(parent), d(new LogModelSinkPrivate(maxCount))
+{
+    d->timer = new QTimer(this);
+    d->timer->setSingleShot(true);
+    QObject::connect(d->timer, &QTimer::timeout, this, &LogModelSink::flush);
+}
+
+QTLOGGER_DECL_SPEC
+LogModelSink::~LogModelSink() = default;
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::send(const LogMessage &lmsg)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+
+    LogModelEntry entry;
+    entry.time = lmsg.time().toMSecsSinceEpoch();
+    entry.threadId = lmsg.threadId();
+    entry.category = d->intern(lmsg.category());
+    entry.file = d->intern(lmsg.file());
+    entry.function = d->intern(lmsg.function());
+    entry.message = lmsg.message();
+    if (lmsg.isFormatted() && lmsg.formattedMessage() != lmsg.message())
+        entry.formattedMessage = lmsg.formattedMessage();
+    entry.attributes = lmsg.attributes();
+    entry.line = lmsg.line();
+    entry.type = lmsg.type();
+
+    // Messages the model wouldn't keep anyway
+    if (d->pending.size() >= static_cast<size_t>(d->maxCount)) {
+        d->pending.pop_front();
+        ++d->droppedCount;
+    }
+
+    d->pending.push_back(std::move(entry));
+
+    if (!d->flushScheduled) {
+        d->flushScheduled = true;
+        QMetaObject::invokeMethod(this, "startFlushTimer", Qt::QueuedConnection);
+    }
+}
+
+QTLOGGER_DECL_SPEC
+bool LogModelSink::flush()
+{
+    std::deque<LogModelEntry> batch;
+
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&d->mutex);
+
+        if (QThread::currentThread() != thread()) {
+            if (!d->flushScheduled && !d->pending.empty()) {
+                d->flushScheduled = true;
+                QMetaObject::invokeMethod(this, "startFlushTimer", Qt::QueuedConnection);
+            }
+            return true;
+        }
+#endif
+
+        batch.swap(d->pending);
+        d->flushScheduled = false;
+    }
+
+    d->timer->stop();
+
+    if (batch.empty())
+        return true;
+
+    std::vector<bool> matched;
+    auto matchedCount = static_cast<int>(batch.size());
+    if (d->isFiltering()) {
+        matched.reserve(batch.size());
+        matchedCount = 0;
+        for (const auto &entry : batch) {
+            matched.push_back(d->matches(entry));
+            if (matched.back())
+                ++matchedCount;
+        }
+    }
+
+    const auto firstRow = rowCount();
+    if (matchedCount > 0)
+        beginInsertRows(QModelIndex(), firstRow, firstRow + matchedCount - 1);
+
+    auto seq = d->firstSeq + static_cast<quint64>(d->totalCount());
+    for (size_t i = 0; i < batch.size(); ++i, ++seq) {
+        if (d->chunks.empty() || d->chunks.back().size() == static_cast<size_t>(d->chunkSize)) {
+            d->chunks.emplace_back();
+            d->chunks.back().reserve(static_cast<size_t>(d->chunkSize));
+        }
+        d->chunks.back().push_back(std::move(batch[i]));
+
+        if (!matched.empty() && matched[i])
+            d->index.push_back(seq);
+        if (d->hasFindIndex && d->matchesFind(d->chunks.back().back()))
+            d->findIndex.push_back(seq);
+    }
+
+    if (matchedCount > 0)
+        endInsertRows();
+
+    // The oldest chunks are dropped as a whole
+    while (d->totalCount() > d->maxCount) {
+        const auto end = d->firstSeq + static_cast<quint64>(d->chunkSize);
+
+        auto removed = d->chunkSize;
+        if (d->isFiltering()) {
+            removed = 0;
+            while (static_cast<size_t>(removed) < d->index.size()
+                   && d->index[static_cast<size_t>(removed)] < end) {
+                ++removed;
+            }
+        }
+
+        if (removed > 0)
+            beginRemoveRows(QModelIndex(), 0, removed - 1);
+
+        d->chunks.pop_front();
+        d->firstSeq = end;
+        if (d->isFiltering())
+            d->index.erase(d->index.begin(), d->index.begin() + removed);
+        d->findIndex.erase(d->findIndex.begin(),
+                           std::lower_bound(d->findIndex.begin(), d->findIndex.end(), end));
+
+        if (removed > 0)
+            endRemoveRows();
+    }
+
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+int LogModelSink::maxCount() const
+{
+    return d->maxCount;
+}
+
+QTLOGGER_DECL_SPEC
+int LogModelSink::flushInterval() const
+{
+    return d->flushInterval;
+}
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::setFlushInterval(int msecs)
+{
+    d->flushInterval = qMax(msecs, 0);
+}
+
+QTLOGGER_DECL_SPEC
+int LogModelSink::totalCount() const
+{
+    return d->totalCount();
+}
+
+QTLOGGER_DECL_SPEC
+quint64 LogModelSink::droppedCount() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->droppedCount;
+}
+
+QTLOGGER_DECL_SPEC
+LogModelSink::RowFilter LogModelSink::rowFilter() const
+{
+    return d->filter;
+}
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::setRowFilter(const RowFilter &filter)
+{
+    const auto wasFiltering = d->isFiltering();
+    const auto narrowed = wasFiltering && LogModelSinkPrivate::narrows(d->filter, filter);
+
+    beginResetModel();
+
+    d->filter = filter;
+
+    if (!filter.category.isEmpty()) {
+        auto pattern = QRegularExpression::escape(filter.category);
+        pattern.replace(QStringLiteral("\\*"), QStringLiteral(".*"));
+        d->categoryRegex = QRegularExpression(QStringLiteral("^%1$").arg(pattern));
+    }
+
+    std::deque<quint64> index;
+
+    if (narrowed) {
+        for (const auto seq : d->index) {
+            if (d->matches(d->entryAt(seq)))
+                index.push_back(seq);
+        }
+    } else if (d->isFiltering()) {
+        auto seq = d->firstSeq;
+        for (const auto &chunk : d->chunks) {
+            for (const auto &entry : chunk) {
+                if (d->matches(entry))
+                    index.push_back(seq);
+                ++seq;
+            }
+        }
+    }
+
+    d->index.swap(index);
+
+    endResetModel();
+}
+
+QTLOGGER_DECL_SPEC
+int LogModelSink::find(const QString &text, int fromRow, bool backward,
+                       Qt::CaseSensitivity caseSensitivity) const
+{
+    if (fromRow < 0 || fromRow >= rowCount())
+        return -1;
+
+    d->updateFindIndex(text, caseSensitivity);
+
+    const auto &found = d->findIndex;
+    const auto from = d->seqAt(fromRow);
+
+    if (backward) {
+        auto it = std::upper_bound(found.cbegin(), found.cend(), from);
+        while (it != found.cbegin()) {
+            const auto row = d->rowOf(*--it);
+            if (row >= 0)
+                return row;
+        }
+    } else {
+        for (auto it = std::lower_bound(found.cbegin(), found.cend(), from); it != found.cend();
+             ++it) {
+            const auto row = d->rowOf(*it);
+            if (row >= 0)
+                return row;
+        }
+    }
+
+    return -1;
+}
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::clearFind()
+{
+    d->hasFindIndex = false;
+    d->findText.clear();
+    d->findIndex.clear();
+}
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::clear()
+{
+    beginResetModel();
+    d->firstSeq += static_cast<quint64>(d->totalCount());
+    d->chunks.clear();
+    d->index.clear();
+    d->findIndex.clear();
+    endResetModel();
+}
+
+QTLOGGER_DECL_SPEC
+int LogModelSink::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+
+    return d->isFiltering() ? static_cast<int>(d->index.size()) : d->totalCount();
+}
+
+QTLOGGER_DECL_SPEC
+QVariant LogModelSink::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+        return QVariant();
+
+    const auto &entry = d->entryAt(d->seqAt(index.row()));
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return entry.displayText();
+    case TimeRole:
+        return QDateTime::fromMSecsSinceEpoch(entry.time);
+    case TypeRole:
+        return static_cast<int>(entry.type);
+    case CategoryRole:
+        return QString::fromUtf8(entry.category);
+    case FileRole:
+        return QString::fromUtf8(entry.file);
+    case LineRole:
+        return entry.line;
+    case FunctionRole:
+        return QString::fromUtf8(entry.function);
+    case MessageRole:
+        return entry.message;
+    case FormattedMessageRole:
+        return entry.displayText();
+    case ThreadIdRole:
+        return entry.threadId;
+    case AttributesRole:
+        return entry.attributes;
+    default:
+        return QVariant();
+    }
+}
+
+QTLOGGER_DECL_SPEC
+QHash<int, QByteArray> LogModelSink::roleNames() const
+{
+    auto roles = QAbstractListModel::roleNames();
+    roles.insert(TimeRole, "time");
+    roles.insert(TypeRole, "type");
+    roles.insert(CategoryRole, "category");
+    roles.insert(FileRole, "file");
+    roles.insert(LineRole, "line");
+    roles.insert(FunctionRole, "function");
+    roles.insert(MessageRole, "message");
+    roles.insert(FormattedMessageRole, "formattedMessage");
+    roles.insert(ThreadIdRole, "threadId");
+    roles.insert(AttributesRole, "attributes");
+    return roles;
+}
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::startFlushTimer()
+{
+    if (d->flushInterval == 0) {
+        flush();
+        return;
+    }
+
+    if (!d->timer->isActive())
+        d->timer->start(d->flushInterval);
+}
+
+} // namespace QtLogger
+
+// oslogsink.cpp
+
+#ifdef QTLOGGER_OSLOG
+
+#include <os/log.h>
+
+#include <QCoreApplication>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+void OslogSink::send(const LogMessage &lmsg)
+{
+    auto customLog = os_log_create(qPrintable(QCoreApplication::applicationName()),
+                                   qPrintable(lmsg.category()));
+
+    auto type = OS_LOG_TYPE_DEBUG;
+    switch (lmsg.type()) {
+    case QtDebugMsg:
+        type = OS_LOG_TYPE_DEBUG;
+        break;
+    case QtInfoMsg:
+        type = OS_LOG_TYPE_INFO;
+        break;
+    case QtWarningMsg:
+        type = OS_LOG_TYPE_ERROR;
+        break;
+    case QtCriticalMsg:
+        type = OS_LOG_TYPE_FAULT;
+        break;
+    case QtFatalMsg:
+        type = OS_LOG_TYPE_FAULT;
+        break;
+    };
+
+    os_log_with_type(customLog, type, "%s", qPrintable(lmsg.message()));
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_OSLOG
+
+// otlpsink.cpp
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QAtomicInteger>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QThread>
+#include <QTimer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+struct OtlpRecord
+{
+    QString scope;
+    QJsonObject record;
+};
+
+int otlpSeverityNumber(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return 5;
+    case QtInfoMsg:
+        return 9;
+    case QtWarningMsg:
+        return 13;
+    case QtCriticalMsg:
+        return 17;
+    case QtFatalMsg:
+        return 21;
+    }
+    return 5;
+}
+
+QString otlpSeverityText(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return QStringLiteral("DEBUG");
+    case QtInfoMsg:
+        return QStringLiteral("INFO");
+    case QtWarningMsg:
+        return QStringLiteral("WARN");
+    case QtCriticalMsg:
+        return QStringLiteral("ERROR");
+    case QtFatalMsg:
+        return QStringLiteral("FATAL");
+    }
+    return QStringLiteral("DEBUG");
+}
+
+// 64-bit integers are strings in the JSON mapping of OTLP
+QString otlpNanos(const QDateTime &time)
+{
+    return QString::number(time.toMSecsSinceEpoch() * 1000000);
+}
+
+QJsonObject otlpAnyValue(const QVariant &value);
+
+QJsonObject otlpKeyValue(const QString &key, const QVariant &value)
+{
+    return QJsonObject { { QStringLiteral("key"), key },
+                         { QStringLiteral("value"), otlpAnyValue(value) } };
+}
+
+QJsonArray otlpKeyValueList(const QVariantHash &attributes)
+{
+    QJsonArray result;
+    for (auto it = attributes.cbegin(); it != attributes.cend(); ++it) {
+        result.append(otlpKeyValue(it.key(), it.value()));
+    }
+    return result;
+}
+
+QJsonObject otlpAnyValue(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::Bool:
+        return QJsonObject { { QStringLiteral("boolValue"), value.toBool() } };
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+        return QJsonObject { { QStringLiteral("intValue"),
+                               QString::number(value.toLongLong()) } };
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return QJsonObject { { QStringLiteral("doubleValue"), value.toDouble() } };
+    case QMetaType::QByteArray:
+        return QJsonObject { { QStringLiteral("bytesValue"),
+                               QString::fromLatin1(value.toByteArray().toBase64()) } };
+    case QMetaType::QStringList:
+    case QMetaType::QVariantList: {
+        QJsonArray values;
+        const auto list = value.toList();
+        for (const auto &item : list) {
+            values.append(otlpAnyValue(item));
+        }
+        return QJsonObject { { QStringLiteral("arrayValue"),
+                               QJsonObject { { QStringLiteral("values"), values } } } };
+    }
+    case QMetaType::QVariantMap:
+    case QMetaType::QVariantHash:
+        return QJsonObject { { QStringLiteral("kvlistValue"),
+                               QJsonObject { { QStringLiteral("values"),
+                                               otlpKeyValueList(value.toHash()) } } } };
+    default:
+        return QJsonObject { { QStringLiteral("stringValue"), value.toString() } };
+    }
+}
+
+QString otlpScope(const LogMessage &lmsg)
+{
+    return lmsg.category() && *lmsg.category() ? QString::fromUtf8(lmsg.category())
+                                               : QStringLiteral("default");
+}
+
+QByteArray otlpExportRequest(const QList<OtlpRecord> &records,
+                             const QVariantHash &resourceAttributes)
+{
+    // Records of a category share a scope, the scopes keep the order of their first record
+    QStringList scopeNames;
+    QHash<QString, QJsonArray> scopeRecords;
+    for (const auto &item : records) {
+        auto it = scopeRecords.find(item.scope);
+        if (it == scopeRecords.end()) {
+            scopeNames.append(item.scope);
+            it = scopeRecords.insert(item.scope, QJsonArray());
+        }
+        it->append(item.record);
+    }
+
+    QJsonArray scopeLogs;
+    for (const auto &name : std::as_const(scopeNames)) {
+        scopeLogs.append(QJsonObject {
+                { QStringLiteral("scope"), QJsonObject { { QStringLiteral("name"), name } } },
+                { QStringLiteral("logRecords"), scopeRecords.value(name) } });
+    }
+
+    const QJsonObject resourceLogs {
+        { QStringLiteral("resource"),
+          QJsonObject { { QStringLiteral("attributes"),
+                          otlpKeyValueList(resourceAttributes) } } },
+        { QStringLiteral("scopeLogs"), scopeLogs }
+    };
+
+    const QJsonObject request { { QStringLiteral("resourceLogs"), QJsonArray { resourceLogs } } };
+
+    return QJsonDocument(request).toJson(QJsonDocument::Compact);
+}
+
+} // namespace
+
+class OtlpSink::OtlpSinkPrivate
+{
+public:
+    OtlpSinkPrivate(const QUrl &endpoint, const Headers &headers)
+        : endpoint(endpoint), resourceAttributes(defaultResourceAttributes())
+    {
+        if (this->endpoint.path().isEmpty() || this->endpoint.path() == QLatin1String("/"))
+            this->endpoint.setPath(QStringLiteral("/v1/logs"));
+
+        request.setUrl(this->endpoint);
+        request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
+        setHeaders(headers);
+    }
+
+    ~OtlpSinkPrivate()
+    {
+        thread.run([this] { resetManager(); });
+        thread.stop();
+    }
+
+    // Called with the mutex locked
+    void setHeaders(const Headers &headers)
+    {
+        for (const auto &header : headers) {
+            request.setRawHeader(header.first, header.second);
+        }
+    }
+
+    // The record is queued in the calling thread, so a full queue drops it before send() returns
+    void send(const LogMessage &lmsg)
+    {
+        OtlpRecord record { otlpScope(lmsg), toLogRecord(lmsg) };
+
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            if (queue.size() >= maxQueueSize) {
+                dropped.fetchAndAddRelaxed(1);
+                return;
+            }
+
+            queue.append(record);
+
+            // Records queued until the thread of the sink gets to them are handled by one call
+            if (updateScheduled)
+                return;
+            updateScheduled = true;
+        }
+
+        thread.post([this] {
+            ensureManager();
+            update();
+        });
+    }
+
+    void flush()
+    {
+        thread.run([this] {
+            if (!manager)
+                return;
+
+            while (queueSize() > 0) {
+                exportBatch(true);
+            }
+        });
+    }
+
+    QUrl endpoint;
+
+    // Set by any thread, guarded by the mutex and copied by the thread of the sink before use
+    QNetworkRequest request;
+    QVariantHash resourceAttributes;
+    int maxQueueSize = DefaultMaxQueueSize;
+    int maxExportBatchSize = DefaultMaxExportBatchSize;
+    int scheduleDelay = DefaultScheduleDelay;
+    int exportTimeout = DefaultExportTimeout;
+
+    QAtomicInteger<quint64> exported;
+    QAtomicInteger<quint64> dropped;
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    SinkThread thread { QStringLiteral("OtlpSink") };
+
+private:
+    // The manager, its timer and the replies are used only in the thread of the sink
+    void ensureManager()
+    {
+        if (manager)
+            return;
+
+        manager = new QNetworkAccessManager(thread.context());
+
+        timer = new QTimer(manager.data());
+        timer->setSingleShot(true);
+        QObject::connect(timer.data(), &QTimer::timeout, manager.data(), [this] { exportBatch(); });
+    }
+
+    // Exports a full batch, or schedules the export of an incomplete one
+    void update()
+    {
+        int size = 0;
+        int maxExportBatchSize = DefaultMaxExportBatchSize;
+        int scheduleDelay = DefaultScheduleDelay;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            updateScheduled = false;
+            size = queue.size();
+            maxExportBatchSize = this->maxExportBatchSize;
+            scheduleDelay = this->scheduleDelay;
+        }
+
+        if (size >= maxExportBatchSize)
+            exportBatch();
+        else if (size > 0 && timer && !timer->isActive())
+            timer->start(scheduleDelay);
+    }
+
+    int queueSize()
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&mutex);
+#endif
+        return queue.size();
+    }
+
+    int currentExportTimeout()
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&mutex);
+#endif
+        return exportTimeout;
+    }
+
+    // Queued records are exported before the manager is deleted, waiting up to the export
+    // timeout for the collector to accept them
+    void resetManager()
+    {
+        if (!manager)
+            return;
+
+        if (manager->thread() == QThread::currentThread()) {
+            while (queueSize() > 0) {
+                exportBatch(true);
             }
-        }
 
-        if (!handledFunctionPointer) {
-            // Remove function arguments
-            int end = func.lastIndexOf(')');
-            if (end != -1) {
-                int openParen = findBalancedReverse('(', ')', end);
-                if (openParen != -1) {
-                    bool isOperatorCall = false;
-                    if (openParen >= 8 && func.mid(openParen - 8, 8) == "operator") {
-                        // Check that 'operator' is not part of a longer identifier
-                        if (openParen == 8) {
-                            isOperatorCall = true;
-                        } else {
-                            char prevChar = func.at(openParen - 9);
-                            if (!QChar::isLetterOrNumber(prevChar) && prevChar != '_') {
-                                isOperatorCall = true;
-                            }
-                        }
-                    }
-                    if (!isOperatorCall)
-                        func.truncate(openParen);
-                }
+            if (activeExports > 0) {
+                QEventLoop loop;
+                waitLoop = &loop;
+                QTimer::singleShot(currentExportTimeout(), &loop, &QEventLoop::quit);
+                loop.exec(QEventLoop::ExcludeUserInputEvents);
+                waitLoop = nullptr;
             }
+        }
 
-            // Remove trailing qualifiers
-            static const char *const qualifiers[] = { " const", " volatile", " noexcept",
-                                                      " override", " final" };
-            bool found;
-            do {
-                found = false;
-                for (const char *qual : qualifiers) {
-                    if (func.endsWith(qual)) {
-                        func.chop(static_cast<int>(qstrlen(qual)));
-                        found = true;
-                        break;
-                    }
-                }
-            } while (found);
+        for (const auto &reply : std::as_const(replies)) {
+            if (reply)
+                reply->disconnect(manager.data());
+        }
+        replies.clear();
+        timer->disconnect();
 
-            // Extract function name (remove return type)
-            int operatorPos = func.lastIndexOf("operator");
-            if (operatorPos != -1) {
-                int scanPos = operatorPos - 1;
-                while (scanPos >= 0 && func.at(scanPos) == ' ')
-                    --scanPos;
+        if (manager->thread() == QThread::currentThread())
+            delete manager.data();
+        else
+            manager->deleteLater();
 
-                bool extracted = false;
-                while (scanPos >= 0) {
-                    if (scanPos >= 1 && func.at(scanPos) == ':' && func.at(scanPos - 1) == ':') {
-                        scanPos -= 2;
-                        while (scanPos >= 0 && func.at(scanPos) == ' ')
-                            --scanPos;
-                        if (scanPos >= 0 && func.at(scanPos) == ')') {
-                            int op = findBalancedReverse('(', ')', scanPos + 1);
-                            if (op != -1) {
-                                scanPos = op - 1;
-                                continue;
-                            }
-                        }
-                        if (scanPos >= 0 && func.at(scanPos) == '>') {
-                            int oa = findBalancedReverse('<', '>', scanPos + 1);
-                            if (oa != -1) {
-                                scanPos = oa - 1;
-                                continue;
-                            }
-                        }
-                        while (scanPos >= 0
-                               && (QChar(func.at(scanPos)).isLetterOrNumber()
-                                   || func.at(scanPos) == '_'))
-                            --scanPos;
-                    } else if (func.at(scanPos) == ' ') {
-                        func = func.mid(scanPos + 1);
-                        extracted = true;
-                        break;
-                    } else {
-                        break;
-                    }
-                }
-                if (!extracted) {
-                    int firstSpace = func.indexOf(' ');
-                    if (firstSpace != -1 && firstSpace < operatorPos)
-                        func = func.mid(firstSpace + 1);
-                }
-            } else {
-                int pos = func.size() - 1;
-                int parenCount = 0, angleCount = 0;
-                while (pos >= 0) {
-                    char c = func.at(pos);
-                    if (c == ')') {
-                        ++parenCount;
-                        --pos;
-                        continue;
-                    }
-                    if (c == '(' && parenCount > 0) {
-                        --parenCount;
-                        --pos;
-                        continue;
-                    }
-                    if (c == '>') {
-                        ++angleCount;
-                        --pos;
-                        continue;
-                    }
-                    if (c == '<' && angleCount > 0) {
-                        --angleCount;
-                        --pos;
-                        continue;
-                    }
-                    if (parenCount > 0 || angleCount > 0) {
-                        --pos;
-                        continue;
-                    }
-                    if (c == ' ') {
-                        func = func.mid(pos + 1);
-                        break;
-                    }
-                    --pos;
-                }
-            }
-            while (func.startsWith('*') || func.startsWith('&') || func.startsWith(' '))
-                func = func.mid(1);
+        manager = nullptr;
+        activeExports = 0;
+    }
+
+    // One export at a time unless forced by flush, the queue collects the records meanwhile
+    void exportBatch(bool force = false)
+    {
+        if (!manager || (activeExports > 0 && !force))
+            return;
+
+        QList<OtlpRecord> batch;
+        QNetworkRequest request;
+        QVariantHash resourceAttributes;
+        int exportTimeout = DefaultExportTimeout;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            const auto count = qMin(queue.size(), maxExportBatchSize);
+            batch = queue.mid(0, count);
+            queue.erase(queue.begin(), queue.begin() + count);
+
+            request = this->request;
+            resourceAttributes = this->resourceAttributes;
+            exportTimeout = this->exportTimeout;
         }
 
-        // Remove empty parentheses before :: (e.g., method():: -> method::)
-        int pos = 0;
-        while ((pos = func.indexOf("()::", pos)) != -1) {
-            if (pos >= 8 && func.mid(pos - 8, 8) == "operator") {
-                pos += 4;
-                continue;
-            }
-            int angleDepth = 0;
-            bool insideTemplate = false;
-            for (int i = pos - 1; i >= 0; --i) {
-                if (func.at(i) == '>')
-                    ++angleDepth;
-                else if (func.at(i) == '<') {
-                    if (angleDepth == 0) {
-                        insideTemplate = true;
-                        break;
-                    }
-                    --angleDepth;
-                }
-            }
-            if (insideTemplate) {
-                pos += 4;
-                continue;
-            }
-            func.remove(pos, 2);
-        }
+        if (batch.isEmpty())
+            return;
+
+        timer->stop();
+
+        const auto count = batch.size();
+
+        auto reply = manager->post(request, otlpExportRequest(batch, resourceAttributes));
+        replies.append(reply);
+        ++activeExports;
+
+        QTimer::singleShot(exportTimeout, reply, &QNetworkReply::abort);
+
+        QObject::connect(reply, &QNetworkReply::finished, manager.data(), [this, reply, count] {
+            const auto status =
+                    reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            if (reply->error() == QNetworkReply::NoError && status >= 200 && status < 300)
+                exported.fetchAndAddRelaxed(static_cast<quint64>(count));
+            else
+                dropped.fetchAndAddRelaxed(static_cast<quint64>(count));
+
+            replies.removeAll(reply);
+            reply->deleteLater();
+
+            if (--activeExports == 0 && waitLoop)
+                waitLoop->quit();
+
+            update();
+        });
+    }
+
+    QPointer<QNetworkAccessManager> manager;
+    QPointer<QTimer> timer;
+    QList<QPointer<QNetworkReply>> replies;
+    int activeExports = 0;
+    QEventLoop *waitLoop = nullptr;
+
+    QList<OtlpRecord> queue;
+    bool updateScheduled = false;
+};
+
+QTLOGGER_DECL_SPEC
+OtlpSink::OtlpSink(const QUrl &endpoint) : d(new OtlpSinkPrivate(endpoint, {})) { }
+
+QTLOGGER_DECL_SPEC
+OtlpSink::OtlpSink(const QUrl &endpoint, const Headers &headers)
+    : d(new OtlpSinkPrivate(endpoint, headers))
+{
+}
+
+QTLOGGER_DECL_SPEC
+OtlpSink::~OtlpSink() = default;
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::send(const LogMessage &lmsg)
+{
+    d->send(lmsg);
+}
+
+QTLOGGER_DECL_SPEC
+bool OtlpSink::flush()
+{
+    d->flush();
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+QUrl OtlpSink::endpoint() const
+{
+    return d->endpoint;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setHeaders(const Headers &headers)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->setHeaders(headers);
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash OtlpSink::resourceAttributes() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->resourceAttributes;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setResourceAttributes(const QVariantHash &attributes)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->resourceAttributes = attributes;
+}
+
+QTLOGGER_DECL_SPEC
+int OtlpSink::maxQueueSize() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxQueueSize;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setMaxQueueSize(int maxQueueSize)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxQueueSize = qMax(maxQueueSize, 1);
+}
+
+QTLOGGER_DECL_SPEC
+int OtlpSink::maxExportBatchSize() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxExportBatchSize;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setMaxExportBatchSize(int maxExportBatchSize)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxExportBatchSize = qMax(maxExportBatchSize, 1);
+}
+
+QTLOGGER_DECL_SPEC
+int OtlpSink::scheduleDelay() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->scheduleDelay;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setScheduleDelay(int msecs)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->scheduleDelay = qMax(msecs, 0);
+}
+
+QTLOGGER_DECL_SPEC
+int OtlpSink::exportTimeout() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->exportTimeout;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setExportTimeout(int msecs)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->exportTimeout = qMax(msecs, 0);
+}
 
-        // Remove template parameters
-        while (true) {
-            int closeAngle = func.lastIndexOf('>');
-            if (closeAngle == -1)
-                break;
-            int opCheck = func.lastIndexOf("operator", closeAngle);
-            if (opCheck != -1) {
-                int operatorEnd = opCheck + 8;
-                if (operatorEnd <= closeAngle) {
-                    bool isOperatorSymbol = true;
-                    static const QByteArray operatorChars("=!+-*/%^&|~<>");
-                    for (int i = operatorEnd; i <= closeAngle; ++i) {
-                        char ch = func.at(i);
-                        if (!operatorChars.contains(ch)) {
-                            isOperatorSymbol = false;
-                            break;
-                        }
-                    }
-                    if (isOperatorSymbol)
-                        break;
-                }
-            }
-            int openAngle = findBalancedReverse('<', '>', closeAngle);
-            if (openAngle == -1)
-                break;
-            if (openAngle >= 8 && func.mid(openAngle - 8, 8) == "operator")
-                break;
-            if (func.mid(openAngle + 1, closeAngle - openAngle - 1).startsWith("lambda"))
-                break;
-            func.remove(openAngle, closeAngle - openAngle + 1);
-        }
+QTLOGGER_DECL_SPEC
+quint64 OtlpSink::exportedCount() const
+{
+    return d->exported.loadAcquire();
+}
 
-        return func;
-    }
-};
+QTLOGGER_DECL_SPEC
+quint64 OtlpSink::droppedCount() const
+{
+    return d->dropped.loadAcquire();
+}
 
-class CategoryToken : public FormattedToken
+QTLOGGER_DECL_SPEC
+QVariantHash OtlpSink::defaultResourceAttributes()
 {
-public:
-    CategoryToken() { }
+    const LogMessage lmsg;
+    auto attrs = AppInfoAttrs().attributes(lmsg);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    attrs.insert(SysInfoAttrs().attributes(lmsg));
+#else
+    attrs.unite(SysInfoAttrs().attributes(lmsg));
+#endif
 
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
-    {
-        dest.append(applyPadding(lmsg.category()));
+    static const QList<QPair<QString, QString>> names = {
+        { QStringLiteral("appname"), QStringLiteral("service.name") },
+        { QStringLiteral("appversion"), QStringLiteral("service.version") },
+        { QStringLiteral("apppath"), QStringLiteral("process.executable.path") },
+        { QStringLiteral("pid"), QStringLiteral("process.pid") },
+        { QStringLiteral("machine_host_name"), QStringLiteral("host.name") },
+        { QStringLiteral("machine_unique_id"), QStringLiteral("host.id") },
+        { QStringLiteral("cpu_arch"), QStringLiteral("host.arch") },
+        { QStringLiteral("kernel_type"), QStringLiteral("os.type") },
+        { QStringLiteral("os_name"), QStringLiteral("os.name") },
+        { QStringLiteral("os_version"), QStringLiteral("os.version") },
+        { QStringLiteral("pretty_product_name"), QStringLiteral("os.description") },
+    };
+
+    QVariantHash result;
+    for (const auto &name : names) {
+        const auto value = attrs.value(name.first).toString();
+        if (!value.isEmpty())
+            result.insert(name.second, attrs.value(name.first));
     }
 
-    size_t estimatedLength() const override
-    {
-        return hasFormatSpec() ? formatWidth() : 20; // Maximum length of "categoryName"
+    // service.name is required by the specification
+    if (!result.contains(QStringLiteral("service.name"))) {
+        result.insert(QStringLiteral("service.name"),
+                      QStringLiteral("unknown_service:")
+                              + QFileInfo(attrs.value(QStringLiteral("apppath")).toString())
+                                        .fileName());
     }
-};
 
-class TimeToken : public FormattedToken
-{
-public:
-    explicit TimeToken(const QString &format = QString()) : m_format(format) { }
+    result.insert(QStringLiteral("telemetry.sdk.name"), QStringLiteral("qtlogger"));
+    result.insert(QStringLiteral("telemetry.sdk.language"), QStringLiteral("cpp"));
 
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
-    {
-        QString value;
-        if (m_format == QLatin1String("process")) {
-            // Time since process started in seconds
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    lmsg.steadyTime() - g_processStartTime);
-            double seconds = duration.count() / 1000.0;
-            value = QString::number(seconds, 'f', 3);
-        } else if (m_format == QLatin1String("boot")) {
-            // Time since system boot in seconds using steady_clock epoch
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    lmsg.steadyTime().time_since_epoch());
-            double seconds = duration.count() / 1000.0;
-            value = QString::number(seconds, 'f', 3);
-        } else if (m_format.isEmpty()) {
-            value = lmsg.time().toString(Qt::ISODate);
-        } else {
-            value = lmsg.time().toString(m_format);
-        }
-        dest.append(applyPadding(value));
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+QJsonObject OtlpSink::toLogRecord(const LogMessage &lmsg)
+{
+    QJsonObject record;
+
+    const auto time = otlpNanos(lmsg.time());
+    record.insert(QStringLiteral("timeUnixNano"), time);
+    record.insert(QStringLiteral("observedTimeUnixNano"), time);
+    record.insert(QStringLiteral("severityNumber"), otlpSeverityNumber(lmsg.type()));
+    record.insert(QStringLiteral("severityText"), otlpSeverityText(lmsg.type()));
+    record.insert(QStringLiteral("body"),
+                  QJsonObject { { QStringLiteral("stringValue"), lmsg.formattedMessage() } });
+
+    auto attrs = lmsg.attributes();
+    if (lmsg.file()) {
+        attrs.insert(QStringLiteral("code.file.path"), QString::fromUtf8(lmsg.file()));
+        attrs.insert(QStringLiteral("code.line.number"), lmsg.line());
     }
+    if (lmsg.function())
+        attrs.insert(QStringLiteral("code.function.name"), QString::fromUtf8(lmsg.function()));
+#ifndef QTLOGGER_NO_THREAD
+    attrs.insert(QStringLiteral("thread.id"), static_cast<qint64>(lmsg.threadId()));
+#endif
 
-    size_t estimatedLength() const override
-    {
-        if (hasFormatSpec())
-            return formatWidth();
-        if (m_format == QLatin1String("process") || m_format == QLatin1String("boot")) {
-            return 15; // Enough for "123456789.123"
-        }
-        return m_format.isEmpty() ? 20 : m_format.length() * 2; // Estimated length based on format
+    record.insert(QStringLiteral("attributes"), otlpKeyValueList(attrs));
+
+    return record;
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray OtlpSink::exportRequest(const QList<LogMessage> &messages,
+                                   const QVariantHash &resourceAttributes)
+{
+    QList<OtlpRecord> records;
+    records.reserve(messages.size());
+    for (const auto &lmsg : messages) {
+        records.append({ otlpScope(lmsg), toLogRecord(lmsg) });
     }
 
-private:
-    QString m_format;
-};
+    return otlpExportRequest(records, resourceAttributes);
+}
 
-class ThreadIdToken : public FormattedToken
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
+
+// recordingsink.cpp
+
+#include <QFile>
+
+namespace QtLogger {
+
+class RecordingSink::RecordingSinkPrivate
 {
 public:
-    ThreadIdToken() { }
+    quint64 maxCount = 0;
+    quint64 count = 0;
 
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    BinaryLogWriter writer;
+};
+
+QTLOGGER_DECL_SPEC
+RecordingSink::RecordingSink(const QString &path, quint64 maxCount)
+    : FileSink(path, QIODevice::WriteOnly | QIODevice::Truncate), d(new RecordingSinkPrivate)
+{
+    d->maxCount = maxCount;
+}
+
+QTLOGGER_DECL_SPEC
+RecordingSink::~RecordingSink() = default;
+
+QTLOGGER_DECL_SPEC
+void RecordingSink::send(const LogMessage &lmsg)
+{
+    if (!isValid() || (d->maxCount > 0 && d->count >= d->maxCount))
+        return;
+
+    FileSink::send(lmsg);
+    ++d->count;
+
+    // The recording is complete, nothing is left in the buffer if the application is killed
+    if (d->count == d->maxCount)
+        flush();
+}
+
+QTLOGGER_DECL_SPEC
+bool RecordingSink::isValid() const
+{
+    return file() && file()->isOpen();
+}
+
+QTLOGGER_DECL_SPEC
+quint64 RecordingSink::maxCount() const
+{
+    return d->maxCount;
+}
+
+QTLOGGER_DECL_SPEC
+quint64 RecordingSink::count() const
+{
+    return d->count;
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray RecordingSink::encode(const LogMessage &lmsg)
+{
+    return d->writer.encode(lmsg);
+}
+
+} // namespace QtLogger
+
+// rotatingfilesink.cpp
+
+/*
+ * Rotated file naming format:
+ *   <basename>.<date>.<index>.<suffix>[.gz]
+ *   Example: app.2024-05-15.1.log or app.2024-05-15.1.log.gz
+ *
+ * Rotation triggers:
+ *   1. On startup (RotationOnStartup) - rotates if the log file is non-empty
+ *   2. Daily (RotationDaily) - rotates when the message date differs from the current log date
+ *   3. By size (maxFileSize > 0) - rotates when adding a new message would exceed maxFileSize
+ *
+ *   If maxFileCount == 1, rotation is disabled (only the main file is kept)
+ *   If maxFileCount <= 0, rotated files are kept indefinitely (no automatic cleanup)
+ *
+ * With the TimeIndex option the "<file>.idx" index is renamed and removed with its log file.
+ * BlockCompression writes seekable gzip files with a "<file>.gz.gzi" block index instead of a
+ * single gzip stream, see seekablegzip.h. With TermIndex the terms of a file are written to
+ * "<file>.tix" when it is rotated, if the sink wrote the file from its start.
+ */
+
+#include <QDate>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <iostream>
+
+namespace QtLogger {
+
+class RotatingFileSink::RotatingFileSinkPrivate
+{
+public:
+    RotatingFileSinkPrivate(RotatingFileSink *q,
+                            int maxFileSize,
+                            int maxFileCount,
+                            RotatingFileSink::Options options)
+        : q_ptr(q)
+        , m_maxFileSize(maxFileSize)
+        , m_maxFileCount(maxFileCount)
+        , m_rotationOnStartup(options.testFlag(RotatingFileSink::RotationOnStartup))
+        , m_rotationDaily(options.testFlag(RotatingFileSink::RotationDaily))
+        , m_compression(options.testFlag(RotatingFileSink::Compression)
+                        || options.testFlag(RotatingFileSink::BlockCompression))
+        , m_blockCompression(options.testFlag(RotatingFileSink::BlockCompression))
     {
-        dest.append(applyPadding(QString::number(lmsg.threadId())));
+        // The block index takes the time of each block from the time index, the term index
+        // refers to its entries
+        if (options.testFlag(RotatingFileSink::TimeIndex) || m_blockCompression
+            || options.testFlag(RotatingFileSink::TermIndex)) {
+            m_timeIndex.reset(new TimeIndexWriter());
+        }
+
+        if (options.testFlag(RotatingFileSink::TermIndex))
+            m_termIndex.reset(new TermIndexWriter());
     }
 
-    size_t estimatedLength() const override
+    void init()
     {
-        return hasFormatSpec() ? formatWidth() : 10; // Maximum length of "9999999999"
+        if (m_initialized)
+            return;
+
+        m_initialized = true;
+
+        auto fi = QFileInfo(q_ptr->file()->fileName());
+        if (fi.exists() && fi.size() > 0) {
+            m_currentLogDate = fi.lastModified().date();
+        } else {
+            m_currentLogDate = QDate::currentDate();
+        }
+
+        if (m_rotationOnStartup) {
+            checkStartupRotation();
+        }
     }
-};
 
-class QThreadPtrToken : public FormattedToken
-{
-public:
-    QThreadPtrToken() { }
+    bool rotateIfNeeded(const LogMessage &lmsg, qint64 additionalSize)
+    {
+        const auto messageDate = lmsg.time().date();
+
+        bool rotated = false;
+
+        if (m_rotationDaily) {
+            rotated = checkDailyRotation(messageDate);
+        }
+
+        if (m_maxFileSize > 0) {
+            rotated = checkSizeRotation(additionalSize) || rotated;
+        }
+
+        return rotated;
+    }
 
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    void checkStartupRotation()
     {
-        QString value = QStringLiteral("0x") + QString::number(lmsg.qthreadptr(), 16);
-        dest.append(applyPadding(value));
+        if (q_ptr->file()->size() > 0) {
+            rotate();
+        }
     }
 
-    size_t estimatedLength() const override
+    bool checkDailyRotation(const QDate &messageDate)
     {
-        return hasFormatSpec() ? formatWidth() : 18; // "0x" + 16 hex digits for 64-bit pointer
+        if (messageDate != m_currentLogDate && q_ptr->file()->size() > 0) {
+            const auto rotated = rotate();
+            m_currentLogDate = messageDate;
+            return rotated;
+        }
+        return false;
     }
-};
 
-class AttributeToken : public FormattedToken
-{
-public:
-    explicit AttributeToken(const QString &attributeName, bool optional = false,
-                            int removeBefore = 0, int removeAfter = 0)
-        : m_attributeName(attributeName)
-        , m_optional(optional)
-        , m_removeBefore(removeBefore)
-        , m_removeAfter(removeAfter)
+    bool checkSizeRotation(qint64 additionalSize)
     {
+        if (m_maxFileSize <= 0)
+            return false;
+
+        const auto currentSize = q_ptr->file()->size();
+        if (currentSize > 0 && (currentSize + additionalSize) > m_maxFileSize) {
+            return rotate();
+        }
+        return false;
     }
 
-    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    // Called after the time index entry of the message was added, before the message is written
+    void addTerms(const LogMessage &lmsg, const QByteArray &data)
     {
-        if (lmsg.hasAttribute(m_attributeName)) {
-            dest.append(applyPadding(lmsg.attribute(m_attributeName).toString()));
-            return;
+        // Terms of a file that was already written to are unknown
+        if (q_ptr->file()->pos() == 0) {
+            m_termIndex->reset();
+            m_termIndexComplete = true;
         }
 
-        if (!m_optional) {
-            QString value = QStringLiteral("%{") + m_attributeName + QStringLiteral("}");
-            dest.append(applyPadding(value));
+        const auto rangeOffset = m_timeIndex->lastOffset();
+        if (rangeOffset < 0)
+            m_termIndexComplete = false;
+
+        if (!m_termIndexComplete)
             return;
-        }
 
-        // Optional attribute not found: remove characters before and add ZWSP markers for removeAfter
-        if (m_removeBefore > 0 && dest.size() >= m_removeBefore) {
-            dest.chop(m_removeBefore);
-        }
-        // Append ZWSP markers to signal how many chars to remove from next token
-        for (int i = 0; i < m_removeAfter; ++i) {
-            dest.append(DEL_MARKER);
-        }
+        // Text logs are searched line by line as UTF-8, whatever the formatter rendered
+        if (q_ptr->writesBinaryLog())
+            m_termIndex->add(lmsg, rangeOffset);
+        else
+            m_termIndex->addText(QString::fromUtf8(data), rangeOffset);
     }
 
-    size_t estimatedLength() const override
+    QString baseDir() const
     {
-        return hasFormatSpec() ? formatWidth() : 20; // Estimated average attribute value length
+        auto fi = QFileInfo(q_ptr->file()->fileName());
+        return fi.absolutePath();
     }
 
-private:
-    QString m_attributeName;
-    bool m_optional;
-    int m_removeBefore;
-    int m_removeAfter;
-};
+    QString generateRotatedFileName(const QDate &date, int index) const
+    {
+        auto fi = QFileInfo(q_ptr->file()->fileName());
+        const auto baseName = fi.completeBaseName();
+        const auto suffix = fi.suffix();
+        const auto dateStr = date.toString(QStringLiteral("yyyy-MM-dd"));
 
-} // namespace
+        QString rotatedName;
+        if (suffix.isEmpty()) {
+            rotatedName = QStringLiteral("%1.%2.%3").arg(baseName, dateStr).arg(index);
+        } else {
+            rotatedName = QStringLiteral("%1.%2.%3.%4").arg(baseName, dateStr).arg(index).arg(suffix);
+        }
 
-class PatternFormatter::PatternFormatterPrivate
-{
-public:
-    explicit PatternFormatterPrivate(const QString &pattern) : m_pattern(pattern)
+        return QDir(baseDir()).filePath(rotatedName);
+    }
+
+    int findNextIndexForDate(const QDate &date) const
     {
-        parsePattern();
+        auto fi = QFileInfo(q_ptr->file()->fileName());
+        const auto baseName = fi.completeBaseName();
+        const auto suffix = fi.suffix();
+        const auto dateStr = date.toString(QStringLiteral("yyyy-MM-dd"));
+
+        QString pattern;
+        if (suffix.isEmpty()) {
+            pattern = QStringLiteral("^%1\\.%2\\.(\\d+)(\\.gz)?$")
+                          .arg(QRegularExpression::escape(baseName),
+                               QRegularExpression::escape(dateStr));
+        } else {
+            pattern = QStringLiteral("^%1\\.%2\\.(\\d+)\\.%3(\\.gz)?$")
+                          .arg(QRegularExpression::escape(baseName),
+                               QRegularExpression::escape(dateStr),
+                               QRegularExpression::escape(suffix));
+        }
+
+        auto re = QRegularExpression(pattern);
+        auto dir = QDir(baseDir());
+        auto maxIndex = 0;
+
+        const auto entries = dir.entryList(QDir::Files);
+        for (const QString &entry : entries) {
+            auto match = re.match(entry);
+            if (match.hasMatch()) {
+                auto index = match.captured(1).toInt();
+                if (index > maxIndex) {
+                    maxIndex = index;
+                }
+            }
+        }
+
+        return maxIndex + 1;
     }
 
-    void parsePattern()
+    void compressFile(const QString &filePath)
     {
-        m_tokens.clear();
+        if (m_blockCompression) {
+            if (SeekableGzip::compress(filePath, m_compressionBlockSize))
+                QFile::remove(filePath);
+            return;
+        }
 
-        int pos = 0;
-        QString literalText;
-        QtMsgType currentCondition = QtDebugMsg;
-        bool hasCondition = false;
+        auto inputFile = QFile(filePath);
+        if (!inputFile.open(QIODevice::ReadOnly)) return;
 
-        while (pos < m_pattern.length()) {
-            if (pos < m_pattern.length() - 1 && m_pattern[pos] == '%') {
-                if (m_pattern[pos + 1] == '{') {
-                    if (!literalText.isEmpty()) {
-                        auto token = new LiteralToken(literalText);
-                        if (hasCondition) {
-                            token->setCondition(currentCondition);
-                        }
-                        m_tokens.append(QSharedPointer<Token>(token));
-                        literalText.clear();
-                    }
+        const auto compressedPath = filePath + QStringLiteral(".gz");
+        auto outputFile = QFile(compressedPath);
+        if (!outputFile.open(QIODevice::WriteOnly)) {
+            inputFile.close();
+            return;
+        }
 
-                    int closingPos = m_pattern.indexOf('}', pos + 2);
-                    if (closingPos == -1) {
-                        // No closing brace, treat as literal
-                        literalText.append('%');
-                        pos++;
-                        continue;
-                    }
+        outputFile.write(SeekableGzip::member(inputFile.readAll()));
 
-                    QString placeholder = m_pattern.mid(pos + 2, closingPos - pos - 2);
+        inputFile.close();
+        outputFile.close();
+        QFile::remove(filePath);
+    }
 
-                    std::optional<FormattedToken::FormatSpec> formatSpec;
+    QStringList findRotatedFiles() const
+    {
+        auto fi = QFileInfo(q_ptr->file()->fileName());
+        const auto baseName = fi.completeBaseName();
+        const auto suffix = fi.suffix();
 
-                    int lastColon = placeholder.lastIndexOf(QLatin1Char(':'));
-                    if (lastColon != -1 && lastColon < placeholder.length() - 1) {
-                        QString possibleSpec = placeholder.mid(lastColon + 1);
-                        formatSpec = FormattedToken::parseFormatSpec(possibleSpec);
-                        if (formatSpec) {
-                            placeholder = placeholder.left(lastColon);
-                        }
-                    }
+        QString pattern;
+        if (suffix.isEmpty()) {
+            pattern = QStringLiteral("^%1\\.\\d{4}-\\d{2}-\\d{2}\\.\\d+(\\.gz)?$")
+                          .arg(QRegularExpression::escape(baseName));
+        } else {
+            pattern = QStringLiteral("^%1\\.\\d{4}-\\d{2}-\\d{2}\\.\\d+\\.%2(\\.gz)?$")
+                          .arg(QRegularExpression::escape(baseName),
+                               QRegularExpression::escape(suffix));
+        }
 
-                    FormattedToken *token = nullptr;
+        auto re = QRegularExpression(pattern);
+        auto dir = QDir(baseDir());
+        auto result = QStringList();
 
-                    if (placeholder == QLatin1String("type")) {
-                        token = new TypeToken();
-                    } else if (placeholder == QLatin1String("line")) {
-                        token = new LineToken();
-                    } else if (placeholder == QLatin1String("file")) {
-                        token = new FileToken();
-                    } else if (placeholder == QLatin1String("shortfile")
-                               || placeholder.startsWith(QLatin1String("shortfile "))) {
-                        QString baseDir;
-                        if (placeholder.startsWith(QLatin1String("shortfile "))) {
-                            baseDir = placeholder.mid(10).trimmed();
-                        }
-                        token = new ShortFileToken(baseDir);
-                    } else if (placeholder == QLatin1String("function")) {
-                        token = new FunctionToken(false);
-                    } else if (placeholder == QLatin1String("func")) {
-                        token = new FunctionToken(true);
-                    } else if (placeholder == QLatin1String("category")) {
-                        token = new CategoryToken();
-                    } else if (placeholder == QLatin1String("time")
-                               || placeholder.startsWith(QLatin1String("time "))) {
-                        QString timeFormat;
-                        if (placeholder.startsWith(QLatin1String("time "))) {
-                            timeFormat = placeholder.mid(5).trimmed();
-                        }
-                        token = new TimeToken(timeFormat);
-                    } else if (placeholder == QLatin1String("threadid")) {
-                        token = new ThreadIdToken();
-                    } else if (placeholder == QLatin1String("qthreadptr")) {
-                        token = new QThreadPtrToken();
-                    } else if (placeholder == QLatin1String("message")) {
-                        token = new MessageToken();
-                    } else if (placeholder.startsWith(QLatin1String("if-"))) {
-                        // Handle conditional: %{if-debug}, %{if-warning}, etc.
-                        QString conditionType = placeholder.mid(3); // Remove "if-"
-                        currentCondition = stringToQtMsgType(conditionType, QtDebugMsg);
-                        hasCondition = true;
-                        pos = closingPos + 1;
-                        continue;
-                    } else if (placeholder == QLatin1String("endif")) {
-                        hasCondition = false;
-                        pos = closingPos + 1;
-                        continue;
-                    } else {
-                        // Try to handle as custom attribute: %{attr} or %{attr?[N][,M]}
-                        int questionPos = placeholder.indexOf(QLatin1Char('?'));
-                        if (questionPos != -1) {
-                            QString attrName = placeholder.left(questionPos);
-                            QString suffix = placeholder.mid(questionPos + 1); // after '?'
-                            int removeBefore = 0;
-                            int removeAfter = 0;
+        const auto entries = dir.entryList(QDir::Files, QDir::Name);
+        for (const QString &entry : entries) {
+            if (re.match(entry).hasMatch()) {
+                result.append(dir.filePath(entry));
+            }
+        }
 
-                            int commaPos = suffix.indexOf(QLatin1Char(','));
-                            if (commaPos == -1) {
-                                // Only removeBefore: %{attr?N}
-                                removeBefore = suffix.toInt();
-                            } else {
-                                // Both or only removeAfter: %{attr?N,M} or %{attr?,M}
-                                if (commaPos > 0) {
-                                    removeBefore = suffix.left(commaPos).toInt();
-                                }
-                                removeAfter = suffix.mid(commaPos + 1).toInt();
-                            }
-                            token = new AttributeToken(attrName, true, removeBefore, removeAfter);
-                        } else {
-                            token = new AttributeToken(placeholder);
-                        }
-                    }
+        std::sort(result.begin(), result.end(), [](const QString &a, const QString &b) {
+            return QFileInfo(a).lastModified() < QFileInfo(b).lastModified();
+        });
+
+        return result;
+    }
+
+    void removeOldFiles()
+    {
+        if (m_maxFileCount <= 0)
+            return;
 
-                    if (token) {
-                        if (hasCondition) {
-                            token->setCondition(currentCondition);
-                        }
-                        if (formatSpec) {
-                            token->setFormatSpec(*formatSpec);
-                        }
-                        m_tokens.append(QSharedPointer<Token>(token));
-                    }
+        auto rotatedFiles = findRotatedFiles();
 
-                    pos = closingPos + 1;
-                } else if (m_pattern[pos + 1] == '%') {
-                    // Escaped %, add single %
-                    literalText.append('%');
-                    pos += 2;
-                } else {
-                    // Just a regular %
-                    literalText.append('%');
-                    pos++;
-                }
-            } else {
-                literalText.append(m_pattern[pos]);
-                pos++;
+        while (rotatedFiles.size() > m_maxFileCount - 1) {
+            const QString &oldestFile = rotatedFiles.first();
+            if (!QFile::remove(oldestFile)) {
+                std::cerr << "RotatingFileSink: Failed to remove old log file: "
+                          << oldestFile.toStdString() << std::endl;
             }
-        }
 
-        if (!literalText.isEmpty()) {
-            auto token = new LiteralToken(literalText);
-            if (hasCondition) {
-                token->setCondition(currentCondition);
+            if (m_timeIndex) {
+                auto logFileName = oldestFile;
+                if (logFileName.endsWith(QStringLiteral(".gz"))) {
+                    QFile::remove(SeekableGzip::indexFileName(oldestFile));
+                    logFileName.chop(3);
+                }
+                QFile::remove(TimeIndex::indexFileName(logFileName));
+                QFile::remove(TermIndex::indexFileName(logFileName));
             }
-            m_tokens.append(QSharedPointer<Token>(token));
+
+            rotatedFiles.removeFirst();
         }
     }
 
-    QString format(const LogMessage &lmsg)
+    bool rotate()
     {
-        if (m_tokens.isEmpty()) {
-            return lmsg.message();
-        }
+        if (m_maxFileCount == 1)
+            return false;
 
-        size_t estimatedLength = 0;
-        for (const auto &token : std::as_const(m_tokens)) {
-            if (token->checkCondition(lmsg)) {
-                estimatedLength += token->estimatedLength();
+        const auto openMode = q_ptr->file()->isOpen()
+                ? q_ptr->file()->openMode()
+                : QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text;
+
+        q_ptr->file()->close();
+
+        if (m_timeIndex)
+            m_timeIndex->close();
+
+        const auto &currentFileName = q_ptr->file()->fileName();
+        const auto rotationDate = m_currentLogDate.isValid() ? m_currentLogDate : QDate::currentDate();
+        const auto nextIndex = findNextIndexForDate(rotationDate);
+        const auto rotatedFileName = generateRotatedFileName(rotationDate, nextIndex);
+
+        if (!QFile::rename(currentFileName, rotatedFileName)) {
+            std::cerr << "RotatingFileSink: Failed to rename log file from "
+                      << currentFileName.toStdString() << " to "
+                      << rotatedFileName.toStdString() << std::endl;
+        } else {
+            if (m_timeIndex) {
+                // Offsets of the index refer to the uncompressed file
+                const auto rotatedIndexFileName = TimeIndex::indexFileName(rotatedFileName);
+                QFile::remove(rotatedIndexFileName);
+                QFile::rename(TimeIndex::indexFileName(currentFileName), rotatedIndexFileName);
+            }
+
+            if (m_termIndex) {
+                const auto termIndexFileName = TermIndex::indexFileName(rotatedFileName);
+                QFile::remove(termIndexFileName);
+                if (m_termIndexComplete && m_termIndex->isComplete())
+                    m_termIndex->write(termIndexFileName);
             }
+
+            if (m_compression)
+                compressFile(rotatedFileName);
         }
 
-        QString result;
-        result.reserve(estimatedLength);
+        if (m_termIndex) {
+            m_termIndex->reset();
+            m_termIndexComplete = false;
+        }
 
-        for (const auto &token : std::as_const(m_tokens)) {
-            if (token->checkCondition(lmsg)) {
-                token->appendToString(lmsg, result);
-            }
+        removeOldFiles();
+
+        if (!q_ptr->file()->open(openMode)) {
+            std::cerr << "RotatingFileSink: Failed to reopen log file: "
+                      << currentFileName.toStdString() << std::endl;
         }
 
-        result.remove(DEL_MARKER);
+        m_currentLogDate = QDate::currentDate();
 
-        return result;
+        return true;
     }
 
-    QString m_pattern;
-    QList<QSharedPointer<Token>> m_tokens;
+    RotatingFileSink *q_ptr;
+
+    int m_maxFileSize;
+    int m_maxFileCount;
+    bool m_rotationOnStartup;
+    bool m_rotationDaily;
+    bool m_compression;
+    bool m_blockCompression;
+    int m_compressionBlockSize = SeekableGzip::DefaultBlockSize;
+
+    QScopedPointer<TimeIndexWriter> m_timeIndex;
+    QScopedPointer<TermIndexWriter> m_termIndex;
+    bool m_termIndexComplete = false;
+
+    QDate m_currentLogDate;
+    bool m_initialized = false;
 };
 
 QTLOGGER_DECL_SPEC
-PatternFormatter::PatternFormatter(const QString &pattern) : d(new PatternFormatterPrivate(pattern))
+RotatingFileSink::RotatingFileSink(const QString &path,
+                                   int maxFileSize,
+                                   int maxFileCount,
+                                   RotatingFileSink::Options options)
+    : FileSink(path)
+    , d(new RotatingFileSinkPrivate(this, maxFileSize, maxFileCount, options))
+{
+}
+
+QTLOGGER_DECL_SPEC
+RotatingFileSink::RotatingFileSink(const QString &path,
+                                   int maxFileSize,
+                                   int maxFileCount,
+                                   RotatingFileSink::Options options,
+                                   QIODevice::OpenMode openMode)
+    : FileSink(path, openMode)
+    , d(new RotatingFileSinkPrivate(this, maxFileSize, maxFileCount, options))
 {
 }
 
 QTLOGGER_DECL_SPEC
-PatternFormatter::~PatternFormatter() = default;
+RotatingFileSink::~RotatingFileSink() = default;
 
 QTLOGGER_DECL_SPEC
-QString PatternFormatter::format(const LogMessage &lmsg)
+void RotatingFileSink::send(const LogMessage &lmsg)
 {
-    return d->format(lmsg);
-}
+    // Neither written nor rotated if the file failed to open
+    if (!device() || !device()->isOpen())
+        return;
 
-} // namespace QtLogger
+    d->init();
 
-// prettyformatter.cpp
+    auto data = encode(lmsg);
 
-namespace QtLogger {
+    if (d->rotateIfNeeded(lmsg, data.size())) {
+        // The encoding may depend on the file contents, e.g. the header of a binary log
+        data = encode(lmsg);
+    }
+
+    // The file may have failed to reopen after a rotation
+    if (!device()->isOpen())
+        return;
+
+    if (d->m_timeIndex)
+        d->m_timeIndex->add(file()->fileName(), lmsg.time(), file()->pos());
+
+    if (d->m_termIndex)
+        d->addTerms(lmsg, data);
+
+    updateTextMode(lmsg);
+    device()->write(data);
+}
 
 QTLOGGER_DECL_SPEC
-PrettyFormatter::PrettyFormatter(bool colorize, int maxCategoryWidth)
-    : m_colorize(colorize), m_maxCategoryWidth(maxCategoryWidth)
+bool RotatingFileSink::flush()
 {
+    const auto flushed = FileSink::flush();
+    return (!d->m_timeIndex || d->m_timeIndex->flush()) && flushed;
 }
 
 QTLOGGER_DECL_SPEC
-QString PrettyFormatter::format(const LogMessage &lmsg)
+void RotatingFileSink::setCompressionBlockSize(int blockSize)
 {
-    static const QString timeFormat = QStringLiteral("dd.MM.yyyy hh:mm:ss");
-    static const QChar typeLetters[] = {
-        QLatin1Char(' '), QLatin1Char('W'), QLatin1Char('E'),
-        QLatin1Char('F'), QLatin1Char('I'), QLatin1Char('S')
-    };
+    d->m_compressionBlockSize = qMax(blockSize, 1);
+}
 
-    // ANSI color codes
-    static const QLatin1String reset("\033[0m");
-    static const QLatin1String darkGray("\033[90m");
-    static const QLatin1String bold("\033[1m");
-    static const QLatin1String green("\033[32m");
-    static const QLatin1String greenBold("\033[1;32m");
-    static const QLatin1String orange("\033[38;5;172m");
-    static const QLatin1String darkOrange("\033[38;5;208m");
-    static const QLatin1String redBold("\033[1;31m");
-    static const QLatin1String darkRedBold("\033[1;38;5;88m");
+QTLOGGER_DECL_SPEC
+bool RotatingFileSink::writesBinaryLog() const
+{
+    return false;
+}
 
-    static const QLatin1Char space(' ');
-    static const QLatin1Char bracketOpen('[');
-    static const QLatin1Char bracketClose(']');
-    static const QLatin1Char letterT('T');
+QTLOGGER_DECL_SPEC
+void RotatingFileSink::setTimeIndexInterval(int intervalBytes, int intervalMsecs)
+{
+    if (d->m_timeIndex)
+        d->m_timeIndex.reset(new TimeIndexWriter(intervalBytes, intervalMsecs));
+}
 
-    const auto type = lmsg.type();
-    const auto threadId = lmsg.threadId();
-    const auto categoryRaw = lmsg.category();
-    const bool isDefaultCategory = (qstrcmp(categoryRaw, "default") == 0);
+} // namespace QtLogger
 
-    // Pre-calculate category string once if needed
-    QString category;
-    if (!isDefaultCategory) {
-        category = QString::fromUtf8(categoryRaw);
+// sdjournalsink.cpp
+
+#ifdef QTLOGGER_SDJOURNAL
+
+#include <systemd/sd-journal.h>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+void SdJournalSink::send(const LogMessage &lmsg)
+{
+    auto priority = LOG_DEBUG;
+
+    switch (lmsg.type()) {
+    case QtDebugMsg:
+        priority = LOG_DEBUG;
+        break;
+    case QtWarningMsg:
+        priority = LOG_WARNING;
+        break;
+    case QtCriticalMsg:
+        priority = LOG_ERR;
+        break;
+    case QtFatalMsg:
+        priority = LOG_EMERG;
+        break;
+    case QtInfoMsg:
+        priority = LOG_INFO;
+        break;
+    default:
+        return;
     }
 
-    // Estimate result size to minimize reallocations
-    // DateTime(19) + space(1) + type(1) + space(1) + thread(~5) + category(~20) + message
-    const int estimatedSize = 30 + category.size() + 4 + lmsg.message().size()
-                              + (m_colorize ? 80 : 0);
+    const auto &file = QByteArrayLiteral("CODE_FILE=") + QByteArray(lmsg.file());
+    const auto &line = QByteArrayLiteral("CODE_LINE=") + QByteArray::number(lmsg.line());
 
-    QString result;
-    result.reserve(estimatedSize);
+    sd_journal_print_with_location(priority, file.constData(), line.constData(), lmsg.function(),
+                                   "%s", qPrintable(lmsg.formattedMessage()));
 
-    // DateTime
-    result += lmsg.time().toString(timeFormat);
-    result += space;
+    sd_journal_send_with_location(file.constData(), line.constData(), lmsg.function(), "%s",
+                                  qPrintable(lmsg.formattedMessage()), "PRIORITY=%i", priority,
+                                  "CATEGORY=%s", lmsg.category(), NULL);
+}
 
-    // Type letter with specific colors
-    if (m_colorize) {
-        switch (type) {
-        case QtInfoMsg:
-            result += greenBold;
-            result += typeLetters[type];
-            result += reset;
-            break;
-        case QtWarningMsg:
-            result += darkOrange;
-            result += typeLetters[type];
-            result += reset;
-            break;
-        case QtCriticalMsg:
-            result += redBold;
-            result += typeLetters[type];
-            result += reset;
-            break;
-        case QtFatalMsg:
-            result += darkRedBold;
-            result += typeLetters[type];
-            result += reset;
-            break;
-        default:
-            result += typeLetters[type];
-            break;
+} // namespace QtLogger
+
+#endif // QTLOGGER_SDJOURNAL
+
+// segmentedlogsink.cpp
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <algorithm>
+#include <iostream>
+
+namespace QtLogger {
+
+class SegmentedLogSink::SegmentedLogSinkPrivate
+{
+public:
+    // Continues the newest segment after its last complete record, or starts the first one
+    bool open()
+    {
+        if (!QDir().mkpath(path)) {
+            error = QStringLiteral("Can't create directory: %1").arg(path);
+            return false;
+        }
+
+        const auto bases = SegmentedLog::segments(path);
+        if (bases.isEmpty())
+            return startSegment(0);
+
+        const auto base = bases.last();
+        file.setFileName(SegmentedLog::segmentFileName(path, base));
+        if (!file.open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+            error = file.errorString();
+            return false;
+        }
+
+        // Written before the header
+        if (file.size() < SegmentedLog::HeaderSize) {
+            file.close();
+            return startSegment(base);
+        }
+
+        const auto header = file.read(SegmentedLog::HeaderSize);
+        if (!header.startsWith(SegmentedLog::Magic)
+            || static_cast<quint8>(header.at(4)) != SegmentedLog::Version) {
+            error = QStringLiteral("Invalid segment: %1").arg(file.fileName());
+            file.close();
+            return false;
         }
-    } else {
-        result += typeLetters[type];
-    }
 
-    result += space;
+        const auto size = file.size();
+        auto pos = static_cast<qint64>(SegmentedLog::HeaderSize);
+        auto count = 0;
 
-    // Thread handling with optimized lookup
-    auto it = m_threads.find(threadId);
-    if (it == m_threads.end()) {
-        it = m_threads.insert(threadId, m_threadsIndex++);
-    }
+        char number[SegmentedLog::RecordHeaderSize];
+        while (size - pos >= SegmentedLog::RecordHeaderSize && file.seek(pos)
+               && file.read(number, sizeof(number)) == sizeof(number)) {
+            const auto recordSize = qFromLittleEndian<quint32>(number);
+            if (recordSize == 0 || size - pos - SegmentedLog::RecordHeaderSize < recordSize)
+                break;
 
-    if (m_threads.size() > 1) {
-        const int index = it.value();
-        if (index == 0) {
-            // Calculate width needed for thread field
-            int threadWidth = 3; // "T0 " minimum
-            if (m_threadsIndex > 10) threadWidth = 4;
-            if (m_threadsIndex > 100) threadWidth = 5;
-            result += QString(threadWidth, space);
-        } else {
-            if (m_colorize) {
-                result += bold;
-            }
-            result += letterT;
-            result += QString::number(index);
-            result += space;
-            if (m_colorize) {
-                result += reset;
-            }
+            pos += SegmentedLog::RecordHeaderSize + recordSize;
+            ++count;
         }
-    }
 
-    // Category output (only if not default)
-    const int categoryFormatLength = isDefaultCategory ? 0 : (category.size() + 3); // "[name] "
-    if (!isDefaultCategory) {
-        if (m_colorize) {
-            result += darkGray;
-        }
-        result += bracketOpen;
-        result += category;
-        result += bracketClose;
-        result += space;
-        if (m_colorize) {
-            result += reset;
+        // A record cut short by a crash
+        if (pos < size) {
+            std::cerr << "SegmentedLogSink: Removing incomplete record at " << pos << " of "
+                      << file.fileName().toStdString() << std::endl;
+            file.resize(pos);
         }
+
+        file.seek(pos);
+        segmentBase = base;
+        nextOffset = base + count;
+
+        return true;
     }
 
-    // Space for alignment
-    if (m_maxCategoryWidth > 0) {
-        if (categoryFormatLength > m_categoryWidth) {
-            m_categoryWidth = qMin(categoryFormatLength, m_maxCategoryWidth);
+    bool startSegment(qint64 base)
+    {
+        file.close();
+        file.setFileName(SegmentedLog::segmentFileName(path, base));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+            error = file.errorString();
+            std::cerr << "SegmentedLogSink: Can't open segment: " << file.fileName().toStdString()
+                      << " error: " << error.toStdString() << std::endl;
+            return false;
         }
-        const int spaceCount = m_categoryWidth - categoryFormatLength;
-        if (spaceCount > 0) {
-            result += QString(spaceCount, space);
+
+        auto header = QByteArray(SegmentedLog::Magic, 4);
+        header.append(static_cast<char>(SegmentedLog::Version));
+        header.append(3, '\0');
+
+        char number[8];
+        qToLittleEndian(base, number);
+        header.append(number, 8);
+
+        if (file.write(header) != header.size()) {
+            error = file.errorString();
+            file.close();
+            return false;
         }
+
+        segmentBase = base;
+        nextOffset = base;
+
+        return true;
     }
 
-    // Message with color
-    if (m_colorize) {
-        switch (type) {
-        case QtInfoMsg:
-            result += green;
-            result += lmsg.message();
-            result += reset;
-            break;
-        case QtWarningMsg:
-            result += orange;
-            result += lmsg.message();
-            result += reset;
-            break;
-        case QtCriticalMsg:
-            result += redBold;
-            result += lmsg.message();
-            result += reset;
-            break;
-        case QtFatalMsg:
-            result += darkRedBold;
-            result += lmsg.message();
-            result += reset;
-            break;
-        default:
-            result += lmsg.message();
-            break;
-        }
-    } else {
-        result += lmsg.message();
+    QString path;
+    qint64 segmentSize;
+    qint64 maxSize;
+
+    QFile file;
+    QString error;
+    qint64 segmentBase = 0;
+    qint64 nextOffset = 0;
+
+    BinaryLogWriter writer;
+};
+
+QTLOGGER_DECL_SPEC
+SegmentedLogSink::SegmentedLogSink(const QString &path, qint64 segmentSize, qint64 maxSize)
+    : d(new SegmentedLogSinkPrivate)
+{
+    d->path = path;
+    d->segmentSize = qMax<qint64>(segmentSize, SegmentedLog::HeaderSize + 1);
+    d->maxSize = qMax<qint64>(maxSize, 0);
+
+    if (!d->open()) {
+        std::cerr << "SegmentedLogSink: Can't open log: " << path.toStdString()
+                  << " error: " << d->error.toStdString() << std::endl;
+        return;
     }
 
-    return result;
+    removeOldSegments();
 }
 
-} // namespace QtLogger
+QTLOGGER_DECL_SPEC
+SegmentedLogSink::~SegmentedLogSink() = default;
 
-// sentryformatter.cpp
+QTLOGGER_DECL_SPEC
+void SegmentedLogSink::send(const LogMessage &lmsg)
+{
+    if (!d->file.isOpen())
+        return;
 
-#include <QJsonArray>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QUuid>
+    // Every record is a session of its own, so it can be decoded from any offset
+    d->writer.reset();
+    const auto payload = d->writer.encode(lmsg);
 
-namespace QtLogger {
+    const auto recordSize = SegmentedLog::RecordHeaderSize + payload.size();
+    if (d->file.pos() > SegmentedLog::HeaderSize && d->file.pos() + recordSize > d->segmentSize) {
+        if (!d->startSegment(d->nextOffset))
+            return;
+        removeOldSegments();
+    }
 
-namespace {
+    QByteArray record;
+    record.reserve(recordSize);
+
+    char number[SegmentedLog::RecordHeaderSize];
+    qToLittleEndian(static_cast<quint32>(payload.size()), number);
+    record.append(number, sizeof(number));
+    record.append(payload);
+
+    const auto pos = d->file.pos();
+    if (d->file.write(record) != record.size()) {
+        std::cerr << "SegmentedLogSink: Can't write record: " << d->file.errorString().toStdString()
+                  << std::endl;
+
+        // Cut back to the last complete record, so the offsets stay consistent
+        d->file.resize(pos);
+        d->file.seek(pos);
+        return;
+    }
+
+    ++d->nextOffset;
+}
 
 QTLOGGER_DECL_SPEC
-QString qtMsgTypeToSentryLevel(QtMsgType type)
+bool SegmentedLogSink::isValid() const
 {
-    switch (type) {
-    case QtDebugMsg:
-        return QStringLiteral("debug");
-    case QtInfoMsg:
-        return QStringLiteral("info");
-    case QtWarningMsg:
-        return QStringLiteral("warning");
-    case QtCriticalMsg:
-        return QStringLiteral("error");
-    case QtFatalMsg:
-        return QStringLiteral("fatal");
-    default:
-        return QStringLiteral("info");
-    }
+    return d->file.isOpen();
 }
 
-} // namespace
+QTLOGGER_DECL_SPEC
+QString SegmentedLogSink::errorString() const
+{
+    return d->error;
+}
 
-SentryFormatter::SentryFormatter(const QString &sdkName, const QString &sdkVersion)
-    : m_sdkName(sdkName), m_sdkVersion(sdkVersion)
+QTLOGGER_DECL_SPEC
+QString SegmentedLogSink::path() const
 {
+    return d->path;
 }
 
 QTLOGGER_DECL_SPEC
-QString SentryFormatter::format(const LogMessage &lmsg)
+qint64 SegmentedLogSink::segmentSize() const
 {
-    QJsonObject event;
+    return d->segmentSize;
+}
 
-    // Required: Event ID (UUID without dashes)
-#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
-    auto eventId = QUuid::createUuid().toString(QUuid::Id128);
-#else
-    auto eventId = QUuid::createUuid().toString().remove(QLatin1Char('{')).remove(QLatin1Char('}')).remove(QLatin1Char('-'));
-#endif
-    event[QStringLiteral("event_id")] = eventId;
+QTLOGGER_DECL_SPEC
+qint64 SegmentedLogSink::maxSize() const
+{
+    return d->maxSize;
+}
 
-    // Required: Timestamp in ISO 8601 format
-    event[QStringLiteral("timestamp")] = lmsg.time().toUTC().toString(Qt::ISODate);
+QTLOGGER_DECL_SPEC
+qint64 SegmentedLogSink::nextOffset() const
+{
+    return d->nextOffset;
+}
 
-    // Platform
-    event[QStringLiteral("platform")] = QStringLiteral("native");
+QTLOGGER_DECL_SPEC
+void SegmentedLogSink::removeOldSegments()
+{
+    auto bases = SegmentedLog::segments(d->path);
 
-    // Severity level
-    event[QStringLiteral("level")] = qtMsgTypeToSentryLevel(lmsg.type());
+    // The current segment is never removed
+    bases.removeAll(d->segmentBase);
 
-    // Logger name (category)
-    auto category = QString::fromLatin1(lmsg.category());
-    if (!category.isEmpty() && category != QLatin1String("default")) {
-        event[QStringLiteral("logger")] = category;
-    }
+    const auto committed = SegmentedLog::committedOffsets(d->path);
+    if (!committed.isEmpty()) {
+        const auto slowest = *std::min_element(committed.cbegin(), committed.cend());
 
-    // Message
-    QJsonObject message;
-    message[QStringLiteral("formatted")] = lmsg.message();
-    event[QStringLiteral("message")] = message;
+        // A segment is read when the next one starts at or before the slowest cursor
+        while (!bases.isEmpty()) {
+            const auto end = bases.size() > 1 ? bases.at(1) : d->segmentBase;
+            if (end > slowest)
+                break;
 
-    // Transaction/culprit (function name)
-    if (lmsg.function() && strlen(lmsg.function()) > 0) {
-        event[QStringLiteral("culprit")] = QString::fromLatin1(lmsg.function());
+            QFile::remove(SegmentedLog::segmentFileName(d->path, bases.takeFirst()));
+        }
     }
 
-    // Tags
-    QJsonObject tags;
-    tags[QStringLiteral("qt_version")] = QString::fromLatin1(qVersion());
-    if (lmsg.hasAttribute(QStringLiteral("appname"))) {
-        tags[QStringLiteral("app_name")] = lmsg.attribute(QStringLiteral("appname")).toString();
-    }
-    if (lmsg.hasAttribute(QStringLiteral("appversion"))) {
-        tags[QStringLiteral("app_version")] = lmsg.attribute(QStringLiteral("appversion")).toString();
+    if (d->maxSize == 0)
+        return;
+
+    auto totalSize = d->file.size();
+    QList<qint64> sizes;
+    for (const auto base : std::as_const(bases)) {
+        sizes.append(QFileInfo(SegmentedLog::segmentFileName(d->path, base)).size());
+        totalSize += sizes.last();
     }
-    event[QStringLiteral("tags")] = tags;
 
-    // Extra context
-    QJsonObject extra;
-    extra[QStringLiteral("line")] = lmsg.line();
-    if (lmsg.file() && strlen(lmsg.file()) > 0) {
-        extra[QStringLiteral("file")] = QString::fromLatin1(lmsg.file());
+    while (!bases.isEmpty() && totalSize > d->maxSize) {
+        totalSize -= sizes.takeFirst();
+        QFile::remove(SegmentedLog::segmentFileName(d->path, bases.takeFirst()));
     }
-    extra[QStringLiteral("thread_id")] = QString::number(lmsg.threadId());
+}
 
-    // Add custom attributes to extra
-    const auto attrs = lmsg.attributes();
-    for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
-        // Skip already handled attributes
-        if (it.key() == QLatin1String("appname") || it.key() == QLatin1String("appversion")
-            || it.key() == QLatin1String("os_name") || it.key() == QLatin1String("os_version")
-            || it.key() == QLatin1String("kernel_version") || it.key() == QLatin1String("build_abi")
-            || it.key() == QLatin1String("cpu_arch") || it.key() == QLatin1String("host_name")) {
-            continue;
+} // namespace QtLogger
+
+// sharedmemorysink.cpp
+
+#ifndef QT_NO_SHAREDMEMORY
+
+#include <QCoreApplication>
+#include <QSharedMemory>
+
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#if defined(Q_OS_WIN)
+#    include <qt_windows.h>
+#else
+#    include <cerrno>
+#    include <signal.h>
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+quint64 writerPid(quint64 token)
+{
+    return token >> 32;
+}
+
+bool isProcessAlive(quint64 pid)
+{
+#if defined(Q_OS_WIN)
+    const auto process = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    if (!process)
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    const auto alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+} // namespace
+
+class SharedMemorySink::SharedMemorySinkPrivate
+{
+public:
+    SharedMemorySinkPrivate(const QString &key, int slotCount, int slotSize)
+        : memory(key),
+          slotCount(qMax(slotCount, 1)),
+          // Slots are 8-byte aligned for the atomic state
+          slotSize((qMax(slotSize, SharedMemoryRing::SlotHeaderSize + 8) + 7) & ~7)
+    {
+        const auto size = SharedMemoryRing::segmentSize(this->slotCount, this->slotSize);
+
+        bool created = memory.create(static_cast<int>(size));
+        if (!created) {
+            if (memory.error() != QSharedMemory::AlreadyExists || !memory.attach()) {
+                error = memory.errorString();
+                std::cerr << "SharedMemorySink: " << qPrintable(error) << std::endl;
+                return;
+            }
+            if (memory.size() < size) {
+                error = QStringLiteral("Existing shared memory segment is too small");
+                std::cerr << "SharedMemorySink: " << qPrintable(error) << std::endl;
+                memory.detach();
+                return;
+            }
         }
-        extra[it.key()] = QJsonValue::fromVariant(it.value());
-    }
-    event[QStringLiteral("extra")] = extra;
 
-    // Contexts
-    QJsonObject contexts;
+        base = static_cast<char *>(memory.data());
+        header = reinterpret_cast<SharedMemoryRing::Header *>(base);
 
-    // OS context (from SysInfoAttrs)
-    QJsonObject osContext;
-    if (lmsg.hasAttribute(QStringLiteral("os_name"))) {
-        osContext[QStringLiteral("name")] = lmsg.attribute(QStringLiteral("os_name")).toString();
-    }
-    if (lmsg.hasAttribute(QStringLiteral("os_version"))) {
-        osContext[QStringLiteral("version")] = lmsg.attribute(QStringLiteral("os_version")).toString();
-    }
-    if (lmsg.hasAttribute(QStringLiteral("kernel_version"))) {
-        osContext[QStringLiteral("kernel_version")] = lmsg.attribute(QStringLiteral("kernel_version")).toString();
-    }
-    if (lmsg.hasAttribute(QStringLiteral("build_abi"))) {
-        osContext[QStringLiteral("build")] = lmsg.attribute(QStringLiteral("build_abi")).toString();
+        // Writers starting at the same time initialize the segment one after another
+        memory.lock();
+
+        const auto isRing = !created && header->magic == SharedMemoryRing::Magic
+                && header->version == SharedMemoryRing::Version;
+
+        if (isRing && !claim()) {
+            error = QStringLiteral("Shared memory ring is in use by another writer (pid %1)")
+                            .arg(writerPid(header->writer.load(std::memory_order_relaxed)));
+            std::cerr << "SharedMemorySink: " << qPrintable(error) << std::endl;
+            memory.unlock();
+            memory.detach();
+            header = nullptr;
+            return;
+        }
+
+        // The ring of a previous writer with the same layout is continued, so that its readers
+        // keep their positions
+        if (!isRing || header->slotCount != static_cast<quint32>(this->slotCount)
+            || header->slotSize != static_cast<quint32>(this->slotSize)) {
+            std::memset(base, 0, static_cast<size_t>(size));
+            header = new (base) SharedMemoryRing::Header();
+            header->slotCount = static_cast<quint32>(this->slotCount);
+            header->slotSize = static_cast<quint32>(this->slotSize);
+            header->writer.store(token, std::memory_order_relaxed);
+            header->version = SharedMemoryRing::Version;
+            header->magic = SharedMemoryRing::Magic;
+        }
+
+        memory.unlock();
     }
-    if (!osContext.isEmpty()) {
-        contexts[QStringLiteral("os")] = osContext;
+
+    ~SharedMemorySinkPrivate()
+    {
+        if (!header)
+            return;
+
+        auto expected = token;
+        header->writer.compare_exchange_strong(expected, 0, std::memory_order_release,
+                                               std::memory_order_relaxed);
     }
 
-    // Device context
-    QJsonObject deviceContext;
-    if (lmsg.hasAttribute(QStringLiteral("cpu_arch"))) {
-        deviceContext[QStringLiteral("arch")] = lmsg.attribute(QStringLiteral("cpu_arch")).toString();
+    // Sinks created in this process, the lower half of their writer tokens
+    static std::atomic<quint32> &writerCount()
+    {
+        static std::atomic<quint32> count { 0 };
+        return count;
     }
-    if (lmsg.hasAttribute(QStringLiteral("host_name"))) {
-        deviceContext[QStringLiteral("name")] = lmsg.attribute(QStringLiteral("host_name")).toString();
+
+    static bool isWriterAlive(quint64 owner)
+    {
+        const auto pid = writerPid(owner);
+
+        // A token of this process that wasn't issued yet was left by an earlier process with the
+        // same id, the sinks of this process clear their tokens when destroyed
+        if (pid == static_cast<quint64>(QCoreApplication::applicationPid()))
+            return (owner & 0xffffffff) <= writerCount().load(std::memory_order_relaxed);
+
+        return isProcessAlive(pid);
     }
-    if (!deviceContext.isEmpty()) {
-        contexts[QStringLiteral("device")] = deviceContext;
+
+    // Takes over the ring if it has no writer or its writer is gone
+    bool claim()
+    {
+        auto owner = header->writer.load(std::memory_order_acquire);
+        while (owner == 0 || !isWriterAlive(owner)) {
+            if (header->writer.compare_exchange_weak(owner, token, std::memory_order_acq_rel,
+                                                     std::memory_order_acquire))
+                return true;
+        }
+        return false;
     }
 
-    // Runtime context
-    QJsonObject runtimeContext;
-    runtimeContext[QStringLiteral("name")] = QStringLiteral("Qt");
-    runtimeContext[QStringLiteral("version")] = QString::fromLatin1(qVersion());
-    contexts[QStringLiteral("runtime")] = runtimeContext;
+    void write(const QByteArray &data)
+    {
+        const auto payloadSize = static_cast<quint32>(slotSize - SharedMemoryRing::SlotHeaderSize);
+        const auto size = static_cast<quint32>(data.size());
+        const auto slots = qMax<quint32>(1, (size + payloadSize - 1) / payloadSize);
+
+        if (slots > static_cast<quint32>(slotCount)) {
+            header->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
 
-    event[QStringLiteral("contexts")] = contexts;
+        // Only this writer changes head and nextRecord
+        const auto head = header->head.load(std::memory_order_relaxed);
+        const auto record = header->nextRecord.load(std::memory_order_relaxed);
 
-    // SDK info
-    QJsonObject sdk;
-    sdk[QStringLiteral("name")] = m_sdkName;
-    sdk[QStringLiteral("version")] = m_sdkVersion;
-    event[QStringLiteral("sdk")] = sdk;
+        for (quint32 i = 0; i < slots; ++i) {
+            const auto n = head + i;
+            auto *slot = slotAt(n);
 
-    // Fingerprint (for grouping similar events)
-    QJsonArray fingerprint;
-    fingerprint.append(qtMsgTypeToSentryLevel(lmsg.type()));
-    fingerprint.append(category.isEmpty() ? QStringLiteral("default") : category);
-    fingerprint.append(lmsg.message().left(100)); // First 100 chars of message
-    event[QStringLiteral("fingerprint")] = fingerprint;
+            slot->state.store(2 * n + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
 
-    return QString::fromUtf8(QJsonDocument(event).toJson(QJsonDocument::Compact));
-}
+            slot->record = record;
+            slot->size = size;
+            slot->slots = i == 0 ? slots : 0;
 
-} // namespace QtLogger
+            const auto offset = i * payloadSize;
+            std::memcpy(reinterpret_cast<char *>(slot) + SharedMemoryRing::SlotHeaderSize,
+                        data.constData() + offset, qMin(payloadSize, size - offset));
 
-// logger.cpp
+            slot->state.store(2 * n + 2, std::memory_order_release);
+        }
 
-#include <QFileInfo>
-#include <QLoggingCategory>
-#include <QScopedPointer>
+        header->nextRecord.store(record + 1, std::memory_order_relaxed);
+        header->head.store(head + slots, std::memory_order_release);
+    }
 
-#ifndef QTLOGGER_NO_THREAD
-#    include <QAtomicPointer>
-#    include <QMutexLocker>
-#endif
+    SharedMemoryRing::Slot *slotAt(quint64 n) const
+    {
+        return reinterpret_cast<SharedMemoryRing::Slot *>(
+                base + SharedMemoryRing::HeaderSize
+                + (n % static_cast<quint64>(slotCount)) * static_cast<quint64>(slotSize));
+    }
 
-namespace QtLogger {
+    QSharedMemory memory;
+    QString error;
 
-namespace {
+    const quint64 token = static_cast<quint64>(QCoreApplication::applicationPid()) << 32
+            | (writerCount().fetch_add(1, std::memory_order_relaxed) + 1);
 
-#ifndef QTLOGGER_NO_THREAD
-QAtomicPointer<Logger> g_activeLogger;
-#else
-Logger *g_activeLogger = nullptr;
-#endif
+    const int slotCount;
+    const int slotSize;
 
-QtMessageHandler g_previousMessageHandler = nullptr;
+    char *base = nullptr;
+    SharedMemoryRing::Header *header = nullptr;
 
-}
+    BinaryLogWriter writer;
+};
 
 QTLOGGER_DECL_SPEC
-Logger *Logger::instance()
+SharedMemorySink::SharedMemorySink(const QString &key, int slotCount, int slotSize)
+    : d(new SharedMemorySinkPrivate(key, slotCount, slotSize))
 {
-    static QScopedPointer<Logger> s_instance;
+}
 
-    if (!s_instance) {
-        s_instance.reset(new Logger());
-    }
+QTLOGGER_DECL_SPEC
+SharedMemorySink::~SharedMemorySink() = default;
 
-    return s_instance.data();
+QTLOGGER_DECL_SPEC
+void SharedMemorySink::send(const LogMessage &lmsg)
+{
+    if (!d->header)
+        return;
+
+    // Every record is a session of its own, so it can be decoded after older records were lost
+    d->writer.reset();
+    d->write(d->writer.encode(lmsg));
 }
 
 QTLOGGER_DECL_SPEC
-Logger::~Logger()
+bool SharedMemorySink::isValid() const
 {
-#ifndef QTLOGGER_NO_THREAD
-    g_activeLogger.testAndSetOrdered(this, nullptr);
-#else
-    if (g_activeLogger == this) {
-        g_activeLogger = nullptr;
-    }
-#endif
+    return d->header != nullptr;
 }
 
 QTLOGGER_DECL_SPEC
-void Logger::configure(const QString &path, int maxFileSize, int maxFileCount,
-                       RotatingFileSink::Options options, bool async)
+QString SharedMemorySink::errorString() const
 {
-    QtLogger::configure(this, path, maxFileSize, maxFileCount, options, async);
-
-    installMessageHandler();
+    return d->error;
 }
 
 QTLOGGER_DECL_SPEC
-void Logger::configure(const QSettings &settings, const QString &group)
+QString SharedMemorySink::key() const
 {
-    QtLogger::configure(this, settings, group);
+    return d->memory.key();
+}
 
-    installMessageHandler();
+QTLOGGER_DECL_SPEC
+int SharedMemorySink::slotCount() const
+{
+    return d->slotCount;
 }
 
 QTLOGGER_DECL_SPEC
-void Logger::configureFromIniFile(const QString &path, const QString &group)
+int SharedMemorySink::slotSize() const
 {
-    configure(QSettings(path, QSettings::IniFormat), group);
+    return d->slotSize;
 }
 
 QTLOGGER_DECL_SPEC
-Logger &Logger::operator<<(const HandlerPtr &handler)
+quint64 SharedMemorySink::dropped() const
 {
-    append(handler);
-    return *this;
+    return d->header ? d->header->dropped.load(std::memory_order_relaxed) : 0;
 }
 
+} // namespace QtLogger
+
+#endif // QT_NO_SHAREDMEMORY
+
+// signalsink.cpp
+
+namespace QtLogger {
+
 QTLOGGER_DECL_SPEC
-void Logger::processMessage(QtMsgType type, const QMessageLogContext &context,
-                            const QString &message)
+SignalSink::SignalSink(QObject *parent) : QObject(parent) { }
+
+QTLOGGER_DECL_SPEC
+void SignalSink::send(const LogMessage &lmsg)
 {
+    Q_EMIT message(lmsg);
+}
+
+} // namespace QtLogger
+
+// sinkthread.cpp
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QList>
+
 #ifndef QTLOGGER_NO_THREAD
-    QMutexLocker locker(mutex());
+#    include <QMutex>
+#    include <QMutexLocker>
+#    include <QSemaphore>
+#    include <QThread>
+#    include <QWaitCondition>
 #endif
 
-    LogMessage lmsg(type, context, message);
-    process(lmsg);
+namespace QtLogger {
+
+#ifndef QTLOGGER_NO_THREAD
+namespace {
+
+QEvent::Type sinkThreadEventType()
+{
+    static const auto type = static_cast<QEvent::Type>(QEvent::registerEventType());
+    return type;
 }
 
-QTLOGGER_DECL_SPEC
-void Logger::messageHandler(QtMsgType type, const QMessageLogContext &context,
-                            const QString &message)
+class SinkThreadContext : public QObject
 {
-#ifndef QTLOGGER_NO_THREAD
-    auto logger = g_activeLogger.loadAcquire();
-#else
-    auto logger = g_activeLogger;
+public:
+    explicit SinkThreadContext(std::function<void()> drain) : m_drain(std::move(drain)) { }
+
+protected:
+    void customEvent(QEvent *event) override
+    {
+        if (event->type() == sinkThreadEventType())
+            m_drain();
+    }
+
+private:
+    std::function<void()> m_drain;
+};
+
+class SinkThreadRunner : public QThread
+{
+public:
+    explicit SinkThreadRunner(std::function<void()> body) : m_body(std::move(body)) { }
+
+    int loop() { return exec(); }
+
+protected:
+    void run() override { m_body(); }
+
+private:
+    std::function<void()> m_body;
+};
+
+} // namespace
 #endif
 
-    if (!logger)
-        return;
+class SinkThread::SinkThreadPrivate
+{
+public:
+    QObject *context = nullptr;
 
-    logger->processMessage(type, context, message);
-}
+#ifndef QTLOGGER_NO_THREAD
+    // Queues the function and starts the thread for the first one, fails once it is stopped
+    bool enqueue(std::function<void()> &function)
+    {
+        QMutexLocker locker(&mutex);
+
+        if (!thread)
+            start();
+
+        if (!running)
+            return false;
+
+        functions.append(std::move(function));
+
+        // One event wakes the event loop for all functions queued until they are run
+        if (!eventLoop) {
+            wakeUp.wakeOne();
+        } else if (!scheduled) {
+            scheduled = true;
+            QCoreApplication::postEvent(context, new QEvent(sinkThreadEventType()));
+        }
+
+        return true;
+    }
+
+    // Called with the mutex locked, returns when the context is created in the thread
+    void start()
+    {
+        running = true;
+        attach();
+
+        thread = new SinkThreadRunner([this] { work(); });
+        thread->setObjectName(name);
+        thread->start();
+        started.acquire();
+    }
+
+    // Called with the mutex locked. Events aren't delivered without the application, so until it
+    // exists and after it is destroyed the thread waits for the functions instead.
+    void attach()
+    {
+        if (!qApp || detached)
+            return;
+
+        eventLoop = true;
+        appDestroyed = QObject::connect(qApp, &QObject::destroyed, [this] {
+            {
+                QMutexLocker locker(&mutex);
+                eventLoop = false;
+                detached = true;
+                scheduled = false;
+                wakeUp.wakeOne();
+            }
+            thread->quit();
+        });
+    }
+
+    // The body of the thread
+    void work()
+    {
+        context = new SinkThreadContext([this] { drain(); });
+        started.release();
+
+        for (;;) {
+            bool loop = false;
+            {
+                QMutexLocker locker(&mutex);
+                while (running && !eventLoop && functions.isEmpty()) {
+                    wakeUp.wait(&mutex);
+
+                    // The application may have been created after the thread was started
+                    if (running)
+                        attach();
+                }
+
+                // The functions queued before stop() are still run
+                if (!running && functions.isEmpty())
+                    break;
+
+                loop = running && eventLoop;
+                if (loop && !scheduled && !functions.isEmpty()) {
+                    scheduled = true;
+                    QCoreApplication::postEvent(context, new QEvent(sinkThreadEventType()));
+                }
+            }
+
+            // Returns when the thread is stopped or the application is destroyed
+            if (loop)
+                static_cast<SinkThreadRunner *>(thread)->loop();
+            else
+                drain();
+        }
+
+        // The objects of the sink are destroyed in the thread they belong to
+        delete context;
+        context = nullptr;
+    }
+
+    void drain()
+    {
+        QList<std::function<void()>> batch;
+        {
+            QMutexLocker locker(&mutex);
+            batch.swap(functions);
+            scheduled = false;
+        }
+
+        for (const auto &function : std::as_const(batch)) {
+            function();
+        }
+    }
+
+    QString name;
+    QThread *thread = nullptr;
+    QSemaphore started;
+    QMetaObject::Connection appDestroyed;
+
+    QMutex mutex;
+    QWaitCondition wakeUp;
+    QList<std::function<void()>> functions;
+    bool eventLoop = false;
+    bool detached = false;
+    bool scheduled = false;
+    bool running = false;
+#endif
+};
 
 QTLOGGER_DECL_SPEC
-void Logger::installMessageHandler()
+SinkThread::SinkThread(const QString &name) : d(new SinkThreadPrivate)
 {
 #ifndef QTLOGGER_NO_THREAD
-    g_activeLogger.storeRelease(this);
+    d->name = name;
 #else
-    g_activeLogger = this;
+    Q_UNUSED(name)
+    d->context = new QObject();
 #endif
-
-    auto prev = qInstallMessageHandler(messageHandler);
-
-    if (prev != messageHandler) {
-        g_previousMessageHandler = prev;
-    }
 }
 
 QTLOGGER_DECL_SPEC
-void Logger::restorePreviousMessageHandler()
+SinkThread::~SinkThread()
 {
-    if (!g_previousMessageHandler)
-        return;
-
-    auto prev = qInstallMessageHandler(g_previousMessageHandler);
+    stop();
 
-    if (prev != messageHandler) {
-        qInstallMessageHandler(prev);
-    }
+#ifndef QTLOGGER_NO_THREAD
+    delete d->thread;
+#else
+    delete d->context;
+#endif
+}
 
-    g_previousMessageHandler = nullptr;
+QTLOGGER_DECL_SPEC
+QObject *SinkThread::context() const
+{
+    return d->context;
 }
 
+QTLOGGER_DECL_SPEC
+void SinkThread::post(std::function<void()> function)
+{
 #ifndef QTLOGGER_NO_THREAD
+    d->enqueue(function);
+#else
+    function();
+#endif
+}
 
 QTLOGGER_DECL_SPEC
-void Logger::lock() const
+void SinkThread::run(const std::function<void()> &function)
 {
-    mutex()->lock();
+#ifndef QTLOGGER_NO_THREAD
+    if (QThread::currentThread() == d->thread) {
+        function();
+        return;
+    }
+
+    QSemaphore done;
+    std::function<void()> task = [&function, &done] {
+        function();
+        done.release();
+    };
+
+    if (d->enqueue(task))
+        done.acquire();
+#else
+    function();
+#endif
 }
 
 QTLOGGER_DECL_SPEC
-void Logger::unlock() const
+void SinkThread::stop()
 {
-    mutex()->unlock();
+#ifndef QTLOGGER_NO_THREAD
+    {
+        QMutexLocker locker(&d->mutex);
+        if (!d->running || QThread::currentThread() == d->thread)
+            return;
+
+        d->running = false;
+        d->wakeUp.wakeOne();
+    }
+
+    QObject::disconnect(d->appDestroyed);
+
+    d->thread->quit();
+    d->thread->wait();
+#endif
 }
 
+} // namespace QtLogger
+
+// sqlitesink.cpp
+
+#ifdef QTLOGGER_SQL
+
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThread>
+#include <QTimer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
 #endif
 
-} // namespace QtLogger
+#include <chrono>
+#include <iostream>
+
+namespace QtLogger {
 
-// pipeline.cpp
+namespace {
 
-namespace QtLogger {
+// Freed pages are returned to the file system at most once a minute, pages freed in between are
+// reused by new rows
+constexpr int SqliteVacuumInterval = 60000; // ms
+
+const char *const SqliteSchema[] = {
+    "CREATE TABLE IF NOT EXISTS logs ("
+    "id INTEGER PRIMARY KEY, "
+    "time INTEGER NOT NULL, "
+    "level TEXT NOT NULL, "
+    "category TEXT, "
+    "file TEXT, "
+    "line INTEGER, "
+    "function TEXT, "
+    "thread INTEGER, "
+    "message TEXT, "
+    "attributes TEXT)",
+    "CREATE INDEX IF NOT EXISTS logs_time ON logs (time)",
+    "CREATE INDEX IF NOT EXISTS logs_level ON logs (level)",
+    "CREATE INDEX IF NOT EXISTS logs_category ON logs (category)",
+};
 
-QTLOGGER_DECL_SPEC
-Pipeline::Pipeline(std::initializer_list<HandlerPtr> handlers, bool scoped)
-    : m_handlers(handlers), m_scoped(scoped)
+QVariant sqliteText(const char *str)
 {
+    return str ? QVariant(QString::fromUtf8(str)) : QVariant();
 }
 
-QTLOGGER_DECL_SPEC
-void Pipeline::append(const HandlerPtr &handler)
-{
-    if (handler.isNull())
-        return;
-
-    m_handlers.append(handler);
-}
+} // namespace
 
-QTLOGGER_DECL_SPEC
-void Pipeline::append(std::initializer_list<HandlerPtr> handlers)
+class SqliteSink::SqliteSinkPrivate
 {
-    m_handlers.append(handlers);
-}
+public:
+    enum State { Closed, Open, Failed };
 
-QTLOGGER_DECL_SPEC
-void Pipeline::remove(const HandlerPtr &handler)
-{
-    if (handler.isNull())
-        return;
+    explicit SqliteSinkPrivate(const QString &fileName) : fileName(fileName) { }
 
-    m_handlers.removeAll(handler);
-}
+    ~SqliteSinkPrivate()
+    {
+        thread.run([this] {
+            commit();
+            close();
+        });
+        thread.stop();
+    }
 
-QTLOGGER_DECL_SPEC
-void Pipeline::clear()
-{
-    m_handlers.clear();
-}
+    // Rows are queued in the calling thread, a complete batch is committed before send() returns
+    void send(const LogMessage &lmsg)
+    {
+        if (!ensureDatabase())
+            return;
 
-QTLOGGER_DECL_SPEC
-Pipeline &Pipeline::operator<<(const HandlerPtr &handler)
-{
-    append(handler);
-    return *this;
-}
+        bool commitNow = false;
+        bool scheduleTimer = false;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            const auto now = std::chrono::steady_clock::now();
+            if (pending.isEmpty())
+                batchStart = now;
 
-QTLOGGER_DECL_SPEC
-bool Pipeline::process(LogMessage &lmsg)
-{
-    QString fmsg;
-    QVariantHash attrs;
+            pending.append(lmsg);
 
-    if (m_scoped) {
-        if (lmsg.isFormatted()) {
-            fmsg = lmsg.formattedMessage();
+            commitNow = pending.size() >= batchSize
+                    || now - batchStart >= std::chrono::milliseconds(batchInterval);
+
+            scheduleTimer = !commitNow && !timerScheduled;
+            if (scheduleTimer)
+                timerScheduled = true;
         }
-        attrs = lmsg.attributes();
-    }
 
-    for (auto &handler : m_handlers) {
-        if (!handler)
-            continue;
-        if (!handler->process(lmsg))
-            break;
+        if (commitNow)
+            thread.run([this] { commit(); });
+        else if (scheduleTimer)
+            thread.post([this] { startTimer(); });
     }
 
-    if (m_scoped) {
-        lmsg.setFormattedMessage(fmsg);
-        lmsg.setAttributes(attrs);
+    bool flush()
+    {
+        bool result = true;
+        thread.run([this, &result] { result = commit(); });
+        return result;
     }
 
-    return true;
-}
+    QString fileName;
+    int batchSize = DefaultBatchSize;
+    int batchInterval = DefaultBatchInterval;
+    qint64 maxRowCount = 0;
+    int maxAge = 0;
 
-} // namespace QtLogger
+    QAtomicInt state { Closed };
 
-// simplepipeline.cpp
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    SinkThread thread { QStringLiteral("SqliteSink") };
 
-#include <QCoreApplication>
+private:
+    // The database is opened once in the thread of the sink, the calling thread waits for it
+    bool ensureDatabase()
+    {
+        const auto current = state.loadAcquire();
+        if (current != Closed)
+            return current == Open;
 
-#ifdef QTLOGGER_NETWORK
+        thread.run([this] {
+            if (state.loadAcquire() != Closed)
+                return;
 
-#endif
+            if (open()) {
+                state.storeRelease(Open);
+            } else {
+                close();
+                state.storeRelease(Failed);
+            }
+        });
 
-#ifdef QTLOGGER_SYSLOG
+        return state.loadAcquire() == Open;
+    }
 
+    // The connection, the statement and the timer are used only in the thread of the sink
+    bool commit()
+    {
+        QList<LogMessage> rows;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
 #endif
+            rows.swap(pending);
+        }
 
-#ifdef QTLOGGER_ANDROIDLOG
+        if (rows.isEmpty() || !insertQuery)
+            return true;
 
-#endif
+        if (timer)
+            timer->stop();
 
-#ifdef QTLOGGER_OSLOG
+        if (!db.transaction()) {
+            printError("Failed to begin transaction", db.lastError());
+            return false;
+        }
 
-#endif
+        for (const auto &lmsg : std::as_const(rows)) {
+            const auto attrs = lmsg.attributes();
+
+            insertQuery->bindValue(0, lmsg.time().toMSecsSinceEpoch());
+            insertQuery->bindValue(1, qtMsgTypeToString(lmsg.type()));
+            insertQuery->bindValue(2, sqliteText(lmsg.category()));
+            insertQuery->bindValue(3, sqliteText(lmsg.file()));
+            insertQuery->bindValue(4, lmsg.file() ? QVariant(lmsg.line()) : QVariant());
+            insertQuery->bindValue(5, sqliteText(lmsg.function()));
+            insertQuery->bindValue(6, static_cast<qint64>(lmsg.threadId()));
+            insertQuery->bindValue(7, lmsg.message());
+            insertQuery->bindValue(
+                    8,
+                    attrs.isEmpty()
+                            ? QVariant()
+                            : QVariant(QString::fromUtf8(
+                                      QJsonDocument(QJsonObject::fromVariantHash(attrs))
+                                              .toJson(QJsonDocument::Compact))));
+
+            if (!insertQuery->exec()) {
+                printError("Failed to insert row", insertQuery->lastError());
+                db.rollback();
+                return false;
+            }
+        }
 
-#ifdef QTLOGGER_SDJOURNAL
+        const auto deleted = applyRetention();
 
-#endif
+        if (!db.commit()) {
+            printError("Failed to commit transaction", db.lastError());
+            db.rollback();
+            return false;
+        }
 
-#ifdef Q_OS_WIN
+        deletedSinceVacuum += deleted;
+        if (deletedSinceVacuum > 0 && vacuumTimer.hasExpired(SqliteVacuumInterval)) {
+            QSqlQuery(db).exec(QStringLiteral("PRAGMA incremental_vacuum"));
+            deletedSinceVacuum = 0;
+            vacuumTimer.restart();
+        }
+
+        return true;
+    }
 
+    // An incomplete batch is committed by the timer
+    void startTimer()
+    {
+        int interval = 0;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
 #endif
+            timerScheduled = false;
+            if (pending.isEmpty())
+                return;
+            interval = batchInterval;
+        }
 
-namespace QtLogger {
+        if (timer && !timer->isActive())
+            timer->start(interval);
+    }
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::addSeqNumber(const QString &name)
-{
-    append(SeqNumberAttrPtr::create(name));
-    return *this;
-}
+    bool open()
+    {
+        static QAtomicInt counter;
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::addAppInfo()
-{
-    append(AppInfoAttrsPtr::create());
-    return *this;
-}
+        if (!QSqlDatabase::isDriverAvailable(QStringLiteral("QSQLITE"))) {
+            std::cerr << "SqliteSink: QSQLITE driver is not available" << std::endl;
+            return false;
+        }
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::addAppUuid(const QString &name)
-{
-    append(AppUuidAttrPtr::create(name));
-    return *this;
-}
+        connectionName = QStringLiteral("qtlogger-sqlite-%1").arg(counter.fetchAndAddRelaxed(1));
+        db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connectionName);
+        db.setDatabaseName(fileName);
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::addSysInfo()
-{
-    append(SysInfoAttrsPtr::create());
-    return *this;
-}
+        if (!db.open()) {
+            printError("Can't open database", db.lastError());
+            return false;
+        }
 
-#ifdef QTLOGGER_NETWORK
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::addHostInfo()
-{
-    append(HostInfoAttrsPtr::create());
-    return *this;
-}
-#endif
+        QSqlQuery query(db);
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::attrHandler(std::function<QVariantHash(const LogMessage &lmsg)> func)
-{
-    append(FunctionAttrHandlerPtr::create(func));
-    return *this;
-}
+        // Auto-vacuum can only be enabled before the first table is created
+        query.exec(QStringLiteral("PRAGMA auto_vacuum = INCREMENTAL"));
+        query.exec(QStringLiteral("PRAGMA journal_mode = WAL"));
+        query.exec(QStringLiteral("PRAGMA synchronous = NORMAL"));
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::filter(std::function<bool(const LogMessage &)> func)
-{
-    append(FunctionFilterPtr::create(func));
-    return *this;
-}
+        for (const auto statement : SqliteSchema) {
+            if (!query.exec(QString::fromLatin1(statement))) {
+                printError("Can't create table", query.lastError());
+                return false;
+            }
+        }
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::filter(const QString &regexp)
-{
-    append(RegExpFilterPtr::create(regexp));
-    return *this;
-}
+        insertQuery.reset(new QSqlQuery(db));
+        if (!insertQuery->prepare(QStringLiteral(
+                    "INSERT INTO logs (time, level, category, file, line, function, thread, "
+                    "message, attributes) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)"))) {
+            printError("Can't prepare statement", insertQuery->lastError());
+            return false;
+        }
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::filterLevel(QtMsgType minLevel)
-{
-    append(LevelFilterPtr::create(minLevel));
-    return *this;
-}
+        timer = new QTimer(thread.context());
+        timer->setSingleShot(true);
+        QObject::connect(timer.data(), &QTimer::timeout, timer.data(), [this] { commit(); });
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::filterCategory(const QString &rules)
-{
-    append(CategoryFilterPtr::create(rules));
-    return *this;
-}
+        vacuumTimer.start();
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::filterDuplicate()
-{
-    append(DuplicateFilterPtr::create());
-    return *this;
-}
+        return true;
+    }
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::format(std::function<QString(const LogMessage &)> func)
-{
-    append(FunctionFormatterPtr::create(func));
-    return *this;
-}
+    void close()
+    {
+        if (timer) {
+            timer->disconnect();
+            if (timer->thread() == QThread::currentThread())
+                delete timer.data();
+            else
+                timer->deleteLater();
+        }
+        timer = nullptr;
 
-QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::format(const QString &pattern)
-{
-    if (pattern == "default")
-        append(PatternFormatterPtr::create(DefaultMessagePattern));
-    else if (pattern == "qt")
-        append(QtLogMessageFormatter::instance());
-    else if (pattern == "pretty")
-        append(PrettyFormatterPtr::create());
-    else
-        append(PatternFormatterPtr::create(pattern));
-    return *this;
-}
+        insertQuery.reset();
+
+        if (!connectionName.isEmpty()) {
+            db.close();
+            db = QSqlDatabase();
+            QSqlDatabase::removeDatabase(connectionName);
+            connectionName.clear();
+        }
+
+        state.storeRelease(Closed);
+    }
+
+    // Runs in the transaction of the batch, returns the number of deleted rows
+    int applyRetention()
+    {
+        int deleted = 0;
+        QSqlQuery query(db);
+
+        // Row ids grow with every insert, so the newest maxRowCount rows have the largest ids
+        if (maxRowCount > 0) {
+            query.prepare(QStringLiteral(
+                    "DELETE FROM logs WHERE id <= (SELECT MAX(id) FROM logs) - ?"));
+            query.addBindValue(maxRowCount);
+            if (query.exec())
+                deleted += query.numRowsAffected();
+        }
+
+        if (maxAge > 0) {
+            query.prepare(QStringLiteral("DELETE FROM logs WHERE time < ?"));
+            query.addBindValue(QDateTime::currentMSecsSinceEpoch()
+                               - static_cast<qint64>(maxAge) * 1000);
+            if (query.exec())
+                deleted += query.numRowsAffected();
+        }
+
+        return deleted;
+    }
+
+    void printError(const char *what, const QSqlError &error) const
+    {
+        std::cerr << "SqliteSink: " << what << ": " << fileName.toStdString()
+                  << " error: " << error.text().toStdString() << std::endl;
+    }
+
+    QString connectionName;
+    QSqlDatabase db;
+    QScopedPointer<QSqlQuery> insertQuery;
+    QPointer<QTimer> timer;
+
+    QList<LogMessage> pending;
+    std::chrono::steady_clock::time_point batchStart;
+    bool timerScheduled = false;
+
+    QElapsedTimer vacuumTimer;
+    qint64 deletedSinceVacuum = 0;
+};
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::formatByQt()
-{
-    append(QtLogMessageFormatter::instance());
-    return *this;
-}
+SqliteSink::SqliteSink(const QString &fileName) : d(new SqliteSinkPrivate(fileName)) { }
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::formatPretty(bool colorize, int maxCategoryWidth)
-{
-    append(PrettyFormatterPtr::create(colorize, maxCategoryWidth));
-    return *this;
-}
+SqliteSink::~SqliteSink() = default;
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::formatToJson(bool compact)
+void SqliteSink::send(const LogMessage &lmsg)
 {
-    append(JsonFormatterPtr::create(compact));
-    return *this;
+    d->send(lmsg);
 }
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::formatToSentry(const QString &sdkName, const QString &sdkVersion)
+bool SqliteSink::flush()
 {
-    append(SentryFormatterPtr::create(sdkName, sdkVersion));
-    return *this;
+    return d->flush();
 }
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToStdOut(bool colorize)
+QString SqliteSink::fileName() const
 {
-    append(StdOutSinkPtr::create(colorize ? ColorMode::Auto : ColorMode::Never));
-    return *this;
+    return d->fileName;
 }
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToStdErr(bool colorize)
+bool SqliteSink::isOpen() const
 {
-    append(StdErrSinkPtr::create(colorize ? ColorMode::Auto : ColorMode::Never));
-    return *this;
+    return d->state.loadAcquire() == SqliteSinkPrivate::Open;
 }
 
-#ifdef QTLOGGER_SYSLOG
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToSyslog()
+int SqliteSink::batchSize() const
 {
-    append(SyslogSinkPtr::create(QCoreApplication::applicationName()));
-    return *this;
-}
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
 #endif
+    return d->batchSize;
+}
 
-#ifdef QTLOGGER_SDJOURNAL
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToSdJournal()
+void SqliteSink::setBatchSize(int batchSize)
 {
-    append(SdJournalSinkPtr::create());
-    return *this;
-}
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
 #endif
+    d->batchSize = qMax(batchSize, 1);
+}
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToPlatformStdLog()
+int SqliteSink::batchInterval() const
 {
-    append(PlatformStdSinkPtr::create());
-    return *this;
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->batchInterval;
 }
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToFile(const QString &fileName, int maxFileSize,
-                                           int maxFileCount, RotatingFileSink::Options options)
+void SqliteSink::setBatchInterval(int msecs)
 {
-    if (fileName.isEmpty())
-        return *this;
-
-    if (maxFileSize > 0
-        || options.testFlag(RotatingFileSink::RotationOnStartup)
-        || options.testFlag(RotatingFileSink::RotationDaily)) {
-        append(RotatingFileSinkPtr::create(fileName, maxFileSize, maxFileCount, options));
-    }
-    else {
-        append(FileSinkPtr::create(fileName));
-    }
-
-    return *this;
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->batchInterval = qMax(msecs, 0);
 }
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToIODevice(const QIODevicePtr &device)
+qint64 SqliteSink::maxRowCount() const
 {
-    append(IODeviceSinkPtr::create(device));
-    return *this;
+    return d->maxRowCount;
 }
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToSignal(QObject *receiver, const char *method)
+void SqliteSink::setMaxRowCount(qint64 maxRowCount)
 {
-    auto sink = SignalSinkPtr::create();
-    QObject::connect(sink.data(), SIGNAL(message(QtLogger::LogMessage)), receiver, method);
-    append(sink.staticCast<Sink>());
-    return *this;
+    d->thread.run([this, maxRowCount] { d->maxRowCount = qMax<qint64>(maxRowCount, 0); });
 }
 
-#ifdef QTLOGGER_NETWORK
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToHttp(const QString &url)
+int SqliteSink::maxAge() const
 {
-    append(HttpSinkPtr::create(QUrl(url)));
-    return *this;
+    return d->maxAge;
 }
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToHttp(const QString &url,
-                                           const QList<QPair<QByteArray, QByteArray>> &headers)
+void SqliteSink::setMaxAge(int secs)
 {
-    append(HttpSinkPtr::create(QUrl(url), headers));
-    return *this;
+    d->thread.run([this, secs] { d->maxAge = qMax(secs, 0); });
 }
-#endif
 
-#ifdef Q_OS_WIN
+} // namespace QtLogger
+
+#endif // QTLOGGER_SQL
+
+// stderrsink.cpp
+
+#include <iostream>
+
+namespace QtLogger {
+
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToWinDebug()
+StdErrSink::StdErrSink(ColorMode colorMode)
+    : ColoredConsole(colorMode)
 {
-    append(WinDebugSinkPtr::create());
-    return *this;
+    updateColorsEnabled();
 }
-#endif
 
-#ifdef QTLOGGER_ANDROIDLOG
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToAndroidLog()
+void StdErrSink::send(const LogMessage &lmsg)
 {
-    append(AndroidLogSinkPtr::create());
-    return *this;
+    if (m_colorsEnabled) {
+        std::cerr << qPrintable(colorize(lmsg.formattedMessage(), lmsg.type())) << std::endl;
+    } else {
+        std::cerr << qPrintable(lmsg.formattedMessage()) << std::endl;
+    }
 }
-#endif
 
-#ifdef QTLOGGER_OSLOG
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::sendToOsLog()
+bool StdErrSink::flush()
 {
-    append(OslogSinkPtr::create());
-    return *this;
+    std::flush(std::cerr);
+    return true;
 }
-#endif
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::pipeline()
+bool StdErrSink::isTty() const
 {
-    auto pipeline = SimplePipelinePtr::create(/* scoped */ true, /* parent */ this);
-    append(pipeline);
-    return *pipeline.data();
+    return isStdErrTty();
 }
 
+} // namespace QtLogger
+
+// stdoutsink.cpp
+
+#include <iostream>
+
+namespace QtLogger {
+
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::end()
+StdOutSink::StdOutSink(ColorMode colorMode)
+    : ColoredConsole(colorMode)
 {
-    if (m_parent)
-        return *m_parent;
-    else
-        return *this;
+    updateColorsEnabled();
 }
 
 QTLOGGER_DECL_SPEC
-SimplePipeline &SimplePipeline::handler(std::function<bool(LogMessage &)> func)
+void StdOutSink::send(const LogMessage &lmsg)
 {
-    append(FunctionHandlerPtr::create(std::move(func)));
-    return *this;
+    if (m_colorsEnabled) {
+        std::cout << qPrintable(colorize(lmsg.formattedMessage(), lmsg.type())) << std::endl;
+    } else {
+        std::cout << qPrintable(lmsg.formattedMessage()) << std::endl;
+    }
 }
 
 QTLOGGER_DECL_SPEC
-void SimplePipeline::recursiveFlush(const Pipeline *pipeline)
+bool StdOutSink::flush()
 {
-    for (const auto &handler : pipeline->handlers()) {
-        if (auto sink = handler.dynamicCast<Sink>()) {
-            sink->flush();
-            continue;
-        }
-        if (auto pipeline = handler.dynamicCast<Pipeline>()) {
-            recursiveFlush(pipeline.data());
-        }
-    }
+    std::flush(std::cout);
+    return true;
 }
 
 QTLOGGER_DECL_SPEC
-void SimplePipeline::flush()
+bool StdOutSink::isTty() const
 {
-    recursiveFlush(this);
+    return isStdOutTty();
 }
 
 } // namespace QtLogger
 
-// androidlogsink.cpp
+// syslogsink.cpp
 
-#ifdef QTLOGGER_ANDROIDLOG
+#ifdef QTLOGGER_SYSLOG
 
-#include <android/log.h>
+#include <syslog.h>
 
 namespace QtLogger {
 
 QTLOGGER_DECL_SPEC
-void AndroidLogSink::send(const LogMessage &lmsg)
+SyslogSink::SyslogSink(const QString &ident, int option, int facility)
 {
-    auto priority = ANDROID_LOG_DEBUG;
+    openlog(qPrintable(ident), option, facility);
+}
+
+QTLOGGER_DECL_SPEC
+SyslogSink::~SyslogSink()
+{
+    closelog();
+}
+
+QTLOGGER_DECL_SPEC
+void SyslogSink::send(const LogMessage &lmsg)
+{
+    auto priority = LOG_DEBUG;
 
     switch (lmsg.type()) {
     case QtDebugMsg:
-        priority = ANDROID_LOG_DEBUG;
-        break;
-    case QtInfoMsg:
-        priority = ANDROID_LOG_INFO;
+        priority = LOG_DEBUG;
         break;
     case QtWarningMsg:
-        priority = ANDROID_LOG_WARN;
+        priority = LOG_WARNING;
         break;
     case QtCriticalMsg:
-        priority = ANDROID_LOG_ERROR;
+        priority = LOG_ERR;
         break;
     case QtFatalMsg:
-        priority = ANDROID_LOG_FATAL;
+        priority = LOG_EMERG;
         break;
-    };
+    case QtInfoMsg:
+        priority = LOG_INFO;
+        break;
+    default:
+        return;
+    }
+
+    QString formattedMessage;
+    if (qstrcmp(lmsg.category(), "default") == 0) {
+        formattedMessage = lmsg.message();
+    } else {
+        formattedMessage = QStringLiteral("%1: %2").arg(lmsg.category(), lmsg.message());
+    }
+
+    syslog(priority, "%s", qPrintable(formattedMessage));
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_SYSLOG
+
+// tcpsink.cpp
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QAtomicInteger>
+#include <QPair>
+#include <QPointer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int TcpBatchSize = 64 * 1024;
+
+} // namespace
+
+class TcpSink::TcpSinkPrivate
+{
+public:
+    TcpSinkPrivate(const QString &host, quint16 port, Framing framing)
+        : host(host), port(port), framing(framing)
+    {
+    }
+
+    ~TcpSinkPrivate()
+    {
+        thread.run([this] { resetSocket(); });
+        thread.stop();
+    }
+
+    // The queue is filled in the calling thread, so the drop policy applies before send() returns
+    void send(const QByteArray &frame)
+    {
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            enqueue(frame);
+
+            // Frames sent until the thread of the sink gets to them are coalesced into one write
+            if (writeScheduled)
+                return;
+            writeScheduled = true;
+        }
+
+        thread.post([this] {
+            ensureSocket();
+            writeQueue();
+        });
+    }
+
+    void flush()
+    {
+        thread.run([this] {
+            if (!socket)
+                return;
+
+            writeQueue();
+            socket->flush();
+        });
+    }
+
+    QString host;
+    quint16 port;
+    Framing framing;
+
+    // Set by any thread, guarded by the mutex
+    int maxBufferSize = DefaultMaxBufferSize;
+    DropPolicy dropPolicy = DropPolicy::DropOldest;
+    int minReconnectDelay = DefaultMinReconnectDelay;
+    int maxReconnectDelay = DefaultMaxReconnectDelay;
+
+    QAtomicInt connected;
+    QAtomicInteger<quint64> dropped;
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    SinkThread thread { QStringLiteral("TcpSink") };
+
+private:
+    // The socket and its timer are used only in the thread of the sink
+    void ensureSocket()
+    {
+        if (socket)
+            return;
+
+        socket = new QTcpSocket(thread.context());
+        reconnectDelay = reconnectDelays().first;
+
+        reconnectTimer = new QTimer(socket.data());
+        reconnectTimer->setSingleShot(true);
+        QObject::connect(reconnectTimer.data(), &QTimer::timeout, socket.data(), [this] {
+            if (socket->state() == QAbstractSocket::UnconnectedState)
+                socket->connectToHost(host, port);
+        });
+
+        QObject::connect(socket.data(), &QAbstractSocket::stateChanged, socket.data(),
+                         [this](QAbstractSocket::SocketState state) {
+                             if (state == QAbstractSocket::ConnectedState) {
+                                 connected.storeRelease(1);
+                                 reconnectDelay = reconnectDelays().first;
+                                 writeQueue();
+                             } else if (state == QAbstractSocket::UnconnectedState) {
+                                 connected.storeRelease(0);
+                                 scheduleReconnect();
+                             }
+                         });
+
+        // The socket is refilled from the queue as it sends
+        QObject::connect(socket.data(), &QIODevice::bytesWritten, socket.data(),
+                         [this] { writeQueue(); });
+
+        socket->connectToHost(host, port);
+    }
+
+    void resetSocket()
+    {
+        if (!socket)
+            return;
+
+        socket->disconnect();
+        reconnectTimer->disconnect();
+
+        if (socket->thread() == QThread::currentThread()) {
+            if (socket->state() == QAbstractSocket::ConnectedState) {
+                {
+#ifndef QTLOGGER_NO_THREAD
+                    QMutexLocker locker(&mutex);
+#endif
+                    while (!queue.isEmpty()) {
+                        socket->write(queue.takeFirst());
+                    }
+                    queuedSize = 0;
+                }
+                if (socket->bytesToWrite() > 0)
+                    socket->waitForBytesWritten(100);
+            }
+            delete socket.data();
+        } else {
+            socket->deleteLater();
+        }
+
+        socket = nullptr;
+        connected.storeRelease(0);
+    }
+
+    void scheduleReconnect()
+    {
+        if (!reconnectTimer || reconnectTimer->isActive())
+            return;
 
-    __android_log_print(priority, lmsg.category(), "%s", qPrintable(lmsg.message()));
+        reconnectTimer->start(reconnectDelay);
+        reconnectDelay = qMin(reconnectDelay * 2, reconnectDelays().second);
+    }
 
-    // TODO: use __android_log_write_log_message for API level 30 and above
-}
+    QPair<int, int> reconnectDelays()
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&mutex);
+#endif
+        return { minReconnectDelay, maxReconnectDelay };
+    }
 
-} // namespace QtLogger
+    // Called with the mutex locked
+    void enqueue(const QByteArray &frame)
+    {
+        if (queuedSize + frame.size() > maxBufferSize) {
+            if (dropPolicy == DropPolicy::DropNewest || frame.size() > maxBufferSize) {
+                dropped.fetchAndAddRelaxed(1);
+                return;
+            }
 
-#endif // QTLOGGER_ANDROIDLOG
+            while (!queue.isEmpty() && queuedSize + frame.size() > maxBufferSize) {
+                queuedSize -= queue.takeFirst().size();
+                dropped.fetchAndAddRelaxed(1);
+            }
+        }
 
-// coloredconsole.cpp
+        queue.append(frame);
+        queuedSize += frame.size();
+    }
 
-#ifdef Q_OS_WIN
-#    include <io.h>
-#    include <stdio.h>
-#    ifndef STDOUT_FILENO
-#        define STDOUT_FILENO _fileno(stdout)
-#    endif
-#    ifndef STDERR_FILENO
-#        define STDERR_FILENO _fileno(stderr)
-#    endif
-#    define isatty _isatty
-#else
-#    include <unistd.h>
+    void writeQueue()
+    {
+        if (!socket)
+            return;
+
+        QByteArray batch;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
 #endif
+            writeScheduled = false;
 
-namespace QtLogger {
+            if (socket->state() != QAbstractSocket::ConnectedState || queue.isEmpty())
+                return;
 
-QTLOGGER_DECL_SPEC
-ColoredConsole::ColoredConsole(ColorMode colorMode) : m_colorMode(colorMode) { }
+            // A slow peer keeps the rest in the bounded queue instead of the socket buffer
+            if (socket->bytesToWrite() >= TcpBatchSize)
+                return;
 
-QTLOGGER_DECL_SPEC
-ColoredConsole::~ColoredConsole() = default;
+            batch.reserve(static_cast<int>(qMin<qint64>(queuedSize, TcpBatchSize)));
+            while (!queue.isEmpty() && batch.size() < TcpBatchSize) {
+                batch.append(queue.takeFirst());
+            }
+            queuedSize -= batch.size();
+        }
+
+        socket->write(batch);
+    }
+
+    QPointer<QTcpSocket> socket;
+    QPointer<QTimer> reconnectTimer;
+    int reconnectDelay = DefaultMinReconnectDelay;
+
+    QList<QByteArray> queue;
+    qint64 queuedSize = 0;
+    bool writeScheduled = false;
+};
 
 QTLOGGER_DECL_SPEC
-void ColoredConsole::setColorMode(ColorMode mode)
+TcpSink::TcpSink(const QString &host, quint16 port, Framing framing)
+    : d(new TcpSinkPrivate(host, port, framing))
 {
-    m_colorMode = mode;
-    updateColorsEnabled();
 }
 
 QTLOGGER_DECL_SPEC
-ColorMode ColoredConsole::colorMode() const
-{
-    return m_colorMode;
-}
+TcpSink::~TcpSink() = default;
 
 QTLOGGER_DECL_SPEC
-bool ColoredConsole::colorsEnabled() const
+void TcpSink::send(const LogMessage &lmsg)
 {
-    return m_colorsEnabled;
+    // A peer isn't a terminal, so the message is sent without terminal colors, and it doesn't
+    // share the locale of the process, so text is always in UTF-8
+    d->send(IODeviceSink::frame(lmsg, d->framing, true, true));
 }
 
 QTLOGGER_DECL_SPEC
-QString ColoredConsole::colorPrefix(QtMsgType type)
+bool TcpSink::flush()
 {
-    switch (type) {
-    case QtDebugMsg:
-        return QStringLiteral("\033[90m"); // Gray
-    case QtInfoMsg:
-        return QStringLiteral("\033[32m"); // Green
-    case QtWarningMsg:
-        return QStringLiteral("\033[33m"); // Yellow
-    case QtCriticalMsg:
-        return QStringLiteral("\033[31m"); // Red
-    case QtFatalMsg:
-        return QStringLiteral("\033[1;91m"); // Bold bright red
-    default:
-        return QString();
-    }
+    d->flush();
+    return true;
 }
 
 QTLOGGER_DECL_SPEC
-QString ColoredConsole::colorReset()
+QString TcpSink::host() const
 {
-    return QStringLiteral("\033[0m");
+    return d->host;
 }
 
 QTLOGGER_DECL_SPEC
-QString ColoredConsole::colorize(const QString &message, QtMsgType type)
+quint16 TcpSink::port() const
 {
-    const QString prefix = colorPrefix(type);
-    if (prefix.isEmpty()) {
-        return message;
-    }
-    return prefix + message + colorReset();
+    return d->port;
 }
 
 QTLOGGER_DECL_SPEC
-bool ColoredConsole::isStdOutTty()
+TcpSink::Framing TcpSink::framing() const
 {
-    static const bool isTty = isatty(STDOUT_FILENO) != 0;
-    return isTty;
+    return d->framing;
 }
 
 QTLOGGER_DECL_SPEC
-bool ColoredConsole::isStdErrTty()
+int TcpSink::maxBufferSize() const
 {
-    static const bool isTty = isatty(STDERR_FILENO) != 0;
-    return isTty;
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxBufferSize;
 }
 
 QTLOGGER_DECL_SPEC
-void ColoredConsole::updateColorsEnabled()
+void TcpSink::setMaxBufferSize(int maxBufferSize)
 {
-    switch (m_colorMode) {
-    case ColorMode::Always:
-        m_colorsEnabled = true;
-        break;
-    case ColorMode::Never:
-        m_colorsEnabled = false;
-        break;
-    case ColorMode::Auto:
-    default:
-        m_colorsEnabled = isTty();
-        break;
-    }
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxBufferSize = maxBufferSize;
 }
 
-} // namespace QtLogger
-
-// filesink.cpp
-
-#include <QDateTime>
-#include <QFile>
-#include <QRegularExpression>
-#include <QSharedPointer>
-
-#include <iostream>
-
-namespace QtLogger {
-
-namespace {
-
-/**
- * @brief Replaces the time pattern in the given string with the current date and time.
- *
- * This function searches for a time pattern in the format `%{time <format>}` within the input
- * string. If found, it replaces the pattern with the current date and time formatted according to
- * the specified format. If no format is specified, it defaults to "yyyyMMdd_hhmmss".
- *
- * @param path The input string potentially containing the time pattern.
- * @return A new string with the time pattern replaced by the current date and time.
- */
-
 QTLOGGER_DECL_SPEC
-QString replaceTimePattern(const QString &path)
+TcpSink::DropPolicy TcpSink::dropPolicy() const
 {
-    static auto re = QRegularExpression(QStringLiteral("(.*)%{time *(.*?)}(.*)"));
-    auto match = re.match(path);
-
-    if (!match.hasMatch())
-        return path;
-
-    auto format = match.captured(2);
-
-    if (format.isEmpty()) {
-        format = QStringLiteral("yyyyMMdd_hhmmss");
-    }
-
-    return match.captured(1) + QDateTime::currentDateTime().toString(format) + match.captured(3);
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->dropPolicy;
 }
 
 QTLOGGER_DECL_SPEC
-QSharedPointer<QFile> createFilePtr(const QString &path)
+void TcpSink::setDropPolicy(DropPolicy dropPolicy)
 {
-    return QSharedPointer<QFile>::create(replaceTimePattern(path));
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->dropPolicy = dropPolicy;
 }
 
+QTLOGGER_DECL_SPEC
+int TcpSink::minReconnectDelay() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->minReconnectDelay;
 }
 
 QTLOGGER_DECL_SPEC
-FileSink::FileSink(const QString &path) : IODeviceSink(createFilePtr(path))
+int TcpSink::maxReconnectDelay() const
 {
-    if (!file()->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-        std::cerr << "FileSink: Can't open log file: " << path.toStdString()
-                  << " error: " << file()->errorString().toStdString() << std::endl;
-    }
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxReconnectDelay;
 }
 
 QTLOGGER_DECL_SPEC
-FileSink::~FileSink()
+void TcpSink::setReconnectDelay(int minDelay, int maxDelay)
 {
-    file()->close();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->minReconnectDelay = qMax(minDelay, 0);
+    d->maxReconnectDelay = qMax(maxDelay, d->minReconnectDelay);
 }
 
 QTLOGGER_DECL_SPEC
-bool FileSink::flush()
+bool TcpSink::isConnected() const
 {
-    return file()->flush();
+    return d->connected.loadAcquire() != 0;
 }
 
 QTLOGGER_DECL_SPEC
-QFile *FileSink::file() const
+quint64 TcpSink::droppedCount() const
 {
-    return qobject_cast<QFile *>(device().data());
+    return d->dropped.loadAcquire();
 }
 
 } // namespace QtLogger
 
-// httpsink.cpp
+#endif // QTLOGGER_NETWORK
 
-#ifdef QTLOGGER_NETWORK
+// windebugsink.cpp
 
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QNetworkRequest>
+#ifdef Q_OS_WIN
 
-namespace QtLogger {
+#include <qt_windows.h>
 
-QTLOGGER_DECL_SPEC
-HttpSink::HttpSink(const QUrl &url) : m_url(url)
-{
-    init();
-}
+namespace QtLogger {
 
 QTLOGGER_DECL_SPEC
-HttpSink::HttpSink(const QUrl &url, const Headers &headers) : m_url(url), m_headers(headers)
+void WinDebugSink::send(const LogMessage &lmsg)
 {
-    init();
+    auto formattedMessage = lmsg.formattedMessage() + u'\n';
+    OutputDebugString(reinterpret_cast<const wchar_t *>(formattedMessage.utf16()));
 }
 
-QTLOGGER_DECL_SPEC
-void HttpSink::init()
-{
-    m_manager = new QNetworkAccessManager();
+} // namespace QtLogger
 
-#ifndef QTLOGGER_NO_THREAD
-    if (m_manager->thread() != Logger::instance()->ownThread()) {
-        m_manager->moveToThread(Logger::instance()->ownThread());
-    }
 #endif
 
-    m_request.setUrl(m_url);
-    for (const auto &header : m_headers) {
-        m_request.setRawHeader(header.first, header.second);
-    }
-}
+// sortedpipeline.cpp
+
+namespace QtLogger {
 
 QTLOGGER_DECL_SPEC
-HttpSink::~HttpSink()
+void SortedPipeline::insertBetweenNearLeft(const QSet<HandlerType> &leftType,
+                                           const QSet<HandlerType> &rightType,
+                                           const HandlerPtr &handler)
 {
-    if (!m_manager.isNull()) {
-        delete m_manager.data();
-    }
+    auto firstRight =
+            std::find_if(handlers().begin(), handlers().end(),
+                         [&rightType](const auto &x) { return rightType.contains(x->type()); });
+
+    auto lastLeft = std::find_if(firstRight, handlers().begin(), [&leftType](const HandlerPtr &x) {
+        return leftType.contains(x->type());
+    });
+
+    handlers().insert(lastLeft, handler);
 }
 
 QTLOGGER_DECL_SPEC
-void HttpSink::send(const LogMessage &lmsg)
+void SortedPipeline::insertBetweenNearRight(const QSet<HandlerType> &leftType,
+                                            const QSet<HandlerType> &rightType,
+                                            const HandlerPtr &handler)
 {
-    if (!Logger::instance()->ownThreadIsRunning()) {
-        if (!m_manager.isNull() && !m_manager->property("activeReply").isValid())
-            m_manager->deleteLater();
-        m_manager = new QNetworkAccessManager();
-    }
-
-    if (!m_request.hasRawHeader("Content-Type")) {
-        m_request.setHeader(QNetworkRequest::ContentTypeHeader,
-                            QStringLiteral("text/plain; charset=utf-8"));
-    }
-
-    auto reply = m_manager->post(m_request, lmsg.formattedMessage().toUtf8());
+    auto lastLeft =
+            std::find_if(handlers().end(), handlers().begin(),
+                         [&leftType](const HandlerPtr &x) { return leftType.contains(x->type()); });
 
-    QObject::connect(reply, &QNetworkReply::finished, reply, &QObject::deleteLater);
+    auto firstRight = std::find_if(lastLeft, handlers().end(), [&rightType](const auto &x) {
+        return rightType.contains(x->type());
+    });
 
-    if (!Logger::instance()->ownThreadIsRunning()) {
-        m_manager->setProperty("activeReply", QVariant::fromValue(reply));
-        QObject::connect(reply, &QNetworkReply::finished, m_manager, &QObject::deleteLater);
-    }
+    handlers().insert(firstRight, handler);
 }
 
 QTLOGGER_DECL_SPEC
-void HttpSink::setNetworkAccessManager(QNetworkAccessManager *manager)
+void SortedPipeline::clear(HandlerType type)
 {
-    if (!m_manager.isNull()) {
-        delete m_manager.data();
+    QMutableListIterator<HandlerPtr> iter(handlers());
+
+    while (iter.hasNext()) {
+        if (iter.next()->type() == type) {
+            iter.remove();
+        }
     }
-    m_manager = manager;
 }
 
 QTLOGGER_DECL_SPEC
-void HttpSink::setRequest(const QNetworkRequest &request)
+void SortedPipeline::clear()
 {
-    m_request = request;
+    Pipeline::clear();
 }
 
 QTLOGGER_DECL_SPEC
-void HttpSink::setHeaders(const Headers &headers)
+void SortedPipeline::appendAttrHandler(const AttrHandlerPtr &attrHandler)
 {
-    m_headers = headers;
-    for (const auto &header : m_headers) {
-        m_request.setRawHeader(header.first, header.second);
-    }
-}
-
-} // namespace QtLogger
-
-#endif // QTLOGGER_NETWORK
-
-// iodevicesink.cpp
+    if (attrHandler.isNull())
+        return;
 
-namespace QtLogger {
+    insertBetweenNearLeft({ HandlerType::AttrHandler },
+                          { HandlerType::Filter, HandlerType::Formatter, HandlerType::Sink },
+                          attrHandler);
+}
 
 QTLOGGER_DECL_SPEC
-IODeviceSink::IODeviceSink(const QIODevicePtr &device) : m_device(device) { }
+void SortedPipeline::clearAttrHandlers()
+{
+    clear(HandlerType::AttrHandler);
+}
 
 QTLOGGER_DECL_SPEC
-void IODeviceSink::send(const LogMessage &lmsg)
+void SortedPipeline::appendFilter(const FilterPtr &filter)
 {
-    if (m_device.isNull()) {
+    if (filter.isNull())
         return;
-    }
 
-    m_device->write(lmsg.formattedMessage().toLocal8Bit().append("\n"));
+    insertBetweenNearLeft({ HandlerType::AttrHandler, HandlerType::Filter },
+                          { HandlerType::Formatter, HandlerType::Sink }, filter);
 }
 
 QTLOGGER_DECL_SPEC
-const QIODevicePtr &IODeviceSink::device() const
+void SortedPipeline::clearFilters()
 {
-    return m_device;
+    clear(HandlerType::Filter);
 }
 
 QTLOGGER_DECL_SPEC
-void IODeviceSink::setDevice(const QIODevicePtr &device)
+void SortedPipeline::setFormatter(const FormatterPtr &formatter)
 {
-    m_device = device;
-}
-
-} // namespace QtLogger
-
-// oslogsink.cpp
+    if (formatter.isNull())
+        return;
 
-#ifdef QTLOGGER_OSLOG
+    clearFormatters();
 
-#include <os/log.h>
+    insertBetweenNearRight({ HandlerType::AttrHandler, HandlerType::Filter }, { HandlerType::Sink },
+                           formatter);
+}
 
-#include <QCoreApplication>
+QTLOGGER_DECL_SPEC
+void SortedPipeline::clearFormatters()
+{
+    clear(HandlerType::Formatter);
+}
 
-namespace QtLogger {
+QTLOGGER_DECL_SPEC
+void SortedPipeline::appendSink(const SinkPtr &sink)
+{
+    append(sink);
+}
 
 QTLOGGER_DECL_SPEC
-void OslogSink::send(const LogMessage &lmsg)
+void SortedPipeline::clearSinks()
 {
-    auto customLog = os_log_create(qPrintable(QCoreApplication::applicationName()),
-                                   qPrintable(lmsg.category()));
+    clear(HandlerType::Sink);
+}
 
-    auto type = OS_LOG_TYPE_DEBUG;
-    switch (lmsg.type()) {
-    case QtDebugMsg:
-        type = OS_LOG_TYPE_DEBUG;
-        break;
-    case QtInfoMsg:
-        type = OS_LOG_TYPE_INFO;
-        break;
-    case QtWarningMsg:
-        type = OS_LOG_TYPE_ERROR;
-        break;
-    case QtCriticalMsg:
-        type = OS_LOG_TYPE_FAULT;
-        break;
-    case QtFatalMsg:
-        type = OS_LOG_TYPE_FAULT;
-        break;
-    };
+QTLOGGER_DECL_SPEC
+void SortedPipeline::appendPipeline(const PipelinePtr &pipeline)
+{
+    append(pipeline);
+}
 
-    os_log_with_type(customLog, type, "%s", qPrintable(lmsg.message()));
+QTLOGGER_DECL_SPEC
+void SortedPipeline::clearPipelines()
+{
+    clear(HandlerType::Pipeline);
 }
 
 } // namespace QtLogger
 
-#endif // QTLOGGER_OSLOG
-
-// rotatingfilesink.cpp
-
-/*
- * Rotated file naming format:
- *   <basename>.<date>.<index>.<suffix>[.gz]
- *   Example: app.2024-05-15.1.log or app.2024-05-15.1.log.gz
- *
- * Rotation triggers:
- *   1. On startup (RotationOnStartup) - rotates if the log file is non-empty
- *   2. Daily (RotationDaily) - rotates when the message date differs from the current log date
- *   3. By size (maxFileSize > 0) - rotates when adding a new message would exceed maxFileSize
- *
- *   If maxFileCount == 1, rotation is disabled (only the main file is kept)
- *   If maxFileCount <= 0, rotated files are kept indefinitely (no automatic cleanup)
- */
+// termindex.cpp
 
-#include <QDate>
-#include <QDir>
 #include <QFile>
-#include <QFileInfo>
-#include <QRegularExpression>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
 #include <QtEndian>
-#include <QDataStream>
 
 #include <algorithm>
 #include <iostream>
@@ -4654,674 +16291,904 @@ namespace QtLogger {
 
 namespace {
 
-QTLOGGER_DECL_SPEC
-static quint32 calculateCRC32(QFile &file) {
-    quint32 crc = 0xFFFFFFFF;
-    const quint32 polynomial = 0xEDB88320;
-    static quint32 table[256];
-    static bool tableGenerated = false;
-
-    if (!tableGenerated) {
-        for (quint32 i = 0; i < 256; i++) {
-            quint32 value = i;
-            for (int j = 0; j < 8; j++) {
-                if (value & 1) value = (value >> 1) ^ polynomial;
-                else value >>= 1;
-            }
-            table[i] = value;
-        }
-        tableGenerated = true;
-    }
-
-    file.seek(0);
-    char buffer[8192];
-    while (!file.atEnd()) {
-        auto bytesRead = file.read(buffer, sizeof(buffer));
-        for (auto i = 0; i < bytesRead; i++) {
-            crc = table[(crc ^ static_cast<unsigned char>(buffer[i])) & 0xFF] ^ (crc >> 8);
-        }
+// FNV-1a, stable across processes and Qt versions unlike qHash()
+quint64 termIndexHash(const QString &term)
+{
+    auto hash = Q_UINT64_C(14695981039346656037);
+    const auto utf8 = term.toUtf8();
+    for (const auto c : utf8) {
+        hash ^= static_cast<quint8>(c);
+        hash *= Q_UINT64_C(1099511628211);
     }
-    return crc ^ 0xFFFFFFFF;
+    return hash;
 }
 
-} // namespace
-
-class RotatingFileSink::RotatingFileSinkPrivate
+// Bit positions by double hashing
+template<typename Function>
+void termIndexBits(const QString &term, quint32 bitCount, int hashCount, Function function)
 {
-public:
-    RotatingFileSinkPrivate(RotatingFileSink *q,
-                            int maxFileSize,
-                            int maxFileCount,
-                            RotatingFileSink::Options options)
-        : q_ptr(q)
-        , m_maxFileSize(maxFileSize)
-        , m_maxFileCount(maxFileCount)
-        , m_rotationOnStartup(options.testFlag(RotatingFileSink::RotationOnStartup))
-        , m_rotationDaily(options.testFlag(RotatingFileSink::RotationDaily))
-        , m_compression(options.testFlag(RotatingFileSink::Compression))
-    {
+    const auto hash = termIndexHash(term);
+    const auto h1 = static_cast<quint32>(hash);
+    const auto h2 = static_cast<quint32>(hash >> 32) | 1;
+    for (int i = 0; i < hashCount; ++i) {
+        function((h1 + static_cast<quint32>(i) * h2) % bitCount);
     }
+}
 
-    void init()
-    {
-        if (m_initialized)
-            return;
-
-        m_initialized = true;
+bool isTermChar(QChar c)
+{
+    return c.isLetterOrNumber() || c == QLatin1Char('_') || c == QLatin1Char('-')
+            || c == QLatin1Char('.');
+}
 
-        auto fi = QFileInfo(q_ptr->file()->fileName());
-        if (fi.exists() && fi.size() > 0) {
-            m_currentLogDate = fi.lastModified().date();
-        } else {
-            m_currentLogDate = QDate::currentDate();
-        }
+bool isTermEdgeChar(QChar c)
+{
+    return c == QLatin1Char('-') || c == QLatin1Char('.');
+}
 
-        if (m_rotationOnStartup) {
-            checkStartupRotation();
-        }
-    }
+} // namespace
 
-    void rotateIfNeeded(const LogMessage &lmsg)
-    {
-        const auto messageDate = lmsg.time().date();
+QTLOGGER_DECL_SPEC
+QString TermIndex::normalizeTerm(const QString &term)
+{
+    return term.trimmed().toLower().left(MaxTermLength);
+}
 
-        if (m_rotationDaily) {
-            checkDailyRotation(messageDate);
-        }
+QTLOGGER_DECL_SPEC
+QStringList TermIndex::tokenize(const QString &text)
+{
+    QStringList tokens;
 
-        if (m_maxFileSize > 0) {
-            const auto additionalSize = lmsg.formattedMessage().toUtf8().size() + 1; // +1 for newline
-            checkSizeRotation(additionalSize);
+    int pos = 0;
+    while (pos < text.size()) {
+        while (pos < text.size() && (!isTermChar(text.at(pos)) || isTermEdgeChar(text.at(pos)))) {
+            ++pos;
         }
-    }
 
-    void checkStartupRotation()
-    {
-        if (q_ptr->file()->size() > 0) {
-            rotate();
+        auto end = pos;
+        while (end < text.size() && isTermChar(text.at(end))) {
+            ++end;
         }
-    }
 
-    void checkDailyRotation(const QDate &messageDate)
-    {
-        if (messageDate != m_currentLogDate && q_ptr->file()->size() > 0) {
-            rotate();
-            m_currentLogDate = messageDate;
+        auto last = end;
+        while (last > pos && isTermEdgeChar(text.at(last - 1))) {
+            --last;
         }
-    }
 
-    void checkSizeRotation(int additionalSize)
-    {
-        if (m_maxFileSize <= 0)
-            return;
+        if (last > pos)
+            tokens.append(normalizeTerm(text.mid(pos, last - pos)));
 
-        const auto currentSize = q_ptr->file()->size();
-        if (currentSize > 0 && (currentSize + additionalSize) > m_maxFileSize) {
-            rotate();
-        }
+        pos = end;
     }
 
-    QString baseDir() const
-    {
-        auto fi = QFileInfo(q_ptr->file()->fileName());
-        return fi.absolutePath();
-    }
+    return tokens;
+}
 
-    QString generateRotatedFileName(const QDate &date, int index) const
-    {
-        auto fi = QFileInfo(q_ptr->file()->fileName());
-        const auto baseName = fi.completeBaseName();
-        const auto suffix = fi.suffix();
-        const auto dateStr = date.toString(QStringLiteral("yyyy-MM-dd"));
+QTLOGGER_DECL_SPEC
+QStringList TermIndex::terms(const QString &text, const QVariantHash &attributes)
+{
+    auto result = tokenize(text);
 
-        QString rotatedName;
-        if (suffix.isEmpty()) {
-            rotatedName = QStringLiteral("%1.%2.%3").arg(baseName, dateStr).arg(index);
-        } else {
-            rotatedName = QStringLiteral("%1.%2.%3.%4").arg(baseName, dateStr).arg(index).arg(suffix);
-        }
+    for (const auto &value : attributes) {
+        const auto string = value.toString();
+        if (string.isEmpty())
+            continue;
 
-        return QDir(baseDir()).filePath(rotatedName);
+        result.append(normalizeTerm(string));
+        result.append(tokenize(string));
     }
 
-    int findNextIndexForDate(const QDate &date) const
-    {
-        auto fi = QFileInfo(q_ptr->file()->fileName());
-        const auto baseName = fi.completeBaseName();
-        const auto suffix = fi.suffix();
-        const auto dateStr = date.toString(QStringLiteral("yyyy-MM-dd"));
-
-        QString pattern;
-        if (suffix.isEmpty()) {
-            pattern = QStringLiteral("^%1\\.%2\\.(\\d+)(\\.gz)?$")
-                          .arg(QRegularExpression::escape(baseName),
-                               QRegularExpression::escape(dateStr));
-        } else {
-            pattern = QStringLiteral("^%1\\.%2\\.(\\d+)\\.%3(\\.gz)?$")
-                          .arg(QRegularExpression::escape(baseName),
-                               QRegularExpression::escape(dateStr),
-                               QRegularExpression::escape(suffix));
-        }
-
-        auto re = QRegularExpression(pattern);
-        auto dir = QDir(baseDir());
-        auto maxIndex = 0;
+    return result;
+}
 
-        const auto entries = dir.entryList(QDir::Files);
-        for (const QString &entry : entries) {
-            auto match = re.match(entry);
-            if (match.hasMatch()) {
-                auto index = match.captured(1).toInt();
-                if (index > maxIndex) {
-                    maxIndex = index;
-                }
-            }
+class TermIndexWriter::TermIndexWriterPrivate
+{
+public:
+    void addTerm(const QString &term, qint64 rangeOffset)
+    {
+        if (term.isEmpty() || !complete)
+            return;
+
+        auto &ranges = terms[term];
+        if (!ranges.isEmpty() && ranges.last() == rangeOffset)
+            return;
+
+        // An index without some of the terms would rule out files that have them
+        if (rangeCount >= maxRangeCount) {
+            terms = QHash<QString, QList<qint64>>();
+            rangeCount = 0;
+            complete = false;
+            return;
         }
 
-        return maxIndex + 1;
+        ranges.append(rangeOffset);
+        ++rangeCount;
     }
 
-    void compressFile(const QString &filePath)
-    {
-        auto inputFile = QFile(filePath);
-        if (!inputFile.open(QIODevice::ReadOnly)) return;
+    QHash<QString, QList<qint64>> terms;
+    int maxRangeCount = DefaultMaxRangeCount;
+    int rangeCount = 0;
+    bool complete = true;
+};
 
-        const auto compressedPath = filePath + QStringLiteral(".gz");
-        auto outputFile = QFile(compressedPath);
-        if (!outputFile.open(QIODevice::WriteOnly)) {
-            inputFile.close();
-            return;
-        }
+QTLOGGER_DECL_SPEC
+TermIndexWriter::TermIndexWriter() : d(new TermIndexWriterPrivate) { }
 
-        auto fileCRC = calculateCRC32(inputFile);
-        auto fileSize = static_cast<quint32>(inputFile.size());
-        inputFile.seek(0);
+QTLOGGER_DECL_SPEC
+TermIndexWriter::~TermIndexWriter() = default;
 
-        outputFile.putChar('\x1f'); // ID1
-        outputFile.putChar('\x8b'); // ID2
-        outputFile.putChar('\x08'); // CM (Deflate)
-        outputFile.putChar('\x00'); // FLG
-        outputFile.write("\x00\x00\x00\x00", 4); // MTIME (0 = unknown)
-        outputFile.putChar('\x00'); // XFL
-        outputFile.putChar('\x03'); // OS (Unix)
+QTLOGGER_DECL_SPEC
+int TermIndexWriter::maxRangeCount() const
+{
+    return d->maxRangeCount;
+}
 
-        auto rawData = inputFile.readAll();
-        auto compressed = qCompress(rawData, 5);
+QTLOGGER_DECL_SPEC
+void TermIndexWriter::setMaxRangeCount(int count)
+{
+    d->maxRangeCount = qMax(count, 1);
+}
 
-        if (compressed.size() > 10) {
-            outputFile.write(compressed.constData() + 6, compressed.size() - 6 - 4);
-        }
+QTLOGGER_DECL_SPEC
+int TermIndexWriter::rangeCount() const
+{
+    return d->rangeCount;
+}
 
-        auto le_crc = qToLittleEndian(fileCRC);
-        auto le_size = qToLittleEndian(fileSize);
-        outputFile.write(reinterpret_cast<const char*>(&le_crc), 4);
-        outputFile.write(reinterpret_cast<const char*>(&le_size), 4);
+QTLOGGER_DECL_SPEC
+bool TermIndexWriter::isComplete() const
+{
+    return d->complete;
+}
 
-        inputFile.close();
-        outputFile.close();
-        QFile::remove(filePath);
+QTLOGGER_DECL_SPEC
+void TermIndexWriter::add(const LogMessage &lmsg, qint64 rangeOffset)
+{
+    if (!d->complete)
+        return;
+
+    const auto terms = TermIndex::terms(lmsg.message(), lmsg.attributes());
+    for (const auto &term : terms) {
+        d->addTerm(term, rangeOffset);
     }
+}
 
-    QStringList findRotatedFiles() const
-    {
-        auto fi = QFileInfo(q_ptr->file()->fileName());
-        const auto baseName = fi.completeBaseName();
-        const auto suffix = fi.suffix();
+QTLOGGER_DECL_SPEC
+void TermIndexWriter::addText(const QString &text, qint64 rangeOffset)
+{
+    if (!d->complete)
+        return;
 
-        QString pattern;
-        if (suffix.isEmpty()) {
-            pattern = QStringLiteral("^%1\\.\\d{4}-\\d{2}-\\d{2}\\.\\d+(\\.gz)?$")
-                          .arg(QRegularExpression::escape(baseName));
-        } else {
-            pattern = QStringLiteral("^%1\\.\\d{4}-\\d{2}-\\d{2}\\.\\d+\\.%2(\\.gz)?$")
-                          .arg(QRegularExpression::escape(baseName),
-                               QRegularExpression::escape(suffix));
-        }
+    const auto tokens = TermIndex::tokenize(text);
+    for (const auto &token : tokens) {
+        d->addTerm(token, rangeOffset);
+    }
+}
 
-        auto re = QRegularExpression(pattern);
-        auto dir = QDir(baseDir());
-        auto result = QStringList();
+QTLOGGER_DECL_SPEC
+bool TermIndexWriter::write(const QString &indexFileName) const
+{
+    if (!d->complete)
+        return false;
 
-        const auto entries = dir.entryList(QDir::Files, QDir::Name);
-        for (const QString &entry : entries) {
-            if (re.match(entry).hasMatch()) {
-                result.append(dir.filePath(entry));
-            }
-        }
+    const auto termCount = static_cast<quint32>(d->terms.size());
+    const auto bloomSize = qMax<quint32>(8, (termCount * TermIndex::BitsPerTerm + 7) / 8);
 
-        std::sort(result.begin(), result.end(), [](const QString &a, const QString &b) {
-            return QFileInfo(a).lastModified() < QFileInfo(b).lastModified();
+    auto data = QByteArray(TermIndex::Magic, 4);
+    data.append(static_cast<char>(TermIndex::Version));
+    data.append(static_cast<char>(TermIndex::HashCount));
+    data.append(2, '\0');
+
+    char number[8];
+    qToLittleEndian(bloomSize, number);
+    data.append(number, 4);
+
+    auto bloom = QByteArray(static_cast<int>(bloomSize), '\0');
+
+    // Sorted, so the same terms always give the same file
+    auto terms = d->terms.keys();
+    std::sort(terms.begin(), terms.end());
+
+    QByteArray termData;
+    qToLittleEndian(termCount, number);
+    termData.append(number, 4);
+
+    for (const auto &term : std::as_const(terms)) {
+        termIndexBits(term, bloomSize * 8, TermIndex::HashCount, [&bloom](quint32 bit) {
+            const auto i = static_cast<int>(bit / 8);
+            bloom[i] = static_cast<char>(bloom.at(i) | (1 << (bit % 8)));
         });
 
-        return result;
+        const auto utf8 = term.toUtf8();
+        qToLittleEndian(static_cast<quint16>(utf8.size()), number);
+        termData.append(number, 2);
+        termData.append(utf8);
+
+        const auto &ranges = d->terms[term];
+        qToLittleEndian(static_cast<quint32>(ranges.size()), number);
+        termData.append(number, 4);
+
+        for (const auto offset : ranges) {
+            qToLittleEndian(offset, number);
+            termData.append(number, 8);
+        }
     }
 
-    void removeOldFiles()
+    auto file = QSaveFile(indexFileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        std::cerr << "TermIndexWriter: Can't open index file: " << indexFileName.toStdString()
+                  << " error: " << file.errorString().toStdString() << std::endl;
+        return false;
+    }
+
+    file.write(data);
+    file.write(bloom);
+    file.write(termData);
+    return file.commit();
+}
+
+QTLOGGER_DECL_SPEC
+void TermIndexWriter::reset()
+{
+    d->terms.clear();
+    d->rangeCount = 0;
+    d->complete = true;
+}
+
+class TermIndexReader::TermIndexReaderPrivate
+{
+public:
+    // Parses the terms after the bloom filter, once
+    void loadTerms()
     {
-        if (m_maxFileCount <= 0)
+        const QMutexLocker locker(&mutex);
+
+        if (termsLoaded)
             return;
 
-        auto rotatedFiles = findRotatedFiles();
+        termsLoaded = true;
 
-        while (rotatedFiles.size() > m_maxFileCount - 1) {
-            const QString &oldestFile = rotatedFiles.first();
-            if (!QFile::remove(oldestFile)) {
-                std::cerr << "RotatingFileSink: Failed to remove old log file: "
-                          << oldestFile.toStdString() << std::endl;
-            }
-            rotatedFiles.removeFirst();
-        }
-    }
+        auto file = QFile(fileName);
+        if (!file.open(QIODevice::ReadOnly) || !file.seek(TermIndex::HeaderSize + bloom.size()))
+            return;
 
-    void rotate()
-    {
-        if (m_maxFileCount == 1)
+        const auto data = file.readAll();
+        const auto *p = data.constData();
+        const auto *end = p + data.size();
+
+        if (end - p < 4)
             return;
 
-        q_ptr->file()->close();
+        const auto count = qFromLittleEndian<quint32>(p);
+        p += 4;
 
-        const auto &currentFileName = q_ptr->file()->fileName();
-        const auto rotationDate = m_currentLogDate.isValid() ? m_currentLogDate : QDate::currentDate();
-        const auto nextIndex = findNextIndexForDate(rotationDate);
-        const auto rotatedFileName = generateRotatedFileName(rotationDate, nextIndex);
+        for (quint32 i = 0; i < count; ++i) {
+            if (end - p < 2)
+                return;
+            const auto size = qFromLittleEndian<quint16>(p);
+            p += 2;
 
-        if (!QFile::rename(currentFileName, rotatedFileName)) {
-            std::cerr << "RotatingFileSink: Failed to rename log file from "
-                      << currentFileName.toStdString() << " to "
-                      << rotatedFileName.toStdString() << std::endl;
-        } else if (m_compression) {
-            compressFile(rotatedFileName);
-        }
+            if (end - p < size + 4)
+                return;
+            const auto term = QString::fromUtf8(p, size);
+            p += size;
 
-        removeOldFiles();
+            const auto rangeCount = qFromLittleEndian<quint32>(p);
+            p += 4;
 
-        if (!q_ptr->file()->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-            std::cerr << "RotatingFileSink: Failed to reopen log file: "
-                      << currentFileName.toStdString() << std::endl;
-        }
+            if (static_cast<quint64>(end - p) < static_cast<quint64>(rangeCount) * 8)
+                return;
 
-        m_currentLogDate = QDate::currentDate();
-    }
+            QList<qint64> ranges;
+            ranges.reserve(static_cast<int>(rangeCount));
+            for (quint32 j = 0; j < rangeCount; ++j) {
+                ranges.append(qFromLittleEndian<qint64>(p));
+                p += 8;
+            }
 
-    RotatingFileSink *q_ptr;
+            terms.insert(term, ranges);
+        }
+    }
 
-    int m_maxFileSize;
-    int m_maxFileCount;
-    bool m_rotationOnStartup;
-    bool m_rotationDaily;
-    bool m_compression;
+    QString fileName;
+    int hashCount = 0;
+    QByteArray bloom;
 
-    QDate m_currentLogDate;
-    bool m_initialized = false;
+    QMutex mutex;
+    bool termsLoaded = false;
+    QHash<QString, QList<qint64>> terms;
 };
 
 QTLOGGER_DECL_SPEC
-RotatingFileSink::RotatingFileSink(const QString &path,
-                                   int maxFileSize,
-                                   int maxFileCount,
-                                   RotatingFileSink::Options options)
-    : FileSink(path)
-    , d(new RotatingFileSinkPrivate(this, maxFileSize, maxFileCount, options))
+TermIndexReader::TermIndexReader(const QString &indexFileName) : d(new TermIndexReaderPrivate)
 {
-}
+    d->fileName = indexFileName;
 
-QTLOGGER_DECL_SPEC
-RotatingFileSink::~RotatingFileSink() = default;
+    auto file = QFile(indexFileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
 
-QTLOGGER_DECL_SPEC
-void RotatingFileSink::send(const LogMessage &lmsg)
-{
-    d->init();
-    d->rotateIfNeeded(lmsg);
-    FileSink::send(lmsg);
-}
+    const auto header = file.read(TermIndex::HeaderSize);
+    if (header.size() != TermIndex::HeaderSize || !header.startsWith(TermIndex::Magic)
+        || static_cast<quint8>(header.at(4)) != TermIndex::Version) {
+        return;
+    }
 
-} // namespace QtLogger
+    const auto hashCount = static_cast<quint8>(header.at(5));
+    const auto bloomSize = qFromLittleEndian<quint32>(header.constData() + 8);
+    if (hashCount == 0 || bloomSize == 0 || bloomSize > static_cast<quint64>(file.size()))
+        return;
 
-// sdjournalsink.cpp
+    const auto bloom = file.read(bloomSize);
+    if (static_cast<quint32>(bloom.size()) != bloomSize)
+        return;
 
-#ifdef QTLOGGER_SDJOURNAL
+    d->hashCount = hashCount;
+    d->bloom = bloom;
+}
 
-#include <systemd/sd-journal.h>
+QTLOGGER_DECL_SPEC
+TermIndexReader::~TermIndexReader() = default;
 
-namespace QtLogger {
+QTLOGGER_DECL_SPEC
+bool TermIndexReader::isValid() const
+{
+    return !d->bloom.isEmpty();
+}
 
 QTLOGGER_DECL_SPEC
-void SdJournalSink::send(const LogMessage &lmsg)
+bool TermIndexReader::mayContain(const QString &term) const
 {
-    auto priority = LOG_DEBUG;
+    if (!isValid())
+        return true;
 
-    switch (lmsg.type()) {
-    case QtDebugMsg:
-        priority = LOG_DEBUG;
-        break;
-    case QtWarningMsg:
-        priority = LOG_WARNING;
-        break;
-    case QtCriticalMsg:
-        priority = LOG_ERR;
-        break;
-    case QtFatalMsg:
-        priority = LOG_EMERG;
-        break;
-    case QtInfoMsg:
-        priority = LOG_INFO;
-        break;
-    default:
-        return;
-    }
+    auto contains = true;
+    const auto &bloom = d->bloom;
+    termIndexBits(TermIndex::normalizeTerm(term), static_cast<quint32>(bloom.size()) * 8,
+                  d->hashCount, [&contains, &bloom](quint32 bit) {
+                      if (!(bloom.at(static_cast<int>(bit / 8)) & (1 << (bit % 8))))
+                          contains = false;
+                  });
+    return contains;
+}
 
-    const auto &file = QByteArrayLiteral("CODE_FILE=") + QByteArray(lmsg.file());
-    const auto &line = QByteArrayLiteral("CODE_LINE=") + QByteArray::number(lmsg.line());
+QTLOGGER_DECL_SPEC
+QList<qint64> TermIndexReader::ranges(const QString &term) const
+{
+    if (!isValid())
+        return {};
 
-    sd_journal_print_with_location(priority, file.constData(), line.constData(), lmsg.function(),
-                                   "%s", qPrintable(lmsg.formattedMessage()));
+    const auto normalized = TermIndex::normalizeTerm(term);
+    if (!mayContain(normalized))
+        return {};
 
-    sd_journal_send_with_location(file.constData(), line.constData(), lmsg.function(), "%s",
-                                  qPrintable(lmsg.formattedMessage()), "PRIORITY=%i", priority,
-                                  "CATEGORY=%s", lmsg.category(), NULL);
+    d->loadTerms();
+    return d->terms.value(normalized);
 }
 
 } // namespace QtLogger
 
-#endif // QTLOGGER_SDJOURNAL
+// threadinfo.cpp
 
-// signalsink.cpp
+#include <QHash>
+#include <QThread>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+#if defined(Q_OS_WIN)
+#    include <qt_windows.h>
+#elif defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+#    include <sys/prctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#elif defined(Q_OS_DARWIN)
+#    include <pthread.h>
+#endif
 
 namespace QtLogger {
 
-QTLOGGER_DECL_SPEC
-SignalSink::SignalSink(QObject *parent) : QObject(parent) { }
+namespace {
 
-QTLOGGER_DECL_SPEC
-void SignalSink::send(const LogMessage &lmsg)
+quint64 resolveThreadId()
 {
-    Q_EMIT message(lmsg);
+#if defined(Q_OS_WIN)
+    return GetCurrentThreadId();
+#elif defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+    return static_cast<quint64>(syscall(SYS_gettid));
+#elif defined(Q_OS_DARWIN)
+    uint64_t id = 0;
+    pthread_threadid_np(nullptr, &id);
+    return id;
+#else
+    return reinterpret_cast<quintptr>(QThread::currentThreadId());
+#endif
 }
 
-} // namespace QtLogger
+// Runs in the thread whose name is resolved
+QString resolveThreadName()
+{
+    QString name;
 
-// stderrsink.cpp
+#ifndef QTLOGGER_NO_THREAD
+    name = QThread::currentThread()->objectName();
+#endif
 
-#include <iostream>
+    if (name.isEmpty()) {
+#if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+        char systemName[16] = {};
+        if (prctl(PR_GET_NAME, systemName) == 0)
+            name = QString::fromLocal8Bit(systemName);
+#elif defined(Q_OS_DARWIN)
+        char systemName[64] = {};
+        if (pthread_getname_np(pthread_self(), systemName, sizeof(systemName)) == 0)
+            name = QString::fromLocal8Bit(systemName);
+#endif
+    }
 
-namespace QtLogger {
+    return name;
+}
 
-QTLOGGER_DECL_SPEC
-StdErrSink::StdErrSink(ColorMode colorMode)
-    : ColoredConsole(colorMode)
+} // namespace
+
+// Names of the threads by system id, written when a thread gets its id or is renamed and read
+// when messages are formatted
+class ThreadNameRegistry
 {
-    updateColorsEnabled();
-}
+public:
+    static ThreadNameRegistry &instance()
+    {
+        // Never destroyed, threads may still log during static destruction
+        static auto *registry = new ThreadNameRegistry();
+        return *registry;
+    }
+
+    QString name(quint64 id)
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&m_mutex);
+#endif
+        return m_names.value(id);
+    }
+
+    void setName(quint64 id, const QString &name)
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&m_mutex);
+#endif
+        m_names.insert(id, name);
+    }
+
+private:
+#ifndef QTLOGGER_NO_THREAD
+    QMutex m_mutex;
+#endif
+    QHash<quint64, QString> m_names;
+};
 
 QTLOGGER_DECL_SPEC
-void StdErrSink::send(const LogMessage &lmsg)
+quint64 ThreadInfo::currentId()
 {
-    if (m_colorsEnabled) {
-        std::cerr << qPrintable(colorize(lmsg.formattedMessage(), lmsg.type())) << std::endl;
-    } else {
-        std::cerr << qPrintable(lmsg.formattedMessage()) << std::endl;
-    }
+    static thread_local const quint64 id = [] {
+        const auto id = resolveThreadId();
+        ThreadNameRegistry::instance().setName(id, resolveThreadName());
+
+#ifndef QTLOGGER_NO_THREAD
+        // The signal passes the new name, so the QThread isn't read from the thread renaming it.
+        // An emptied object name keeps the last name, the system name can't be read from there.
+        QObject::connect(QThread::currentThread(), &QObject::objectNameChanged,
+                         [id](const QString &name) {
+                             if (!name.isEmpty())
+                                 ThreadNameRegistry::instance().setName(id, name);
+                         });
+#endif
+
+        return id;
+    }();
+
+    return id;
 }
 
 QTLOGGER_DECL_SPEC
-bool StdErrSink::flush()
+QString ThreadInfo::name(quint64 id)
 {
-    std::flush(std::cerr);
-    return true;
+    if (id == 0)
+        return QString();
+
+    return ThreadNameRegistry::instance().name(id);
 }
 
 QTLOGGER_DECL_SPEC
-bool StdErrSink::isTty() const
+void ThreadInfo::refreshCurrent()
 {
-    return isStdErrTty();
+    ThreadNameRegistry::instance().setName(currentId(), resolveThreadName());
 }
 
 } // namespace QtLogger
 
-// stdoutsink.cpp
+// timeindex.cpp
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QtEndian>
 
+#include <algorithm>
 #include <iostream>
 
 namespace QtLogger {
 
-QTLOGGER_DECL_SPEC
-StdOutSink::StdOutSink(ColorMode colorMode)
-    : ColoredConsole(colorMode)
-{
-    updateColorsEnabled();
-}
+namespace {
 
-QTLOGGER_DECL_SPEC
-void StdOutSink::send(const LogMessage &lmsg)
+QByteArray timeIndexHeader()
 {
-    if (m_colorsEnabled) {
-        std::cout << qPrintable(colorize(lmsg.formattedMessage(), lmsg.type())) << std::endl;
-    } else {
-        std::cout << qPrintable(lmsg.formattedMessage()) << std::endl;
-    }
+    auto header = QByteArray(TimeIndex::Magic, 4);
+    header.append(static_cast<char>(TimeIndex::Version));
+    header.append(3, '\0');
+    return header;
 }
 
-QTLOGGER_DECL_SPEC
-bool StdOutSink::flush()
+bool timeIndexHeaderValid(const QByteArray &header)
 {
-    std::flush(std::cout);
-    return true;
+    return header.size() == TimeIndex::HeaderSize && header.startsWith(TimeIndex::Magic)
+            && static_cast<quint8>(header.at(4)) == TimeIndex::Version;
 }
 
-QTLOGGER_DECL_SPEC
-bool StdOutSink::isTty() const
+TimeIndex::Entry timeIndexEntry(const char *data)
 {
-    return isStdOutTty();
+    return { qFromLittleEndian<qint64>(data), qFromLittleEndian<qint64>(data + 8) };
 }
 
-} // namespace QtLogger
-
-// syslogsink.cpp
+} // namespace
 
-#ifdef QTLOGGER_SYSLOG
+QTLOGGER_DECL_SPEC
+QList<TimeIndex::Entry> TimeIndex::readEntries(const QString &indexFileName)
+{
+    auto file = QFile(indexFileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
 
-#include <syslog.h>
+    if (!timeIndexHeaderValid(file.read(HeaderSize)))
+        return {};
 
-namespace QtLogger {
+    const auto data = file.readAll();
+    const auto count = data.size() / EntrySize;
 
-QTLOGGER_DECL_SPEC
-SyslogSink::SyslogSink(const QString &ident, int option, int facility)
-{
-    openlog(qPrintable(ident), option, facility);
-}
+    QList<Entry> entries;
+    entries.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        entries.append(timeIndexEntry(data.constData() + i * EntrySize));
+    }
 
-QTLOGGER_DECL_SPEC
-SyslogSink::~SyslogSink()
-{
-    closelog();
+    return entries;
 }
 
-QTLOGGER_DECL_SPEC
-void SyslogSink::send(const LogMessage &lmsg)
+class TimeIndexWriter::TimeIndexWriterPrivate
 {
-    auto priority = LOG_DEBUG;
-
-    switch (lmsg.type()) {
-    case QtDebugMsg:
-        priority = LOG_DEBUG;
-        break;
-    case QtWarningMsg:
-        priority = LOG_WARNING;
-        break;
-    case QtCriticalMsg:
-        priority = LOG_ERR;
-        break;
-    case QtFatalMsg:
-        priority = LOG_EMERG;
-        break;
-    case QtInfoMsg:
-        priority = LOG_INFO;
-        break;
-    default:
-        return;
+public:
+    TimeIndexWriterPrivate(int intervalBytes, int intervalMsecs)
+        : intervalBytes(qMax(intervalBytes, 0)), intervalMsecs(qMax(intervalMsecs, 0))
+    {
     }
 
-    QString formattedMessage;
-    if (qstrcmp(lmsg.category(), "default") == 0) {
-        formattedMessage = lmsg.message();
-    } else {
-        formattedMessage = QStringLiteral("%1: %2").arg(lmsg.category(), lmsg.message());
-    }
+    // Continues a valid index of the log file, or starts a new one
+    bool open(const QString &logFileName, qint64 offset)
+    {
+        file.setFileName(TimeIndex::indexFileName(logFileName));
+        hasEntry = false;
+
+        if (offset > 0 && file.open(QIODevice::ReadWrite)) {
+            const auto count = (file.size() - TimeIndex::HeaderSize) / TimeIndex::EntrySize;
+
+            if (count > 0 && timeIndexHeaderValid(file.read(TimeIndex::HeaderSize))) {
+                const auto end = TimeIndex::HeaderSize + count * TimeIndex::EntrySize;
+                file.seek(end - TimeIndex::EntrySize);
+                const auto last = timeIndexEntry(file.read(TimeIndex::EntrySize).constData());
+
+                // An entry beyond the end of the log means the log was replaced
+                if (last.offset <= offset) {
+                    file.resize(end);
+                    file.seek(end);
+                    lastTime = last.time;
+                    lastOffset = last.offset;
+                    hasEntry = true;
+                    return true;
+                }
+            }
 
-    syslog(priority, "%s", qPrintable(formattedMessage));
-}
+            file.close();
+        }
 
-} // namespace QtLogger
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::cerr << "TimeIndexWriter: Can't open index file: "
+                      << file.fileName().toStdString()
+                      << " error: " << file.errorString().toStdString() << std::endl;
+            return false;
+        }
 
-#endif // QTLOGGER_SYSLOG
+        file.write(timeIndexHeader());
+        return true;
+    }
 
-// windebugsink.cpp
+    void add(const QString &logFileName, const QDateTime &time, qint64 offset)
+    {
+        if (file.isOpen() && file.fileName() != TimeIndex::indexFileName(logFileName))
+            file.close();
 
-#ifdef Q_OS_WIN
+        if (!file.isOpen()) {
+            if (openFailed == logFileName || !open(logFileName, offset)) {
+                openFailed = logFileName;
+                return;
+            }
+            openFailed.clear();
+        }
 
-#include <qt_windows.h>
+        auto msecs = time.toMSecsSinceEpoch();
+        if (hasEntry)
+            msecs = qMax(msecs, lastTime);
 
-namespace QtLogger {
+        if (hasEntry && offset - lastOffset < intervalBytes && msecs - lastTime < intervalMsecs)
+            return;
 
-QTLOGGER_DECL_SPEC
-void WinDebugSink::send(const LogMessage &lmsg)
-{
-    auto formattedMessage = lmsg.formattedMessage() + u'\n';
-    OutputDebugString(reinterpret_cast<const wchar_t *>(formattedMessage.utf16()));
-}
+        char entry[TimeIndex::EntrySize];
+        qToLittleEndian(msecs, entry);
+        qToLittleEndian(offset, entry + 8);
 
-} // namespace QtLogger
+        // Flushed right away, so readers of a live log see the entry with the message
+        file.write(entry, sizeof(entry));
+        file.flush();
 
-#endif
+        lastTime = msecs;
+        lastOffset = offset;
+        hasEntry = true;
+    }
 
-// sortedpipeline.cpp
+    int intervalBytes;
+    int intervalMsecs;
 
-namespace QtLogger {
+    QFile file;
+    QString openFailed;
+    qint64 lastTime = 0;
+    qint64 lastOffset = 0;
+    bool hasEntry = false;
+};
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::insertBetweenNearLeft(const QSet<HandlerType> &leftType,
-                                           const QSet<HandlerType> &rightType,
-                                           const HandlerPtr &handler)
+TimeIndexWriter::TimeIndexWriter(int intervalBytes, int intervalMsecs)
+    : d(new TimeIndexWriterPrivate(intervalBytes, intervalMsecs))
 {
-    auto firstRight =
-            std::find_if(handlers().begin(), handlers().end(),
-                         [&rightType](const auto &x) { return rightType.contains(x->type()); });
+}
 
-    auto lastLeft = std::find_if(firstRight, handlers().begin(), [&leftType](const HandlerPtr &x) {
-        return leftType.contains(x->type());
-    });
+QTLOGGER_DECL_SPEC
+TimeIndexWriter::~TimeIndexWriter() = default;
 
-    handlers().insert(lastLeft, handler);
+QTLOGGER_DECL_SPEC
+int TimeIndexWriter::intervalBytes() const
+{
+    return d->intervalBytes;
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::insertBetweenNearRight(const QSet<HandlerType> &leftType,
-                                            const QSet<HandlerType> &rightType,
-                                            const HandlerPtr &handler)
+int TimeIndexWriter::intervalMsecs() const
 {
-    auto lastLeft =
-            std::find_if(handlers().end(), handlers().begin(),
-                         [&leftType](const HandlerPtr &x) { return leftType.contains(x->type()); });
-
-    auto firstRight = std::find_if(lastLeft, handlers().end(), [&rightType](const auto &x) {
-        return rightType.contains(x->type());
-    });
-
-    handlers().insert(firstRight, handler);
+    return d->intervalMsecs;
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::clear(HandlerType type)
+void TimeIndexWriter::add(const QString &logFileName, const QDateTime &time, qint64 offset)
 {
-    QMutableListIterator<HandlerPtr> iter(handlers());
-
-    while (iter.hasNext()) {
-        if (iter.next()->type() == type) {
-            iter.remove();
-        }
-    }
+    d->add(logFileName, time, offset);
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::clear()
+qint64 TimeIndexWriter::lastOffset() const
 {
-    Pipeline::clear();
+    return d->hasEntry ? d->lastOffset : -1;
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::appendAttrHandler(const AttrHandlerPtr &attrHandler)
+void TimeIndexWriter::close()
 {
-    if (attrHandler.isNull())
-        return;
-
-    insertBetweenNearLeft({ HandlerType::AttrHandler },
-                          { HandlerType::Filter, HandlerType::Formatter, HandlerType::Sink },
-                          attrHandler);
+    d->file.close();
+    d->openFailed.clear();
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::clearAttrHandlers()
+bool TimeIndexWriter::flush()
 {
-    clear(HandlerType::AttrHandler);
+    return !d->file.isOpen() || d->file.flush();
 }
 
-QTLOGGER_DECL_SPEC
-void SortedPipeline::appendFilter(const FilterPtr &filter)
+class TimeIndexReader::TimeIndexReaderPrivate
 {
-    if (filter.isNull())
-        return;
+public:
+    explicit TimeIndexReaderPrivate(const QString &logFileName) : logFileName(logFileName) { }
 
-    insertBetweenNearLeft({ HandlerType::AttrHandler, HandlerType::Filter },
-                          { HandlerType::Formatter, HandlerType::Sink }, filter);
-}
+    static bool isCompressed(const QString &fileName)
+    {
+        return fileName.endsWith(QStringLiteral(".gz"));
+    }
+
+    // The time index of a compressed file keeps the name of the uncompressed file
+    static QString indexFileName(const QString &fileName)
+    {
+        return TimeIndex::indexFileName(isCompressed(fileName) ? fileName.left(fileName.size() - 3)
+                                                               : fileName);
+    }
+
+    QStringList files() const
+    {
+        const auto fi = QFileInfo(logFileName);
+        const auto baseName = fi.completeBaseName();
+        const auto suffix = fi.suffix();
+
+        QString pattern;
+        if (suffix.isEmpty()) {
+            pattern = QStringLiteral("^%1\\.(\\d{4}-\\d{2}-\\d{2})\\.(\\d+)(\\.gz)?$")
+                              .arg(QRegularExpression::escape(baseName));
+        } else {
+            pattern = QStringLiteral("^%1\\.(\\d{4}-\\d{2}-\\d{2})\\.(\\d+)\\.%2(\\.gz)?$")
+                              .arg(QRegularExpression::escape(baseName),
+                                   QRegularExpression::escape(suffix));
+        }
+
+        const auto re = QRegularExpression(pattern);
+        const auto dir = fi.absoluteDir();
+
+        struct Rotated
+        {
+            QString date;
+            int index;
+            QString path;
+        };
+        QList<Rotated> rotated;
+
+        const auto entries = dir.entryList(QDir::Files);
+        for (const auto &entry : entries) {
+            const auto match = re.match(entry);
+            // Only compressed files with a block index can be read without decompressing them
+            if (match.hasMatch()
+                && (match.captured(3).isEmpty()
+                    || dir.exists(SeekableGzip::indexFileName(entry)))) {
+                rotated.append(
+                        { match.captured(1), match.captured(2).toInt(), dir.filePath(entry) });
+            }
+        }
+
+        // Rotated files are numbered per date, so their order does not depend on the file times
+        std::sort(rotated.begin(), rotated.end(), [](const Rotated &a, const Rotated &b) {
+            return a.date != b.date ? a.date < b.date : a.index < b.index;
+        });
+
+        QStringList result;
+        for (const auto &r : std::as_const(rotated)) {
+            result.append(r.path);
+        }
+
+        if (fi.exists())
+            result.append(fi.absoluteFilePath());
+
+        return result;
+    }
+
+    void start(const QStringList &fileList, int index, qint64 offset)
+    {
+        device.reset();
+        openedFiles = fileList;
+        fileIndex = index;
+        started = true;
+
+        if (fileIndex < openedFiles.size()) {
+            const auto &fileName = openedFiles.at(fileIndex);
+            if (isCompressed(fileName))
+                device.reset(new SeekableGzipFile(fileName));
+            else
+                device.reset(new QFile(fileName));
+
+            if (device->open(QIODevice::ReadOnly))
+                device->seek(offset);
+        }
+    }
+
+    // Moves to the next file with unread data, returns false at the end of the last file
+    bool advance()
+    {
+        if (!started)
+            start(files(), 0, 0);
+
+        while (!device || !device->isOpen() || device->atEnd()) {
+            if (fileIndex + 1 >= openedFiles.size())
+                return false;
+            start(openedFiles, fileIndex + 1, 0);
+        }
+
+        return true;
+    }
+
+    QString logFileName;
+
+    QStringList openedFiles;
+    int fileIndex = 0;
+    QScopedPointer<QIODevice> device;
+    bool started = false;
+};
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::clearFilters()
+TimeIndexReader::TimeIndexReader(const QString &logFileName)
+    : d(new TimeIndexReaderPrivate(logFileName))
 {
-    clear(HandlerType::Filter);
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::setFormatter(const FormatterPtr &formatter)
-{
-    if (formatter.isNull())
-        return;
-
-    clearFormatters();
+TimeIndexReader::~TimeIndexReader() = default;
 
-    insertBetweenNearRight({ HandlerType::AttrHandler, HandlerType::Filter }, { HandlerType::Sink },
-                           formatter);
+QTLOGGER_DECL_SPEC
+QStringList TimeIndexReader::files() const
+{
+    return d->files();
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::clearFormatters()
+bool TimeIndexReader::seek(const QDateTime &time)
 {
-    clear(HandlerType::Formatter);
+    const auto fileList = files();
+    if (fileList.isEmpty()) {
+        d->start(fileList, 0, 0);
+        return false;
+    }
+
+    const auto target = time.toMSecsSinceEpoch();
+
+    // The newest file with an entry before the time is read from the last such entry on. Files
+    // without one start after the time, or can't be placed without their index, e.g. the active
+    // file before its first entry is flushed, so they are only read after it.
+    for (auto i = fileList.size() - 1; i >= 0; --i) {
+        const auto entries = TimeIndex::readEntries(d->indexFileName(fileList.at(i)));
+        if (entries.isEmpty() || entries.first().time >= target)
+            continue;
+
+        const auto it = std::lower_bound(entries.cbegin(), entries.cend(), target,
+                                         [](const TimeIndex::Entry &entry, qint64 msecs) {
+                                             return entry.time < msecs;
+                                         });
+
+        d->start(fileList, i, std::prev(it)->offset);
+        return d->device && d->device->isOpen();
+    }
+
+    // The time is before all entries, or no file can be placed
+    d->start(fileList, 0, 0);
+    return d->device && d->device->isOpen();
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::appendSink(const SinkPtr &sink)
+QString TimeIndexReader::fileName() const
 {
-    append(sink);
+    return d->device ? d->openedFiles.at(d->fileIndex) : QString();
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::clearSinks()
+qint64 TimeIndexReader::offset() const
 {
-    clear(HandlerType::Sink);
+    return d->device && d->device->isOpen() ? d->device->pos() : 0;
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::appendPipeline(const PipelinePtr &pipeline)
+bool TimeIndexReader::atEnd()
 {
-    append(pipeline);
+    return !d->advance();
 }
 
 QTLOGGER_DECL_SPEC
-void SortedPipeline::clearPipelines()
+QByteArray TimeIndexReader::readLine()
 {
-    clear(HandlerType::Pipeline);
+    if (!d->advance())
+        return {};
+
+    return d->device->readLine();
 }
 
 } // namespace QtLogger
@@ -0,0 +1,46 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "backtraceattr.h"
+
+#include <QStringList>
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+BacktraceAttr::BacktraceAttr(QtMsgType minLevel, int depth, const QString &name)
+    : m_minLevel(minLevel), m_depth(depth), m_name(name), m_levelFilter(minLevel)
+{
+    Backtrace::enableCapture(minLevel, depth);
+}
+
+QTLOGGER_DECL_SPEC
+BacktraceAttr::~BacktraceAttr()
+{
+    Backtrace::releaseCapture(m_minLevel, m_depth);
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash BacktraceAttr::attributes(const LogMessage &lmsg)
+{
+    if (!m_levelFilter.filter(lmsg))
+        return {};
+
+    // Capturing here would record the stack of the logger thread for an asynchronous logger
+    const auto addresses = lmsg.backtrace();
+    if (addresses.isEmpty())
+        return {};
+
+    // The logger captures the largest depth of all handlers
+    const auto count = qMin(static_cast<int>(addresses.size()), m_depth);
+
+    QStringList frames;
+    frames.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        frames.append(Backtrace::formatFrame(Backtrace::resolve(addresses.at(i))));
+    }
+
+    return { { m_name, frames.join(QLatin1Char('\n')) } };
+}
+
+} // namespace QtLogger
@@ -0,0 +1,45 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QSharedPointer>
+
+#include "../attrhandler.h"
+#include "../backtrace.h"
+#include "../filters/levelfilter.h"
+#include "../logger_global.h"
+
+namespace QtLogger {
+
+// Symbolized backtrace of the messages at or above a level, one frame per line with the innermost
+// call first. The handler enables the capture in the logger while it exists (see backtrace.h):
+// the thread that logs the message only records the raw return addresses, they are resolved here,
+// in the thread of the logger, through a cache of address to symbol. Messages that reach the handler
+// without addresses, e.g. not logged through the logger, get no backtrace.
+class QTLOGGER_EXPORT BacktraceAttr : public AttrHandler
+{
+public:
+    explicit BacktraceAttr(QtMsgType minLevel = QtCriticalMsg,
+                           int depth = Backtrace::DefaultDepth,
+                           const QString &name = QStringLiteral("backtrace"));
+    ~BacktraceAttr() override;
+
+    QVariantHash attributes(const LogMessage &lmsg) override;
+
+    QtMsgType minLevel() const { return m_minLevel; }
+    int depth() const { return m_depth; }
+    QString name() const { return m_name; }
+
+private:
+    Q_DISABLE_COPY(BacktraceAttr)
+
+    QtMsgType m_minLevel;
+    int m_depth;
+    QString m_name;
+    LevelFilter m_levelFilter;
+};
+
+using BacktraceAttrPtr = QSharedPointer<BacktraceAttr>;
+
+} // namespace QtLogger
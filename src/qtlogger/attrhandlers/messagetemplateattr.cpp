@@ -0,0 +1,188 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "messagetemplateattr.h"
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutexLocker>
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+// Splitting on single spaces keeps empty tokens, so joining with a space restores the message
+QStringList tokenize(const QString &message)
+{
+    return message.split(QLatin1Char(' '));
+}
+
+bool hasDigit(const QString &token)
+{
+    for (const auto &ch : token) {
+        if (ch.isDigit())
+            return true;
+    }
+    return false;
+}
+
+// Tokens with digits are likely parameters, they must not split the templates into groups
+QString groupKey(const QStringList &tokens)
+{
+    const auto &first = tokens.first();
+    return hasDigit(first) ? MessageTemplateAttr::wildcard() : first;
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+MessageTemplateAttr::MessageTemplateAttr(const QString &name, double similarityThreshold,
+                                         int maxTemplates)
+    : m_name(name), m_similarityThreshold(similarityThreshold), m_maxTemplates(maxTemplates)
+{
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash MessageTemplateAttr::attributes(const LogMessage &lmsg)
+{
+    const auto tokens = tokenize(lmsg.message());
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&m_mutex);
+#endif
+
+    const auto id = match(tokens);
+    if (id < 0)
+        return {};
+
+    return { { m_name, id } };
+}
+
+QTLOGGER_DECL_SPEC
+int MessageTemplateAttr::match(const QStringList &tokens)
+{
+    const auto wildcard = MessageTemplateAttr::wildcard();
+    const auto key = groupKey(tokens);
+    const auto group = m_groups.value(tokens.size()).value(key);
+
+    int bestId = -1;
+    double bestSimilarity = -1.0;
+    int bestWildcards = -1;
+
+    for (const auto id : std::as_const(group)) {
+        const auto &tmpl = m_templates.at(id);
+
+        int same = 0;
+        int wildcards = 0;
+        for (int i = 0; i < tokens.size(); ++i) {
+            if (tmpl.at(i) == wildcard)
+                ++wildcards;
+            else if (tmpl.at(i) == tokens.at(i))
+                ++same;
+        }
+
+        const auto similarity = static_cast<double>(same) / tokens.size();
+        if (similarity > bestSimilarity
+            || (similarity == bestSimilarity && wildcards > bestWildcards)) {
+            bestId = id;
+            bestSimilarity = similarity;
+            bestWildcards = wildcards;
+        }
+    }
+
+    if (bestId >= 0 && bestSimilarity >= m_similarityThreshold) {
+        auto &tmpl = m_templates[bestId];
+        for (int i = 0; i < tokens.size(); ++i) {
+            if (tmpl.at(i) != tokens.at(i))
+                tmpl[i] = wildcard;
+        }
+        ++m_counts[bestId];
+        return bestId;
+    }
+
+    if (m_templates.size() >= m_maxTemplates || group.size() >= MaxTemplatesPerGroup)
+        return -1;
+
+    const auto id = static_cast<int>(m_templates.size());
+    m_templates.append(tokens);
+    m_counts.append(1);
+    m_groups[tokens.size()][key].append(id);
+
+    return id;
+}
+
+QTLOGGER_DECL_SPEC
+QList<MessageTemplateAttr::Template> MessageTemplateAttr::templates() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&m_mutex);
+#endif
+
+    QList<Template> result;
+    result.reserve(m_templates.size());
+
+    for (int id = 0; id < m_templates.size(); ++id) {
+        Template tmpl;
+        tmpl.id = id;
+        tmpl.text = m_templates.at(id).join(QLatin1Char(' '));
+        tmpl.count = m_counts.at(id);
+        result.append(tmpl);
+    }
+
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+QString MessageTemplateAttr::templateText(int id) const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&m_mutex);
+#endif
+
+    if (id < 0 || id >= m_templates.size())
+        return {};
+
+    return m_templates.at(id).join(QLatin1Char(' '));
+}
+
+QTLOGGER_DECL_SPEC
+std::optional<QStringList> MessageTemplateAttr::parameters(const QString &templateText,
+                                                           const QString &message)
+{
+    const auto wildcard = MessageTemplateAttr::wildcard();
+    const auto tmpl = tokenize(templateText);
+    const auto tokens = tokenize(message);
+
+    if (tmpl.size() != tokens.size())
+        return std::nullopt;
+
+    QStringList result;
+    result.reserve(tmpl.size());
+
+    for (int i = 0; i < tmpl.size(); ++i) {
+        if (tmpl.at(i) == wildcard)
+            result.append(tokens.at(i));
+        else if (tmpl.at(i) != tokens.at(i))
+            return std::nullopt;
+    }
+
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+QString MessageTemplateAttr::applyParameters(const QString &templateText,
+                                             const QStringList &parameters)
+{
+    const auto wildcard = MessageTemplateAttr::wildcard();
+    auto tokens = tokenize(templateText);
+
+    int param = 0;
+    for (auto &token : tokens) {
+        if (token == wildcard && param < parameters.size())
+            token = parameters.at(param++);
+    }
+
+    return tokens.join(QLatin1Char(' '));
+}
+
+} // namespace QtLogger
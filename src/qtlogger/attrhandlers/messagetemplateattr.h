@@ -0,0 +1,80 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <optional>
+
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+#include <QStringList>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#endif
+
+#include "../attrhandler.h"
+#include "../logger_global.h"
+
+namespace QtLogger {
+
+// Online message template mining in the spirit of the Drain algorithm. Messages are split into
+// space separated tokens, routed by token count and first token to a small group of templates and
+// merged into the most similar one; tokens that differ become the <*> wildcard. The id of the
+// matched template is attached to the message, the variable tokens are its parameters.
+class QTLOGGER_EXPORT MessageTemplateAttr : public AttrHandler
+{
+public:
+    struct Template
+    {
+        int id = -1;
+        QString text;
+        quint64 count = 0;
+    };
+
+    static constexpr double DefaultSimilarityThreshold = 0.4;
+    static constexpr int DefaultMaxTemplates = 1000;
+    static constexpr int MaxTemplatesPerGroup = 100;
+
+    explicit MessageTemplateAttr(const QString &name = QStringLiteral("template_id"),
+                                 double similarityThreshold = DefaultSimilarityThreshold,
+                                 int maxTemplates = DefaultMaxTemplates);
+
+    QVariantHash attributes(const LogMessage &lmsg) override;
+
+    QString name() const { return m_name; }
+
+    // Snapshot of all templates with their message counts, ordered by id
+    QList<Template> templates() const;
+    QString templateText(int id) const;
+
+    static QString wildcard() { return QStringLiteral("<*>"); }
+
+    // Values of the wildcard tokens of the template in the message, or nothing if the message
+    // doesn't match the template
+    static std::optional<QStringList> parameters(const QString &templateText,
+                                                 const QString &message);
+    // Message with the wildcard tokens of the template replaced by the parameters
+    static QString applyParameters(const QString &templateText, const QStringList &parameters);
+
+private:
+    int match(const QStringList &tokens);
+
+    QString m_name;
+    double m_similarityThreshold;
+    int m_maxTemplates;
+
+    QList<QStringList> m_templates;
+    QList<quint64> m_counts;
+    // token count -> first token -> template ids
+    QHash<int, QHash<QString, QList<int>>> m_groups;
+
+#ifndef QTLOGGER_NO_THREAD
+    mutable QMutex m_mutex;
+#endif
+};
+
+using MessageTemplateAttrPtr = QSharedPointer<MessageTemplateAttr>;
+
+} // namespace QtLogger
@@ -9,7 +9,7 @@ QTLOGGER_DECL_SPEC
 QVariantHash SeqNumberAttr::attributes(const LogMessage &lmsg)
 {
     Q_UNUSED(lmsg)
-    return { { m_name, m_count++ } };
+    return { { m_name, m_count.fetchAndAddOrdered(1) } };
 }
 
 } // namespace QtLogger
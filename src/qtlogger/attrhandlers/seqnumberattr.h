@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QAtomicInt>
 #include <QSharedPointer>
 
 #include "../attrhandler.h"
@@ -15,7 +16,7 @@ public:
 
 private:
     QString m_name;
-    int m_count = 0;
+    QAtomicInt m_count;
 };
 
 using SeqNumberAttrPtr = QSharedPointer<SeqNumberAttr>;
@@ -0,0 +1,299 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "backtrace.h"
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QPair>
+#include <QVarLengthArray>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+#if defined(Q_OS_WIN)
+#    include <qt_windows.h>
+#elif !defined(Q_OS_ANDROID) && __has_include(<execinfo.h>)
+#    include <execinfo.h>
+#    define QTLOGGER_BACKTRACE_EXECINFO
+#endif
+
+#if !defined(Q_OS_WIN) && __has_include(<dlfcn.h>)
+#    include <dlfcn.h>
+#    define QTLOGGER_BACKTRACE_DLADDR
+#endif
+
+#if __has_include(<cxxabi.h>)
+#    include <cxxabi.h>
+#    include <cstdlib>
+#    define QTLOGGER_BACKTRACE_DEMANGLE
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int BacktraceDisabled = 5;
+
+QAtomicInt g_backtraceMinPriority(BacktraceDisabled);
+QAtomicInt g_backtraceDepth(0);
+
+// Capture requests of the handlers, the atomics above hold the lowest level and largest depth
+struct BacktraceRequests
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    QList<QPair<int, int>> requests; // priority, depth
+
+    void apply()
+    {
+        auto minPriority = BacktraceDisabled;
+        auto depth = 0;
+        for (const auto &request : std::as_const(requests)) {
+            minPriority = qMin(minPriority, request.first);
+            depth = qMax(depth, request.second);
+        }
+        g_backtraceMinPriority.storeRelease(minPriority);
+        g_backtraceDepth.storeRelease(depth);
+    }
+};
+
+BacktraceRequests &backtraceRequests()
+{
+    static BacktraceRequests requests;
+    return requests;
+}
+
+struct BacktraceCache
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    QHash<quintptr, Backtrace::Frame> frames;
+};
+
+BacktraceCache &backtraceCache()
+{
+    static BacktraceCache cache;
+    return cache;
+}
+
+Backtrace::Frame resolveUncached(quintptr address)
+{
+    Backtrace::Frame frame;
+    frame.address = address;
+
+#if defined(QTLOGGER_BACKTRACE_DLADDR)
+    // A return address points after the call, which may already be the next function
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void *>(address - 1), &info) == 0)
+        return frame;
+
+    if (info.dli_fname)
+        frame.module = QString::fromLocal8Bit(info.dli_fname);
+    frame.moduleAddress = reinterpret_cast<quintptr>(info.dli_fbase);
+
+    if (info.dli_sname) {
+        frame.symbolAddress = reinterpret_cast<quintptr>(info.dli_saddr);
+        frame.function = QString::fromLatin1(info.dli_sname);
+
+#    if defined(QTLOGGER_BACKTRACE_DEMANGLE)
+        auto status = 0;
+        auto demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        if (status == 0 && demangled)
+            frame.function = QString::fromUtf8(demangled);
+        std::free(demangled);
+#    endif
+    }
+#elif defined(Q_OS_WIN)
+    HMODULE module = nullptr;
+    if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS
+                                    | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                            reinterpret_cast<LPCWSTR>(address - 1), &module))
+        return frame;
+
+    wchar_t path[MAX_PATH];
+    const auto size = GetModuleFileNameW(module, path, MAX_PATH);
+    frame.module = QString::fromWCharArray(path, static_cast<int>(size));
+    frame.moduleAddress = reinterpret_cast<quintptr>(module);
+#endif
+
+    return frame;
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+Q_NEVER_INLINE QList<quintptr> Backtrace::capture(int depth, int skip)
+{
+    depth = qBound(0, depth, MaxDepth);
+    skip = qBound(0, skip, MaxDepth);
+
+    QList<quintptr> addresses;
+    if (depth == 0)
+        return addresses;
+
+    // One more for the frame of capture()
+    QVarLengthArray<void *, DefaultDepth + 8> frames(depth + skip + 1);
+
+#if defined(QTLOGGER_BACKTRACE_EXECINFO)
+    const auto count = ::backtrace(frames.data(), frames.size());
+#elif defined(Q_OS_WIN)
+    const auto count = static_cast<int>(
+            CaptureStackBackTrace(0, static_cast<DWORD>(frames.size()), frames.data(), nullptr));
+#else
+    const auto count = 0;
+#endif
+
+    addresses.reserve(qMax(count - skip - 1, 0));
+    for (int i = skip + 1; i < count; ++i) {
+        addresses.append(reinterpret_cast<quintptr>(frames.at(i)));
+    }
+
+    return addresses;
+}
+
+QTLOGGER_DECL_SPEC
+void Backtrace::attach(LogMessage &lmsg, int skip)
+{
+    if (!isCaptureEnabled(lmsg.type()) || lmsg.hasBacktrace())
+        return;
+
+    // Without the frame of attach()
+    const auto addresses = capture(g_backtraceDepth.loadAcquire(), skip + 1);
+    if (!addresses.isEmpty())
+        lmsg.setBacktrace(addresses);
+}
+
+QTLOGGER_DECL_SPEC
+void Backtrace::enableCapture(QtMsgType minLevel, int depth)
+{
+    auto &requests = backtraceRequests();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&requests.mutex);
+#endif
+    requests.requests.append({ qtMsgTypePriority(minLevel), qBound(0, depth, MaxDepth) });
+    requests.apply();
+}
+
+QTLOGGER_DECL_SPEC
+void Backtrace::releaseCapture(QtMsgType minLevel, int depth)
+{
+    auto &requests = backtraceRequests();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&requests.mutex);
+#endif
+    const auto index = requests.requests.indexOf(
+            { qtMsgTypePriority(minLevel), qBound(0, depth, MaxDepth) });
+    if (index < 0)
+        return;
+    requests.requests.removeAt(index);
+    requests.apply();
+}
+
+QTLOGGER_DECL_SPEC
+void Backtrace::disableCapture()
+{
+    auto &requests = backtraceRequests();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&requests.mutex);
+#endif
+    requests.requests.clear();
+    requests.apply();
+}
+
+QTLOGGER_DECL_SPEC
+bool Backtrace::isCaptureEnabled(QtMsgType type)
+{
+    return qtMsgTypePriority(type) >= g_backtraceMinPriority.loadAcquire();
+}
+
+QTLOGGER_DECL_SPEC
+Backtrace::Frame Backtrace::resolve(quintptr address)
+{
+    auto &cache = backtraceCache();
+
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&cache.mutex);
+#endif
+        const auto it = cache.frames.constFind(address);
+        if (it != cache.frames.cend())
+            return it.value();
+    }
+
+    // Resolved without the lock, two threads may resolve the same address at worst
+    const auto frame = resolveUncached(address);
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&cache.mutex);
+#endif
+
+    // Addresses of unloaded modules may be reused, so the cache is bounded rather than permanent
+    if (cache.frames.size() >= MaxCacheSize)
+        cache.frames.clear();
+    cache.frames.insert(address, frame);
+
+    return frame;
+}
+
+QTLOGGER_DECL_SPEC
+QList<Backtrace::Frame> Backtrace::resolve(const QList<quintptr> &addresses)
+{
+    QList<Frame> frames;
+    frames.reserve(addresses.size());
+    for (const auto address : addresses) {
+        frames.append(resolve(address));
+    }
+    return frames;
+}
+
+QTLOGGER_DECL_SPEC
+QString Backtrace::formatFrame(const Frame &frame)
+{
+    QString text;
+
+    if (!frame.function.isEmpty()) {
+        text = frame.function;
+        if (frame.symbolAddress && frame.address >= frame.symbolAddress) {
+            text += QStringLiteral("+0x")
+                    + QString::number(static_cast<qulonglong>(frame.address - frame.symbolAddress),
+                                      16);
+        }
+    } else {
+        text = QStringLiteral("0x") + QString::number(static_cast<qulonglong>(frame.address), 16);
+    }
+
+    if (!frame.module.isEmpty()) {
+        const auto slash = qMax(frame.module.lastIndexOf(QLatin1Char('/')),
+                                frame.module.lastIndexOf(QLatin1Char('\\')));
+        text += QStringLiteral(" (") + frame.module.mid(slash + 1) + QLatin1Char(')');
+    }
+
+    return text;
+}
+
+QTLOGGER_DECL_SPEC
+int Backtrace::cacheSize()
+{
+    auto &cache = backtraceCache();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&cache.mutex);
+#endif
+    return static_cast<int>(cache.frames.size());
+}
+
+QTLOGGER_DECL_SPEC
+void Backtrace::clearCache()
+{
+    auto &cache = backtraceCache();
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&cache.mutex);
+#endif
+    cache.frames.clear();
+}
+
+} // namespace QtLogger
@@ -0,0 +1,74 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QList>
+#include <QString>
+
+#include "logger_global.h"
+#include "logmessage.h"
+
+/*
+ * Backtraces in two steps:
+ *
+ *   capture  - the raw return addresses of the calling thread, only unwinding the stack. The
+ *              logger attaches them to messages at or above the capture level before the message
+ *              leaves the thread that logged it.
+ *   resolve  - function and module of every address, looked up once and then served from a
+ *              process wide cache. Done by BacktraceAttr and SentryFormatter, which run in the
+ *              thread of the logger.
+ *
+ * Addresses are captured with backtrace() on glibc and macOS and CaptureStackBackTrace() on
+ * Windows, elsewhere backtraces are empty. Function names need exported symbols (-rdynamic on
+ * Linux), on Windows only the module is resolved.
+ */
+
+namespace QtLogger {
+
+namespace Backtrace {
+
+constexpr int DefaultDepth = 32;
+constexpr int MaxDepth = 256;
+constexpr int MaxCacheSize = 8192;
+
+struct Frame
+{
+    quintptr address = 0;
+    QString function;
+    QString module;
+    quintptr symbolAddress = 0;
+    quintptr moduleAddress = 0;
+};
+
+// Raw return addresses of the calling thread, without the frame of capture() itself and the
+// skipped ones
+QTLOGGER_EXPORT QList<quintptr> capture(int depth = DefaultDepth, int skip = 0);
+
+// Captures the addresses into LogMessage::backtrace() when capturing is enabled for its type and
+// it has none. Called by the logger in the thread that logged the message.
+QTLOGGER_EXPORT void attach(LogMessage &lmsg, int skip = 0);
+
+// Messages at or above the level get a backtrace; with several requests the lowest level and the
+// largest depth are used. The capture is process wide: every message logged at or above the level
+// unwinds the stack of its thread, so a request for QtDebugMsg makes all logging slower. Every
+// enableCapture() is undone by a releaseCapture() with the same arguments, disableCapture() drops
+// all requests.
+QTLOGGER_EXPORT void enableCapture(QtMsgType minLevel = QtCriticalMsg, int depth = DefaultDepth);
+QTLOGGER_EXPORT void releaseCapture(QtMsgType minLevel = QtCriticalMsg, int depth = DefaultDepth);
+QTLOGGER_EXPORT void disableCapture();
+QTLOGGER_EXPORT bool isCaptureEnabled(QtMsgType type);
+
+// Function and module of the address, cached
+QTLOGGER_EXPORT Frame resolve(quintptr address);
+QTLOGGER_EXPORT QList<Frame> resolve(const QList<quintptr> &addresses);
+
+// "function+0x1f (module)", or the address for unknown functions
+QTLOGGER_EXPORT QString formatFrame(const Frame &frame);
+
+QTLOGGER_EXPORT int cacheSize();
+QTLOGGER_EXPORT void clearCache();
+
+} // namespace Backtrace
+
+} // namespace QtLogger
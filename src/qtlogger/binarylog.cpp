@@ -0,0 +1,664 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "binarylog.h"
+
+#include <QFile>
+#include <QHash>
+#include <QIODevice>
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int BinaryLogReadChunkSize = 64 * 1024;
+
+class BinaryLogCursor
+{
+public:
+    BinaryLogCursor(const QByteArray &data, int pos, int end)
+        : m_data(data), m_pos(pos), m_end(end)
+    {
+    }
+
+    bool ok() const { return m_ok; }
+    int pos() const { return m_pos; }
+    bool atEnd() const { return m_pos >= m_end; }
+
+    // A read failed because the data ended, not because it is damaged
+    bool truncated() const { return m_truncated; }
+
+    quint8 readByte()
+    {
+        if (!m_ok)
+            return 0;
+        if (m_pos >= m_end) {
+            m_ok = false;
+            m_truncated = true;
+            return 0;
+        }
+        return static_cast<quint8>(m_data.at(m_pos++));
+    }
+
+    quint64 readVarUInt()
+    {
+        quint64 value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const auto byte = readByte();
+            if (!m_ok)
+                return 0;
+            value |= static_cast<quint64>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+        m_ok = false;
+        return 0;
+    }
+
+    qint64 readVarInt()
+    {
+        const auto value = readVarUInt();
+        return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+    }
+
+    QByteArray readRaw(quint64 size)
+    {
+        if (!m_ok)
+            return {};
+        if (size > static_cast<quint64>(m_end - m_pos)) {
+            m_ok = false;
+            m_truncated = true;
+            return {};
+        }
+        const auto result = m_data.mid(m_pos, static_cast<int>(size));
+        m_pos += static_cast<int>(size);
+        return result;
+    }
+
+    QByteArray readBytes() { return readRaw(readVarUInt()); }
+
+    QString readString() { return QString::fromUtf8(readBytes()); }
+
+    QVariant readValue()
+    {
+        const auto tag = readByte();
+        if (!m_ok)
+            return {};
+
+        switch (tag) {
+        case BinaryLog::NullValue:
+            return {};
+        case BinaryLog::BoolValue:
+            return readByte() != 0;
+        case BinaryLog::IntValue:
+            return readVarInt();
+        case BinaryLog::UIntValue:
+            return readVarUInt();
+        case BinaryLog::DoubleValue: {
+            const auto raw = readRaw(sizeof(quint64));
+            if (!m_ok)
+                return {};
+            const auto bits = qFromLittleEndian<quint64>(raw.constData());
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+        case BinaryLog::StringValue:
+            return readString();
+        case BinaryLog::DateTimeValue:
+            return QDateTime::fromMSecsSinceEpoch(readVarInt());
+        case BinaryLog::BytesValue:
+            return readBytes();
+        default:
+            // Decoding can't continue after a value of unknown size
+            m_ok = false;
+            return {};
+        }
+    }
+
+private:
+    const QByteArray &m_data;
+    int m_pos;
+    int m_end;
+    bool m_ok = true;
+    bool m_truncated = false;
+};
+
+} // namespace
+
+class BinaryLogWriter::BinaryLogWriterPrivate
+{
+public:
+    QByteArray encode(const LogMessage &lmsg)
+    {
+        const auto time = lmsg.time().toMSecsSinceEpoch();
+
+        QByteArray out;
+        out.reserve(lmsg.message().size() + 32);
+
+        if (!m_headerWritten)
+            writeHeader(out, time);
+
+        const auto callsiteId = callsite(out, lmsg);
+        const auto threadId = thread(out, lmsg.qthreadptr());
+
+        int templateId = -1;
+        std::optional<QStringList> params;
+        if (messageTemplates && lmsg.hasAttribute(messageTemplates->name())) {
+            templateId = lmsg.attribute(messageTemplates->name()).toInt();
+            const auto text = messageTemplates->templateText(templateId);
+            params = MessageTemplateAttr::parameters(text, lmsg.message());
+            if (params)
+                writeTemplate(out, templateId, text);
+        }
+
+        const auto start = beginFrame(out, params ? BinaryLog::TemplatedRecordFrame
+                                                  : BinaryLog::RecordFrame);
+        BinaryLog::writeVarInt(out, time - m_lastTime);
+        out.append(static_cast<char>(lmsg.type()));
+        BinaryLog::writeVarUInt(out, callsiteId);
+        BinaryLog::writeVarUInt(out, threadId);
+        if (params) {
+            BinaryLog::writeVarUInt(out, static_cast<quint64>(templateId));
+            BinaryLog::writeVarUInt(out, static_cast<quint64>(params->size()));
+            for (const auto &param : std::as_const(*params)) {
+                BinaryLog::writeString(out, param);
+            }
+        } else {
+            BinaryLog::writeString(out, lmsg.message());
+        }
+
+        const auto attrs = lmsg.attributes();
+        BinaryLog::writeVarUInt(out, static_cast<quint64>(attrs.size()));
+        for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
+            BinaryLog::writeString(out, it.key());
+            BinaryLog::writeValue(out, it.value());
+        }
+        endFrame(out, start);
+
+        m_lastTime = time;
+
+        return out;
+    }
+
+    void reset() { m_headerWritten = false; }
+
+    MessageTemplateAttrPtr messageTemplates;
+    QVariantHash sessionAttributes;
+
+private:
+    // The payload is written after the kind, endFrame() inserts its length in front of it
+    static int beginFrame(QByteArray &out, BinaryLog::FrameKind kind)
+    {
+        out.append(static_cast<char>(kind));
+        return out.size();
+    }
+
+    static void endFrame(QByteArray &out, int start)
+    {
+        QByteArray length;
+        BinaryLog::writeVarUInt(length, static_cast<quint64>(out.size() - start));
+        out.insert(start, length);
+    }
+
+    void writeHeader(QByteArray &out, qint64 time)
+    {
+        m_callsites.clear();
+        m_threads.clear();
+        m_templates.clear();
+        m_lastTime = time;
+
+        out.append(static_cast<char>(BinaryLog::HeaderFrame));
+        out.append(BinaryLog::Magic, 4);
+        out.append(static_cast<char>(BinaryLog::Version));
+        BinaryLog::writeVarInt(out, time);
+
+        if (!sessionAttributes.isEmpty()) {
+            const auto start = beginFrame(out, BinaryLog::AttributesFrame);
+            BinaryLog::writeVarUInt(out, static_cast<quint64>(sessionAttributes.size()));
+            for (auto it = sessionAttributes.cbegin(); it != sessionAttributes.cend(); ++it) {
+                BinaryLog::writeString(out, it.key());
+                BinaryLog::writeValue(out, it.value());
+            }
+            endFrame(out, start);
+        }
+
+        m_headerWritten = true;
+    }
+
+    // Callsites are compared by content, the context pointers of a message copied to another
+    // thread point to its own buffers
+    quint64 callsite(QByteArray &out, const LogMessage &lmsg)
+    {
+        QByteArray key;
+        key.reserve(128);
+        key.append(lmsg.file()).append('\0');
+        key.append(lmsg.function()).append('\0');
+        key.append(lmsg.category()).append('\0');
+        key.append(QByteArray::number(lmsg.line()));
+
+        auto it = m_callsites.constFind(key);
+        if (it != m_callsites.constEnd())
+            return it.value();
+
+        const auto id = static_cast<quint64>(m_callsites.size());
+        m_callsites.insert(key, id);
+
+        const auto start = beginFrame(out, BinaryLog::CallsiteFrame);
+        BinaryLog::writeVarUInt(out, id);
+        BinaryLog::writeBytes(out, QByteArray(lmsg.file()));
+        BinaryLog::writeVarUInt(out, static_cast<quint64>(qMax(lmsg.line(), 0)));
+        BinaryLog::writeBytes(out, QByteArray(lmsg.function()));
+        BinaryLog::writeBytes(out, QByteArray(lmsg.category()));
+        endFrame(out, start);
+
+        return id;
+    }
+
+    // Templates are only generalized, the text is written again when it changed since the last use
+    void writeTemplate(QByteArray &out, int id, const QString &text)
+    {
+        auto it = m_templates.find(id);
+        if (it != m_templates.end() && it.value() == text)
+            return;
+
+        m_templates.insert(id, text);
+
+        const auto start = beginFrame(out, BinaryLog::TemplateFrame);
+        BinaryLog::writeVarUInt(out, static_cast<quint64>(id));
+        BinaryLog::writeString(out, text);
+        endFrame(out, start);
+    }
+
+    quint64 thread(QByteArray &out, quintptr qthreadptr)
+    {
+        auto it = m_threads.constFind(qthreadptr);
+        if (it != m_threads.constEnd())
+            return it.value();
+
+        const auto id = static_cast<quint64>(m_threads.size());
+        m_threads.insert(qthreadptr, id);
+
+        const auto start = beginFrame(out, BinaryLog::ThreadFrame);
+        BinaryLog::writeVarUInt(out, id);
+        BinaryLog::writeVarUInt(out, static_cast<quint64>(qthreadptr));
+        endFrame(out, start);
+
+        return id;
+    }
+
+    QHash<QByteArray, quint64> m_callsites;
+    QHash<quintptr, quint64> m_threads;
+    QHash<int, QString> m_templates;
+    qint64 m_lastTime = 0;
+    bool m_headerWritten = false;
+};
+
+QTLOGGER_DECL_SPEC
+BinaryLogWriter::BinaryLogWriter() : d(new BinaryLogWriterPrivate) { }
+
+QTLOGGER_DECL_SPEC
+BinaryLogWriter::~BinaryLogWriter() = default;
+
+QTLOGGER_DECL_SPEC
+QByteArray BinaryLogWriter::encode(const LogMessage &lmsg)
+{
+    return d->encode(lmsg);
+}
+
+QTLOGGER_DECL_SPEC
+void BinaryLogWriter::reset()
+{
+    d->reset();
+}
+
+QTLOGGER_DECL_SPEC
+void BinaryLogWriter::setMessageTemplates(const MessageTemplateAttrPtr &messageTemplates)
+{
+    d->messageTemplates = messageTemplates;
+}
+
+QTLOGGER_DECL_SPEC
+MessageTemplateAttrPtr BinaryLogWriter::messageTemplates() const
+{
+    return d->messageTemplates;
+}
+
+QTLOGGER_DECL_SPEC
+void BinaryLogWriter::setSessionAttributes(const QVariantHash &attributes)
+{
+    d->sessionAttributes = attributes;
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash BinaryLogWriter::sessionAttributes() const
+{
+    return d->sessionAttributes;
+}
+
+class BinaryLogReader::BinaryLogReaderPrivate
+{
+public:
+    struct Callsite
+    {
+        QByteArray file;
+        int line = 0;
+        QByteArray function;
+        QByteArray category;
+    };
+
+    enum class FrameResult { Message, Dictionary, Incomplete, Skipped, Damaged, Unsupported };
+
+    void init()
+    {
+        if (!device || !device->isOpen()) {
+            error = QStringLiteral("Device is not open");
+            return;
+        }
+
+        while (buffer.size() < 5 && readMore()) { }
+
+        if (buffer.size() < 5 || buffer.at(0) != BinaryLog::HeaderFrame
+            || !buffer.mid(1, 4).startsWith(BinaryLog::Magic)) {
+            error = QStringLiteral("Not a binary log");
+            return;
+        }
+
+        valid = true;
+    }
+
+    bool readMore()
+    {
+        if (pos > 0) {
+            buffer.remove(0, pos);
+            pos = 0;
+        }
+
+        const auto chunk = device->read(BinaryLogReadChunkSize);
+        if (chunk.isEmpty())
+            return false;
+
+        buffer.append(chunk);
+        return true;
+    }
+
+    static QByteArray headerMarker()
+    {
+        return QByteArray(1, BinaryLog::HeaderFrame) + BinaryLog::Magic;
+    }
+
+    // Moves to the next header at or after the position. Without one in the data read so far, the
+    // search continues in the next call.
+    bool resync(int from)
+    {
+        const auto marker = headerMarker();
+
+        for (;;) {
+            const auto index = static_cast<int>(buffer.indexOf(marker, from));
+            if (index >= 0) {
+                pos = index;
+                resyncing = false;
+                return true;
+            }
+
+            // Keeps the bytes that may be the start of a marker split between reads
+            pos = qMax(from, static_cast<int>(buffer.size() - marker.size()) + 1);
+            if (!readMore()) {
+                resyncing = true;
+                return false;
+            }
+            from = pos;
+        }
+    }
+
+    FrameResult parseHeader(BinaryLogCursor &cursor)
+    {
+        const auto magic = cursor.readRaw(4);
+        const auto version = cursor.readByte();
+        const auto baseTime = cursor.readVarInt();
+        if (!cursor.ok())
+            return cursor.truncated() ? FrameResult::Incomplete : FrameResult::Damaged;
+        if (!magic.startsWith(BinaryLog::Magic))
+            return FrameResult::Damaged;
+        if (version > BinaryLog::Version) {
+            error = QStringLiteral("Unsupported binary log version");
+            return FrameResult::Unsupported;
+        }
+
+        callsites.clear();
+        threads.clear();
+        templates.clear();
+        sessionAttributes.clear();
+        lastTime = baseTime;
+        pos = cursor.pos();
+        return FrameResult::Dictionary;
+    }
+
+    FrameResult parseFrame(std::optional<LogMessage> &result)
+    {
+        BinaryLogCursor cursor(buffer, pos, buffer.size());
+
+        const auto kind = static_cast<char>(cursor.readByte());
+        if (!cursor.ok())
+            return FrameResult::Incomplete;
+
+        if (kind == BinaryLog::HeaderFrame)
+            return parseHeader(cursor);
+
+        const auto length = cursor.readVarUInt();
+        if (!cursor.ok())
+            return cursor.truncated() ? FrameResult::Incomplete : FrameResult::Damaged;
+        if (length > BinaryLog::MaxFrameSize)
+            return FrameResult::Damaged;
+        if (length > static_cast<quint64>(buffer.size() - cursor.pos()))
+            return FrameResult::Incomplete;
+
+        const auto end = cursor.pos() + static_cast<int>(length);
+        BinaryLogCursor payload(buffer, cursor.pos(), end);
+
+        const auto frameResult = parsePayload(kind, payload, result);
+        if (frameResult == FrameResult::Damaged)
+            return frameResult;
+
+        // A frame cut short by a crash spans the header of the next session
+        const auto header = frameResult == FrameResult::Skipped
+                                ? static_cast<int>(buffer.indexOf(headerMarker(), pos + 1))
+                                : -1;
+        pos = header >= 0 && header < end ? header : end;
+        return frameResult;
+    }
+
+    // A payload that doesn't decode to exactly its length is skipped, the length or the payload is
+    // damaged
+    FrameResult parsePayload(char kind, BinaryLogCursor &cursor, std::optional<LogMessage> &result)
+    {
+        switch (kind) {
+        case BinaryLog::CallsiteFrame: {
+            const auto id = cursor.readVarUInt();
+            Callsite callsite;
+            callsite.file = cursor.readBytes();
+            callsite.line = static_cast<int>(cursor.readVarUInt());
+            callsite.function = cursor.readBytes();
+            callsite.category = cursor.readBytes();
+            if (!cursor.ok() || !cursor.atEnd())
+                return FrameResult::Skipped;
+            callsites.insert(id, callsite);
+            return FrameResult::Dictionary;
+        }
+        case BinaryLog::ThreadFrame: {
+            const auto id = cursor.readVarUInt();
+            const auto qthreadptr = cursor.readVarUInt();
+            if (!cursor.ok() || !cursor.atEnd())
+                return FrameResult::Skipped;
+            threads.insert(id, static_cast<quintptr>(qthreadptr));
+            return FrameResult::Dictionary;
+        }
+        case BinaryLog::TemplateFrame: {
+            const auto id = cursor.readVarUInt();
+            const auto text = cursor.readString();
+            if (!cursor.ok() || !cursor.atEnd())
+                return FrameResult::Skipped;
+            templates.insert(id, text);
+            return FrameResult::Dictionary;
+        }
+        case BinaryLog::AttributesFrame: {
+            const auto count = cursor.readVarUInt();
+            QVariantHash attrs;
+            for (quint64 i = 0; i < count && cursor.ok(); ++i) {
+                const auto name = cursor.readString();
+                attrs.insert(name, cursor.readValue());
+            }
+            if (!cursor.ok() || !cursor.atEnd())
+                return FrameResult::Skipped;
+            sessionAttributes = attrs;
+            return FrameResult::Dictionary;
+        }
+        case BinaryLog::RecordFrame:
+        case BinaryLog::TemplatedRecordFrame: {
+            const auto time = lastTime + cursor.readVarInt();
+            const auto type = cursor.readByte();
+            const auto callsiteId = cursor.readVarUInt();
+            const auto threadId = cursor.readVarUInt();
+            QString message;
+            if (kind == BinaryLog::TemplatedRecordFrame) {
+                const auto templateId = cursor.readVarUInt();
+                const auto paramCount = cursor.readVarUInt();
+                QStringList params;
+                for (quint64 i = 0; i < paramCount && cursor.ok(); ++i) {
+                    params.append(cursor.readString());
+                }
+                message = MessageTemplateAttr::applyParameters(templates.value(templateId), params);
+            } else {
+                message = cursor.readString();
+            }
+            const auto attrCount = cursor.readVarUInt();
+            QVariantHash attrs = sessionAttributes;
+            for (quint64 i = 0; i < attrCount && cursor.ok(); ++i) {
+                const auto name = cursor.readString();
+                attrs.insert(name, cursor.readValue());
+            }
+            if (!cursor.ok() || !cursor.atEnd() || type > QtInfoMsg)
+                return FrameResult::Skipped;
+
+            const auto callsite = callsites.value(callsiteId);
+            const QMessageLogContext context(callsite.file.constData(), callsite.line,
+                                             callsite.function.constData(),
+                                             callsite.category.constData());
+
+            result.emplace(static_cast<QtMsgType>(type), context, message, QDateTime::fromMSecsSinceEpoch(time),
+                           threads.value(threadId));
+            result->setAttributes(attrs);
+
+            lastTime = time;
+            return FrameResult::Message;
+        }
+        default:
+            // A frame of an unknown kind still has a length to skip it by
+            return FrameResult::Skipped;
+        }
+    }
+
+    QIODevice *device = nullptr;
+    QScopedPointer<QFile> file;
+
+    QByteArray buffer;
+    int pos = 0;
+
+    QString error;
+    bool valid = false;
+    bool resyncing = false;
+    int damagedFrames = 0;
+
+    QHash<quint64, Callsite> callsites;
+    QHash<quint64, quintptr> threads;
+    QHash<quint64, QString> templates;
+    QVariantHash sessionAttributes;
+    qint64 lastTime = 0;
+};
+
+QTLOGGER_DECL_SPEC
+BinaryLogReader::BinaryLogReader(const QString &path) : d(new BinaryLogReaderPrivate)
+{
+    d->file.reset(new QFile(path));
+    if (!d->file->open(QIODevice::ReadOnly)) {
+        d->error = d->file->errorString();
+        return;
+    }
+    d->device = d->file.data();
+    d->init();
+}
+
+QTLOGGER_DECL_SPEC
+BinaryLogReader::BinaryLogReader(QIODevice *device) : d(new BinaryLogReaderPrivate)
+{
+    d->device = device;
+    d->init();
+}
+
+QTLOGGER_DECL_SPEC
+BinaryLogReader::~BinaryLogReader() = default;
+
+QTLOGGER_DECL_SPEC
+bool BinaryLogReader::isValid() const
+{
+    return d->valid;
+}
+
+QTLOGGER_DECL_SPEC
+QString BinaryLogReader::errorString() const
+{
+    return d->error;
+}
+
+QTLOGGER_DECL_SPEC
+std::optional<LogMessage> BinaryLogReader::next()
+{
+    std::optional<LogMessage> result;
+
+    if (!d->valid)
+        return result;
+
+    if (d->resyncing && !d->resync(d->pos))
+        return result;
+
+    while (true) {
+        switch (d->parseFrame(result)) {
+        case BinaryLogReaderPrivate::FrameResult::Message:
+            return result;
+        case BinaryLogReaderPrivate::FrameResult::Dictionary:
+            break;
+        case BinaryLogReaderPrivate::FrameResult::Incomplete:
+            if (d->readMore())
+                break;
+
+            // A truncated last frame, e.g. of a file that is still being written, ends the log. In
+            // a file followed by another session it was cut short by a crash and is skipped.
+            if (d->device->isSequential()
+                || d->buffer.indexOf(BinaryLogReaderPrivate::headerMarker(), d->pos + 1) < 0)
+                return result;
+            ++d->damagedFrames;
+            if (!d->resync(d->pos + 1))
+                return result;
+            break;
+        case BinaryLogReaderPrivate::FrameResult::Damaged:
+            ++d->damagedFrames;
+            if (!d->resync(d->pos + 1))
+                return result;
+            break;
+        case BinaryLogReaderPrivate::FrameResult::Skipped:
+            ++d->damagedFrames;
+            break;
+        case BinaryLogReaderPrivate::FrameResult::Unsupported:
+            d->valid = false;
+            return result;
+        }
+    }
+}
+
+QTLOGGER_DECL_SPEC
+int BinaryLogReader::damagedFrames() const
+{
+    return d->damagedFrames;
+}
+
+} // namespace QtLogger
@@ -0,0 +1,214 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <optional>
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QScopedPointer>
+#include <QVariant>
+#include <QtEndian>
+
+#include <cstring>
+
+#include "attrhandlers/messagetemplateattr.h"
+#include "logger_global.h"
+#include "logmessage.h"
+
+QT_FORWARD_DECLARE_CLASS(QIODevice)
+
+/*
+ * Binary log format (written by BinaryLogWriter for BinaryFileSink and LocalSocketSink):
+ *
+ *   file     := (header frame*)*
+ *   header   := 'H' "QTLB" <u8 version> <svarint base time, ms since epoch>
+ *               Starts every file and every session appended to a file. Resets the dictionaries
+ *               and the time base.
+ *   frame    := <u8 kind> <varint payload length> <payload>
+ *
+ *   'C' callsite := <varint id> <str file> <varint line> <str function> <str category>
+ *   'T' thread   := <varint id> <varint qthreadptr>
+ *   'R' record   := <svarint time delta, ms> <u8 type> <varint callsite id> <varint thread id>
+ *                   <str message> <varint attribute count> (<str name> <value>)*
+ *   'P' template := <varint id> <str text>
+ *                   Written again when the template of the id is generalized.
+ *   'M' templated record := like 'R', but with <varint template id> <varint param count> <str param>*
+ *                   instead of <str message>; see MessageTemplateAttr
+ *   'A' attributes := <varint count> (<str name> <value>)*
+ *                   Attributes of the session, added to every following record that doesn't have
+ *                   an attribute with the same name.
+ *
+ *   str      := <varint length> <UTF-8 bytes>
+ *   value    := <u8 tag> <payload>, see BinaryLog::ValueTag
+ *
+ * Varints are LEB128, signed varints are zigzag encoded. Callsite, thread and template dictionaries
+ * are per file, so every file can be decoded on its own.
+ *
+ * A frame whose payload doesn't decode to exactly its length, of an unknown kind or with a message
+ * type above QtInfoMsg is skipped. After an implausible length the reader continues at the next
+ * header.
+ */
+
+namespace QtLogger {
+
+namespace BinaryLog {
+
+constexpr char Magic[] = "QTLB";
+constexpr quint8 Version = 1;
+constexpr quint64 MaxFrameSize = 64 * 1024 * 1024;
+
+enum FrameKind : char {
+    HeaderFrame = 'H',
+    CallsiteFrame = 'C',
+    ThreadFrame = 'T',
+    RecordFrame = 'R',
+    TemplateFrame = 'P',
+    TemplatedRecordFrame = 'M',
+    AttributesFrame = 'A'
+};
+
+enum ValueTag : quint8 {
+    NullValue = 0,
+    BoolValue = 1,
+    IntValue = 2,
+    UIntValue = 3,
+    DoubleValue = 4,
+    StringValue = 5,
+    DateTimeValue = 6,
+    BytesValue = 7
+};
+
+inline void writeVarUInt(QByteArray &out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.append(static_cast<char>(value));
+}
+
+inline void writeVarInt(QByteArray &out, qint64 value)
+{
+    writeVarUInt(out, (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63));
+}
+
+inline void writeBytes(QByteArray &out, const QByteArray &bytes)
+{
+    writeVarUInt(out, static_cast<quint64>(bytes.size()));
+    out.append(bytes);
+}
+
+inline void writeString(QByteArray &out, const QString &str)
+{
+    writeBytes(out, str.toUtf8());
+}
+
+inline void writeValue(QByteArray &out, const QVariant &value)
+{
+    if (!value.isValid()) {
+        out.append(static_cast<char>(NullValue));
+        return;
+    }
+
+    switch (value.userType()) {
+    case QMetaType::Bool:
+        out.append(static_cast<char>(BoolValue));
+        out.append(static_cast<char>(value.toBool() ? 1 : 0));
+        break;
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+    case QMetaType::Short:
+    case QMetaType::SChar:
+        out.append(static_cast<char>(IntValue));
+        writeVarInt(out, value.toLongLong());
+        break;
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+    case QMetaType::UShort:
+    case QMetaType::UChar:
+        out.append(static_cast<char>(UIntValue));
+        writeVarUInt(out, value.toULongLong());
+        break;
+    case QMetaType::Double:
+    case QMetaType::Float: {
+        out.append(static_cast<char>(DoubleValue));
+        const double d = value.toDouble();
+        quint64 bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        const auto le = qToLittleEndian(bits);
+        out.append(reinterpret_cast<const char *>(&le), sizeof(le));
+        break;
+    }
+    case QMetaType::QDateTime:
+        out.append(static_cast<char>(DateTimeValue));
+        writeVarInt(out, value.toDateTime().toMSecsSinceEpoch());
+        break;
+    case QMetaType::QByteArray:
+        out.append(static_cast<char>(BytesValue));
+        writeBytes(out, value.toByteArray());
+        break;
+    default:
+        out.append(static_cast<char>(StringValue));
+        writeString(out, value.toString());
+        break;
+    }
+}
+
+} // namespace BinaryLog
+
+// Encodes messages as binary log frames. The callsite, thread and template dictionaries are kept
+// between messages, so the output of all encode() calls since the last reset() is one session.
+class QTLOGGER_EXPORT BinaryLogWriter
+{
+public:
+    BinaryLogWriter();
+    ~BinaryLogWriter();
+
+    // Record frame of the message, preceded by the session header and dictionary frames as needed
+    QByteArray encode(const LogMessage &lmsg);
+
+    // The next message starts a new session, e.g. in a new file or on a new connection
+    void reset();
+
+    // Messages with an id of these templates are stored as the template id and the parameters
+    void setMessageTemplates(const MessageTemplateAttrPtr &messageTemplates);
+    MessageTemplateAttrPtr messageTemplates() const;
+
+    // Written once after the session header instead of with every message
+    void setSessionAttributes(const QVariantHash &attributes);
+    QVariantHash sessionAttributes() const;
+
+private:
+    class BinaryLogWriterPrivate;
+    QScopedPointer<BinaryLogWriterPrivate> d;
+    Q_DISABLE_COPY(BinaryLogWriter)
+};
+
+class QTLOGGER_EXPORT BinaryLogReader
+{
+public:
+    explicit BinaryLogReader(const QString &path);
+    explicit BinaryLogReader(QIODevice *device);
+    ~BinaryLogReader();
+
+    // False if the file can't be opened or doesn't start with a binary log header
+    bool isValid() const;
+    QString errorString() const;
+
+    // Next message of the log, or nothing at the end of the log
+    std::optional<LogMessage> next();
+
+    // Number of damaged frames and regions skipped so far
+    int damagedFrames() const;
+
+private:
+    class BinaryLogReaderPrivate;
+    QScopedPointer<BinaryLogReaderPrivate> d;
+    Q_DISABLE_COPY(BinaryLogReader)
+};
+
+} // namespace QtLogger
@@ -4,25 +4,30 @@
 #include "configure.h"
 
 #include <QLoggingCategory>
-#include <QRegularExpression>
 #include <QUrl>
 #include <QtCore/QtGlobal>
 
 #include "filters/categoryfilter.h"
 #include "filters/regexpfilter.h"
-#include "formatters/functionformatter.h"
 #include "formatters/patternformatter.h"
 #include "formatters/prettyformatter.h"
 #include "pipeline.h"
 #include "simplepipeline.h"
 #include "sinks/filesink.h"
 #include "sinks/platformstdsink.h"
+#include "sinks/recordingsink.h"
 #include "sinks/rotatingfilesink.h"
+#include "sinks/segmentedlogsink.h"
+#include "sinks/sharedmemorysink.h"
 #include "sinks/stderrsink.h"
 #include "sinks/stdoutsink.h"
 
 #ifdef QTLOGGER_NETWORK
+#    include "sinks/gelfsink.h"
 #    include "sinks/httpsink.h"
+#    include "sinks/localsocketsink.h"
+#    include "sinks/otlpsink.h"
+#    include "sinks/tcpsink.h"
 #endif
 
 #ifdef QTLOGGER_SYSLOG
@@ -33,6 +38,10 @@
 #    include "sinks/sdjournalsink.h"
 #endif
 
+#ifdef QTLOGGER_SQL
+#    include "sinks/sqlitesink.h"
+#endif
+
 #ifdef QTLOGGER_OSLOG
 #    include "sinks/oslogsink.h"
 #endif
@@ -58,16 +67,12 @@ void configure(Pipeline *pipeline, const QString &path, int maxFileSize, int max
     *pipeline << PrettyFormatterPtr::create(true);
     *pipeline << PlatformStdSinkPtr::create();
 
+    // The file sinks write the rendering without colors of the same pass
     if (!path.isEmpty()) {
-        *pipeline << FunctionFormatterPtr::create([](const LogMessage &lmsg) {
-            auto fmsg = lmsg.formattedMessage();
-            static const QRegularExpression ansiEscape(QStringLiteral("\033\\[[0-9;]*m"));
-            fmsg.remove(ansiEscape);
-            return fmsg;
-        });
-
         if (maxFileSize > 0 || options.testFlag(RotatingFileSink::RotationOnStartup)
-            || options.testFlag(RotatingFileSink::RotationDaily)) {
+            || options.testFlag(RotatingFileSink::RotationDaily)
+            || options.testFlag(RotatingFileSink::TimeIndex)
+            || options.testFlag(RotatingFileSink::TermIndex)) {
             *pipeline << RotatingFileSinkPtr::create(path, maxFileSize, maxFileCount, options);
         } else {
             *pipeline << FileSinkPtr::create(path);
@@ -93,6 +98,15 @@ void configure(Pipeline *pipeline, const QSettings &settings, const QString &gro
         return;
     }
 
+    // First, so the workload is recorded before the filters. With format_in_caller_thread, it gets
+    // the messages in the own thread and the filters and formatters still run in the caller thread.
+    const auto recordingPath = settings.value(group + QStringLiteral("/recording_path")).toString();
+    if (!recordingPath.isEmpty()) {
+        const auto maxCount =
+                settings.value(group + QStringLiteral("/recording_max_count"), 0).toULongLong();
+        *pipeline << RecordingSinkPtr::create(recordingPath, maxCount);
+    }
+
     const auto filterRules = settings.value(group + QStringLiteral("/filter_rules")).toString();
     if (!filterRules.isEmpty()) {
 #ifdef QTLOGGER_DEBUG
@@ -185,10 +199,20 @@ void configure(Pipeline *pipeline, const QSettings &settings, const QString &gro
         const auto compress =
                 settings.value(group + QStringLiteral("/compress_old_files"), false).toBool();
 
+        // Compressed files are seekable when a block size is given
+        const auto compressionBlockSize =
+                settings.value(group + QStringLiteral("/compression_block_size"), 0).toInt();
+
+        const auto timeIndex = settings.value(group + QStringLiteral("/time_index"), false).toBool();
+
+        const auto termIndex = settings.value(group + QStringLiteral("/term_index"), false).toBool();
+
 #ifdef QTLOGGER_DEBUG
         std::cerr << "configure: path: " << path.toStdString() << " maxFileSize: " << maxFileSize
                   << " maxFileCount: " << maxFileCount << " rotateOnStartup: " << rotateOnStartup
-                  << " rotateDaily: " << rotateDaily << " compress: " << compress << std::endl;
+                  << " rotateDaily: " << rotateDaily << " compress: " << compress
+                  << " compressionBlockSize: " << compressionBlockSize
+                  << " timeIndex: " << timeIndex << " termIndex: " << termIndex << std::endl;
 #endif
 
         RotatingFileSink::Options options = RotatingFileSink::Option::None;
@@ -196,11 +220,55 @@ void configure(Pipeline *pipeline, const QSettings &settings, const QString &gro
             options |= RotatingFileSink::RotationOnStartup;
         if (rotateDaily)
             options |= RotatingFileSink::RotationDaily;
-        if (compress)
+        if (compress && compressionBlockSize > 0)
+            options |= RotatingFileSink::Option::BlockCompression;
+        else if (compress)
             options |= RotatingFileSink::Option::Compression;
+        if (timeIndex)
+            options |= RotatingFileSink::Option::TimeIndex;
+        if (termIndex)
+            options |= RotatingFileSink::Option::TermIndex;
+
+        auto sink = RotatingFileSinkPtr::create(path, maxFileSize, maxFileCount, options);
+        if (compressionBlockSize > 0)
+            sink->setCompressionBlockSize(compressionBlockSize);
+
+        *pipeline << sink;
+    }
+
+    const auto segmentedLogPath =
+            settings.value(group + QStringLiteral("/segmented_log_path")).toString();
+    if (!segmentedLogPath.isEmpty()) {
+        const auto segmentSize =
+                settings.value(group + QStringLiteral("/segmented_log_segment_size"),
+                               SegmentedLogSink::DefaultSegmentSize)
+                        .toLongLong();
+        const auto maxSize =
+                settings.value(group + QStringLiteral("/segmented_log_max_size"), 0).toLongLong();
+        *pipeline << SegmentedLogSinkPtr::create(segmentedLogPath, segmentSize, maxSize);
+    }
 
-        *pipeline << RotatingFileSinkPtr::create(path, maxFileSize, maxFileCount, options);
+#ifndef QT_NO_SHAREDMEMORY
+    const auto sharedMemoryKey =
+            settings.value(group + QStringLiteral("/shared_memory_key")).toString();
+    if (!sharedMemoryKey.isEmpty()) {
+        const auto slotCount = settings.value(group + QStringLiteral("/shared_memory_slots"),
+                                              SharedMemorySink::DefaultSlotCount)
+                                       .toInt();
+        *pipeline << SharedMemorySinkPtr::create(sharedMemoryKey, slotCount);
     }
+#endif
+
+#ifdef QTLOGGER_SQL
+    const auto sqliteFile = settings.value(group + QStringLiteral("/sqlite_file")).toString();
+    if (!sqliteFile.isEmpty()) {
+        auto sink = SqliteSinkPtr::create(sqliteFile);
+        sink->setMaxRowCount(
+                settings.value(group + QStringLiteral("/sqlite_max_rows"), 0).toLongLong());
+        sink->setMaxAge(settings.value(group + QStringLiteral("/sqlite_max_age"), 0).toInt());
+        *pipeline << sink;
+    }
+#endif
 
 #ifdef QTLOGGER_NETWORK
     const auto httpUrl = settings.value(group + QStringLiteral("/http_url")).toString();
@@ -211,6 +279,59 @@ void configure(Pipeline *pipeline, const QSettings &settings, const QString &gro
         // TODO: add support for http_msg_format (json)
         *pipeline << HttpSinkPtr::create(QUrl(httpUrl));
     }
+
+    const auto gelfHost = settings.value(group + QStringLiteral("/gelf_host")).toString();
+    if (!gelfHost.isEmpty()) {
+        const auto gelfPort = settings.value(group + QStringLiteral("/gelf_port"),
+                                             GelfSink::DefaultPort)
+                                      .toUInt();
+        const auto gelfTransport = settings.value(group + QStringLiteral("/gelf_transport"),
+                                                  QStringLiteral("udp"))
+                                           .toString();
+        const auto gelfCompression = settings.value(group + QStringLiteral("/gelf_compression"),
+                                                    QStringLiteral("none"))
+                                             .toString();
+
+        auto sink = GelfSinkPtr::create(gelfHost, static_cast<quint16>(gelfPort),
+                                        gelfTransport == QLatin1String("tcp")
+                                                ? GelfSink::Transport::Tcp
+                                                : GelfSink::Transport::Udp);
+        if (gelfCompression == QLatin1String("zlib"))
+            sink->setCompression(GelfSink::Compression::Zlib);
+        else if (gelfCompression == QLatin1String("gzip"))
+            sink->setCompression(GelfSink::Compression::Gzip);
+
+        *pipeline << sink;
+    }
+
+    const auto localSocket = settings.value(group + QStringLiteral("/local_socket")).toString();
+    if (!localSocket.isEmpty()) {
+        *pipeline << LocalSocketSinkPtr::create(localSocket);
+    }
+
+    const auto tcpHost = settings.value(group + QStringLiteral("/tcp_host")).toString();
+    const auto tcpPort = settings.value(group + QStringLiteral("/tcp_port"), 0).toUInt();
+    if (!tcpHost.isEmpty() && tcpPort > 0) {
+        const auto tcpFraming = settings.value(group + QStringLiteral("/tcp_framing"),
+                                               QStringLiteral("newline"))
+                                        .toString();
+        *pipeline << TcpSinkPtr::create(tcpHost, static_cast<quint16>(tcpPort),
+                                        tcpFraming == QLatin1String("length")
+                                                ? TcpSink::Framing::LengthPrefixed
+                                                : TcpSink::Framing::Newline);
+    }
+
+    const auto otlpEndpoint = settings.value(group + QStringLiteral("/otlp_endpoint")).toString();
+    if (!otlpEndpoint.isEmpty()) {
+        auto sink = OtlpSinkPtr::create(QUrl(otlpEndpoint));
+        sink->setMaxExportBatchSize(settings.value(group + QStringLiteral("/otlp_batch_size"),
+                                                   OtlpSink::DefaultMaxExportBatchSize)
+                                            .toInt());
+        sink->setScheduleDelay(settings.value(group + QStringLiteral("/otlp_schedule_delay"),
+                                              OtlpSink::DefaultScheduleDelay)
+                                       .toInt());
+        *pipeline << sink;
+    }
 #endif
 
 #ifndef QTLOGGER_NO_THREAD
@@ -220,6 +341,17 @@ void configure(Pipeline *pipeline, const QSettings &settings, const QString &gro
 #    endif
         auto *ownThreadLogger = dynamic_cast<OwnThreadHandler<SimplePipeline> *>(pipeline);
         if (ownThreadLogger) {
+            ownThreadLogger->setFormatInCallerThread(
+                    settings.value(group + QStringLiteral("/format_in_caller_thread"), false)
+                            .toBool());
+            const auto priorityLaneLevel =
+                    settings.value(group + QStringLiteral("/priority_lane_level")).toString();
+            if (!priorityLaneLevel.isEmpty()) {
+                ownThreadLogger->setPriorityLane(
+                        stringToQtMsgType(priorityLaneLevel, QtWarningMsg),
+                        settings.value(group + QStringLiteral("/priority_lane_ordered"), false)
+                                .toBool());
+            }
             ownThreadLogger->moveToOwnThread();
         }
     }
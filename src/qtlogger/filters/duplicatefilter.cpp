@@ -1,10 +1,18 @@
 #include "duplicatefilter.h"
 
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutexLocker>
+#endif
+
 namespace QtLogger {
 
 QTLOGGER_DECL_SPEC
 bool DuplicateFilter::filter(const LogMessage &lmsg)
 {
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&m_mutex);
+#endif
+
     if (lmsg.message() == m_lastMessage) {
         return false;
     }
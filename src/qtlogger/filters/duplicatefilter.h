@@ -1,5 +1,9 @@
 #pragma once
 
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#endif
+
 #include "../filter.h"
 #include "../logger_global.h"
 
@@ -12,6 +16,9 @@ public:
 
 private:
     QString m_lastMessage;
+#ifndef QTLOGGER_NO_THREAD
+    QMutex m_mutex;
+#endif
 };
 
 using DuplicateFilterPtr = QSharedPointer<DuplicateFilter>;
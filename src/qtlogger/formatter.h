@@ -17,15 +17,45 @@ public:
 
     virtual QString format(const LogMessage &lmsg) = 0;
 
+    // Formatters styling the message for a terminal also render it without the escape sequences
+    // into plainMessage, in the same pass; see LogMessage::plainFormattedMessage()
+    virtual QString formatStyled(const LogMessage &lmsg, QString &plainMessage)
+    {
+        Q_UNUSED(plainMessage)
+        return format(lmsg);
+    }
+
     HandlerType type() const override final { return HandlerType::Formatter; }
 
     bool process(LogMessage &lmsg) override final
     {
-        lmsg.setFormattedMessage(format(lmsg));
+        QString plainMessage;
+        const auto formattedMessage = formatStyled(lmsg, plainMessage);
+        lmsg.setFormattedMessage(formattedMessage, plainMessage);
         return true;
     }
 };
 
 using FormatterPtr = QSharedPointer<Formatter>;
 
+// Formatter producing bytes instead of text, e.g. CBOR. Sinks based on IODeviceSink write the
+// bytes as is.
+class QTLOGGER_EXPORT BinaryFormatter : public Handler
+{
+public:
+    virtual ~BinaryFormatter() = default;
+
+    virtual QByteArray format(const LogMessage &lmsg) = 0;
+
+    HandlerType type() const override final { return HandlerType::Formatter; }
+
+    bool process(LogMessage &lmsg) override final
+    {
+        lmsg.setFormattedData(format(lmsg));
+        return true;
+    }
+};
+
+using BinaryFormatterPtr = QSharedPointer<BinaryFormatter>;
+
 } // namespace QtLogger
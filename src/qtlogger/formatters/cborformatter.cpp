@@ -0,0 +1,179 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "cborformatter.h"
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+
+#include <QCborStreamWriter>
+#include <QDateTime>
+
+namespace QtLogger {
+
+namespace {
+
+void appendUtf8(QCborStreamWriter &writer, const char *str)
+{
+    writer.appendTextString(str ? str : "", str ? static_cast<qsizetype>(qstrlen(str)) : 0);
+}
+
+void appendDateTime(QCborStreamWriter &writer, const QDateTime &dateTime)
+{
+    writer.append(QCborKnownTags::EpochDateTime);
+    writer.append(static_cast<double>(dateTime.toMSecsSinceEpoch()) / 1000.0);
+}
+
+void appendVariant(QCborStreamWriter &writer, const QVariant &value)
+{
+    if (!value.isValid()) {
+        writer.appendNull();
+        return;
+    }
+
+    switch (value.userType()) {
+    case QMetaType::Bool:
+        writer.append(value.toBool());
+        break;
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+    case QMetaType::Short:
+    case QMetaType::SChar:
+        writer.append(static_cast<qint64>(value.toLongLong()));
+        break;
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+    case QMetaType::UShort:
+    case QMetaType::UChar:
+        writer.append(static_cast<quint64>(value.toULongLong()));
+        break;
+    case QMetaType::Double:
+    case QMetaType::Float:
+        writer.append(value.toDouble());
+        break;
+    case QMetaType::QByteArray:
+        writer.append(value.toByteArray());
+        break;
+    case QMetaType::QDateTime:
+        appendDateTime(writer, value.toDateTime());
+        break;
+    case QMetaType::QStringList: {
+        const auto list = value.toStringList();
+        writer.startArray(static_cast<quint64>(list.size()));
+        for (const auto &item : list) {
+            writer.append(item);
+        }
+        writer.endArray();
+        break;
+    }
+    case QMetaType::QVariantList: {
+        const auto list = value.toList();
+        writer.startArray(static_cast<quint64>(list.size()));
+        for (const auto &item : list) {
+            appendVariant(writer, item);
+        }
+        writer.endArray();
+        break;
+    }
+    case QMetaType::QVariantMap: {
+        const auto map = value.toMap();
+        writer.startMap(static_cast<quint64>(map.size()));
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            writer.append(it.key());
+            appendVariant(writer, it.value());
+        }
+        writer.endMap();
+        break;
+    }
+    case QMetaType::QVariantHash: {
+        const auto hash = value.toHash();
+        writer.startMap(static_cast<quint64>(hash.size()));
+        for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+            writer.append(it.key());
+            appendVariant(writer, it.value());
+        }
+        writer.endMap();
+        break;
+    }
+    default:
+        writer.append(value.toString());
+        break;
+    }
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+QByteArray CborFormatter::format(const LogMessage &lmsg)
+{
+    const auto attrs = lmsg.attributes();
+
+    QByteArray result;
+    result.reserve(lmsg.message().size() + 128);
+
+    QCborStreamWriter writer(&result);
+
+    // Custom attributes override the message fields, like in LogMessage::allAttributes()
+    const auto has = [&attrs](const char *key) { return attrs.contains(QLatin1String(key)); };
+
+    quint64 count = static_cast<quint64>(attrs.size());
+    for (const auto key : { "type", "line", "file", "function", "category", "message", "time" }) {
+        if (!has(key))
+            ++count;
+    }
+#ifndef QTLOGGER_NO_THREAD
+    if (!has("threadId"))
+        ++count;
+#endif
+
+    writer.startMap(count);
+
+    if (!has("type")) {
+        writer.append(QLatin1String("type"));
+        writer.append(qtMsgTypeToString(lmsg.type()));
+    }
+    if (!has("line")) {
+        writer.append(QLatin1String("line"));
+        writer.append(static_cast<qint64>(lmsg.line()));
+    }
+    if (!has("file")) {
+        writer.append(QLatin1String("file"));
+        appendUtf8(writer, lmsg.file());
+    }
+    if (!has("function")) {
+        writer.append(QLatin1String("function"));
+        appendUtf8(writer, lmsg.function());
+    }
+    if (!has("category")) {
+        writer.append(QLatin1String("category"));
+        appendUtf8(writer, lmsg.category());
+    }
+    if (!has("message")) {
+        writer.append(QLatin1String("message"));
+        writer.append(lmsg.message());
+    }
+    if (!has("time")) {
+        writer.append(QLatin1String("time"));
+        appendDateTime(writer, lmsg.time());
+    }
+#ifndef QTLOGGER_NO_THREAD
+    if (!has("threadId")) {
+        writer.append(QLatin1String("threadId"));
+        writer.append(static_cast<quint64>(lmsg.threadId()));
+    }
+#endif
+
+    for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
+        writer.append(it.key());
+        appendVariant(writer, it.value());
+    }
+
+    writer.endMap();
+
+    return result;
+}
+
+} // namespace QtLogger
+
+#endif // QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
@@ -0,0 +1,37 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QtGlobal>
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+
+#include <QSharedPointer>
+
+#include "../formatter.h"
+#include "../logger_global.h"
+
+namespace QtLogger {
+
+using CborFormatterPtr = QSharedPointer<class CborFormatter>;
+
+// Streams the message fields and attributes as a CBOR map with the same keys as JsonFormatter.
+// Time is written as an epoch based date/time (tag 1), attributes keep their types.
+class QTLOGGER_EXPORT CborFormatter : public BinaryFormatter
+{
+public:
+    CborFormatter() = default;
+
+    static CborFormatterPtr instance()
+    {
+        static const auto s_instance = CborFormatterPtr::create();
+        return s_instance;
+    }
+
+    QByteArray format(const LogMessage &lmsg) override;
+};
+
+} // namespace QtLogger
+
+#endif // QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
@@ -0,0 +1,181 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "logfmtformatter.h"
+
+#include <QDateTime>
+#include <QLocale>
+#include <QStringList>
+
+namespace QtLogger {
+
+namespace {
+
+bool needsQuoting(const QString &value)
+{
+    if (value.isEmpty())
+        return true;
+
+    for (const auto ch : value) {
+        if (ch.unicode() <= ' ' || ch == QLatin1Char('=') || ch == QLatin1Char('"')
+            || ch.unicode() == 0x7F)
+            return true;
+    }
+    return false;
+}
+
+void appendValue(QString &dest, const QString &value)
+{
+    if (!needsQuoting(value)) {
+        dest.append(value);
+        return;
+    }
+
+    dest.append(QLatin1Char('"'));
+    for (const auto ch : value) {
+        switch (ch.unicode()) {
+        case '"':
+            dest.append(QLatin1String("\\\""));
+            break;
+        case '\\':
+            dest.append(QLatin1String("\\\\"));
+            break;
+        case '\n':
+            dest.append(QLatin1String("\\n"));
+            break;
+        case '\r':
+            dest.append(QLatin1String("\\r"));
+            break;
+        case '\t':
+            dest.append(QLatin1String("\\t"));
+            break;
+        default:
+            // Other control characters would break the line of the record in a terminal or a viewer
+            if (ch.unicode() < ' ' || ch.unicode() == 0x7F)
+                dest.append(QStringLiteral("\\u%1").arg(static_cast<uint>(ch.unicode()), 4, 16,
+                                                           QLatin1Char('0')));
+            else
+                dest.append(ch);
+        }
+    }
+    dest.append(QLatin1Char('"'));
+}
+
+void appendValue(QString &dest, const char *value)
+{
+    appendValue(dest, QString::fromUtf8(value));
+}
+
+// Keys can't be quoted, characters that would break the pair are replaced. Attributes named as
+// the fields written before them get a prefix, so each key of a record is unique.
+void appendKey(QString &dest, const QString &key, bool withCallsite)
+{
+    QString name;
+    name.reserve(key.size());
+    for (const auto ch : key) {
+        if (ch.unicode() <= ' ' || ch == QLatin1Char('=') || ch == QLatin1Char('"')
+            || ch.unicode() == 0x7F)
+            name.append(QLatin1Char('_'));
+        else
+            name.append(ch);
+    }
+
+    static const QStringList fieldKeys = { QStringLiteral("time"), QStringLiteral("level"),
+                                           QStringLiteral("category"), QStringLiteral("msg") };
+    static const QStringList callsiteKeys = { QStringLiteral("file"), QStringLiteral("line"),
+                                              QStringLiteral("func") };
+
+    dest.append(QLatin1Char(' '));
+    if (fieldKeys.contains(name) || (withCallsite && callsiteKeys.contains(name)))
+        dest.append(QLatin1String("attr_"));
+    dest.append(name);
+    dest.append(QLatin1Char('='));
+}
+
+void appendVariant(QString &dest, const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::Bool:
+        dest.append(value.toBool() ? QLatin1String("true") : QLatin1String("false"));
+        break;
+    case QMetaType::Int:
+    case QMetaType::Long:
+    case QMetaType::LongLong:
+    case QMetaType::Short:
+    case QMetaType::SChar:
+        dest.append(QString::number(value.toLongLong()));
+        break;
+    case QMetaType::UInt:
+    case QMetaType::ULong:
+    case QMetaType::ULongLong:
+    case QMetaType::UShort:
+    case QMetaType::UChar:
+        dest.append(QString::number(value.toULongLong()));
+        break;
+    case QMetaType::Double:
+    case QMetaType::Float:
+        dest.append(QString::number(value.toDouble(), 'g', QLocale::FloatingPointShortest));
+        break;
+    case QMetaType::QString:
+        appendValue(dest, value.toString());
+        break;
+    case QMetaType::QDateTime:
+        dest.append(value.toDateTime().toString(Qt::ISODateWithMs));
+        break;
+    case QMetaType::QStringList:
+        appendValue(dest, value.toStringList().join(QLatin1Char(',')));
+        break;
+    default:
+        appendValue(dest, value.toString());
+    }
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+LogfmtFormatter::LogfmtFormatter(bool withCallsite) : m_withCallsite(withCallsite) { }
+
+QTLOGGER_DECL_SPEC
+QString LogfmtFormatter::format(const LogMessage &lmsg)
+{
+    const auto attrs = lmsg.attributes();
+    const auto message = lmsg.message();
+
+    QString result;
+    result.reserve(message.size() + 96 + attrs.size() * 24);
+
+    result.append(QLatin1String("time="));
+    result.append(lmsg.time().toString(Qt::ISODateWithMs));
+
+    result.append(QLatin1String(" level="));
+    result.append(qtMsgTypeToString(lmsg.type()));
+
+    if (lmsg.category() && *lmsg.category()) {
+        result.append(QLatin1String(" category="));
+        appendValue(result, lmsg.category());
+    }
+
+    result.append(QLatin1String(" msg="));
+    appendValue(result, message);
+
+    const auto withCallsite = m_withCallsite && lmsg.file();
+    if (withCallsite) {
+        result.append(QLatin1String(" file="));
+        appendValue(result, lmsg.file());
+        result.append(QLatin1String(" line="));
+        result.append(QString::number(lmsg.line()));
+        if (lmsg.function()) {
+            result.append(QLatin1String(" func="));
+            appendValue(result, lmsg.function());
+        }
+    }
+
+    for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
+        appendKey(result, it.key(), withCallsite);
+        appendVariant(result, it.value());
+    }
+
+    return result;
+}
+
+} // namespace QtLogger
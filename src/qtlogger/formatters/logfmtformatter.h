@@ -0,0 +1,38 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QSharedPointer>
+
+#include "../formatter.h"
+#include "../logger_global.h"
+
+namespace QtLogger {
+
+using LogfmtFormatterPtr = QSharedPointer<class LogfmtFormatter>;
+
+// Formats messages as logfmt key=value pairs:
+//   time=2024-01-15T14:30:45.123 level=warning category=net msg="Connection timeout" seq_number=1
+// Values are quoted only if they are empty or contain spaces, '=', '"' or control characters,
+// control characters are escaped inside quotes, so each record stays on a single line. Attributes
+// named as the fields (time, level, category, msg and the callsite keys) get an attr_ prefix.
+class QTLOGGER_EXPORT LogfmtFormatter : public Formatter
+{
+public:
+    // With withCallsite, file=, line= and func= are added for messages with a file name
+    explicit LogfmtFormatter(bool withCallsite = false);
+
+    static LogfmtFormatterPtr instance()
+    {
+        static const auto s_instance = LogfmtFormatterPtr::create();
+        return s_instance;
+    }
+
+    QString format(const LogMessage &lmsg) override;
+
+private:
+    bool m_withCallsite = false;
+};
+
+} // namespace QtLogger
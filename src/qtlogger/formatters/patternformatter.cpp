@@ -5,8 +5,17 @@
 
 #include <optional>
 
+#include <QCoreApplication>
+#include <QHash>
+#include <QRegularExpression>
 #include <QSharedPointer>
 
+#ifndef QTLOGGER_NO_THREAD
+#    include <QReadWriteLock>
+#endif
+
+#include "../backtrace.h"
+
 namespace QtLogger {
 
 namespace {
@@ -15,6 +24,57 @@ static const auto g_processStartTime = std::chrono::steady_clock::now();
 
 static const QChar DEL_MARKER = QChar(0x200B);
 
+// Defaults of %{backtrace} in qSetMessagePattern()
+constexpr int QtBacktraceDepth = 5;
+constexpr char QtBacktraceSeparator[] = "|";
+
+// Frames of the logger and of qDebug() itself, captured in addition and dropped before formatting
+constexpr int QtBacktraceExtraDepth = 8;
+
+// Values derived from a callsite string, rendered once per distinct string. Keyed by the content
+// rather than the pointer: messages queued to the own thread of a logger carry copies of the
+// strings, and a buffer may be reused for another string. Lookups share the lock, so logging threads
+// don't serialize on a cache hit.
+class CallsiteCache
+{
+public:
+    static constexpr int MaxSize = 4096;
+
+    template<typename Render>
+    QString value(const char *key, Render render) const
+    {
+        const auto bytes = QByteArray::fromRawData(key, key ? static_cast<int>(qstrlen(key)) : 0);
+
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QReadLocker locker(&m_lock);
+#endif
+            const auto it = m_values.constFind(bytes);
+            if (it != m_values.cend())
+                return it.value();
+        }
+
+        // Rendered without the lock, two threads may render the same string at worst
+        const auto value = render(bytes);
+
+#ifndef QTLOGGER_NO_THREAD
+        QWriteLocker locker(&m_lock);
+#endif
+        if (m_values.size() >= MaxSize)
+            m_values.clear();
+        // A deep copy, the raw data belongs to the message
+        m_values.insert(QByteArray(bytes.constData(), bytes.size()), value);
+
+        return value;
+    }
+
+private:
+#ifndef QTLOGGER_NO_THREAD
+    mutable QReadWriteLock m_lock;
+#endif
+    mutable QHash<QByteArray, QString> m_values;
+};
+
 class Token
 {
 public:
@@ -29,6 +89,9 @@ class ConditionToken : public Token
 public:
     bool checkCondition(const LogMessage &lmsg) const override
     {
+        if (m_categoryCondition && isDefaultCategory(lmsg.category())) {
+            return false;
+        }
         if (!m_hasCondition) {
             return true;
         }
@@ -43,9 +106,18 @@ public:
         m_hasCondition = true;
     }
 
+    // %{if-category}: only messages of a category other than the default one
+    void setCategoryCondition() { m_categoryCondition = true; }
+
 private:
     QtMsgType m_condition = QtDebugMsg;
     bool m_hasCondition = false;
+    bool m_categoryCondition = false;
+
+    static bool isDefaultCategory(const char *category)
+    {
+        return !category || qstrcmp(category, "default") == 0;
+    }
 };
 
 class FormattedToken : public ConditionToken
@@ -307,17 +379,20 @@ public:
 class FileToken : public FormattedToken
 {
 public:
-    FileToken() { }
+    explicit FileToken(const QString &unknown = QString()) : m_unknown(unknown) { }
 
     void appendToString(const LogMessage &lmsg, QString &dest) const override
     {
-        dest.append(applyPadding(lmsg.file()));
+        dest.append(applyPadding(lmsg.file() ? QString::fromUtf8(lmsg.file()) : m_unknown));
     }
 
     size_t estimatedLength() const override
     {
         return hasFormatSpec() ? formatWidth() : 20; // Maximum length of "path/to/file.cpp"
     }
+
+private:
+    QString m_unknown;
 };
 
 class ShortFileToken : public FormattedToken
@@ -327,7 +402,22 @@ public:
 
     void appendToString(const LogMessage &lmsg, QString &dest) const override
     {
-        QString file = lmsg.file();
+        dest.append(applyPadding(m_cache.value(lmsg.file(), [this](const QByteArray &file) {
+            return shortFile(QString::fromUtf8(file));
+        })));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 20;
+    }
+
+private:
+    QString m_baseDir;
+    CallsiteCache m_cache;
+
+    QString shortFile(const QString &file) const
+    {
         QString value;
         if (m_baseDir.isEmpty()) {
             // No basedir specified - return only filename without directory
@@ -353,32 +443,28 @@ public:
                 value = file;
             }
         }
-        dest.append(applyPadding(value));
+        return value;
     }
-
-    size_t estimatedLength() const override
-    {
-        return hasFormatSpec() ? formatWidth() : 20;
-    }
-
-private:
-    QString m_baseDir;
 };
 
 class FunctionToken : public FormattedToken
 {
 public:
-    FunctionToken(bool cleanup = true) : m_cleanup(cleanup) { }
+    explicit FunctionToken(bool cleanup = true, const QString &unknown = QString())
+        : m_cleanup(cleanup), m_unknown(unknown)
+    {
+    }
 
     void appendToString(const LogMessage &lmsg, QString &dest) const override
     {
-        QString value;
-        if (m_cleanup) {
-            value = QString::fromLatin1(cleanup(lmsg.function()));
-        } else {
-            value = QString::fromLatin1(lmsg.function());
+        if (!lmsg.function()) {
+            dest.append(applyPadding(m_unknown));
+            return;
         }
-        dest.append(applyPadding(value));
+
+        dest.append(applyPadding(m_cache.value(lmsg.function(), [this](const QByteArray &function) {
+            return QString::fromLatin1(m_cleanup ? cleanup(function) : function);
+        })));
     }
 
     size_t estimatedLength() const override
@@ -388,9 +474,7 @@ public:
         return m_cleanup ? 20 : 40;
     }
 
-private:
-    bool m_cleanup;
-
+    // Also used for the frames of %{backtrace}
     static QByteArray cleanup(QByteArray func)
     {
         if (func.isEmpty())
@@ -634,6 +718,11 @@ private:
 
         return func;
     }
+
+private:
+    bool m_cleanup;
+    QString m_unknown;
+    CallsiteCache m_cache;
 };
 
 class CategoryToken : public FormattedToken
@@ -655,12 +744,17 @@ public:
 class TimeToken : public FormattedToken
 {
 public:
-    explicit TimeToken(const QString &format = QString()) : m_format(format) { }
+    explicit TimeToken(const QString &format = QString(), bool qtSyntax = false)
+        : m_format(format), m_qtSyntax(qtSyntax)
+    {
+    }
 
     void appendToString(const LogMessage &lmsg, QString &dest) const override
     {
         QString value;
-        if (m_format == QLatin1String("process")) {
+        if (m_qtSyntax) {
+            value = qtTime(lmsg);
+        } else if (m_format == QLatin1String("process")) {
             // Time since process started in seconds
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
                     lmsg.steadyTime() - g_processStartTime);
@@ -692,6 +786,31 @@ public:
 
 private:
     QString m_format;
+    bool m_qtSyntax;
+
+    // As qFormatLogMessage() prints them
+    QString qtTime(const LogMessage &lmsg) const
+    {
+        auto duration = std::chrono::milliseconds(0);
+        if (m_format == QLatin1String("process")) {
+            duration = std::chrono::duration_cast<std::chrono::milliseconds>(lmsg.steadyTime()
+                                                                             - g_processStartTime);
+        } else if (m_format == QLatin1String("boot")) {
+            duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    lmsg.steadyTime().time_since_epoch());
+        } else if (m_format.isEmpty()) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+            return lmsg.time().toString(Qt::ISODateWithMs);
+#else
+            return lmsg.time().toString(Qt::ISODate);
+#endif
+        } else {
+            return lmsg.time().toString(m_format);
+        }
+
+        const auto ms = static_cast<quint64>(duration.count());
+        return QString::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000));
+    }
 };
 
 class ThreadIdToken : public FormattedToken
@@ -699,9 +818,11 @@ class ThreadIdToken : public FormattedToken
 public:
     ThreadIdToken() { }
 
+    // The system id, like Qt prints it; restored messages only have the id of the QThread
     void appendToString(const LogMessage &lmsg, QString &dest) const override
     {
-        dest.append(applyPadding(QString::number(lmsg.threadId())));
+        const auto id = lmsg.osThreadId() ? lmsg.osThreadId() : lmsg.threadId();
+        dest.append(applyPadding(QString::number(id)));
     }
 
     size_t estimatedLength() const override
@@ -727,6 +848,100 @@ public:
     }
 };
 
+class ThreadNameToken : public FormattedToken
+{
+public:
+    ThreadNameToken() { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        dest.append(applyPadding(lmsg.threadName()));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : 15; // Linux limits thread names to 15 bytes
+    }
+};
+
+// %{appname} and %{pid}: the attribute of AppInfoAttrs if set, otherwise of this process
+class AppInfoToken : public FormattedToken
+{
+public:
+    explicit AppInfoToken(const QString &name) : m_name(name) { }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        const auto value = lmsg.attribute(m_name);
+        if (value.isValid()) {
+            dest.append(applyPadding(value.toString()));
+        } else if (m_name == QLatin1String("pid")) {
+            dest.append(applyPadding(QString::number(QCoreApplication::applicationPid())));
+        } else {
+            dest.append(applyPadding(QCoreApplication::applicationName()));
+        }
+    }
+
+    size_t estimatedLength() const override { return hasFormatSpec() ? formatWidth() : 10; }
+
+private:
+    QString m_name;
+};
+
+// %{backtrace}: the functions of the backtrace captured with the message, see backtrace.h. As in
+// Qt, every message is captured, as long as the token exists.
+class BacktraceToken : public FormattedToken
+{
+public:
+    BacktraceToken(int depth, const QString &separator) : m_depth(depth), m_separator(separator)
+    {
+        Backtrace::enableCapture(QtDebugMsg, depth + QtBacktraceExtraDepth);
+    }
+
+    ~BacktraceToken() override
+    {
+        Backtrace::releaseCapture(QtDebugMsg, m_depth + QtBacktraceExtraDepth);
+    }
+
+    void appendToString(const LogMessage &lmsg, QString &dest) const override
+    {
+        QStringList frames;
+        for (const auto &frame : Backtrace::resolve(lmsg.backtrace())) {
+            if (frames.size() >= m_depth)
+                break;
+
+            const auto module = frame.module.mid(qMax(frame.module.lastIndexOf(QLatin1Char('/')),
+                                                      frame.module.lastIndexOf(QLatin1Char('\\')))
+                                                 + 1);
+
+            // The logger and qDebug() itself
+            if (frames.isEmpty()
+                && (frame.function.startsWith(QLatin1String("QtLogger::"))
+                    || module.contains(QLatin1String("Qt5Core"))
+                    || module.contains(QLatin1String("Qt6Core"))
+                    || module == QLatin1String("QtCore")))
+                continue;
+
+            if (frame.function.isEmpty()) {
+                frames.append(QLatin1Char('?') + module + QLatin1Char('?'));
+            } else {
+                frames.append(QString::fromLatin1(FunctionToken::cleanup(frame.function.toLatin1())));
+            }
+        }
+
+        dest.append(applyPadding(frames.join(m_separator)));
+    }
+
+    size_t estimatedLength() const override
+    {
+        return hasFormatSpec() ? formatWidth() : static_cast<size_t>(m_depth) * 30;
+    }
+
+private:
+    int m_depth;
+    QString m_separator;
+};
+
 class AttributeToken : public FormattedToken
 {
 public:
@@ -779,7 +994,8 @@ private:
 class PatternFormatter::PatternFormatterPrivate
 {
 public:
-    explicit PatternFormatterPrivate(const QString &pattern) : m_pattern(pattern)
+    PatternFormatterPrivate(const QString &pattern, bool qtSyntax)
+        : m_pattern(pattern), m_qtSyntax(qtSyntax)
     {
         parsePattern();
     }
@@ -792,6 +1008,7 @@ public:
         QString literalText;
         QtMsgType currentCondition = QtDebugMsg;
         bool hasCondition = false;
+        bool categoryCondition = false;
 
         while (pos < m_pattern.length()) {
             if (pos < m_pattern.length() - 1 && m_pattern[pos] == '%') {
@@ -801,6 +1018,9 @@ public:
                         if (hasCondition) {
                             token->setCondition(currentCondition);
                         }
+                        if (categoryCondition) {
+                            token->setCategoryCondition();
+                        }
                         m_tokens.append(QSharedPointer<Token>(token));
                         literalText.clear();
                     }
@@ -833,7 +1053,7 @@ public:
                     } else if (placeholder == QLatin1String("line")) {
                         token = new LineToken();
                     } else if (placeholder == QLatin1String("file")) {
-                        token = new FileToken();
+                        token = new FileToken(m_qtSyntax ? QStringLiteral("unknown") : QString());
                     } else if (placeholder == QLatin1String("shortfile")
                                || placeholder.startsWith(QLatin1String("shortfile "))) {
                         QString baseDir;
@@ -842,7 +1062,9 @@ public:
                         }
                         token = new ShortFileToken(baseDir);
                     } else if (placeholder == QLatin1String("function")) {
-                        token = new FunctionToken(false);
+                        // Qt cleans up the signature of %{function}
+                        token = m_qtSyntax ? new FunctionToken(true, QStringLiteral("unknown"))
+                                           : new FunctionToken(false);
                     } else if (placeholder == QLatin1String("func")) {
                         token = new FunctionToken(true);
                     } else if (placeholder == QLatin1String("category")) {
@@ -853,13 +1075,27 @@ public:
                         if (placeholder.startsWith(QLatin1String("time "))) {
                             timeFormat = placeholder.mid(5).trimmed();
                         }
-                        token = new TimeToken(timeFormat);
+                        token = new TimeToken(timeFormat, m_qtSyntax);
                     } else if (placeholder == QLatin1String("threadid")) {
                         token = new ThreadIdToken();
+                    } else if (placeholder == QLatin1String("threadname")) {
+                        token = new ThreadNameToken();
                     } else if (placeholder == QLatin1String("qthreadptr")) {
                         token = new QThreadPtrToken();
                     } else if (placeholder == QLatin1String("message")) {
                         token = new MessageToken();
+                    } else if (m_qtSyntax
+                               && (placeholder == QLatin1String("appname")
+                                   || placeholder == QLatin1String("pid"))) {
+                        token = new AppInfoToken(placeholder);
+                    } else if (m_qtSyntax
+                               && (placeholder == QLatin1String("backtrace")
+                                   || placeholder.startsWith(QLatin1String("backtrace ")))) {
+                        token = createBacktraceToken(placeholder.mid(9));
+                    } else if (placeholder == QLatin1String("if-category")) {
+                        categoryCondition = true;
+                        pos = closingPos + 1;
+                        continue;
                     } else if (placeholder.startsWith(QLatin1String("if-"))) {
                         // Handle conditional: %{if-debug}, %{if-warning}, etc.
                         QString conditionType = placeholder.mid(3); // Remove "if-"
@@ -869,6 +1105,7 @@ public:
                         continue;
                     } else if (placeholder == QLatin1String("endif")) {
                         hasCondition = false;
+                        categoryCondition = false;
                         pos = closingPos + 1;
                         continue;
                     } else {
@@ -901,6 +1138,9 @@ public:
                         if (hasCondition) {
                             token->setCondition(currentCondition);
                         }
+                        if (categoryCondition) {
+                            token->setCategoryCondition();
+                        }
                         if (formatSpec) {
                             token->setFormatSpec(*formatSpec);
                         }
@@ -908,8 +1148,8 @@ public:
                     }
 
                     pos = closingPos + 1;
-                } else if (m_pattern[pos + 1] == '%') {
-                    // Escaped %, add single %
+                } else if (m_pattern[pos + 1] == '%' && !m_qtSyntax) {
+                    // Escaped %, add single % (Qt has no escape)
                     literalText.append('%');
                     pos += 2;
                 } else {
@@ -928,6 +1168,9 @@ public:
             if (hasCondition) {
                 token->setCondition(currentCondition);
             }
+            if (categoryCondition) {
+                token->setCategoryCondition();
+            }
             m_tokens.append(QSharedPointer<Token>(token));
         }
     }
@@ -959,12 +1202,40 @@ public:
         return result;
     }
 
+    // Arguments of %{backtrace [depth=N] [separator="..."]}
+    static FormattedToken *createBacktraceToken(const QString &args)
+    {
+        auto depth = QtBacktraceDepth;
+        auto separator = QString::fromLatin1(QtBacktraceSeparator);
+
+        static const QRegularExpression depthRx(QStringLiteral("depth=(\\d+)"));
+        static const QRegularExpression separatorRx(QStringLiteral("separator=\"([^\"]*)\""));
+
+        const auto depthMatch = depthRx.match(args);
+        if (depthMatch.hasMatch())
+            depth = qBound(1, depthMatch.captured(1).toInt(), Backtrace::MaxDepth);
+
+        const auto separatorMatch = separatorRx.match(args);
+        if (separatorMatch.hasMatch())
+            separator = separatorMatch.captured(1);
+
+        return new BacktraceToken(depth, separator);
+    }
+
     QString m_pattern;
+    bool m_qtSyntax;
     QList<QSharedPointer<Token>> m_tokens;
 };
 
 QTLOGGER_DECL_SPEC
-PatternFormatter::PatternFormatter(const QString &pattern) : d(new PatternFormatterPrivate(pattern))
+PatternFormatter::PatternFormatter(const QString &pattern)
+    : d(new PatternFormatterPrivate(pattern, false))
+{
+}
+
+QTLOGGER_DECL_SPEC
+PatternFormatter::PatternFormatter(const QString &pattern, Syntax syntax)
+    : d(new PatternFormatterPrivate(pattern, syntax == Syntax::Qt))
 {
 }
 
@@ -21,6 +21,14 @@ public:
 
     QString format(const LogMessage &lmsg) override;
 
+protected:
+    enum class Syntax {
+        QtLogger,
+        Qt // qSetMessagePattern(), see QtMessagePatternFormatter
+    };
+
+    PatternFormatter(const QString &pattern, Syntax syntax);
+
 private:
     class PatternFormatterPrivate;
     QScopedPointer<PatternFormatterPrivate> d;
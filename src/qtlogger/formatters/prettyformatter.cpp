@@ -3,6 +3,10 @@
 
 #include "prettyformatter.h"
 
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutexLocker>
+#endif
+
 namespace QtLogger {
 
 QTLOGGER_DECL_SPEC
@@ -13,6 +17,18 @@ PrettyFormatter::PrettyFormatter(bool colorize, int maxCategoryWidth)
 
 QTLOGGER_DECL_SPEC
 QString PrettyFormatter::format(const LogMessage &lmsg)
+{
+    return render(lmsg, nullptr);
+}
+
+QTLOGGER_DECL_SPEC
+QString PrettyFormatter::formatStyled(const LogMessage &lmsg, QString &plainMessage)
+{
+    return render(lmsg, m_colorize ? &plainMessage : nullptr);
+}
+
+QTLOGGER_DECL_SPEC
+QString PrettyFormatter::render(const LogMessage &lmsg, QString *plain)
 {
     static const QString timeFormat = QStringLiteral("dd.MM.yyyy hh:mm:ss");
     static const QChar typeLetters[] = {
@@ -54,65 +70,71 @@ QString PrettyFormatter::format(const LogMessage &lmsg)
 
     QString result;
     result.reserve(estimatedSize);
+    if (plain)
+        plain->reserve(estimatedSize);
+
+    // Text goes to both renderings, escape sequences only to the colored one
+    const auto append = [&result, plain](const auto &text) {
+        result += text;
+        if (plain)
+            *plain += text;
+    };
 
     // DateTime
-    result += lmsg.time().toString(timeFormat);
-    result += space;
+    append(lmsg.time().toString(timeFormat));
+    append(space);
 
     // Type letter with specific colors
     if (m_colorize) {
         switch (type) {
         case QtInfoMsg:
             result += greenBold;
-            result += typeLetters[type];
+            append(typeLetters[type]);
             result += reset;
             break;
         case QtWarningMsg:
             result += darkOrange;
-            result += typeLetters[type];
+            append(typeLetters[type]);
             result += reset;
             break;
         case QtCriticalMsg:
             result += redBold;
-            result += typeLetters[type];
+            append(typeLetters[type]);
             result += reset;
             break;
         case QtFatalMsg:
             result += darkRedBold;
-            result += typeLetters[type];
+            append(typeLetters[type]);
             result += reset;
             break;
         default:
-            result += typeLetters[type];
+            append(typeLetters[type]);
             break;
         }
     } else {
-        result += typeLetters[type];
+        append(typeLetters[type]);
     }
 
-    result += space;
+    append(space);
 
     // Thread handling with optimized lookup
-    auto it = m_threads.find(threadId);
-    if (it == m_threads.end()) {
-        it = m_threads.insert(threadId, m_threadsIndex++);
-    }
+    int threadsCount = 0;
+    const int index = threadIndex(threadId, &threadsCount);
 
-    if (m_threads.size() > 1) {
-        const int index = it.value();
+    if (threadsCount > 1) {
         if (index == 0) {
             // Calculate width needed for thread field
             int threadWidth = 3; // "T0 " minimum
-            if (m_threadsIndex > 10) threadWidth = 4;
-            if (m_threadsIndex > 100) threadWidth = 5;
-            result += QString(threadWidth, space);
+            if (threadsCount > 10) threadWidth = 4;
+            if (threadsCount > 100) threadWidth = 5;
+            append(QString(threadWidth, space));
         } else {
             if (m_colorize) {
                 result += bold;
             }
-            result += letterT;
-            result += QString::number(index);
-            result += space;
+            append(letterT);
+            append(QString::number(index));
+            append(space);
             if (m_colorize) {
                 result += reset;
             }
@@ -125,10 +147,10 @@ QString PrettyFormatter::format(const LogMessage &lmsg)
         if (m_colorize) {
             result += darkGray;
         }
-        result += bracketOpen;
-        result += category;
-        result += bracketClose;
-        result += space;
+        append(bracketOpen);
+        append(category);
+        append(bracketClose);
+        append(space);
         if (m_colorize) {
             result += reset;
         }
@@ -136,12 +158,9 @@ QString PrettyFormatter::format(const LogMessage &lmsg)
 
     // Space for alignment
     if (m_maxCategoryWidth > 0) {
-        if (categoryFormatLength > m_categoryWidth) {
-            m_categoryWidth = qMin(categoryFormatLength, m_maxCategoryWidth);
-        }
-        const int spaceCount = m_categoryWidth - categoryFormatLength;
+        const int spaceCount = updateCategoryWidth(categoryFormatLength) - categoryFormatLength;
         if (spaceCount > 0) {
-            result += QString(spaceCount, space);
+            append(QString(spaceCount, space));
         }
     }
 
@@ -150,33 +169,82 @@ QString PrettyFormatter::format(const LogMessage &lmsg)
         switch (type) {
         case QtInfoMsg:
             result += green;
-            result += lmsg.message();
+            append(lmsg.message());
             result += reset;
             break;
         case QtWarningMsg:
             result += orange;
-            result += lmsg.message();
+            append(lmsg.message());
             result += reset;
             break;
         case QtCriticalMsg:
             result += redBold;
-            result += lmsg.message();
+            append(lmsg.message());
             result += reset;
             break;
         case QtFatalMsg:
             result += darkRedBold;
-            result += lmsg.message();
+            append(lmsg.message());
             result += reset;
             break;
         default:
-            result += lmsg.message();
+            append(lmsg.message());
             break;
         }
     } else {
-        result += lmsg.message();
+        append(lmsg.message());
     }
 
     return result;
 }
 
+QTLOGGER_DECL_SPEC
+int PrettyFormatter::threadIndex(quint64 threadId, int *threadsCount)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&m_threadsMutex);
+#endif
+
+    const auto now = ++m_threadsClock;
+
+    auto it = m_threads.find(threadId);
+    if (it == m_threads.end()) {
+        auto index = m_threadsIndex;
+        if (m_threadsIndex < MaxThreads) {
+            ++m_threadsIndex;
+        } else {
+            // Threads of pools come and go, the index of the first thread is kept
+            auto lru = m_threads.end();
+            for (auto i = m_threads.begin(); i != m_threads.end(); ++i) {
+                if (i->index != 0 && (lru == m_threads.end() || i->lastUse < lru->lastUse))
+                    lru = i;
+            }
+            index = lru->index;
+            m_threads.erase(lru);
+        }
+        it = m_threads.insert(threadId, { index, now });
+    } else {
+        it->lastUse = now;
+    }
+
+    *threadsCount = m_threadsIndex;
+    return it->index;
+}
+
+QTLOGGER_DECL_SPEC
+int PrettyFormatter::updateCategoryWidth(int categoryFormatLength)
+{
+    const int width = qMin(categoryFormatLength, m_maxCategoryWidth);
+
+    // The alignment width only grows, so a lock-free maximum is enough
+    int current = m_categoryWidth.loadAcquire();
+    while (width > current) {
+        if (m_categoryWidth.testAndSetOrdered(current, width))
+            return width;
+        current = m_categoryWidth.loadAcquire();
+    }
+
+    return current;
+}
+
 } // namespace QtLogger
\ No newline at end of file
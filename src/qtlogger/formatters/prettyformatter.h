@@ -3,8 +3,13 @@
 
 #pragma once
 
+#include <QAtomicInt>
 #include <QHash>
 
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#endif
+
 #include "../formatter.h"
 #include "../logger_global.h"
 
@@ -21,17 +26,37 @@ public:
         return s_instance;
     }
 
+    // Threads beyond are given the index of the least recently used one
+    static constexpr int MaxThreads = 256;
+
     explicit PrettyFormatter(bool colorize = false, int maxCategoryWidth = 15);
 
     QString format(const LogMessage &lmsg) override;
+    QString formatStyled(const LogMessage &lmsg, QString &plainMessage) override;
 
 private:
+    // Also renders the message without colors into plain, if set
+    QString render(const LogMessage &lmsg, QString *plain);
+    int threadIndex(quint64 threadId, int *threadsCount);
+    int updateCategoryWidth(int categoryFormatLength);
+
     bool m_colorize = false;
     int m_maxCategoryWidth = 15;
 
-    QHash<int, int> m_threads;
+    struct ThreadEntry
+    {
+        int index;
+        quint64 lastUse;
+    };
+
+    // Shared between producer threads when formatting in the caller thread
+    QHash<quint64, ThreadEntry> m_threads;
     int m_threadsIndex = 0;
-    int m_categoryWidth = 0;
+    quint64 m_threadsClock = 0;
+    QAtomicInt m_categoryWidth = 0;
+#ifndef QTLOGGER_NO_THREAD
+    QMutex m_threadsMutex;
+#endif
 };
 
 } // namespace QtLogger
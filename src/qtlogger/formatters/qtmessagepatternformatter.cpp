@@ -0,0 +1,23 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "qtmessagepatternformatter.h"
+
+#include "../messagepatterns.h"
+
+namespace QtLogger {
+
+QTLOGGER_DECL_SPEC
+QtMessagePatternFormatter::QtMessagePatternFormatter(const QString &pattern)
+    : PatternFormatter(pattern.isEmpty() ? defaultPattern() : pattern, Syntax::Qt)
+{
+}
+
+QTLOGGER_DECL_SPEC
+QString QtMessagePatternFormatter::defaultPattern()
+{
+    const auto pattern = QString::fromLocal8Bit(qgetenv("QT_MESSAGE_PATTERN"));
+    return pattern.isEmpty() ? QString::fromUtf8(DefaultMessagePattern) : pattern;
+}
+
+} // namespace QtLogger
@@ -0,0 +1,31 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QSharedPointer>
+
+#include "../logger_global.h"
+#include "patternformatter.h"
+
+namespace QtLogger {
+
+using QtMessagePatternFormatterPtr = QSharedPointer<class QtMessagePatternFormatter>;
+
+// Formats messages like qFormatLogMessage() with a pattern of qSetMessagePattern(), but compiled
+// into the tokens of PatternFormatter: no global pattern and no lock of Qt, and a pattern of its
+// own for every pipeline. Supports all placeholders of Qt, %{backtrace} uses the backtrace captured
+// with the message (see backtrace.h). While a formatter with %{backtrace} exists, the logger
+// unwinds the stack for every message of the process, as Qt does. Other placeholders are
+// attributes, as in PatternFormatter.
+//
+// Without a pattern, the one Qt would use: QT_MESSAGE_PATTERN or the default of Qt.
+class QTLOGGER_EXPORT QtMessagePatternFormatter : public PatternFormatter
+{
+public:
+    explicit QtMessagePatternFormatter(const QString &pattern = QString());
+
+    static QString defaultPattern();
+};
+
+} // namespace QtLogger
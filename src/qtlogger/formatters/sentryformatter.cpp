@@ -8,6 +8,8 @@
 #include <QJsonObject>
 #include <QUuid>
 
+#include "../backtrace.h"
+
 namespace QtLogger {
 
 namespace {
@@ -31,6 +33,38 @@ QString qtMsgTypeToSentryLevel(QtMsgType type)
     }
 }
 
+QTLOGGER_DECL_SPEC
+QString sentryHexAddress(quintptr address)
+{
+    return QStringLiteral("0x") + QString::number(static_cast<qulonglong>(address), 16);
+}
+
+// Sentry stack trace interface, the frames ordered from the outermost call
+QTLOGGER_DECL_SPEC
+QJsonObject sentryStacktrace(const QList<quintptr> &addresses)
+{
+    QJsonArray frames;
+    for (auto it = addresses.crbegin(); it != addresses.crend(); ++it) {
+        const auto frame = Backtrace::resolve(*it);
+
+        QJsonObject object;
+        object[QStringLiteral("instruction_addr")] = sentryHexAddress(frame.address);
+        if (!frame.function.isEmpty())
+            object[QStringLiteral("function")] = frame.function;
+        if (frame.symbolAddress)
+            object[QStringLiteral("symbol_addr")] = sentryHexAddress(frame.symbolAddress);
+        if (!frame.module.isEmpty())
+            object[QStringLiteral("package")] = frame.module;
+        if (frame.moduleAddress)
+            object[QStringLiteral("image_addr")] = sentryHexAddress(frame.moduleAddress);
+        frames.append(object);
+    }
+
+    QJsonObject stacktrace;
+    stacktrace[QStringLiteral("frames")] = frames;
+    return stacktrace;
+}
+
 } // namespace
 
 SentryFormatter::SentryFormatter(const QString &sdkName, const QString &sdkVersion)
@@ -102,13 +136,27 @@ QString SentryFormatter::format(const LogMessage &lmsg)
         if (it.key() == QLatin1String("appname") || it.key() == QLatin1String("appversion")
             || it.key() == QLatin1String("os_name") || it.key() == QLatin1String("os_version")
             || it.key() == QLatin1String("kernel_version") || it.key() == QLatin1String("build_abi")
-            || it.key() == QLatin1String("cpu_arch") || it.key() == QLatin1String("host_name")) {
+            || it.key() == QLatin1String("cpu_arch") || it.key() == QLatin1String("host_name")
+            || it.key() == QLatin1String("backtrace")) {
             continue;
         }
         extra[it.key()] = QJsonValue::fromVariant(it.value());
     }
     event[QStringLiteral("extra")] = extra;
 
+    // Stack trace of the logging thread (captured by the logger, see BacktraceAttr)
+    const auto addresses = lmsg.backtrace();
+    if (!addresses.isEmpty()) {
+        QJsonObject thread;
+        thread[QStringLiteral("id")] = QString::number(lmsg.threadId());
+        thread[QStringLiteral("current")] = true;
+        thread[QStringLiteral("stacktrace")] = sentryStacktrace(addresses);
+
+        QJsonObject threads;
+        threads[QStringLiteral("values")] = QJsonArray { thread };
+        event[QStringLiteral("threads")] = threads;
+    }
+
     // Contexts
     QJsonObject contexts;
 
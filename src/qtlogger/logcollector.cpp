@@ -0,0 +1,190 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifdef QTLOGGER_NETWORK
+
+#include "logcollector.h"
+
+#include <QHash>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSharedPointer>
+
+#include <iostream>
+
+#include "binarylog.h"
+
+namespace QtLogger {
+
+class LogCollector::LogCollectorPrivate
+{
+public:
+    LogCollectorPrivate() { pipeline = SimplePipelinePtr::create(); }
+
+    ~LogCollectorPrivate() { close(); }
+
+    bool listen(const QString &serverName)
+    {
+        close();
+
+        server.reset(new QLocalServer());
+
+        QObject::connect(server.data(), &QLocalServer::newConnection, server.data(),
+                         [this] { acceptConnections(); });
+
+        // A socket file left by a crashed collector would prevent listening
+        if (!server->listen(serverName)
+            && server->serverError() == QAbstractSocket::AddressInUseError
+            && !isServerRunning(serverName) && QLocalServer::removeServer(serverName)) {
+            server->listen(serverName);
+        }
+
+        if (!server->isListening()) {
+            error = server->errorString();
+            server.reset();
+            return false;
+        }
+
+        error.clear();
+        return true;
+    }
+
+    void close()
+    {
+        const auto sockets = readers.keys();
+        for (auto *socket : sockets) {
+            socket->disconnect();
+            read(socket);
+            delete socket;
+        }
+        readers.clear();
+
+        server.reset();
+    }
+
+    SimplePipelinePtr pipeline;
+    QScopedPointer<QLocalServer> server;
+    QString error;
+    quint64 messageCount = 0;
+
+    // Readers are created when the session header has arrived
+    QHash<QLocalSocket *, QSharedPointer<BinaryLogReader>> readers;
+
+private:
+    static bool isServerRunning(const QString &serverName)
+    {
+        QLocalSocket socket;
+        socket.connectToServer(serverName);
+        return socket.waitForConnected(100);
+    }
+
+    void acceptConnections()
+    {
+        while (auto *socket = server->nextPendingConnection()) {
+            // The socket is owned by the collector, not by the server
+            socket->setParent(nullptr);
+            readers.insert(socket, {});
+
+            QObject::connect(socket, &QLocalSocket::readyRead, socket,
+                             [this, socket] { read(socket); });
+            QObject::connect(socket, &QLocalSocket::disconnected, socket, [this, socket] {
+                read(socket);
+                readers.remove(socket);
+                socket->deleteLater();
+            });
+
+            read(socket);
+        }
+    }
+
+    void read(QLocalSocket *socket)
+    {
+        auto it = readers.find(socket);
+        if (it == readers.end())
+            return;
+
+        if (!it.value()) {
+            if (socket->bytesAvailable() < 5)
+                return;
+            it.value() = QSharedPointer<BinaryLogReader>::create(socket);
+        }
+
+        const auto reader = it.value();
+        bool received = false;
+
+        while (auto lmsg = reader->next()) {
+            pipeline->process(*lmsg);
+            ++messageCount;
+            received = true;
+        }
+
+        if (received)
+            pipeline->flush();
+
+        if (!reader->isValid()) {
+            std::cerr << "LogCollector: " << qPrintable(reader->errorString()) << std::endl;
+            readers.remove(socket);
+            socket->disconnect();
+            socket->abort();
+            socket->deleteLater();
+        }
+    }
+};
+
+QTLOGGER_DECL_SPEC
+LogCollector::LogCollector() : d(new LogCollectorPrivate) { }
+
+QTLOGGER_DECL_SPEC
+LogCollector::~LogCollector() = default;
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &LogCollector::pipeline()
+{
+    return *d->pipeline;
+}
+
+QTLOGGER_DECL_SPEC
+bool LogCollector::listen(const QString &serverName)
+{
+    return d->listen(serverName);
+}
+
+QTLOGGER_DECL_SPEC
+void LogCollector::close()
+{
+    d->close();
+}
+
+QTLOGGER_DECL_SPEC
+bool LogCollector::isListening() const
+{
+    return d->server && d->server->isListening();
+}
+
+QTLOGGER_DECL_SPEC
+QString LogCollector::serverName() const
+{
+    return d->server ? d->server->serverName() : QString();
+}
+
+QTLOGGER_DECL_SPEC
+QString LogCollector::errorString() const
+{
+    return d->error;
+}
+
+QTLOGGER_DECL_SPEC
+int LogCollector::connectionCount() const
+{
+    return static_cast<int>(d->readers.size());
+}
+
+QTLOGGER_DECL_SPEC
+quint64 LogCollector::messageCount() const
+{
+    return d->messageCount;
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
@@ -0,0 +1,49 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QScopedPointer>
+#include <QString>
+
+#include "logger_global.h"
+#include "simplepipeline.h"
+
+namespace QtLogger {
+
+// Receives messages from the LocalSocketSinks of many processes and passes them to one pipeline,
+// so the log files of a host are written and rotated by a single process. The received messages
+// have the appname and pid attributes of their process.
+//
+// Connections are served in the thread of the collector, which needs an event loop. The sinks
+// of the pipeline are flushed after every batch of received messages.
+class QTLOGGER_EXPORT LogCollector
+{
+public:
+    LogCollector();
+    ~LogCollector();
+
+    // Pipeline for the received messages, e.g. collector.pipeline().formatPretty().sendToFile(...)
+    SimplePipeline &pipeline();
+
+    bool listen(const QString &serverName);
+    void close();
+    bool isListening() const;
+
+    QString serverName() const;
+    QString errorString() const;
+
+    int connectionCount() const;
+    quint64 messageCount() const;
+
+private:
+    class LogCollectorPrivate;
+    QScopedPointer<LogCollectorPrivate> d;
+    Q_DISABLE_COPY(LogCollector)
+};
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
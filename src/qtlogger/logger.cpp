@@ -12,6 +12,7 @@
 #    include <QMutexLocker>
 #endif
 
+#include "backtrace.h"
 #include "configure.h"
 
 namespace QtLogger {
@@ -86,11 +87,28 @@ QTLOGGER_DECL_SPEC
 void Logger::processMessage(QtMsgType type, const QMessageLogContext &context,
                             const QString &message)
 {
+    LogMessage lmsg(type, context, message);
+
+    // Only the raw addresses are captured here, they are resolved in the thread of the logger
+    Backtrace::attach(lmsg, 1);
+
 #ifndef QTLOGGER_NO_THREAD
+    if (formatInCallerThread()) {
+        // Only the snapshot of the handlers is taken under the lock, so the leading handlers of
+        // the pipeline run concurrently in the calling threads
+        QList<HandlerPtr> handlers;
+        {
+            QMutexLocker locker(mutex());
+            handlers = this->handlers();
+        }
+
+        processInCallerThread(lmsg, handlers);
+        return;
+    }
+
     QMutexLocker locker(mutex());
 #endif
 
-    LogMessage lmsg(type, context, message);
     process(lmsg);
 }
 
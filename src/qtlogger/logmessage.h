@@ -13,6 +13,7 @@
 #endif
 
 #include "logger_global.h"
+#include "threadinfo.h"
 
 namespace QtLogger {
 
@@ -28,6 +29,32 @@ public:
     {
     }
 
+    // Restores a message captured earlier, e.g. read back from a binary log. The context strings
+    // are copied, the steady time is derived from the given time, the thread metadata is empty.
+    LogMessage(QtMsgType type, const QMessageLogContext &context, const QString &message,
+               const QDateTime &time, quintptr qthreadptr = 0) noexcept
+        : m_file(context.file),
+          m_function(context.function),
+          m_category(context.category),
+          m_type(type),
+          m_context(m_file.constData(), context.line, m_function.constData(),
+                    m_category.constData()),
+          m_message(message),
+          m_time(time),
+          m_steadyTime(std::chrono::steady_clock::now()
+                       - std::chrono::milliseconds(time.msecsTo(QDateTime::currentDateTime())))
+#ifndef QTLOGGER_NO_THREAD
+          ,
+          m_qthreadptr(qthreadptr)
+#endif
+          ,
+          m_osThreadId(0)
+    {
+#ifdef QTLOGGER_NO_THREAD
+        Q_UNUSED(qthreadptr)
+#endif
+    }
+
     inline LogMessage(const LogMessage &lmsg) noexcept
         : m_file(lmsg.m_context.file),
           m_function(lmsg.m_context.function),
@@ -41,8 +68,12 @@ public:
 #ifndef QTLOGGER_NO_THREAD
           m_qthreadptr(lmsg.m_qthreadptr),
 #endif
+          m_osThreadId(lmsg.m_osThreadId),
           m_formattedMessage(lmsg.m_formattedMessage),
-          m_attributes(lmsg.m_attributes)
+          m_plainFormattedMessage(lmsg.m_plainFormattedMessage),
+          m_formattedData(lmsg.m_formattedData),
+          m_attributes(lmsg.m_attributes),
+          m_backtrace(lmsg.m_backtrace)
     {
     }
 
@@ -79,6 +110,10 @@ public:
 #endif
     }
 
+    // System id of the thread that logged the message and its current name, see ThreadInfo
+    inline quint64 osThreadId() const { return m_osThreadId; }
+    inline QString threadName() const { return ThreadInfo::name(m_osThreadId); }
+
     // Formatted message
 
     inline QString formattedMessage() const
@@ -88,9 +123,38 @@ public:
     inline void setFormattedMessage(const QString &formattedMessage)
     {
         m_formattedMessage = formattedMessage;
+        m_plainFormattedMessage.clear();
+        m_formattedData.clear();
     }
     inline bool isFormatted() const { return !m_formattedMessage.isNull(); }
 
+    // Formatters that style the message for a terminal, e.g. PrettyFormatter with colors, render it
+    // without the escape sequences in the same pass. Sinks that don't write to a terminal, like
+    // the file sinks, use the plain message.
+
+    inline QString plainFormattedMessage() const
+    {
+        return m_plainFormattedMessage.isNull() ? formattedMessage() : m_plainFormattedMessage;
+    }
+    inline void setFormattedMessage(const QString &formattedMessage,
+                                    const QString &plainFormattedMessage)
+    {
+        m_formattedMessage = formattedMessage;
+        m_plainFormattedMessage = plainFormattedMessage;
+        m_formattedData.clear();
+    }
+
+    // Output of a binary formatter, the last formatter replaces the formatted message or data
+
+    inline QByteArray formattedData() const { return m_formattedData; }
+    inline void setFormattedData(const QByteArray &formattedData)
+    {
+        m_formattedData = formattedData;
+        m_formattedMessage.clear();
+        m_plainFormattedMessage.clear();
+    }
+    inline bool hasFormattedData() const { return !m_formattedData.isNull(); }
+
     // Custom attributes
 
     inline QVariant attribute(const QString &name) const { return m_attributes.value(name); }
@@ -117,6 +181,13 @@ public:
     inline bool hasAttribute(const QString &name) const { return m_attributes.contains(name); }
     inline QVariantHash attributes() const { return m_attributes; }
 
+    // Raw return addresses captured by the logger, innermost call first, see backtrace.h. Kept
+    // apart from the attributes, they are only meaningful within the process that logged them.
+
+    inline QList<quintptr> backtrace() const { return m_backtrace; }
+    inline void setBacktrace(const QList<quintptr> &addresses) { m_backtrace = addresses; }
+    inline bool hasBacktrace() const { return !m_backtrace.isEmpty(); }
+
     // All message attributes including: type, line, file, function, category, message,
     // time, threadId and all custom attributes
     QVariantHash allAttributes() const;
@@ -136,11 +207,33 @@ private:
 #ifndef QTLOGGER_NO_THREAD
     const quintptr m_qthreadptr = reinterpret_cast<quintptr>(QThread::currentThreadId());
 #endif
+    const quint64 m_osThreadId = ThreadInfo::currentId();
 
     QString m_formattedMessage;
+    QString m_plainFormattedMessage;
+    QByteArray m_formattedData;
     QVariantHash m_attributes;
+    QList<quintptr> m_backtrace;
 };
 
+// Orders the message types by severity, from 0 for debug to 4 for fatal
+inline int qtMsgTypePriority(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return 0;
+    case QtInfoMsg:
+        return 1;
+    case QtWarningMsg:
+        return 2;
+    case QtCriticalMsg:
+        return 3;
+    case QtFatalMsg:
+        return 4;
+    }
+    return -1;
+}
+
 inline QString qtMsgTypeToString(QtMsgType type, const QString &a_default = QStringLiteral("debug"))
 {
     static const auto map = QHash<QtMsgType, QString> {
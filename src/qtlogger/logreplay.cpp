@@ -0,0 +1,185 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "logreplay.h"
+
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <algorithm>
+#include <vector>
+
+#include "binarylog.h"
+
+namespace QtLogger {
+
+namespace {
+
+// Sleeping is only accurate to about a millisecond, the rest of the wait is spent yielding
+constexpr qint64 LogReplaySpinTime = 2000000; // ns
+
+qint64 logReplayPercentile(const std::vector<qint64> &sorted, double percentile)
+{
+    if (sorted.empty())
+        return 0;
+
+    const auto index = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1));
+    return sorted.at(index);
+}
+
+void logReplayWaitUntil(const QElapsedTimer &timer, qint64 due)
+{
+    for (;;) {
+        const auto remaining = due - timer.nsecsElapsed();
+        if (remaining <= 0)
+            return;
+
+        if (remaining > LogReplaySpinTime)
+            QThread::usleep(static_cast<unsigned long>((remaining - LogReplaySpinTime) / 1000));
+        else
+            QThread::yieldCurrentThread();
+    }
+}
+
+} // namespace
+
+class LogReplay::LogReplayPrivate
+{
+public:
+    std::vector<LogMessage> messages;
+    QString error;
+
+    Pacing pacing = Pacing::Fast;
+    double speed = 1.0;
+};
+
+QTLOGGER_DECL_SPEC
+LogReplay::LogReplay(const QString &path) : d(new LogReplayPrivate)
+{
+    BinaryLogReader reader(path);
+    if (!reader.isValid()) {
+        d->error = reader.errorString();
+        return;
+    }
+
+    while (auto lmsg = reader.next()) {
+        d->messages.push_back(*lmsg);
+    }
+
+    // A damaged frame ends the recording, the messages before it are replayed
+    if (!reader.isValid())
+        d->error = reader.errorString();
+}
+
+QTLOGGER_DECL_SPEC
+LogReplay::~LogReplay() = default;
+
+QTLOGGER_DECL_SPEC
+bool LogReplay::isValid() const
+{
+    return d->error.isEmpty();
+}
+
+QTLOGGER_DECL_SPEC
+QString LogReplay::errorString() const
+{
+    return d->error;
+}
+
+QTLOGGER_DECL_SPEC
+int LogReplay::count() const
+{
+    return static_cast<int>(d->messages.size());
+}
+
+QTLOGGER_DECL_SPEC
+qint64 LogReplay::duration() const
+{
+    if (d->messages.empty())
+        return 0;
+
+    return d->messages.front().time().msecsTo(d->messages.back().time());
+}
+
+QTLOGGER_DECL_SPEC
+LogReplay::Pacing LogReplay::pacing() const
+{
+    return d->pacing;
+}
+
+QTLOGGER_DECL_SPEC
+void LogReplay::setPacing(Pacing pacing)
+{
+    d->pacing = pacing;
+}
+
+QTLOGGER_DECL_SPEC
+double LogReplay::speed() const
+{
+    return d->speed;
+}
+
+QTLOGGER_DECL_SPEC
+void LogReplay::setSpeed(double speed)
+{
+    if (speed > 0)
+        d->speed = speed;
+}
+
+QTLOGGER_DECL_SPEC
+LogReplay::Stats LogReplay::run(Handler &handler) const
+{
+    Stats stats;
+    if (d->messages.empty())
+        return stats;
+
+    std::vector<qint64> latencies;
+    latencies.reserve(d->messages.size());
+
+    const auto firstTime = d->messages.front().time();
+    const auto paced = d->pacing == Pacing::Original;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (const auto &recorded : d->messages) {
+        // Handlers change the message, every run starts with the recorded one
+        auto lmsg = recorded;
+
+        auto start = timer.nsecsElapsed();
+        if (paced) {
+            const auto due = static_cast<qint64>(
+                    static_cast<double>(firstTime.msecsTo(lmsg.time())) * 1000000 / d->speed);
+            logReplayWaitUntil(timer, due);
+            start = due;
+        }
+
+        handler.process(lmsg);
+
+        latencies.push_back(qMax<qint64>(timer.nsecsElapsed() - start, 0));
+    }
+
+    stats.elapsed = timer.nsecsElapsed();
+    stats.count = latencies.size();
+    stats.throughput = stats.elapsed > 0
+            ? static_cast<double>(stats.count) * 1e9 / static_cast<double>(stats.elapsed)
+            : 0;
+
+    qint64 total = 0;
+    for (const auto latency : latencies) {
+        total += latency;
+    }
+    stats.meanLatency = total / static_cast<qint64>(latencies.size());
+
+    std::sort(latencies.begin(), latencies.end());
+    stats.minLatency = latencies.front();
+    stats.maxLatency = latencies.back();
+    stats.p50Latency = logReplayPercentile(latencies, 0.5);
+    stats.p90Latency = logReplayPercentile(latencies, 0.9);
+    stats.p99Latency = logReplayPercentile(latencies, 0.99);
+    stats.p999Latency = logReplayPercentile(latencies, 0.999);
+
+    return stats;
+}
+
+} // namespace QtLogger
@@ -0,0 +1,78 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QScopedPointer>
+#include <QString>
+
+#include "handler.h"
+#include "logger_global.h"
+#include "logmessage.h"
+
+namespace QtLogger {
+
+// Replays a recorded workload (RecordingSink, or any binary log of BinaryFileSink) into a handler,
+// e.g. a Logger or Pipeline configured like the application, and measures it.
+//
+// The whole recording is loaded before the replay, so decoding doesn't add to the measurement.
+// Messages keep their recorded time, thread, callsite and attributes. With the original pacing they
+// are sent at the recorded intervals, scaled by the speed; the latency of a message is measured
+// from the time it was due, so a handler that falls behind the load is charged for the wait of the
+// following messages. As fast as possible, the latency is the time spent in process(). For a
+// handler with its own thread, only the time to queue the messages is measured.
+class QTLOGGER_EXPORT LogReplay
+{
+public:
+    enum class Pacing {
+        Original, // Recorded intervals between the messages
+        Fast // As fast as possible
+    };
+
+    struct Stats
+    {
+        quint64 count = 0;
+        // From the first message sent to the last one processed, nanoseconds
+        qint64 elapsed = 0;
+        // Messages per second
+        double throughput = 0;
+
+        // Nanoseconds
+        qint64 minLatency = 0;
+        qint64 meanLatency = 0;
+        qint64 p50Latency = 0;
+        qint64 p90Latency = 0;
+        qint64 p99Latency = 0;
+        qint64 p999Latency = 0;
+        qint64 maxLatency = 0;
+    };
+
+    explicit LogReplay(const QString &path);
+    ~LogReplay();
+
+    // False if the recording can't be read
+    bool isValid() const;
+    QString errorString() const;
+
+    // Messages of the recording
+    int count() const;
+    // From the first to the last message of the recording, milliseconds
+    qint64 duration() const;
+
+    Pacing pacing() const;
+    void setPacing(Pacing pacing);
+
+    // Factor for the recorded intervals with the original pacing, e.g. 2 replays twice as fast
+    double speed() const;
+    void setSpeed(double speed);
+
+    // Sends every message of the recording to the handler
+    Stats run(Handler &handler) const;
+
+private:
+    class LogReplayPrivate;
+    QScopedPointer<LogReplayPrivate> d;
+    Q_DISABLE_COPY(LogReplay)
+};
+
+} // namespace QtLogger
@@ -0,0 +1,626 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "logsearch.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QRunnable>
+#    include <QThread>
+#    include <QThreadPool>
+#    include <QWaitCondition>
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "binarylog.h"
+#include "seekablegzip.h"
+#include "termindex.h"
+#include "timeindex.h"
+
+namespace QtLogger {
+
+namespace {
+
+constexpr qint64 LogSearchReadChunkSize = 1024 * 1024;
+
+using LogSearchTask = std::function<QList<LogSearch::Match>()>;
+
+// A part of a log file from a time index entry to the next one
+struct LogSearchRange
+{
+    qint64 begin;
+    qint64 end;
+};
+
+class LogSearchMatcher
+{
+public:
+    explicit LogSearchMatcher(const LogSearch::Query &query)
+        : m_minSeverity(qtMsgTypePriority(query.minLevel)),
+          m_text(query.text),
+          m_caseSensitivity(query.caseSensitivity),
+          m_regex(query.regex)
+    {
+        if (query.from.isValid())
+            m_from = query.from.toMSecsSinceEpoch();
+        if (query.to.isValid())
+            m_to = query.to.toMSecsSinceEpoch();
+
+        if (!query.category.isEmpty()) {
+            auto pattern = QRegularExpression::escape(query.category);
+            pattern.replace(QStringLiteral("\\*"), QStringLiteral(".*"));
+            m_category = QRegularExpression(QStringLiteral("^%1$").arg(pattern));
+        }
+
+        for (const auto &term : query.terms) {
+            const auto normalized = TermIndex::normalizeTerm(term);
+            if (!normalized.isEmpty())
+                m_terms.append(normalized);
+        }
+
+        m_messageConditions = m_minSeverity > 0 || !query.category.isEmpty();
+    }
+
+    qint64 from() const { return m_from; }
+    qint64 to() const { return m_to; }
+    bool hasTimeRange() const
+    {
+        return m_from != std::numeric_limits<qint64>::min()
+                || m_to != std::numeric_limits<qint64>::max();
+    }
+    const QStringList &terms() const { return m_terms; }
+
+    // Level and category conditions can only be checked for binary logs, text logs with them are
+    // reported as not searched
+    bool hasMessageConditions() const { return m_messageConditions; }
+
+    // The messages between the times may overlap the range
+    bool overlaps(qint64 first, qint64 last) const { return last >= m_from && first <= m_to; }
+
+    bool matchesText(const QString &text, const QVariantHash &attributes = QVariantHash()) const
+    {
+        if (!m_text.isEmpty() && !text.contains(m_text, m_caseSensitivity))
+            return false;
+
+        if (!m_regex.pattern().isEmpty() && !m_regex.match(text).hasMatch())
+            return false;
+
+        if (!m_terms.isEmpty()) {
+            // The same terms as in the term index, so indexed files give the same matches
+            const auto terms = TermIndex::terms(text, attributes);
+            for (const auto &term : m_terms) {
+                if (!terms.contains(term))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool matches(const LogMessage &lmsg) const
+    {
+        const auto time = lmsg.time().toMSecsSinceEpoch();
+        if (time < m_from || time > m_to)
+            return false;
+
+        if (qtMsgTypePriority(lmsg.type()) < m_minSeverity)
+            return false;
+
+        if (!m_category.pattern().isEmpty()
+            && !m_category.match(QString::fromUtf8(lmsg.category())).hasMatch()) {
+            return false;
+        }
+
+        return matchesText(lmsg.message(), lmsg.attributes());
+    }
+
+private:
+    qint64 m_from = std::numeric_limits<qint64>::min();
+    qint64 m_to = std::numeric_limits<qint64>::max();
+    int m_minSeverity;
+    QRegularExpression m_category;
+    QString m_text;
+    Qt::CaseSensitivity m_caseSensitivity;
+    QRegularExpression m_regex;
+    QStringList m_terms;
+    bool m_messageConditions = false;
+};
+
+bool isBinaryLog(QIODevice *device)
+{
+    return device->peek(5) == QByteArray(1, BinaryLog::HeaderFrame) + BinaryLog::Magic;
+}
+
+// Offset of the first line that may be in the range, by the last index entry before it
+qint64 logSearchStartOffset(const QList<TimeIndex::Entry> &entries, qint64 from)
+{
+    const auto it = std::lower_bound(entries.cbegin(), entries.cend(), from,
+                                     [](const TimeIndex::Entry &entry, qint64 msecs) {
+                                         return entry.time < msecs;
+                                     });
+    return it == entries.cbegin() ? 0 : std::prev(it)->offset;
+}
+
+// The first entry after the offset
+QList<TimeIndex::Entry>::const_iterator logSearchEntryAfter(const QList<TimeIndex::Entry> &entries,
+                                                            qint64 offset)
+{
+    return std::upper_bound(entries.cbegin(), entries.cend(), offset,
+                            [](qint64 value, const TimeIndex::Entry &entry) {
+                                return value < entry.offset;
+                            });
+}
+
+// Ranges of the time index entries that have all terms in the term index of the log file, the
+// whole file if it has no term index. Nothing if the file doesn't have the terms.
+std::optional<QList<LogSearchRange>> logSearchTermRanges(const QString &logFileName,
+                                                         const QList<TimeIndex::Entry> &entries,
+                                                         const QStringList &terms)
+{
+    const auto whole = QList<LogSearchRange> { { 0, std::numeric_limits<qint64>::max() } };
+
+    if (terms.isEmpty())
+        return whole;
+
+    const auto termIndex = TermIndexReader(TermIndex::indexFileName(logFileName));
+    if (!termIndex.isValid())
+        return whole;
+
+    QList<qint64> offsets;
+    for (int i = 0; i < terms.size(); ++i) {
+        const auto termOffsets = termIndex.ranges(terms.at(i));
+        if (i == 0) {
+            offsets = termOffsets;
+        } else {
+            QList<qint64> common;
+            std::set_intersection(offsets.cbegin(), offsets.cend(), termOffsets.cbegin(),
+                                  termOffsets.cend(), std::back_inserter(common));
+            offsets = common;
+        }
+
+        if (offsets.isEmpty())
+            return std::nullopt;
+    }
+
+    QList<LogSearchRange> ranges;
+    for (const auto offset : std::as_const(offsets)) {
+        const auto next = logSearchEntryAfter(entries, offset);
+        const auto end = next == entries.cend() ? std::numeric_limits<qint64>::max()
+                                                : next->offset;
+
+        if (!ranges.isEmpty() && ranges.last().end == offset)
+            ranges.last().end = end;
+        else
+            ranges.append({ offset, end });
+    }
+
+    return ranges;
+}
+
+bool logSearchOverlaps(const QList<LogSearchRange> &ranges, qint64 begin, qint64 end)
+{
+    return std::any_of(ranges.cbegin(), ranges.cend(), [begin, end](const LogSearchRange &range) {
+        return range.begin < end && range.end > begin;
+    });
+}
+
+// Matches the lines of a part of a text log starting at the offset. False if the lines after it
+// are past the time range.
+bool searchText(const QByteArray &data, qint64 offset, const QString &fileName,
+                const QList<TimeIndex::Entry> &entries, const LogSearchMatcher &matcher,
+                QList<LogSearch::Match> &result)
+{
+    // The last entry at or before the offset
+    int entry = static_cast<int>(logSearchEntryAfter(entries, offset) - entries.cbegin()) - 1;
+    int pos = 0;
+
+    while (pos < data.size()) {
+        const auto newline = data.indexOf('\n', pos);
+        const int end = newline < 0 ? data.size() : newline + 1;
+        const auto lineOffset = offset + pos;
+
+        while (entry + 1 < entries.size() && entries.at(entry + 1).offset <= lineOffset) {
+            ++entry;
+        }
+
+        qint64 time = 0;
+        if (!entries.isEmpty()) {
+            time = entry >= 0 ? entries.at(entry).time : entries.first().time;
+            const auto next = entry + 1 < entries.size() ? entries.at(entry + 1).time
+                                                         : std::numeric_limits<qint64>::max();
+            if (time > matcher.to())
+                return false;
+            if (!matcher.overlaps(time, next)) {
+                pos = end;
+                continue;
+            }
+        }
+
+        auto line = QString::fromUtf8(data.constData() + pos, end - pos);
+        while (line.endsWith(QLatin1Char('\n')) || line.endsWith(QLatin1Char('\r'))) {
+            line.chop(1);
+        }
+
+        if (matcher.matchesText(line)) {
+            LogSearch::Match match;
+            match.time = time;
+            match.fileName = fileName;
+            match.line = line;
+            result.append(match);
+        }
+
+        pos = end;
+    }
+
+    return true;
+}
+
+// Matches the lines of a text log from the offset to the end offset, read in chunks of whole lines
+bool searchTextFile(QIODevice *device, qint64 offset, qint64 end, const QString &fileName,
+                    const QList<TimeIndex::Entry> &entries, const LogSearchMatcher &matcher,
+                    QList<LogSearch::Match> &result)
+{
+    if (!device->seek(offset))
+        return true;
+
+    QByteArray data;
+    while (offset + data.size() < end) {
+        const auto chunk = device->read(qMin(LogSearchReadChunkSize, end - offset - data.size()));
+        if (chunk.isEmpty())
+            break;
+        data.append(chunk);
+
+        // A line longer than a chunk is completed by the next ones
+        const auto lineEnd = data.lastIndexOf('\n') + 1;
+        if (lineEnd == 0)
+            continue;
+
+        if (!searchText(data.left(lineEnd), offset, fileName, entries, matcher, result))
+            return false;
+
+        data.remove(0, lineEnd);
+        offset += lineEnd;
+    }
+
+    return data.isEmpty() || searchText(data, offset, fileName, entries, matcher, result);
+}
+
+QList<LogSearch::Match> searchBinary(QIODevice *device, const QString &fileName,
+                                     const LogSearchMatcher &matcher)
+{
+    QList<LogSearch::Match> result;
+
+    BinaryLogReader reader(device);
+    while (auto lmsg = reader.next()) {
+        if (!matcher.matches(*lmsg))
+            continue;
+
+        LogSearch::Match match;
+        match.time = lmsg->time().toMSecsSinceEpoch();
+        match.fileName = fileName;
+        match.message = QSharedPointer<const LogMessage>::create(*lmsg);
+        result.append(match);
+    }
+
+    return result;
+}
+
+#ifndef QTLOGGER_NO_THREAD
+class LogSearchRunnable : public QRunnable
+{
+public:
+    explicit LogSearchRunnable(std::function<void()> function) : m_function(std::move(function))
+    {
+    }
+
+    void run() override { m_function(); }
+
+private:
+    std::function<void()> m_function;
+};
+#endif
+
+} // namespace
+
+class LogSearch::LogSearchPrivate
+{
+public:
+    explicit LogSearchPrivate(const QString &logFileName) : logFileName(logFileName) { }
+
+    void addError(const QString &fileName, const QString &reason)
+    {
+        const QMutexLocker locker(&mutex);
+        errors.append(QStringLiteral("%1: %2").arg(fileName, reason));
+    }
+
+    void addReadError(const QString &fileName)
+    {
+        addError(fileName, QStringLiteral("can't be read"));
+    }
+
+    // The lines don't have the level and category, so the file can't be searched
+    bool rejectsText(const QString &fileName, const LogSearchMatcher &matcher)
+    {
+        if (!matcher.hasMessageConditions())
+            return false;
+
+        addError(fileName, QStringLiteral("level and category can't be matched in a text log"));
+        return true;
+    }
+
+    // The lines of a text log only have the times of its time index
+    void checkTimeRange(const QString &fileName, const QList<TimeIndex::Entry> &entries,
+                        const LogSearchMatcher &matcher)
+    {
+        if (!entries.isEmpty() || !matcher.hasTimeRange())
+            return;
+
+        const QMutexLocker locker(&mutex);
+        warnings.append(
+                QStringLiteral("%1: no time index, the time range can't be applied").arg(fileName));
+    }
+
+    // Tasks searching one file, nothing if the file is outside the time range
+    void addTasks(std::vector<LogSearchTask> &tasks, const QString &fileName,
+                  const QList<TimeIndex::Entry> &entries, qint64 nextFileTime,
+                  const LogSearchMatcher &matcher)
+    {
+        if (!entries.isEmpty() && entries.first().offset == 0
+            && !matcher.overlaps(entries.first().time, nextFileTime)) {
+            return;
+        }
+
+        const auto compressed = fileName.endsWith(QStringLiteral(".gz"));
+
+        // Indexes keep the name of the uncompressed file
+        const auto ranges = logSearchTermRanges(
+                compressed ? fileName.left(fileName.size() - 3) : fileName, entries,
+                matcher.terms());
+        if (!ranges)
+            return;
+
+        if (!compressed) {
+            tasks.push_back([this, fileName, entries, matcher, ranges] {
+                auto file = QFile(fileName);
+                if (!file.open(QIODevice::ReadOnly)) {
+                    addReadError(fileName);
+                    return QList<Match>();
+                }
+
+                if (isBinaryLog(&file))
+                    return searchBinary(&file, fileName, matcher);
+
+                if (rejectsText(fileName, matcher))
+                    return QList<Match>();
+
+                checkTimeRange(fileName, entries, matcher);
+
+                const auto start = logSearchStartOffset(entries, matcher.from());
+
+                QList<Match> result;
+                for (const auto &range : *ranges) {
+                    if (range.end <= start)
+                        continue;
+
+                    if (!searchTextFile(&file, qMax(range.begin, start), range.end, fileName,
+                                        entries, matcher, result)) {
+                        break;
+                    }
+                }
+                return result;
+            });
+            return;
+        }
+
+        auto file = SeekableGzipFile(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            addReadError(fileName);
+            return;
+        }
+
+        // The dictionaries of a binary log are needed for all following records
+        if (isBinaryLog(&file)) {
+            tasks.push_back([this, fileName, matcher] {
+                auto file = SeekableGzipFile(fileName);
+                if (!file.open(QIODevice::ReadOnly)) {
+                    addReadError(fileName);
+                    return QList<Match>();
+                }
+                return searchBinary(&file, fileName, matcher);
+            });
+            return;
+        }
+
+        if (rejectsText(fileName, matcher))
+            return;
+
+        checkTimeRange(fileName, entries, matcher);
+
+        const auto blocks = file.blocks();
+        for (int i = 0; i < blocks.size(); ++i) {
+            if (!entries.isEmpty()) {
+                const auto next = i + 1 < blocks.size() ? blocks.at(i + 1).time : nextFileTime;
+                if (!matcher.overlaps(blocks.at(i).time, next))
+                    continue;
+            }
+
+            const auto end = i + 1 < blocks.size() ? blocks.at(i + 1).uncompressedOffset
+                                                   : file.size();
+            if (!logSearchOverlaps(*ranges, blocks.at(i).uncompressedOffset, end))
+                continue;
+
+            const auto offset = blocks.at(i).uncompressedOffset;
+            tasks.push_back([this, fileName, entries, matcher, i, offset] {
+                auto file = SeekableGzipFile(fileName);
+                if (!file.open(QIODevice::ReadOnly)) {
+                    addReadError(fileName);
+                    return QList<Match>();
+                }
+                QList<Match> result;
+                searchText(file.block(i), offset, fileName, entries, matcher, result);
+                return result;
+            });
+        }
+    }
+
+    QString logFileName;
+    int maxThreadCount = 0;
+
+    QMutex mutex;
+    QStringList errors;
+    QStringList warnings;
+};
+
+QTLOGGER_DECL_SPEC
+LogSearch::LogSearch(const QString &logFileName) : d(new LogSearchPrivate(logFileName)) { }
+
+QTLOGGER_DECL_SPEC
+LogSearch::~LogSearch() = default;
+
+QTLOGGER_DECL_SPEC
+QStringList LogSearch::files() const
+{
+    return TimeIndexReader(d->logFileName).files();
+}
+
+QTLOGGER_DECL_SPEC
+int LogSearch::maxThreadCount() const
+{
+    return d->maxThreadCount;
+}
+
+QTLOGGER_DECL_SPEC
+void LogSearch::setMaxThreadCount(int maxThreadCount)
+{
+    d->maxThreadCount = qMax(maxThreadCount, 0);
+}
+
+QTLOGGER_DECL_SPEC
+QList<LogSearch::Match> LogSearch::search(const Query &query) const
+{
+    QList<Match> matches;
+    search(query, [&matches](const Match &match) { matches.append(match); });
+    return matches;
+}
+
+QTLOGGER_DECL_SPEC
+void LogSearch::search(const Query &query, const std::function<void(const Match &)> &callback) const
+{
+    {
+        const QMutexLocker locker(&d->mutex);
+        d->errors.clear();
+        d->warnings.clear();
+    }
+
+    const auto matcher = LogSearchMatcher(query);
+    const auto fileList = files();
+
+    // Time indexes of compressed files keep the name of the uncompressed file
+    QList<QList<TimeIndex::Entry>> indexes;
+    for (auto fileName : fileList) {
+        if (fileName.endsWith(QStringLiteral(".gz")))
+            fileName.chop(3);
+        indexes.append(TimeIndex::readEntries(TimeIndex::indexFileName(fileName)));
+    }
+
+    // The tasks of the file i are fileTasks[i] to fileTasks[i + 1]
+    std::vector<LogSearchTask> tasks;
+    std::vector<size_t> fileTasks;
+    for (int i = 0; i < fileList.size(); ++i) {
+        // The next file starts after the last message of this one
+        auto nextFileTime = std::numeric_limits<qint64>::max();
+        if (i + 1 < fileList.size() && !indexes.at(i + 1).isEmpty()
+            && indexes.at(i + 1).first().offset == 0) {
+            nextFileTime = indexes.at(i + 1).first().time;
+        }
+
+        fileTasks.push_back(tasks.size());
+        d->addTasks(tasks, fileList.at(i), indexes.at(i), nextFileTime, matcher);
+    }
+    fileTasks.push_back(tasks.size());
+
+    std::vector<QList<Match>> results(tasks.size());
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex doneMutex;
+    QWaitCondition doneCondition;
+    std::vector<bool> taskDone(tasks.size(), false);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(d->maxThreadCount > 0 ? d->maxThreadCount
+                                                 : QThread::idealThreadCount());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        pool.start(new LogSearchRunnable([&, i] {
+            results[i] = tasks[i]();
+
+            const QMutexLocker locker(&doneMutex);
+            taskDone[i] = true;
+            doneCondition.wakeAll();
+        }));
+    }
+#endif
+
+    // Tasks are in file order, so the sort keeps the order of messages with the same time. Lines
+    // without a time are sorted by the time of the match before them, which keeps them in place.
+    // Rotated files don't overlap in time, the matches of a file are passed on as soon as it and
+    // the files before it are searched.
+    auto lastTime = std::numeric_limits<qint64>::min();
+    for (size_t file = 0; file + 1 < fileTasks.size(); ++file) {
+        std::vector<std::pair<qint64, Match>> sorted;
+
+        for (size_t i = fileTasks[file]; i < fileTasks[file + 1]; ++i) {
+#ifndef QTLOGGER_NO_THREAD
+            {
+                QMutexLocker locker(&doneMutex);
+                while (!taskDone[i]) {
+                    doneCondition.wait(&doneMutex);
+                }
+            }
+#else
+            results[i] = tasks[i]();
+#endif
+
+            for (auto &match : results[i]) {
+                if (match.message || match.time != 0)
+                    lastTime = match.time;
+                sorted.emplace_back(lastTime, std::move(match));
+            }
+            results[i].clear();
+        }
+
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const std::pair<qint64, Match> &a, const std::pair<qint64, Match> &b) {
+                             return a.first < b.first;
+                         });
+
+        for (const auto &entry : sorted) {
+            callback(entry.second);
+        }
+    }
+}
+
+QTLOGGER_DECL_SPEC
+QStringList LogSearch::errors() const
+{
+    const QMutexLocker locker(&d->mutex);
+    return d->errors;
+}
+
+QTLOGGER_DECL_SPEC
+QStringList LogSearch::warnings() const
+{
+    const QMutexLocker locker(&d->mutex);
+    return d->warnings;
+}
+
+} // namespace QtLogger
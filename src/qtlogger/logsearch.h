@@ -0,0 +1,103 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QDateTime>
+#include <QList>
+#include <QRegularExpression>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+
+#include "logger_global.h"
+#include "logmessage.h"
+
+namespace QtLogger {
+
+// Searches a log and its rotated files, plain and compressed with
+// RotatingFileSink::BlockCompression, in a thread pool.
+//
+// Every plain file and every block of a compressed text file is searched by its own task, a
+// compressed binary log by one task, as its dictionaries are only written once. The time indexes
+// (RotatingFileSink::TimeIndex) are used to skip files, blocks and parts of files outside the time
+// range, the term indexes (RotatingFileSink::TermIndex) to skip them if they don't have the
+// terms of the query. The matches of the tasks of a file are merged in time order and passed on
+// file by file, oldest first. Plain files are read in chunks.
+//
+// Binary logs (BinaryFileSink) are matched message by message. Text logs are matched line by line:
+// a line gets the time of the time index entry before it, so the time range applies with the
+// granularity of the index. The time range can't be applied to text logs without a time index,
+// they are searched completely and reported by warnings(). Level and category conditions can't be checked in text logs, the text
+// logs of a query with them are reported by errors() instead of being searched. Compressed files
+// without a block index can't be read.
+class QTLOGGER_EXPORT LogSearch
+{
+public:
+    struct Query
+    {
+        // Invalid times don't limit the range
+        QDateTime from;
+        QDateTime to;
+
+        // Binary logs only, text logs are reported by errors()
+        QtMsgType minLevel = QtDebugMsg;
+        // Category name, '*' matches any characters; empty matches all
+        QString category;
+
+        // Substring of the message or line, and a regular expression, both must match if set
+        QString text;
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive;
+        QRegularExpression regex;
+
+        // Terms that must all be tokens of the message or line, or values of attributes of binary
+        // log messages, case insensitive. See termindex.h for tokens; files and ranges without
+        // them are skipped by their term index (RotatingFileSink::TermIndex).
+        QStringList terms;
+    };
+
+    struct Match
+    {
+        // Milliseconds since epoch, 0 for text lines of files without a time index, which are
+        // merged in file order after the matches before them
+        qint64 time = 0;
+        QString fileName;
+        // The line of a text log, without the line break
+        QString line;
+        // The message of a binary log
+        QSharedPointer<const LogMessage> message;
+    };
+
+    // The path of the active log file, as given to the sink
+    explicit LogSearch(const QString &logFileName);
+    ~LogSearch();
+
+    // Files that are searched, oldest first
+    QStringList files() const;
+
+    // 0 uses QThread::idealThreadCount()
+    int maxThreadCount() const;
+    void setMaxThreadCount(int maxThreadCount);
+
+    QList<Match> search(const Query &query) const;
+
+    // Calls the callback with the matches of every file as soon as the file and the files before it
+    // are searched, on the calling thread
+    void search(const Query &query, const std::function<void(const Match &)> &callback) const;
+
+    // Files that couldn't be read or searched by the last search, as "<file>: <reason>"
+    QStringList errors() const;
+
+    // Files the time range of the last search couldn't be applied to, as "<file>: <reason>"
+    QStringList warnings() const;
+
+private:
+    class LogSearchPrivate;
+    QScopedPointer<LogSearchPrivate> d;
+    Q_DISABLE_COPY(LogSearch)
+};
+
+} // namespace QtLogger
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <type_traits>
 
 #include <QAtomicInt>
@@ -13,6 +14,8 @@
 #include "handler.h"
 #include "logger_global.h"
 #include "logmessage.h"
+#include "pipeline.h"
+#include "sink.h"
 
 namespace QtLogger {
 
@@ -36,6 +39,51 @@ public:
 
     bool ownThreadIsRunning() const { return m_thread && m_thread->isRunning(); }
 
+    // When enabled, the leading attribute handlers, filters and formatters of the pipeline run
+    // synchronously in the calling thread and only the remaining sinks and nested pipelines are
+    // queued to the own thread. The leading handlers must be thread-safe. Sinks at the very start
+    // of the pipeline, e.g. a RecordingSink, don't end the leading handlers: they get the message
+    // as it was logged in the own thread.
+    OwnThreadHandler<BaseHandler> &setFormatInCallerThread(bool enabled)
+    {
+        static_assert(std::is_base_of<Pipeline, BaseHandler>::value,
+                      "Formatting in the caller thread requires a Pipeline");
+        m_formatInCallerThread.storeRelease(enabled ? 1 : 0);
+        return *this;
+    }
+
+    bool formatInCallerThread() const { return m_formatInCallerThread.loadAcquire() != 0; }
+
+    // Messages at or above the level take a separate lane: the worker handles them before the
+    // next queued message and flushes the sinks after them, so they don't wait behind a backlog.
+    // When ordered, they keep their place among the queued messages and only the sinks are
+    // flushed after them, writing out the backlog before them as well.
+    OwnThreadHandler<BaseHandler> &setPriorityLane(QtMsgType minLevel = QtWarningMsg,
+                                                   bool ordered = false)
+    {
+        m_priorityLaneLevel.storeRelease(minLevel);
+        m_priorityLane.storeRelease(ordered ? PriorityLaneOrdered : PriorityLaneBypass);
+        return *this;
+    }
+
+    OwnThreadHandler<BaseHandler> &disablePriorityLane()
+    {
+        m_priorityLane.storeRelease(PriorityLaneDisabled);
+        return *this;
+    }
+
+    bool hasPriorityLane() const { return m_priorityLane.loadAcquire() != PriorityLaneDisabled; }
+
+    QtMsgType priorityLaneLevel() const
+    {
+        return static_cast<QtMsgType>(m_priorityLaneLevel.loadAcquire());
+    }
+
+    bool priorityLaneOrdered() const
+    {
+        return m_priorityLane.loadAcquire() == PriorityLaneOrdered;
+    }
+
     OwnThreadHandler<BaseHandler> &moveToOwnThread()
     {
         QMutexLocker locker(&m_mutex);
@@ -100,21 +148,177 @@ public:
 
     bool process(LogMessage &lmsg) override
     {
+        if constexpr (std::is_base_of<Pipeline, BaseHandler>::value) {
+            if (formatInCallerThread()) {
+                return processInCallerThread(lmsg, BaseHandler::handlers());
+            }
+        }
+
         QMutexLocker locker(&m_mutex);
 
         if (m_worker) {
-            m_pendingCount.fetchAndAddOrdered(1);
-            QCoreApplication::postEvent(m_worker, new LogEvent(lmsg));
+            postLogEvent(new LogEvent(lmsg));
         } else {
             BaseHandler::process(lmsg);
         }
         return true;
     }
 
+protected:
+    bool processInCallerThread(LogMessage &lmsg, const QList<HandlerPtr> &handlers)
+    {
+        int leading = 0;
+        while (leading < handlers.size()
+               && (!handlers.at(leading)
+                   || handlers.at(leading)->type() == Handler::HandlerType::Sink)) {
+            ++leading;
+        }
+
+        std::optional<LogMessage> unprocessed;
+        if (leading > 0)
+            unprocessed = lmsg;
+
+        int first = leading;
+        bool passed = true;
+        for (; first < handlers.size(); ++first) {
+            const auto &handler = handlers.at(first);
+            if (!handler)
+                continue;
+            if (handler->type() == Handler::HandlerType::Sink
+                || handler->type() == Handler::HandlerType::Pipeline)
+                break;
+            if (!handler->process(lmsg)) {
+                passed = false;
+                break;
+            }
+        }
+
+        const auto tail = passed ? handlers.mid(first) : QList<HandlerPtr>();
+        if (!unprocessed && tail.isEmpty())
+            return true;
+
+        QMutexLocker locker(&m_mutex);
+
+        if (unprocessed)
+            processInOwnThread(*unprocessed, handlers.mid(0, leading));
+        if (!tail.isEmpty())
+            processInOwnThread(lmsg, tail);
+        return true;
+    }
+
 private:
+    enum PriorityLane { PriorityLaneDisabled, PriorityLaneBypass, PriorityLaneOrdered };
+
+    struct LogEvent;
+
+    static void processHandlers(LogMessage &lmsg, const QList<HandlerPtr> &handlers)
+    {
+        for (const auto &handler : handlers) {
+            if (!handler)
+                continue;
+            if (!handler->process(lmsg))
+                break;
+        }
+    }
+
+    static void flushHandlers(const QList<HandlerPtr> &handlers)
+    {
+        for (const auto &handler : handlers) {
+            if (auto sink = handler.dynamicCast<Sink>()) {
+                sink->flush();
+            } else if (auto pipeline = handler.dynamicCast<Pipeline>()) {
+                flushHandlers(std::as_const(*pipeline).handlers());
+            }
+        }
+    }
+
+    // Called with m_mutex locked
+    void processInOwnThread(LogMessage &lmsg, const QList<HandlerPtr> &handlers)
+    {
+        if (m_worker) {
+            postLogEvent(new LogEvent(lmsg, handlers));
+        } else {
+            processHandlers(lmsg, handlers);
+        }
+    }
+
+    // Called with m_mutex locked
+    void postLogEvent(LogEvent *event)
+    {
+        m_pendingCount.fetchAndAddOrdered(1);
+
+        const auto lane = m_priorityLane.loadAcquire();
+        if (lane == PriorityLaneDisabled
+            || qtMsgTypePriority(event->lmsg.type()) < qtMsgTypePriority(priorityLaneLevel())) {
+            QCoreApplication::postEvent(m_worker, event);
+            return;
+        }
+
+        if (lane == PriorityLaneOrdered) {
+            event->flush = true;
+            QCoreApplication::postEvent(m_worker, event);
+            return;
+        }
+
+        {
+            QMutexLocker locker(&m_priorityMutex);
+            m_priorityEvents.append(event);
+            m_priorityCount.storeRelease(static_cast<int>(m_priorityEvents.size()));
+        }
+
+        // Wakes the worker when the queue is empty, the lane is drained before any queued event
+        QCoreApplication::postEvent(m_worker, new QEvent(LogEvent::type()), Qt::HighEventPriority);
+    }
+
+    void processLogEvent(LogEvent *event)
+    {
+        if (event->handlers.isEmpty()) {
+            BaseHandler::process(event->lmsg);
+        } else {
+            processHandlers(event->lmsg, event->handlers);
+        }
+
+        if (event->flush)
+            flushSinks();
+    }
+
+    // Called in the own thread before every queued event
+    void processPriorityEvents()
+    {
+        if (m_priorityCount.loadAcquire() == 0)
+            return;
+
+        QList<LogEvent *> events;
+        {
+            QMutexLocker locker(&m_priorityMutex);
+            events.swap(m_priorityEvents);
+            m_priorityCount.storeRelease(0);
+        }
+
+        for (const auto event : std::as_const(events)) {
+            processLogEvent(event);
+        }
+        flushSinks();
+
+        qDeleteAll(events);
+        m_pendingCount.fetchAndSubOrdered(static_cast<int>(events.size()));
+    }
+
+    void flushSinks()
+    {
+        if constexpr (std::is_base_of<Pipeline, BaseHandler>::value) {
+            flushHandlers(BaseHandler::handlers());
+        } else if constexpr (std::is_base_of<Sink, BaseHandler>::value) {
+            BaseHandler::flush();
+        }
+    }
+
     struct LogEvent : public QEvent
     {
-        LogEvent(const LogMessage &lmsg) : QEvent(type()), lmsg(lmsg) { }
+        LogEvent(const LogMessage &lmsg, const QList<HandlerPtr> &handlers = {})
+            : QEvent(type()), lmsg(lmsg), handlers(handlers)
+        {
+        }
 
         static QEvent::Type type()
         {
@@ -123,6 +327,10 @@ private:
         }
 
         LogMessage lmsg;
+        // Rest of the pipeline when the leading handlers already ran in the caller thread
+        QList<HandlerPtr> handlers;
+        // Flushes the sinks after the message, for messages of the ordered priority lane
+        bool flush = false;
     };
 
     class Worker : public QObject
@@ -133,9 +341,12 @@ private:
         void customEvent(QEvent *event) override
         {
             if (event->type() == LogEvent::type()) {
+                m_handler->processPriorityEvents();
+
+                // Otherwise a wake-up for the priority lane
                 auto logEvent = dynamic_cast<LogEvent *>(event);
                 if (logEvent) {
-                    m_handler->BaseHandler::process(logEvent->lmsg);
+                    m_handler->processLogEvent(logEvent);
                     m_handler->m_pendingCount.fetchAndSubOrdered(1);
                 }
             }
@@ -150,6 +361,13 @@ private:
     Worker *m_worker = nullptr;
     QMutex m_mutex;
     QAtomicInt m_pendingCount;
+    QAtomicInt m_formatInCallerThread;
+
+    QAtomicInt m_priorityLane;
+    QAtomicInt m_priorityLaneLevel { QtWarningMsg };
+    QMutex m_priorityMutex;
+    QList<LogEvent *> m_priorityEvents;
+    QAtomicInt m_priorityCount;
 };
 
 } // namespace QtLogger
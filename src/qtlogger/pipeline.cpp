@@ -52,12 +52,16 @@ QTLOGGER_DECL_SPEC
 bool Pipeline::process(LogMessage &lmsg)
 {
     QString fmsg;
+    QString plainFmsg;
+    QByteArray fdata;
     QVariantHash attrs;
 
     if (m_scoped) {
         if (lmsg.isFormatted()) {
             fmsg = lmsg.formattedMessage();
+            plainFmsg = lmsg.plainFormattedMessage();
         }
+        fdata = lmsg.formattedData();
         attrs = lmsg.attributes();
     }
 
@@ -69,7 +73,10 @@ bool Pipeline::process(LogMessage &lmsg)
     }
 
     if (m_scoped) {
-        lmsg.setFormattedMessage(fmsg);
+        if (!fdata.isNull())
+            lmsg.setFormattedData(fdata);
+        else
+            lmsg.setFormattedMessage(fmsg, plainFmsg);
         lmsg.setAttributes(attrs);
     }
 
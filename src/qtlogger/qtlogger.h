@@ -2,9 +2,13 @@
 
 #include "attrhandler.h"
 #include "attrhandlers/appinfoattrs.h"
+#include "attrhandlers/backtraceattr.h"
 #include "attrhandlers/functionattrhandler.h"
+#include "attrhandlers/messagetemplateattr.h"
 #include "attrhandlers/seqnumberattr.h"
 #include "attrhandlers/sysinfoattrs.h"
+#include "backtrace.h"
+#include "binarylog.h"
 #include "filter.h"
 #include "filters/categoryfilter.h"
 #include "filters/duplicatefilter.h"
@@ -12,34 +16,57 @@
 #include "filters/levelfilter.h"
 #include "filters/regexpfilter.h"
 #include "formatter.h"
+#include "formatters/cborformatter.h"
 #include "formatters/functionformatter.h"
 #include "formatters/jsonformatter.h"
+#include "formatters/logfmtformatter.h"
 #include "formatters/patternformatter.h"
 #include "formatters/prettyformatter.h"
 #include "formatters/qtlogmessageformatter.h"
+#include "formatters/qtmessagepatternformatter.h"
 #include "formatters/sentryformatter.h"
 #include "functionhandler.h"
 #include "sentry.h"
 #include "handler.h"
 #include "logger.h"
 #include "logmessage.h"
+#include "logreplay.h"
+#include "logsearch.h"
 #include "messagepatterns.h"
 #include "pipeline.h"
+#include "seekablegzip.h"
+#include "segmentedlog.h"
+#include "sharedmemoryring.h"
 #include "simplepipeline.h"
 #include "sink.h"
+#include "sinks/batchsignalsink.h"
+#include "sinks/binaryfilesink.h"
 #include "sinks/filesink.h"
 #include "sinks/iodevicesink.h"
+#include "sinks/logmodelsink.h"
 #include "sinks/platformstdsink.h"
+#include "sinks/recordingsink.h"
 #include "sinks/rotatingfilesink.h"
+#include "sinks/segmentedlogsink.h"
+#include "sinks/sharedmemorysink.h"
 #include "sinks/signalsink.h"
+#include "sinks/sinkthread.h"
 #include "sinks/stderrsink.h"
 #include "sinks/stdoutsink.h"
 #include "sortedpipeline.h"
+#include "termindex.h"
+#include "threadinfo.h"
+#include "timeindex.h"
 #include "utils.h"
 
 #ifdef QTLOGGER_NETWORK
 #    include "attrhandlers/hostinfoattrs.h"
+#    include "logcollector.h"
+#    include "sinks/gelfsink.h"
 #    include "sinks/httpsink.h"
+#    include "sinks/localsocketsink.h"
+#    include "sinks/otlpsink.h"
+#    include "sinks/tcpsink.h"
 #endif
 
 #ifdef Q_OS_WIN
@@ -61,3 +88,7 @@
 #ifdef QTLOGGER_SDJOURNAL
 #    include "sinks/sdjournalsink.h"
 #endif
+
+#ifdef QTLOGGER_SQL
+#    include "sinks/sqlitesink.h"
+#endif
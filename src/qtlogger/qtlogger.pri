@@ -24,10 +24,20 @@ qtlogger_network {
     QT *= network
     SOURCES += \
         $$PWD/attrhandlers/hostinfoattrs.cpp \
-        $$PWD/sinks/httpsink.cpp
+        $$PWD/logcollector.cpp \
+        $$PWD/sinks/gelfsink.cpp \
+        $$PWD/sinks/httpsink.cpp \
+        $$PWD/sinks/localsocketsink.cpp \
+        $$PWD/sinks/otlpsink.cpp \
+        $$PWD/sinks/tcpsink.cpp
     HEADERS += \
         $$PWD/attrhandlers/hostinfoattrs.h \
-        $$PWD/sinks/httpsink.h
+        $$PWD/logcollector.h \
+        $$PWD/sinks/gelfsink.h \
+        $$PWD/sinks/httpsink.h \
+        $$PWD/sinks/localsocketsink.h \
+        $$PWD/sinks/otlpsink.h \
+        $$PWD/sinks/tcpsink.h
 }
 
 windows {
@@ -47,6 +57,9 @@ linux:android {
     HEADERS += $$PWD/sinks/androidlogsink.h
 }
 
+# dladdr() to resolve backtraces
+unix: LIBS *= $$QMAKE_LIBS_DYNLOAD
+
 unix:!android {
     DEFINES *= QTLOGGER_SYSLOG
     SOURCES += $$PWD/sinks/syslogsink.cpp
@@ -59,36 +72,69 @@ qtlogger_journal {
     HEADERS += $$PWD/sinks/sdjournalsink.h
 }
 
+qtlogger_sql {
+    DEFINES *= QTLOGGER_SQL
+    QT *= sql
+    SOURCES += $$PWD/sinks/sqlitesink.cpp
+    HEADERS += $$PWD/sinks/sqlitesink.h
+}
+
 SOURCES += \
     $$PWD/attrhandlers/appinfoattrs.cpp \
     $$PWD/attrhandlers/appuuidattr.cpp \
+    $$PWD/attrhandlers/backtraceattr.cpp \
+    $$PWD/attrhandlers/messagetemplateattr.cpp \
     $$PWD/attrhandlers/seqnumberattr.cpp \
+    $$PWD/backtrace.cpp \
+    $$PWD/binarylog.cpp \
     $$PWD/configure.cpp \
     $$PWD/filters/categoryfilter.cpp \
     $$PWD/filters/duplicatefilter.cpp \
     $$PWD/filters/regexpfilter.cpp \
+    $$PWD/formatters/cborformatter.cpp \
     $$PWD/formatters/jsonformatter.cpp \
+    $$PWD/formatters/logfmtformatter.cpp \
     $$PWD/formatters/patternformatter.cpp \
     $$PWD/formatters/prettyformatter.cpp \
+    $$PWD/formatters/qtmessagepatternformatter.cpp \
     $$PWD/logger.cpp \
+    $$PWD/logreplay.cpp \
+    $$PWD/logsearch.cpp \
     $$PWD/pipeline.cpp \
+    $$PWD/seekablegzip.cpp \
+    $$PWD/segmentedlog.cpp \
+    $$PWD/sharedmemoryring.cpp \
     $$PWD/simplepipeline.cpp \
+    $$PWD/sinks/batchsignalsink.cpp \
+    $$PWD/sinks/binaryfilesink.cpp \
     $$PWD/sinks/coloredconsole.cpp \
     $$PWD/sinks/filesink.cpp \
     $$PWD/sinks/iodevicesink.cpp \
+    $$PWD/sinks/logmodelsink.cpp \
+    $$PWD/sinks/recordingsink.cpp \
     $$PWD/sinks/rotatingfilesink.cpp \
+    $$PWD/sinks/segmentedlogsink.cpp \
+    $$PWD/sinks/sharedmemorysink.cpp \
     $$PWD/sinks/signalsink.cpp \
+    $$PWD/sinks/sinkthread.cpp \
     $$PWD/sinks/stderrsink.cpp \
     $$PWD/sinks/stdoutsink.cpp \
     $$PWD/sortedpipeline.cpp \
+    $$PWD/termindex.cpp \
+    $$PWD/threadinfo.cpp \
+    $$PWD/timeindex.cpp \
     $$PWD/utils.cpp
 
 HEADERS += \
     $$PWD/attrhandler.h \
     $$PWD/attrhandlers/appinfoattrs.h \
     $$PWD/attrhandlers/appuuidattr.h \
+    $$PWD/attrhandlers/backtraceattr.h \
     $$PWD/attrhandlers/functionattrhandler.h \
+    $$PWD/attrhandlers/messagetemplateattr.h \
     $$PWD/attrhandlers/seqnumberattr.h \
+    $$PWD/backtrace.h \
+    $$PWD/binarylog.h \
     $$PWD/configure.h \
     $$PWD/filter.h \
     $$PWD/filters/categoryfilter.h \
@@ -97,28 +143,46 @@ HEADERS += \
     $$PWD/filters/levelfilter.h \
     $$PWD/filters/regexpfilter.h \
     $$PWD/formatter.h \
+    $$PWD/formatters/cborformatter.h \
     $$PWD/formatters/functionformatter.h \
     $$PWD/formatters/jsonformatter.h \
+    $$PWD/formatters/logfmtformatter.h \
     $$PWD/formatters/patternformatter.h \
     $$PWD/formatters/prettyformatter.h \
     $$PWD/formatters/qtlogmessageformatter.h \
+    $$PWD/formatters/qtmessagepatternformatter.h \
     $$PWD/functionhandler.h \
     $$PWD/handler.h \
     $$PWD/logger.h \
     $$PWD/logger_global.h \
     $$PWD/logmessage.h \
+    $$PWD/logreplay.h \
+    $$PWD/logsearch.h \
     $$PWD/messagepatterns.h \
     $$PWD/pipeline.h \
+    $$PWD/seekablegzip.h \
+    $$PWD/segmentedlog.h \
+    $$PWD/sharedmemoryring.h \
     $$PWD/simplepipeline.h \
     $$PWD/sink.h \
+    $$PWD/sinks/batchsignalsink.h \
+    $$PWD/sinks/binaryfilesink.h \
     $$PWD/sinks/coloredconsole.h \
     $$PWD/sinks/filesink.h \
     $$PWD/sinks/iodevicesink.h \
+    $$PWD/sinks/logmodelsink.h \
     $$PWD/sinks/platformstdsink.h \
+    $$PWD/sinks/recordingsink.h \
     $$PWD/sinks/rotatingfilesink.h \
+    $$PWD/sinks/segmentedlogsink.h \
+    $$PWD/sinks/sharedmemorysink.h \
     $$PWD/sinks/signalsink.h \
+    $$PWD/sinks/sinkthread.h \
     $$PWD/sinks/stderrsink.h \
     $$PWD/sinks/stdoutsink.h \
     $$PWD/sortedpipeline.h \
+    $$PWD/termindex.h \
+    $$PWD/threadinfo.h \
+    $$PWD/timeindex.h \
     $$PWD/utils.h \
     $$PWD/version.h
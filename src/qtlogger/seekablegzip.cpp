@@ -0,0 +1,419 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "seekablegzip.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+
+#include "timeindex.h"
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int GzipHeaderSize = 10;
+constexpr int GzipTrailerSize = 8;
+
+quint32 gzipCrc32(const QByteArray &data)
+{
+    static const auto table = [] {
+        std::array<quint32, 256> result {};
+        for (quint32 i = 0; i < 256; ++i) {
+            auto value = i;
+            for (int j = 0; j < 8; ++j) {
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320 : value >> 1;
+            }
+            result[i] = value;
+        }
+        return result;
+    }();
+
+    quint32 crc = 0xFFFFFFFF;
+    for (const auto byte : data) {
+        crc = table[(crc ^ static_cast<quint8>(byte)) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+void appendLittleEndian(QByteArray &data, quint32 value)
+{
+    char bytes[sizeof(value)];
+    qToLittleEndian(value, bytes);
+    data.append(bytes, sizeof(bytes));
+}
+
+void appendLittleEndian(QByteArray &data, qint64 value)
+{
+    char bytes[sizeof(value)];
+    qToLittleEndian(value, bytes);
+    data.append(bytes, sizeof(bytes));
+}
+
+// End of the block starting at the offset: the first message after blockSize bytes
+int seekableGzipBlockEnd(const QByteArray &data, int start, int blockSize,
+                         const QList<TimeIndex::Entry> &entries)
+{
+    if (data.size() - start <= blockSize)
+        return data.size();
+
+    const auto target = start + blockSize;
+
+    const auto it = std::lower_bound(entries.cbegin(), entries.cend(), target,
+                                     [](const TimeIndex::Entry &entry, qint64 offset) {
+                                         return entry.offset < offset;
+                                     });
+    if (it != entries.cend() && it->offset < data.size())
+        return static_cast<int>(it->offset);
+
+    const auto newline = data.indexOf('\n', target - 1);
+    return newline < 0 ? data.size() : newline + 1;
+}
+
+// Time of the message at the offset, or of the last indexed message before it
+qint64 seekableGzipBlockTime(qint64 offset, const QList<TimeIndex::Entry> &entries)
+{
+    const auto it = std::upper_bound(entries.cbegin(), entries.cend(), offset,
+                                     [](qint64 value, const TimeIndex::Entry &entry) {
+                                         return value < entry.offset;
+                                     });
+    return it == entries.cbegin() ? 0 : std::prev(it)->time;
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+QByteArray SeekableGzip::member(const QByteArray &data, int compressionLevel, quint32 *adler32)
+{
+    auto result = QByteArray("\x1f\x8b" // ID1, ID2
+                             "\x08" // CM (Deflate)
+                             "\x00" // FLG
+                             "\x00\x00\x00\x00" // MTIME (0 = unknown)
+                             "\x00" // XFL
+                             "\x03", // OS (Unix)
+                             GzipHeaderSize);
+
+    if (data.isEmpty()) {
+        // A single empty final block
+        result.append("\x03\x00", 2);
+        if (adler32)
+            *adler32 = 1;
+    } else {
+        // Length (4 bytes), zlib header (2 bytes), deflate data, Adler-32 (4 bytes)
+        const auto compressed = qCompress(data, compressionLevel);
+        result.append(compressed.constData() + 6, compressed.size() - 6 - 4);
+        if (adler32)
+            *adler32 = qFromBigEndian<quint32>(compressed.constData() + compressed.size() - 4);
+    }
+
+    appendLittleEndian(result, gzipCrc32(data));
+    appendLittleEndian(result, static_cast<quint32>(data.size()));
+
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+bool SeekableGzip::compress(const QString &fileName, int blockSize)
+{
+    auto inputFile = QFile(fileName);
+    if (!inputFile.open(QIODevice::ReadOnly))
+        return false;
+
+    const auto data = inputFile.readAll();
+    inputFile.close();
+
+    const auto entries = TimeIndex::readEntries(TimeIndex::indexFileName(fileName));
+
+    const auto gzFileName = fileName + QStringLiteral(".gz");
+    auto outputFile = QFile(gzFileName);
+    auto indexFile = QFile(indexFileName(gzFileName));
+
+    if (!outputFile.open(QIODevice::WriteOnly) || !indexFile.open(QIODevice::WriteOnly)) {
+        std::cerr << "SeekableGzip: Can't create compressed file: " << gzFileName.toStdString()
+                  << std::endl;
+        outputFile.remove();
+        return false;
+    }
+
+    auto index = QByteArray(Magic, 4);
+    index.append(static_cast<char>(Version));
+    index.append(3, '\0');
+    appendLittleEndian(index, static_cast<qint64>(data.size()));
+
+    auto ok = true;
+    auto start = 0;
+
+    do {
+        const auto end = seekableGzipBlockEnd(data, start, qMax(blockSize, 1), entries);
+
+        quint32 adler32 = 0;
+        const auto gzipMember = member(data.mid(start, end - start), 5, &adler32);
+
+        appendLittleEndian(index, static_cast<qint64>(start));
+        appendLittleEndian(index, outputFile.pos());
+        appendLittleEndian(index, seekableGzipBlockTime(start, entries));
+        appendLittleEndian(index, adler32);
+        index.append(4, '\0');
+
+        ok = outputFile.write(gzipMember) == gzipMember.size();
+        start = end;
+    } while (ok && start < data.size());
+
+    ok = ok && indexFile.write(index) == index.size();
+    ok = outputFile.flush() && indexFile.flush() && ok;
+
+    if (!ok) {
+        std::cerr << "SeekableGzip: Failed to write compressed file: " << gzFileName.toStdString()
+                  << std::endl;
+        outputFile.remove();
+        indexFile.remove();
+    }
+
+    return ok;
+}
+
+class SeekableGzipFile::SeekableGzipFilePrivate
+{
+public:
+    explicit SeekableGzipFilePrivate(const QString &fileName) : fileName(fileName) { }
+
+    bool loadIndex()
+    {
+        blocks.clear();
+
+        auto file = QFile(SeekableGzip::indexFileName(fileName));
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+
+        const auto data = file.readAll();
+        if (data.size() < SeekableGzip::HeaderSize || !data.startsWith(SeekableGzip::Magic)
+            || static_cast<quint8>(data.at(4)) != SeekableGzip::Version) {
+            return false;
+        }
+
+        uncompressedSize = qFromLittleEndian<qint64>(data.constData() + 8);
+        compressedSize = QFileInfo(fileName).size();
+
+        const auto count = (data.size() - SeekableGzip::HeaderSize) / SeekableGzip::EntrySize;
+        for (int i = 0; i < count; ++i) {
+            const auto entry = data.constData() + SeekableGzip::HeaderSize
+                    + i * SeekableGzip::EntrySize;
+            blocks.append({ qFromLittleEndian<qint64>(entry),
+                            qFromLittleEndian<qint64>(entry + 8),
+                            qFromLittleEndian<qint64>(entry + 16),
+                            qFromLittleEndian<quint32>(entry + 24) });
+        }
+
+        return !blocks.isEmpty() && blocks.first().uncompressedOffset == 0;
+    }
+
+    qint64 uncompressedEnd(int index) const
+    {
+        return index + 1 < blocks.size() ? blocks.at(index + 1).uncompressedOffset
+                                         : uncompressedSize;
+    }
+
+    qint64 compressedEnd(int index) const
+    {
+        return index + 1 < blocks.size() ? blocks.at(index + 1).compressedOffset : compressedSize;
+    }
+
+    // The cached block holding the offset, nullptr on error
+    const QByteArray *cachedBlock(const SeekableGzipFile *q, qint64 offset, qint64 *blockOffset)
+    {
+        const auto index = q->blockAt(offset);
+        if (index < 0)
+            return nullptr;
+
+        if (index != cacheIndex) {
+            cache = q->block(index);
+            const auto size = uncompressedEnd(index) - blocks.at(index).uncompressedOffset;
+            cacheIndex = cache.size() == size ? index : -1;
+            if (cacheIndex < 0)
+                return nullptr;
+        }
+
+        *blockOffset = offset - blocks.at(index).uncompressedOffset;
+        return &cache;
+    }
+
+    QString fileName;
+    QList<SeekableGzip::Block> blocks;
+    qint64 uncompressedSize = 0;
+    qint64 compressedSize = 0;
+
+    QByteArray cache;
+    int cacheIndex = -1;
+};
+
+QTLOGGER_DECL_SPEC
+SeekableGzipFile::SeekableGzipFile(const QString &gzFileName)
+    : d(new SeekableGzipFilePrivate(gzFileName))
+{
+}
+
+QTLOGGER_DECL_SPEC
+SeekableGzipFile::~SeekableGzipFile() = default;
+
+QTLOGGER_DECL_SPEC
+QString SeekableGzipFile::fileName() const
+{
+    return d->fileName;
+}
+
+QTLOGGER_DECL_SPEC
+bool SeekableGzipFile::open(OpenMode mode)
+{
+    if ((mode & ReadWrite) != ReadOnly) {
+        setErrorString(QStringLiteral("Seekable gzip files are read-only"));
+        return false;
+    }
+
+    if (!d->loadIndex()) {
+        setErrorString(QStringLiteral("No valid block index"));
+        return false;
+    }
+
+    // Reads go straight to the cached block
+    return QIODevice::open(ReadOnly | Unbuffered);
+}
+
+QTLOGGER_DECL_SPEC
+void SeekableGzipFile::close()
+{
+    QIODevice::close();
+    d->cache.clear();
+    d->cacheIndex = -1;
+}
+
+QTLOGGER_DECL_SPEC
+bool SeekableGzipFile::isSequential() const
+{
+    return false;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SeekableGzipFile::size() const
+{
+    return d->uncompressedSize;
+}
+
+QTLOGGER_DECL_SPEC
+const QList<SeekableGzip::Block> &SeekableGzipFile::blocks() const
+{
+    return d->blocks;
+}
+
+QTLOGGER_DECL_SPEC
+int SeekableGzipFile::blockAt(qint64 offset) const
+{
+    if (offset < 0 || offset >= d->uncompressedSize)
+        return -1;
+
+    const auto it = std::upper_bound(d->blocks.cbegin(), d->blocks.cend(), offset,
+                                     [](qint64 value, const SeekableGzip::Block &block) {
+                                         return value < block.uncompressedOffset;
+                                     });
+    return static_cast<int>(std::distance(d->blocks.cbegin(), it)) - 1;
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray SeekableGzipFile::block(int index) const
+{
+    if (index < 0 || index >= d->blocks.size())
+        return {};
+
+    const auto &block = d->blocks.at(index);
+    const auto size = d->uncompressedEnd(index) - block.uncompressedOffset;
+    if (size <= 0)
+        return {};
+
+    auto file = QFile(d->fileName);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(block.compressedOffset))
+        return {};
+
+    const auto gzipMember = file.read(d->compressedEnd(index) - block.compressedOffset);
+    if (gzipMember.size() < GzipHeaderSize + GzipTrailerSize
+        || !gzipMember.startsWith("\x1f\x8b\x08") || gzipMember.at(3) != '\0') {
+        return {};
+    }
+
+    // qUncompress() expects the size, a zlib header and the Adler-32 around the deflate data
+    QByteArray zlibData;
+    zlibData.reserve(gzipMember.size());
+    char sizeBytes[4];
+    qToBigEndian(static_cast<quint32>(size), sizeBytes);
+    zlibData.append(sizeBytes, sizeof(sizeBytes));
+    zlibData.append("\x78\x9c", 2);
+    zlibData.append(gzipMember.constData() + GzipHeaderSize,
+                    gzipMember.size() - GzipHeaderSize - GzipTrailerSize);
+    char adlerBytes[4];
+    qToBigEndian(block.adler32, adlerBytes);
+    zlibData.append(adlerBytes, sizeof(adlerBytes));
+
+    const auto data = qUncompress(zlibData);
+    return data.size() == size ? data : QByteArray();
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SeekableGzipFile::readData(char *data, qint64 maxSize)
+{
+    auto offset = pos();
+    qint64 done = 0;
+
+    while (done < maxSize && offset < d->uncompressedSize) {
+        qint64 blockOffset = 0;
+        const auto block = d->cachedBlock(this, offset, &blockOffset);
+        if (!block)
+            return done > 0 ? done : -1;
+
+        const auto count = qMin(maxSize - done, block->size() - blockOffset);
+        std::memcpy(data + done, block->constData() + blockOffset, static_cast<size_t>(count));
+        done += count;
+        offset += count;
+    }
+
+    return done;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SeekableGzipFile::readLineData(char *data, qint64 maxSize)
+{
+    auto offset = pos();
+    qint64 done = 0;
+
+    while (done < maxSize && offset < d->uncompressedSize) {
+        qint64 blockOffset = 0;
+        const auto block = d->cachedBlock(this, offset, &blockOffset);
+        if (!block)
+            return done > 0 ? done : -1;
+
+        const auto newline = block->indexOf('\n', static_cast<int>(blockOffset));
+        const auto available = (newline < 0 ? block->size() : newline + 1) - blockOffset;
+        const auto count = qMin(maxSize - done, available);
+        std::memcpy(data + done, block->constData() + blockOffset, static_cast<size_t>(count));
+        done += count;
+        offset += count;
+
+        if (newline >= 0 && count == available)
+            break;
+    }
+
+    return done;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SeekableGzipFile::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+    return -1;
+}
+
+} // namespace QtLogger
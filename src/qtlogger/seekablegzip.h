@@ -0,0 +1,98 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QList>
+#include <QScopedPointer>
+#include <QString>
+
+#include "logger_global.h"
+
+/*
+ * Seekable gzip file: a sequence of gzip members, each holding an independently compressed block
+ * of about blockSize bytes of the log, so the file is still read by gunzip and zcat. Blocks
+ * start at message boundaries.
+ *
+ * The block index is written next to it as "<file>.gz.gzi":
+ *
+ *   file  := "QTLZ" <u8 version> <3 reserved bytes> <i64 uncompressed size> block*
+ *   block := <i64 uncompressed offset> <i64 compressed offset> <i64 time, ms since epoch>
+ *            <u32 adler-32 of the uncompressed block> <4 reserved bytes>
+ *
+ * Integers are little endian. The time is the time of the first message of the block taken from
+ * the time index of the log (see timeindex.h), 0 if the log has none.
+ */
+
+namespace QtLogger {
+
+namespace SeekableGzip {
+
+constexpr char Magic[] = "QTLZ";
+constexpr quint8 Version = 1;
+constexpr int HeaderSize = 16;
+constexpr int EntrySize = 32;
+
+constexpr int DefaultBlockSize = 1 * 1024 * 1024; // 1 MB
+
+struct Block
+{
+    qint64 uncompressedOffset;
+    qint64 compressedOffset;
+    qint64 time;
+    quint32 adler32;
+};
+
+inline QString indexFileName(const QString &gzFileName)
+{
+    return gzFileName + QStringLiteral(".gzi");
+}
+
+// A complete gzip member with the deflated data
+QTLOGGER_EXPORT QByteArray member(const QByteArray &data, int compressionLevel = 5,
+                                  quint32 *adler32 = nullptr);
+
+// Compresses the file into "<file>.gz" with its block index, the file itself is kept
+QTLOGGER_EXPORT bool compress(const QString &fileName, int blockSize = DefaultBlockSize);
+
+} // namespace SeekableGzip
+
+// Read-only random access to the uncompressed contents of a seekable gzip file.
+//
+// Only the blocks holding the requested range are read and decompressed, the last one is cached.
+// block() does not change the device, so blocks can also be decompressed in parallel.
+class QTLOGGER_EXPORT SeekableGzipFile : public QIODevice
+{
+public:
+    explicit SeekableGzipFile(const QString &gzFileName);
+    ~SeekableGzipFile() override;
+
+    QString fileName() const;
+
+    // Fails if the file has no valid block index
+    bool open(OpenMode mode) override;
+    void close() override;
+
+    bool isSequential() const override;
+    qint64 size() const override;
+
+    const QList<SeekableGzip::Block> &blocks() const;
+    // The block holding the uncompressed offset, -1 if out of range
+    int blockAt(qint64 offset) const;
+    // The uncompressed data of a block, empty on error
+    QByteArray block(int index) const;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 readLineData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    class SeekableGzipFilePrivate;
+    QScopedPointer<SeekableGzipFilePrivate> d;
+    Q_DISABLE_COPY(SeekableGzipFile)
+};
+
+} // namespace QtLogger
@@ -0,0 +1,478 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "segmentedlog.h"
+
+#include <QBuffer>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSaveFile>
+#include <QThread>
+#include <QtEndian>
+
+#ifndef QT_NO_FILESYSTEMWATCHER
+#    include <QFileSystemWatcher>
+#endif
+
+#include <algorithm>
+#include <iostream>
+
+#include "binarylog.h"
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int SegmentedLogPollInterval = 10; // ms
+
+constexpr char SegmentedLogSegmentSuffix[] = ".seg";
+constexpr char SegmentedLogCursorSuffix[] = ".cursor";
+
+} // namespace
+
+namespace SegmentedLog {
+
+// Offset of a record and where it starts in its segment, if known
+struct Mark
+{
+    qint64 offset = 0;
+    qint64 segmentBase = -1;
+    qint64 filePos = -1;
+};
+
+QTLOGGER_DECL_SPEC
+std::optional<Mark> readCursor(const QString &fileName)
+{
+    auto file = QFile(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt;
+
+    const auto fields = file.readAll().simplified().split(' ');
+
+    auto ok = false;
+    auto mark = Mark();
+    mark.offset = fields.first().toLongLong(&ok);
+    if (!ok)
+        return std::nullopt;
+
+    // Cursors committed without a segment position only have the offset
+    if (fields.size() == 3) {
+        auto baseOk = false;
+        auto posOk = false;
+        const auto segmentBase = fields.at(1).toLongLong(&baseOk);
+        const auto filePos = fields.at(2).toLongLong(&posOk);
+        if (baseOk && posOk) {
+            mark.segmentBase = segmentBase;
+            mark.filePos = filePos;
+        }
+    }
+
+    return mark;
+}
+
+} // namespace SegmentedLog
+
+QTLOGGER_DECL_SPEC
+QString SegmentedLog::segmentFileName(const QString &path, qint64 baseOffset)
+{
+    return QDir(path).filePath(QStringLiteral("%1").arg(baseOffset, 20, 10, QLatin1Char('0'))
+                               + QLatin1String(SegmentedLogSegmentSuffix));
+}
+
+QTLOGGER_DECL_SPEC
+QString SegmentedLog::cursorFileName(const QString &path, const QString &name)
+{
+    return QDir(path).filePath(name + QLatin1String(SegmentedLogCursorSuffix));
+}
+
+QTLOGGER_DECL_SPEC
+QList<qint64> SegmentedLog::segments(const QString &path)
+{
+    QList<qint64> bases;
+
+    const auto suffix = QLatin1String(SegmentedLogSegmentSuffix);
+    const auto fileNames = QDir(path).entryList({ QLatin1Char('*') + suffix }, QDir::Files);
+    for (const auto &fileName : fileNames) {
+        auto ok = false;
+        const auto base = fileName.left(fileName.size() - suffix.size()).toLongLong(&ok);
+        if (ok && base >= 0)
+            bases.append(base);
+    }
+
+    std::sort(bases.begin(), bases.end());
+    return bases;
+}
+
+QTLOGGER_DECL_SPEC
+QList<qint64> SegmentedLog::committedOffsets(const QString &path)
+{
+    QList<qint64> offsets;
+
+    const auto dir = QDir(path);
+    const auto fileNames = dir.entryList(
+            { QLatin1Char('*') + QLatin1String(SegmentedLogCursorSuffix) }, QDir::Files);
+    for (const auto &fileName : fileNames) {
+        if (const auto mark = SegmentedLog::readCursor(dir.filePath(fileName)))
+            offsets.append(mark->offset);
+    }
+
+    return offsets;
+}
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLog::isValidConsumerName(const QString &name)
+{
+    if (name.isEmpty() || name.startsWith(QLatin1Char('.')))
+        return false;
+
+    return std::all_of(name.cbegin(), name.cend(), [](QChar c) {
+        return (c.unicode() < 128 && c.isLetterOrNumber()) || c == QLatin1Char('_')
+                || c == QLatin1Char('-') || c == QLatin1Char('.');
+    });
+}
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLog::removeCursor(const QString &path, const QString &name)
+{
+    if (!isValidConsumerName(name))
+        return false;
+
+    return QFile::remove(cursorFileName(path, name));
+}
+
+class SegmentedLogConsumer::SegmentedLogConsumerPrivate
+{
+public:
+    // Opens the segment with the position, or the oldest one if the position was removed
+    bool openSegment()
+    {
+        const auto bases = SegmentedLog::segments(path);
+        if (bases.isEmpty())
+            return false;
+
+        auto it = std::upper_bound(bases.cbegin(), bases.cend(), position);
+        if (it == bases.cbegin()) {
+            lostCount += static_cast<quint64>(bases.first() - position);
+            position = bases.first();
+            ++it;
+        }
+
+        segmentBase = *(it - 1);
+        file.setFileName(SegmentedLog::segmentFileName(path, segmentBase));
+        // Unbuffered, so data read ahead never goes stale when the writer cuts an incomplete record
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+            return false;
+
+        headerRead = false;
+
+#ifndef QT_NO_FILESYSTEMWATCHER
+        if (watcher)
+            watcher->addPath(file.fileName());
+#endif
+
+        return true;
+    }
+
+    void closeSegment()
+    {
+#ifndef QT_NO_FILESYSTEMWATCHER
+        if (watcher && file.isOpen())
+            watcher->removePath(file.fileName());
+#endif
+        file.close();
+    }
+
+    // Checks the header and skips the records before the position, starting from the closest
+    // known mark; false until the writer has written the header of a new segment
+    bool readHeader()
+    {
+        const auto size = file.size();
+        if (size < SegmentedLog::HeaderSize)
+            return false;
+
+        const auto header = file.read(SegmentedLog::HeaderSize);
+        if (!header.startsWith(SegmentedLog::Magic)
+            || static_cast<quint8>(header.at(4)) != SegmentedLog::Version
+            || qFromLittleEndian<qint64>(header.constData() + 8) != segmentBase) {
+            std::cerr << "SegmentedLogConsumer: Invalid segment: " << file.fileName().toStdString()
+                      << std::endl;
+            file.seek(0);
+            return false;
+        }
+
+        headerRead = true;
+
+        auto offset = segmentBase;
+        auto filePos = qint64(SegmentedLog::HeaderSize);
+        for (const auto &mark : { committedMark, seekMark }) {
+            if (mark.segmentBase == segmentBase && mark.offset > offset
+                && mark.offset <= position && mark.filePos >= SegmentedLog::HeaderSize
+                && mark.filePos <= size) {
+                offset = mark.offset;
+                filePos = mark.filePos;
+            }
+        }
+
+        if (filePos != file.pos())
+            file.seek(filePos);
+
+        // The size is read once, records the writer appends meanwhile are skipped by next()
+        char number[SegmentedLog::RecordHeaderSize];
+        while (offset < position && size - filePos >= SegmentedLog::RecordHeaderSize) {
+            if (file.read(number, sizeof(number)) != sizeof(number))
+                break;
+
+            const auto recordSize = qFromLittleEndian<quint32>(number);
+            const auto next = filePos + SegmentedLog::RecordHeaderSize + recordSize;
+            if (recordSize == 0 || next > size || !file.seek(next)) {
+                file.seek(filePos);
+                break;
+            }
+
+            filePos = next;
+            ++offset;
+        }
+
+        // The cursor is ahead of the log, e.g. after the log was removed
+        position = offset;
+
+        return true;
+    }
+
+    // Size of the complete record at the current position, 0 if there is none
+    quint32 recordSize()
+    {
+        const auto pos = file.pos();
+        const auto available = file.size() - pos;
+        if (available < SegmentedLog::RecordHeaderSize)
+            return 0;
+
+        char number[SegmentedLog::RecordHeaderSize];
+        if (file.peek(number, sizeof(number)) != sizeof(number))
+            return 0;
+
+        const auto size = qFromLittleEndian<quint32>(number);
+        if (size == 0 || available - SegmentedLog::RecordHeaderSize < size)
+            return 0;
+
+        return size;
+    }
+
+    std::optional<QByteArray> readRecord()
+    {
+        const auto size = recordSize();
+        if (size == 0)
+            return std::nullopt;
+
+        file.seek(file.pos() + SegmentedLog::RecordHeaderSize);
+        return file.read(size);
+    }
+
+    // Where the record with the position starts, if the segment with it is open
+    SegmentedLog::Mark currentMark() const
+    {
+        auto mark = SegmentedLog::Mark();
+        mark.offset = position;
+        if (file.isOpen() && headerRead) {
+            mark.segmentBase = segmentBase;
+            mark.filePos = file.pos();
+        }
+        return mark;
+    }
+
+    // True if there is a complete record to read or the next segment was started
+    bool hasRecord()
+    {
+        if (!file.isOpen() && !openSegment())
+            return false;
+
+        if (!headerRead && !readHeader())
+            return false;
+
+        return recordSize() > 0 || QFile::exists(SegmentedLog::segmentFileName(path, position));
+    }
+
+    QString path;
+    QString name;
+    bool valid = false;
+
+    QFile file;
+    qint64 segmentBase = 0;
+    bool headerRead = false;
+
+    qint64 position = 0;
+    qint64 committedOffset = 0;
+
+    // Known record positions, so reopening a segment doesn't skip every record before them
+    SegmentedLog::Mark committedMark;
+    SegmentedLog::Mark seekMark;
+    quint64 lostCount = 0;
+
+#ifndef QT_NO_FILESYSTEMWATCHER
+    QFileSystemWatcher *watcher = nullptr;
+#endif
+};
+
+QTLOGGER_DECL_SPEC
+SegmentedLogConsumer::SegmentedLogConsumer(const QString &path, const QString &name,
+                                           QObject *parent)
+    : QObject(parent), d(new SegmentedLogConsumerPrivate)
+{
+    d->path = path;
+    d->name = name;
+    d->valid = SegmentedLog::isValidConsumerName(name);
+
+    if (!d->valid) {
+        std::cerr << "SegmentedLogConsumer: Invalid consumer name: " << name.toStdString()
+                  << std::endl;
+        return;
+    }
+
+    QDir().mkpath(path);
+
+    if (const auto mark = SegmentedLog::readCursor(SegmentedLog::cursorFileName(path, name))) {
+        d->committedMark = *mark;
+        d->committedOffset = mark->offset;
+        d->position = mark->offset;
+    } else {
+        // Registers the consumer, so the retention keeps the messages it hasn't read yet
+        const auto bases = SegmentedLog::segments(path);
+        d->position = bases.isEmpty() ? 0 : bases.first();
+        commit();
+    }
+
+#ifndef QT_NO_FILESYSTEMWATCHER
+    d->watcher = new QFileSystemWatcher(this);
+    d->watcher->addPath(path);
+    QObject::connect(d->watcher, &QFileSystemWatcher::fileChanged, this,
+                     &SegmentedLogConsumer::readyRead);
+    QObject::connect(d->watcher, &QFileSystemWatcher::directoryChanged, this,
+                     &SegmentedLogConsumer::readyRead);
+#endif
+}
+
+QTLOGGER_DECL_SPEC
+SegmentedLogConsumer::~SegmentedLogConsumer() = default;
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLogConsumer::isValid() const
+{
+    return d->valid;
+}
+
+QTLOGGER_DECL_SPEC
+QString SegmentedLogConsumer::path() const
+{
+    return d->path;
+}
+
+QTLOGGER_DECL_SPEC
+QString SegmentedLogConsumer::name() const
+{
+    return d->name;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SegmentedLogConsumer::position() const
+{
+    return d->position;
+}
+
+QTLOGGER_DECL_SPEC
+void SegmentedLogConsumer::seek(qint64 offset)
+{
+    // Remembers where the current record starts, so seeking ahead in the segment continues there
+    d->seekMark = d->currentMark();
+    d->closeSegment();
+    d->position = qMax<qint64>(offset, 0);
+}
+
+QTLOGGER_DECL_SPEC
+std::optional<LogMessage> SegmentedLogConsumer::next()
+{
+    if (!d->valid)
+        return std::nullopt;
+
+    for (;;) {
+        if (!d->hasRecord())
+            return std::nullopt;
+
+        const auto data = d->readRecord();
+        if (!data) {
+            // The segment is complete, the next one starts with the position
+            d->closeSegment();
+            continue;
+        }
+
+        ++d->position;
+
+        QBuffer buffer;
+        buffer.setData(*data);
+        buffer.open(QIODevice::ReadOnly);
+
+        BinaryLogReader reader(&buffer);
+        if (auto lmsg = reader.next())
+            return lmsg;
+    }
+}
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLogConsumer::commit()
+{
+    if (!d->valid)
+        return false;
+
+    auto file = QSaveFile(SegmentedLog::cursorFileName(d->path, d->name));
+    if (!file.open(QIODevice::WriteOnly)) {
+        std::cerr << "SegmentedLogConsumer: Can't open cursor file: "
+                  << file.fileName().toStdString() << " error: " << file.errorString().toStdString()
+                  << std::endl;
+        return false;
+    }
+
+    const auto mark = d->currentMark();
+    auto text = QByteArray::number(mark.offset);
+    if (mark.filePos >= 0)
+        text += ' ' + QByteArray::number(mark.segmentBase) + ' ' + QByteArray::number(mark.filePos);
+
+    file.write(text);
+    if (!file.commit())
+        return false;
+
+    d->committedMark = mark;
+    d->committedOffset = d->position;
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SegmentedLogConsumer::committedOffset() const
+{
+    return d->committedOffset;
+}
+
+QTLOGGER_DECL_SPEC
+quint64 SegmentedLogConsumer::lostCount() const
+{
+    return d->lostCount;
+}
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLogConsumer::waitForReadyRead(int msecs)
+{
+    if (!d->valid)
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!d->hasRecord()) {
+        if (msecs >= 0 && timer.elapsed() >= msecs)
+            return false;
+        QThread::msleep(SegmentedLogPollInterval);
+    }
+
+    return true;
+}
+
+} // namespace QtLogger
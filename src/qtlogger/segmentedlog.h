@@ -0,0 +1,108 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <optional>
+
+#include <QList>
+#include <QObject>
+#include <QScopedPointer>
+#include <QString>
+
+#include "logger_global.h"
+#include "logmessage.h"
+
+/*
+ * Segmented log (written by SegmentedLogSink, read by SegmentedLogConsumer):
+ *
+ *   directory := <segment>* <cursor>*
+ *   segment   := "<base offset, 20 digits>.seg"
+ *                "QTLS" <u8 version> <3 reserved bytes> <i64 base offset> record*
+ *   record    := <u32 size> <binary log session of one message, see binarylog.h>
+ *   cursor    := "<consumer name>.cursor", decimal text "<offset> [<segment base> <position>]"
+ *
+ * Every record has an offset: the first record of a segment has the base offset of the segment,
+ * the following ones count up, and the next segment starts with the offset after the last record
+ * of the previous one. Integers are little endian. A cursor holds the committed offset and, when
+ * known, the segment and byte position of the record with it, so a restarted consumer seeks
+ * straight to the record instead of skipping every record before it.
+ *
+ * The writer appends every record with a single write and starts a new segment when the current
+ * one is full. A record cut short by a crash is removed when the writer opens the log again.
+ * Segments before the slowest committed cursor are removed; with a maximum size, the oldest
+ * segments are removed even if not all consumers have read them.
+ */
+
+namespace QtLogger {
+
+namespace SegmentedLog {
+
+constexpr char Magic[] = "QTLS";
+constexpr quint8 Version = 1;
+constexpr int HeaderSize = 16;
+constexpr int RecordHeaderSize = 4;
+
+QTLOGGER_EXPORT QString segmentFileName(const QString &path, qint64 baseOffset);
+QTLOGGER_EXPORT QString cursorFileName(const QString &path, const QString &name);
+
+// Base offsets of the segments in the directory, ascending
+QTLOGGER_EXPORT QList<qint64> segments(const QString &path);
+
+// Committed offsets of all consumers of the log
+QTLOGGER_EXPORT QList<qint64> committedOffsets(const QString &path);
+
+// Letters, digits, '_', '-' and '.'
+QTLOGGER_EXPORT bool isValidConsumerName(const QString &name);
+
+// Removes the cursor of a consumer that is gone, so it no longer holds back the retention
+QTLOGGER_EXPORT bool removeCursor(const QString &path, const QString &name);
+
+} // namespace SegmentedLog
+
+// Follows a segmented log from its committed offset, in the same or in another process than the
+// writer. Every consumer has a name and its own cursor: after a restart it continues with the first
+// message it didn't commit. A new consumer starts with the oldest message in the log.
+class QTLOGGER_EXPORT SegmentedLogConsumer : public QObject
+{
+    Q_OBJECT
+
+public:
+    SegmentedLogConsumer(const QString &path, const QString &name, QObject *parent = nullptr);
+    ~SegmentedLogConsumer() override;
+
+    // False if the name isn't a valid consumer name
+    bool isValid() const;
+
+    QString path() const;
+    QString name() const;
+
+    // Offset of the next message
+    qint64 position() const;
+    // Continues with the message at the offset. Seeking ahead within the open segment or to the
+    // committed offset is direct, other offsets skip the records from the start of their segment.
+    void seek(qint64 offset);
+
+    // Next message, or nothing if there are no new messages
+    std::optional<LogMessage> next();
+
+    // Stores the position, messages before it are not read again and may be removed
+    bool commit();
+    qint64 committedOffset() const;
+
+    // Messages removed by the maximum size of the log before they were read
+    quint64 lostCount() const;
+
+    // Waits until there is a new message, polling the log; -1 waits without a timeout
+    bool waitForReadyRead(int msecs);
+
+Q_SIGNALS:
+    // The log was written to, emitted in the thread of the consumer when it has an event loop
+    void readyRead();
+
+private:
+    class SegmentedLogConsumerPrivate;
+    QScopedPointer<SegmentedLogConsumerPrivate> d;
+};
+
+} // namespace QtLogger
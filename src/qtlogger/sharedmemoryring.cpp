@@ -0,0 +1,212 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "sharedmemoryring.h"
+
+#ifndef QT_NO_SHAREDMEMORY
+
+#include <QBuffer>
+#include <QSharedMemory>
+
+#include <cstring>
+
+#include "binarylog.h"
+
+namespace QtLogger {
+
+class SharedMemoryReader::SharedMemoryReaderPrivate
+{
+public:
+    explicit SharedMemoryReaderPrivate(const QString &key) : memory(key)
+    {
+        if (!memory.attach(QSharedMemory::ReadOnly)) {
+            error = memory.errorString();
+            return;
+        }
+
+        if (memory.size() < SharedMemoryRing::HeaderSize) {
+            error = QStringLiteral("Not a shared memory ring buffer");
+            return;
+        }
+
+        base = static_cast<const char *>(memory.constData());
+        header = reinterpret_cast<const SharedMemoryRing::Header *>(base);
+
+        if (header->magic != SharedMemoryRing::Magic
+            || header->version != SharedMemoryRing::Version || header->slotCount == 0
+            || header->slotSize <= static_cast<quint32>(SharedMemoryRing::SlotHeaderSize)
+            || memory.size() < SharedMemoryRing::segmentSize(static_cast<int>(header->slotCount),
+                                                             static_cast<int>(header->slotSize))) {
+            error = QStringLiteral("Not a shared memory ring buffer");
+            header = nullptr;
+            return;
+        }
+
+        slotCount = header->slotCount;
+        slotSize = header->slotSize;
+        payloadSize = slotSize - SharedMemoryRing::SlotHeaderSize;
+
+        // Nothing has been overwritten yet, so every lost record can be counted
+        const auto head = header->head.load(std::memory_order_acquire);
+        position = head > slotCount ? head - slotCount : 0;
+        hasNextRecord = head <= slotCount;
+    }
+
+    const SharedMemoryRing::Slot *slotAt(quint64 n) const
+    {
+        return reinterpret_cast<const SharedMemoryRing::Slot *>(
+                base + SharedMemoryRing::HeaderSize + (n % slotCount) * slotSize);
+    }
+
+    bool isComplete(quint64 n) const
+    {
+        return slotAt(n)->state.load(std::memory_order_acquire) == 2 * n + 2;
+    }
+
+    // Copies the record starting at the current position, nothing if it was overwritten meanwhile
+    std::optional<QByteArray> readRecord(quint64 &record, quint32 &slots)
+    {
+        const auto *first = slotAt(position);
+        if (!isComplete(position))
+            return {};
+
+        record = first->record;
+        slots = first->slots;
+        const auto size = first->size;
+
+        // Continuation slot, or fields torn by the writer
+        const auto expectedSlots =
+                qMax<quint64>(1, (static_cast<quint64>(size) + payloadSize - 1) / payloadSize);
+        if (slots == 0 || slots > slotCount || slots != expectedSlots)
+            return {};
+
+        QByteArray data(static_cast<int>(size), Qt::Uninitialized);
+        for (quint32 i = 0; i < slots; ++i) {
+            if (i > 0 && !isComplete(position + i))
+                return {};
+            const auto offset = i * payloadSize;
+            std::memcpy(data.data() + offset,
+                        reinterpret_cast<const char *>(slotAt(position + i))
+                                + SharedMemoryRing::SlotHeaderSize,
+                        qMin(payloadSize, size - offset));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        for (quint32 i = 0; i < slots; ++i) {
+            if (slotAt(position + i)->state.load(std::memory_order_relaxed)
+                != 2 * (position + i) + 2)
+                return {};
+        }
+
+        return data;
+    }
+
+    QSharedMemory memory;
+    QString error;
+
+    const char *base = nullptr;
+    const SharedMemoryRing::Header *header = nullptr;
+    quint64 slotCount = 0;
+    quint32 slotSize = 0;
+    quint32 payloadSize = 0;
+
+    quint64 position = 0;
+    quint64 nextRecord = 0;
+    bool hasNextRecord = false;
+    quint64 overruns = 0;
+};
+
+QTLOGGER_DECL_SPEC
+SharedMemoryReader::SharedMemoryReader(const QString &key) : d(new SharedMemoryReaderPrivate(key))
+{
+}
+
+QTLOGGER_DECL_SPEC
+SharedMemoryReader::~SharedMemoryReader() = default;
+
+QTLOGGER_DECL_SPEC
+bool SharedMemoryReader::isValid() const
+{
+    return d->header != nullptr;
+}
+
+QTLOGGER_DECL_SPEC
+QString SharedMemoryReader::errorString() const
+{
+    return d->error;
+}
+
+QTLOGGER_DECL_SPEC
+std::optional<LogMessage> SharedMemoryReader::next()
+{
+    if (!d->header)
+        return {};
+
+    while (true) {
+        const auto head = d->header->head.load(std::memory_order_acquire);
+
+        // The segment was initialized again by a new writer
+        if (head < d->position) {
+            d->position = head > d->slotCount ? head - d->slotCount : 0;
+            d->hasNextRecord = false;
+        }
+
+        if (d->position == head)
+            return {};
+
+        if (head - d->position > d->slotCount)
+            d->position = head - d->slotCount;
+
+        quint64 record = 0;
+        quint32 slots = 0;
+        const auto data = d->readRecord(record, slots);
+        if (!data) {
+            ++d->position;
+            continue;
+        }
+
+        d->position += slots;
+
+        if (d->hasNextRecord && record > d->nextRecord)
+            d->overruns += record - d->nextRecord;
+        d->nextRecord = record + 1;
+        d->hasNextRecord = true;
+
+        QBuffer buffer;
+        buffer.setData(*data);
+        buffer.open(QIODevice::ReadOnly);
+
+        BinaryLogReader reader(&buffer);
+        if (auto lmsg = reader.next())
+            return lmsg;
+    }
+}
+
+QTLOGGER_DECL_SPEC
+void SharedMemoryReader::skipToLatest()
+{
+    if (!d->header)
+        return;
+
+    // The record counter is published before head, so it never runs behind the position
+    d->position = d->header->head.load(std::memory_order_acquire);
+    d->nextRecord = d->header->nextRecord.load(std::memory_order_relaxed);
+    d->hasNextRecord = true;
+}
+
+QTLOGGER_DECL_SPEC
+quint64 SharedMemoryReader::overruns() const
+{
+    return d->overruns;
+}
+
+QTLOGGER_DECL_SPEC
+quint64 SharedMemoryReader::dropped() const
+{
+    return d->header ? d->header->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace QtLogger
+
+#endif // QT_NO_SHAREDMEMORY
@@ -0,0 +1,116 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QtGlobal>
+
+#ifndef QT_NO_SHAREDMEMORY
+
+#include <atomic>
+#include <optional>
+
+#include <QScopedPointer>
+#include <QString>
+
+#include "logger_global.h"
+#include "logmessage.h"
+
+/*
+ * Shared memory ring buffer (written by SharedMemorySink, read by SharedMemoryReader):
+ *
+ *   segment := <header, 64 bytes> <slot>{slot count}
+ *   slot    := <atomic u64 state> <u64 record seq> <u32 record size> <u32 record slots> <payload>
+ *
+ * A record is a binary log session of a single message (see binarylog.h) stored in one or more
+ * consecutive slots. Slots are numbered by an ever increasing slot sequence, slot n lives at index
+ * n % slot count. Only the first slot of a record has a non-zero record slots field.
+ *
+ * Every slot is a seqlock: the writer sets its state to 2n + 1 while writing slot n and to 2n + 2
+ * when done, then publishes the record by advancing the header head. The writer never waits for
+ * readers and overwrites the oldest slots; readers detect overwritten slots by their state and
+ * count the records they lost from the gaps in the record sequence.
+ *
+ * There is a single writer. It claims the ring by storing its token (process id << 32 | sink
+ * number in the process) in the header writer field with a compare-and-swap and clears it when
+ * done. A ring whose writer process is gone is taken over by the next writer.
+ */
+
+namespace QtLogger {
+
+namespace SharedMemoryRing {
+
+constexpr quint32 Magic = 0x524c5451; // "QTLR"
+constexpr quint32 Version = 2;
+
+static_assert(std::atomic<quint64>::is_always_lock_free,
+              "The shared memory ring buffer requires lock-free 64-bit atomics");
+
+struct Header
+{
+    quint32 magic;
+    quint32 version;
+    quint32 slotSize;
+    quint32 slotCount;
+    std::atomic<quint64> head; // Next slot sequence
+    std::atomic<quint64> nextRecord; // Next record sequence
+    std::atomic<quint64> dropped; // Records larger than the ring
+    std::atomic<quint64> writer; // Token of the writing sink, 0 if none
+    char reserved[16];
+};
+
+struct Slot
+{
+    std::atomic<quint64> state;
+    quint64 record;
+    quint32 size;
+    quint32 slots;
+};
+
+constexpr int HeaderSize = sizeof(Header);
+constexpr int SlotHeaderSize = sizeof(Slot);
+
+static_assert(HeaderSize == 64, "Unexpected shared memory ring header size");
+static_assert(SlotHeaderSize == 24, "Unexpected shared memory ring slot header size");
+
+inline qint64 segmentSize(int slotCount, int slotSize)
+{
+    return HeaderSize + static_cast<qint64>(slotCount) * slotSize;
+}
+
+} // namespace SharedMemoryRing
+
+// Reads the messages of a SharedMemorySink, in the same or in another process. Reading never
+// blocks or slows down the writer: records overwritten before they were read are counted as
+// overruns and skipped.
+class QTLOGGER_EXPORT SharedMemoryReader
+{
+public:
+    explicit SharedMemoryReader(const QString &key);
+    ~SharedMemoryReader();
+
+    // False if the segment doesn't exist or isn't a ring buffer
+    bool isValid() const;
+    QString errorString() const;
+
+    // Next message, or nothing if there are no new messages. Starts with the oldest message
+    // still in the ring.
+    std::optional<LogMessage> next();
+
+    // Skips all messages written so far
+    void skipToLatest();
+
+    // Records lost because the reader was too slow
+    quint64 overruns() const;
+    // Records the writer dropped because they don't fit into the ring
+    quint64 dropped() const;
+
+private:
+    class SharedMemoryReaderPrivate;
+    QScopedPointer<SharedMemoryReaderPrivate> d;
+    Q_DISABLE_COPY(SharedMemoryReader)
+};
+
+} // namespace QtLogger
+
+#endif // QT_NO_SHAREDMEMORY
@@ -4,7 +4,9 @@
 
 #include "attrhandlers/appinfoattrs.h"
 #include "attrhandlers/appuuidattr.h"
+#include "attrhandlers/backtraceattr.h"
 #include "attrhandlers/functionattrhandler.h"
+#include "attrhandlers/messagetemplateattr.h"
 #include "attrhandlers/seqnumberattr.h"
 #include "attrhandlers/sysinfoattrs.h"
 #include "filters/categoryfilter.h"
@@ -12,23 +14,35 @@
 #include "filters/functionfilter.h"
 #include "filters/levelfilter.h"
 #include "filters/regexpfilter.h"
+#include "formatters/cborformatter.h"
 #include "formatters/functionformatter.h"
 #include "formatters/jsonformatter.h"
+#include "formatters/logfmtformatter.h"
 #include "formatters/patternformatter.h"
 #include "formatters/prettyformatter.h"
 #include "formatters/qtlogmessageformatter.h"
+#include "formatters/qtmessagepatternformatter.h"
 #include "formatters/sentryformatter.h"
 #include "functionhandler.h"
 #include "messagepatterns.h"
+#include "sinks/batchsignalsink.h"
+#include "sinks/binaryfilesink.h"
 #include "sinks/platformstdsink.h"
+#include "sinks/recordingsink.h"
 #include "sinks/rotatingfilesink.h"
+#include "sinks/segmentedlogsink.h"
+#include "sinks/sharedmemorysink.h"
 #include "sinks/stderrsink.h"
 #include "sinks/stdoutsink.h"
 #include "sinks/signalsink.h"
 
 #ifdef QTLOGGER_NETWORK
 #    include "attrhandlers/hostinfoattrs.h"
+#    include "sinks/gelfsink.h"
 #    include "sinks/httpsink.h"
+#    include "sinks/localsocketsink.h"
+#    include "sinks/otlpsink.h"
+#    include "sinks/tcpsink.h"
 #endif
 
 #ifdef QTLOGGER_SYSLOG
@@ -47,6 +61,10 @@
 #    include "sinks/sdjournalsink.h"
 #endif
 
+#ifdef QTLOGGER_SQL
+#    include "sinks/sqlitesink.h"
+#endif
+
 #ifdef Q_OS_WIN
 #    include "sinks/windebugsink.h"
 #endif
@@ -60,6 +78,13 @@ SimplePipeline &SimplePipeline::addSeqNumber(const QString &name)
     return *this;
 }
 
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::addMessageTemplates(const QString &name)
+{
+    append(MessageTemplateAttrPtr::create(name));
+    return *this;
+}
+
 QTLOGGER_DECL_SPEC
 SimplePipeline &SimplePipeline::addAppInfo()
 {
@@ -81,6 +106,13 @@ SimplePipeline &SimplePipeline::addSysInfo()
     return *this;
 }
 
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::addBacktrace(QtMsgType minLevel, int depth)
+{
+    append(BacktraceAttrPtr::create(minLevel, depth));
+    return *this;
+}
+
 #ifdef QTLOGGER_NETWORK
 QTLOGGER_DECL_SPEC
 SimplePipeline &SimplePipeline::addHostInfo()
@@ -160,6 +192,13 @@ SimplePipeline &SimplePipeline::formatByQt()
     return *this;
 }
 
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::formatByQtPattern(const QString &pattern)
+{
+    append(QtMessagePatternFormatterPtr::create(pattern));
+    return *this;
+}
+
 QTLOGGER_DECL_SPEC
 SimplePipeline &SimplePipeline::formatPretty(bool colorize, int maxCategoryWidth)
 {
@@ -174,6 +213,22 @@ SimplePipeline &SimplePipeline::formatToJson(bool compact)
     return *this;
 }
 
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::formatToLogfmt(bool withCallsite)
+{
+    append(LogfmtFormatterPtr::create(withCallsite));
+    return *this;
+}
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::formatToCbor()
+{
+    append(CborFormatter::instance());
+    return *this;
+}
+#endif
+
 QTLOGGER_DECL_SPEC
 SimplePipeline &SimplePipeline::formatToSentry(const QString &sdkName, const QString &sdkVersion)
 {
@@ -229,7 +284,9 @@ SimplePipeline &SimplePipeline::sendToFile(const QString &fileName, int maxFileS
 
     if (maxFileSize > 0
         || options.testFlag(RotatingFileSink::RotationOnStartup)
-        || options.testFlag(RotatingFileSink::RotationDaily)) {
+        || options.testFlag(RotatingFileSink::RotationDaily)
+        || options.testFlag(RotatingFileSink::TimeIndex)
+        || options.testFlag(RotatingFileSink::TermIndex)) {
         append(RotatingFileSinkPtr::create(fileName, maxFileSize, maxFileCount, options));
     }
     else {
@@ -239,6 +296,69 @@ SimplePipeline &SimplePipeline::sendToFile(const QString &fileName, int maxFileS
     return *this;
 }
 
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToBinaryFile(const QString &fileName, int maxFileSize,
+                                                 int maxFileCount,
+                                                 RotatingFileSink::Options options)
+{
+    if (fileName.isEmpty())
+        return *this;
+
+    auto sink = BinaryFileSinkPtr::create(fileName, maxFileSize, maxFileCount, options);
+
+    // Store only template ids and parameters if this or a parent pipeline mines message templates
+    for (auto pipeline = this; pipeline && !sink->messageTemplates(); pipeline = pipeline->m_parent) {
+        for (const auto &handler : pipeline->handlers()) {
+            if (auto templates = handler.dynamicCast<MessageTemplateAttr>()) {
+                sink->setMessageTemplates(templates);
+                break;
+            }
+        }
+    }
+
+    append(sink);
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToRecording(const QString &fileName, quint64 maxCount)
+{
+    if (fileName.isEmpty())
+        return *this;
+
+    append(RecordingSinkPtr::create(fileName, maxCount));
+    return *this;
+}
+
+#ifndef QT_NO_SHAREDMEMORY
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToSharedMemory(const QString &key, int slotCount,
+                                                   int slotSize)
+{
+    if (key.isEmpty())
+        return *this;
+
+    append(SharedMemorySinkPtr::create(key, slotCount, slotSize));
+    return *this;
+}
+#endif
+
+#ifdef QTLOGGER_SQL
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToSqlite(const QString &fileName, qint64 maxRowCount,
+                                             int maxAge)
+{
+    if (fileName.isEmpty())
+        return *this;
+
+    auto sink = SqliteSinkPtr::create(fileName);
+    sink->setMaxRowCount(maxRowCount);
+    sink->setMaxAge(maxAge);
+    append(sink);
+    return *this;
+}
+#endif
+
 QTLOGGER_DECL_SPEC
 SimplePipeline &SimplePipeline::sendToIODevice(const QIODevicePtr &device)
 {
@@ -246,6 +366,17 @@ SimplePipeline &SimplePipeline::sendToIODevice(const QIODevicePtr &device)
     return *this;
 }
 
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToSegmentedLog(const QString &path, qint64 segmentSize,
+                                                   qint64 maxSize)
+{
+    if (path.isEmpty())
+        return *this;
+
+    append(SegmentedLogSinkPtr::create(path, segmentSize, maxSize));
+    return *this;
+}
+
 QTLOGGER_DECL_SPEC
 SimplePipeline &SimplePipeline::sendToSignal(QObject *receiver, const char *method)
 {
@@ -255,6 +386,17 @@ SimplePipeline &SimplePipeline::sendToSignal(QObject *receiver, const char *meth
     return *this;
 }
 
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToBatchSignal(QObject *receiver, const char *method,
+                                                  int interval, int maxBatchSize)
+{
+    auto sink = BatchSignalSinkPtr::create(interval, maxBatchSize);
+    QObject::connect(sink.data(), SIGNAL(messages(QVector<QtLogger::LogMessage>)), receiver,
+                     method);
+    append(sink.staticCast<Sink>());
+    return *this;
+}
+
 #ifdef QTLOGGER_NETWORK
 QTLOGGER_DECL_SPEC
 SimplePipeline &SimplePipeline::sendToHttp(const QString &url)
@@ -270,6 +412,56 @@ SimplePipeline &SimplePipeline::sendToHttp(const QString &url,
     append(HttpSinkPtr::create(QUrl(url), headers));
     return *this;
 }
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToGelf(const QString &host, quint16 port,
+                                           GelfSink::Transport transport,
+                                           GelfSink::Compression compression)
+{
+    if (host.isEmpty())
+        return *this;
+
+    auto sink = GelfSinkPtr::create(host, port, transport);
+    sink->setCompression(compression);
+    append(sink);
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToLocalSocket(const QString &serverName)
+{
+    if (serverName.isEmpty())
+        return *this;
+
+    append(LocalSocketSinkPtr::create(serverName));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToTcp(const QString &host, quint16 port,
+                                          IODeviceSink::Framing framing)
+{
+    if (host.isEmpty())
+        return *this;
+
+    append(TcpSinkPtr::create(host, port, framing));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToOtlp(const QString &endpoint)
+{
+    append(OtlpSinkPtr::create(QUrl(endpoint)));
+    return *this;
+}
+
+QTLOGGER_DECL_SPEC
+SimplePipeline &SimplePipeline::sendToOtlp(const QString &endpoint,
+                                           const QList<QPair<QByteArray, QByteArray>> &headers)
+{
+    append(OtlpSinkPtr::create(QUrl(endpoint), headers));
+    return *this;
+}
 #endif
 
 #ifdef Q_OS_WIN
@@ -3,10 +3,18 @@
 #include <QList>
 #include <QSharedPointer>
 
+#include "backtrace.h"
 #include "logger_global.h"
 #include "sortedpipeline.h"
+#include "sinks/batchsignalsink.h"
 #include "sinks/iodevicesink.h"
 #include "sinks/rotatingfilesink.h"
+#include "sinks/segmentedlogsink.h"
+#include "sinks/sharedmemorysink.h"
+
+#ifdef QTLOGGER_NETWORK
+#    include "sinks/gelfsink.h"
+#endif
 
 QT_FORWARD_DECLARE_CLASS(QIODevice)
 
@@ -21,9 +29,12 @@ public:
     }
 
     SimplePipeline &addSeqNumber(const QString &name = QStringLiteral("seq_number"));
+    SimplePipeline &addMessageTemplates(const QString &name = QStringLiteral("template_id"));
     SimplePipeline &addAppInfo();
     SimplePipeline &addAppUuid(const QString &name = QStringLiteral("app_uuid"));
     SimplePipeline &addSysInfo();
+    SimplePipeline &addBacktrace(QtMsgType minLevel = QtCriticalMsg,
+                                 int depth = Backtrace::DefaultDepth);
 #ifdef QTLOGGER_NETWORK
     SimplePipeline &addHostInfo();
 #endif
@@ -38,8 +49,13 @@ public:
     SimplePipeline &format(std::function<QString(const LogMessage &)> func);
     SimplePipeline &format(const QString &pattern);
     SimplePipeline &formatByQt();
+    SimplePipeline &formatByQtPattern(const QString &pattern = QString());
     SimplePipeline &formatPretty(bool colorize = false, int maxCategoryWidth = 15);
     SimplePipeline &formatToJson(bool compact = false);
+    SimplePipeline &formatToLogfmt(bool withCallsite = false);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 12, 0)
+    SimplePipeline &formatToCbor();
+#endif
     SimplePipeline &formatToSentry(const QString &sdkName = QStringLiteral("qtlogger.sentry"),
                                    const QString &sdkVersion = QStringLiteral("1.0.0"));
 
@@ -53,12 +69,37 @@ public:
 #endif
     SimplePipeline &sendToPlatformStdLog();
     SimplePipeline &sendToFile(const QString &fileName, int maxFileSize = 0, int maxFileCount = 0, RotatingFileSink::Options options = RotatingFileSink::None);
+    SimplePipeline &sendToBinaryFile(const QString &fileName, int maxFileSize = 0, int maxFileCount = 0, RotatingFileSink::Options options = RotatingFileSink::None);
+    SimplePipeline &sendToRecording(const QString &fileName, quint64 maxCount = 0);
     SimplePipeline &sendToIODevice(const QIODevicePtr &device);
+    SimplePipeline &sendToSegmentedLog(const QString &path,
+                                       qint64 segmentSize = SegmentedLogSink::DefaultSegmentSize,
+                                       qint64 maxSize = 0);
+#ifndef QT_NO_SHAREDMEMORY
+    SimplePipeline &sendToSharedMemory(const QString &key,
+                                       int slotCount = SharedMemorySink::DefaultSlotCount,
+                                       int slotSize = SharedMemorySink::DefaultSlotSize);
+#endif
+#ifdef QTLOGGER_SQL
+    SimplePipeline &sendToSqlite(const QString &fileName, qint64 maxRowCount = 0, int maxAge = 0);
+#endif
     SimplePipeline &sendToSignal(QObject *receiver, const char *method);
+    SimplePipeline &sendToBatchSignal(QObject *receiver, const char *method,
+                                      int interval = BatchSignalSink::DefaultInterval,
+                                      int maxBatchSize = BatchSignalSink::DefaultMaxBatchSize);
 #ifdef QTLOGGER_NETWORK
     SimplePipeline &sendToHttp(const QString &url);
     SimplePipeline &sendToHttp(const QString &url,
                                const QList<QPair<QByteArray, QByteArray>> &headers);
+    SimplePipeline &sendToGelf(const QString &host, quint16 port = GelfSink::DefaultPort,
+                               GelfSink::Transport transport = GelfSink::Transport::Udp,
+                               GelfSink::Compression compression = GelfSink::Compression::None);
+    SimplePipeline &sendToLocalSocket(const QString &serverName);
+    SimplePipeline &sendToTcp(const QString &host, quint16 port,
+                              IODeviceSink::Framing framing = IODeviceSink::Framing::Newline);
+    SimplePipeline &sendToOtlp(const QString &endpoint);
+    SimplePipeline &sendToOtlp(const QString &endpoint,
+                               const QList<QPair<QByteArray, QByteArray>> &headers);
 #endif
 #ifdef Q_OS_WIN
     SimplePipeline &sendToWinDebug();
@@ -0,0 +1,183 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "batchsignalsink.h"
+
+#include <QTimer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#    include <QThread>
+#endif
+
+#include <deque>
+
+namespace QtLogger {
+
+class BatchSignalSink::BatchSignalSinkPrivate
+{
+public:
+    BatchSignalSinkPrivate(int interval, int maxBatchSize)
+        : interval(qMax(interval, 0)), maxBatchSize(qMax(maxBatchSize, 1))
+    {
+    }
+
+    int interval;
+    int maxBatchSize;
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    std::deque<LogMessage> pending;
+    int maxPendingCount = 0;
+    quint64 droppedCount = 0;
+    bool timerScheduled = false;
+    bool flushRequested = false;
+
+    QTimer *timer = nullptr;
+};
+
+QTLOGGER_DECL_SPEC
+BatchSignalSink::BatchSignalSink(int interval, int maxBatchSize, QObject *parent)
+    : QObject(parent), d(new BatchSignalSinkPrivate(interval, maxBatchSize))
+{
+    static auto __once =
+            qRegisterMetaType<QVector<QtLogger::LogMessage>>("QVector<QtLogger::LogMessage>");
+    Q_UNUSED(__once)
+
+    d->timer = new QTimer(this);
+    d->timer->setSingleShot(true);
+    QObject::connect(d->timer, &QTimer::timeout, this, &BatchSignalSink::flush);
+}
+
+QTLOGGER_DECL_SPEC
+BatchSignalSink::~BatchSignalSink() = default;
+
+QTLOGGER_DECL_SPEC
+void BatchSignalSink::send(const LogMessage &lmsg)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+
+    if (d->maxPendingCount > 0 && d->pending.size() >= static_cast<size_t>(d->maxPendingCount)) {
+        d->pending.pop_front();
+        ++d->droppedCount;
+    }
+
+    d->pending.push_back(lmsg);
+
+    // A full batch is emitted on the next event loop iteration, not from the caller of send()
+    if (d->pending.size() >= static_cast<size_t>(d->maxBatchSize)) {
+        if (!d->flushRequested) {
+            d->flushRequested = true;
+            QMetaObject::invokeMethod(this, "startFlushTimer", Qt::QueuedConnection);
+        }
+    } else if (!d->timerScheduled) {
+        d->timerScheduled = true;
+        QMetaObject::invokeMethod(this, "startFlushTimer", Qt::QueuedConnection);
+    }
+}
+
+QTLOGGER_DECL_SPEC
+bool BatchSignalSink::flush()
+{
+    std::deque<LogMessage> pending;
+
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&d->mutex);
+
+        if (QThread::currentThread() != thread()) {
+            if (!d->flushRequested && !d->pending.empty()) {
+                d->flushRequested = true;
+                QMetaObject::invokeMethod(this, "startFlushTimer", Qt::QueuedConnection);
+            }
+            return true;
+        }
+#endif
+
+        pending.swap(d->pending);
+        d->timerScheduled = false;
+        d->flushRequested = false;
+    }
+
+    d->timer->stop();
+
+    while (!pending.empty()) {
+        const auto size = qMin(pending.size(), static_cast<size_t>(d->maxBatchSize));
+
+        QVector<LogMessage> batch;
+        batch.reserve(static_cast<int>(size));
+        for (size_t i = 0; i < size; ++i) {
+            batch.append(pending.front());
+            pending.pop_front();
+        }
+
+        Q_EMIT messages(batch);
+    }
+
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+int BatchSignalSink::interval() const
+{
+    return d->interval;
+}
+
+QTLOGGER_DECL_SPEC
+int BatchSignalSink::maxBatchSize() const
+{
+    return d->maxBatchSize;
+}
+
+QTLOGGER_DECL_SPEC
+int BatchSignalSink::maxPendingCount() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxPendingCount;
+}
+
+QTLOGGER_DECL_SPEC
+void BatchSignalSink::setMaxPendingCount(int count)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxPendingCount = qMax(count, 0);
+}
+
+QTLOGGER_DECL_SPEC
+quint64 BatchSignalSink::droppedCount() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->droppedCount;
+}
+
+QTLOGGER_DECL_SPEC
+void BatchSignalSink::startFlushTimer()
+{
+    bool flushRequested;
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&d->mutex);
+#endif
+        flushRequested = d->flushRequested;
+    }
+
+    if (flushRequested || d->interval == 0) {
+        flush();
+        return;
+    }
+
+    if (!d->timer->isActive())
+        d->timer->start(d->interval);
+}
+
+} // namespace QtLogger
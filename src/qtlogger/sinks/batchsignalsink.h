@@ -0,0 +1,60 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "../logger_global.h"
+#include "../sink.h"
+
+namespace QtLogger {
+
+// Emits log messages in batches, for receivers that can't handle a signal per message.
+//
+// send() can be called from any thread. Messages are queued and emitted with messages() in the
+// thread of the sink, at most interval ms after the first queued one, or as soon as maxBatchSize
+// messages are queued. When the thread of the sink falls behind, e.g. a GUI thread busy with a slow
+// receiver, messages pile up; with a maximum pending count the oldest ones are dropped instead.
+class QTLOGGER_EXPORT BatchSignalSink : public QObject, public Sink
+{
+    Q_OBJECT
+
+public:
+    constexpr static int DefaultInterval = 100; // ms
+    constexpr static int DefaultMaxBatchSize = 1000;
+
+    explicit BatchSignalSink(int interval = DefaultInterval,
+                             int maxBatchSize = DefaultMaxBatchSize, QObject *parent = nullptr);
+    ~BatchSignalSink() override;
+
+    void send(const LogMessage &lmsg) override;
+
+    // Emits the queued messages when called in the thread of the sink, otherwise schedules it
+    bool flush() override;
+
+    int interval() const;
+    int maxBatchSize() const;
+
+    // 0 keeps all messages until they are emitted
+    int maxPendingCount() const;
+    void setMaxPendingCount(int count);
+
+    quint64 droppedCount() const;
+
+Q_SIGNALS:
+    void messages(const QVector<QtLogger::LogMessage> &lmsgs);
+
+private:
+    Q_INVOKABLE void startFlushTimer();
+
+    class BatchSignalSinkPrivate;
+    QScopedPointer<BatchSignalSinkPrivate> d;
+};
+
+using BatchSignalSinkPtr = QSharedPointer<BatchSignalSink>;
+
+} // namespace QtLogger
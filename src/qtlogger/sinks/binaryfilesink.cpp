@@ -0,0 +1,58 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "binaryfilesink.h"
+
+#include <QFile>
+
+#include "../binarylog.h"
+
+namespace QtLogger {
+
+class BinaryFileSink::BinaryFileSinkPrivate
+{
+public:
+    BinaryLogWriter writer;
+};
+
+QTLOGGER_DECL_SPEC
+BinaryFileSink::BinaryFileSink(const QString &path, int maxFileSize, int maxFileCount,
+                               Options options)
+    : RotatingFileSink(path, maxFileSize, maxFileCount, options,
+                       QIODevice::WriteOnly | QIODevice::Append)
+    , d(new BinaryFileSinkPrivate)
+{
+}
+
+QTLOGGER_DECL_SPEC
+BinaryFileSink::~BinaryFileSink() = default;
+
+QTLOGGER_DECL_SPEC
+void BinaryFileSink::setMessageTemplates(const MessageTemplateAttrPtr &messageTemplates)
+{
+    d->writer.setMessageTemplates(messageTemplates);
+}
+
+QTLOGGER_DECL_SPEC
+MessageTemplateAttrPtr BinaryFileSink::messageTemplates() const
+{
+    return d->writer.messageTemplates();
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray BinaryFileSink::encode(const LogMessage &lmsg)
+{
+    // Every file starts with its own header and dictionaries
+    if (file()->size() == 0)
+        d->writer.reset();
+
+    return d->writer.encode(lmsg);
+}
+
+QTLOGGER_DECL_SPEC
+bool BinaryFileSink::writesBinaryLog() const
+{
+    return true;
+}
+
+} // namespace QtLogger
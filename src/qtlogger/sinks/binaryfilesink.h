@@ -0,0 +1,43 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "../attrhandlers/messagetemplateattr.h"
+#include "../logger_global.h"
+#include "rotatingfilesink.h"
+
+namespace QtLogger {
+
+// Writes messages in the compact binary format described in binarylog.h. The formatted message is
+// not used: the raw message, its callsite and attributes are stored, so any formatter can be
+// applied later when the log is read back with BinaryLogReader.
+class QTLOGGER_EXPORT BinaryFileSink : public RotatingFileSink
+{
+public:
+    explicit BinaryFileSink(const QString &path,
+                            int maxFileSize = DefaultMaxFileSize,
+                            int maxFileCount = DefaultMaxFileCount,
+                            Options options = Option::None);
+    ~BinaryFileSink() override;
+
+    // Messages with an id of these templates are stored as the template id and the parameters
+    void setMessageTemplates(const MessageTemplateAttrPtr &messageTemplates);
+    MessageTemplateAttrPtr messageTemplates() const;
+
+protected:
+    QByteArray encode(const LogMessage &lmsg) override;
+    bool writesBinaryLog() const override;
+
+private:
+    class BinaryFileSinkPrivate;
+    QScopedPointer<BinaryFileSinkPrivate> d;
+    Q_DISABLE_COPY(BinaryFileSink)
+};
+
+using BinaryFileSinkPtr = QSharedPointer<BinaryFileSink>;
+
+} // namespace QtLogger
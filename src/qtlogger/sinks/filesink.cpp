@@ -52,9 +52,19 @@ QSharedPointer<QFile> createFilePtr(const QString &path)
 }
 
 QTLOGGER_DECL_SPEC
-FileSink::FileSink(const QString &path) : IODeviceSink(createFilePtr(path))
+FileSink::FileSink(const QString &path)
+    : FileSink(path, QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)
 {
-    if (!file()->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+}
+
+QTLOGGER_DECL_SPEC
+FileSink::FileSink(const QString &path, QIODevice::OpenMode openMode)
+    : IODeviceSink(createFilePtr(path))
+{
+    // Terminal colors are of no use in a file
+    setPlainText(true);
+
+    if (!file()->open(openMode)) {
         std::cerr << "FileSink: Can't open log file: " << path.toStdString()
                   << " error: " << file()->errorString().toStdString() << std::endl;
     }
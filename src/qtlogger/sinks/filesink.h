@@ -21,6 +21,8 @@ public:
     bool flush() override;
 
 protected:
+    FileSink(const QString &path, QIODevice::OpenMode openMode);
+
     QFile *file() const;
 };
 
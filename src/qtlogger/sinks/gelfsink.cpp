@@ -0,0 +1,509 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifdef QTLOGGER_NETWORK
+
+#include "gelfsink.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSysInfo>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+#include <QUdpSocket>
+#include <QtEndian>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+#include "../seekablegzip.h"
+#include "sinkthread.h"
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int GelfChunkHeaderSize = 12;
+constexpr int GelfMaxChunks = 128;
+constexpr int GelfTcpBatchSize = 64 * 1024;
+constexpr qint64 GelfMaxExactInteger = Q_INT64_C(1) << 53;
+
+int gelfLevel(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return 7;
+    case QtInfoMsg:
+        return 6;
+    case QtWarningMsg:
+        return 4;
+    case QtCriticalMsg:
+        return 3;
+    case QtFatalMsg:
+        return 2;
+    }
+    return 7;
+}
+
+// Additional field names must match ^[\w\.\-]*$, "_id" is reserved
+QString gelfFieldName(const QString &name)
+{
+    QString result = QStringLiteral("_");
+    result.reserve(name.size() + 2);
+
+    for (const auto ch : name) {
+        if (ch.isLetterOrNumber() || ch == QLatin1Char('_') || ch == QLatin1Char('.')
+            || ch == QLatin1Char('-'))
+            result.append(ch);
+        else
+            result.append(QLatin1Char('_'));
+    }
+
+    if (result == QLatin1String("_id"))
+        result.append(QLatin1Char('_'));
+
+    return result;
+}
+
+QJsonValue gelfValue(const QVariant &value)
+{
+    switch (value.userType()) {
+    // Integers beyond 2^53 don't fit a JSON number exactly, they are sent as strings
+    case QMetaType::Long:
+    case QMetaType::LongLong: {
+        const auto number = value.toLongLong();
+        if (number >= -GelfMaxExactInteger && number <= GelfMaxExactInteger)
+            return static_cast<double>(number);
+        return QString::number(number);
+    }
+    case QMetaType::ULong:
+    case QMetaType::ULongLong: {
+        const auto number = value.toULongLong();
+        if (number <= static_cast<quint64>(GelfMaxExactInteger))
+            return static_cast<double>(number);
+        return QString::number(number);
+    }
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return value.toDouble();
+    default:
+        return value.toString();
+    }
+}
+
+QByteArray gelfCompress(const QByteArray &data, GelfSink::Compression compression)
+{
+    switch (compression) {
+    case GelfSink::Compression::None:
+        return data;
+    case GelfSink::Compression::Zlib:
+        // qCompress() prepends the uncompressed size to a zlib stream
+        return qCompress(data).mid(4);
+    case GelfSink::Compression::Gzip:
+        return SeekableGzip::member(data, -1);
+    }
+    return data;
+}
+
+} // namespace
+
+class GelfSink::GelfSinkPrivate
+{
+public:
+    GelfSinkPrivate(const QString &host, quint16 port, Transport transport)
+        : host(host),
+          port(port),
+          transport(transport),
+          hostName(QSysInfo::machineHostName()),
+          messageIdBase(static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) << 16
+                        ^ static_cast<quint64>(QCoreApplication::applicationPid()) << 48)
+    {
+    }
+
+    ~GelfSinkPrivate()
+    {
+        thread.run([this] { resetSocket(); });
+        thread.stop();
+    }
+
+    void send(const QByteArray &gelf)
+    {
+        thread.post([this, gelf] { write(gelf); });
+    }
+
+    void flush()
+    {
+        thread.run([this] {
+            if (!socket)
+                return;
+
+            writePending();
+            writeBatch();
+            socket->flush();
+        });
+    }
+
+    // GELF chunks of a message, or nothing if it needs more than 128 chunks
+    QList<QByteArray> datagrams(const QByteArray &data, int chunkSize)
+    {
+        const auto size = static_cast<int>(data.size());
+        if (size <= chunkSize)
+            return { data };
+
+        const auto payloadSize = chunkSize - GelfChunkHeaderSize;
+        const auto count = (size + payloadSize - 1) / payloadSize;
+        if (count > GelfMaxChunks)
+            return {};
+
+        const auto messageId = qToBigEndian(messageIdBase + messageCounter++);
+
+        QList<QByteArray> result;
+        result.reserve(count);
+
+        for (int i = 0; i < count; ++i) {
+            QByteArray chunk;
+            chunk.reserve(chunkSize);
+            chunk.append('\x1e').append('\x0f');
+            chunk.append(reinterpret_cast<const char *>(&messageId), sizeof(messageId));
+            chunk.append(static_cast<char>(i));
+            chunk.append(static_cast<char>(count));
+            chunk.append(data.constData() + i * payloadSize,
+                         qMin(payloadSize, size - i * payloadSize));
+            result.append(chunk);
+        }
+
+        return result;
+    }
+
+    QString host;
+    quint16 port;
+    Transport transport;
+
+    // Set by any thread, guarded by the mutex
+    Compression compression = Compression::None;
+    int chunkSize = DefaultChunkSize;
+    int maxBufferSize = DefaultMaxBufferSize;
+    QString hostName;
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+
+    SinkThread thread { QStringLiteral("GelfSink") };
+
+private:
+    // Runs in the thread of the sink
+    void write(const QByteArray &gelf)
+    {
+        auto compression = Compression::None;
+        auto chunkSize = DefaultChunkSize;
+        auto maxBufferSize = DefaultMaxBufferSize;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            compression = this->compression;
+            chunkSize = this->chunkSize;
+            maxBufferSize = this->maxBufferSize;
+        }
+
+        ensureSocket();
+
+        if (transport == Transport::Udp) {
+            const auto data = gelfCompress(gelf, compression);
+            for (const auto &datagram : datagrams(data, chunkSize)) {
+                if (socket->state() == QAbstractSocket::ConnectedState)
+                    socket->write(datagram);
+                else
+                    enqueue(datagram, maxBufferSize);
+            }
+            return;
+        }
+
+        auto frame = gelf;
+        frame.append('\0');
+
+        if (socket->state() != QAbstractSocket::ConnectedState) {
+            enqueue(frame, maxBufferSize);
+            return;
+        }
+
+        // A slow server keeps the rest in the bounded buffer instead of the socket buffer
+        if (!pending.isEmpty() || socket->bytesToWrite() + batch.size() >= GelfTcpBatchSize) {
+            enqueue(frame, maxBufferSize);
+            writePending();
+            return;
+        }
+
+        batch.append(frame);
+        scheduleBatch();
+    }
+
+    void ensureSocket()
+    {
+        if (!socket) {
+            if (transport == Transport::Udp)
+                socket = new QUdpSocket(thread.context());
+            else
+                socket = new QTcpSocket(thread.context());
+
+            QObject::connect(socket.data(), &QAbstractSocket::connected, socket.data(),
+                             [this] { writePending(); });
+
+            // The next batch of the buffer is written when the socket has sent the last one
+            if (transport == Transport::Tcp) {
+                QObject::connect(socket.data(), &QIODevice::bytesWritten, socket.data(),
+                                 [this] { writePending(); });
+            }
+        }
+
+        // Also reconnects a TCP socket closed by the server
+        if (socket->state() == QAbstractSocket::UnconnectedState)
+            socket->connectToHost(host, port);
+    }
+
+    void resetSocket()
+    {
+        if (!socket)
+            return;
+
+        socket->disconnect();
+
+        if (socket->thread() == QThread::currentThread()) {
+            writePending();
+            writeBatch();
+            while (socket->state() == QAbstractSocket::ConnectedState
+                   && socket->bytesToWrite() > 0 && socket->waitForBytesWritten(100)) {
+                writePending();
+            }
+            delete socket.data();
+        } else {
+            socket->deleteLater();
+        }
+
+        socket = nullptr;
+        batchScheduled = false;
+    }
+
+    void enqueue(const QByteArray &data, int maxBufferSize)
+    {
+        pending.append(data);
+        pendingSize += data.size();
+
+        while (pendingSize > maxBufferSize && !pending.isEmpty()) {
+            pendingSize -= pending.takeFirst().size();
+        }
+    }
+
+    void writePending()
+    {
+        if (!socket || socket->state() != QAbstractSocket::ConnectedState)
+            return;
+
+        if (transport == Transport::Udp) {
+            for (const auto &item : std::as_const(pending)) {
+                socket->write(item);
+            }
+            pending.clear();
+            pendingSize = 0;
+            return;
+        }
+
+        while (!pending.isEmpty()
+               && socket->bytesToWrite() + batch.size() < GelfTcpBatchSize) {
+            pendingSize -= pending.first().size();
+            batch.append(pending.takeFirst());
+        }
+
+        writeBatch();
+    }
+
+    void scheduleBatch()
+    {
+        if (batch.size() >= GelfTcpBatchSize) {
+            writeBatch();
+            return;
+        }
+
+        if (batchScheduled)
+            return;
+
+        batchScheduled = true;
+        QTimer::singleShot(0, socket.data(), [this] { writeBatch(); });
+    }
+
+    void writeBatch()
+    {
+        batchScheduled = false;
+
+        if (batch.isEmpty() || !socket)
+            return;
+
+        socket->write(batch);
+        batch.clear();
+    }
+
+    QPointer<QAbstractSocket> socket;
+
+    QList<QByteArray> pending;
+    qint64 pendingSize = 0;
+
+    QByteArray batch;
+    bool batchScheduled = false;
+
+    const quint64 messageIdBase;
+    quint64 messageCounter = 0;
+};
+
+QTLOGGER_DECL_SPEC
+GelfSink::GelfSink(const QString &host, quint16 port, Transport transport)
+    : d(new GelfSinkPrivate(host, port, transport))
+{
+}
+
+QTLOGGER_DECL_SPEC
+GelfSink::~GelfSink() = default;
+
+QTLOGGER_DECL_SPEC
+void GelfSink::send(const LogMessage &lmsg)
+{
+    d->send(toGelf(lmsg, hostName()));
+}
+
+QTLOGGER_DECL_SPEC
+bool GelfSink::flush()
+{
+    d->flush();
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+GelfSink::Transport GelfSink::transport() const
+{
+    return d->transport;
+}
+
+QTLOGGER_DECL_SPEC
+GelfSink::Compression GelfSink::compression() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->compression;
+}
+
+QTLOGGER_DECL_SPEC
+void GelfSink::setCompression(Compression compression)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->compression = compression;
+}
+
+QTLOGGER_DECL_SPEC
+int GelfSink::chunkSize() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->chunkSize;
+}
+
+QTLOGGER_DECL_SPEC
+void GelfSink::setChunkSize(int chunkSize)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->chunkSize = qMax(chunkSize, GelfChunkHeaderSize + 1);
+}
+
+QTLOGGER_DECL_SPEC
+int GelfSink::maxBufferSize() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxBufferSize;
+}
+
+QTLOGGER_DECL_SPEC
+void GelfSink::setMaxBufferSize(int maxBufferSize)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxBufferSize = maxBufferSize;
+}
+
+QTLOGGER_DECL_SPEC
+QString GelfSink::hostName() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->hostName;
+}
+
+QTLOGGER_DECL_SPEC
+void GelfSink::setHostName(const QString &hostName)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->hostName = hostName;
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray GelfSink::toGelf(const LogMessage &lmsg, const QString &hostName)
+{
+    QJsonObject obj;
+
+    obj.insert(QStringLiteral("version"), QStringLiteral("1.1"));
+    obj.insert(QStringLiteral("host"), hostName);
+
+    // short_message must not be empty
+    const auto message = lmsg.message();
+    obj.insert(QStringLiteral("short_message"),
+               message.isEmpty() ? QStringLiteral("-") : message);
+
+    if (lmsg.isFormatted() && lmsg.formattedMessage() != message)
+        obj.insert(QStringLiteral("full_message"), lmsg.formattedMessage());
+
+    obj.insert(QStringLiteral("timestamp"),
+               static_cast<double>(lmsg.time().toMSecsSinceEpoch()) / 1000.0);
+    obj.insert(QStringLiteral("level"), gelfLevel(lmsg.type()));
+
+    if (lmsg.category() && *lmsg.category())
+        obj.insert(QStringLiteral("_category"), QString::fromUtf8(lmsg.category()));
+    if (lmsg.file()) {
+        obj.insert(QStringLiteral("_file"), QString::fromUtf8(lmsg.file()));
+        obj.insert(QStringLiteral("_line"), lmsg.line());
+    }
+    if (lmsg.function())
+        obj.insert(QStringLiteral("_function"), QString::fromUtf8(lmsg.function()));
+#ifndef QTLOGGER_NO_THREAD
+    obj.insert(QStringLiteral("_thread_id"), QString::number(lmsg.threadId()));
+#endif
+
+    const auto attrs = lmsg.attributes();
+    for (auto it = attrs.cbegin(); it != attrs.cend(); ++it) {
+        obj.insert(gelfFieldName(it.key()), gelfValue(it.value()));
+    }
+
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
@@ -0,0 +1,73 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "../logger_global.h"
+#include "../sink.h"
+
+namespace QtLogger {
+
+// Sends messages to Graylog in GELF 1.1 format.
+//
+// UDP: one datagram per message, compressed with zlib or gzip if enabled; messages larger than
+// the chunk size are split into GELF chunks (at most 128).
+// TCP: null-byte terminated messages without compression; messages sent within one event loop
+// iteration are written as a single batch.
+//
+// The socket is owned by a thread of the sink and never blocks the calling thread. Messages sent
+// before the connection is established, or over TCP while the server hasn't read the last batch,
+// are kept in a bounded buffer, the oldest ones are dropped when it's full.
+class QTLOGGER_EXPORT GelfSink : public Sink
+{
+public:
+    enum class Transport { Udp, Tcp };
+    enum class Compression { None, Zlib, Gzip };
+
+    static constexpr quint16 DefaultPort = 12201;
+    static constexpr int DefaultChunkSize = 8192;
+    static constexpr int DefaultMaxBufferSize = 4 * 1024 * 1024;
+
+    explicit GelfSink(const QString &host, quint16 port = DefaultPort,
+                      Transport transport = Transport::Udp);
+    ~GelfSink() override;
+
+    void send(const LogMessage &lmsg) override;
+    bool flush() override;
+
+    Transport transport() const;
+
+    // UDP only, GELF over TCP doesn't support compression
+    Compression compression() const;
+    void setCompression(Compression compression);
+
+    // Maximum UDP datagram size including the 12 bytes of the chunk header
+    int chunkSize() const;
+    void setChunkSize(int chunkSize);
+
+    int maxBufferSize() const;
+    void setMaxBufferSize(int maxBufferSize);
+
+    // Value of the GELF "host" field, the machine host name by default
+    QString hostName() const;
+    void setHostName(const QString &hostName);
+
+    // GELF 1.1 JSON of the message. Custom attributes become additional fields prefixed with '_'.
+    static QByteArray toGelf(const LogMessage &lmsg, const QString &hostName);
+
+private:
+    class GelfSinkPrivate;
+    QScopedPointer<GelfSinkPrivate> d;
+    Q_DISABLE_COPY(GelfSink)
+};
+
+using GelfSinkPtr = QSharedPointer<GelfSink>;
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
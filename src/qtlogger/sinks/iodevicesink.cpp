@@ -3,6 +3,8 @@
 
 #include "iodevicesink.h"
 
+#include <QtEndian>
+
 namespace QtLogger {
 
 QTLOGGER_DECL_SPEC
@@ -11,11 +13,68 @@ IODeviceSink::IODeviceSink(const QIODevicePtr &device) : m_device(device) { }
 QTLOGGER_DECL_SPEC
 void IODeviceSink::send(const LogMessage &lmsg)
 {
-    if (m_device.isNull()) {
+    if (m_device.isNull() || !m_device->isOpen()) {
         return;
     }
 
-    m_device->write(lmsg.formattedMessage().toLocal8Bit().append("\n"));
+    updateTextMode(lmsg);
+    m_device->write(encode(lmsg));
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray IODeviceSink::encode(const LogMessage &lmsg)
+{
+    return frame(lmsg, m_framing, m_plainText);
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray IODeviceSink::frame(const LogMessage &lmsg, Framing framing, bool plainText,
+                               bool utf8Text)
+{
+    const auto text = [&lmsg, plainText] {
+        return plainText ? lmsg.plainFormattedMessage() : lmsg.formattedMessage();
+    };
+
+    if (framing == Framing::Newline) {
+        if (lmsg.hasFormattedData())
+            return lmsg.formattedData();
+        return (utf8Text ? text().toUtf8() : text().toLocal8Bit()).append('\n');
+    }
+
+    const auto payload = lmsg.hasFormattedData() ? lmsg.formattedData() : text().toUtf8();
+
+    QByteArray result;
+    result.reserve(payload.size() + 4);
+    const auto size = qToBigEndian(static_cast<quint32>(payload.size()));
+    result.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    result.append(payload);
+
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+IODeviceSink::Framing IODeviceSink::framing() const
+{
+    return m_framing;
+}
+
+QTLOGGER_DECL_SPEC
+void IODeviceSink::setFraming(Framing framing)
+{
+    m_framing = framing;
+    updateTextMode();
+}
+
+QTLOGGER_DECL_SPEC
+bool IODeviceSink::plainText() const
+{
+    return m_plainText;
+}
+
+QTLOGGER_DECL_SPEC
+void IODeviceSink::setPlainText(bool enabled)
+{
+    m_plainText = enabled;
 }
 
 QTLOGGER_DECL_SPEC
@@ -28,6 +87,42 @@ QTLOGGER_DECL_SPEC
 void IODeviceSink::setDevice(const QIODevicePtr &device)
 {
     m_device = device;
+    m_textModeSuspended = false;
+    updateTextMode();
+}
+
+QTLOGGER_DECL_SPEC
+void IODeviceSink::updateTextMode(const LogMessage &lmsg)
+{
+    // Newline translation of the text mode would damage binary formatter output and frames. The
+    // device may have been reopened in text mode since, e.g. by a rotation.
+    if (lmsg.hasFormattedData() || m_framing == Framing::LengthPrefixed) {
+        if (m_device->isTextModeEnabled()) {
+            m_device->setTextModeEnabled(false);
+            m_textModeSuspended = true;
+        }
+    } else if (m_textModeSuspended) {
+        // Text written after binary output gets the newline translation of the device again
+        m_device->setTextModeEnabled(true);
+        m_textModeSuspended = false;
+    }
+}
+
+QTLOGGER_DECL_SPEC
+void IODeviceSink::updateTextMode()
+{
+    if (!m_device || !m_device->isOpen())
+        return;
+
+    if (m_framing == Framing::LengthPrefixed) {
+        if (m_device->isTextModeEnabled()) {
+            m_device->setTextModeEnabled(false);
+            m_textModeSuspended = true;
+        }
+    } else if (m_textModeSuspended) {
+        m_device->setTextModeEnabled(true);
+        m_textModeSuspended = false;
+    }
 }
 
 } // namespace QtLogger
@@ -16,16 +16,49 @@ using QIODevicePtr = QSharedPointer<QIODevice>;
 class QTLOGGER_EXPORT IODeviceSink : public Sink
 {
 public:
+    enum class Framing {
+        Newline, // Text followed by a newline, binary formatter output as is
+        LengthPrefixed // 32-bit big-endian length followed by the text or binary output
+    };
+
     explicit IODeviceSink(const QIODevicePtr &device);
 
     void send(const LogMessage &lmsg) override;
 
+    Framing framing() const;
+    // LengthPrefixed disables the text mode of the device, so the frames are written unchanged.
+    // Newline enables it again if it was disabled by the sink.
+    void setFraming(Framing framing);
+
+    // Writes the formatted message without terminal colors (LogMessage::plainFormattedMessage()).
+    // Off by default, file sinks enable it.
+    bool plainText() const;
+    void setPlainText(bool enabled);
+
+    // Bytes of a message in the framing, also used by sinks writing to sockets. Newline text is in
+    // the local 8-bit encoding unless utf8Text is set, length-prefixed text in UTF-8, binary
+    // formatter output is used as is.
+    static QByteArray frame(const LogMessage &lmsg, Framing framing, bool plainText,
+                            bool utf8Text = false);
+
 protected:
+    // Bytes written to the device for a single message
+    virtual QByteArray encode(const LogMessage &lmsg);
+
     const QIODevicePtr &device() const;
     void setDevice(const QIODevicePtr &device);
 
+    // Disables the text mode of the device before writing binary output and enables it again
+    // before writing newline-framed text, called by send()
+    void updateTextMode(const LogMessage &lmsg);
+
 private:
+    void updateTextMode();
+
     QIODevicePtr m_device;
+    Framing m_framing = Framing::Newline;
+    bool m_plainText = false;
+    bool m_textModeSuspended = false; // Text mode of the device disabled by updateTextMode()
 };
 
 using IODeviceSinkPtr = QSharedPointer<IODeviceSink>;
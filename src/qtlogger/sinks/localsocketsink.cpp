@@ -0,0 +1,292 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifdef QTLOGGER_NETWORK
+
+#include "localsocketsink.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLocalSocket>
+#include <QPointer>
+#include <QThread>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+#include "../binarylog.h"
+#include "sinkthread.h"
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int LocalSocketBatchSize = 64 * 1024;
+constexpr int LocalSocketReconnectInterval = 1000; // ms
+
+} // namespace
+
+class LocalSocketSink::LocalSocketSinkPrivate
+{
+public:
+    explicit LocalSocketSinkPrivate(const QString &serverName) : serverName(serverName)
+    {
+        writer.setSessionAttributes({
+                { QStringLiteral("appname"), QCoreApplication::applicationName() },
+                { QStringLiteral("pid"), QCoreApplication::applicationPid() },
+        });
+    }
+
+    ~LocalSocketSinkPrivate()
+    {
+        thread.run([this] { resetSocket(); });
+        thread.stop();
+    }
+
+    // The queue is filled in the calling thread, so the oldest messages are dropped before send()
+    // returns
+    void send(const LogMessage &lmsg)
+    {
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            enqueue(lmsg);
+
+            // Messages sent until the thread of the sink gets to them are written as one batch
+            if (writeScheduled)
+                return;
+            writeScheduled = true;
+        }
+
+        thread.post([this] {
+            ensureSocket();
+            writePending();
+        });
+    }
+
+    void flush()
+    {
+        thread.run([this] {
+            ensureSocket();
+            if (socket->state() == QLocalSocket::ConnectingState)
+                socket->waitForConnected(100);
+
+            writePending();
+            socket->flush();
+        });
+    }
+
+    QString serverName;
+    int maxPendingCount = DefaultMaxPendingCount;
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    SinkThread thread { QStringLiteral("LocalSocketSink") };
+
+private:
+    // The socket and the writer are used only in the thread of the sink
+    void ensureSocket()
+    {
+        if (!socket) {
+            socket = new QLocalSocket(thread.context());
+
+            QObject::connect(socket.data(), &QLocalSocket::connected, socket.data(),
+                             [this] { writePending(); });
+
+            QObject::connect(socket.data(), &QIODevice::bytesWritten, socket.data(),
+                             [this](qint64 bytes) {
+                                 sent(bytes);
+                                 writePending();
+                             });
+
+            // A new connection is a new session, the collector has lost the dictionaries
+            QObject::connect(socket.data(), &QLocalSocket::disconnected, socket.data(), [this] {
+                writer.reset();
+                requeueUnsent();
+            });
+        }
+
+        // Without a collector every message would try to connect, so retries are rate limited
+        if (socket->state() == QLocalSocket::UnconnectedState
+            && (!lastConnect.isValid() || lastConnect.elapsed() >= LocalSocketReconnectInterval)) {
+            lastConnect.start();
+            writer.reset();
+            socket->connectToServer(serverName);
+        }
+    }
+
+    void resetSocket()
+    {
+        if (!socket)
+            return;
+
+        socket->disconnect();
+
+        if (socket->thread() == QThread::currentThread()) {
+            writePending();
+            while (socket->state() == QLocalSocket::ConnectedState && socket->bytesToWrite() > 0
+                   && socket->waitForBytesWritten(100)) {
+                writePending();
+            }
+            delete socket.data();
+        } else {
+            socket->deleteLater();
+        }
+
+        socket = nullptr;
+        unsent.clear();
+        lastConnect.invalidate();
+    }
+
+    // Called with the mutex locked
+    void enqueue(const LogMessage &lmsg)
+    {
+        pending.append(lmsg);
+
+        while (pending.size() > maxPendingCount && !pending.isEmpty()) {
+            pending.removeFirst();
+        }
+    }
+
+    void writePending()
+    {
+        QList<LogMessage> items;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            writeScheduled = false;
+
+            if (!socket || socket->state() != QLocalSocket::ConnectedState)
+                return;
+
+            // A slow collector keeps the rest in the bounded queue instead of the socket buffer,
+            // the next batch is written when the socket has sent this one
+            if (socket->bytesToWrite() >= LocalSocketBatchSize)
+                return;
+
+            // The size of the messages is an estimate of the size of their frames
+            int size = 0;
+            while (!pending.isEmpty() && size < LocalSocketBatchSize) {
+                size += pending.first().message().size();
+                items.append(pending.takeFirst());
+            }
+        }
+
+        if (items.isEmpty())
+            return;
+
+        QByteArray batch;
+        for (const auto &lmsg : std::as_const(items)) {
+            const auto frame = writer.encode(lmsg);
+            batch.append(frame);
+            writtenBytes += frame.size();
+            unsent.append({ lmsg, writtenBytes });
+        }
+        socket->write(batch);
+    }
+
+    // Messages are kept until the socket has sent all of their bytes
+    void sent(qint64 bytes)
+    {
+        sentBytes += bytes;
+
+        while (!unsent.isEmpty() && unsent.first().end <= sentBytes) {
+            unsent.removeFirst();
+        }
+    }
+
+    // The messages the socket hasn't sent go to the next connection
+    void requeueUnsent()
+    {
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            for (auto it = unsent.crbegin(); it != unsent.crend(); ++it) {
+                pending.prepend(it->lmsg);
+            }
+
+            while (pending.size() > maxPendingCount && !pending.isEmpty()) {
+                pending.removeFirst();
+            }
+        }
+
+        unsent.clear();
+        writtenBytes = 0;
+        sentBytes = 0;
+    }
+
+    struct Unsent
+    {
+        LogMessage lmsg;
+        // Bytes written to the socket up to the end of the message
+        qint64 end;
+    };
+
+    QPointer<QLocalSocket> socket;
+    BinaryLogWriter writer;
+
+    QList<Unsent> unsent;
+    qint64 writtenBytes = 0;
+    qint64 sentBytes = 0;
+
+    QElapsedTimer lastConnect;
+
+    QList<LogMessage> pending;
+    bool writeScheduled = false;
+};
+
+QTLOGGER_DECL_SPEC
+LocalSocketSink::LocalSocketSink(const QString &serverName)
+    : d(new LocalSocketSinkPrivate(serverName))
+{
+}
+
+QTLOGGER_DECL_SPEC
+LocalSocketSink::~LocalSocketSink() = default;
+
+QTLOGGER_DECL_SPEC
+void LocalSocketSink::send(const LogMessage &lmsg)
+{
+    d->send(lmsg);
+}
+
+QTLOGGER_DECL_SPEC
+bool LocalSocketSink::flush()
+{
+    d->flush();
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+QString LocalSocketSink::serverName() const
+{
+    return d->serverName;
+}
+
+QTLOGGER_DECL_SPEC
+int LocalSocketSink::maxPendingCount() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxPendingCount;
+}
+
+QTLOGGER_DECL_SPEC
+void LocalSocketSink::setMaxPendingCount(int count)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxPendingCount = count;
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
@@ -0,0 +1,52 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "../logger_global.h"
+#include "../sink.h"
+
+namespace QtLogger {
+
+// Streams messages to a LogCollector over a local socket (a Unix domain socket, a named pipe on
+// Windows) in the binary log format. Every connection is a binary log session that starts with the
+// appname and pid attributes of the process, the collector adds them to the received messages.
+//
+// Messages sent until the thread of the sink gets to them are written as a single batch. The socket
+// lives in that thread and never blocks the calling thread: messages are queued by the calling
+// thread in a bounded queue, the oldest ones are dropped when it's full, e.g. until the collector
+// accepts the connection or while a slow collector hasn't read the previous batch. Messages the
+// socket hasn't sent when the connection is lost are queued again for the next one.
+class QTLOGGER_EXPORT LocalSocketSink : public Sink
+{
+public:
+    static constexpr int DefaultMaxPendingCount = 10000;
+
+    explicit LocalSocketSink(const QString &serverName);
+    ~LocalSocketSink() override;
+
+    void send(const LogMessage &lmsg) override;
+    bool flush() override;
+
+    QString serverName() const;
+
+    // Maximum number of queued messages, e.g. while not connected
+    int maxPendingCount() const;
+    void setMaxPendingCount(int count);
+
+private:
+    class LocalSocketSinkPrivate;
+    QScopedPointer<LocalSocketSinkPrivate> d;
+    Q_DISABLE_COPY(LocalSocketSink)
+};
+
+using LocalSocketSinkPtr = QSharedPointer<LocalSocketSink>;
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
@@ -0,0 +1,548 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "logmodelsink.h"
+
+#include <QRegularExpression>
+#include <QSet>
+#include <QTimer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#    include <QThread>
+#endif
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int LogModelChunkSize = 4096;
+constexpr int LogModelMaxInternedStrings = 4096;
+
+// A message without the copies of the context strings of LogMessage, which are shared between
+// the entries of the same callsite instead
+struct LogModelEntry
+{
+    qint64 time;
+    quint64 threadId;
+    QByteArray category;
+    QByteArray file;
+    QByteArray function;
+    QString message;
+    QString formattedMessage;
+    QVariantHash attributes;
+    int line;
+    QtMsgType type;
+
+    QString displayText() const { return formattedMessage.isNull() ? message : formattedMessage; }
+};
+
+} // namespace
+
+class LogModelSink::LogModelSinkPrivate
+{
+public:
+    explicit LogModelSinkPrivate(int maxCount)
+        : maxCount(qMax(maxCount, 1)),
+          chunkSize(qBound(1, maxCount / 4, LogModelChunkSize))
+    {
+    }
+
+    QByteArray intern(const char *string)
+    {
+        const auto value = QByteArray(string);
+        const auto it = strings.constFind(value);
+        if (it != strings.cend())
+            return *it;
+
+        if (strings.size() < LogModelMaxInternedStrings)
+            strings.insert(value);
+
+        return value;
+    }
+
+    bool isFiltering() const
+    {
+        return qtMsgTypePriority(filter.minLevel) > 0 || !filter.category.isEmpty()
+                || !filter.text.isEmpty();
+    }
+
+    bool matches(const LogModelEntry &entry) const
+    {
+        if (qtMsgTypePriority(entry.type) < qtMsgTypePriority(filter.minLevel))
+            return false;
+
+        if (!filter.category.isEmpty()
+            && !categoryRegex.match(QString::fromUtf8(entry.category)).hasMatch()) {
+            return false;
+        }
+
+        return filter.text.isEmpty()
+                || entry.displayText().contains(filter.text, filter.caseSensitivity);
+    }
+
+    bool matchesFind(const LogModelEntry &entry) const
+    {
+        return entry.displayText().contains(findText, findCaseSensitivity);
+    }
+
+    // Every text containing the new text contains the previous one
+    static bool narrowsText(const QString &previous, Qt::CaseSensitivity previousCaseSensitivity,
+                            const QString &text, Qt::CaseSensitivity caseSensitivity)
+    {
+        return text.contains(previous, previousCaseSensitivity)
+                && !(previousCaseSensitivity == Qt::CaseSensitive
+                     && caseSensitivity == Qt::CaseInsensitive);
+    }
+
+    // The previous filter matches all messages the new one matches
+    static bool narrows(const RowFilter &previous, const RowFilter &filter)
+    {
+        if (qtMsgTypePriority(filter.minLevel) < qtMsgTypePriority(previous.minLevel))
+            return false;
+
+        if (!previous.category.isEmpty() && filter.category != previous.category)
+            return false;
+
+        if (previous.text.isEmpty())
+            return true;
+
+        return narrowsText(previous.text, previous.caseSensitivity, filter.text,
+                           filter.caseSensitivity);
+    }
+
+    // Indexes the messages with the text for find(): the same text again only looks up the
+    // index, a text that narrows the previous one only checks the messages it matched
+    void updateFindIndex(const QString &text, Qt::CaseSensitivity caseSensitivity)
+    {
+        if (hasFindIndex && text == findText && caseSensitivity == findCaseSensitivity)
+            return;
+
+        const auto narrowed = hasFindIndex
+                && narrowsText(findText, findCaseSensitivity, text, caseSensitivity);
+
+        findText = text;
+        findCaseSensitivity = caseSensitivity;
+        hasFindIndex = true;
+
+        std::deque<quint64> found;
+
+        if (narrowed) {
+            for (const auto seq : findIndex) {
+                if (matchesFind(entryAt(seq)))
+                    found.push_back(seq);
+            }
+        } else {
+            auto seq = firstSeq;
+            for (const auto &chunk : chunks) {
+                for (const auto &entry : chunk) {
+                    if (matchesFind(entry))
+                        found.push_back(seq);
+                    ++seq;
+                }
+            }
+        }
+
+        findIndex.swap(found);
+    }
+
+    int totalCount() const
+    {
+        return chunks.empty() ? 0
+                              : static_cast<int>((chunks.size() - 1) * chunkSize
+                                                 + chunks.back().size());
+    }
+
+    const LogModelEntry &entryAt(quint64 seq) const
+    {
+        const auto pos = seq - firstSeq;
+        return chunks[pos / chunkSize][pos % chunkSize];
+    }
+
+    quint64 seqAt(int row) const
+    {
+        return isFiltering() ? index[static_cast<size_t>(row)] : firstSeq + row;
+    }
+
+    // Row of the message, -1 if the filter doesn't match it
+    int rowOf(quint64 seq) const
+    {
+        if (!isFiltering())
+            return static_cast<int>(seq - firstSeq);
+
+        const auto it = std::lower_bound(index.cbegin(), index.cend(), seq);
+        return it != index.cend() && *it == seq ? static_cast<int>(it - index.cbegin()) : -1;
+    }
+
+    int maxCount;
+    int chunkSize;
+    int flushInterval = LogModelSink::DefaultFlushInterval;
+
+    // Written by send() in any thread
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    std::deque<LogModelEntry> pending;
+    QSet<QByteArray> strings;
+    quint64 droppedCount = 0;
+    bool flushScheduled = false;
+
+    // Thread of the model
+    std::deque<std::vector<LogModelEntry>> chunks;
+    quint64 firstSeq = 0;
+    std::deque<quint64> index;
+    RowFilter filter;
+    QRegularExpression categoryRegex;
+    QTimer *timer = nullptr;
+
+    // Messages with the text of the last find(), sorted; kept up to date like the row index
+    QString findText;
+    Qt::CaseSensitivity findCaseSensitivity = Qt::CaseInsensitive;
+    bool hasFindIndex = false;
+    std::deque<quint64> findIndex;
+};
+
+QTLOGGER_DECL_SPEC
+LogModelSink::LogModelSink(int maxCount, QObject *parent)
+    : QAbstractListModel(parent), d(new LogModelSinkPrivate(maxCount))
+{
+    d->timer = new QTimer(this);
+    d->timer->setSingleShot(true);
+    QObject::connect(d->timer, &QTimer::timeout, this, &LogModelSink::flush);
+}
+
+QTLOGGER_DECL_SPEC
+LogModelSink::~LogModelSink() = default;
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::send(const LogMessage &lmsg)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+
+    LogModelEntry entry;
+    entry.time = lmsg.time().toMSecsSinceEpoch();
+    entry.threadId = lmsg.threadId();
+    entry.category = d->intern(lmsg.category());
+    entry.file = d->intern(lmsg.file());
+    entry.function = d->intern(lmsg.function());
+    entry.message = lmsg.message();
+    if (lmsg.isFormatted() && lmsg.formattedMessage() != lmsg.message())
+        entry.formattedMessage = lmsg.formattedMessage();
+    entry.attributes = lmsg.attributes();
+    entry.line = lmsg.line();
+    entry.type = lmsg.type();
+
+    // Messages the model wouldn't keep anyway
+    if (d->pending.size() >= static_cast<size_t>(d->maxCount)) {
+        d->pending.pop_front();
+        ++d->droppedCount;
+    }
+
+    d->pending.push_back(std::move(entry));
+
+    if (!d->flushScheduled) {
+        d->flushScheduled = true;
+        QMetaObject::invokeMethod(this, "startFlushTimer", Qt::QueuedConnection);
+    }
+}
+
+QTLOGGER_DECL_SPEC
+bool LogModelSink::flush()
+{
+    std::deque<LogModelEntry> batch;
+
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&d->mutex);
+
+        if (QThread::currentThread() != thread()) {
+            if (!d->flushScheduled && !d->pending.empty()) {
+                d->flushScheduled = true;
+                QMetaObject::invokeMethod(this, "startFlushTimer", Qt::QueuedConnection);
+            }
+            return true;
+        }
+#endif
+
+        batch.swap(d->pending);
+        d->flushScheduled = false;
+    }
+
+    d->timer->stop();
+
+    if (batch.empty())
+        return true;
+
+    std::vector<bool> matched;
+    auto matchedCount = static_cast<int>(batch.size());
+    if (d->isFiltering()) {
+        matched.reserve(batch.size());
+        matchedCount = 0;
+        for (const auto &entry : batch) {
+            matched.push_back(d->matches(entry));
+            if (matched.back())
+                ++matchedCount;
+        }
+    }
+
+    const auto firstRow = rowCount();
+    if (matchedCount > 0)
+        beginInsertRows(QModelIndex(), firstRow, firstRow + matchedCount - 1);
+
+    auto seq = d->firstSeq + static_cast<quint64>(d->totalCount());
+    for (size_t i = 0; i < batch.size(); ++i, ++seq) {
+        if (d->chunks.empty() || d->chunks.back().size() == static_cast<size_t>(d->chunkSize)) {
+            d->chunks.emplace_back();
+            d->chunks.back().reserve(static_cast<size_t>(d->chunkSize));
+        }
+        d->chunks.back().push_back(std::move(batch[i]));
+
+        if (!matched.empty() && matched[i])
+            d->index.push_back(seq);
+        if (d->hasFindIndex && d->matchesFind(d->chunks.back().back()))
+            d->findIndex.push_back(seq);
+    }
+
+    if (matchedCount > 0)
+        endInsertRows();
+
+    // The oldest chunks are dropped as a whole
+    while (d->totalCount() > d->maxCount) {
+        const auto end = d->firstSeq + static_cast<quint64>(d->chunkSize);
+
+        auto removed = d->chunkSize;
+        if (d->isFiltering()) {
+            removed = 0;
+            while (static_cast<size_t>(removed) < d->index.size()
+                   && d->index[static_cast<size_t>(removed)] < end) {
+                ++removed;
+            }
+        }
+
+        if (removed > 0)
+            beginRemoveRows(QModelIndex(), 0, removed - 1);
+
+        d->chunks.pop_front();
+        d->firstSeq = end;
+        if (d->isFiltering())
+            d->index.erase(d->index.begin(), d->index.begin() + removed);
+        d->findIndex.erase(d->findIndex.begin(),
+                           std::lower_bound(d->findIndex.begin(), d->findIndex.end(), end));
+
+        if (removed > 0)
+            endRemoveRows();
+    }
+
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+int LogModelSink::maxCount() const
+{
+    return d->maxCount;
+}
+
+QTLOGGER_DECL_SPEC
+int LogModelSink::flushInterval() const
+{
+    return d->flushInterval;
+}
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::setFlushInterval(int msecs)
+{
+    d->flushInterval = qMax(msecs, 0);
+}
+
+QTLOGGER_DECL_SPEC
+int LogModelSink::totalCount() const
+{
+    return d->totalCount();
+}
+
+QTLOGGER_DECL_SPEC
+quint64 LogModelSink::droppedCount() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->droppedCount;
+}
+
+QTLOGGER_DECL_SPEC
+LogModelSink::RowFilter LogModelSink::rowFilter() const
+{
+    return d->filter;
+}
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::setRowFilter(const RowFilter &filter)
+{
+    const auto wasFiltering = d->isFiltering();
+    const auto narrowed = wasFiltering && LogModelSinkPrivate::narrows(d->filter, filter);
+
+    beginResetModel();
+
+    d->filter = filter;
+
+    if (!filter.category.isEmpty()) {
+        auto pattern = QRegularExpression::escape(filter.category);
+        pattern.replace(QStringLiteral("\\*"), QStringLiteral(".*"));
+        d->categoryRegex = QRegularExpression(QStringLiteral("^%1$").arg(pattern));
+    }
+
+    std::deque<quint64> index;
+
+    if (narrowed) {
+        for (const auto seq : d->index) {
+            if (d->matches(d->entryAt(seq)))
+                index.push_back(seq);
+        }
+    } else if (d->isFiltering()) {
+        auto seq = d->firstSeq;
+        for (const auto &chunk : d->chunks) {
+            for (const auto &entry : chunk) {
+                if (d->matches(entry))
+                    index.push_back(seq);
+                ++seq;
+            }
+        }
+    }
+
+    d->index.swap(index);
+
+    endResetModel();
+}
+
+QTLOGGER_DECL_SPEC
+int LogModelSink::find(const QString &text, int fromRow, bool backward,
+                       Qt::CaseSensitivity caseSensitivity) const
+{
+    if (fromRow < 0 || fromRow >= rowCount())
+        return -1;
+
+    d->updateFindIndex(text, caseSensitivity);
+
+    const auto &found = d->findIndex;
+    const auto from = d->seqAt(fromRow);
+
+    if (backward) {
+        auto it = std::upper_bound(found.cbegin(), found.cend(), from);
+        while (it != found.cbegin()) {
+            const auto row = d->rowOf(*--it);
+            if (row >= 0)
+                return row;
+        }
+    } else {
+        for (auto it = std::lower_bound(found.cbegin(), found.cend(), from); it != found.cend();
+             ++it) {
+            const auto row = d->rowOf(*it);
+            if (row >= 0)
+                return row;
+        }
+    }
+
+    return -1;
+}
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::clearFind()
+{
+    d->hasFindIndex = false;
+    d->findText.clear();
+    d->findIndex.clear();
+}
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::clear()
+{
+    beginResetModel();
+    d->firstSeq += static_cast<quint64>(d->totalCount());
+    d->chunks.clear();
+    d->index.clear();
+    d->findIndex.clear();
+    endResetModel();
+}
+
+QTLOGGER_DECL_SPEC
+int LogModelSink::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+        return 0;
+
+    return d->isFiltering() ? static_cast<int>(d->index.size()) : d->totalCount();
+}
+
+QTLOGGER_DECL_SPEC
+QVariant LogModelSink::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+        return QVariant();
+
+    const auto &entry = d->entryAt(d->seqAt(index.row()));
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return entry.displayText();
+    case TimeRole:
+        return QDateTime::fromMSecsSinceEpoch(entry.time);
+    case TypeRole:
+        return static_cast<int>(entry.type);
+    case CategoryRole:
+        return QString::fromUtf8(entry.category);
+    case FileRole:
+        return QString::fromUtf8(entry.file);
+    case LineRole:
+        return entry.line;
+    case FunctionRole:
+        return QString::fromUtf8(entry.function);
+    case MessageRole:
+        return entry.message;
+    case FormattedMessageRole:
+        return entry.displayText();
+    case ThreadIdRole:
+        return entry.threadId;
+    case AttributesRole:
+        return entry.attributes;
+    default:
+        return QVariant();
+    }
+}
+
+QTLOGGER_DECL_SPEC
+QHash<int, QByteArray> LogModelSink::roleNames() const
+{
+    auto roles = QAbstractListModel::roleNames();
+    roles.insert(TimeRole, "time");
+    roles.insert(TypeRole, "type");
+    roles.insert(CategoryRole, "category");
+    roles.insert(FileRole, "file");
+    roles.insert(LineRole, "line");
+    roles.insert(FunctionRole, "function");
+    roles.insert(MessageRole, "message");
+    roles.insert(FormattedMessageRole, "formattedMessage");
+    roles.insert(ThreadIdRole, "threadId");
+    roles.insert(AttributesRole, "attributes");
+    return roles;
+}
+
+QTLOGGER_DECL_SPEC
+void LogModelSink::startFlushTimer()
+{
+    if (d->flushInterval == 0) {
+        flush();
+        return;
+    }
+
+    if (!d->timer->isActive())
+        d->timer->start(d->flushInterval);
+}
+
+} // namespace QtLogger
@@ -0,0 +1,104 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "../logger_global.h"
+#include "../sink.h"
+
+namespace QtLogger {
+
+// List model of the latest messages for in-app log viewers.
+//
+// send() can be called from any thread. Messages are queued and inserted in the thread of the model
+// once per flush interval, a frame by default, with one beginInsertRows() per batch. They are
+// stored compactly in chunks; when more than maxCount messages are stored, the oldest chunk is
+// dropped, so memory stays bounded however many messages arrive.
+//
+// The rows are the messages matching the filter, kept in an index: new messages are checked when
+// they are inserted, and a filter that narrows the current one only checks the rows it matched.
+class QTLOGGER_EXPORT LogModelSink : public QAbstractListModel, public Sink
+{
+    Q_OBJECT
+
+public:
+    constexpr static int DefaultMaxCount = 1000000;
+    constexpr static int DefaultFlushInterval = 16; // ms
+
+    enum Role
+    {
+        TimeRole = Qt::UserRole + 1,
+        TypeRole,
+        CategoryRole,
+        FileRole,
+        LineRole,
+        FunctionRole,
+        MessageRole,
+        FormattedMessageRole,
+        ThreadIdRole,
+        AttributesRole
+    };
+
+    struct RowFilter
+    {
+        QtMsgType minLevel = QtDebugMsg;
+        // Category name, '*' matches any characters; empty matches all
+        QString category;
+        // Substring of the formatted message
+        QString text;
+        Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive;
+    };
+
+    explicit LogModelSink(int maxCount = DefaultMaxCount, QObject *parent = nullptr);
+    ~LogModelSink() override;
+
+    void send(const LogMessage &lmsg) override;
+
+    // Inserts the queued messages when called in the thread of the model, otherwise schedules it
+    bool flush() override;
+
+    int maxCount() const;
+
+    int flushInterval() const;
+    void setFlushInterval(int msecs);
+
+    // Stored messages, matching the filter or not
+    int totalCount() const;
+    // Messages dropped before they were inserted, because the model thread didn't keep up
+    quint64 droppedCount() const;
+
+    RowFilter rowFilter() const;
+    void setRowFilter(const RowFilter &filter);
+
+    // The next row from fromRow on, or the previous one, with the text in the formatted message;
+    // -1 if there is none.
+    //
+    // The messages with the text are kept in an index like the rows. A new text checks every
+    // stored message once, up to maxCount, in the calling thread; a text that extends the previous
+    // one only checks the messages it matched, and finding the same text again is a lookup. Until
+    // clearFind(), every inserted message is also checked for the text.
+    int find(const QString &text, int fromRow = 0, bool backward = false,
+             Qt::CaseSensitivity caseSensitivity = Qt::CaseInsensitive) const;
+    // Drops the index of find()
+    void clearFind();
+
+    void clear();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+private:
+    Q_INVOKABLE void startFlushTimer();
+
+    class LogModelSinkPrivate;
+    QScopedPointer<LogModelSinkPrivate> d;
+};
+
+using LogModelSinkPtr = QSharedPointer<LogModelSink>;
+
+} // namespace QtLogger
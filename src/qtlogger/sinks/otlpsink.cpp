@@ -0,0 +1,650 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifdef QTLOGGER_NETWORK
+
+#include "otlpsink.h"
+
+#include <QAtomicInteger>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QThread>
+#include <QTimer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+#include "../attrhandlers/appinfoattrs.h"
+#include "../attrhandlers/sysinfoattrs.h"
+#include "sinkthread.h"
+
+namespace QtLogger {
+
+namespace {
+
+struct OtlpRecord
+{
+    QString scope;
+    QJsonObject record;
+};
+
+int otlpSeverityNumber(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return 5;
+    case QtInfoMsg:
+        return 9;
+    case QtWarningMsg:
+        return 13;
+    case QtCriticalMsg:
+        return 17;
+    case QtFatalMsg:
+        return 21;
+    }
+    return 5;
+}
+
+QString otlpSeverityText(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:
+        return QStringLiteral("DEBUG");
+    case QtInfoMsg:
+        return QStringLiteral("INFO");
+    case QtWarningMsg:
+        return QStringLiteral("WARN");
+    case QtCriticalMsg:
+        return QStringLiteral("ERROR");
+    case QtFatalMsg:
+        return QStringLiteral("FATAL");
+    }
+    return QStringLiteral("DEBUG");
+}
+
+// 64-bit integers are strings in the JSON mapping of OTLP
+QString otlpNanos(const QDateTime &time)
+{
+    return QString::number(time.toMSecsSinceEpoch() * 1000000);
+}
+
+QJsonObject otlpAnyValue(const QVariant &value);
+
+QJsonObject otlpKeyValue(const QString &key, const QVariant &value)
+{
+    return QJsonObject { { QStringLiteral("key"), key },
+                         { QStringLiteral("value"), otlpAnyValue(value) } };
+}
+
+QJsonArray otlpKeyValueList(const QVariantHash &attributes)
+{
+    QJsonArray result;
+    for (auto it = attributes.cbegin(); it != attributes.cend(); ++it) {
+        result.append(otlpKeyValue(it.key(), it.value()));
+    }
+    return result;
+}
+
+QJsonObject otlpAnyValue(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::Bool:
+        return QJsonObject { { QStringLiteral("boolValue"), value.toBool() } };
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+        return QJsonObject { { QStringLiteral("intValue"),
+                               QString::number(value.toLongLong()) } };
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return QJsonObject { { QStringLiteral("doubleValue"), value.toDouble() } };
+    case QMetaType::QByteArray:
+        return QJsonObject { { QStringLiteral("bytesValue"),
+                               QString::fromLatin1(value.toByteArray().toBase64()) } };
+    case QMetaType::QStringList:
+    case QMetaType::QVariantList: {
+        QJsonArray values;
+        const auto list = value.toList();
+        for (const auto &item : list) {
+            values.append(otlpAnyValue(item));
+        }
+        return QJsonObject { { QStringLiteral("arrayValue"),
+                               QJsonObject { { QStringLiteral("values"), values } } } };
+    }
+    case QMetaType::QVariantMap:
+    case QMetaType::QVariantHash:
+        return QJsonObject { { QStringLiteral("kvlistValue"),
+                               QJsonObject { { QStringLiteral("values"),
+                                               otlpKeyValueList(value.toHash()) } } } };
+    default:
+        return QJsonObject { { QStringLiteral("stringValue"), value.toString() } };
+    }
+}
+
+QString otlpScope(const LogMessage &lmsg)
+{
+    return lmsg.category() && *lmsg.category() ? QString::fromUtf8(lmsg.category())
+                                               : QStringLiteral("default");
+}
+
+QByteArray otlpExportRequest(const QList<OtlpRecord> &records,
+                             const QVariantHash &resourceAttributes)
+{
+    // Records of a category share a scope, the scopes keep the order of their first record
+    QStringList scopeNames;
+    QHash<QString, QJsonArray> scopeRecords;
+    for (const auto &item : records) {
+        auto it = scopeRecords.find(item.scope);
+        if (it == scopeRecords.end()) {
+            scopeNames.append(item.scope);
+            it = scopeRecords.insert(item.scope, QJsonArray());
+        }
+        it->append(item.record);
+    }
+
+    QJsonArray scopeLogs;
+    for (const auto &name : std::as_const(scopeNames)) {
+        scopeLogs.append(QJsonObject {
+                { QStringLiteral("scope"), QJsonObject { { QStringLiteral("name"), name } } },
+                { QStringLiteral("logRecords"), scopeRecords.value(name) } });
+    }
+
+    const QJsonObject resourceLogs {
+        { QStringLiteral("resource"),
+          QJsonObject { { QStringLiteral("attributes"),
+                          otlpKeyValueList(resourceAttributes) } } },
+        { QStringLiteral("scopeLogs"), scopeLogs }
+    };
+
+    const QJsonObject request { { QStringLiteral("resourceLogs"), QJsonArray { resourceLogs } } };
+
+    return QJsonDocument(request).toJson(QJsonDocument::Compact);
+}
+
+} // namespace
+
+class OtlpSink::OtlpSinkPrivate
+{
+public:
+    OtlpSinkPrivate(const QUrl &endpoint, const Headers &headers)
+        : endpoint(endpoint), resourceAttributes(defaultResourceAttributes())
+    {
+        if (this->endpoint.path().isEmpty() || this->endpoint.path() == QLatin1String("/"))
+            this->endpoint.setPath(QStringLiteral("/v1/logs"));
+
+        request.setUrl(this->endpoint);
+        request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
+        setHeaders(headers);
+    }
+
+    ~OtlpSinkPrivate()
+    {
+        thread.run([this] { resetManager(); });
+        thread.stop();
+    }
+
+    // Called with the mutex locked
+    void setHeaders(const Headers &headers)
+    {
+        for (const auto &header : headers) {
+            request.setRawHeader(header.first, header.second);
+        }
+    }
+
+    // The record is queued in the calling thread, so a full queue drops it before send() returns
+    void send(const LogMessage &lmsg)
+    {
+        OtlpRecord record { otlpScope(lmsg), toLogRecord(lmsg) };
+
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            if (queue.size() >= maxQueueSize) {
+                dropped.fetchAndAddRelaxed(1);
+                return;
+            }
+
+            queue.append(record);
+
+            // Records queued until the thread of the sink gets to them are handled by one call
+            if (updateScheduled)
+                return;
+            updateScheduled = true;
+        }
+
+        thread.post([this] {
+            ensureManager();
+            update();
+        });
+    }
+
+    void flush()
+    {
+        thread.run([this] {
+            if (!manager)
+                return;
+
+            while (queueSize() > 0) {
+                exportBatch(true);
+            }
+        });
+    }
+
+    QUrl endpoint;
+
+    // Set by any thread, guarded by the mutex and copied by the thread of the sink before use
+    QNetworkRequest request;
+    QVariantHash resourceAttributes;
+    int maxQueueSize = DefaultMaxQueueSize;
+    int maxExportBatchSize = DefaultMaxExportBatchSize;
+    int scheduleDelay = DefaultScheduleDelay;
+    int exportTimeout = DefaultExportTimeout;
+
+    QAtomicInteger<quint64> exported;
+    QAtomicInteger<quint64> dropped;
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    SinkThread thread { QStringLiteral("OtlpSink") };
+
+private:
+    // The manager, its timer and the replies are used only in the thread of the sink
+    void ensureManager()
+    {
+        if (manager)
+            return;
+
+        manager = new QNetworkAccessManager(thread.context());
+
+        timer = new QTimer(manager.data());
+        timer->setSingleShot(true);
+        QObject::connect(timer.data(), &QTimer::timeout, manager.data(), [this] { exportBatch(); });
+    }
+
+    // Exports a full batch, or schedules the export of an incomplete one
+    void update()
+    {
+        int size = 0;
+        int maxExportBatchSize = DefaultMaxExportBatchSize;
+        int scheduleDelay = DefaultScheduleDelay;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            updateScheduled = false;
+            size = queue.size();
+            maxExportBatchSize = this->maxExportBatchSize;
+            scheduleDelay = this->scheduleDelay;
+        }
+
+        if (size >= maxExportBatchSize)
+            exportBatch();
+        else if (size > 0 && timer && !timer->isActive())
+            timer->start(scheduleDelay);
+    }
+
+    int queueSize()
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&mutex);
+#endif
+        return queue.size();
+    }
+
+    int currentExportTimeout()
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&mutex);
+#endif
+        return exportTimeout;
+    }
+
+    // Queued records are exported before the manager is deleted, waiting up to the export
+    // timeout for the collector to accept them
+    void resetManager()
+    {
+        if (!manager)
+            return;
+
+        if (manager->thread() == QThread::currentThread()) {
+            while (queueSize() > 0) {
+                exportBatch(true);
+            }
+
+            if (activeExports > 0) {
+                QEventLoop loop;
+                waitLoop = &loop;
+                QTimer::singleShot(currentExportTimeout(), &loop, &QEventLoop::quit);
+                loop.exec(QEventLoop::ExcludeUserInputEvents);
+                waitLoop = nullptr;
+            }
+        }
+
+        for (const auto &reply : std::as_const(replies)) {
+            if (reply)
+                reply->disconnect(manager.data());
+        }
+        replies.clear();
+        timer->disconnect();
+
+        if (manager->thread() == QThread::currentThread())
+            delete manager.data();
+        else
+            manager->deleteLater();
+
+        manager = nullptr;
+        activeExports = 0;
+    }
+
+    // One export at a time unless forced by flush, the queue collects the records meanwhile
+    void exportBatch(bool force = false)
+    {
+        if (!manager || (activeExports > 0 && !force))
+            return;
+
+        QList<OtlpRecord> batch;
+        QNetworkRequest request;
+        QVariantHash resourceAttributes;
+        int exportTimeout = DefaultExportTimeout;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            const auto count = qMin(queue.size(), maxExportBatchSize);
+            batch = queue.mid(0, count);
+            queue.erase(queue.begin(), queue.begin() + count);
+
+            request = this->request;
+            resourceAttributes = this->resourceAttributes;
+            exportTimeout = this->exportTimeout;
+        }
+
+        if (batch.isEmpty())
+            return;
+
+        timer->stop();
+
+        const auto count = batch.size();
+
+        auto reply = manager->post(request, otlpExportRequest(batch, resourceAttributes));
+        replies.append(reply);
+        ++activeExports;
+
+        QTimer::singleShot(exportTimeout, reply, &QNetworkReply::abort);
+
+        QObject::connect(reply, &QNetworkReply::finished, manager.data(), [this, reply, count] {
+            const auto status =
+                    reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            if (reply->error() == QNetworkReply::NoError && status >= 200 && status < 300)
+                exported.fetchAndAddRelaxed(static_cast<quint64>(count));
+            else
+                dropped.fetchAndAddRelaxed(static_cast<quint64>(count));
+
+            replies.removeAll(reply);
+            reply->deleteLater();
+
+            if (--activeExports == 0 && waitLoop)
+                waitLoop->quit();
+
+            update();
+        });
+    }
+
+    QPointer<QNetworkAccessManager> manager;
+    QPointer<QTimer> timer;
+    QList<QPointer<QNetworkReply>> replies;
+    int activeExports = 0;
+    QEventLoop *waitLoop = nullptr;
+
+    QList<OtlpRecord> queue;
+    bool updateScheduled = false;
+};
+
+QTLOGGER_DECL_SPEC
+OtlpSink::OtlpSink(const QUrl &endpoint) : d(new OtlpSinkPrivate(endpoint, {})) { }
+
+QTLOGGER_DECL_SPEC
+OtlpSink::OtlpSink(const QUrl &endpoint, const Headers &headers)
+    : d(new OtlpSinkPrivate(endpoint, headers))
+{
+}
+
+QTLOGGER_DECL_SPEC
+OtlpSink::~OtlpSink() = default;
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::send(const LogMessage &lmsg)
+{
+    d->send(lmsg);
+}
+
+QTLOGGER_DECL_SPEC
+bool OtlpSink::flush()
+{
+    d->flush();
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+QUrl OtlpSink::endpoint() const
+{
+    return d->endpoint;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setHeaders(const Headers &headers)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->setHeaders(headers);
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash OtlpSink::resourceAttributes() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->resourceAttributes;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setResourceAttributes(const QVariantHash &attributes)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->resourceAttributes = attributes;
+}
+
+QTLOGGER_DECL_SPEC
+int OtlpSink::maxQueueSize() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxQueueSize;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setMaxQueueSize(int maxQueueSize)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxQueueSize = qMax(maxQueueSize, 1);
+}
+
+QTLOGGER_DECL_SPEC
+int OtlpSink::maxExportBatchSize() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxExportBatchSize;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setMaxExportBatchSize(int maxExportBatchSize)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxExportBatchSize = qMax(maxExportBatchSize, 1);
+}
+
+QTLOGGER_DECL_SPEC
+int OtlpSink::scheduleDelay() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->scheduleDelay;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setScheduleDelay(int msecs)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->scheduleDelay = qMax(msecs, 0);
+}
+
+QTLOGGER_DECL_SPEC
+int OtlpSink::exportTimeout() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->exportTimeout;
+}
+
+QTLOGGER_DECL_SPEC
+void OtlpSink::setExportTimeout(int msecs)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->exportTimeout = qMax(msecs, 0);
+}
+
+QTLOGGER_DECL_SPEC
+quint64 OtlpSink::exportedCount() const
+{
+    return d->exported.loadAcquire();
+}
+
+QTLOGGER_DECL_SPEC
+quint64 OtlpSink::droppedCount() const
+{
+    return d->dropped.loadAcquire();
+}
+
+QTLOGGER_DECL_SPEC
+QVariantHash OtlpSink::defaultResourceAttributes()
+{
+    const LogMessage lmsg;
+    auto attrs = AppInfoAttrs().attributes(lmsg);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    attrs.insert(SysInfoAttrs().attributes(lmsg));
+#else
+    attrs.unite(SysInfoAttrs().attributes(lmsg));
+#endif
+
+    static const QList<QPair<QString, QString>> names = {
+        { QStringLiteral("appname"), QStringLiteral("service.name") },
+        { QStringLiteral("appversion"), QStringLiteral("service.version") },
+        { QStringLiteral("apppath"), QStringLiteral("process.executable.path") },
+        { QStringLiteral("pid"), QStringLiteral("process.pid") },
+        { QStringLiteral("machine_host_name"), QStringLiteral("host.name") },
+        { QStringLiteral("machine_unique_id"), QStringLiteral("host.id") },
+        { QStringLiteral("cpu_arch"), QStringLiteral("host.arch") },
+        { QStringLiteral("kernel_type"), QStringLiteral("os.type") },
+        { QStringLiteral("os_name"), QStringLiteral("os.name") },
+        { QStringLiteral("os_version"), QStringLiteral("os.version") },
+        { QStringLiteral("pretty_product_name"), QStringLiteral("os.description") },
+    };
+
+    QVariantHash result;
+    for (const auto &name : names) {
+        const auto value = attrs.value(name.first).toString();
+        if (!value.isEmpty())
+            result.insert(name.second, attrs.value(name.first));
+    }
+
+    // service.name is required by the specification
+    if (!result.contains(QStringLiteral("service.name"))) {
+        result.insert(QStringLiteral("service.name"),
+                      QStringLiteral("unknown_service:")
+                              + QFileInfo(attrs.value(QStringLiteral("apppath")).toString())
+                                        .fileName());
+    }
+
+    result.insert(QStringLiteral("telemetry.sdk.name"), QStringLiteral("qtlogger"));
+    result.insert(QStringLiteral("telemetry.sdk.language"), QStringLiteral("cpp"));
+
+    return result;
+}
+
+QTLOGGER_DECL_SPEC
+QJsonObject OtlpSink::toLogRecord(const LogMessage &lmsg)
+{
+    QJsonObject record;
+
+    const auto time = otlpNanos(lmsg.time());
+    record.insert(QStringLiteral("timeUnixNano"), time);
+    record.insert(QStringLiteral("observedTimeUnixNano"), time);
+    record.insert(QStringLiteral("severityNumber"), otlpSeverityNumber(lmsg.type()));
+    record.insert(QStringLiteral("severityText"), otlpSeverityText(lmsg.type()));
+    record.insert(QStringLiteral("body"),
+                  QJsonObject { { QStringLiteral("stringValue"), lmsg.formattedMessage() } });
+
+    auto attrs = lmsg.attributes();
+    if (lmsg.file()) {
+        attrs.insert(QStringLiteral("code.file.path"), QString::fromUtf8(lmsg.file()));
+        attrs.insert(QStringLiteral("code.line.number"), lmsg.line());
+    }
+    if (lmsg.function())
+        attrs.insert(QStringLiteral("code.function.name"), QString::fromUtf8(lmsg.function()));
+#ifndef QTLOGGER_NO_THREAD
+    attrs.insert(QStringLiteral("thread.id"), static_cast<qint64>(lmsg.threadId()));
+#endif
+
+    record.insert(QStringLiteral("attributes"), otlpKeyValueList(attrs));
+
+    return record;
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray OtlpSink::exportRequest(const QList<LogMessage> &messages,
+                                   const QVariantHash &resourceAttributes)
+{
+    QList<OtlpRecord> records;
+    records.reserve(messages.size());
+    for (const auto &lmsg : messages) {
+        records.append({ otlpScope(lmsg), toLogRecord(lmsg) });
+    }
+
+    return otlpExportRequest(records, resourceAttributes);
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
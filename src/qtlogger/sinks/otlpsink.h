@@ -0,0 +1,93 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QJsonObject>
+#include <QList>
+#include <QPair>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QUrl>
+#include <QVariantHash>
+
+#include "../logger_global.h"
+#include "../sink.h"
+
+namespace QtLogger {
+
+// Exports messages to an OpenTelemetry collector as OTLP/HTTP JSON.
+//
+// Messages are mapped to OTLP log records and exported in batches like the batch log record
+// processor of the OpenTelemetry SDKs: a batch is sent when maxExportBatchSize() records are
+// queued or scheduleDelay() has passed, one export at a time. Records arriving while the queue
+// holds maxQueueSize() records are dropped.
+//
+// The network access manager lives in a thread of the sink, so the sending threads need no event
+// loop. Records are queued in the calling thread.
+class QTLOGGER_EXPORT OtlpSink : public Sink
+{
+public:
+    using Headers = QList<QPair<QByteArray, QByteArray>>;
+
+    static constexpr int DefaultMaxQueueSize = 2048;
+    static constexpr int DefaultMaxExportBatchSize = 512;
+    static constexpr int DefaultScheduleDelay = 1000; // ms
+    static constexpr int DefaultExportTimeout = 30000; // ms
+
+    // An endpoint without a path gets the OTLP logs path "/v1/logs"
+    explicit OtlpSink(const QUrl &endpoint);
+    OtlpSink(const QUrl &endpoint, const Headers &headers);
+    ~OtlpSink() override;
+
+    void send(const LogMessage &lmsg) override;
+    // Starts the export of all queued records
+    bool flush() override;
+
+    QUrl endpoint() const;
+    void setHeaders(const Headers &headers);
+
+    // Attributes of the resource the records belong to, defaultResourceAttributes() by default
+    QVariantHash resourceAttributes() const;
+    void setResourceAttributes(const QVariantHash &attributes);
+
+    int maxQueueSize() const;
+    void setMaxQueueSize(int maxQueueSize);
+
+    int maxExportBatchSize() const;
+    void setMaxExportBatchSize(int maxExportBatchSize);
+
+    int scheduleDelay() const;
+    void setScheduleDelay(int msecs);
+
+    int exportTimeout() const;
+    void setExportTimeout(int msecs);
+
+    // Records accepted by the collector, and records dropped because the queue was full or the
+    // export failed
+    quint64 exportedCount() const;
+    quint64 droppedCount() const;
+
+    // SysInfoAttrs and AppInfoAttrs with OpenTelemetry semantic convention names
+    static QVariantHash defaultResourceAttributes();
+
+    // OTLP LogRecord of a message
+    static QJsonObject toLogRecord(const LogMessage &lmsg);
+
+    // ExportLogsServiceRequest with the messages grouped into scopes by category
+    static QByteArray exportRequest(const QList<LogMessage> &messages,
+                                    const QVariantHash &resourceAttributes);
+
+private:
+    class OtlpSinkPrivate;
+    QScopedPointer<OtlpSinkPrivate> d;
+    Q_DISABLE_COPY(OtlpSink)
+};
+
+using OtlpSinkPtr = QSharedPointer<OtlpSink>;
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
@@ -0,0 +1,69 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "recordingsink.h"
+
+#include <QFile>
+
+#include "../binarylog.h"
+
+namespace QtLogger {
+
+class RecordingSink::RecordingSinkPrivate
+{
+public:
+    quint64 maxCount = 0;
+    quint64 count = 0;
+
+    BinaryLogWriter writer;
+};
+
+QTLOGGER_DECL_SPEC
+RecordingSink::RecordingSink(const QString &path, quint64 maxCount)
+    : FileSink(path, QIODevice::WriteOnly | QIODevice::Truncate), d(new RecordingSinkPrivate)
+{
+    d->maxCount = maxCount;
+}
+
+QTLOGGER_DECL_SPEC
+RecordingSink::~RecordingSink() = default;
+
+QTLOGGER_DECL_SPEC
+void RecordingSink::send(const LogMessage &lmsg)
+{
+    if (!isValid() || (d->maxCount > 0 && d->count >= d->maxCount))
+        return;
+
+    FileSink::send(lmsg);
+    ++d->count;
+
+    // The recording is complete, nothing is left in the buffer if the application is killed
+    if (d->count == d->maxCount)
+        flush();
+}
+
+QTLOGGER_DECL_SPEC
+bool RecordingSink::isValid() const
+{
+    return file() && file()->isOpen();
+}
+
+QTLOGGER_DECL_SPEC
+quint64 RecordingSink::maxCount() const
+{
+    return d->maxCount;
+}
+
+QTLOGGER_DECL_SPEC
+quint64 RecordingSink::count() const
+{
+    return d->count;
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray RecordingSink::encode(const LogMessage &lmsg)
+{
+    return d->writer.encode(lmsg);
+}
+
+} // namespace QtLogger
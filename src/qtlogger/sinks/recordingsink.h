@@ -0,0 +1,45 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "../logger_global.h"
+#include "filesink.h"
+
+namespace QtLogger {
+
+// Records a workload for LogReplay: the raw messages with their time, thread, callsite and
+// attributes are written to a single binary log file (see binarylog.h), which is truncated when the
+// sink is created. Placed first in a pipeline, it records the traffic before any filter. With
+// maxCount, only the first messages are recorded, so a sample of production traffic can be taken
+// without limiting the recording by hand.
+class QTLOGGER_EXPORT RecordingSink : public FileSink
+{
+public:
+    explicit RecordingSink(const QString &path, quint64 maxCount = 0);
+    ~RecordingSink() override;
+
+    void send(const LogMessage &lmsg) override;
+
+    // False if the file can't be written
+    bool isValid() const;
+
+    quint64 maxCount() const;
+    // Messages recorded so far
+    quint64 count() const;
+
+protected:
+    QByteArray encode(const LogMessage &lmsg) override;
+
+private:
+    class RecordingSinkPrivate;
+    QScopedPointer<RecordingSinkPrivate> d;
+    Q_DISABLE_COPY(RecordingSink)
+};
+
+using RecordingSinkPtr = QSharedPointer<RecordingSink>;
+
+} // namespace QtLogger
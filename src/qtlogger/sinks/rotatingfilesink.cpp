@@ -3,6 +3,10 @@
 
 #include "rotatingfilesink.h"
 
+#include "../seekablegzip.h"
+#include "../termindex.h"
+#include "../timeindex.h"
+
 /*
  * Rotated file naming format:
  *   <basename>.<date>.<index>.<suffix>[.gz]
@@ -15,6 +19,11 @@
  *
  *   If maxFileCount == 1, rotation is disabled (only the main file is kept)
  *   If maxFileCount <= 0, rotated files are kept indefinitely (no automatic cleanup)
+ *
+ * With the TimeIndex option the "<file>.idx" index is renamed and removed with its log file.
+ * BlockCompression writes seekable gzip files with a "<file>.gz.gzi" block index instead of a
+ * single gzip stream, see seekablegzip.h. With TermIndex the terms of a file are written to
+ * "<file>.tix" when it is rotated, if the sink wrote the file from its start.
  */
 
 
@@ -23,48 +32,12 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QRegularExpression>
-#include <QtEndian>
-#include <QDataStream>
 
 #include <algorithm>
 #include <iostream>
 
 namespace QtLogger {
 
-namespace {
-
-QTLOGGER_DECL_SPEC
-static quint32 calculateCRC32(QFile &file) {
-    quint32 crc = 0xFFFFFFFF;
-    const quint32 polynomial = 0xEDB88320;
-    static quint32 table[256];
-    static bool tableGenerated = false;
-
-    if (!tableGenerated) {
-        for (quint32 i = 0; i < 256; i++) {
-            quint32 value = i;
-            for (int j = 0; j < 8; j++) {
-                if (value & 1) value = (value >> 1) ^ polynomial;
-                else value >>= 1;
-            }
-            table[i] = value;
-        }
-        tableGenerated = true;
-    }
-
-    file.seek(0);
-    char buffer[8192];
-    while (!file.atEnd()) {
-        auto bytesRead = file.read(buffer, sizeof(buffer));
-        for (auto i = 0; i < bytesRead; i++) {
-            crc = table[(crc ^ static_cast<unsigned char>(buffer[i])) & 0xFF] ^ (crc >> 8);
-        }
-    }
-    return crc ^ 0xFFFFFFFF;
-}
-
-} // namespace
-
 class RotatingFileSink::RotatingFileSinkPrivate
 {
 public:
@@ -77,8 +50,19 @@ public:
         , m_maxFileCount(maxFileCount)
         , m_rotationOnStartup(options.testFlag(RotatingFileSink::RotationOnStartup))
         , m_rotationDaily(options.testFlag(RotatingFileSink::RotationDaily))
-        , m_compression(options.testFlag(RotatingFileSink::Compression))
+        , m_compression(options.testFlag(RotatingFileSink::Compression)
+                        || options.testFlag(RotatingFileSink::BlockCompression))
+        , m_blockCompression(options.testFlag(RotatingFileSink::BlockCompression))
     {
+        // The block index takes the time of each block from the time index, the term index
+        // refers to its entries
+        if (options.testFlag(RotatingFileSink::TimeIndex) || m_blockCompression
+            || options.testFlag(RotatingFileSink::TermIndex)) {
+            m_timeIndex.reset(new TimeIndexWriter());
+        }
+
+        if (options.testFlag(RotatingFileSink::TermIndex))
+            m_termIndex.reset(new TermIndexWriter());
     }
 
     void init()
@@ -100,18 +84,21 @@ public:
         }
     }
 
-    void rotateIfNeeded(const LogMessage &lmsg)
+    bool rotateIfNeeded(const LogMessage &lmsg, qint64 additionalSize)
     {
         const auto messageDate = lmsg.time().date();
 
+        bool rotated = false;
+
         if (m_rotationDaily) {
-            checkDailyRotation(messageDate);
+            rotated = checkDailyRotation(messageDate);
         }
 
         if (m_maxFileSize > 0) {
-            const auto additionalSize = lmsg.formattedMessage().toUtf8().size() + 1; // +1 for newline
-            checkSizeRotation(additionalSize);
+            rotated = checkSizeRotation(additionalSize) || rotated;
         }
+
+        return rotated;
     }
 
     void checkStartupRotation()
@@ -121,23 +108,49 @@ public:
         }
     }
 
-    void checkDailyRotation(const QDate &messageDate)
+    bool checkDailyRotation(const QDate &messageDate)
     {
         if (messageDate != m_currentLogDate && q_ptr->file()->size() > 0) {
-            rotate();
+            const auto rotated = rotate();
             m_currentLogDate = messageDate;
+            return rotated;
         }
+        return false;
     }
 
-    void checkSizeRotation(int additionalSize)
+    bool checkSizeRotation(qint64 additionalSize)
     {
         if (m_maxFileSize <= 0)
-            return;
+            return false;
 
         const auto currentSize = q_ptr->file()->size();
         if (currentSize > 0 && (currentSize + additionalSize) > m_maxFileSize) {
-            rotate();
+            return rotate();
+        }
+        return false;
+    }
+
+    // Called after the time index entry of the message was added, before the message is written
+    void addTerms(const LogMessage &lmsg, const QByteArray &data)
+    {
+        // Terms of a file that was already written to are unknown
+        if (q_ptr->file()->pos() == 0) {
+            m_termIndex->reset();
+            m_termIndexComplete = true;
         }
+
+        const auto rangeOffset = m_timeIndex->lastOffset();
+        if (rangeOffset < 0)
+            m_termIndexComplete = false;
+
+        if (!m_termIndexComplete)
+            return;
+
+        // Text logs are searched line by line as UTF-8, whatever the formatter rendered
+        if (q_ptr->writesBinaryLog())
+            m_termIndex->add(lmsg, rangeOffset);
+        else
+            m_termIndex->addText(QString::fromUtf8(data), rangeOffset);
     }
 
     QString baseDir() const
@@ -202,6 +215,12 @@ public:
 
     void compressFile(const QString &filePath)
     {
+        if (m_blockCompression) {
+            if (SeekableGzip::compress(filePath, m_compressionBlockSize))
+                QFile::remove(filePath);
+            return;
+        }
+
         auto inputFile = QFile(filePath);
         if (!inputFile.open(QIODevice::ReadOnly)) return;
 
@@ -212,29 +231,7 @@ public:
             return;
         }
 
-        auto fileCRC = calculateCRC32(inputFile);
-        auto fileSize = static_cast<quint32>(inputFile.size());
-        inputFile.seek(0);
-
-        outputFile.putChar('\x1f'); // ID1
-        outputFile.putChar('\x8b'); // ID2
-        outputFile.putChar('\x08'); // CM (Deflate)
-        outputFile.putChar('\x00'); // FLG
-        outputFile.write("\x00\x00\x00\x00", 4); // MTIME (0 = unknown)
-        outputFile.putChar('\x00'); // XFL
-        outputFile.putChar('\x03'); // OS (Unix)
-
-        auto rawData = inputFile.readAll();
-        auto compressed = qCompress(rawData, 5);
-
-        if (compressed.size() > 10) {
-            outputFile.write(compressed.constData() + 6, compressed.size() - 6 - 4);
-        }
-
-        auto le_crc = qToLittleEndian(fileCRC);
-        auto le_size = qToLittleEndian(fileSize);
-        outputFile.write(reinterpret_cast<const char*>(&le_crc), 4);
-        outputFile.write(reinterpret_cast<const char*>(&le_size), 4);
+        outputFile.write(SeekableGzip::member(inputFile.readAll()));
 
         inputFile.close();
         outputFile.close();
@@ -288,17 +285,35 @@ public:
                 std::cerr << "RotatingFileSink: Failed to remove old log file: "
                           << oldestFile.toStdString() << std::endl;
             }
+
+            if (m_timeIndex) {
+                auto logFileName = oldestFile;
+                if (logFileName.endsWith(QStringLiteral(".gz"))) {
+                    QFile::remove(SeekableGzip::indexFileName(oldestFile));
+                    logFileName.chop(3);
+                }
+                QFile::remove(TimeIndex::indexFileName(logFileName));
+                QFile::remove(TermIndex::indexFileName(logFileName));
+            }
+
             rotatedFiles.removeFirst();
         }
     }
 
-    void rotate()
+    bool rotate()
     {
         if (m_maxFileCount == 1)
-            return;
+            return false;
+
+        const auto openMode = q_ptr->file()->isOpen()
+                ? q_ptr->file()->openMode()
+                : QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text;
 
         q_ptr->file()->close();
 
+        if (m_timeIndex)
+            m_timeIndex->close();
+
         const auto &currentFileName = q_ptr->file()->fileName();
         const auto rotationDate = m_currentLogDate.isValid() ? m_currentLogDate : QDate::currentDate();
         const auto nextIndex = findNextIndexForDate(rotationDate);
@@ -308,18 +323,40 @@ public:
             std::cerr << "RotatingFileSink: Failed to rename log file from "
                       << currentFileName.toStdString() << " to "
                       << rotatedFileName.toStdString() << std::endl;
-        } else if (m_compression) {
-            compressFile(rotatedFileName);
+        } else {
+            if (m_timeIndex) {
+                // Offsets of the index refer to the uncompressed file
+                const auto rotatedIndexFileName = TimeIndex::indexFileName(rotatedFileName);
+                QFile::remove(rotatedIndexFileName);
+                QFile::rename(TimeIndex::indexFileName(currentFileName), rotatedIndexFileName);
+            }
+
+            if (m_termIndex) {
+                const auto termIndexFileName = TermIndex::indexFileName(rotatedFileName);
+                QFile::remove(termIndexFileName);
+                if (m_termIndexComplete && m_termIndex->isComplete())
+                    m_termIndex->write(termIndexFileName);
+            }
+
+            if (m_compression)
+                compressFile(rotatedFileName);
+        }
+
+        if (m_termIndex) {
+            m_termIndex->reset();
+            m_termIndexComplete = false;
         }
 
         removeOldFiles();
 
-        if (!q_ptr->file()->open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        if (!q_ptr->file()->open(openMode)) {
             std::cerr << "RotatingFileSink: Failed to reopen log file: "
                       << currentFileName.toStdString() << std::endl;
         }
 
         m_currentLogDate = QDate::currentDate();
+
+        return true;
     }
 
     RotatingFileSink *q_ptr;
@@ -329,6 +366,12 @@ public:
     bool m_rotationOnStartup;
     bool m_rotationDaily;
     bool m_compression;
+    bool m_blockCompression;
+    int m_compressionBlockSize = SeekableGzip::DefaultBlockSize;
+
+    QScopedPointer<TimeIndexWriter> m_timeIndex;
+    QScopedPointer<TermIndexWriter> m_termIndex;
+    bool m_termIndexComplete = false;
 
     QDate m_currentLogDate;
     bool m_initialized = false;
@@ -344,15 +387,74 @@ RotatingFileSink::RotatingFileSink(const QString &path,
 {
 }
 
+QTLOGGER_DECL_SPEC
+RotatingFileSink::RotatingFileSink(const QString &path,
+                                   int maxFileSize,
+                                   int maxFileCount,
+                                   RotatingFileSink::Options options,
+                                   QIODevice::OpenMode openMode)
+    : FileSink(path, openMode)
+    , d(new RotatingFileSinkPrivate(this, maxFileSize, maxFileCount, options))
+{
+}
+
 QTLOGGER_DECL_SPEC
 RotatingFileSink::~RotatingFileSink() = default;
 
 QTLOGGER_DECL_SPEC
 void RotatingFileSink::send(const LogMessage &lmsg)
 {
+    // Neither written nor rotated if the file failed to open
+    if (!device() || !device()->isOpen())
+        return;
+
     d->init();
-    d->rotateIfNeeded(lmsg);
-    FileSink::send(lmsg);
+
+    auto data = encode(lmsg);
+
+    if (d->rotateIfNeeded(lmsg, data.size())) {
+        // The encoding may depend on the file contents, e.g. the header of a binary log
+        data = encode(lmsg);
+    }
+
+    // The file may have failed to reopen after a rotation
+    if (!device()->isOpen())
+        return;
+
+    if (d->m_timeIndex)
+        d->m_timeIndex->add(file()->fileName(), lmsg.time(), file()->pos());
+
+    if (d->m_termIndex)
+        d->addTerms(lmsg, data);
+
+    updateTextMode(lmsg);
+    device()->write(data);
+}
+
+QTLOGGER_DECL_SPEC
+bool RotatingFileSink::flush()
+{
+    const auto flushed = FileSink::flush();
+    return (!d->m_timeIndex || d->m_timeIndex->flush()) && flushed;
+}
+
+QTLOGGER_DECL_SPEC
+void RotatingFileSink::setCompressionBlockSize(int blockSize)
+{
+    d->m_compressionBlockSize = qMax(blockSize, 1);
+}
+
+QTLOGGER_DECL_SPEC
+bool RotatingFileSink::writesBinaryLog() const
+{
+    return false;
+}
+
+QTLOGGER_DECL_SPEC
+void RotatingFileSink::setTimeIndexInterval(int intervalBytes, int intervalMsecs)
+{
+    if (d->m_timeIndex)
+        d->m_timeIndex.reset(new TimeIndexWriter(intervalBytes, intervalMsecs));
 }
 
 } // namespace QtLogger
@@ -5,6 +5,7 @@
 
 #include <QScopedPointer>
 #include <QSharedPointer>
+#include <QStringList>
 
 #include "../logger_global.h"
 #include "filesink.h"
@@ -22,7 +23,12 @@ public:
         None = 0x00,
         RotationOnStartup = 0x01,
         RotationDaily = 0x02,
-        Compression = 0x04
+        Compression = 0x04,
+        TimeIndex = 0x08, // Writes a time index next to each file, see timeindex.h
+        BlockCompression = 0x10, // Compression with a block index for random access, implies
+                                 // TimeIndex, see seekablegzip.h
+        TermIndex = 0x20 // Writes a bloom filter and term index of each rotated file, implies
+                         // TimeIndex, see termindex.h
     };
 
     Q_DECLARE_FLAGS(Options, Option)
@@ -34,6 +40,22 @@ public:
     ~RotatingFileSink() override;
 
     void send(const LogMessage &lmsg) override;
+    bool flush() override;
+
+    // An index entry is written at most every intervalBytes of the log or intervalMsecs of message
+    // time, only used with the TimeIndex option
+    void setTimeIndexInterval(int intervalBytes, int intervalMsecs);
+
+    // Uncompressed size of the blocks written with the BlockCompression option
+    void setCompressionBlockSize(int blockSize);
+
+protected:
+    RotatingFileSink(const QString &path, int maxFileSize, int maxFileCount, Options options,
+                     QIODevice::OpenMode openMode);
+
+    // True if encode() writes binary log records, whose message and attributes go to the term
+    // index. Otherwise the tokens of the written bytes are indexed, as a search reads them.
+    virtual bool writesBinaryLog() const;
 
 private:
     class RotatingFileSinkPrivate;
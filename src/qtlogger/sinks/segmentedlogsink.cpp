@@ -0,0 +1,260 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "segmentedlogsink.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <algorithm>
+#include <iostream>
+
+#include "../binarylog.h"
+#include "../segmentedlog.h"
+
+namespace QtLogger {
+
+class SegmentedLogSink::SegmentedLogSinkPrivate
+{
+public:
+    // Continues the newest segment after its last complete record, or starts the first one
+    bool open()
+    {
+        if (!QDir().mkpath(path)) {
+            error = QStringLiteral("Can't create directory: %1").arg(path);
+            return false;
+        }
+
+        const auto bases = SegmentedLog::segments(path);
+        if (bases.isEmpty())
+            return startSegment(0);
+
+        const auto base = bases.last();
+        file.setFileName(SegmentedLog::segmentFileName(path, base));
+        if (!file.open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+            error = file.errorString();
+            return false;
+        }
+
+        // Written before the header
+        if (file.size() < SegmentedLog::HeaderSize) {
+            file.close();
+            return startSegment(base);
+        }
+
+        const auto header = file.read(SegmentedLog::HeaderSize);
+        if (!header.startsWith(SegmentedLog::Magic)
+            || static_cast<quint8>(header.at(4)) != SegmentedLog::Version) {
+            error = QStringLiteral("Invalid segment: %1").arg(file.fileName());
+            file.close();
+            return false;
+        }
+
+        const auto size = file.size();
+        auto pos = static_cast<qint64>(SegmentedLog::HeaderSize);
+        auto count = 0;
+
+        char number[SegmentedLog::RecordHeaderSize];
+        while (size - pos >= SegmentedLog::RecordHeaderSize && file.seek(pos)
+               && file.read(number, sizeof(number)) == sizeof(number)) {
+            const auto recordSize = qFromLittleEndian<quint32>(number);
+            if (recordSize == 0 || size - pos - SegmentedLog::RecordHeaderSize < recordSize)
+                break;
+
+            pos += SegmentedLog::RecordHeaderSize + recordSize;
+            ++count;
+        }
+
+        // A record cut short by a crash
+        if (pos < size) {
+            std::cerr << "SegmentedLogSink: Removing incomplete record at " << pos << " of "
+                      << file.fileName().toStdString() << std::endl;
+            file.resize(pos);
+        }
+
+        file.seek(pos);
+        segmentBase = base;
+        nextOffset = base + count;
+
+        return true;
+    }
+
+    bool startSegment(qint64 base)
+    {
+        file.close();
+        file.setFileName(SegmentedLog::segmentFileName(path, base));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered)) {
+            error = file.errorString();
+            std::cerr << "SegmentedLogSink: Can't open segment: " << file.fileName().toStdString()
+                      << " error: " << error.toStdString() << std::endl;
+            return false;
+        }
+
+        auto header = QByteArray(SegmentedLog::Magic, 4);
+        header.append(static_cast<char>(SegmentedLog::Version));
+        header.append(3, '\0');
+
+        char number[8];
+        qToLittleEndian(base, number);
+        header.append(number, 8);
+
+        if (file.write(header) != header.size()) {
+            error = file.errorString();
+            file.close();
+            return false;
+        }
+
+        segmentBase = base;
+        nextOffset = base;
+
+        return true;
+    }
+
+    QString path;
+    qint64 segmentSize;
+    qint64 maxSize;
+
+    QFile file;
+    QString error;
+    qint64 segmentBase = 0;
+    qint64 nextOffset = 0;
+
+    BinaryLogWriter writer;
+};
+
+QTLOGGER_DECL_SPEC
+SegmentedLogSink::SegmentedLogSink(const QString &path, qint64 segmentSize, qint64 maxSize)
+    : d(new SegmentedLogSinkPrivate)
+{
+    d->path = path;
+    d->segmentSize = qMax<qint64>(segmentSize, SegmentedLog::HeaderSize + 1);
+    d->maxSize = qMax<qint64>(maxSize, 0);
+
+    if (!d->open()) {
+        std::cerr << "SegmentedLogSink: Can't open log: " << path.toStdString()
+                  << " error: " << d->error.toStdString() << std::endl;
+        return;
+    }
+
+    removeOldSegments();
+}
+
+QTLOGGER_DECL_SPEC
+SegmentedLogSink::~SegmentedLogSink() = default;
+
+QTLOGGER_DECL_SPEC
+void SegmentedLogSink::send(const LogMessage &lmsg)
+{
+    if (!d->file.isOpen())
+        return;
+
+    // Every record is a session of its own, so it can be decoded from any offset
+    d->writer.reset();
+    const auto payload = d->writer.encode(lmsg);
+
+    const auto recordSize = SegmentedLog::RecordHeaderSize + payload.size();
+    if (d->file.pos() > SegmentedLog::HeaderSize && d->file.pos() + recordSize > d->segmentSize) {
+        if (!d->startSegment(d->nextOffset))
+            return;
+        removeOldSegments();
+    }
+
+    QByteArray record;
+    record.reserve(recordSize);
+
+    char number[SegmentedLog::RecordHeaderSize];
+    qToLittleEndian(static_cast<quint32>(payload.size()), number);
+    record.append(number, sizeof(number));
+    record.append(payload);
+
+    const auto pos = d->file.pos();
+    if (d->file.write(record) != record.size()) {
+        std::cerr << "SegmentedLogSink: Can't write record: " << d->file.errorString().toStdString()
+                  << std::endl;
+
+        // Cut back to the last complete record, so the offsets stay consistent
+        d->file.resize(pos);
+        d->file.seek(pos);
+        return;
+    }
+
+    ++d->nextOffset;
+}
+
+QTLOGGER_DECL_SPEC
+bool SegmentedLogSink::isValid() const
+{
+    return d->file.isOpen();
+}
+
+QTLOGGER_DECL_SPEC
+QString SegmentedLogSink::errorString() const
+{
+    return d->error;
+}
+
+QTLOGGER_DECL_SPEC
+QString SegmentedLogSink::path() const
+{
+    return d->path;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SegmentedLogSink::segmentSize() const
+{
+    return d->segmentSize;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SegmentedLogSink::maxSize() const
+{
+    return d->maxSize;
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SegmentedLogSink::nextOffset() const
+{
+    return d->nextOffset;
+}
+
+QTLOGGER_DECL_SPEC
+void SegmentedLogSink::removeOldSegments()
+{
+    auto bases = SegmentedLog::segments(d->path);
+
+    // The current segment is never removed
+    bases.removeAll(d->segmentBase);
+
+    const auto committed = SegmentedLog::committedOffsets(d->path);
+    if (!committed.isEmpty()) {
+        const auto slowest = *std::min_element(committed.cbegin(), committed.cend());
+
+        // A segment is read when the next one starts at or before the slowest cursor
+        while (!bases.isEmpty()) {
+            const auto end = bases.size() > 1 ? bases.at(1) : d->segmentBase;
+            if (end > slowest)
+                break;
+
+            QFile::remove(SegmentedLog::segmentFileName(d->path, bases.takeFirst()));
+        }
+    }
+
+    if (d->maxSize == 0)
+        return;
+
+    auto totalSize = d->file.size();
+    QList<qint64> sizes;
+    for (const auto base : std::as_const(bases)) {
+        sizes.append(QFileInfo(SegmentedLog::segmentFileName(d->path, base)).size());
+        totalSize += sizes.last();
+    }
+
+    while (!bases.isEmpty() && totalSize > d->maxSize) {
+        totalSize -= sizes.takeFirst();
+        QFile::remove(SegmentedLog::segmentFileName(d->path, bases.takeFirst()));
+    }
+}
+
+} // namespace QtLogger
@@ -0,0 +1,57 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "../logger_global.h"
+#include "../sink.h"
+
+namespace QtLogger {
+
+// Appends messages to a segmented log in a directory (see segmentedlog.h), followed by local
+// agents with SegmentedLogConsumer.
+//
+// Every message is a record with its own offset, written with a single write, so it survives a
+// crash of the application and consumers see it right away. When a segment reaches segmentSize a
+// new one is started, and the segments all consumers have committed are removed. With maxSize, the
+// oldest segments are removed when the log grows larger, even if a slow consumer hasn't read them.
+// There must be a single writer per directory, which the logger guarantees for the sinks of one
+// pipeline.
+class QTLOGGER_EXPORT SegmentedLogSink : public Sink
+{
+public:
+    static constexpr qint64 DefaultSegmentSize = 16 * 1024 * 1024;
+
+    explicit SegmentedLogSink(const QString &path, qint64 segmentSize = DefaultSegmentSize,
+                              qint64 maxSize = 0);
+    ~SegmentedLogSink() override;
+
+    void send(const LogMessage &lmsg) override;
+
+    // False if the directory or the current segment can't be written
+    bool isValid() const;
+    QString errorString() const;
+
+    QString path() const;
+    qint64 segmentSize() const;
+    qint64 maxSize() const;
+
+    // Offset of the next message
+    qint64 nextOffset() const;
+
+    // Removes the segments read by all consumers, and the oldest ones beyond the maximum size.
+    // Called whenever a new segment is started.
+    void removeOldSegments();
+
+private:
+    class SegmentedLogSinkPrivate;
+    QScopedPointer<SegmentedLogSinkPrivate> d;
+    Q_DISABLE_COPY(SegmentedLogSink)
+};
+
+using SegmentedLogSinkPtr = QSharedPointer<SegmentedLogSink>;
+
+} // namespace QtLogger
@@ -0,0 +1,269 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "sharedmemorysink.h"
+
+#ifndef QT_NO_SHAREDMEMORY
+
+#include <QCoreApplication>
+#include <QSharedMemory>
+
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#if defined(Q_OS_WIN)
+#    include <qt_windows.h>
+#else
+#    include <cerrno>
+#    include <signal.h>
+#endif
+
+#include "../binarylog.h"
+#include "../sharedmemoryring.h"
+
+namespace QtLogger {
+
+namespace {
+
+quint64 writerPid(quint64 token)
+{
+    return token >> 32;
+}
+
+bool isProcessAlive(quint64 pid)
+{
+#if defined(Q_OS_WIN)
+    const auto process = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    if (!process)
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    const auto alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+} // namespace
+
+class SharedMemorySink::SharedMemorySinkPrivate
+{
+public:
+    SharedMemorySinkPrivate(const QString &key, int slotCount, int slotSize)
+        : memory(key),
+          slotCount(qMax(slotCount, 1)),
+          // Slots are 8-byte aligned for the atomic state
+          slotSize((qMax(slotSize, SharedMemoryRing::SlotHeaderSize + 8) + 7) & ~7)
+    {
+        const auto size = SharedMemoryRing::segmentSize(this->slotCount, this->slotSize);
+
+        bool created = memory.create(static_cast<int>(size));
+        if (!created) {
+            if (memory.error() != QSharedMemory::AlreadyExists || !memory.attach()) {
+                error = memory.errorString();
+                std::cerr << "SharedMemorySink: " << qPrintable(error) << std::endl;
+                return;
+            }
+            if (memory.size() < size) {
+                error = QStringLiteral("Existing shared memory segment is too small");
+                std::cerr << "SharedMemorySink: " << qPrintable(error) << std::endl;
+                memory.detach();
+                return;
+            }
+        }
+
+        base = static_cast<char *>(memory.data());
+        header = reinterpret_cast<SharedMemoryRing::Header *>(base);
+
+        // Writers starting at the same time initialize the segment one after another
+        memory.lock();
+
+        const auto isRing = !created && header->magic == SharedMemoryRing::Magic
+                && header->version == SharedMemoryRing::Version;
+
+        if (isRing && !claim()) {
+            error = QStringLiteral("Shared memory ring is in use by another writer (pid %1)")
+                            .arg(writerPid(header->writer.load(std::memory_order_relaxed)));
+            std::cerr << "SharedMemorySink: " << qPrintable(error) << std::endl;
+            memory.unlock();
+            memory.detach();
+            header = nullptr;
+            return;
+        }
+
+        // The ring of a previous writer with the same layout is continued, so that its readers
+        // keep their positions
+        if (!isRing || header->slotCount != static_cast<quint32>(this->slotCount)
+            || header->slotSize != static_cast<quint32>(this->slotSize)) {
+            std::memset(base, 0, static_cast<size_t>(size));
+            header = new (base) SharedMemoryRing::Header();
+            header->slotCount = static_cast<quint32>(this->slotCount);
+            header->slotSize = static_cast<quint32>(this->slotSize);
+            header->writer.store(token, std::memory_order_relaxed);
+            header->version = SharedMemoryRing::Version;
+            header->magic = SharedMemoryRing::Magic;
+        }
+
+        memory.unlock();
+    }
+
+    ~SharedMemorySinkPrivate()
+    {
+        if (!header)
+            return;
+
+        auto expected = token;
+        header->writer.compare_exchange_strong(expected, 0, std::memory_order_release,
+                                               std::memory_order_relaxed);
+    }
+
+    // Sinks created in this process, the lower half of their writer tokens
+    static std::atomic<quint32> &writerCount()
+    {
+        static std::atomic<quint32> count { 0 };
+        return count;
+    }
+
+    static bool isWriterAlive(quint64 owner)
+    {
+        const auto pid = writerPid(owner);
+
+        // A token of this process that wasn't issued yet was left by an earlier process with the
+        // same id, the sinks of this process clear their tokens when destroyed
+        if (pid == static_cast<quint64>(QCoreApplication::applicationPid()))
+            return (owner & 0xffffffff) <= writerCount().load(std::memory_order_relaxed);
+
+        return isProcessAlive(pid);
+    }
+
+    // Takes over the ring if it has no writer or its writer is gone
+    bool claim()
+    {
+        auto owner = header->writer.load(std::memory_order_acquire);
+        while (owner == 0 || !isWriterAlive(owner)) {
+            if (header->writer.compare_exchange_weak(owner, token, std::memory_order_acq_rel,
+                                                     std::memory_order_acquire))
+                return true;
+        }
+        return false;
+    }
+
+    void write(const QByteArray &data)
+    {
+        const auto payloadSize = static_cast<quint32>(slotSize - SharedMemoryRing::SlotHeaderSize);
+        const auto size = static_cast<quint32>(data.size());
+        const auto slots = qMax<quint32>(1, (size + payloadSize - 1) / payloadSize);
+
+        if (slots > static_cast<quint32>(slotCount)) {
+            header->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Only this writer changes head and nextRecord
+        const auto head = header->head.load(std::memory_order_relaxed);
+        const auto record = header->nextRecord.load(std::memory_order_relaxed);
+
+        for (quint32 i = 0; i < slots; ++i) {
+            const auto n = head + i;
+            auto *slot = slotAt(n);
+
+            slot->state.store(2 * n + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            slot->record = record;
+            slot->size = size;
+            slot->slots = i == 0 ? slots : 0;
+
+            const auto offset = i * payloadSize;
+            std::memcpy(reinterpret_cast<char *>(slot) + SharedMemoryRing::SlotHeaderSize,
+                        data.constData() + offset, qMin(payloadSize, size - offset));
+
+            slot->state.store(2 * n + 2, std::memory_order_release);
+        }
+
+        header->nextRecord.store(record + 1, std::memory_order_relaxed);
+        header->head.store(head + slots, std::memory_order_release);
+    }
+
+    SharedMemoryRing::Slot *slotAt(quint64 n) const
+    {
+        return reinterpret_cast<SharedMemoryRing::Slot *>(
+                base + SharedMemoryRing::HeaderSize
+                + (n % static_cast<quint64>(slotCount)) * static_cast<quint64>(slotSize));
+    }
+
+    QSharedMemory memory;
+    QString error;
+
+    const quint64 token = static_cast<quint64>(QCoreApplication::applicationPid()) << 32
+            | (writerCount().fetch_add(1, std::memory_order_relaxed) + 1);
+
+    const int slotCount;
+    const int slotSize;
+
+    char *base = nullptr;
+    SharedMemoryRing::Header *header = nullptr;
+
+    BinaryLogWriter writer;
+};
+
+QTLOGGER_DECL_SPEC
+SharedMemorySink::SharedMemorySink(const QString &key, int slotCount, int slotSize)
+    : d(new SharedMemorySinkPrivate(key, slotCount, slotSize))
+{
+}
+
+QTLOGGER_DECL_SPEC
+SharedMemorySink::~SharedMemorySink() = default;
+
+QTLOGGER_DECL_SPEC
+void SharedMemorySink::send(const LogMessage &lmsg)
+{
+    if (!d->header)
+        return;
+
+    // Every record is a session of its own, so it can be decoded after older records were lost
+    d->writer.reset();
+    d->write(d->writer.encode(lmsg));
+}
+
+QTLOGGER_DECL_SPEC
+bool SharedMemorySink::isValid() const
+{
+    return d->header != nullptr;
+}
+
+QTLOGGER_DECL_SPEC
+QString SharedMemorySink::errorString() const
+{
+    return d->error;
+}
+
+QTLOGGER_DECL_SPEC
+QString SharedMemorySink::key() const
+{
+    return d->memory.key();
+}
+
+QTLOGGER_DECL_SPEC
+int SharedMemorySink::slotCount() const
+{
+    return d->slotCount;
+}
+
+QTLOGGER_DECL_SPEC
+int SharedMemorySink::slotSize() const
+{
+    return d->slotSize;
+}
+
+QTLOGGER_DECL_SPEC
+quint64 SharedMemorySink::dropped() const
+{
+    return d->header ? d->header->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+} // namespace QtLogger
+
+#endif // QT_NO_SHAREDMEMORY
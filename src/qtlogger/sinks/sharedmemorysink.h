@@ -0,0 +1,58 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QtGlobal>
+
+#ifndef QT_NO_SHAREDMEMORY
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "../logger_global.h"
+#include "../sink.h"
+
+namespace QtLogger {
+
+// Writes messages into a shared memory ring buffer (see sharedmemoryring.h) for a reader in another
+// process that formats and writes them, e.g. with SharedMemoryReader or qtlogger-cat --shm.
+//
+// After the segment is created in the constructor, sending a message only encodes it and copies it
+// into the ring, without system calls or locks. The writer never waits for readers: slow readers
+// lose the oldest messages and see them as overruns. There is a single writer per segment: a sink
+// whose key is in use by a live writer, in this or in another process, is not valid.
+class QTLOGGER_EXPORT SharedMemorySink : public Sink
+{
+public:
+    static constexpr int DefaultSlotCount = 8192;
+    static constexpr int DefaultSlotSize = 512;
+
+    explicit SharedMemorySink(const QString &key, int slotCount = DefaultSlotCount,
+                              int slotSize = DefaultSlotSize);
+    ~SharedMemorySink() override;
+
+    void send(const LogMessage &lmsg) override;
+
+    // False if the shared memory segment couldn't be created
+    bool isValid() const;
+    QString errorString() const;
+
+    QString key() const;
+    int slotCount() const;
+    int slotSize() const;
+
+    // Messages larger than the whole ring, not written
+    quint64 dropped() const;
+
+private:
+    class SharedMemorySinkPrivate;
+    QScopedPointer<SharedMemorySinkPrivate> d;
+    Q_DISABLE_COPY(SharedMemorySink)
+};
+
+using SharedMemorySinkPtr = QSharedPointer<SharedMemorySink>;
+
+} // namespace QtLogger
+
+#endif // QT_NO_SHAREDMEMORY
@@ -0,0 +1,275 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "sinkthread.h"
+
+#include <QCoreApplication>
+#include <QEvent>
+#include <QList>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#    include <QSemaphore>
+#    include <QThread>
+#    include <QWaitCondition>
+#endif
+
+namespace QtLogger {
+
+#ifndef QTLOGGER_NO_THREAD
+namespace {
+
+QEvent::Type sinkThreadEventType()
+{
+    static const auto type = static_cast<QEvent::Type>(QEvent::registerEventType());
+    return type;
+}
+
+class SinkThreadContext : public QObject
+{
+public:
+    explicit SinkThreadContext(std::function<void()> drain) : m_drain(std::move(drain)) { }
+
+protected:
+    void customEvent(QEvent *event) override
+    {
+        if (event->type() == sinkThreadEventType())
+            m_drain();
+    }
+
+private:
+    std::function<void()> m_drain;
+};
+
+class SinkThreadRunner : public QThread
+{
+public:
+    explicit SinkThreadRunner(std::function<void()> body) : m_body(std::move(body)) { }
+
+    int loop() { return exec(); }
+
+protected:
+    void run() override { m_body(); }
+
+private:
+    std::function<void()> m_body;
+};
+
+} // namespace
+#endif
+
+class SinkThread::SinkThreadPrivate
+{
+public:
+    QObject *context = nullptr;
+
+#ifndef QTLOGGER_NO_THREAD
+    // Queues the function and starts the thread for the first one, fails once it is stopped
+    bool enqueue(std::function<void()> &function)
+    {
+        QMutexLocker locker(&mutex);
+
+        if (!thread)
+            start();
+
+        if (!running)
+            return false;
+
+        functions.append(std::move(function));
+
+        // One event wakes the event loop for all functions queued until they are run
+        if (!eventLoop) {
+            wakeUp.wakeOne();
+        } else if (!scheduled) {
+            scheduled = true;
+            QCoreApplication::postEvent(context, new QEvent(sinkThreadEventType()));
+        }
+
+        return true;
+    }
+
+    // Called with the mutex locked, returns when the context is created in the thread
+    void start()
+    {
+        running = true;
+        attach();
+
+        thread = new SinkThreadRunner([this] { work(); });
+        thread->setObjectName(name);
+        thread->start();
+        started.acquire();
+    }
+
+    // Called with the mutex locked. Events aren't delivered without the application, so until it
+    // exists and after it is destroyed the thread waits for the functions instead.
+    void attach()
+    {
+        if (!qApp || detached)
+            return;
+
+        eventLoop = true;
+        appDestroyed = QObject::connect(qApp, &QObject::destroyed, [this] {
+            {
+                QMutexLocker locker(&mutex);
+                eventLoop = false;
+                detached = true;
+                scheduled = false;
+                wakeUp.wakeOne();
+            }
+            thread->quit();
+        });
+    }
+
+    // The body of the thread
+    void work()
+    {
+        context = new SinkThreadContext([this] { drain(); });
+        started.release();
+
+        for (;;) {
+            bool loop = false;
+            {
+                QMutexLocker locker(&mutex);
+                while (running && !eventLoop && functions.isEmpty()) {
+                    wakeUp.wait(&mutex);
+
+                    // The application may have been created after the thread was started
+                    if (running)
+                        attach();
+                }
+
+                // The functions queued before stop() are still run
+                if (!running && functions.isEmpty())
+                    break;
+
+                loop = running && eventLoop;
+                if (loop && !scheduled && !functions.isEmpty()) {
+                    scheduled = true;
+                    QCoreApplication::postEvent(context, new QEvent(sinkThreadEventType()));
+                }
+            }
+
+            // Returns when the thread is stopped or the application is destroyed
+            if (loop)
+                static_cast<SinkThreadRunner *>(thread)->loop();
+            else
+                drain();
+        }
+
+        // The objects of the sink are destroyed in the thread they belong to
+        delete context;
+        context = nullptr;
+    }
+
+    void drain()
+    {
+        QList<std::function<void()>> batch;
+        {
+            QMutexLocker locker(&mutex);
+            batch.swap(functions);
+            scheduled = false;
+        }
+
+        for (const auto &function : std::as_const(batch)) {
+            function();
+        }
+    }
+
+    QString name;
+    QThread *thread = nullptr;
+    QSemaphore started;
+    QMetaObject::Connection appDestroyed;
+
+    QMutex mutex;
+    QWaitCondition wakeUp;
+    QList<std::function<void()>> functions;
+    bool eventLoop = false;
+    bool detached = false;
+    bool scheduled = false;
+    bool running = false;
+#endif
+};
+
+QTLOGGER_DECL_SPEC
+SinkThread::SinkThread(const QString &name) : d(new SinkThreadPrivate)
+{
+#ifndef QTLOGGER_NO_THREAD
+    d->name = name;
+#else
+    Q_UNUSED(name)
+    d->context = new QObject();
+#endif
+}
+
+QTLOGGER_DECL_SPEC
+SinkThread::~SinkThread()
+{
+    stop();
+
+#ifndef QTLOGGER_NO_THREAD
+    delete d->thread;
+#else
+    delete d->context;
+#endif
+}
+
+QTLOGGER_DECL_SPEC
+QObject *SinkThread::context() const
+{
+    return d->context;
+}
+
+QTLOGGER_DECL_SPEC
+void SinkThread::post(std::function<void()> function)
+{
+#ifndef QTLOGGER_NO_THREAD
+    d->enqueue(function);
+#else
+    function();
+#endif
+}
+
+QTLOGGER_DECL_SPEC
+void SinkThread::run(const std::function<void()> &function)
+{
+#ifndef QTLOGGER_NO_THREAD
+    if (QThread::currentThread() == d->thread) {
+        function();
+        return;
+    }
+
+    QSemaphore done;
+    std::function<void()> task = [&function, &done] {
+        function();
+        done.release();
+    };
+
+    if (d->enqueue(task))
+        done.acquire();
+#else
+    function();
+#endif
+}
+
+QTLOGGER_DECL_SPEC
+void SinkThread::stop()
+{
+#ifndef QTLOGGER_NO_THREAD
+    {
+        QMutexLocker locker(&d->mutex);
+        if (!d->running || QThread::currentThread() == d->thread)
+            return;
+
+        d->running = false;
+        d->wakeUp.wakeOne();
+    }
+
+    QObject::disconnect(d->appDestroyed);
+
+    d->thread->quit();
+    d->thread->wait();
+#endif
+}
+
+} // namespace QtLogger
@@ -0,0 +1,54 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <functional>
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QString>
+
+#include "../logger_global.h"
+
+namespace QtLogger {
+
+// The thread of a sink that owns its sockets, timers or database connection.
+//
+// A sink is called from the thread of an async logger, and with a synchronous logger from every
+// thread that logs. The objects of the sink are created and used only by the functions run in its
+// own thread, so they never move between the sending threads. Settings used by the functions are
+// changed with run(), the rest of the state shared with the sending threads, such as a queue they
+// fill, is guarded by a mutex of the sink. Functions are run in the order they were posted, the
+// ones posted within one event loop iteration of the thread are run in a row.
+//
+// The thread is started by the first function and runs an event loop while the application exists,
+// before and after that it only runs the functions. It is stopped only by stop() or the
+// destructor, so the messages the logger processes while the application quits still reach the
+// sink: the pending functions are completed and the objects are destroyed in the thread. With
+// QTLOGGER_NO_THREAD all functions run directly.
+class QTLOGGER_EXPORT SinkThread
+{
+public:
+    explicit SinkThread(const QString &name);
+    ~SinkThread();
+
+    // Parent of the objects of the sink, only valid in the functions
+    QObject *context() const;
+
+    // Queues the function to the thread
+    void post(std::function<void()> function);
+
+    // Runs the function in the thread and waits for it to complete
+    void run(const std::function<void()> &function);
+
+    // Completes the pending functions and stops the thread, later functions are dropped
+    void stop();
+
+private:
+    class SinkThreadPrivate;
+    QScopedPointer<SinkThreadPrivate> d;
+    Q_DISABLE_COPY(SinkThread)
+};
+
+} // namespace QtLogger
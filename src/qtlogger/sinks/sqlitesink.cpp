@@ -0,0 +1,446 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifdef QTLOGGER_SQL
+
+#include "sqlitesink.h"
+
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThread>
+#include <QTimer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+#include <chrono>
+#include <iostream>
+
+#include "sinkthread.h"
+
+namespace QtLogger {
+
+namespace {
+
+// Freed pages are returned to the file system at most once a minute, pages freed in between are
+// reused by new rows
+constexpr int SqliteVacuumInterval = 60000; // ms
+
+const char *const SqliteSchema[] = {
+    "CREATE TABLE IF NOT EXISTS logs ("
+    "id INTEGER PRIMARY KEY, "
+    "time INTEGER NOT NULL, "
+    "level TEXT NOT NULL, "
+    "category TEXT, "
+    "file TEXT, "
+    "line INTEGER, "
+    "function TEXT, "
+    "thread INTEGER, "
+    "message TEXT, "
+    "attributes TEXT)",
+    "CREATE INDEX IF NOT EXISTS logs_time ON logs (time)",
+    "CREATE INDEX IF NOT EXISTS logs_level ON logs (level)",
+    "CREATE INDEX IF NOT EXISTS logs_category ON logs (category)",
+};
+
+QVariant sqliteText(const char *str)
+{
+    return str ? QVariant(QString::fromUtf8(str)) : QVariant();
+}
+
+} // namespace
+
+class SqliteSink::SqliteSinkPrivate
+{
+public:
+    enum State { Closed, Open, Failed };
+
+    explicit SqliteSinkPrivate(const QString &fileName) : fileName(fileName) { }
+
+    ~SqliteSinkPrivate()
+    {
+        thread.run([this] {
+            commit();
+            close();
+        });
+        thread.stop();
+    }
+
+    // Rows are queued in the calling thread, a complete batch is committed before send() returns
+    void send(const LogMessage &lmsg)
+    {
+        if (!ensureDatabase())
+            return;
+
+        bool commitNow = false;
+        bool scheduleTimer = false;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            const auto now = std::chrono::steady_clock::now();
+            if (pending.isEmpty())
+                batchStart = now;
+
+            pending.append(lmsg);
+
+            commitNow = pending.size() >= batchSize
+                    || now - batchStart >= std::chrono::milliseconds(batchInterval);
+
+            scheduleTimer = !commitNow && !timerScheduled;
+            if (scheduleTimer)
+                timerScheduled = true;
+        }
+
+        if (commitNow)
+            thread.run([this] { commit(); });
+        else if (scheduleTimer)
+            thread.post([this] { startTimer(); });
+    }
+
+    bool flush()
+    {
+        bool result = true;
+        thread.run([this, &result] { result = commit(); });
+        return result;
+    }
+
+    QString fileName;
+    int batchSize = DefaultBatchSize;
+    int batchInterval = DefaultBatchInterval;
+    qint64 maxRowCount = 0;
+    int maxAge = 0;
+
+    QAtomicInt state { Closed };
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    SinkThread thread { QStringLiteral("SqliteSink") };
+
+private:
+    // The database is opened once in the thread of the sink, the calling thread waits for it
+    bool ensureDatabase()
+    {
+        const auto current = state.loadAcquire();
+        if (current != Closed)
+            return current == Open;
+
+        thread.run([this] {
+            if (state.loadAcquire() != Closed)
+                return;
+
+            if (open()) {
+                state.storeRelease(Open);
+            } else {
+                close();
+                state.storeRelease(Failed);
+            }
+        });
+
+        return state.loadAcquire() == Open;
+    }
+
+    // The connection, the statement and the timer are used only in the thread of the sink
+    bool commit()
+    {
+        QList<LogMessage> rows;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            rows.swap(pending);
+        }
+
+        if (rows.isEmpty() || !insertQuery)
+            return true;
+
+        if (timer)
+            timer->stop();
+
+        if (!db.transaction()) {
+            printError("Failed to begin transaction", db.lastError());
+            return false;
+        }
+
+        for (const auto &lmsg : std::as_const(rows)) {
+            const auto attrs = lmsg.attributes();
+
+            insertQuery->bindValue(0, lmsg.time().toMSecsSinceEpoch());
+            insertQuery->bindValue(1, qtMsgTypeToString(lmsg.type()));
+            insertQuery->bindValue(2, sqliteText(lmsg.category()));
+            insertQuery->bindValue(3, sqliteText(lmsg.file()));
+            insertQuery->bindValue(4, lmsg.file() ? QVariant(lmsg.line()) : QVariant());
+            insertQuery->bindValue(5, sqliteText(lmsg.function()));
+            insertQuery->bindValue(6, static_cast<qint64>(lmsg.threadId()));
+            insertQuery->bindValue(7, lmsg.message());
+            insertQuery->bindValue(
+                    8,
+                    attrs.isEmpty()
+                            ? QVariant()
+                            : QVariant(QString::fromUtf8(
+                                      QJsonDocument(QJsonObject::fromVariantHash(attrs))
+                                              .toJson(QJsonDocument::Compact))));
+
+            if (!insertQuery->exec()) {
+                printError("Failed to insert row", insertQuery->lastError());
+                db.rollback();
+                return false;
+            }
+        }
+
+        const auto deleted = applyRetention();
+
+        if (!db.commit()) {
+            printError("Failed to commit transaction", db.lastError());
+            db.rollback();
+            return false;
+        }
+
+        deletedSinceVacuum += deleted;
+        if (deletedSinceVacuum > 0 && vacuumTimer.hasExpired(SqliteVacuumInterval)) {
+            QSqlQuery(db).exec(QStringLiteral("PRAGMA incremental_vacuum"));
+            deletedSinceVacuum = 0;
+            vacuumTimer.restart();
+        }
+
+        return true;
+    }
+
+    // An incomplete batch is committed by the timer
+    void startTimer()
+    {
+        int interval = 0;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            timerScheduled = false;
+            if (pending.isEmpty())
+                return;
+            interval = batchInterval;
+        }
+
+        if (timer && !timer->isActive())
+            timer->start(interval);
+    }
+
+    bool open()
+    {
+        static QAtomicInt counter;
+
+        if (!QSqlDatabase::isDriverAvailable(QStringLiteral("QSQLITE"))) {
+            std::cerr << "SqliteSink: QSQLITE driver is not available" << std::endl;
+            return false;
+        }
+
+        connectionName = QStringLiteral("qtlogger-sqlite-%1").arg(counter.fetchAndAddRelaxed(1));
+        db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connectionName);
+        db.setDatabaseName(fileName);
+
+        if (!db.open()) {
+            printError("Can't open database", db.lastError());
+            return false;
+        }
+
+        QSqlQuery query(db);
+
+        // Auto-vacuum can only be enabled before the first table is created
+        query.exec(QStringLiteral("PRAGMA auto_vacuum = INCREMENTAL"));
+        query.exec(QStringLiteral("PRAGMA journal_mode = WAL"));
+        query.exec(QStringLiteral("PRAGMA synchronous = NORMAL"));
+
+        for (const auto statement : SqliteSchema) {
+            if (!query.exec(QString::fromLatin1(statement))) {
+                printError("Can't create table", query.lastError());
+                return false;
+            }
+        }
+
+        insertQuery.reset(new QSqlQuery(db));
+        if (!insertQuery->prepare(QStringLiteral(
+                    "INSERT INTO logs (time, level, category, file, line, function, thread, "
+                    "message, attributes) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)"))) {
+            printError("Can't prepare statement", insertQuery->lastError());
+            return false;
+        }
+
+        timer = new QTimer(thread.context());
+        timer->setSingleShot(true);
+        QObject::connect(timer.data(), &QTimer::timeout, timer.data(), [this] { commit(); });
+
+        vacuumTimer.start();
+
+        return true;
+    }
+
+    void close()
+    {
+        if (timer) {
+            timer->disconnect();
+            if (timer->thread() == QThread::currentThread())
+                delete timer.data();
+            else
+                timer->deleteLater();
+        }
+        timer = nullptr;
+
+        insertQuery.reset();
+
+        if (!connectionName.isEmpty()) {
+            db.close();
+            db = QSqlDatabase();
+            QSqlDatabase::removeDatabase(connectionName);
+            connectionName.clear();
+        }
+
+        state.storeRelease(Closed);
+    }
+
+    // Runs in the transaction of the batch, returns the number of deleted rows
+    int applyRetention()
+    {
+        int deleted = 0;
+        QSqlQuery query(db);
+
+        // Row ids grow with every insert, so the newest maxRowCount rows have the largest ids
+        if (maxRowCount > 0) {
+            query.prepare(QStringLiteral(
+                    "DELETE FROM logs WHERE id <= (SELECT MAX(id) FROM logs) - ?"));
+            query.addBindValue(maxRowCount);
+            if (query.exec())
+                deleted += query.numRowsAffected();
+        }
+
+        if (maxAge > 0) {
+            query.prepare(QStringLiteral("DELETE FROM logs WHERE time < ?"));
+            query.addBindValue(QDateTime::currentMSecsSinceEpoch()
+                               - static_cast<qint64>(maxAge) * 1000);
+            if (query.exec())
+                deleted += query.numRowsAffected();
+        }
+
+        return deleted;
+    }
+
+    void printError(const char *what, const QSqlError &error) const
+    {
+        std::cerr << "SqliteSink: " << what << ": " << fileName.toStdString()
+                  << " error: " << error.text().toStdString() << std::endl;
+    }
+
+    QString connectionName;
+    QSqlDatabase db;
+    QScopedPointer<QSqlQuery> insertQuery;
+    QPointer<QTimer> timer;
+
+    QList<LogMessage> pending;
+    std::chrono::steady_clock::time_point batchStart;
+    bool timerScheduled = false;
+
+    QElapsedTimer vacuumTimer;
+    qint64 deletedSinceVacuum = 0;
+};
+
+QTLOGGER_DECL_SPEC
+SqliteSink::SqliteSink(const QString &fileName) : d(new SqliteSinkPrivate(fileName)) { }
+
+QTLOGGER_DECL_SPEC
+SqliteSink::~SqliteSink() = default;
+
+QTLOGGER_DECL_SPEC
+void SqliteSink::send(const LogMessage &lmsg)
+{
+    d->send(lmsg);
+}
+
+QTLOGGER_DECL_SPEC
+bool SqliteSink::flush()
+{
+    return d->flush();
+}
+
+QTLOGGER_DECL_SPEC
+QString SqliteSink::fileName() const
+{
+    return d->fileName;
+}
+
+QTLOGGER_DECL_SPEC
+bool SqliteSink::isOpen() const
+{
+    return d->state.loadAcquire() == SqliteSinkPrivate::Open;
+}
+
+QTLOGGER_DECL_SPEC
+int SqliteSink::batchSize() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->batchSize;
+}
+
+QTLOGGER_DECL_SPEC
+void SqliteSink::setBatchSize(int batchSize)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->batchSize = qMax(batchSize, 1);
+}
+
+QTLOGGER_DECL_SPEC
+int SqliteSink::batchInterval() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->batchInterval;
+}
+
+QTLOGGER_DECL_SPEC
+void SqliteSink::setBatchInterval(int msecs)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->batchInterval = qMax(msecs, 0);
+}
+
+QTLOGGER_DECL_SPEC
+qint64 SqliteSink::maxRowCount() const
+{
+    return d->maxRowCount;
+}
+
+QTLOGGER_DECL_SPEC
+void SqliteSink::setMaxRowCount(qint64 maxRowCount)
+{
+    d->thread.run([this, maxRowCount] { d->maxRowCount = qMax<qint64>(maxRowCount, 0); });
+}
+
+QTLOGGER_DECL_SPEC
+int SqliteSink::maxAge() const
+{
+    return d->maxAge;
+}
+
+QTLOGGER_DECL_SPEC
+void SqliteSink::setMaxAge(int secs)
+{
+    d->thread.run([this, secs] { d->maxAge = qMax(secs, 0); });
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_SQL
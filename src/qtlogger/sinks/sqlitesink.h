@@ -0,0 +1,70 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#ifdef QTLOGGER_SQL
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "../logger_global.h"
+#include "../sink.h"
+
+namespace QtLogger {
+
+// Stores messages in an SQLite database through the QSQLITE driver of QtSql.
+//
+// Rows go to the "logs" table with indexed time, level and category columns, the custom
+// attributes are stored as a JSON object. The formatted message is not used.
+//
+// Rows are inserted with a prepared statement in one transaction per batch: a batch is committed
+// when it holds batchSize() rows or its first row is older than batchInterval(). The database is
+// opened in WAL mode with incremental auto-vacuum, and the retention limits are applied with
+// every commit.
+//
+// The database is opened once, in a thread of the sink that owns the connection and commits
+// incomplete batches, so the sending threads need no event loop. A complete batch is committed
+// before send() returns.
+class QTLOGGER_EXPORT SqliteSink : public Sink
+{
+public:
+    static constexpr int DefaultBatchSize = 1000;
+    static constexpr int DefaultBatchInterval = 1000; // ms
+
+    explicit SqliteSink(const QString &fileName);
+    ~SqliteSink() override;
+
+    void send(const LogMessage &lmsg) override;
+    // Commits the pending rows
+    bool flush() override;
+
+    QString fileName() const;
+    // The database is opened with the first message
+    bool isOpen() const;
+
+    int batchSize() const;
+    void setBatchSize(int batchSize);
+
+    int batchInterval() const;
+    void setBatchInterval(int msecs);
+
+    // Retention: the oldest rows beyond the row count and rows older than the age (in seconds)
+    // are deleted, 0 disables the limit
+    qint64 maxRowCount() const;
+    void setMaxRowCount(qint64 maxRowCount);
+
+    int maxAge() const;
+    void setMaxAge(int secs);
+
+private:
+    class SqliteSinkPrivate;
+    QScopedPointer<SqliteSinkPrivate> d;
+    Q_DISABLE_COPY(SqliteSink)
+};
+
+using SqliteSinkPtr = QSharedPointer<SqliteSink>;
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_SQL
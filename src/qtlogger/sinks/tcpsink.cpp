@@ -0,0 +1,355 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#ifdef QTLOGGER_NETWORK
+
+#include "tcpsink.h"
+
+#include <QAtomicInteger>
+#include <QPair>
+#include <QPointer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+#include "sinkthread.h"
+
+namespace QtLogger {
+
+namespace {
+
+constexpr int TcpBatchSize = 64 * 1024;
+
+} // namespace
+
+class TcpSink::TcpSinkPrivate
+{
+public:
+    TcpSinkPrivate(const QString &host, quint16 port, Framing framing)
+        : host(host), port(port), framing(framing)
+    {
+    }
+
+    ~TcpSinkPrivate()
+    {
+        thread.run([this] { resetSocket(); });
+        thread.stop();
+    }
+
+    // The queue is filled in the calling thread, so the drop policy applies before send() returns
+    void send(const QByteArray &frame)
+    {
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            enqueue(frame);
+
+            // Frames sent until the thread of the sink gets to them are coalesced into one write
+            if (writeScheduled)
+                return;
+            writeScheduled = true;
+        }
+
+        thread.post([this] {
+            ensureSocket();
+            writeQueue();
+        });
+    }
+
+    void flush()
+    {
+        thread.run([this] {
+            if (!socket)
+                return;
+
+            writeQueue();
+            socket->flush();
+        });
+    }
+
+    QString host;
+    quint16 port;
+    Framing framing;
+
+    // Set by any thread, guarded by the mutex
+    int maxBufferSize = DefaultMaxBufferSize;
+    DropPolicy dropPolicy = DropPolicy::DropOldest;
+    int minReconnectDelay = DefaultMinReconnectDelay;
+    int maxReconnectDelay = DefaultMaxReconnectDelay;
+
+    QAtomicInt connected;
+    QAtomicInteger<quint64> dropped;
+
+#ifndef QTLOGGER_NO_THREAD
+    QMutex mutex;
+#endif
+    SinkThread thread { QStringLiteral("TcpSink") };
+
+private:
+    // The socket and its timer are used only in the thread of the sink
+    void ensureSocket()
+    {
+        if (socket)
+            return;
+
+        socket = new QTcpSocket(thread.context());
+        reconnectDelay = reconnectDelays().first;
+
+        reconnectTimer = new QTimer(socket.data());
+        reconnectTimer->setSingleShot(true);
+        QObject::connect(reconnectTimer.data(), &QTimer::timeout, socket.data(), [this] {
+            if (socket->state() == QAbstractSocket::UnconnectedState)
+                socket->connectToHost(host, port);
+        });
+
+        QObject::connect(socket.data(), &QAbstractSocket::stateChanged, socket.data(),
+                         [this](QAbstractSocket::SocketState state) {
+                             if (state == QAbstractSocket::ConnectedState) {
+                                 connected.storeRelease(1);
+                                 reconnectDelay = reconnectDelays().first;
+                                 writeQueue();
+                             } else if (state == QAbstractSocket::UnconnectedState) {
+                                 connected.storeRelease(0);
+                                 scheduleReconnect();
+                             }
+                         });
+
+        // The socket is refilled from the queue as it sends
+        QObject::connect(socket.data(), &QIODevice::bytesWritten, socket.data(),
+                         [this] { writeQueue(); });
+
+        socket->connectToHost(host, port);
+    }
+
+    void resetSocket()
+    {
+        if (!socket)
+            return;
+
+        socket->disconnect();
+        reconnectTimer->disconnect();
+
+        if (socket->thread() == QThread::currentThread()) {
+            if (socket->state() == QAbstractSocket::ConnectedState) {
+                {
+#ifndef QTLOGGER_NO_THREAD
+                    QMutexLocker locker(&mutex);
+#endif
+                    while (!queue.isEmpty()) {
+                        socket->write(queue.takeFirst());
+                    }
+                    queuedSize = 0;
+                }
+                if (socket->bytesToWrite() > 0)
+                    socket->waitForBytesWritten(100);
+            }
+            delete socket.data();
+        } else {
+            socket->deleteLater();
+        }
+
+        socket = nullptr;
+        connected.storeRelease(0);
+    }
+
+    void scheduleReconnect()
+    {
+        if (!reconnectTimer || reconnectTimer->isActive())
+            return;
+
+        reconnectTimer->start(reconnectDelay);
+        reconnectDelay = qMin(reconnectDelay * 2, reconnectDelays().second);
+    }
+
+    QPair<int, int> reconnectDelays()
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&mutex);
+#endif
+        return { minReconnectDelay, maxReconnectDelay };
+    }
+
+    // Called with the mutex locked
+    void enqueue(const QByteArray &frame)
+    {
+        if (queuedSize + frame.size() > maxBufferSize) {
+            if (dropPolicy == DropPolicy::DropNewest || frame.size() > maxBufferSize) {
+                dropped.fetchAndAddRelaxed(1);
+                return;
+            }
+
+            while (!queue.isEmpty() && queuedSize + frame.size() > maxBufferSize) {
+                queuedSize -= queue.takeFirst().size();
+                dropped.fetchAndAddRelaxed(1);
+            }
+        }
+
+        queue.append(frame);
+        queuedSize += frame.size();
+    }
+
+    void writeQueue()
+    {
+        if (!socket)
+            return;
+
+        QByteArray batch;
+        {
+#ifndef QTLOGGER_NO_THREAD
+            QMutexLocker locker(&mutex);
+#endif
+            writeScheduled = false;
+
+            if (socket->state() != QAbstractSocket::ConnectedState || queue.isEmpty())
+                return;
+
+            // A slow peer keeps the rest in the bounded queue instead of the socket buffer
+            if (socket->bytesToWrite() >= TcpBatchSize)
+                return;
+
+            batch.reserve(static_cast<int>(qMin<qint64>(queuedSize, TcpBatchSize)));
+            while (!queue.isEmpty() && batch.size() < TcpBatchSize) {
+                batch.append(queue.takeFirst());
+            }
+            queuedSize -= batch.size();
+        }
+
+        socket->write(batch);
+    }
+
+    QPointer<QTcpSocket> socket;
+    QPointer<QTimer> reconnectTimer;
+    int reconnectDelay = DefaultMinReconnectDelay;
+
+    QList<QByteArray> queue;
+    qint64 queuedSize = 0;
+    bool writeScheduled = false;
+};
+
+QTLOGGER_DECL_SPEC
+TcpSink::TcpSink(const QString &host, quint16 port, Framing framing)
+    : d(new TcpSinkPrivate(host, port, framing))
+{
+}
+
+QTLOGGER_DECL_SPEC
+TcpSink::~TcpSink() = default;
+
+QTLOGGER_DECL_SPEC
+void TcpSink::send(const LogMessage &lmsg)
+{
+    // A peer isn't a terminal, so the message is sent without terminal colors, and it doesn't
+    // share the locale of the process, so text is always in UTF-8
+    d->send(IODeviceSink::frame(lmsg, d->framing, true, true));
+}
+
+QTLOGGER_DECL_SPEC
+bool TcpSink::flush()
+{
+    d->flush();
+    return true;
+}
+
+QTLOGGER_DECL_SPEC
+QString TcpSink::host() const
+{
+    return d->host;
+}
+
+QTLOGGER_DECL_SPEC
+quint16 TcpSink::port() const
+{
+    return d->port;
+}
+
+QTLOGGER_DECL_SPEC
+TcpSink::Framing TcpSink::framing() const
+{
+    return d->framing;
+}
+
+QTLOGGER_DECL_SPEC
+int TcpSink::maxBufferSize() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxBufferSize;
+}
+
+QTLOGGER_DECL_SPEC
+void TcpSink::setMaxBufferSize(int maxBufferSize)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->maxBufferSize = maxBufferSize;
+}
+
+QTLOGGER_DECL_SPEC
+TcpSink::DropPolicy TcpSink::dropPolicy() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->dropPolicy;
+}
+
+QTLOGGER_DECL_SPEC
+void TcpSink::setDropPolicy(DropPolicy dropPolicy)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->dropPolicy = dropPolicy;
+}
+
+QTLOGGER_DECL_SPEC
+int TcpSink::minReconnectDelay() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->minReconnectDelay;
+}
+
+QTLOGGER_DECL_SPEC
+int TcpSink::maxReconnectDelay() const
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    return d->maxReconnectDelay;
+}
+
+QTLOGGER_DECL_SPEC
+void TcpSink::setReconnectDelay(int minDelay, int maxDelay)
+{
+#ifndef QTLOGGER_NO_THREAD
+    QMutexLocker locker(&d->mutex);
+#endif
+    d->minReconnectDelay = qMax(minDelay, 0);
+    d->maxReconnectDelay = qMax(maxDelay, d->minReconnectDelay);
+}
+
+QTLOGGER_DECL_SPEC
+bool TcpSink::isConnected() const
+{
+    return d->connected.loadAcquire() != 0;
+}
+
+QTLOGGER_DECL_SPEC
+quint64 TcpSink::droppedCount() const
+{
+    return d->dropped.loadAcquire();
+}
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
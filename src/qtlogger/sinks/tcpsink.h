@@ -0,0 +1,76 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#ifdef QTLOGGER_NETWORK
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include "../logger_global.h"
+#include "../sink.h"
+#include "iodevicesink.h"
+
+namespace QtLogger {
+
+// Streams formatted messages to a TCP server, framed by IODeviceSink::frame() without terminal
+// colors. Text is sent in UTF-8 with both framings.
+//
+// Frames are queued in a bounded buffer and written in batches: everything sent within one event
+// loop iteration goes to the socket with a single write, and at most 64 KB are handed to the
+// socket until it has sent them, so a slow peer fills the buffer of the sink instead of the socket.
+// When the buffer is full, messages are dropped according to the drop policy.
+//
+// The socket lives in a thread of the sink, so the sending threads need no event loop. Lost
+// connections are reestablished with exponential backoff; frames already handed to the socket
+// when the connection is lost are lost with it.
+class QTLOGGER_EXPORT TcpSink : public Sink
+{
+public:
+    using Framing = IODeviceSink::Framing;
+
+    enum class DropPolicy {
+        DropOldest, // Discard the oldest queued messages to make room
+        DropNewest // Discard the message being sent
+    };
+
+    static constexpr int DefaultMaxBufferSize = 4 * 1024 * 1024;
+    static constexpr int DefaultMinReconnectDelay = 100; // ms
+    static constexpr int DefaultMaxReconnectDelay = 30000; // ms
+
+    TcpSink(const QString &host, quint16 port, Framing framing = Framing::Newline);
+    ~TcpSink() override;
+
+    void send(const LogMessage &lmsg) override;
+    bool flush() override;
+
+    QString host() const;
+    quint16 port() const;
+    Framing framing() const;
+
+    int maxBufferSize() const;
+    void setMaxBufferSize(int maxBufferSize);
+
+    DropPolicy dropPolicy() const;
+    void setDropPolicy(DropPolicy dropPolicy);
+
+    // The delay starts at the minimum and doubles after every failed attempt
+    int minReconnectDelay() const;
+    int maxReconnectDelay() const;
+    void setReconnectDelay(int minDelay, int maxDelay);
+
+    bool isConnected() const;
+    quint64 droppedCount() const;
+
+private:
+    class TcpSinkPrivate;
+    QScopedPointer<TcpSinkPrivate> d;
+    Q_DISABLE_COPY(TcpSink)
+};
+
+using TcpSinkPtr = QSharedPointer<TcpSink>;
+
+} // namespace QtLogger
+
+#endif // QTLOGGER_NETWORK
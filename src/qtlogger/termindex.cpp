@@ -0,0 +1,394 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "termindex.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <algorithm>
+#include <iostream>
+
+namespace QtLogger {
+
+namespace {
+
+// FNV-1a, stable across processes and Qt versions unlike qHash()
+quint64 termIndexHash(const QString &term)
+{
+    auto hash = Q_UINT64_C(14695981039346656037);
+    const auto utf8 = term.toUtf8();
+    for (const auto c : utf8) {
+        hash ^= static_cast<quint8>(c);
+        hash *= Q_UINT64_C(1099511628211);
+    }
+    return hash;
+}
+
+// Bit positions by double hashing
+template<typename Function>
+void termIndexBits(const QString &term, quint32 bitCount, int hashCount, Function function)
+{
+    const auto hash = termIndexHash(term);
+    const auto h1 = static_cast<quint32>(hash);
+    const auto h2 = static_cast<quint32>(hash >> 32) | 1;
+    for (int i = 0; i < hashCount; ++i) {
+        function((h1 + static_cast<quint32>(i) * h2) % bitCount);
+    }
+}
+
+bool isTermChar(QChar c)
+{
+    return c.isLetterOrNumber() || c == QLatin1Char('_') || c == QLatin1Char('-')
+            || c == QLatin1Char('.');
+}
+
+bool isTermEdgeChar(QChar c)
+{
+    return c == QLatin1Char('-') || c == QLatin1Char('.');
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+QString TermIndex::normalizeTerm(const QString &term)
+{
+    return term.trimmed().toLower().left(MaxTermLength);
+}
+
+QTLOGGER_DECL_SPEC
+QStringList TermIndex::tokenize(const QString &text)
+{
+    QStringList tokens;
+
+    int pos = 0;
+    while (pos < text.size()) {
+        while (pos < text.size() && (!isTermChar(text.at(pos)) || isTermEdgeChar(text.at(pos)))) {
+            ++pos;
+        }
+
+        auto end = pos;
+        while (end < text.size() && isTermChar(text.at(end))) {
+            ++end;
+        }
+
+        auto last = end;
+        while (last > pos && isTermEdgeChar(text.at(last - 1))) {
+            --last;
+        }
+
+        if (last > pos)
+            tokens.append(normalizeTerm(text.mid(pos, last - pos)));
+
+        pos = end;
+    }
+
+    return tokens;
+}
+
+QTLOGGER_DECL_SPEC
+QStringList TermIndex::terms(const QString &text, const QVariantHash &attributes)
+{
+    auto result = tokenize(text);
+
+    for (const auto &value : attributes) {
+        const auto string = value.toString();
+        if (string.isEmpty())
+            continue;
+
+        result.append(normalizeTerm(string));
+        result.append(tokenize(string));
+    }
+
+    return result;
+}
+
+class TermIndexWriter::TermIndexWriterPrivate
+{
+public:
+    void addTerm(const QString &term, qint64 rangeOffset)
+    {
+        if (term.isEmpty() || !complete)
+            return;
+
+        auto &ranges = terms[term];
+        if (!ranges.isEmpty() && ranges.last() == rangeOffset)
+            return;
+
+        // An index without some of the terms would rule out files that have them
+        if (rangeCount >= maxRangeCount) {
+            terms = QHash<QString, QList<qint64>>();
+            rangeCount = 0;
+            complete = false;
+            return;
+        }
+
+        ranges.append(rangeOffset);
+        ++rangeCount;
+    }
+
+    QHash<QString, QList<qint64>> terms;
+    int maxRangeCount = DefaultMaxRangeCount;
+    int rangeCount = 0;
+    bool complete = true;
+};
+
+QTLOGGER_DECL_SPEC
+TermIndexWriter::TermIndexWriter() : d(new TermIndexWriterPrivate) { }
+
+QTLOGGER_DECL_SPEC
+TermIndexWriter::~TermIndexWriter() = default;
+
+QTLOGGER_DECL_SPEC
+int TermIndexWriter::maxRangeCount() const
+{
+    return d->maxRangeCount;
+}
+
+QTLOGGER_DECL_SPEC
+void TermIndexWriter::setMaxRangeCount(int count)
+{
+    d->maxRangeCount = qMax(count, 1);
+}
+
+QTLOGGER_DECL_SPEC
+int TermIndexWriter::rangeCount() const
+{
+    return d->rangeCount;
+}
+
+QTLOGGER_DECL_SPEC
+bool TermIndexWriter::isComplete() const
+{
+    return d->complete;
+}
+
+QTLOGGER_DECL_SPEC
+void TermIndexWriter::add(const LogMessage &lmsg, qint64 rangeOffset)
+{
+    if (!d->complete)
+        return;
+
+    const auto terms = TermIndex::terms(lmsg.message(), lmsg.attributes());
+    for (const auto &term : terms) {
+        d->addTerm(term, rangeOffset);
+    }
+}
+
+QTLOGGER_DECL_SPEC
+void TermIndexWriter::addText(const QString &text, qint64 rangeOffset)
+{
+    if (!d->complete)
+        return;
+
+    const auto tokens = TermIndex::tokenize(text);
+    for (const auto &token : tokens) {
+        d->addTerm(token, rangeOffset);
+    }
+}
+
+QTLOGGER_DECL_SPEC
+bool TermIndexWriter::write(const QString &indexFileName) const
+{
+    if (!d->complete)
+        return false;
+
+    const auto termCount = static_cast<quint32>(d->terms.size());
+    const auto bloomSize = qMax<quint32>(8, (termCount * TermIndex::BitsPerTerm + 7) / 8);
+
+    auto data = QByteArray(TermIndex::Magic, 4);
+    data.append(static_cast<char>(TermIndex::Version));
+    data.append(static_cast<char>(TermIndex::HashCount));
+    data.append(2, '\0');
+
+    char number[8];
+    qToLittleEndian(bloomSize, number);
+    data.append(number, 4);
+
+    auto bloom = QByteArray(static_cast<int>(bloomSize), '\0');
+
+    // Sorted, so the same terms always give the same file
+    auto terms = d->terms.keys();
+    std::sort(terms.begin(), terms.end());
+
+    QByteArray termData;
+    qToLittleEndian(termCount, number);
+    termData.append(number, 4);
+
+    for (const auto &term : std::as_const(terms)) {
+        termIndexBits(term, bloomSize * 8, TermIndex::HashCount, [&bloom](quint32 bit) {
+            const auto i = static_cast<int>(bit / 8);
+            bloom[i] = static_cast<char>(bloom.at(i) | (1 << (bit % 8)));
+        });
+
+        const auto utf8 = term.toUtf8();
+        qToLittleEndian(static_cast<quint16>(utf8.size()), number);
+        termData.append(number, 2);
+        termData.append(utf8);
+
+        const auto &ranges = d->terms[term];
+        qToLittleEndian(static_cast<quint32>(ranges.size()), number);
+        termData.append(number, 4);
+
+        for (const auto offset : ranges) {
+            qToLittleEndian(offset, number);
+            termData.append(number, 8);
+        }
+    }
+
+    auto file = QSaveFile(indexFileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        std::cerr << "TermIndexWriter: Can't open index file: " << indexFileName.toStdString()
+                  << " error: " << file.errorString().toStdString() << std::endl;
+        return false;
+    }
+
+    file.write(data);
+    file.write(bloom);
+    file.write(termData);
+    return file.commit();
+}
+
+QTLOGGER_DECL_SPEC
+void TermIndexWriter::reset()
+{
+    d->terms.clear();
+    d->rangeCount = 0;
+    d->complete = true;
+}
+
+class TermIndexReader::TermIndexReaderPrivate
+{
+public:
+    // Parses the terms after the bloom filter, once
+    void loadTerms()
+    {
+        const QMutexLocker locker(&mutex);
+
+        if (termsLoaded)
+            return;
+
+        termsLoaded = true;
+
+        auto file = QFile(fileName);
+        if (!file.open(QIODevice::ReadOnly) || !file.seek(TermIndex::HeaderSize + bloom.size()))
+            return;
+
+        const auto data = file.readAll();
+        const auto *p = data.constData();
+        const auto *end = p + data.size();
+
+        if (end - p < 4)
+            return;
+
+        const auto count = qFromLittleEndian<quint32>(p);
+        p += 4;
+
+        for (quint32 i = 0; i < count; ++i) {
+            if (end - p < 2)
+                return;
+            const auto size = qFromLittleEndian<quint16>(p);
+            p += 2;
+
+            if (end - p < size + 4)
+                return;
+            const auto term = QString::fromUtf8(p, size);
+            p += size;
+
+            const auto rangeCount = qFromLittleEndian<quint32>(p);
+            p += 4;
+
+            if (static_cast<quint64>(end - p) < static_cast<quint64>(rangeCount) * 8)
+                return;
+
+            QList<qint64> ranges;
+            ranges.reserve(static_cast<int>(rangeCount));
+            for (quint32 j = 0; j < rangeCount; ++j) {
+                ranges.append(qFromLittleEndian<qint64>(p));
+                p += 8;
+            }
+
+            terms.insert(term, ranges);
+        }
+    }
+
+    QString fileName;
+    int hashCount = 0;
+    QByteArray bloom;
+
+    QMutex mutex;
+    bool termsLoaded = false;
+    QHash<QString, QList<qint64>> terms;
+};
+
+QTLOGGER_DECL_SPEC
+TermIndexReader::TermIndexReader(const QString &indexFileName) : d(new TermIndexReaderPrivate)
+{
+    d->fileName = indexFileName;
+
+    auto file = QFile(indexFileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const auto header = file.read(TermIndex::HeaderSize);
+    if (header.size() != TermIndex::HeaderSize || !header.startsWith(TermIndex::Magic)
+        || static_cast<quint8>(header.at(4)) != TermIndex::Version) {
+        return;
+    }
+
+    const auto hashCount = static_cast<quint8>(header.at(5));
+    const auto bloomSize = qFromLittleEndian<quint32>(header.constData() + 8);
+    if (hashCount == 0 || bloomSize == 0 || bloomSize > static_cast<quint64>(file.size()))
+        return;
+
+    const auto bloom = file.read(bloomSize);
+    if (static_cast<quint32>(bloom.size()) != bloomSize)
+        return;
+
+    d->hashCount = hashCount;
+    d->bloom = bloom;
+}
+
+QTLOGGER_DECL_SPEC
+TermIndexReader::~TermIndexReader() = default;
+
+QTLOGGER_DECL_SPEC
+bool TermIndexReader::isValid() const
+{
+    return !d->bloom.isEmpty();
+}
+
+QTLOGGER_DECL_SPEC
+bool TermIndexReader::mayContain(const QString &term) const
+{
+    if (!isValid())
+        return true;
+
+    auto contains = true;
+    const auto &bloom = d->bloom;
+    termIndexBits(TermIndex::normalizeTerm(term), static_cast<quint32>(bloom.size()) * 8,
+                  d->hashCount, [&contains, &bloom](quint32 bit) {
+                      if (!(bloom.at(static_cast<int>(bit / 8)) & (1 << (bit % 8))))
+                          contains = false;
+                  });
+    return contains;
+}
+
+QTLOGGER_DECL_SPEC
+QList<qint64> TermIndexReader::ranges(const QString &term) const
+{
+    if (!isValid())
+        return {};
+
+    const auto normalized = TermIndex::normalizeTerm(term);
+    if (!mayContain(normalized))
+        return {};
+
+    d->loadTerms();
+    return d->terms.value(normalized);
+}
+
+} // namespace QtLogger
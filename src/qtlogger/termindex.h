@@ -0,0 +1,124 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVariantHash>
+
+#include "logger_global.h"
+#include "logmessage.h"
+
+/*
+ * Term index sidecar format (written by RotatingFileSink when a file is rotated, as
+ * "<log file>.tix"):
+ *
+ *   file  := "QTLT" <u8 version> <u8 hash count> <2 reserved bytes> <u32 bloom size in bytes>
+ *            <bloom filter> <u32 term count> term*
+ *   term  := <u16 size> <utf-8 term> <u32 range count> <i64 range offset>*
+ *
+ * Integers are little endian. The bloom filter holds all terms, so a reader can rule out a term by
+ * reading only the header and the filter. The ranges of a term are the offsets of the time index
+ * entries (see timeindex.h) after which a message with the term was written, so they also select
+ * the blocks of a seekable gzip file. Like the time index, the index keeps the name of the
+ * uncompressed file.
+ *
+ * The terms are those LogSearch matches, so a search finds the same messages with and without the
+ * index: the tokens of the lines of a text log as written, and for a binary log the tokens of the
+ * message text and the values of all attributes, both the whole value and its tokens. Tokens are
+ * runs of letters, digits, '_', '-' and '.' not starting or ending with '-' or '.'. Terms are lower
+ * case and at most MaxTermLength characters.
+ *
+ * The writer keeps the ranges of all terms in memory until the file is rotated. High-cardinality
+ * text, e.g. ids and numbers, can have more than TermIndexWriter::maxRangeCount(); the terms are
+ * then dropped and no index is written for the file, a search reads all of it.
+ */
+
+namespace QtLogger {
+
+namespace TermIndex {
+
+constexpr char Magic[] = "QTLT";
+constexpr quint8 Version = 1;
+constexpr int HeaderSize = 12;
+
+constexpr int BitsPerTerm = 10;
+constexpr int HashCount = 7;
+constexpr int MaxTermLength = 128;
+
+inline QString indexFileName(const QString &logFileName)
+{
+    return logFileName + QStringLiteral(".tix");
+}
+
+QTLOGGER_EXPORT QString normalizeTerm(const QString &term);
+QTLOGGER_EXPORT QStringList tokenize(const QString &text);
+
+// Tokens of the text and the values of the attributes, whole and tokenized
+QTLOGGER_EXPORT QStringList terms(const QString &text,
+                                  const QVariantHash &attributes = QVariantHash());
+
+} // namespace TermIndex
+
+// Collects the terms of the messages of one log file and writes its index
+class QTLOGGER_EXPORT TermIndexWriter
+{
+public:
+    static constexpr int DefaultMaxRangeCount = 1024 * 1024;
+
+    TermIndexWriter();
+    ~TermIndexWriter();
+
+    // Adds the terms of a binary log record written after the time index entry at rangeOffset:
+    // its message text and attributes
+    void add(const LogMessage &lmsg, qint64 rangeOffset);
+
+    // Adds the terms of text written after the time index entry at rangeOffset
+    void addText(const QString &text, qint64 rangeOffset);
+
+    // Limit of the ranges of all terms kept in memory, every term has at least one
+    int maxRangeCount() const;
+    void setMaxRangeCount(int count);
+
+    // Ranges of all terms added since the last reset, 0 after the limit was exceeded
+    int rangeCount() const;
+
+    // False if the terms added since the last reset exceeded maxRangeCount() and were dropped
+    bool isComplete() const;
+
+    // Writes the index of the terms added since the last reset, false if it isn't complete
+    bool write(const QString &indexFileName) const;
+    void reset();
+
+private:
+    class TermIndexWriterPrivate;
+    QScopedPointer<TermIndexWriterPrivate> d;
+    Q_DISABLE_COPY(TermIndexWriter)
+};
+
+// Reads the bloom filter of a term index right away and its terms on first use
+class QTLOGGER_EXPORT TermIndexReader
+{
+public:
+    explicit TermIndexReader(const QString &indexFileName);
+    ~TermIndexReader();
+
+    bool isValid() const;
+
+    // False if the file has no message with the term, true if it may have
+    bool mayContain(const QString &term) const;
+
+    // Range offsets of the messages with the term, in ascending order
+    QList<qint64> ranges(const QString &term) const;
+
+private:
+    class TermIndexReaderPrivate;
+    QScopedPointer<TermIndexReaderPrivate> d;
+    Q_DISABLE_COPY(TermIndexReader)
+};
+
+} // namespace QtLogger
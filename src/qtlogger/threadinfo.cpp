@@ -0,0 +1,142 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "threadinfo.h"
+
+#include <QHash>
+#include <QThread>
+
+#ifndef QTLOGGER_NO_THREAD
+#    include <QMutex>
+#    include <QMutexLocker>
+#endif
+
+#if defined(Q_OS_WIN)
+#    include <qt_windows.h>
+#elif defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+#    include <sys/prctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#elif defined(Q_OS_DARWIN)
+#    include <pthread.h>
+#endif
+
+namespace QtLogger {
+
+namespace {
+
+quint64 resolveThreadId()
+{
+#if defined(Q_OS_WIN)
+    return GetCurrentThreadId();
+#elif defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+    return static_cast<quint64>(syscall(SYS_gettid));
+#elif defined(Q_OS_DARWIN)
+    uint64_t id = 0;
+    pthread_threadid_np(nullptr, &id);
+    return id;
+#else
+    return reinterpret_cast<quintptr>(QThread::currentThreadId());
+#endif
+}
+
+// Runs in the thread whose name is resolved
+QString resolveThreadName()
+{
+    QString name;
+
+#ifndef QTLOGGER_NO_THREAD
+    name = QThread::currentThread()->objectName();
+#endif
+
+    if (name.isEmpty()) {
+#if defined(Q_OS_LINUX) || defined(Q_OS_ANDROID)
+        char systemName[16] = {};
+        if (prctl(PR_GET_NAME, systemName) == 0)
+            name = QString::fromLocal8Bit(systemName);
+#elif defined(Q_OS_DARWIN)
+        char systemName[64] = {};
+        if (pthread_getname_np(pthread_self(), systemName, sizeof(systemName)) == 0)
+            name = QString::fromLocal8Bit(systemName);
+#endif
+    }
+
+    return name;
+}
+
+} // namespace
+
+// Names of the threads by system id, written when a thread gets its id or is renamed and read
+// when messages are formatted
+class ThreadNameRegistry
+{
+public:
+    static ThreadNameRegistry &instance()
+    {
+        // Never destroyed, threads may still log during static destruction
+        static auto *registry = new ThreadNameRegistry();
+        return *registry;
+    }
+
+    QString name(quint64 id)
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&m_mutex);
+#endif
+        return m_names.value(id);
+    }
+
+    void setName(quint64 id, const QString &name)
+    {
+#ifndef QTLOGGER_NO_THREAD
+        QMutexLocker locker(&m_mutex);
+#endif
+        m_names.insert(id, name);
+    }
+
+private:
+#ifndef QTLOGGER_NO_THREAD
+    QMutex m_mutex;
+#endif
+    QHash<quint64, QString> m_names;
+};
+
+QTLOGGER_DECL_SPEC
+quint64 ThreadInfo::currentId()
+{
+    static thread_local const quint64 id = [] {
+        const auto id = resolveThreadId();
+        ThreadNameRegistry::instance().setName(id, resolveThreadName());
+
+#ifndef QTLOGGER_NO_THREAD
+        // The signal passes the new name, so the QThread isn't read from the thread renaming it.
+        // An emptied object name keeps the last name, the system name can't be read from there.
+        QObject::connect(QThread::currentThread(), &QObject::objectNameChanged,
+                         [id](const QString &name) {
+                             if (!name.isEmpty())
+                                 ThreadNameRegistry::instance().setName(id, name);
+                         });
+#endif
+
+        return id;
+    }();
+
+    return id;
+}
+
+QTLOGGER_DECL_SPEC
+QString ThreadInfo::name(quint64 id)
+{
+    if (id == 0)
+        return QString();
+
+    return ThreadNameRegistry::instance().name(id);
+}
+
+QTLOGGER_DECL_SPEC
+void ThreadInfo::refreshCurrent()
+{
+    ThreadNameRegistry::instance().setName(currentId(), resolveThreadName());
+}
+
+} // namespace QtLogger
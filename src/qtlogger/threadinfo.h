@@ -0,0 +1,31 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QString>
+
+#include "logger_global.h"
+
+namespace QtLogger {
+
+namespace ThreadInfo {
+
+// System id of the calling thread: gettid() on Linux and Android, pthread_threadid_np() on macOS
+// and iOS, GetCurrentThreadId() on Windows, the native thread handle elsewhere. Resolved once per
+// thread and then served from thread local storage, so capturing it with every message costs a
+// single load.
+QTLOGGER_EXPORT quint64 currentId();
+
+// Name of the thread with the system id, looked up when a message is formatted: the object name
+// of its QThread, or the name of the thread in the system when it got its id. A new object name
+// is taken from QThread::objectNameChanged; a thread renamed in the system only, e.g. by
+// pthread_setname_np(), calls refreshCurrent(). Empty for threads that never got their id.
+QTLOGGER_EXPORT QString name(quint64 id);
+
+// Resolves the name of the calling thread again, e.g. after it was renamed in the system
+QTLOGGER_EXPORT void refreshCurrent();
+
+} // namespace ThreadInfo
+
+} // namespace QtLogger
@@ -0,0 +1,389 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include "timeindex.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QtEndian>
+
+#include <algorithm>
+#include <iostream>
+
+#include "seekablegzip.h"
+
+namespace QtLogger {
+
+namespace {
+
+QByteArray timeIndexHeader()
+{
+    auto header = QByteArray(TimeIndex::Magic, 4);
+    header.append(static_cast<char>(TimeIndex::Version));
+    header.append(3, '\0');
+    return header;
+}
+
+bool timeIndexHeaderValid(const QByteArray &header)
+{
+    return header.size() == TimeIndex::HeaderSize && header.startsWith(TimeIndex::Magic)
+            && static_cast<quint8>(header.at(4)) == TimeIndex::Version;
+}
+
+TimeIndex::Entry timeIndexEntry(const char *data)
+{
+    return { qFromLittleEndian<qint64>(data), qFromLittleEndian<qint64>(data + 8) };
+}
+
+} // namespace
+
+QTLOGGER_DECL_SPEC
+QList<TimeIndex::Entry> TimeIndex::readEntries(const QString &indexFileName)
+{
+    auto file = QFile(indexFileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+
+    if (!timeIndexHeaderValid(file.read(HeaderSize)))
+        return {};
+
+    const auto data = file.readAll();
+    const auto count = data.size() / EntrySize;
+
+    QList<Entry> entries;
+    entries.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        entries.append(timeIndexEntry(data.constData() + i * EntrySize));
+    }
+
+    return entries;
+}
+
+class TimeIndexWriter::TimeIndexWriterPrivate
+{
+public:
+    TimeIndexWriterPrivate(int intervalBytes, int intervalMsecs)
+        : intervalBytes(qMax(intervalBytes, 0)), intervalMsecs(qMax(intervalMsecs, 0))
+    {
+    }
+
+    // Continues a valid index of the log file, or starts a new one
+    bool open(const QString &logFileName, qint64 offset)
+    {
+        file.setFileName(TimeIndex::indexFileName(logFileName));
+        hasEntry = false;
+
+        if (offset > 0 && file.open(QIODevice::ReadWrite)) {
+            const auto count = (file.size() - TimeIndex::HeaderSize) / TimeIndex::EntrySize;
+
+            if (count > 0 && timeIndexHeaderValid(file.read(TimeIndex::HeaderSize))) {
+                const auto end = TimeIndex::HeaderSize + count * TimeIndex::EntrySize;
+                file.seek(end - TimeIndex::EntrySize);
+                const auto last = timeIndexEntry(file.read(TimeIndex::EntrySize).constData());
+
+                // An entry beyond the end of the log means the log was replaced
+                if (last.offset <= offset) {
+                    file.resize(end);
+                    file.seek(end);
+                    lastTime = last.time;
+                    lastOffset = last.offset;
+                    hasEntry = true;
+                    return true;
+                }
+            }
+
+            file.close();
+        }
+
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            std::cerr << "TimeIndexWriter: Can't open index file: "
+                      << file.fileName().toStdString()
+                      << " error: " << file.errorString().toStdString() << std::endl;
+            return false;
+        }
+
+        file.write(timeIndexHeader());
+        return true;
+    }
+
+    void add(const QString &logFileName, const QDateTime &time, qint64 offset)
+    {
+        if (file.isOpen() && file.fileName() != TimeIndex::indexFileName(logFileName))
+            file.close();
+
+        if (!file.isOpen()) {
+            if (openFailed == logFileName || !open(logFileName, offset)) {
+                openFailed = logFileName;
+                return;
+            }
+            openFailed.clear();
+        }
+
+        auto msecs = time.toMSecsSinceEpoch();
+        if (hasEntry)
+            msecs = qMax(msecs, lastTime);
+
+        if (hasEntry && offset - lastOffset < intervalBytes && msecs - lastTime < intervalMsecs)
+            return;
+
+        char entry[TimeIndex::EntrySize];
+        qToLittleEndian(msecs, entry);
+        qToLittleEndian(offset, entry + 8);
+
+        // Flushed right away, so readers of a live log see the entry with the message
+        file.write(entry, sizeof(entry));
+        file.flush();
+
+        lastTime = msecs;
+        lastOffset = offset;
+        hasEntry = true;
+    }
+
+    int intervalBytes;
+    int intervalMsecs;
+
+    QFile file;
+    QString openFailed;
+    qint64 lastTime = 0;
+    qint64 lastOffset = 0;
+    bool hasEntry = false;
+};
+
+QTLOGGER_DECL_SPEC
+TimeIndexWriter::TimeIndexWriter(int intervalBytes, int intervalMsecs)
+    : d(new TimeIndexWriterPrivate(intervalBytes, intervalMsecs))
+{
+}
+
+QTLOGGER_DECL_SPEC
+TimeIndexWriter::~TimeIndexWriter() = default;
+
+QTLOGGER_DECL_SPEC
+int TimeIndexWriter::intervalBytes() const
+{
+    return d->intervalBytes;
+}
+
+QTLOGGER_DECL_SPEC
+int TimeIndexWriter::intervalMsecs() const
+{
+    return d->intervalMsecs;
+}
+
+QTLOGGER_DECL_SPEC
+void TimeIndexWriter::add(const QString &logFileName, const QDateTime &time, qint64 offset)
+{
+    d->add(logFileName, time, offset);
+}
+
+QTLOGGER_DECL_SPEC
+qint64 TimeIndexWriter::lastOffset() const
+{
+    return d->hasEntry ? d->lastOffset : -1;
+}
+
+QTLOGGER_DECL_SPEC
+void TimeIndexWriter::close()
+{
+    d->file.close();
+    d->openFailed.clear();
+}
+
+QTLOGGER_DECL_SPEC
+bool TimeIndexWriter::flush()
+{
+    return !d->file.isOpen() || d->file.flush();
+}
+
+class TimeIndexReader::TimeIndexReaderPrivate
+{
+public:
+    explicit TimeIndexReaderPrivate(const QString &logFileName) : logFileName(logFileName) { }
+
+    static bool isCompressed(const QString &fileName)
+    {
+        return fileName.endsWith(QStringLiteral(".gz"));
+    }
+
+    // The time index of a compressed file keeps the name of the uncompressed file
+    static QString indexFileName(const QString &fileName)
+    {
+        return TimeIndex::indexFileName(isCompressed(fileName) ? fileName.left(fileName.size() - 3)
+                                                               : fileName);
+    }
+
+    QStringList files() const
+    {
+        const auto fi = QFileInfo(logFileName);
+        const auto baseName = fi.completeBaseName();
+        const auto suffix = fi.suffix();
+
+        QString pattern;
+        if (suffix.isEmpty()) {
+            pattern = QStringLiteral("^%1\\.(\\d{4}-\\d{2}-\\d{2})\\.(\\d+)(\\.gz)?$")
+                              .arg(QRegularExpression::escape(baseName));
+        } else {
+            pattern = QStringLiteral("^%1\\.(\\d{4}-\\d{2}-\\d{2})\\.(\\d+)\\.%2(\\.gz)?$")
+                              .arg(QRegularExpression::escape(baseName),
+                                   QRegularExpression::escape(suffix));
+        }
+
+        const auto re = QRegularExpression(pattern);
+        const auto dir = fi.absoluteDir();
+
+        struct Rotated
+        {
+            QString date;
+            int index;
+            QString path;
+        };
+        QList<Rotated> rotated;
+
+        const auto entries = dir.entryList(QDir::Files);
+        for (const auto &entry : entries) {
+            const auto match = re.match(entry);
+            // Only compressed files with a block index can be read without decompressing them
+            if (match.hasMatch()
+                && (match.captured(3).isEmpty()
+                    || dir.exists(SeekableGzip::indexFileName(entry)))) {
+                rotated.append(
+                        { match.captured(1), match.captured(2).toInt(), dir.filePath(entry) });
+            }
+        }
+
+        // Rotated files are numbered per date, so their order does not depend on the file times
+        std::sort(rotated.begin(), rotated.end(), [](const Rotated &a, const Rotated &b) {
+            return a.date != b.date ? a.date < b.date : a.index < b.index;
+        });
+
+        QStringList result;
+        for (const auto &r : std::as_const(rotated)) {
+            result.append(r.path);
+        }
+
+        if (fi.exists())
+            result.append(fi.absoluteFilePath());
+
+        return result;
+    }
+
+    void start(const QStringList &fileList, int index, qint64 offset)
+    {
+        device.reset();
+        openedFiles = fileList;
+        fileIndex = index;
+        started = true;
+
+        if (fileIndex < openedFiles.size()) {
+            const auto &fileName = openedFiles.at(fileIndex);
+            if (isCompressed(fileName))
+                device.reset(new SeekableGzipFile(fileName));
+            else
+                device.reset(new QFile(fileName));
+
+            if (device->open(QIODevice::ReadOnly))
+                device->seek(offset);
+        }
+    }
+
+    // Moves to the next file with unread data, returns false at the end of the last file
+    bool advance()
+    {
+        if (!started)
+            start(files(), 0, 0);
+
+        while (!device || !device->isOpen() || device->atEnd()) {
+            if (fileIndex + 1 >= openedFiles.size())
+                return false;
+            start(openedFiles, fileIndex + 1, 0);
+        }
+
+        return true;
+    }
+
+    QString logFileName;
+
+    QStringList openedFiles;
+    int fileIndex = 0;
+    QScopedPointer<QIODevice> device;
+    bool started = false;
+};
+
+QTLOGGER_DECL_SPEC
+TimeIndexReader::TimeIndexReader(const QString &logFileName)
+    : d(new TimeIndexReaderPrivate(logFileName))
+{
+}
+
+QTLOGGER_DECL_SPEC
+TimeIndexReader::~TimeIndexReader() = default;
+
+QTLOGGER_DECL_SPEC
+QStringList TimeIndexReader::files() const
+{
+    return d->files();
+}
+
+QTLOGGER_DECL_SPEC
+bool TimeIndexReader::seek(const QDateTime &time)
+{
+    const auto fileList = files();
+    if (fileList.isEmpty()) {
+        d->start(fileList, 0, 0);
+        return false;
+    }
+
+    const auto target = time.toMSecsSinceEpoch();
+
+    // The newest file with an entry before the time is read from the last such entry on. Files
+    // without one start after the time, or can't be placed without their index, e.g. the active
+    // file before its first entry is flushed, so they are only read after it.
+    for (auto i = fileList.size() - 1; i >= 0; --i) {
+        const auto entries = TimeIndex::readEntries(d->indexFileName(fileList.at(i)));
+        if (entries.isEmpty() || entries.first().time >= target)
+            continue;
+
+        const auto it = std::lower_bound(entries.cbegin(), entries.cend(), target,
+                                         [](const TimeIndex::Entry &entry, qint64 msecs) {
+                                             return entry.time < msecs;
+                                         });
+
+        d->start(fileList, i, std::prev(it)->offset);
+        return d->device && d->device->isOpen();
+    }
+
+    // The time is before all entries, or no file can be placed
+    d->start(fileList, 0, 0);
+    return d->device && d->device->isOpen();
+}
+
+QTLOGGER_DECL_SPEC
+QString TimeIndexReader::fileName() const
+{
+    return d->device ? d->openedFiles.at(d->fileIndex) : QString();
+}
+
+QTLOGGER_DECL_SPEC
+qint64 TimeIndexReader::offset() const
+{
+    return d->device && d->device->isOpen() ? d->device->pos() : 0;
+}
+
+QTLOGGER_DECL_SPEC
+bool TimeIndexReader::atEnd()
+{
+    return !d->advance();
+}
+
+QTLOGGER_DECL_SPEC
+QByteArray TimeIndexReader::readLine()
+{
+    if (!d->advance())
+        return {};
+
+    return d->device->readLine();
+}
+
+} // namespace QtLogger
@@ -0,0 +1,117 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <QDateTime>
+#include <QList>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+
+#include "logger_global.h"
+
+/*
+ * Time index sidecar format (written by FileSink next to the log file as "<log file>.idx"):
+ *
+ *   file  := "QTLI" <u8 version> <3 reserved bytes> entry*
+ *   entry := <i64 time, ms since epoch> <i64 byte offset in the log file>
+ *
+ * Integers are little endian. An entry is written for the first message of a file and then for
+ * the first message after the interval in bytes or in time has passed. Entry times never decrease,
+ * so an index can be binary searched even if messages arrive slightly out of order.
+ *
+ * Rotated files keep their index: "app.log.idx" becomes "app.2024-05-15.1.log.idx". Offsets refer
+ * to the uncompressed file, also after "app.2024-05-15.1.log" is compressed.
+ */
+
+namespace QtLogger {
+
+namespace TimeIndex {
+
+constexpr char Magic[] = "QTLI";
+constexpr quint8 Version = 1;
+constexpr int HeaderSize = 8;
+constexpr int EntrySize = 16;
+
+constexpr int DefaultIntervalBytes = 64 * 1024;
+constexpr int DefaultIntervalMsecs = 1000;
+
+struct Entry
+{
+    qint64 time;
+    qint64 offset;
+};
+
+inline QString indexFileName(const QString &logFileName)
+{
+    return logFileName + QStringLiteral(".idx");
+}
+
+// Entries of an index file, empty if the file is missing or invalid
+QTLOGGER_EXPORT QList<Entry> readEntries(const QString &indexFileName);
+
+} // namespace TimeIndex
+
+class QTLOGGER_EXPORT TimeIndexWriter
+{
+public:
+    TimeIndexWriter(int intervalBytes = TimeIndex::DefaultIntervalBytes,
+                    int intervalMsecs = TimeIndex::DefaultIntervalMsecs);
+    ~TimeIndexWriter();
+
+    int intervalBytes() const;
+    int intervalMsecs() const;
+
+    // Called before a message is written at the offset of the log file. A new index is started
+    // at offset 0, otherwise an existing index is continued.
+    void add(const QString &logFileName, const QDateTime &time, qint64 offset);
+
+    // Offset of the last entry written, -1 if there is none
+    qint64 lastOffset() const;
+
+    // Closes the index, e.g. before the log file is renamed
+    void close();
+    bool flush();
+
+private:
+    class TimeIndexWriterPrivate;
+    QScopedPointer<TimeIndexWriterPrivate> d;
+    Q_DISABLE_COPY(TimeIndexWriter)
+};
+
+// Reads a text log and its rotated files from a point in time.
+//
+// seek() finds the newest file whose index has an entry before the time and binary searches it for
+// the last such entry, so reading starts at a message shortly before the time instead of at the
+// start of the oldest file. Newer files without an index are read after it, and all files are read
+// from the start if none has such an entry. Compressed files
+// are read if they have a block index (RotatingFileSink::BlockCompression), decompressing only the
+// blocks from the position on.
+class QTLOGGER_EXPORT TimeIndexReader
+{
+public:
+    // The path of the active log file, as given to the sink
+    explicit TimeIndexReader(const QString &logFileName);
+    ~TimeIndexReader();
+
+    // Files of the log that can be read, oldest first
+    QStringList files() const;
+
+    bool seek(const QDateTime &time);
+
+    QString fileName() const;
+    qint64 offset() const;
+
+    // Lines from the current position on, continuing with the next files; reads to the end
+    // without seek()
+    bool atEnd();
+    QByteArray readLine();
+
+private:
+    class TimeIndexReaderPrivate;
+    QScopedPointer<TimeIndexReaderPrivate> d;
+    Q_DISABLE_COPY(TimeIndexReader)
+};
+
+} // namespace QtLogger
@@ -23,6 +23,9 @@ QTLOGGER_EXPORT void setFilterRules(const QString &rules);
  * %{appname} %{category} %{file} %{function} %{line} %{message} %{pid} %{threadid}
  * %{qthreadptr} %{type} %{time process} %{time boot} %{time [format]} %{backtrace [depth=N]
  * [separator="..."]}
+ *
+ * %{backtrace} symbolizes the stack in the calling thread; BacktraceAttr only captures the return
+ * addresses there and resolves them in the thread of the logger.
  */
 
 QTLOGGER_EXPORT QString setMessagePattern(const QString &messagePattern);
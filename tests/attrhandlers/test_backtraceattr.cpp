@@ -0,0 +1,272 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "qtlogger/attrhandlers/backtraceattr.h"
+#include "qtlogger/backtrace.h"
+#include "qtlogger/formatters/sentryformatter.h"
+#include "qtlogger/logmessage.h"
+
+using namespace QtLogger;
+
+class TestBacktraceAttr : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testCapture();
+    void testDefaultAttributeName();
+    void testMinLevel();
+    void testCapturedAddresses();
+    void testWithoutAddresses();
+    void testAttach();
+    void testReleaseCapture();
+    void testResolveCache();
+    void testFormatFrame();
+    void testSentryStacktrace();
+
+private:
+    LogMessage createLogMessage(QtMsgType type);
+};
+
+void TestBacktraceAttr::init()
+{
+    if (Backtrace::capture(8).isEmpty())
+        QSKIP("Backtraces are not supported on this platform");
+}
+
+void TestBacktraceAttr::cleanup()
+{
+    Backtrace::disableCapture();
+}
+
+LogMessage TestBacktraceAttr::createLogMessage(QtMsgType type)
+{
+    QMessageLogContext context("test.cpp", 42, "testFunction", "test.category");
+    return LogMessage(type, context, QStringLiteral("Something failed"));
+}
+
+void TestBacktraceAttr::testCapture()
+{
+    const auto addresses = Backtrace::capture(4);
+    QVERIFY(!addresses.isEmpty());
+    QVERIFY(addresses.size() <= 4);
+
+    QVERIFY(Backtrace::capture(0).isEmpty());
+
+    // Skipped frames are dropped from the innermost end, the caller of this function stays
+    const auto all = Backtrace::capture(16);
+    const auto skipped = Backtrace::capture(16, 1);
+    QVERIFY(all.size() > 1);
+    QCOMPARE(skipped.first(), all.at(1));
+}
+
+void TestBacktraceAttr::testDefaultAttributeName()
+{
+    BacktraceAttr attr;
+    QCOMPARE(attr.name(), QStringLiteral("backtrace"));
+    QCOMPARE(attr.minLevel(), QtCriticalMsg);
+    QCOMPARE(attr.depth(), Backtrace::DefaultDepth);
+
+    auto lmsg = createLogMessage(QtCriticalMsg);
+    Backtrace::attach(lmsg);
+    attr.process(lmsg);
+
+    QVERIFY(lmsg.hasAttribute(QStringLiteral("backtrace")));
+    const auto frames = lmsg.attribute(QStringLiteral("backtrace")).toString().split(
+            QLatin1Char('\n'));
+    QVERIFY(!frames.first().isEmpty());
+    QCOMPARE(static_cast<int>(frames.size()), static_cast<int>(lmsg.backtrace().size()));
+
+    // The raw addresses are no attribute
+    QCOMPARE(static_cast<int>(lmsg.attributes().size()), 1);
+}
+
+void TestBacktraceAttr::testMinLevel()
+{
+    BacktraceAttr attr(QtWarningMsg, 8, QStringLiteral("stack"));
+
+    auto info = createLogMessage(QtInfoMsg);
+    Backtrace::attach(info);
+    attr.process(info);
+    QVERIFY(!info.hasAttribute(QStringLiteral("stack")));
+    QVERIFY(!info.hasBacktrace());
+
+    auto warning = createLogMessage(QtWarningMsg);
+    Backtrace::attach(warning);
+    attr.process(warning);
+    QVERIFY(warning.hasAttribute(QStringLiteral("stack")));
+    QVERIFY(warning.backtrace().size() <= 8);
+}
+
+void TestBacktraceAttr::testCapturedAddresses()
+{
+    BacktraceAttr attr;
+
+    // Addresses captured by the logger are resolved, not captured again
+    const auto addresses = Backtrace::capture(3);
+    auto lmsg = createLogMessage(QtCriticalMsg);
+    lmsg.setBacktrace(addresses);
+
+    attr.process(lmsg);
+
+    QCOMPARE(lmsg.backtrace(), addresses);
+    const auto frames = lmsg.attribute(QStringLiteral("backtrace")).toString().split(
+            QLatin1Char('\n'));
+    QCOMPARE(static_cast<int>(frames.size()), static_cast<int>(addresses.size()));
+
+    // Addresses captured for a deeper handler are cut to the depth
+    BacktraceAttr shallow(QtCriticalMsg, 2, QStringLiteral("short"));
+    lmsg.setBacktrace(Backtrace::capture(8));
+    QVERIFY(lmsg.backtrace().size() > 2);
+    shallow.process(lmsg);
+    const auto shortFrames = lmsg.attribute(QStringLiteral("short")).toString().split(
+            QLatin1Char('\n'));
+    QCOMPARE(static_cast<int>(shortFrames.size()), 2);
+}
+
+void TestBacktraceAttr::testWithoutAddresses()
+{
+    BacktraceAttr attr;
+
+    // Not captured by the logger, e.g. in the logger thread of an asynchronous logger
+    auto lmsg = createLogMessage(QtCriticalMsg);
+    attr.process(lmsg);
+
+    QVERIFY(!lmsg.hasAttribute(QStringLiteral("backtrace")));
+    QVERIFY(!lmsg.hasBacktrace());
+}
+
+void TestBacktraceAttr::testAttach()
+{
+    auto lmsg = createLogMessage(QtCriticalMsg);
+    Backtrace::attach(lmsg);
+    QVERIFY(!lmsg.hasBacktrace());
+
+    Backtrace::enableCapture(QtCriticalMsg, 8);
+    QVERIFY(!Backtrace::isCaptureEnabled(QtWarningMsg));
+    QVERIFY(Backtrace::isCaptureEnabled(QtCriticalMsg));
+    QVERIFY(Backtrace::isCaptureEnabled(QtFatalMsg));
+
+    auto warning = createLogMessage(QtWarningMsg);
+    Backtrace::attach(warning);
+    QVERIFY(!warning.hasBacktrace());
+
+    Backtrace::attach(lmsg);
+    const auto addresses = lmsg.backtrace();
+    QVERIFY(!addresses.isEmpty());
+    QVERIFY(addresses.size() <= 8);
+
+    // The lowest level and the largest depth of all handlers are used
+    Backtrace::enableCapture(QtWarningMsg, 4);
+    Backtrace::enableCapture(QtCriticalMsg, 16);
+    QVERIFY(Backtrace::isCaptureEnabled(QtWarningMsg));
+    QVERIFY(!Backtrace::isCaptureEnabled(QtInfoMsg));
+
+    Backtrace::disableCapture();
+    QVERIFY(!Backtrace::isCaptureEnabled(QtFatalMsg));
+}
+
+void TestBacktraceAttr::testReleaseCapture()
+{
+    Backtrace::enableCapture(QtWarningMsg, 4);
+    Backtrace::enableCapture(QtCriticalMsg, 16);
+
+    // The other request stays
+    Backtrace::releaseCapture(QtWarningMsg, 4);
+    QVERIFY(!Backtrace::isCaptureEnabled(QtWarningMsg));
+    QVERIFY(Backtrace::isCaptureEnabled(QtCriticalMsg));
+
+    Backtrace::releaseCapture(QtCriticalMsg, 16);
+    QVERIFY(!Backtrace::isCaptureEnabled(QtFatalMsg));
+
+    // A handler requests the capture while it exists
+    {
+        BacktraceAttr attr(QtWarningMsg, 8);
+        QVERIFY(Backtrace::isCaptureEnabled(QtWarningMsg));
+    }
+    QVERIFY(!Backtrace::isCaptureEnabled(QtFatalMsg));
+}
+
+void TestBacktraceAttr::testResolveCache()
+{
+    Backtrace::clearCache();
+    QCOMPARE(Backtrace::cacheSize(), 0);
+
+    const auto addresses = Backtrace::capture(1);
+    QCOMPARE(static_cast<int>(addresses.size()), 1);
+
+    const auto frame = Backtrace::resolve(addresses.first());
+    QCOMPARE(frame.address, addresses.first());
+    QCOMPARE(Backtrace::cacheSize(), 1);
+
+    const auto cached = Backtrace::resolve(addresses.first());
+    QCOMPARE(Backtrace::cacheSize(), 1);
+    QCOMPARE(cached.function, frame.function);
+    QCOMPARE(cached.module, frame.module);
+
+    Backtrace::clearCache();
+    QCOMPARE(Backtrace::cacheSize(), 0);
+}
+
+void TestBacktraceAttr::testFormatFrame()
+{
+    Backtrace::Frame frame;
+    frame.address = 0x1234;
+    QCOMPARE(Backtrace::formatFrame(frame), QStringLiteral("0x1234"));
+
+    frame.module = QStringLiteral("/usr/lib/libapp.so");
+    QCOMPARE(Backtrace::formatFrame(frame), QStringLiteral("0x1234 (libapp.so)"));
+
+    frame.function = QStringLiteral("App::run()");
+    frame.symbolAddress = 0x1200;
+    QCOMPARE(Backtrace::formatFrame(frame), QStringLiteral("App::run()+0x34 (libapp.so)"));
+}
+
+void TestBacktraceAttr::testSentryStacktrace()
+{
+    const auto addresses = Backtrace::capture(5);
+
+    auto lmsg = createLogMessage(QtCriticalMsg);
+    lmsg.setBacktrace(addresses);
+
+    SentryFormatter formatter;
+    const auto event = QJsonDocument::fromJson(formatter.format(lmsg).toUtf8()).object();
+
+    const auto threads = event.value(QStringLiteral("threads")).toObject();
+    const auto thread = threads.value(QStringLiteral("values")).toArray().first().toObject();
+    QVERIFY(thread.value(QStringLiteral("current")).toBool());
+
+    const auto frames = thread.value(QStringLiteral("stacktrace"))
+                                .toObject()
+                                .value(QStringLiteral("frames"))
+                                .toArray();
+    QCOMPARE(static_cast<int>(frames.size()), static_cast<int>(addresses.size()));
+
+    // Outermost call first
+    const auto innermost = frames.last().toObject();
+    QCOMPARE(innermost.value(QStringLiteral("instruction_addr")).toString(),
+             QStringLiteral("0x") + QString::number(addresses.first(), 16));
+
+    // Raw addresses are not repeated in the extra data
+    const auto extra = event.value(QStringLiteral("extra")).toObject();
+    for (const auto &value : extra) {
+        QVERIFY(!value.isArray());
+    }
+
+    // No stack trace without addresses
+    const auto plain = QJsonDocument::fromJson(
+                               formatter.format(createLogMessage(QtCriticalMsg)).toUtf8())
+                               .object();
+    QVERIFY(!plain.contains(QStringLiteral("threads")));
+}
+
+QTEST_MAIN(TestBacktraceAttr)
+#include "test_backtraceattr.moc"
@@ -0,0 +1,187 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+
+#include "qtlogger/attrhandlers/messagetemplateattr.h"
+#include "qtlogger/logmessage.h"
+
+using namespace QtLogger;
+
+class TestMessageTemplateAttr : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testDefaultAttributeName();
+    void testCustomAttributeName();
+    void testSameTemplate();
+    void testDifferentTemplates();
+    void testDifferentTokenCount();
+    void testNumericFirstToken();
+    void testTemplateCounts();
+    void testMaxTemplates();
+    void testParameters();
+    void testParametersMismatch();
+    void testApplyParameters();
+
+private:
+    int templateId(MessageTemplateAttr &attr, const QString &message);
+};
+
+int TestMessageTemplateAttr::templateId(MessageTemplateAttr &attr, const QString &message)
+{
+    QMessageLogContext context("test.cpp", 42, "testFunction", "test.category");
+    LogMessage lmsg(QtDebugMsg, context, message);
+    attr.process(lmsg);
+    return lmsg.hasAttribute(attr.name()) ? lmsg.attribute(attr.name()).toInt() : -1;
+}
+
+void TestMessageTemplateAttr::testDefaultAttributeName()
+{
+    MessageTemplateAttr attr;
+    QCOMPARE(attr.name(), QStringLiteral("template_id"));
+
+    QMessageLogContext context("test.cpp", 42, "testFunction", "test.category");
+    LogMessage lmsg(QtDebugMsg, context, QStringLiteral("Hello"));
+    attr.process(lmsg);
+
+    QVERIFY(lmsg.hasAttribute(QStringLiteral("template_id")));
+    QCOMPARE(lmsg.attribute(QStringLiteral("template_id")).toInt(), 0);
+}
+
+void TestMessageTemplateAttr::testCustomAttributeName()
+{
+    MessageTemplateAttr attr(QStringLiteral("tid"));
+
+    QMessageLogContext context("test.cpp", 42, "testFunction", "test.category");
+    LogMessage lmsg(QtDebugMsg, context, QStringLiteral("Hello"));
+    attr.process(lmsg);
+
+    QVERIFY(lmsg.hasAttribute(QStringLiteral("tid")));
+    QVERIFY(!lmsg.hasAttribute(QStringLiteral("template_id")));
+}
+
+void TestMessageTemplateAttr::testSameTemplate()
+{
+    MessageTemplateAttr attr;
+
+    const auto id1 = templateId(attr, QStringLiteral("Connected to 10.0.0.1 in 5 ms"));
+    const auto id2 = templateId(attr, QStringLiteral("Connected to 10.0.0.2 in 7 ms"));
+    const auto id3 = templateId(attr, QStringLiteral("Connected to 10.0.0.3 in 12 ms"));
+
+    QCOMPARE(id2, id1);
+    QCOMPARE(id3, id1);
+    QCOMPARE(attr.templateText(id1), QStringLiteral("Connected to <*> in <*> ms"));
+}
+
+void TestMessageTemplateAttr::testDifferentTemplates()
+{
+    MessageTemplateAttr attr;
+
+    const auto id1 = templateId(attr, QStringLiteral("User alice logged in"));
+    const auto id2 = templateId(attr, QStringLiteral("User cache was flushed"));
+    const auto id3 = templateId(attr, QStringLiteral("User bob logged in"));
+
+    QVERIFY(id1 != id2);
+    QCOMPARE(id3, id1);
+    QCOMPARE(attr.templateText(id1), QStringLiteral("User <*> logged in"));
+    QCOMPARE(attr.templateText(id2), QStringLiteral("User cache was flushed"));
+}
+
+void TestMessageTemplateAttr::testDifferentTokenCount()
+{
+    MessageTemplateAttr attr;
+
+    const auto id1 = templateId(attr, QStringLiteral("Request failed"));
+    const auto id2 = templateId(attr, QStringLiteral("Request failed twice"));
+
+    QVERIFY(id1 != id2);
+}
+
+void TestMessageTemplateAttr::testNumericFirstToken()
+{
+    MessageTemplateAttr attr;
+
+    const auto id1 = templateId(attr, QStringLiteral("42 files copied"));
+    const auto id2 = templateId(attr, QStringLiteral("7 files copied"));
+
+    QCOMPARE(id2, id1);
+    QCOMPARE(attr.templateText(id1), QStringLiteral("<*> files copied"));
+}
+
+void TestMessageTemplateAttr::testTemplateCounts()
+{
+    MessageTemplateAttr attr;
+
+    for (int i = 0; i < 5; ++i) {
+        templateId(attr, QStringLiteral("Job %1 finished").arg(i));
+    }
+    templateId(attr, QStringLiteral("Shutting down"));
+
+    const auto templates = attr.templates();
+    QCOMPARE(templates.size(), 2);
+    QCOMPARE(templates.at(0).id, 0);
+    QCOMPARE(templates.at(0).text, QStringLiteral("Job <*> finished"));
+    QCOMPARE(templates.at(0).count, quint64(5));
+    QCOMPARE(templates.at(1).text, QStringLiteral("Shutting down"));
+    QCOMPARE(templates.at(1).count, quint64(1));
+}
+
+void TestMessageTemplateAttr::testMaxTemplates()
+{
+    MessageTemplateAttr attr(QStringLiteral("template_id"),
+                             MessageTemplateAttr::DefaultSimilarityThreshold, 2);
+
+    QCOMPARE(templateId(attr, QStringLiteral("First message")), 0);
+    QCOMPARE(templateId(attr, QStringLiteral("Second message here")), 1);
+    QCOMPARE(templateId(attr, QStringLiteral("Third one")), -1);
+
+    // Existing templates are still matched
+    QCOMPARE(templateId(attr, QStringLiteral("First again")), 0);
+    QCOMPARE(attr.templates().size(), 2);
+}
+
+void TestMessageTemplateAttr::testParameters()
+{
+    const auto params = MessageTemplateAttr::parameters(
+            QStringLiteral("Connected to <*> in <*> ms"),
+            QStringLiteral("Connected to 10.0.0.1 in 5 ms"));
+
+    QVERIFY(params.has_value());
+    QCOMPARE(*params, QStringList({ QStringLiteral("10.0.0.1"), QStringLiteral("5") }));
+
+    const auto noParams = MessageTemplateAttr::parameters(QStringLiteral("Shutting down"),
+                                                          QStringLiteral("Shutting down"));
+    QVERIFY(noParams.has_value());
+    QVERIFY(noParams->isEmpty());
+}
+
+void TestMessageTemplateAttr::testParametersMismatch()
+{
+    QVERIFY(!MessageTemplateAttr::parameters(QStringLiteral("Job <*> finished"),
+                                             QStringLiteral("Job 1 failed")));
+    QVERIFY(!MessageTemplateAttr::parameters(QStringLiteral("Job <*> finished"),
+                                             QStringLiteral("Job 1 finished late")));
+}
+
+void TestMessageTemplateAttr::testApplyParameters()
+{
+    MessageTemplateAttr attr;
+
+    const QStringList messages = {
+        QStringLiteral("Value  a = 1"),
+        QStringLiteral("Value  b = 22"),
+        QStringLiteral("Value  c = "),
+    };
+
+    for (const auto &message : messages) {
+        const auto text = attr.templateText(templateId(attr, message));
+        const auto params = MessageTemplateAttr::parameters(text, message);
+        QVERIFY(params.has_value());
+        QCOMPARE(MessageTemplateAttr::applyParameters(text, *params), message);
+    }
+}
+
+QTEST_MAIN(TestMessageTemplateAttr)
+#include "test_messagetemplateattr.moc"
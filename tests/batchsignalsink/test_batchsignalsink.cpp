@@ -0,0 +1,161 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+
+#include <thread>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/simplepipeline.h"
+#include "qtlogger/sinks/batchsignalsink.h"
+
+using namespace QtLogger;
+
+class BatchReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    QList<int> batchSizes;
+    QStringList messages;
+
+public slots:
+    void receive(const QVector<QtLogger::LogMessage> &lmsgs)
+    {
+        batchSizes.append(static_cast<int>(lmsgs.size()));
+        for (const auto &lmsg : lmsgs) {
+            messages.append(lmsg.message());
+        }
+    }
+};
+
+class TestBatchSignalSink : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testInterval();
+    void testMaxBatchSize();
+    void testFlush();
+    void testMaxPendingCount();
+    void testSendFromThread();
+    void testSendToBatchSignal();
+
+private:
+    LogMessage createLogMessage(const QString &message);
+};
+
+LogMessage TestBatchSignalSink::createLogMessage(const QString &message)
+{
+    return LogMessage(QtDebugMsg, QMessageLogContext(), message);
+}
+
+void TestBatchSignalSink::testInterval()
+{
+    auto sink = BatchSignalSink(50);
+    auto receiver = BatchReceiver();
+    QObject::connect(&sink, &BatchSignalSink::messages, &receiver, &BatchReceiver::receive);
+
+    for (int i = 0; i < 10; ++i) {
+        sink.send(createLogMessage(QString::number(i)));
+    }
+
+    // Nothing is emitted from send()
+    QVERIFY(receiver.batchSizes.isEmpty());
+
+    QTRY_COMPARE(receiver.batchSizes, QList<int>({ 10 }));
+    QCOMPARE(receiver.messages.first(), QStringLiteral("0"));
+    QCOMPARE(receiver.messages.last(), QStringLiteral("9"));
+}
+
+void TestBatchSignalSink::testMaxBatchSize()
+{
+    // The interval is long enough for the test to time out if it is waited for
+    auto sink = BatchSignalSink(60000, 100);
+    auto receiver = BatchReceiver();
+    QObject::connect(&sink, &BatchSignalSink::messages, &receiver, &BatchReceiver::receive);
+
+    for (int i = 0; i < 250; ++i) {
+        sink.send(createLogMessage(QString::number(i)));
+    }
+
+    // Full batches don't wait for the interval
+    QTRY_COMPARE(static_cast<int>(receiver.messages.size()), 250);
+    QCOMPARE(receiver.batchSizes, QList<int>({ 100, 100, 50 }));
+}
+
+void TestBatchSignalSink::testFlush()
+{
+    auto sink = BatchSignalSink(60000, 100);
+    QCOMPARE(sink.interval(), 60000);
+    QCOMPARE(sink.maxBatchSize(), 100);
+
+    auto receiver = BatchReceiver();
+    QObject::connect(&sink, &BatchSignalSink::messages, &receiver, &BatchReceiver::receive);
+
+    QVERIFY(sink.flush());
+    QVERIFY(receiver.batchSizes.isEmpty());
+
+    for (int i = 0; i < 30; ++i) {
+        sink.send(createLogMessage(QString::number(i)));
+    }
+
+    QVERIFY(sink.flush());
+    QCOMPARE(receiver.batchSizes, QList<int>({ 30 }));
+}
+
+void TestBatchSignalSink::testMaxPendingCount()
+{
+    auto sink = BatchSignalSink(60000, 1000);
+    sink.setMaxPendingCount(100);
+    QCOMPARE(sink.maxPendingCount(), 100);
+
+    auto receiver = BatchReceiver();
+    QObject::connect(&sink, &BatchSignalSink::messages, &receiver, &BatchReceiver::receive);
+
+    for (int i = 0; i < 500; ++i) {
+        sink.send(createLogMessage(QString::number(i)));
+    }
+    sink.flush();
+
+    // The oldest messages are dropped
+    QCOMPARE(static_cast<int>(receiver.messages.size()), 100);
+    QCOMPARE(receiver.messages.first(), QStringLiteral("400"));
+    QCOMPARE(receiver.messages.last(), QStringLiteral("499"));
+    QCOMPARE(sink.droppedCount(), quint64(400));
+}
+
+void TestBatchSignalSink::testSendFromThread()
+{
+    auto sink = BatchSignalSink(20, 1000);
+    auto receiver = BatchReceiver();
+    QObject::connect(&sink, &BatchSignalSink::messages, &receiver, &BatchReceiver::receive);
+
+    auto thread = std::thread([this, &sink]() {
+        for (int i = 0; i < 10000; ++i) {
+            sink.send(createLogMessage(QString::number(i)));
+        }
+    });
+    thread.join();
+
+    QTRY_COMPARE(static_cast<int>(receiver.messages.size()), 10000);
+    QCOMPARE(receiver.messages.last(), QStringLiteral("9999"));
+    QVERIFY(receiver.batchSizes.size() >= 10);
+    QVERIFY(receiver.batchSizes.size() < 20);
+}
+
+void TestBatchSignalSink::testSendToBatchSignal()
+{
+    auto receiver = BatchReceiver();
+
+    SimplePipeline pipeline;
+    pipeline.sendToBatchSignal(&receiver, SLOT(receive(QVector<QtLogger::LogMessage>)), 10);
+
+    auto lmsg = createLogMessage(QStringLiteral("pipeline message"));
+    QVERIFY(pipeline.process(lmsg));
+
+    QTRY_COMPARE(receiver.messages, QStringList({ QStringLiteral("pipeline message") }));
+}
+
+QTEST_MAIN(TestBatchSignalSink)
+#include "test_batchsignalsink.moc"
@@ -0,0 +1,471 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "qtlogger/attrhandlers/messagetemplateattr.h"
+#include "qtlogger/binarylog.h"
+#include "qtlogger/formatters/patternformatter.h"
+#include "qtlogger/logmessage.h"
+#include "qtlogger/sinks/binaryfilesink.h"
+
+using namespace QtLogger;
+
+class TestBinaryFileSink : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testRoundTrip();
+    void testTypedAttributes();
+    void testCallsiteDictionary();
+    void testAppendedSession();
+    void testRotation();
+    void testTruncatedFile();
+    void testTruncatedSession();
+    void testDamagedRecord();
+    void testDamagedMessageType();
+    void testUnknownFrameKind();
+    void testNotABinaryLog();
+    void testFormatDecodedMessage();
+    void testMessageTemplates();
+    void testSessionAttributes();
+
+private:
+    LogMessage createLogMessage(const QString &message, QtMsgType type = QtDebugMsg,
+                                int line = 42);
+    QList<LogMessage> readAll(const QString &path);
+
+    QTemporaryDir *m_tempDir = nullptr;
+};
+
+void TestBinaryFileSink::init()
+{
+    m_tempDir = new QTemporaryDir();
+    QVERIFY(m_tempDir->isValid());
+}
+
+void TestBinaryFileSink::cleanup()
+{
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+LogMessage TestBinaryFileSink::createLogMessage(const QString &message, QtMsgType type, int line)
+{
+    QMessageLogContext context("test.cpp", line, "void testFunction()", "test.category");
+    return LogMessage(type, context, message);
+}
+
+QList<LogMessage> TestBinaryFileSink::readAll(const QString &path)
+{
+    QList<LogMessage> result;
+    BinaryLogReader reader(path);
+    while (auto lmsg = reader.next()) {
+        result.append(*lmsg);
+    }
+    return result;
+}
+
+void TestBinaryFileSink::testRoundTrip()
+{
+    auto logPath = m_tempDir->filePath("test.qtlb");
+    auto original = createLogMessage(QStringLiteral("Hello, 世界"), QtWarningMsg);
+
+    {
+        BinaryFileSink sink(logPath);
+        sink.send(original);
+        sink.flush();
+    }
+
+    const auto messages = readAll(logPath);
+    QCOMPARE(messages.size(), 1);
+
+    const auto &lmsg = messages.first();
+    QCOMPARE(lmsg.type(), QtWarningMsg);
+    QCOMPARE(lmsg.message(), original.message());
+    QCOMPARE(QString::fromUtf8(lmsg.file()), QStringLiteral("test.cpp"));
+    QCOMPARE(lmsg.line(), 42);
+    QCOMPARE(QString::fromUtf8(lmsg.function()), QStringLiteral("void testFunction()"));
+    QCOMPARE(QString::fromUtf8(lmsg.category()), QStringLiteral("test.category"));
+    QCOMPARE(lmsg.time().toMSecsSinceEpoch(), original.time().toMSecsSinceEpoch());
+    QCOMPARE(lmsg.qthreadptr(), original.qthreadptr());
+}
+
+void TestBinaryFileSink::testTypedAttributes()
+{
+    auto logPath = m_tempDir->filePath("test.qtlb");
+    const auto dateTime = QDateTime::fromMSecsSinceEpoch(1700000000123);
+
+    {
+        BinaryFileSink sink(logPath);
+        auto lmsg = createLogMessage(QStringLiteral("attrs"));
+        lmsg.setAttribute(QStringLiteral("int"), -42);
+        lmsg.setAttribute(QStringLiteral("uint"), 42u);
+        lmsg.setAttribute(QStringLiteral("double"), 3.5);
+        lmsg.setAttribute(QStringLiteral("bool"), true);
+        lmsg.setAttribute(QStringLiteral("string"), QStringLiteral("value"));
+        lmsg.setAttribute(QStringLiteral("time"), dateTime);
+        lmsg.setAttribute(QStringLiteral("bytes"), QByteArray("\x00\x01", 2));
+        lmsg.setAttribute(QStringLiteral("null"), QVariant());
+        sink.send(lmsg);
+    }
+
+    const auto messages = readAll(logPath);
+    QCOMPARE(messages.size(), 1);
+
+    const auto &lmsg = messages.first();
+    QCOMPARE(lmsg.attribute(QStringLiteral("int")).toLongLong(), qlonglong(-42));
+    QCOMPARE(lmsg.attribute(QStringLiteral("uint")).toULongLong(), qulonglong(42));
+    QCOMPARE(lmsg.attribute(QStringLiteral("double")).toDouble(), 3.5);
+    QCOMPARE(lmsg.attribute(QStringLiteral("bool")).toBool(), true);
+    QCOMPARE(lmsg.attribute(QStringLiteral("string")).toString(), QStringLiteral("value"));
+    QCOMPARE(lmsg.attribute(QStringLiteral("time")).toDateTime(), dateTime);
+    QCOMPARE(lmsg.attribute(QStringLiteral("bytes")).toByteArray(), QByteArray("\x00\x01", 2));
+    QVERIFY(lmsg.hasAttribute(QStringLiteral("null")));
+    QVERIFY(!lmsg.attribute(QStringLiteral("null")).isValid());
+}
+
+void TestBinaryFileSink::testCallsiteDictionary()
+{
+    auto logPath = m_tempDir->filePath("test.qtlb");
+    const auto longFile = QByteArray(200, 'f');
+
+    {
+        BinaryFileSink sink(logPath);
+        for (int i = 0; i < 100; ++i) {
+            QMessageLogContext context(longFile.constData(), 1, "func", "cat");
+            sink.send(LogMessage(QtInfoMsg, context, QStringLiteral("m")));
+        }
+    }
+
+    // The file name is stored once, not per record
+    QVERIFY(QFileInfo(logPath).size() < 100 * longFile.size() / 10);
+
+    const auto messages = readAll(logPath);
+    QCOMPARE(messages.size(), 100);
+    QCOMPARE(QByteArray(messages.last().file()), longFile);
+}
+
+void TestBinaryFileSink::testAppendedSession()
+{
+    auto logPath = m_tempDir->filePath("test.qtlb");
+
+    {
+        BinaryFileSink sink(logPath);
+        sink.send(createLogMessage(QStringLiteral("first"), QtDebugMsg, 1));
+    }
+    {
+        BinaryFileSink sink(logPath);
+        sink.send(createLogMessage(QStringLiteral("second"), QtDebugMsg, 2));
+    }
+
+    const auto messages = readAll(logPath);
+    QCOMPARE(messages.size(), 2);
+    QCOMPARE(messages.at(0).message(), QStringLiteral("first"));
+    QCOMPARE(messages.at(0).line(), 1);
+    QCOMPARE(messages.at(1).message(), QStringLiteral("second"));
+    QCOMPARE(messages.at(1).line(), 2);
+}
+
+void TestBinaryFileSink::testRotation()
+{
+    auto logPath = m_tempDir->filePath("test.qtlb");
+
+    {
+        BinaryFileSink sink(logPath, 200, 0);
+        for (int i = 0; i < 50; ++i) {
+            sink.send(createLogMessage(QStringLiteral("Message number %1").arg(i)));
+        }
+    }
+
+    const auto entries = QDir(m_tempDir->path()).entryList(QDir::Files, QDir::Name);
+    QVERIFY(entries.size() > 1);
+
+    // Every rotated file is decodable on its own
+    int total = 0;
+    for (const auto &entry : entries) {
+        const auto path = m_tempDir->filePath(entry);
+        BinaryLogReader reader(path);
+        QVERIFY2(reader.isValid(), qPrintable(entry));
+        QVERIFY(QFileInfo(path).size() <= 200);
+        total += readAll(path).size();
+    }
+    QCOMPARE(total, 50);
+}
+
+void TestBinaryFileSink::testTruncatedFile()
+{
+    auto logPath = m_tempDir->filePath("test.qtlb");
+
+    {
+        BinaryFileSink sink(logPath);
+        sink.send(createLogMessage(QStringLiteral("complete")));
+        sink.send(createLogMessage(QStringLiteral("truncated")));
+    }
+
+    QFile file(logPath);
+    QVERIFY(file.resize(file.size() - 3));
+
+    const auto messages = readAll(logPath);
+    QCOMPARE(messages.size(), 1);
+    QCOMPARE(messages.first().message(), QStringLiteral("complete"));
+}
+
+void TestBinaryFileSink::testTruncatedSession()
+{
+    auto logPath = m_tempDir->filePath("test.qtlb");
+
+    {
+        BinaryFileSink sink(logPath);
+        sink.send(createLogMessage(QStringLiteral("complete")));
+        sink.send(createLogMessage(QStringLiteral("truncated")));
+    }
+
+    {
+        QFile file(logPath);
+        QVERIFY(file.resize(file.size() - 3));
+    }
+
+    // The session after a crash is appended to the truncated record
+    {
+        BinaryFileSink sink(logPath);
+        sink.send(createLogMessage(QStringLiteral("next session")));
+    }
+
+    BinaryLogReader reader(logPath);
+    QVERIFY(reader.isValid());
+
+    const auto first = reader.next();
+    QVERIFY(first);
+    QCOMPARE(first->message(), QStringLiteral("complete"));
+
+    const auto second = reader.next();
+    QVERIFY(second);
+    QCOMPARE(second->message(), QStringLiteral("next session"));
+
+    QVERIFY(!reader.next());
+    QCOMPARE(reader.damagedFrames(), 1);
+}
+
+void TestBinaryFileSink::testDamagedRecord()
+{
+    BinaryLogWriter writer;
+
+    auto lmsg = createLogMessage(QStringLiteral("damaged"));
+    lmsg.setAttribute(QStringLiteral("n"), 1);
+
+    QByteArray data = writer.encode(createLogMessage(QStringLiteral("first")));
+    auto damaged = writer.encode(lmsg);
+    const auto last = writer.encode(createLogMessage(QStringLiteral("last")));
+
+    // An unknown tag of the last attribute value
+    damaged[damaged.size() - 2] = static_cast<char>(0x7F);
+    data.append(damaged).append(last);
+
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    BinaryLogReader reader(&buffer);
+    QVERIFY(reader.isValid());
+
+    const auto first = reader.next();
+    QVERIFY(first);
+    QCOMPARE(first->message(), QStringLiteral("first"));
+
+    const auto second = reader.next();
+    QVERIFY(second);
+    QCOMPARE(second->message(), QStringLiteral("last"));
+
+    QVERIFY(!reader.next());
+    QVERIFY(reader.isValid());
+    QCOMPARE(reader.damagedFrames(), 1);
+}
+
+void TestBinaryFileSink::testDamagedMessageType()
+{
+    BinaryLogWriter writer;
+
+    QByteArray data = writer.encode(createLogMessage(QStringLiteral("first")));
+    auto damaged = writer.encode(createLogMessage(QStringLiteral("damaged")));
+    const auto last = writer.encode(createLogMessage(QStringLiteral("last")));
+
+    // The type follows the kind, the length and the time delta of the record
+    QCOMPARE(damaged.at(0), static_cast<char>(BinaryLog::RecordFrame));
+    int typePos = 2;
+    while (damaged.at(typePos) & 0x80) {
+        ++typePos;
+    }
+    ++typePos;
+    QCOMPARE(damaged.at(typePos), static_cast<char>(QtDebugMsg));
+    damaged[typePos] = static_cast<char>(0xC8);
+    data.append(damaged).append(last);
+
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    BinaryLogReader reader(&buffer);
+
+    const auto first = reader.next();
+    QVERIFY(first);
+    QCOMPARE(first->message(), QStringLiteral("first"));
+
+    const auto second = reader.next();
+    QVERIFY(second);
+    QCOMPARE(second->message(), QStringLiteral("last"));
+    QCOMPARE(second->type(), QtDebugMsg);
+
+    QVERIFY(!reader.next());
+    QCOMPARE(reader.damagedFrames(), 1);
+}
+
+void TestBinaryFileSink::testUnknownFrameKind()
+{
+    BinaryLogWriter writer;
+
+    QByteArray data = writer.encode(createLogMessage(QStringLiteral("first")));
+    data.append('Z').append(static_cast<char>(3)).append("abc");
+    data.append(writer.encode(createLogMessage(QStringLiteral("last"))));
+
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    BinaryLogReader reader(&buffer);
+
+    const auto first = reader.next();
+    QVERIFY(first);
+    QCOMPARE(first->message(), QStringLiteral("first"));
+
+    // Skipped by its length, the stream doesn't need to be resynchronized
+    const auto second = reader.next();
+    QVERIFY(second);
+    QCOMPARE(second->message(), QStringLiteral("last"));
+
+    QVERIFY(!reader.next());
+    QVERIFY(reader.isValid());
+    QCOMPARE(reader.damagedFrames(), 1);
+}
+
+void TestBinaryFileSink::testNotABinaryLog()
+{
+    auto logPath = m_tempDir->filePath("test.log");
+
+    QFile file(logPath);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("plain text log\n");
+    file.close();
+
+    BinaryLogReader reader(logPath);
+    QVERIFY(!reader.isValid());
+    QVERIFY(!reader.errorString().isEmpty());
+    QVERIFY(!reader.next());
+}
+
+void TestBinaryFileSink::testFormatDecodedMessage()
+{
+    auto logPath = m_tempDir->filePath("test.qtlb");
+
+    {
+        BinaryFileSink sink(logPath);
+        auto lmsg = createLogMessage(QStringLiteral("formatted"), QtCriticalMsg);
+        lmsg.setAttribute(QStringLiteral("seq"), 7);
+        sink.send(lmsg);
+    }
+
+    const auto messages = readAll(logPath);
+    QCOMPARE(messages.size(), 1);
+
+    PatternFormatter formatter(QStringLiteral("%{type} [%{category}] %{func}:%{line} #%{seq} %{message}"));
+    QCOMPARE(formatter.format(messages.first()),
+             QStringLiteral("critical [test.category] testFunction:42 #7 formatted"));
+}
+
+void TestBinaryFileSink::testMessageTemplates()
+{
+    auto logPath = m_tempDir->filePath("test.qtlb");
+    auto plainPath = m_tempDir->filePath("plain.qtlb");
+    auto templates = MessageTemplateAttrPtr::create();
+
+    QStringList sent;
+    {
+        BinaryFileSink sink(logPath);
+        sink.setMessageTemplates(templates);
+        BinaryFileSink plainSink(plainPath);
+
+        for (int i = 0; i < 100; ++i) {
+            const auto message = i % 2
+                    ? QStringLiteral("Connection to server number %1 established in %2 ms")
+                              .arg(i)
+                              .arg(i * 3)
+                    : QStringLiteral("Request %1 completed with status ok").arg(i);
+            auto lmsg = createLogMessage(message);
+            templates->process(lmsg);
+            sink.send(lmsg);
+            plainSink.send(lmsg);
+            sent.append(message);
+        }
+    }
+
+    QVERIFY(QFileInfo(logPath).size() < QFileInfo(plainPath).size());
+
+    const auto messages = readAll(logPath);
+    QCOMPARE(messages.size(), sent.size());
+    for (int i = 0; i < sent.size(); ++i) {
+        QCOMPARE(messages.at(i).message(), sent.at(i));
+        QVERIFY(messages.at(i).hasAttribute(QStringLiteral("template_id")));
+    }
+    QCOMPARE(templates->templates().size(), 2);
+}
+
+void TestBinaryFileSink::testSessionAttributes()
+{
+    BinaryLogWriter writer;
+    writer.setSessionAttributes({ { "appname", "writer" }, { "pid", 1234 } });
+
+    auto lmsg = createLogMessage("Own pid");
+    lmsg.setAttribute("pid", 5678);
+
+    QByteArray data;
+    data.append(writer.encode(createLogMessage("First")));
+    data.append(writer.encode(lmsg));
+
+    // A new session without session attributes
+    writer.reset();
+    writer.setSessionAttributes({});
+    data.append(writer.encode(createLogMessage("Next session")));
+
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    BinaryLogReader reader(&buffer);
+    QVERIFY(reader.isValid());
+
+    const auto first = reader.next();
+    QVERIFY(first);
+    QCOMPARE(first->attribute("appname").toString(), QString("writer"));
+    QCOMPARE(first->attribute("pid").toLongLong(), 1234LL);
+
+    const auto second = reader.next();
+    QVERIFY(second);
+    QCOMPARE(second->attribute("appname").toString(), QString("writer"));
+    QCOMPARE(second->attribute("pid").toLongLong(), 5678LL);
+
+    const auto third = reader.next();
+    QVERIFY(third);
+    QCOMPARE(third->message(), QString("Next session"));
+    QVERIFY(!third->hasAttribute("appname"));
+
+    QVERIFY(!reader.next());
+    QVERIFY(reader.isValid());
+}
+
+QTEST_MAIN(TestBinaryFileSink)
+#include "test_binaryfilesink.moc"
@@ -0,0 +1,282 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QBuffer>
+#include <QCborMap>
+#include <QCborValue>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+#include "qtlogger/formatters/cborformatter.h"
+#include "qtlogger/formatters/patternformatter.h"
+#include "qtlogger/logmessage.h"
+#include "qtlogger/pipeline.h"
+#include "qtlogger/sinks/iodevicesink.h"
+#include "qtlogger/sinks/rotatingfilesink.h"
+
+using namespace QtLogger;
+
+class TestCborFormatter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testMessageFields();
+    void testTypedAttributes();
+    void testAttributeOverridesField();
+    void testFormattedDataReplacesMessage();
+    void testScopedPipelineKeepsData();
+    void testNewlineFraming();
+    void testLengthPrefixedFraming();
+    void testLengthPrefixedText();
+    void testRotatingFileSinkTextMode();
+    void testTextModeRestored();
+
+private:
+    LogMessage createLogMessage(const QString &message, QtMsgType type = QtDebugMsg);
+    QCborMap decode(const QByteArray &data);
+};
+
+LogMessage TestCborFormatter::createLogMessage(const QString &message, QtMsgType type)
+{
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", "test.category");
+    return LogMessage(type, context, message);
+}
+
+QCborMap TestCborFormatter::decode(const QByteArray &data)
+{
+    QCborParserError error;
+    const auto value = QCborValue::fromCbor(data, &error);
+    if (error.error != QCborError::NoError)
+        return {};
+    return value.toMap();
+}
+
+void TestCborFormatter::testMessageFields()
+{
+    auto lmsg = createLogMessage(QStringLiteral("Hello, 世界"), QtWarningMsg);
+
+    CborFormatter formatter;
+    const auto map = decode(formatter.format(lmsg));
+
+    QCOMPARE(map.value(QStringLiteral("type")).toString(), QStringLiteral("warning"));
+    QCOMPARE(map.value(QStringLiteral("message")).toString(), QStringLiteral("Hello, 世界"));
+    QCOMPARE(map.value(QStringLiteral("file")).toString(), QStringLiteral("test.cpp"));
+    QCOMPARE(map.value(QStringLiteral("line")).toInteger(), qint64(42));
+    QCOMPARE(map.value(QStringLiteral("function")).toString(),
+             QStringLiteral("void testFunction()"));
+    QCOMPARE(map.value(QStringLiteral("category")).toString(), QStringLiteral("test.category"));
+
+    const auto time = map.value(QStringLiteral("time")).toDateTime();
+    QVERIFY(time.isValid());
+    QVERIFY(qAbs(time.toMSecsSinceEpoch() - lmsg.time().toMSecsSinceEpoch()) <= 1);
+
+#ifndef QTLOGGER_NO_THREAD
+    QCOMPARE(static_cast<quint64>(map.value(QStringLiteral("threadId")).toInteger()),
+             lmsg.threadId());
+#endif
+}
+
+void TestCborFormatter::testTypedAttributes()
+{
+    auto lmsg = createLogMessage(QStringLiteral("attrs"));
+    lmsg.setAttribute(QStringLiteral("int"), -42);
+    lmsg.setAttribute(QStringLiteral("double"), 3.5);
+    lmsg.setAttribute(QStringLiteral("bool"), true);
+    lmsg.setAttribute(QStringLiteral("string"), QStringLiteral("value"));
+    lmsg.setAttribute(QStringLiteral("bytes"), QByteArray("\x00\x01", 2));
+    lmsg.setAttribute(QStringLiteral("list"), QStringList { QStringLiteral("a"), QStringLiteral("b") });
+    lmsg.setAttribute(QStringLiteral("null"), QVariant());
+
+    CborFormatter formatter;
+    const auto map = decode(formatter.format(lmsg));
+
+    QVERIFY(map.value(QStringLiteral("int")).isInteger());
+    QCOMPARE(map.value(QStringLiteral("int")).toInteger(), qint64(-42));
+    QVERIFY(map.value(QStringLiteral("double")).isDouble());
+    QCOMPARE(map.value(QStringLiteral("double")).toDouble(), 3.5);
+    QVERIFY(map.value(QStringLiteral("bool")).isTrue());
+    QCOMPARE(map.value(QStringLiteral("string")).toString(), QStringLiteral("value"));
+    QCOMPARE(map.value(QStringLiteral("bytes")).toByteArray(), QByteArray("\x00\x01", 2));
+    QCOMPARE(map.value(QStringLiteral("list")).toArray().size(), 2);
+    QVERIFY(map.value(QStringLiteral("null")).isNull());
+}
+
+void TestCborFormatter::testAttributeOverridesField()
+{
+    auto lmsg = createLogMessage(QStringLiteral("original"));
+    lmsg.setAttribute(QStringLiteral("message"), QStringLiteral("overridden"));
+
+    CborFormatter formatter;
+    const auto map = decode(formatter.format(lmsg));
+
+    QCOMPARE(map.value(QStringLiteral("message")).toString(), QStringLiteral("overridden"));
+    QCOMPARE(int(map.size()), int(lmsg.allAttributes().size()));
+}
+
+void TestCborFormatter::testFormattedDataReplacesMessage()
+{
+    auto lmsg = createLogMessage(QStringLiteral("message"));
+
+    CborFormatter::instance()->process(lmsg);
+    QVERIFY(lmsg.hasFormattedData());
+    QVERIFY(!lmsg.isFormatted());
+
+    lmsg.setFormattedMessage(QStringLiteral("text"));
+    QVERIFY(!lmsg.hasFormattedData());
+    QCOMPARE(lmsg.formattedMessage(), QStringLiteral("text"));
+}
+
+void TestCborFormatter::testScopedPipelineKeepsData()
+{
+    auto buffer = QSharedPointer<QBuffer>::create();
+    buffer->open(QIODevice::WriteOnly);
+
+    auto scoped = PipelinePtr::create(
+            std::initializer_list<HandlerPtr> { PatternFormatterPtr::create("%{message}") }, true);
+
+    Pipeline pipeline { CborFormatter::instance(), scoped, IODeviceSinkPtr::create(buffer) };
+
+    auto lmsg = createLogMessage(QStringLiteral("message"));
+    pipeline.process(lmsg);
+
+    // The text of the scoped pipeline doesn't replace the CBOR item of the outer one
+    QVERIFY(lmsg.hasFormattedData());
+    QVERIFY(!buffer->data().isEmpty());
+    QCOMPARE(buffer->data(), lmsg.formattedData());
+    QCOMPARE(decode(buffer->data()).value(QStringLiteral("message")).toString(),
+             QStringLiteral("message"));
+}
+
+void TestCborFormatter::testNewlineFraming()
+{
+    auto buffer = QSharedPointer<QBuffer>::create();
+    buffer->open(QIODevice::WriteOnly);
+
+    IODeviceSink sink(buffer);
+    QCOMPARE(sink.framing(), IODeviceSink::Framing::Newline);
+
+    auto lmsg1 = createLogMessage(QStringLiteral("first"));
+    auto lmsg2 = createLogMessage(QStringLiteral("second"));
+    CborFormatter::instance()->process(lmsg1);
+    CborFormatter::instance()->process(lmsg2);
+    sink.process(lmsg1);
+    sink.process(lmsg2);
+
+    // CBOR items are self-delimiting, they are written as a CBOR sequence
+    QCOMPARE(buffer->data(), lmsg1.formattedData() + lmsg2.formattedData());
+}
+
+void TestCborFormatter::testLengthPrefixedFraming()
+{
+    auto buffer = QSharedPointer<QBuffer>::create();
+    buffer->open(QIODevice::WriteOnly | QIODevice::Text);
+
+    IODeviceSink sink(buffer);
+    sink.setFraming(IODeviceSink::Framing::LengthPrefixed);
+    QVERIFY(!buffer->isTextModeEnabled());
+
+    const QStringList messages = { QStringLiteral("first"), QStringLiteral("second\nline") };
+    for (const auto &message : messages) {
+        auto lmsg = createLogMessage(message);
+        CborFormatter::instance()->process(lmsg);
+        sink.process(lmsg);
+    }
+
+    const auto data = buffer->data();
+    int pos = 0;
+    for (const auto &message : messages) {
+        QVERIFY(pos + 4 <= data.size());
+        const auto size = qFromBigEndian<quint32>(data.constData() + pos);
+        pos += 4;
+        QVERIFY(pos + static_cast<int>(size) <= data.size());
+
+        const auto map = decode(data.mid(pos, static_cast<int>(size)));
+        QCOMPARE(map.value(QStringLiteral("message")).toString(), message);
+        pos += static_cast<int>(size);
+    }
+    QCOMPARE(pos, data.size());
+}
+
+void TestCborFormatter::testLengthPrefixedText()
+{
+    auto buffer = QSharedPointer<QBuffer>::create();
+    buffer->open(QIODevice::WriteOnly);
+
+    IODeviceSink sink(buffer);
+    sink.setFraming(IODeviceSink::Framing::LengthPrefixed);
+
+    auto lmsg = createLogMessage(QStringLiteral("ignored"));
+    lmsg.setFormattedMessage(QStringLiteral("text message"));
+    sink.process(lmsg);
+
+    QByteArray expected("\x00\x00\x00\x0c", 4);
+    expected.append("text message");
+    QCOMPARE(buffer->data(), expected);
+}
+
+void TestCborFormatter::testRotatingFileSinkTextMode()
+{
+    class TextModeSink : public RotatingFileSink
+    {
+    public:
+        using RotatingFileSink::RotatingFileSink;
+        bool isTextModeEnabled() const { return file()->isTextModeEnabled(); }
+    };
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto path = dir.filePath(QStringLiteral("app.log"));
+
+    QByteArray written;
+    {
+        TextModeSink sink(path);
+        auto lmsg = createLogMessage(QStringLiteral("first\nsecond"));
+        CborFormatter::instance()->process(lmsg);
+        sink.process(lmsg);
+        written = lmsg.formattedData();
+
+        // Opened as a text file, but binary output is written unchanged
+        QVERIFY(!sink.isTextModeEnabled());
+    }
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), written);
+}
+
+void TestCborFormatter::testTextModeRestored()
+{
+    auto buffer = QSharedPointer<QBuffer>::create();
+    buffer->open(QIODevice::WriteOnly | QIODevice::Text);
+
+    IODeviceSink sink(buffer);
+
+    auto binary = createLogMessage(QStringLiteral("binary"));
+    CborFormatter::instance()->process(binary);
+    sink.process(binary);
+    QVERIFY(!buffer->isTextModeEnabled());
+
+    auto text = createLogMessage(QStringLiteral("ignored"));
+    text.setFormattedMessage(QStringLiteral("text"));
+    sink.process(text);
+    QVERIFY(buffer->isTextModeEnabled());
+
+    sink.setFraming(IODeviceSink::Framing::LengthPrefixed);
+    QVERIFY(!buffer->isTextModeEnabled());
+    sink.setFraming(IODeviceSink::Framing::Newline);
+    QVERIFY(buffer->isTextModeEnabled());
+
+    // A device opened without the text mode keeps it disabled
+    auto rawBuffer = QSharedPointer<QBuffer>::create();
+    rawBuffer->open(QIODevice::WriteOnly);
+
+    IODeviceSink rawSink(rawBuffer);
+    rawSink.process(binary);
+    rawSink.process(text);
+    QVERIFY(!rawBuffer->isTextModeEnabled());
+}
+
+QTEST_MAIN(TestCborFormatter)
+#include "test_cborformatter.moc"
@@ -6,6 +6,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QRegularExpression>
+#include <QBuffer>
 
 #include "qtlogger.h"
 #include "mock_logmessage.h"
@@ -16,6 +17,7 @@
 #include "qtlogger/formatters/jsonformatter.h"
 
 #include "qtlogger/formatters/prettyformatter.h"
+#include "qtlogger/sinks/iodevicesink.h"
 
 using namespace QtLogger;
 using namespace QtLogger::Test;
@@ -53,6 +55,8 @@ private slots:
     void testPrettyFormatterDifferentCategories();
     void testPrettyFormatterDefaultCategory();
     void testPrettyFormatterLongCategory();
+    void testPrettyFormatterPlainRendering();
+    void testPrettyFormatterThreadEviction();
 
     // Base Formatter interface tests
     void testFormatterInterface();
@@ -385,6 +389,77 @@ void TestFormatters::testPrettyFormatterLongCategory()
     QVERIFY(formatted.contains("E"));  // Critical uses "E" in pretty formatter
 }
 
+void TestFormatters::testPrettyFormatterPlainRendering()
+{
+    PrettyFormatter colored(true, 0);
+    PrettyFormatter plain(false, 0);
+
+    auto msg = MockLogMessage::createWithCategory("network", QtWarningMsg, "Plain rendering");
+
+    // Both renderings in the same pass
+    QVERIFY(colored.process(msg));
+    QVERIFY(msg.formattedMessage().contains("\033["));
+    QCOMPARE(msg.plainFormattedMessage(), plain.format(msg));
+    QVERIFY(!msg.plainFormattedMessage().contains(QLatin1Char('\033')));
+
+    // Without colors, the formatted message is the plain one
+    QVERIFY(plain.process(msg));
+    QCOMPARE(msg.plainFormattedMessage(), msg.formattedMessage());
+
+    // A later formatter replaces both
+    QVERIFY(colored.process(msg));
+    QVERIFY(PatternFormatter("%{message}").process(msg));
+    QCOMPARE(msg.formattedMessage(), QString("Plain rendering"));
+    QCOMPARE(msg.plainFormattedMessage(), QString("Plain rendering"));
+
+    // Device sinks keep the colors unless asked for plain text
+    QVERIFY(colored.process(msg));
+    auto buffer = QSharedPointer<QBuffer>::create();
+    buffer->open(QIODevice::WriteOnly);
+    IODeviceSink sink(buffer);
+    QVERIFY(!sink.plainText());
+    sink.process(msg);
+    QCOMPARE(QString::fromLocal8Bit(buffer->data()), msg.formattedMessage() + QLatin1Char('\n'));
+
+    buffer->buffer().clear();
+    buffer->seek(0);
+    sink.setPlainText(true);
+    sink.process(msg);
+    QCOMPARE(QString::fromLocal8Bit(buffer->data()),
+             msg.plainFormattedMessage() + QLatin1Char('\n'));
+}
+
+void TestFormatters::testPrettyFormatterThreadEviction()
+{
+    PrettyFormatter formatter(false, 0);
+
+    // Index of the thread in the output, -1 for the first thread which has none
+    const auto threadIndex = [&formatter](quintptr thread) {
+        QMessageLogContext context("test.cpp", 1, "test", "test");
+        const auto formatted = formatter.format(LogMessage(
+                QtInfoMsg, context, "message", QDateTime::currentDateTime(), thread));
+        const auto match = QRegularExpression(" T(\\d+) ").match(formatted);
+        return match.hasMatch() ? match.captured(1).toInt() : -1;
+    };
+
+    for (quintptr thread = 1; thread <= quintptr(PrettyFormatter::MaxThreads); ++thread) {
+        QCOMPARE(threadIndex(thread), thread == 1 ? -1 : static_cast<int>(thread) - 1);
+    }
+
+    // The second thread logs again, the third one is the least recently used
+    QCOMPARE(threadIndex(2), 1);
+    QCOMPARE(threadIndex(1000), 2);
+    QCOMPARE(threadIndex(3), 3);
+    QCOMPARE(threadIndex(2), 1);
+
+    // Short-lived threads never grow the table, the first thread keeps its index
+    for (quintptr thread = 2000; thread < 3000; ++thread) {
+        const auto index = threadIndex(thread);
+        QVERIFY(index > 0 && index < PrettyFormatter::MaxThreads);
+    }
+    QCOMPARE(threadIndex(1), -1);
+}
+
 // Base Formatter Interface Tests
 
 void TestFormatters::testFormatterInterface()
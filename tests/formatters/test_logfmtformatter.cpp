@@ -0,0 +1,177 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+
+#include "qtlogger/formatters/logfmtformatter.h"
+#include "qtlogger/logmessage.h"
+
+using namespace QtLogger;
+
+class TestLogfmtFormatter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testBasicFields();
+    void testQuoting_data();
+    void testQuoting();
+    void testTypedAttributes();
+    void testAttributeKeys();
+    void testAttributeControlCharacters();
+    void testReservedAttributeKeys();
+    void testCallsite();
+    void testEmptyCategory();
+
+private:
+    LogMessage createLogMessage(const QString &message, const char *category = "test.category",
+                                QtMsgType type = QtDebugMsg);
+    QString timeField(const LogMessage &lmsg);
+};
+
+LogMessage TestLogfmtFormatter::createLogMessage(const QString &message, const char *category,
+                                                 QtMsgType type)
+{
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", category);
+    return LogMessage(type, context, message);
+}
+
+QString TestLogfmtFormatter::timeField(const LogMessage &lmsg)
+{
+    return QStringLiteral("time=") + lmsg.time().toString(Qt::ISODateWithMs);
+}
+
+void TestLogfmtFormatter::testBasicFields()
+{
+    auto lmsg = createLogMessage(QStringLiteral("Started"), "app.core", QtWarningMsg);
+
+    LogfmtFormatter formatter;
+    QCOMPARE(formatter.format(lmsg),
+             timeField(lmsg) + QStringLiteral(" level=warning category=app.core msg=Started"));
+}
+
+void TestLogfmtFormatter::testQuoting_data()
+{
+    QTest::addColumn<QString>("message");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("plain") << QStringLiteral("ok") << QStringLiteral("msg=ok");
+    QTest::newRow("empty") << QString() << QStringLiteral("msg=\"\"");
+    QTest::newRow("space") << QStringLiteral("two words") << QStringLiteral("msg=\"two words\"");
+    QTest::newRow("equals") << QStringLiteral("a=b") << QStringLiteral("msg=\"a=b\"");
+    QTest::newRow("quote") << QStringLiteral("say \"hi\"")
+                           << QStringLiteral("msg=\"say \\\"hi\\\"\"");
+    QTest::newRow("backslash") << QStringLiteral("C:\\dir x")
+                               << QStringLiteral("msg=\"C:\\\\dir x\"");
+    QTest::newRow("newline") << QStringLiteral("line1\nline2")
+                             << QStringLiteral("msg=\"line1\\nline2\"");
+    QTest::newRow("tab") << QStringLiteral("a\tb") << QStringLiteral("msg=\"a\\tb\"");
+    QTest::newRow("carriage return")
+            << QStringLiteral("a\rb") << QStringLiteral("msg=\"a\\rb\"");
+    QTest::newRow("control") << QStringLiteral("a\x01" "b\x1b[0m")
+                             << QStringLiteral("msg=\"a\\u0001b\\u001b[0m\"");
+    QTest::newRow("delete") << QStringLiteral("a\x7f") << QStringLiteral("msg=\"a\\u007f\"");
+    QTest::newRow("unicode") << QStringLiteral("привет") << QStringLiteral("msg=привет");
+}
+
+void TestLogfmtFormatter::testQuoting()
+{
+    QFETCH(QString, message);
+    QFETCH(QString, expected);
+
+    auto lmsg = createLogMessage(message);
+
+    LogfmtFormatter formatter;
+    QVERIFY2(formatter.format(lmsg).endsWith(QLatin1Char(' ') + expected),
+             qPrintable(formatter.format(lmsg)));
+}
+
+void TestLogfmtFormatter::testTypedAttributes()
+{
+    auto lmsg = createLogMessage(QStringLiteral("m"));
+    lmsg.setAttribute(QStringLiteral("int"), -42);
+    lmsg.setAttribute(QStringLiteral("double"), 0.1);
+    lmsg.setAttribute(QStringLiteral("bool"), true);
+    lmsg.setAttribute(QStringLiteral("string"), QStringLiteral("hello world"));
+    lmsg.setAttribute(QStringLiteral("list"),
+                      QStringList { QStringLiteral("a"), QStringLiteral("b") });
+
+    LogfmtFormatter formatter;
+    const auto result = formatter.format(lmsg);
+
+    QVERIFY(result.contains(QStringLiteral(" int=-42")));
+    QVERIFY(result.contains(QStringLiteral(" double=0.1")));
+    QVERIFY(result.contains(QStringLiteral(" bool=true")));
+    QVERIFY(result.contains(QStringLiteral(" string=\"hello world\"")));
+    QVERIFY(result.contains(QStringLiteral(" list=a,b")));
+}
+
+void TestLogfmtFormatter::testAttributeKeys()
+{
+    auto lmsg = createLogMessage(QStringLiteral("m"));
+    lmsg.setAttribute(QStringLiteral("user name"), QStringLiteral("bob"));
+    lmsg.setAttribute(QStringLiteral("a=b"), 1);
+
+    LogfmtFormatter formatter;
+    const auto result = formatter.format(lmsg);
+
+    QVERIFY(result.contains(QStringLiteral(" user_name=bob")));
+    QVERIFY(result.contains(QStringLiteral(" a_b=1")));
+}
+
+void TestLogfmtFormatter::testAttributeControlCharacters()
+{
+    auto lmsg = createLogMessage(QStringLiteral("m"));
+    lmsg.setAttribute(QStringLiteral("key\nname"), QStringLiteral("first\r\nsecond\x02"));
+
+    LogfmtFormatter formatter;
+    const auto result = formatter.format(lmsg);
+
+    QVERIFY(!result.contains(QLatin1Char('\n')));
+    QVERIFY(!result.contains(QLatin1Char('\r')));
+    QVERIFY(result.endsWith(QStringLiteral(" key_name=\"first\\r\\nsecond\\u0002\"")));
+}
+
+void TestLogfmtFormatter::testReservedAttributeKeys()
+{
+    auto lmsg = createLogMessage(QStringLiteral("m"), "app");
+    lmsg.setAttribute(QStringLiteral("msg"), QStringLiteral("other"));
+    lmsg.setAttribute(QStringLiteral("level"), 5);
+    lmsg.setAttribute(QStringLiteral("file"), QStringLiteral("data.txt"));
+
+    const auto result = LogfmtFormatter().format(lmsg);
+    QCOMPARE(result.count(QStringLiteral(" msg=")), 1);
+    QCOMPARE(result.count(QStringLiteral(" level=")), 1);
+    QVERIFY(result.contains(QStringLiteral(" msg=m")));
+    QVERIFY(result.contains(QStringLiteral(" attr_msg=other")));
+    QVERIFY(result.contains(QStringLiteral(" attr_level=5")));
+    // No callsite is written, so the attribute keeps its name
+    QVERIFY(result.contains(QStringLiteral(" file=data.txt")));
+
+    const auto withCallsite = LogfmtFormatter(/* withCallsite */ true).format(lmsg);
+    QCOMPARE(withCallsite.count(QStringLiteral(" file=")), 1);
+    QVERIFY(withCallsite.contains(QStringLiteral(" file=test.cpp")));
+    QVERIFY(withCallsite.contains(QStringLiteral(" attr_file=data.txt")));
+}
+
+void TestLogfmtFormatter::testCallsite()
+{
+    auto lmsg = createLogMessage(QStringLiteral("m"));
+
+    QVERIFY(!LogfmtFormatter().format(lmsg).contains(QStringLiteral("file=")));
+
+    LogfmtFormatter formatter(/* withCallsite */ true);
+    QVERIFY(formatter.format(lmsg).endsWith(
+            QStringLiteral(" msg=m file=test.cpp line=42 func=\"void testFunction()\"")));
+}
+
+void TestLogfmtFormatter::testEmptyCategory()
+{
+    auto lmsg = createLogMessage(QStringLiteral("m"), "");
+
+    LogfmtFormatter formatter;
+    QCOMPARE(formatter.format(lmsg), timeField(lmsg) + QStringLiteral(" level=debug msg=m"));
+}
+
+QTEST_MAIN(TestLogfmtFormatter)
+#include "test_logfmtformatter.moc"
@@ -42,6 +42,9 @@ private slots:
     void testPatternFormatterWithShortfile();
     void testPatternFormatterWithShortfileBaseDir();
 
+    // Callsite cache tests
+    void testPatternFormatterCallsiteCache();
+
     // Thread tests
     void testPatternFormatterWithQThreadPtr();
 
@@ -340,6 +343,29 @@ void TestPatternFormatter::testPatternFormatterWithShortfileBaseDir()
     QVERIFY(formatted2.contains("/home/user/project/src/file.cpp:456"));
 }
 
+void TestPatternFormatter::testPatternFormatterCallsiteCache()
+{
+    PatternFormatter formatter("%{func}|%{function}|%{shortfile}|%{line}");
+
+    const auto first = QString("First::run|void First::run(int)|first.cpp|10");
+    QCOMPARE(formatter.format(MockLogMessage::create(QtDebugMsg, "Test", "/src/a/first.cpp", 10,
+                                                     "void First::run(int)")),
+             first);
+
+    // The mock reuses its buffers, so the same pointers hold another callsite
+    auto msg = MockLogMessage::create(QtDebugMsg, "Test", "/src/b/second.cpp", 20,
+                                      "int Second::value() const");
+    const auto second = QString("Second::value|int Second::value() const|second.cpp|20");
+    QCOMPARE(formatter.format(msg), second);
+
+    // Cached values
+    QCOMPARE(formatter.format(msg), second);
+    QCOMPARE(formatter.format(LogMessage(msg)), second);
+    QCOMPARE(formatter.format(MockLogMessage::create(QtDebugMsg, "Test", "/src/a/first.cpp", 10,
+                                                     "void First::run(int)")),
+             first);
+}
+
 void TestPatternFormatter::testPatternFormatterWithQThreadPtr()
 {
     QString pattern = "Thread: %{qthreadptr} - %{message}";
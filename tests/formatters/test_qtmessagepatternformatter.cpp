@@ -0,0 +1,178 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QCoreApplication>
+#include <QRegularExpression>
+
+#include "qtlogger/backtrace.h"
+#include "qtlogger/formatters/qtmessagepatternformatter.h"
+#include "qtlogger/logmessage.h"
+
+using namespace QtLogger;
+
+class TestQtMessagePatternFormatter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testMatchesQt_data();
+    void testMatchesQt();
+    void testUnknownCallsite();
+    void testAppInfo();
+    void testTime();
+    void testBacktrace();
+    void testBacktraceReleased();
+    void testDefaultPattern();
+
+private:
+    QString qtFormat(const QString &pattern, const LogMessage &lmsg);
+};
+
+void TestQtMessagePatternFormatter::initTestCase()
+{
+    QCoreApplication::setApplicationName(QStringLiteral("patterntest"));
+}
+
+void TestQtMessagePatternFormatter::cleanupTestCase()
+{
+    qSetMessagePattern(QString());
+    Backtrace::disableCapture();
+}
+
+QString TestQtMessagePatternFormatter::qtFormat(const QString &pattern, const LogMessage &lmsg)
+{
+    qSetMessagePattern(pattern);
+    return qFormatLogMessage(lmsg.type(), lmsg.context(), lmsg.message());
+}
+
+void TestQtMessagePatternFormatter::testMatchesQt_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<int>("type");
+    QTest::addColumn<QByteArray>("category");
+
+    const auto callsite = QStringLiteral("%{type} %{file}:%{line} %{function}: %{message}");
+    const auto category = QStringLiteral("%{if-category}%{category}: %{endif}%{message}");
+    const auto conditions = QStringLiteral("%{if-debug}D%{endif}%{if-info}I%{endif}"
+                                           "%{if-warning}W%{endif}%{if-critical}C%{endif} "
+                                           "%{message}");
+
+    QTest::newRow("callsite") << callsite << int(QtWarningMsg) << QByteArray("app.net");
+    QTest::newRow("category") << category << int(QtDebugMsg) << QByteArray("app.net");
+    QTest::newRow("default category") << category << int(QtDebugMsg) << QByteArray("default");
+    QTest::newRow("debug") << conditions << int(QtDebugMsg) << QByteArray("default");
+    QTest::newRow("info") << conditions << int(QtInfoMsg) << QByteArray("default");
+    QTest::newRow("critical") << conditions << int(QtCriticalMsg) << QByteArray("default");
+    QTest::newRow("literals") << QStringLiteral("[%{pid}] %% %{appname}: %{message} %")
+                              << int(QtInfoMsg) << QByteArray("default");
+}
+
+void TestQtMessagePatternFormatter::testMatchesQt()
+{
+    QFETCH(QString, pattern);
+    QFETCH(int, type);
+    QFETCH(QByteArray, category);
+
+    QMessageLogContext context("src/net/client.cpp", 128,
+                               "bool Client::connectTo(const QString &, int)",
+                               category.constData());
+    const auto lmsg = LogMessage(static_cast<QtMsgType>(type), context, QStringLiteral("hello"));
+
+    QtMessagePatternFormatter formatter(pattern);
+    QCOMPARE(formatter.format(lmsg), qtFormat(pattern, lmsg));
+}
+
+void TestQtMessagePatternFormatter::testUnknownCallsite()
+{
+    const auto pattern = QStringLiteral("%{file}:%{line} %{function} %{message}");
+
+    QMessageLogContext context(nullptr, 0, nullptr, "default");
+    const auto lmsg = LogMessage(QtInfoMsg, context, QStringLiteral("no context"));
+
+    QtMessagePatternFormatter formatter(pattern);
+    QCOMPARE(formatter.format(lmsg), QStringLiteral("unknown:0 unknown no context"));
+    QCOMPARE(formatter.format(lmsg), qtFormat(pattern, lmsg));
+}
+
+void TestQtMessagePatternFormatter::testAppInfo()
+{
+    QtMessagePatternFormatter formatter(QStringLiteral("%{appname} %{pid}"));
+
+    QMessageLogContext context("test.cpp", 1, "void test()", "default");
+    auto lmsg = LogMessage(QtInfoMsg, context, QStringLiteral("Test"));
+    QCOMPARE(formatter.format(lmsg),
+             QStringLiteral("patterntest %1").arg(QCoreApplication::applicationPid()));
+
+    // Set by AppInfoAttrs, e.g. of a message recorded in another process
+    lmsg.setAttribute(QStringLiteral("appname"), QStringLiteral("recorded"));
+    lmsg.setAttribute(QStringLiteral("pid"), 4242);
+    QCOMPARE(formatter.format(lmsg), QStringLiteral("recorded 4242"));
+}
+
+void TestQtMessagePatternFormatter::testTime()
+{
+    QMessageLogContext context("test.cpp", 1, "void test()", "default");
+    const auto lmsg = LogMessage(QtInfoMsg, context, QStringLiteral("Test"));
+
+    static const QRegularExpression seconds(QStringLiteral("^ *\\d+\\.\\d{3}$"));
+    QVERIFY(seconds.match(QtMessagePatternFormatter(QStringLiteral("%{time process}"))
+                                  .format(lmsg))
+                    .hasMatch());
+    QVERIFY(seconds.match(QtMessagePatternFormatter(QStringLiteral("%{time boot}")).format(lmsg))
+                    .hasMatch());
+
+    QCOMPARE(QtMessagePatternFormatter(QStringLiteral("%{time yyyy-MM-dd hh:mm:ss.zzz}"))
+                     .format(lmsg),
+             lmsg.time().toString(QStringLiteral("yyyy-MM-dd hh:mm:ss.zzz")));
+}
+
+void TestQtMessagePatternFormatter::testBacktrace()
+{
+    QtMessagePatternFormatter formatter(
+            QStringLiteral("%{message} [%{backtrace depth=2 separator=\";\"}]"));
+    QVERIFY(Backtrace::isCaptureEnabled(QtDebugMsg));
+
+    QMessageLogContext context("test.cpp", 1, "void test()", "default");
+
+    // Without a captured backtrace
+    auto lmsg = LogMessage(QtDebugMsg, context, QStringLiteral("Test"));
+    QCOMPARE(formatter.format(lmsg), QStringLiteral("Test []"));
+
+    Backtrace::attach(lmsg);
+    const auto formatted = formatter.format(lmsg);
+    QVERIFY(formatted.startsWith(QStringLiteral("Test [")));
+    QVERIFY(formatted.length() > 7);
+    QVERIFY(formatted.count(QLatin1Char(';')) <= 1);
+}
+
+void TestQtMessagePatternFormatter::testBacktraceReleased()
+{
+    {
+        QtMessagePatternFormatter formatter(QStringLiteral("%{message} %{backtrace}"));
+        QVERIFY(Backtrace::isCaptureEnabled(QtDebugMsg));
+    }
+    QVERIFY(!Backtrace::isCaptureEnabled(QtFatalMsg));
+}
+
+void TestQtMessagePatternFormatter::testDefaultPattern()
+{
+    qunsetenv("QT_MESSAGE_PATTERN");
+    QCOMPARE(QtMessagePatternFormatter::defaultPattern(),
+             QStringLiteral("%{if-category}%{category}: %{endif}%{message}"));
+
+    qputenv("QT_MESSAGE_PATTERN", "%{type}: %{message}");
+    QCOMPARE(QtMessagePatternFormatter::defaultPattern(), QStringLiteral("%{type}: %{message}"));
+
+    QMessageLogContext context("test.cpp", 1, "void test()", "default");
+    const auto lmsg = LogMessage(QtWarningMsg, context, QStringLiteral("Test"));
+    QCOMPARE(QtMessagePatternFormatter().format(lmsg), QStringLiteral("warning: Test"));
+
+    qunsetenv("QT_MESSAGE_PATTERN");
+}
+
+QTEST_MAIN(TestQtMessagePatternFormatter)
+#include "test_qtmessagepatternformatter.moc"
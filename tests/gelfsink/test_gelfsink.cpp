@@ -0,0 +1,296 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkDatagram>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUdpSocket>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/sinks/gelfsink.h"
+
+using namespace QtLogger;
+
+class TestGelfSink : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testToGelf();
+    void testToGelfEmptyMessage();
+    void testToGelfLargeIntegers();
+    void testUdp();
+    void testUdpChunked();
+    void testUdpZlib();
+    void testTcp();
+    void testTcpBatches();
+    void testMaxBufferSize();
+
+private:
+    LogMessage createLogMessage(const QString &message, QtMsgType type = QtWarningMsg);
+    QList<QByteArray> receiveDatagrams(QUdpSocket &server, int count);
+};
+
+LogMessage TestGelfSink::createLogMessage(const QString &message, QtMsgType type)
+{
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", "test.category");
+    return LogMessage(type, context, message);
+}
+
+QList<QByteArray> TestGelfSink::receiveDatagrams(QUdpSocket &server, int count)
+{
+    QList<QByteArray> result;
+    QElapsedTimer timer;
+    timer.start();
+
+    while (result.size() < count && timer.elapsed() < 5000) {
+        QCoreApplication::processEvents();
+        server.waitForReadyRead(10);
+        while (server.hasPendingDatagrams())
+            result.append(server.receiveDatagram().data());
+    }
+
+    return result;
+}
+
+void TestGelfSink::testToGelf()
+{
+    auto lmsg = createLogMessage("Disk is almost full");
+    lmsg.setAttribute("free_space", 42);
+    lmsg.setAttribute("mount point", "/var");
+    lmsg.setAttribute("id", "abc");
+    lmsg.setFormattedMessage("WARNING Disk is almost full");
+
+    const auto doc = QJsonDocument::fromJson(GelfSink::toGelf(lmsg, "testhost"));
+    QVERIFY(doc.isObject());
+    const auto obj = doc.object();
+
+    QCOMPARE(obj.value("version").toString(), QString("1.1"));
+    QCOMPARE(obj.value("host").toString(), QString("testhost"));
+    QCOMPARE(obj.value("short_message").toString(), QString("Disk is almost full"));
+    QCOMPARE(obj.value("full_message").toString(), QString("WARNING Disk is almost full"));
+    QCOMPARE(obj.value("level").toInt(), 4);
+    QCOMPARE(obj.value("timestamp").toDouble(),
+             static_cast<double>(lmsg.time().toMSecsSinceEpoch()) / 1000.0);
+    QCOMPARE(obj.value("_category").toString(), QString("test.category"));
+    QCOMPARE(obj.value("_file").toString(), QString("test.cpp"));
+    QCOMPARE(obj.value("_line").toInt(), 42);
+    QCOMPARE(obj.value("_function").toString(), QString("void testFunction()"));
+
+    QCOMPARE(obj.value("_free_space").toDouble(), 42.0);
+    QCOMPARE(obj.value("_mount_point").toString(), QString("/var"));
+    QVERIFY(!obj.contains("_id"));
+    QCOMPARE(obj.value("_id_").toString(), QString("abc"));
+}
+
+void TestGelfSink::testToGelfEmptyMessage()
+{
+    const auto obj =
+            QJsonDocument::fromJson(GelfSink::toGelf(createLogMessage("", QtCriticalMsg), "h"))
+                    .object();
+
+    QCOMPARE(obj.value("short_message").toString(), QString("-"));
+    QVERIFY(!obj.contains("full_message"));
+    QCOMPARE(obj.value("level").toInt(), 3);
+}
+
+void TestGelfSink::testToGelfLargeIntegers()
+{
+    auto lmsg = createLogMessage("m");
+    lmsg.setAttribute("small", Q_INT64_C(-9007199254740992));
+    lmsg.setAttribute("signed", Q_INT64_C(9007199254740993));
+    lmsg.setAttribute("unsigned", Q_UINT64_C(18446744073709551615));
+
+    const auto obj = QJsonDocument::fromJson(GelfSink::toGelf(lmsg, "h")).object();
+
+    QCOMPARE(obj.value("_small").toDouble(), -9007199254740992.0);
+    QCOMPARE(obj.value("_signed").toString(), QString("9007199254740993"));
+    QCOMPARE(obj.value("_unsigned").toString(), QString("18446744073709551615"));
+}
+
+void TestGelfSink::testUdp()
+{
+    QUdpSocket server;
+    QVERIFY(server.bind(QHostAddress::LocalHost, 0));
+
+    GelfSink sink("127.0.0.1", server.localPort());
+    sink.setHostName("testhost");
+    sink.send(createLogMessage("Hello GELF"));
+    sink.flush();
+
+    const auto datagrams = receiveDatagrams(server, 1);
+    QCOMPARE(datagrams.size(), 1);
+
+    const auto obj = QJsonDocument::fromJson(datagrams.first()).object();
+    QCOMPARE(obj.value("short_message").toString(), QString("Hello GELF"));
+    QCOMPARE(obj.value("host").toString(), QString("testhost"));
+}
+
+void TestGelfSink::testUdpChunked()
+{
+    QUdpSocket server;
+    QVERIFY(server.bind(QHostAddress::LocalHost, 0));
+
+    GelfSink sink("127.0.0.1", server.localPort());
+    sink.setChunkSize(112);
+
+    const auto message = QString(1000, QLatin1Char('x'));
+    const auto expected = GelfSink::toGelf(createLogMessage(message), sink.hostName());
+    const auto count = static_cast<int>((expected.size() + 99) / 100);
+
+    sink.send(createLogMessage(message));
+    sink.flush();
+
+    const auto chunks = receiveDatagrams(server, count);
+    QCOMPARE(chunks.size(), count);
+
+    QMap<int, QByteArray> parts;
+    for (const auto &chunk : chunks) {
+        QVERIFY(chunk.size() <= 112);
+        QCOMPARE(static_cast<quint8>(chunk.at(0)), static_cast<quint8>(0x1e));
+        QCOMPARE(static_cast<quint8>(chunk.at(1)), static_cast<quint8>(0x0f));
+        QCOMPARE(chunk.mid(2, 8), chunks.first().mid(2, 8));
+        QCOMPARE(static_cast<int>(chunk.at(11)), count);
+        parts.insert(chunk.at(10), chunk.mid(12));
+    }
+
+    QByteArray data;
+    for (const auto &part : std::as_const(parts))
+        data.append(part);
+
+    const auto obj = QJsonDocument::fromJson(data).object();
+    QCOMPARE(obj.value("short_message").toString(), message);
+}
+
+void TestGelfSink::testUdpZlib()
+{
+    QUdpSocket server;
+    QVERIFY(server.bind(QHostAddress::LocalHost, 0));
+
+    GelfSink sink("127.0.0.1", server.localPort());
+    sink.setCompression(GelfSink::Compression::Zlib);
+    sink.send(createLogMessage("Compressed message"));
+    sink.flush();
+
+    const auto datagrams = receiveDatagrams(server, 1);
+    QCOMPARE(datagrams.size(), 1);
+
+    const auto &datagram = datagrams.first();
+    QCOMPARE(static_cast<quint8>(datagram.at(0)), static_cast<quint8>(0x78));
+
+    // qUncompress() expects the uncompressed size before the zlib stream
+    QByteArray zlib(4, '\0');
+    qToBigEndian(quint32(1024 * 1024), zlib.data());
+    zlib.append(datagram);
+
+    const auto obj = QJsonDocument::fromJson(qUncompress(zlib)).object();
+    QCOMPARE(obj.value("short_message").toString(), QString("Compressed message"));
+}
+
+void TestGelfSink::testTcp()
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost, 0));
+
+    GelfSink sink("127.0.0.1", server.serverPort(), GelfSink::Transport::Tcp);
+    QCOMPARE(sink.transport(), GelfSink::Transport::Tcp);
+
+    // Sent before the connection is established, buffered
+    sink.send(createLogMessage("First"));
+
+    QVERIFY(server.waitForNewConnection(5000));
+    QTcpSocket *client = server.nextPendingConnection();
+    QVERIFY(client);
+
+    sink.send(createLogMessage("Second"));
+    sink.send(createLogMessage("Third"));
+
+    QByteArray data;
+    QTRY_VERIFY_WITH_TIMEOUT((data.append(client->readAll()), data.count('\0') == 3), 5000);
+
+    const auto frames = data.split('\0');
+    QCOMPARE(frames.size(), 4);
+    QVERIFY(frames.last().isEmpty());
+    QCOMPARE(QJsonDocument::fromJson(frames.at(0)).object().value("short_message").toString(),
+             QString("First"));
+    QCOMPARE(QJsonDocument::fromJson(frames.at(1)).object().value("short_message").toString(),
+             QString("Second"));
+    QCOMPARE(QJsonDocument::fromJson(frames.at(2)).object().value("short_message").toString(),
+             QString("Third"));
+}
+
+void TestGelfSink::testTcpBatches()
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost, 0));
+
+    GelfSink sink("127.0.0.1", server.serverPort(), GelfSink::Transport::Tcp);
+    sink.setHostName("batches");
+    QCOMPARE(sink.hostName(), QString("batches"));
+
+    sink.send(createLogMessage("Connect"));
+    QVERIFY(server.waitForNewConnection(5000));
+    QTcpSocket *client = server.nextPendingConnection();
+    QVERIFY(client);
+
+    // Many times the size of a batch, written from the buffer as the socket sends the last batch
+    const auto padding = QString(1000, QLatin1Char('x'));
+    for (int i = 0; i < 1000; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1 %2").arg(i).arg(padding)));
+
+    QByteArray data;
+    QTRY_VERIFY_WITH_TIMEOUT((data.append(client->readAll()), data.count('\0') == 1001), 10000);
+
+    const auto frames = data.split('\0');
+    for (int i = 0; i < 1000; ++i) {
+        const auto obj = QJsonDocument::fromJson(frames.at(i + 1)).object();
+        QVERIFY(obj.value("short_message").toString().startsWith(QStringLiteral("Message %1 ").arg(i)));
+        QCOMPARE(obj.value("host").toString(), QString("batches"));
+    }
+}
+
+void TestGelfSink::testMaxBufferSize()
+{
+    // A free port with nothing listening on it yet
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost, 0));
+    const auto port = server.serverPort();
+    server.close();
+
+    const auto frameSize = GelfSink::toGelf(createLogMessage("Message 0"), "h").size() + 1;
+
+    GelfSink sink("127.0.0.1", port, GelfSink::Transport::Tcp);
+    sink.setHostName("h");
+    sink.setMaxBufferSize(static_cast<int>(frameSize * 2));
+    QCOMPARE(sink.maxBufferSize(), static_cast<int>(frameSize * 2));
+
+    // The connection is refused, only the two newest messages fit into the buffer
+    for (int i = 0; i < 5; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1").arg(i)));
+    sink.flush();
+    QTest::qWait(200);
+
+    // The next message reconnects
+    QVERIFY(server.listen(QHostAddress::LocalHost, port));
+    sink.send(createLogMessage("Message 5"));
+
+    QVERIFY(server.waitForNewConnection(5000));
+    QTcpSocket *client = server.nextPendingConnection();
+    QVERIFY(client);
+
+    QByteArray data;
+    QTRY_VERIFY_WITH_TIMEOUT((data.append(client->readAll()), data.count('\0') == 2), 5000);
+
+    const auto frames = data.split('\0');
+    QCOMPARE(QJsonDocument::fromJson(frames.at(0)).object().value("short_message").toString(),
+             QString("Message 4"));
+    QCOMPARE(QJsonDocument::fromJson(frames.at(1)).object().value("short_message").toString(),
+             QString("Message 5"));
+}
+
+QTEST_MAIN(TestGelfSink)
+#include "test_gelfsink.moc"
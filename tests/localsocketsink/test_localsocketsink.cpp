@@ -0,0 +1,250 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QCoreApplication>
+
+#include "qtlogger/logcollector.h"
+#include "qtlogger/logmessage.h"
+#include "qtlogger/sinks/localsocketsink.h"
+
+using namespace QtLogger;
+
+class CollectingSink : public Sink
+{
+public:
+    void send(const LogMessage &lmsg) override { messages.append(lmsg); }
+
+    QList<LogMessage> messages;
+};
+
+using CollectingSinkPtr = QSharedPointer<CollectingSink>;
+
+class TestLocalSocketSink : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testRoundTrip();
+    void testProcessAttributes();
+    void testMultipleConnections();
+    void testBufferUntilConnected();
+    void testMaxPendingCount();
+    void testBatches();
+    void testReconnect();
+    void testListenError();
+
+private:
+    LogMessage createLogMessage(const QString &message, QtMsgType type = QtDebugMsg);
+
+    QString m_serverName;
+    LogCollector *m_collector = nullptr;
+    CollectingSinkPtr m_received;
+};
+
+void TestLocalSocketSink::init()
+{
+    static int counter = 0;
+    m_serverName = QStringLiteral("qtlogger-test-%1-%2")
+                           .arg(QCoreApplication::applicationPid())
+                           .arg(++counter);
+
+    m_received = CollectingSinkPtr::create();
+    m_collector = new LogCollector();
+    m_collector->pipeline() << m_received;
+}
+
+void TestLocalSocketSink::cleanup()
+{
+    delete m_collector;
+    m_collector = nullptr;
+    m_received.reset();
+}
+
+LogMessage TestLocalSocketSink::createLogMessage(const QString &message, QtMsgType type)
+{
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", "test.category");
+    return LogMessage(type, context, message);
+}
+
+void TestLocalSocketSink::testRoundTrip()
+{
+    QVERIFY(m_collector->listen(m_serverName));
+    QVERIFY(m_collector->isListening());
+
+    LocalSocketSink sink(m_serverName);
+    QCOMPARE(sink.serverName(), m_serverName);
+
+    auto lmsg = createLogMessage("Hello collector", QtWarningMsg);
+    lmsg.setAttribute("request", 17);
+    sink.send(lmsg);
+    sink.send(createLogMessage("Second"));
+
+    QTRY_COMPARE(m_received->messages.size(), 2);
+    QCOMPARE(m_collector->messageCount(), quint64(2));
+
+    const auto &first = m_received->messages.at(0);
+    QCOMPARE(first.message(), QString("Hello collector"));
+    QCOMPARE(first.type(), QtWarningMsg);
+    QCOMPARE(QString(first.category()), QString("test.category"));
+    QCOMPARE(QString(first.file()), QString("test.cpp"));
+    QCOMPARE(first.line(), 42);
+    QCOMPARE(QString(first.function()), QString("void testFunction()"));
+    QCOMPARE(first.time().toMSecsSinceEpoch(), lmsg.time().toMSecsSinceEpoch());
+    QCOMPARE(first.attribute("request").toLongLong(), 17LL);
+
+    QCOMPARE(m_received->messages.at(1).message(), QString("Second"));
+}
+
+void TestLocalSocketSink::testProcessAttributes()
+{
+    QVERIFY(m_collector->listen(m_serverName));
+
+    LocalSocketSink sink(m_serverName);
+
+    auto lmsg = createLogMessage("With own appname");
+    lmsg.setAttribute("appname", "override");
+    sink.send(createLogMessage("Plain"));
+    sink.send(lmsg);
+
+    QTRY_COMPARE(m_received->messages.size(), 2);
+
+    const auto &plain = m_received->messages.at(0);
+    QCOMPARE(plain.attribute("pid").toLongLong(),
+             static_cast<qlonglong>(QCoreApplication::applicationPid()));
+    QCOMPARE(plain.attribute("appname").toString(), QCoreApplication::applicationName());
+
+    // Attributes of the message take precedence over the process attributes
+    QCOMPARE(m_received->messages.at(1).attribute("appname").toString(), QString("override"));
+}
+
+void TestLocalSocketSink::testMultipleConnections()
+{
+    QVERIFY(m_collector->listen(m_serverName));
+
+    LocalSocketSink sink1(m_serverName);
+    LocalSocketSink sink2(m_serverName);
+
+    for (int i = 0; i < 50; ++i) {
+        sink1.send(createLogMessage(QStringLiteral("one %1").arg(i)));
+        sink2.send(createLogMessage(QStringLiteral("two %1").arg(i)));
+    }
+
+    QTRY_COMPARE(m_received->messages.size(), 100);
+    QCOMPARE(m_collector->connectionCount(), 2);
+
+    // Each connection keeps its own order
+    int one = 0;
+    int two = 0;
+    for (const auto &lmsg : std::as_const(m_received->messages)) {
+        if (lmsg.message().startsWith("one"))
+            QCOMPARE(lmsg.message(), QStringLiteral("one %1").arg(one++));
+        else
+            QCOMPARE(lmsg.message(), QStringLiteral("two %1").arg(two++));
+    }
+}
+
+void TestLocalSocketSink::testBufferUntilConnected()
+{
+    LocalSocketSink sink(m_serverName);
+
+    sink.send(createLogMessage("Before listen 1"));
+    sink.send(createLogMessage("Before listen 2"));
+
+    QVERIFY(m_collector->listen(m_serverName));
+
+    // Reconnection attempts are rate limited
+    QTest::qWait(1100);
+    sink.send(createLogMessage("After listen"));
+
+    QTRY_COMPARE(m_received->messages.size(), 3);
+    QCOMPARE(m_received->messages.at(0).message(), QString("Before listen 1"));
+    QCOMPARE(m_received->messages.at(1).message(), QString("Before listen 2"));
+    QCOMPARE(m_received->messages.at(2).message(), QString("After listen"));
+}
+
+void TestLocalSocketSink::testMaxPendingCount()
+{
+    LocalSocketSink sink(m_serverName);
+    sink.setMaxPendingCount(2);
+    QCOMPARE(sink.maxPendingCount(), 2);
+
+    // The queue is bounded when the messages are sent
+    for (int i = 0; i < 5; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1").arg(i)));
+
+    QVERIFY(m_collector->listen(m_serverName));
+
+    // Connects and writes the queue
+    QTest::qWait(1100);
+    sink.flush();
+    sink.send(createLogMessage("Message 5"));
+
+    QTRY_COMPARE(m_received->messages.size(), 3);
+    QCOMPARE(m_received->messages.at(0).message(), QString("Message 3"));
+    QCOMPARE(m_received->messages.at(1).message(), QString("Message 4"));
+    QCOMPARE(m_received->messages.at(2).message(), QString("Message 5"));
+}
+
+void TestLocalSocketSink::testBatches()
+{
+    QVERIFY(m_collector->listen(m_serverName));
+
+    LocalSocketSink sink(m_serverName);
+    sink.send(createLogMessage("Connect"));
+    QTRY_COMPARE(m_received->messages.size(), 1);
+
+    // Many times the size of a batch, written as the socket sends the previous ones
+    const auto padding = QString(1000, QLatin1Char('x'));
+    for (int i = 0; i < 1000; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1 %2").arg(i).arg(padding)));
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_received->messages.size(), 1001, 10000);
+    for (int i = 0; i < 1000; ++i) {
+        QVERIFY(m_received->messages.at(i + 1).message().startsWith(
+                QStringLiteral("Message %1 ").arg(i)));
+    }
+}
+
+void TestLocalSocketSink::testReconnect()
+{
+    QVERIFY(m_collector->listen(m_serverName));
+
+    LocalSocketSink sink(m_serverName);
+    sink.send(createLogMessage("First session"));
+    QTRY_COMPARE(m_received->messages.size(), 1);
+
+    // A restarted collector gets a new session with its own header and dictionaries
+    m_collector->close();
+    QVERIFY(!m_collector->isListening());
+    QTest::qWait(50);
+    QVERIFY(m_collector->listen(m_serverName));
+
+    QTest::qWait(1100);
+    sink.send(createLogMessage("Second session"));
+    QTRY_COMPARE(m_received->messages.size(), 2);
+
+    const auto &lmsg = m_received->messages.at(1);
+    QCOMPARE(lmsg.message(), QString("Second session"));
+    QCOMPARE(QString(lmsg.file()), QString("test.cpp"));
+    QCOMPARE(lmsg.attribute("pid").toLongLong(),
+             static_cast<qlonglong>(QCoreApplication::applicationPid()));
+}
+
+void TestLocalSocketSink::testListenError()
+{
+    QVERIFY(m_collector->listen(m_serverName));
+
+    // The name is used by a running collector
+    LogCollector other;
+    QVERIFY(!other.listen(m_serverName));
+    QVERIFY(!other.isListening());
+    QVERIFY(!other.errorString().isEmpty());
+    QVERIFY(m_collector->isListening());
+}
+
+QTEST_MAIN(TestLocalSocketSink)
+#include "test_localsocketsink.moc"
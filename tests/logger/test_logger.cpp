@@ -13,6 +13,7 @@
 #include <QtConcurrent>
 #include <QFuture>
 
+#include "qtlogger/binarylog.h"
 #include "qtlogger/logger.h"
 #include "qtlogger/logmessage.h"
 #include "qtlogger/sinks/rotatingfilesink.h"
@@ -60,6 +61,7 @@ private slots:
     void testThreadSafety();
     void testAsyncConfiguration();
     void testMutexLocking();
+    void testConfigureRecordingWithCallerThreadFormatting();
 #endif
 
     // Integration tests
@@ -393,6 +395,46 @@ void TestLogger::testMutexLocking()
     QVERIFY(m_logger->mutex() != nullptr);
 }
 
+void TestLogger::testConfigureRecordingWithCallerThreadFormatting()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto recordingPath = dir.filePath("workload.qtlb");
+    const auto logPath = dir.filePath("app.log");
+
+    QSettings settings(dir.filePath("logger.ini"), QSettings::IniFormat);
+    settings.beginGroup("logger");
+    settings.setValue("recording_path", recordingPath);
+    settings.setValue("message_pattern", "formatted %{message}");
+    settings.setValue("path", logPath);
+    settings.setValue("async", true);
+    settings.setValue("format_in_caller_thread", true);
+    settings.endGroup();
+
+    m_logger->configure(settings);
+    QVERIFY(m_logger->formatInCallerThread());
+
+    // Runs in the calling thread only if the recording sink doesn't end the leading handlers
+    m_logger->handlers().insert(1, m_mockHandler1);
+
+    QMessageLogContext context("test.cpp", 42, "testFunction", "test.category");
+    m_logger->processMessage(QtInfoMsg, context, "recorded message");
+    QCOMPARE(m_mockHandler1->processCallCount(), 1);
+
+    m_logger->resetOwnThread();
+    m_logger->setFormatInCallerThread(false);
+    m_logger->clear();
+
+    BinaryLogReader reader(recordingPath);
+    const auto recorded = reader.next();
+    QVERIFY(recorded);
+    QCOMPARE(recorded->message(), QString("recorded message"));
+
+    QFile log(logPath);
+    QVERIFY(log.open(QIODevice::ReadOnly));
+    QVERIFY(log.readAll().contains("formatted recorded message"));
+}
+
 #endif
 
 void TestLogger::testRealLogging()
@@ -4,6 +4,8 @@
 #include <QVariantHash>
 #include <QMessageLogContext>
 
+#include <optional>
+
 #include "qtlogger.h"
 #include "mock_context.h"
 
@@ -28,6 +30,7 @@ private slots:
     // System attributes tests
     void testTime();
     void testThreadId();
+    void testThreadInfo();
 
     // Formatted message tests
     void testFormattedMessage();
@@ -187,6 +190,64 @@ void TestLogMessage::testThreadId()
     QCOMPARE(msg.threadId(), currentThreadId);
 }
 
+void TestLogMessage::testThreadInfo()
+{
+    auto context = Test::MockContext::create();
+    LogMessage msg(QtDebugMsg, context, "test");
+
+    QVERIFY(msg.osThreadId() != 0);
+    QCOMPARE(msg.osThreadId(), ThreadInfo::currentId());
+    QCOMPARE(msg.threadName(), ThreadInfo::name(ThreadInfo::currentId()));
+
+    // Captured in the thread that creates the message
+    std::optional<LogMessage> workerMsg;
+    QThread thread;
+    thread.setObjectName(QStringLiteral("worker"));
+    connect(
+            &thread, &QThread::started, &thread,
+            [&]() {
+                workerMsg.emplace(QtDebugMsg, context, QStringLiteral("from worker"));
+                QThread::currentThread()->quit();
+            },
+            Qt::DirectConnection);
+    thread.start();
+    QVERIFY(thread.wait(5000));
+
+    QVERIFY(workerMsg);
+    QCOMPARE(workerMsg->threadName(), QStringLiteral("worker"));
+    QVERIFY(workerMsg->osThreadId() != 0);
+    QVERIFY(workerMsg->osThreadId() != msg.osThreadId());
+
+    const auto copy = LogMessage(*workerMsg);
+    QCOMPARE(copy.osThreadId(), workerMsg->osThreadId());
+    QCOMPARE(copy.threadName(), QStringLiteral("worker"));
+
+    // A QThread renamed after its first message, the name is looked up when it is read
+    std::optional<LogMessage> firstMsg;
+    std::optional<LogMessage> renamedMsg;
+    QString firstName;
+    QThread renamedThread;
+    renamedThread.setObjectName(QStringLiteral("first"));
+    connect(
+            &renamedThread, &QThread::started, &renamedThread,
+            [&]() {
+                firstMsg.emplace(QtDebugMsg, context, QStringLiteral("before"));
+                firstName = firstMsg->threadName();
+                QThread::currentThread()->setObjectName(QStringLiteral("renamed"));
+                renamedMsg.emplace(QtDebugMsg, context, QStringLiteral("after"));
+                QThread::currentThread()->quit();
+            },
+            Qt::DirectConnection);
+    renamedThread.start();
+    QVERIFY(renamedThread.wait(5000));
+
+    QVERIFY(firstMsg && renamedMsg);
+    QCOMPARE(firstName, QStringLiteral("first"));
+    QCOMPARE(firstMsg->threadName(), QStringLiteral("renamed"));
+    QCOMPARE(renamedMsg->threadName(), QStringLiteral("renamed"));
+    QCOMPARE(renamedMsg->osThreadId(), firstMsg->osThreadId());
+}
+
 void TestLogMessage::testFormattedMessage()
 {
     auto context = Test::MockContext::create();
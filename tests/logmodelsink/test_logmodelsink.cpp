@@ -0,0 +1,300 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QSignalSpy>
+
+#include <thread>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/sinks/logmodelsink.h"
+
+using namespace QtLogger;
+
+class TestLogModelSink : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void testInsertBatch();
+    void testRoles();
+    void testScheduledFlush();
+    void testMaxCount();
+    void testRowFilter();
+    void testNarrowedFilter();
+    void testFind();
+    void testFindIndex();
+    void testClear();
+    void testSendFromThread();
+
+private:
+    LogMessage createLogMessage(const QString &message, QtMsgType type = QtDebugMsg,
+                                const char *category = "app");
+};
+
+LogMessage TestLogModelSink::createLogMessage(const QString &message, QtMsgType type,
+                                              const char *category)
+{
+    QMessageLogContext context("test.cpp", 42, "testFunction", category);
+    return LogMessage(type, context, message, QDateTime::currentDateTime());
+}
+
+void TestLogModelSink::testInsertBatch()
+{
+    auto model = LogModelSink();
+    QSignalSpy spy(&model, &QAbstractItemModel::rowsInserted);
+
+    for (int i = 0; i < 1000; ++i) {
+        model.send(createLogMessage(QString::number(i)));
+    }
+
+    // Nothing is inserted until the batch is flushed
+    QCOMPARE(model.rowCount(), 0);
+
+    QVERIFY(model.flush());
+    QCOMPARE(model.rowCount(), 1000);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.first().at(1).toInt(), 0);
+    QCOMPARE(spy.first().at(2).toInt(), 999);
+
+    QCOMPARE(model.index(0).data().toString(), QStringLiteral("0"));
+    QCOMPARE(model.index(999).data().toString(), QStringLiteral("999"));
+    QVERIFY(!model.index(1000).data().isValid());
+}
+
+void TestLogModelSink::testRoles()
+{
+    auto model = LogModelSink();
+
+    auto lmsg = createLogMessage(QStringLiteral("hello"), QtWarningMsg, "app.network");
+    lmsg.setFormattedMessage(QStringLiteral("[warning] hello"));
+    lmsg.setAttribute(QStringLiteral("user"), QStringLiteral("john"));
+    model.send(lmsg);
+    model.flush();
+
+    const auto index = model.index(0);
+    QCOMPARE(index.data(Qt::DisplayRole).toString(), QStringLiteral("[warning] hello"));
+    QCOMPARE(index.data(LogModelSink::MessageRole).toString(), QStringLiteral("hello"));
+    QCOMPARE(index.data(LogModelSink::FormattedMessageRole).toString(),
+             QStringLiteral("[warning] hello"));
+    QCOMPARE(index.data(LogModelSink::TypeRole).toInt(), static_cast<int>(QtWarningMsg));
+    QCOMPARE(index.data(LogModelSink::CategoryRole).toString(), QStringLiteral("app.network"));
+    QCOMPARE(index.data(LogModelSink::FileRole).toString(), QStringLiteral("test.cpp"));
+    QCOMPARE(index.data(LogModelSink::LineRole).toInt(), 42);
+    QCOMPARE(index.data(LogModelSink::FunctionRole).toString(), QStringLiteral("testFunction"));
+    QCOMPARE(index.data(LogModelSink::TimeRole).toDateTime().toMSecsSinceEpoch(),
+             lmsg.time().toMSecsSinceEpoch());
+    QCOMPARE(index.data(LogModelSink::AttributesRole).toHash().value(QStringLiteral("user")),
+             QVariant(QStringLiteral("john")));
+
+    const auto roles = model.roleNames();
+    QCOMPARE(roles.value(LogModelSink::MessageRole), QByteArray("message"));
+    QCOMPARE(roles.value(LogModelSink::TimeRole), QByteArray("time"));
+}
+
+void TestLogModelSink::testScheduledFlush()
+{
+    auto model = LogModelSink();
+    QSignalSpy spy(&model, &QAbstractItemModel::rowsInserted);
+
+    for (int i = 0; i < 10; ++i) {
+        model.send(createLogMessage(QString::number(i)));
+    }
+
+    QTRY_COMPARE(model.rowCount(), 10);
+    QCOMPARE(spy.count(), 1);
+}
+
+void TestLogModelSink::testMaxCount()
+{
+    auto model = LogModelSink(100);
+    QCOMPARE(model.maxCount(), 100);
+
+    // Only the last maxCount messages of a batch are kept
+    for (int i = 0; i < 1000; ++i) {
+        model.send(createLogMessage(QString::number(i)));
+    }
+    model.flush();
+
+    QCOMPARE(model.rowCount(), 100);
+    QCOMPARE(model.droppedCount(), quint64(900));
+    QCOMPARE(model.index(0).data().toString(), QStringLiteral("900"));
+
+    // The oldest chunk is dropped when the model is full
+    QSignalSpy spy(&model, &QAbstractItemModel::rowsRemoved);
+    for (int i = 1000; i < 1010; ++i) {
+        model.send(createLogMessage(QString::number(i)));
+    }
+    model.flush();
+
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(model.totalCount() <= 100);
+    QCOMPARE(model.rowCount(), model.totalCount());
+    QCOMPARE(model.index(model.rowCount() - 1).data().toString(), QStringLiteral("1009"));
+    QCOMPARE(model.index(0).data().toString(), QString::number(1010 - model.rowCount()));
+}
+
+void TestLogModelSink::testRowFilter()
+{
+    auto model = LogModelSink();
+
+    for (int i = 0; i < 30; ++i) {
+        const auto type = i % 3 == 0 ? QtWarningMsg : QtDebugMsg;
+        const auto *category = i % 2 == 0 ? "app.network" : "app.ui";
+        model.send(createLogMessage(QStringLiteral("message %1").arg(i), type, category));
+    }
+    model.flush();
+
+    LogModelSink::RowFilter filter;
+    filter.minLevel = QtWarningMsg;
+    model.setRowFilter(filter);
+    QCOMPARE(model.rowCount(), 10);
+    QCOMPARE(model.totalCount(), 30);
+    QCOMPARE(model.index(1).data().toString(), QStringLiteral("message 3"));
+
+    filter.minLevel = QtDebugMsg;
+    filter.category = QStringLiteral("*.network");
+    model.setRowFilter(filter);
+    QCOMPARE(model.rowCount(), 15);
+
+    filter.category.clear();
+    filter.text = QStringLiteral("MESSAGE 2");
+    model.setRowFilter(filter);
+    QCOMPARE(model.rowCount(), 11);
+
+    // New messages are filtered when they are inserted
+    model.send(createLogMessage(QStringLiteral("message 200")));
+    model.send(createLogMessage(QStringLiteral("other")));
+    model.flush();
+    QCOMPARE(model.rowCount(), 12);
+    QCOMPARE(model.index(11).data().toString(), QStringLiteral("message 200"));
+
+    model.setRowFilter(LogModelSink::RowFilter());
+    QCOMPARE(model.rowCount(), 32);
+}
+
+void TestLogModelSink::testNarrowedFilter()
+{
+    auto model = LogModelSink();
+
+    for (int i = 0; i < 100; ++i) {
+        model.send(createLogMessage(QStringLiteral("message %1").arg(i)));
+    }
+    model.flush();
+
+    LogModelSink::RowFilter filter;
+    filter.text = QStringLiteral("message 1");
+    model.setRowFilter(filter);
+    QCOMPARE(model.rowCount(), 11);
+
+    filter.text = QStringLiteral("message 12");
+    model.setRowFilter(filter);
+    QCOMPARE(model.rowCount(), 1);
+
+    // Wider again
+    filter.text = QStringLiteral("message");
+    model.setRowFilter(filter);
+    QCOMPARE(model.rowCount(), 100);
+}
+
+void TestLogModelSink::testFind()
+{
+    auto model = LogModelSink();
+
+    for (int i = 0; i < 20; ++i) {
+        model.send(createLogMessage(i % 5 == 0 ? QStringLiteral("Error %1").arg(i)
+                                               : QStringLiteral("ok %1").arg(i)));
+    }
+    model.flush();
+
+    QCOMPARE(model.find(QStringLiteral("error")), 0);
+    QCOMPARE(model.find(QStringLiteral("error"), 1), 5);
+    QCOMPARE(model.find(QStringLiteral("error"), 19, true), 15);
+    QCOMPARE(model.find(QStringLiteral("error"), 1, false, Qt::CaseSensitive), -1);
+    QCOMPARE(model.find(QStringLiteral("missing")), -1);
+
+    // Rows of the filtered model
+    LogModelSink::RowFilter filter;
+    filter.text = QStringLiteral("error");
+    model.setRowFilter(filter);
+    QCOMPARE(model.find(QStringLiteral("15")), 3);
+}
+
+void TestLogModelSink::testFindIndex()
+{
+    auto model = LogModelSink(100);
+
+    for (int i = 0; i < 100; ++i) {
+        model.send(createLogMessage(i % 10 == 0 ? QStringLiteral("Error %1").arg(i)
+                                                : QStringLiteral("ok %1").arg(i)));
+    }
+    model.flush();
+
+    QCOMPARE(model.find(QStringLiteral("error"), 0), 0);
+    QCOMPARE(model.find(QStringLiteral("error"), 95, true), 90);
+
+    // A longer text and messages inserted after the search
+    QCOMPARE(model.find(QStringLiteral("error 5")), 50);
+    model.send(createLogMessage(QStringLiteral("error 500")));
+    model.flush();
+    QCOMPARE(model.find(QStringLiteral("error 5"), 51), model.rowCount() - 1);
+
+    // Matches in dropped chunks are gone
+    for (int i = 0; i < 50; ++i) {
+        model.send(createLogMessage(QStringLiteral("ok")));
+    }
+    model.flush();
+    QCOMPARE(model.index(0).data().toString(), QStringLiteral("ok 75"));
+    QCOMPARE(model.find(QStringLiteral("error 5")), 25);
+    QCOMPARE(model.find(QStringLiteral("error 50"), 0, false, Qt::CaseSensitive), 25);
+
+    // A shorter text checks all messages again
+    QCOMPARE(model.find(QStringLiteral("error")), 5);
+
+    model.clearFind();
+    QCOMPARE(model.find(QStringLiteral("ok")), 0);
+}
+
+void TestLogModelSink::testClear()
+{
+    auto model = LogModelSink();
+
+    for (int i = 0; i < 10; ++i) {
+        model.send(createLogMessage(QString::number(i)));
+    }
+    model.flush();
+
+    model.clear();
+    QCOMPARE(model.rowCount(), 0);
+    QCOMPARE(model.totalCount(), 0);
+
+    model.send(createLogMessage(QStringLiteral("after")));
+    model.flush();
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.index(0).data().toString(), QStringLiteral("after"));
+}
+
+void TestLogModelSink::testSendFromThread()
+{
+    auto model = LogModelSink();
+    QSignalSpy spy(&model, &QAbstractItemModel::rowsInserted);
+
+    auto thread = std::thread([this, &model]() {
+        for (int i = 0; i < 10000; ++i) {
+            model.send(createLogMessage(QString::number(i)));
+        }
+
+        // Only schedules the insertion outside the thread of the model
+        model.flush();
+    });
+    thread.join();
+
+    QTRY_COMPARE(model.rowCount(), 10000);
+    QCOMPARE(model.index(9999).data().toString(), QStringLiteral("9999"));
+
+    // Batched, not a signal per message
+    QVERIFY(spy.count() < 10);
+}
+
+QTEST_MAIN(TestLogModelSink)
+#include "test_logmodelsink.moc"
@@ -0,0 +1,238 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+#include "qtlogger/attrhandlers/seqnumberattr.h"
+#include "qtlogger/binarylog.h"
+#include "qtlogger/logmessage.h"
+#include "qtlogger/logreplay.h"
+#include "qtlogger/pipeline.h"
+#include "qtlogger/sinks/recordingsink.h"
+
+using namespace QtLogger;
+
+class CollectingSink : public Sink
+{
+public:
+    void send(const LogMessage &lmsg) override { messages.append(lmsg); }
+
+    QList<LogMessage> messages;
+};
+
+class TestLogReplay : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testRecord();
+    void testMaxCount();
+    void testTruncate();
+    void testReplayFast();
+    void testReplayOriginalPacing();
+    void testStats();
+    void testInvalidRecording();
+
+private:
+    LogMessage createLogMessage(const QString &message, qint64 offset = 0);
+    void record(const QString &path, int count, qint64 interval = 0);
+
+    QTemporaryDir *m_tempDir = nullptr;
+    QString m_path;
+    QDateTime m_baseTime;
+};
+
+void TestLogReplay::init()
+{
+    m_tempDir = new QTemporaryDir();
+    QVERIFY(m_tempDir->isValid());
+    m_path = m_tempDir->filePath("workload.qtlb");
+    m_baseTime = QDateTime::currentDateTime();
+}
+
+void TestLogReplay::cleanup()
+{
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+LogMessage TestLogReplay::createLogMessage(const QString &message, qint64 offset)
+{
+    QMessageLogContext context("test.cpp", 42, "testFunction", "test.category");
+    return LogMessage(QtInfoMsg, context, message, m_baseTime.addMSecs(offset));
+}
+
+void TestLogReplay::record(const QString &path, int count, qint64 interval)
+{
+    RecordingSink sink(path);
+    for (int i = 0; i < count; ++i) {
+        sink.send(createLogMessage(QStringLiteral("message %1").arg(i), i * interval));
+    }
+}
+
+void TestLogReplay::testRecord()
+{
+    {
+        RecordingSink sink(m_path);
+        QVERIFY(sink.isValid());
+
+        auto lmsg = createLogMessage(QStringLiteral("with attributes"));
+        lmsg.setAttribute(QStringLiteral("user"), QStringLiteral("john"));
+        // Formatted output is not recorded
+        lmsg.setFormattedMessage(QStringLiteral("formatted"));
+        sink.send(lmsg);
+        sink.send(createLogMessage(QStringLiteral("second"), 25));
+
+        QCOMPARE(sink.count(), quint64(2));
+    }
+
+    BinaryLogReader reader(m_path);
+    QVERIFY(reader.isValid());
+
+    const auto first = reader.next();
+    QVERIFY(first);
+    QCOMPARE(first->message(), QStringLiteral("with attributes"));
+    QCOMPARE(first->attribute(QStringLiteral("user")).toString(), QStringLiteral("john"));
+    QCOMPARE(first->time().toMSecsSinceEpoch(), m_baseTime.toMSecsSinceEpoch());
+    QCOMPARE(QString::fromUtf8(first->function()), QStringLiteral("testFunction"));
+
+    const auto second = reader.next();
+    QVERIFY(second);
+    QCOMPARE(first->time().msecsTo(second->time()), qint64(25));
+
+    QVERIFY(!reader.next());
+}
+
+void TestLogReplay::testMaxCount()
+{
+    {
+        RecordingSink sink(m_path, 10);
+        QCOMPARE(sink.maxCount(), quint64(10));
+
+        for (int i = 0; i < 25; ++i) {
+            sink.send(createLogMessage(QStringLiteral("message %1").arg(i)));
+        }
+        QCOMPARE(sink.count(), quint64(10));
+    }
+
+    LogReplay replay(m_path);
+    QCOMPARE(replay.count(), 10);
+}
+
+void TestLogReplay::testTruncate()
+{
+    record(m_path, 20);
+    record(m_path, 5);
+
+    LogReplay replay(m_path);
+    QVERIFY(replay.isValid());
+    QCOMPARE(replay.count(), 5);
+}
+
+void TestLogReplay::testReplayFast()
+{
+    record(m_path, 100, 1000);
+
+    LogReplay replay(m_path);
+    QVERIFY(replay.isValid());
+    QCOMPARE(replay.count(), 100);
+    QCOMPARE(replay.duration(), qint64(99000));
+    QCOMPARE(replay.pacing(), LogReplay::Pacing::Fast);
+
+    auto sink = QSharedPointer<CollectingSink>::create();
+    Pipeline pipeline;
+    pipeline << SeqNumberAttrPtr::create() << sink;
+
+    // 99 seconds of recorded traffic are replayed at once
+    QElapsedTimer timer;
+    timer.start();
+    const auto stats = replay.run(pipeline);
+    QVERIFY(timer.elapsed() < 10000);
+
+    QCOMPARE(stats.count, quint64(100));
+    QCOMPARE(static_cast<int>(sink->messages.size()), 100);
+    QCOMPARE(sink->messages.first().message(), QStringLiteral("message 0"));
+    QCOMPARE(sink->messages.last().message(), QStringLiteral("message 99"));
+    QCOMPARE(sink->messages.last().time().toMSecsSinceEpoch(),
+             m_baseTime.addMSecs(99000).toMSecsSinceEpoch());
+
+    // Every run starts with the recorded messages, not the ones changed by the handlers
+    replay.run(pipeline);
+    QCOMPARE(static_cast<int>(sink->messages.size()), 200);
+    QCOMPARE(sink->messages.at(100).attribute(QStringLiteral("seq_number")).toInt(), 100);
+    QCOMPARE(static_cast<int>(sink->messages.at(100).attributes().size()), 1);
+}
+
+void TestLogReplay::testReplayOriginalPacing()
+{
+    record(m_path, 5, 50);
+
+    LogReplay replay(m_path);
+    replay.setPacing(LogReplay::Pacing::Original);
+    replay.setSpeed(2);
+    QCOMPARE(replay.speed(), 2.0);
+
+    // Ignored
+    replay.setSpeed(0);
+    QCOMPARE(replay.speed(), 2.0);
+
+    auto sink = QSharedPointer<CollectingSink>::create();
+    Pipeline pipeline;
+    pipeline << sink;
+
+    const auto stats = replay.run(pipeline);
+    QCOMPARE(stats.count, quint64(5));
+    QCOMPARE(static_cast<int>(sink->messages.size()), 5);
+
+    // 200 ms of recorded traffic at twice the speed
+    QVERIFY(stats.elapsed >= 100 * 1000000LL);
+    QVERIFY(stats.elapsed < 2000 * 1000000LL);
+}
+
+void TestLogReplay::testStats()
+{
+    record(m_path, 1000);
+
+    LogReplay replay(m_path);
+
+    Pipeline pipeline;
+    pipeline << QSharedPointer<CollectingSink>::create();
+
+    const auto stats = replay.run(pipeline);
+    QCOMPARE(stats.count, quint64(1000));
+    QVERIFY(stats.elapsed > 0);
+    QVERIFY(stats.throughput > 0);
+
+    QVERIFY(stats.minLatency <= stats.p50Latency);
+    QVERIFY(stats.p50Latency <= stats.p90Latency);
+    QVERIFY(stats.p90Latency <= stats.p99Latency);
+    QVERIFY(stats.p99Latency <= stats.p999Latency);
+    QVERIFY(stats.p999Latency <= stats.maxLatency);
+    QVERIFY(stats.meanLatency >= stats.minLatency);
+    QVERIFY(stats.meanLatency <= stats.maxLatency);
+}
+
+void TestLogReplay::testInvalidRecording()
+{
+    LogReplay missing(m_tempDir->filePath("missing.qtlb"));
+    QVERIFY(!missing.isValid());
+    QVERIFY(!missing.errorString().isEmpty());
+    QCOMPARE(missing.count(), 0);
+
+    Pipeline pipeline;
+    QCOMPARE(missing.run(pipeline).count, quint64(0));
+
+    auto file = QFile(m_path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("not a recording");
+    file.close();
+
+    QVERIFY(!LogReplay(m_path).isValid());
+}
+
+QTEST_MAIN(TestLogReplay)
+#include "test_logreplay.moc"
@@ -0,0 +1,373 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/logsearch.h"
+#include "qtlogger/sinks/binaryfilesink.h"
+#include "qtlogger/sinks/rotatingfilesink.h"
+#include "qtlogger/timeindex.h"
+
+using namespace QtLogger;
+
+class TestLogSearch : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testFiles();
+    void testText();
+    void testRegexAndCase();
+    void testTimeRange();
+    void testTextWithMessageConditions();
+    void testBinary();
+    void testMergeOrder();
+    void testMergeOrderWithoutTimeIndex();
+    void testTimeRangeWithoutTimeIndex();
+    void testStreamedMatches();
+    void testLargeFile();
+    void testMissingLog();
+
+private:
+    QString writeTextLog(int messages);
+    LogMessage createLogMessage(const QString &message, const QDateTime &time,
+                                QtMsgType type = QtDebugMsg,
+                                const char *category = "test.category");
+    static int number(const LogSearch::Match &match);
+
+    QTemporaryDir *m_tempDir = nullptr;
+    QDateTime m_baseTime;
+};
+
+void TestLogSearch::init()
+{
+    m_tempDir = new QTemporaryDir();
+    QVERIFY(m_tempDir->isValid());
+    m_baseTime = QDateTime::currentDateTime().addSecs(-3600);
+}
+
+void TestLogSearch::cleanup()
+{
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+QString TestLogSearch::writeTextLog(int messages)
+{
+    const auto logPath = m_tempDir->filePath("app.log");
+
+    auto sink = RotatingFileSink(logPath, 400, 0, RotatingFileSink::BlockCompression);
+    sink.setCompressionBlockSize(100);
+    sink.setTimeIndexInterval(40, 3600 * 1000);
+
+    for (int i = 0; i < messages; ++i) {
+        sink.send(createLogMessage(QStringLiteral("msg %1").arg(i, 3, 10, QLatin1Char('0')),
+                                   m_baseTime.addSecs(i)));
+    }
+
+    return logPath;
+}
+
+LogMessage TestLogSearch::createLogMessage(const QString &message, const QDateTime &time,
+                                           QtMsgType type, const char *category)
+{
+    QMessageLogContext context("test.cpp", 42, "testFunction", category);
+    auto lmsg = LogMessage(type, context, message, time);
+    lmsg.setFormattedMessage(message);
+    return lmsg;
+}
+
+int TestLogSearch::number(const LogSearch::Match &match)
+{
+    const auto text = match.message ? match.message->message() : match.line;
+    return text.mid(4).toInt();
+}
+
+void TestLogSearch::testFiles()
+{
+    const auto logPath = writeTextLog(200);
+
+    auto search = LogSearch(logPath);
+    const auto files = search.files();
+
+    QVERIFY(files.size() > 3);
+    QVERIFY(files.first().endsWith(".gz"));
+    QCOMPARE(files.last(), logPath);
+}
+
+void TestLogSearch::testText()
+{
+    auto search = LogSearch(writeTextLog(200));
+
+    LogSearch::Query query;
+    query.text = QStringLiteral("msg 1");
+
+    const auto matches = search.search(query);
+    QCOMPARE(static_cast<int>(matches.size()), 100);
+
+    for (int i = 0; i < matches.size(); ++i) {
+        QCOMPARE(matches.at(i).line, QStringLiteral("msg %1").arg(100 + i));
+        QVERIFY(!matches.at(i).message);
+        QVERIFY(matches.at(i).time > 0);
+    }
+
+    QVERIFY(search.errors().isEmpty());
+}
+
+void TestLogSearch::testRegexAndCase()
+{
+    auto search = LogSearch(writeTextLog(200));
+
+    LogSearch::Query query;
+    query.regex = QRegularExpression(QStringLiteral("^msg \\d\\d7$"));
+
+    auto matches = search.search(query);
+    QCOMPARE(static_cast<int>(matches.size()), 20);
+    QCOMPARE(matches.first().line, QStringLiteral("msg 007"));
+    QCOMPARE(matches.last().line, QStringLiteral("msg 197"));
+
+    query.regex = QRegularExpression();
+    query.text = QStringLiteral("MSG 05");
+    QVERIFY(search.search(query).isEmpty());
+
+    query.caseSensitivity = Qt::CaseInsensitive;
+    matches = search.search(query);
+    QCOMPARE(static_cast<int>(matches.size()), 10);
+    QCOMPARE(matches.first().line, QStringLiteral("msg 050"));
+}
+
+void TestLogSearch::testTimeRange()
+{
+    auto search = LogSearch(writeTextLog(200));
+
+    LogSearch::Query query;
+    query.from = m_baseTime.addSecs(50);
+    query.to = m_baseTime.addSecs(80);
+
+    const auto matches = search.search(query);
+
+    // Lines get the time of the index entry before them, an entry is written every 5 lines
+    QVERIFY(matches.size() >= 31);
+    QVERIFY(number(matches.first()) <= 50);
+    QVERIFY(number(matches.first()) > 40);
+    QVERIFY(number(matches.last()) >= 80);
+    QVERIFY(number(matches.last()) < 90);
+
+    for (int i = 1; i < matches.size(); ++i) {
+        QCOMPARE(number(matches.at(i)), number(matches.at(i - 1)) + 1);
+    }
+
+    query.from = QDateTime();
+    query.to = m_baseTime.addSecs(-10);
+    QVERIFY(search.search(query).isEmpty());
+}
+
+void TestLogSearch::testTextWithMessageConditions()
+{
+    auto search = LogSearch(writeTextLog(50));
+
+    LogSearch::Query query;
+    QCOMPARE(static_cast<int>(search.search(query).size()), 50);
+    QVERIFY(search.errors().isEmpty());
+
+    // The text logs are reported as not searched instead of having no matches
+    query.minLevel = QtWarningMsg;
+    QVERIFY(search.search(query).isEmpty());
+    QCOMPARE(search.errors().size(), search.files().size());
+    for (const auto &file : search.files()) {
+        QVERIFY(search.errors().contains(
+                QStringLiteral("%1: level and category can't be matched in a text log").arg(file)));
+    }
+
+    query.minLevel = QtDebugMsg;
+    query.category = QStringLiteral("test.*");
+    QVERIFY(search.search(query).isEmpty());
+    QCOMPARE(search.errors().size(), search.files().size());
+}
+
+void TestLogSearch::testBinary()
+{
+    const auto logPath = m_tempDir->filePath("app.qtlb");
+
+    {
+        auto sink = BinaryFileSink(logPath, 600, 0, RotatingFileSink::BlockCompression);
+        sink.setCompressionBlockSize(200);
+
+        for (int i = 0; i < 200; ++i) {
+            const auto type = i % 4 == 0 ? QtWarningMsg : QtDebugMsg;
+            const auto category = i % 2 == 0 ? "app.network" : "app.ui";
+            sink.send(createLogMessage(QStringLiteral("msg %1").arg(i, 3, 10, QLatin1Char('0')),
+                                       m_baseTime.addSecs(i), type, category));
+        }
+    }
+
+    auto search = LogSearch(logPath);
+    QVERIFY(search.files().size() > 2);
+    QVERIFY(search.files().first().endsWith(".gz"));
+
+    LogSearch::Query query;
+    query.from = m_baseTime.addSecs(20);
+    query.to = m_baseTime.addSecs(119);
+    query.minLevel = QtWarningMsg;
+    query.category = QStringLiteral("app.net*");
+
+    const auto matches = search.search(query);
+    QCOMPARE(static_cast<int>(matches.size()), 25);
+
+    for (int i = 0; i < matches.size(); ++i) {
+        const auto &match = matches.at(i);
+        QVERIFY(match.message);
+        QVERIFY(match.line.isEmpty());
+        QCOMPARE(number(match), 20 + i * 4);
+        QCOMPARE(match.message->type(), QtWarningMsg);
+        QCOMPARE(QByteArray(match.message->category()), QByteArray("app.network"));
+        QCOMPARE(match.time, m_baseTime.addSecs(20 + i * 4).toMSecsSinceEpoch());
+    }
+
+    query.category = QStringLiteral("app.ui");
+    QVERIFY(search.search(query).isEmpty());
+
+    QVERIFY(search.errors().isEmpty());
+}
+
+void TestLogSearch::testMergeOrder()
+{
+    auto search = LogSearch(writeTextLog(300));
+    search.setMaxThreadCount(4);
+    QCOMPARE(search.maxThreadCount(), 4);
+
+    const auto matches = search.search(LogSearch::Query());
+    QCOMPARE(static_cast<int>(matches.size()), 300);
+
+    for (int i = 0; i < matches.size(); ++i) {
+        QCOMPARE(number(matches.at(i)), i);
+        if (i > 0)
+            QVERIFY(matches.at(i).time >= matches.at(i - 1).time);
+    }
+}
+
+void TestLogSearch::testMergeOrderWithoutTimeIndex()
+{
+    const auto logPath = writeTextLog(300);
+    QVERIFY(QFile::remove(TimeIndex::indexFileName(logPath)));
+
+    auto search = LogSearch(logPath);
+    const auto matches = search.search(LogSearch::Query());
+    QCOMPARE(static_cast<int>(matches.size()), 300);
+
+    // The lines of the active file have no time but stay after the older files
+    for (int i = 0; i < matches.size(); ++i) {
+        QCOMPARE(number(matches.at(i)), i);
+    }
+    QCOMPARE(matches.last().time, qint64(0));
+    QVERIFY(matches.first().time > 0);
+}
+
+void TestLogSearch::testTimeRangeWithoutTimeIndex()
+{
+    const auto logPath = writeTextLog(300);
+    QVERIFY(QFile::remove(TimeIndex::indexFileName(logPath)));
+
+    auto search = LogSearch(logPath);
+
+    LogSearch::Query query;
+    QCOMPARE(static_cast<int>(search.search(query).size()), 300);
+    QVERIFY(search.warnings().isEmpty());
+
+    // The active file is searched completely and reported
+    query.from = m_baseTime.addSecs(10);
+    query.to = m_baseTime.addSecs(20);
+    const auto matches = search.search(query);
+    QVERIFY(!matches.isEmpty());
+    QCOMPARE(number(matches.last()), 299);
+
+    QCOMPARE(search.warnings(),
+             QStringList { QStringLiteral("%1: no time index, the time range can't be applied")
+                                   .arg(logPath) });
+    QVERIFY(search.errors().isEmpty());
+}
+
+void TestLogSearch::testStreamedMatches()
+{
+    auto search = LogSearch(writeTextLog(300));
+    search.setMaxThreadCount(4);
+
+    LogSearch::Query query;
+    query.text = QStringLiteral("msg 1");
+
+    QList<LogSearch::Match> matches;
+    QStringList fileOrder;
+    search.search(query, [&](const LogSearch::Match &match) {
+        matches.append(match);
+        if (fileOrder.isEmpty() || fileOrder.last() != match.fileName)
+            fileOrder.append(match.fileName);
+    });
+
+    QCOMPARE(static_cast<int>(matches.size()), 100);
+    for (int i = 0; i < matches.size(); ++i) {
+        QCOMPARE(number(matches.at(i)), 100 + i);
+    }
+
+    // Every file is passed on once, in the order of the files
+    auto files = search.files();
+    for (auto it = files.begin(); it != files.end();) {
+        if (fileOrder.contains(*it))
+            ++it;
+        else
+            it = files.erase(it);
+    }
+    QCOMPARE(fileOrder, files);
+}
+
+void TestLogSearch::testLargeFile()
+{
+    const auto logPath = m_tempDir->filePath("large.log");
+
+    {
+        QFile file(logPath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+
+        // Longer than a read chunk, and more lines than fit in one
+        file.write(QByteArray(1536 * 1024, 'x'));
+        file.write(" long\n");
+        for (int i = 0; i < 40000; ++i) {
+            file.write(QStringLiteral("msg %1 padding the line to a few dozen bytes\n")
+                               .arg(i, 5, 10, QLatin1Char('0'))
+                               .toUtf8());
+        }
+    }
+
+    auto search = LogSearch(logPath);
+
+    LogSearch::Query query;
+    query.text = QStringLiteral(" long");
+    auto matches = search.search(query);
+    QCOMPARE(static_cast<int>(matches.size()), 1);
+    QCOMPARE(matches.first().line.size(), 1536 * 1024 + 5);
+
+    query.text = QStringLiteral("padding");
+    matches = search.search(query);
+    QCOMPARE(static_cast<int>(matches.size()), 40000);
+    for (int i = 0; i < matches.size(); ++i) {
+        QVERIFY(matches.at(i).line.startsWith(
+                QStringLiteral("msg %1 ").arg(i, 5, 10, QLatin1Char('0'))));
+    }
+}
+
+void TestLogSearch::testMissingLog()
+{
+    auto search = LogSearch(m_tempDir->filePath("missing.log"));
+
+    QVERIFY(search.files().isEmpty());
+    QVERIFY(search.search(LogSearch::Query()).isEmpty());
+    QVERIFY(search.errors().isEmpty());
+}
+
+QTEST_MAIN(TestLogSearch)
+#include "test_logsearch.moc"
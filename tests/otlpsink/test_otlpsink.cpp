@@ -0,0 +1,360 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/sinks/otlpsink.h"
+
+using namespace QtLogger;
+
+// Minimal HTTP/1.1 server standing in for an OpenTelemetry collector
+class CollectorStandIn : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Request
+    {
+        QByteArray path;
+        QByteArray contentType;
+        QByteArray authorization;
+        QJsonObject body;
+    };
+
+    CollectorStandIn()
+    {
+        connect(&m_server, &QTcpServer::newConnection, this, [this] {
+            while (auto *connection = m_server.nextPendingConnection()) {
+                connect(connection, &QIODevice::readyRead, this,
+                        [this, connection] { read(connection); });
+            }
+        });
+    }
+
+    bool listen() { return m_server.listen(QHostAddress::LocalHost); }
+    QString url() const { return QStringLiteral("http://127.0.0.1:%1").arg(m_server.serverPort()); }
+
+    int statusCode = 200;
+    QList<Request> requests;
+
+    int recordCount() const
+    {
+        int count = 0;
+        for (const auto &request : requests) {
+            const auto scopeLogs = request.body.value("resourceLogs")
+                                           .toArray()
+                                           .at(0)
+                                           .toObject()
+                                           .value("scopeLogs")
+                                           .toArray();
+            for (const auto &scope : scopeLogs) {
+                count += scope.toObject().value("logRecords").toArray().size();
+            }
+        }
+        return count;
+    }
+
+private:
+    void read(QTcpSocket *connection)
+    {
+        auto &buffer = m_buffers[connection];
+        buffer.append(connection->readAll());
+
+        for (;;) {
+            const auto headerEnd = buffer.indexOf("\r\n\r\n");
+            if (headerEnd < 0)
+                return;
+
+            Request request;
+            int contentLength = 0;
+            const auto lines = buffer.left(headerEnd).split('\n');
+            request.path = lines.value(0).split(' ').value(1);
+            for (const auto &line : lines) {
+                const auto colon = line.indexOf(':');
+                const auto name = line.left(colon).trimmed().toLower();
+                const auto value = line.mid(colon + 1).trimmed();
+                if (name == "content-length")
+                    contentLength = value.toInt();
+                else if (name == "content-type")
+                    request.contentType = value;
+                else if (name == "authorization")
+                    request.authorization = value;
+            }
+
+            if (buffer.size() < headerEnd + 4 + contentLength)
+                return;
+
+            request.body = QJsonDocument::fromJson(buffer.mid(headerEnd + 4, contentLength)).object();
+            buffer.remove(0, headerEnd + 4 + contentLength);
+            requests.append(request);
+
+            connection->write(QByteArray("HTTP/1.1 ") + QByteArray::number(statusCode)
+                              + " Status\r\nContent-Length: 0\r\n\r\n");
+        }
+    }
+
+    QTcpServer m_server;
+    QHash<QTcpSocket *, QByteArray> m_buffers;
+};
+
+class TestOtlpSink : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testLogRecord();
+    void testAttributeValues();
+    void testExportRequest();
+    void testDefaultResourceAttributes();
+    void testBatchSize();
+    void testScheduleDelay();
+    void testMaxQueueSize();
+    void testExportFailure();
+
+private:
+    LogMessage createLogMessage(const QString &message, QtMsgType type = QtDebugMsg,
+                                const char *category = "test.category");
+    QVariant recordAttribute(const QJsonObject &record, const QString &key);
+
+    CollectorStandIn *m_collector = nullptr;
+};
+
+void TestOtlpSink::init()
+{
+    m_collector = new CollectorStandIn();
+    QVERIFY(m_collector->listen());
+}
+
+void TestOtlpSink::cleanup()
+{
+    delete m_collector;
+    m_collector = nullptr;
+}
+
+LogMessage TestOtlpSink::createLogMessage(const QString &message, QtMsgType type,
+                                          const char *category)
+{
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", category);
+    return LogMessage(type, context, message);
+}
+
+QVariant TestOtlpSink::recordAttribute(const QJsonObject &record, const QString &key)
+{
+    const auto attributes = record.value("attributes").toArray();
+    for (const auto &attribute : attributes) {
+        if (attribute.toObject().value("key").toString() == key)
+            return attribute.toObject().value("value").toObject().toVariantMap();
+    }
+    return QVariant();
+}
+
+void TestOtlpSink::testLogRecord()
+{
+    const auto time = QDateTime::fromMSecsSinceEpoch(1700000000123LL);
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", "test.category");
+    LogMessage lmsg(QtWarningMsg, context, "Disk is almost full", time);
+
+    auto record = OtlpSink::toLogRecord(lmsg);
+    QCOMPARE(record.value("timeUnixNano").toString(), QString("1700000000123000000"));
+    QCOMPARE(record.value("observedTimeUnixNano").toString(), QString("1700000000123000000"));
+    QCOMPARE(record.value("severityNumber").toInt(), 13);
+    QCOMPARE(record.value("severityText").toString(), QString("WARN"));
+    QCOMPARE(record.value("body").toObject().value("stringValue").toString(),
+             QString("Disk is almost full"));
+    QCOMPARE(recordAttribute(record, "code.file.path").toMap().value("stringValue").toString(),
+             QString("test.cpp"));
+    QCOMPARE(recordAttribute(record, "code.line.number").toMap().value("intValue").toString(),
+             QString("42"));
+    QCOMPARE(recordAttribute(record, "code.function.name").toMap().value("stringValue").toString(),
+             QString("void testFunction()"));
+
+    // The body is the formatted message
+    lmsg.setFormattedMessage("[warning] Disk is almost full");
+    record = OtlpSink::toLogRecord(lmsg);
+    QCOMPARE(record.value("body").toObject().value("stringValue").toString(),
+             QString("[warning] Disk is almost full"));
+
+    const QList<QPair<QtMsgType, int>> severities = {
+        { QtDebugMsg, 5 }, { QtInfoMsg, 9 }, { QtWarningMsg, 13 }, { QtCriticalMsg, 17 },
+        { QtFatalMsg, 21 }
+    };
+    for (const auto &severity : severities) {
+        QCOMPARE(OtlpSink::toLogRecord(createLogMessage("x", severity.first))
+                         .value("severityNumber")
+                         .toInt(),
+                 severity.second);
+    }
+}
+
+void TestOtlpSink::testAttributeValues()
+{
+    auto lmsg = createLogMessage("Attributes");
+    lmsg.setAttribute("string", "value");
+    lmsg.setAttribute("int", 7);
+    lmsg.setAttribute("double", 2.5);
+    lmsg.setAttribute("bool", true);
+    lmsg.setAttribute("list", QVariantList { 1, "two" });
+    lmsg.setAttribute("map", QVariantMap { { "key", "value" } });
+
+    const auto record = OtlpSink::toLogRecord(lmsg);
+
+    QCOMPARE(recordAttribute(record, "string").toMap().value("stringValue").toString(),
+             QString("value"));
+    QCOMPARE(recordAttribute(record, "int").toMap().value("intValue").toString(), QString("7"));
+    QCOMPARE(recordAttribute(record, "double").toMap().value("doubleValue").toDouble(), 2.5);
+    QCOMPARE(recordAttribute(record, "bool").toMap().value("boolValue").toBool(), true);
+
+    const auto list = recordAttribute(record, "list")
+                              .toMap()
+                              .value("arrayValue")
+                              .toMap()
+                              .value("values")
+                              .toList();
+    QCOMPARE(list.size(), 2);
+    QCOMPARE(list.at(0).toMap().value("intValue").toString(), QString("1"));
+    QCOMPARE(list.at(1).toMap().value("stringValue").toString(), QString("two"));
+
+    const auto map = recordAttribute(record, "map")
+                             .toMap()
+                             .value("kvlistValue")
+                             .toMap()
+                             .value("values")
+                             .toList();
+    QCOMPARE(map.size(), 1);
+    QCOMPARE(map.at(0).toMap().value("key").toString(), QString("key"));
+}
+
+void TestOtlpSink::testExportRequest()
+{
+    const QList<LogMessage> messages = { createLogMessage("one", QtDebugMsg, "net"),
+                                         createLogMessage("two", QtDebugMsg, "ui"),
+                                         createLogMessage("three", QtDebugMsg, "net"),
+                                         createLogMessage("four", QtDebugMsg, "") };
+
+    const auto json = OtlpSink::exportRequest(messages, { { "service.name", "test" } });
+    const auto resourceLogs =
+            QJsonDocument::fromJson(json).object().value("resourceLogs").toArray();
+    QCOMPARE(resourceLogs.size(), 1);
+
+    const auto resource = resourceLogs.at(0).toObject().value("resource").toObject();
+    const auto resourceAttrs = resource.value("attributes").toArray();
+    QCOMPARE(resourceAttrs.size(), 1);
+    QCOMPARE(resourceAttrs.at(0).toObject().value("key").toString(), QString("service.name"));
+
+    // Categories become scopes in the order of their first message
+    const auto scopeLogs = resourceLogs.at(0).toObject().value("scopeLogs").toArray();
+    QCOMPARE(scopeLogs.size(), 3);
+    QCOMPARE(scopeLogs.at(0).toObject().value("scope").toObject().value("name").toString(),
+             QString("net"));
+    QCOMPARE(scopeLogs.at(1).toObject().value("scope").toObject().value("name").toString(),
+             QString("ui"));
+    QCOMPARE(scopeLogs.at(2).toObject().value("scope").toObject().value("name").toString(),
+             QString("default"));
+
+    const auto netRecords = scopeLogs.at(0).toObject().value("logRecords").toArray();
+    QCOMPARE(netRecords.size(), 2);
+    QCOMPARE(netRecords.at(0).toObject().value("body").toObject().value("stringValue").toString(),
+             QString("one"));
+    QCOMPARE(netRecords.at(1).toObject().value("body").toObject().value("stringValue").toString(),
+             QString("three"));
+}
+
+void TestOtlpSink::testDefaultResourceAttributes()
+{
+    const auto attrs = OtlpSink::defaultResourceAttributes();
+
+    QVERIFY(!attrs.value("service.name").toString().isEmpty());
+    QCOMPARE(attrs.value("process.pid").toLongLong(),
+             static_cast<qlonglong>(QCoreApplication::applicationPid()));
+    QCOMPARE(attrs.value("host.name").toString(), QSysInfo::machineHostName());
+    QCOMPARE(attrs.value("telemetry.sdk.name").toString(), QString("qtlogger"));
+    QVERIFY(!attrs.contains("appname"));
+}
+
+void TestOtlpSink::testBatchSize()
+{
+    OtlpSink sink(QUrl(m_collector->url()), { { "Authorization", "Bearer token" } });
+    QCOMPARE(sink.endpoint().path(), QString("/v1/logs"));
+
+    sink.setMaxExportBatchSize(10);
+    sink.setScheduleDelay(60000);
+    QCOMPARE(sink.maxExportBatchSize(), 10);
+    QCOMPARE(sink.scheduleDelay(), 60000);
+
+    for (int i = 0; i < 25; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1").arg(i)));
+
+    // Full batches are exported one at a time, the rest waits for the schedule delay
+    QTRY_COMPARE(m_collector->requests.size(), 2);
+    QTest::qWait(100);
+    QCOMPARE(m_collector->requests.size(), 2);
+    QCOMPARE(m_collector->recordCount(), 20);
+
+    QVERIFY(sink.flush());
+    QTRY_COMPARE(m_collector->requests.size(), 3);
+    QCOMPARE(m_collector->recordCount(), 25);
+    QTRY_COMPARE(sink.exportedCount(), quint64(25));
+    QCOMPARE(sink.droppedCount(), quint64(0));
+
+    const auto &request = m_collector->requests.first();
+    QCOMPARE(request.path, QByteArray("/v1/logs"));
+    QCOMPARE(request.contentType, QByteArray("application/json"));
+    QCOMPARE(request.authorization, QByteArray("Bearer token"));
+}
+
+void TestOtlpSink::testScheduleDelay()
+{
+    OtlpSink sink(QUrl(m_collector->url() + "/custom/logs"));
+    QCOMPARE(sink.endpoint().path(), QString("/custom/logs"));
+
+    sink.setScheduleDelay(50);
+
+    sink.send(createLogMessage("One"));
+    sink.send(createLogMessage("Two"));
+    sink.send(createLogMessage("Three"));
+
+    QTRY_COMPARE(m_collector->requests.size(), 1);
+    QCOMPARE(m_collector->requests.first().path, QByteArray("/custom/logs"));
+    QCOMPARE(m_collector->recordCount(), 3);
+}
+
+void TestOtlpSink::testMaxQueueSize()
+{
+    OtlpSink sink(QUrl(m_collector->url()));
+    sink.setMaxQueueSize(5);
+    sink.setScheduleDelay(60000);
+    QCOMPARE(sink.maxQueueSize(), 5);
+
+    for (int i = 0; i < 8; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1").arg(i)));
+    QCOMPARE(sink.droppedCount(), quint64(3));
+
+    sink.flush();
+    QTRY_COMPARE(sink.exportedCount(), quint64(5));
+    QCOMPARE(m_collector->recordCount(), 5);
+}
+
+void TestOtlpSink::testExportFailure()
+{
+    m_collector->statusCode = 503;
+
+    OtlpSink sink(QUrl(m_collector->url()));
+    sink.send(createLogMessage("One"));
+    sink.send(createLogMessage("Two"));
+    sink.flush();
+
+    QTRY_COMPARE(sink.droppedCount(), quint64(2));
+    QCOMPARE(sink.exportedCount(), quint64(0));
+}
+
+QTEST_MAIN(TestOtlpSink)
+#include "test_otlpsink.moc"
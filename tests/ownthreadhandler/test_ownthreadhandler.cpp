@@ -9,6 +9,7 @@
 #include <QEventLoop>
 
 #ifndef QTLOGGER_NO_THREAD
+#include "qtlogger/formatters/functionformatter.h"
 #include "qtlogger/ownthreadhandler.h"
 #include "qtlogger/logmessage.h"
 #include "qtlogger/simplepipeline.h"
@@ -53,6 +54,15 @@ private slots:
     void testThreadSafetyWithPipeline();
     void testMultipleHandlersInOwnThreads();
 
+    // Caller thread formatting tests
+    void testFormatInCallerThread();
+    void testFormatInCallerThreadFiltered();
+    void testFormatInCallerThreadLeadingSink();
+
+    // Priority lane tests
+    void testPriorityLane();
+    void testPriorityLaneOrdered();
+
     // Edge cases and error handling
     void testProcessBeforeMoveToThread();
     void testProcessAfterReset();
@@ -437,6 +447,154 @@ void TestOwnThreadHandler::testThreadSafetyWithPipeline()
     handler.resetOwnThread();
 }
 
+void TestOwnThreadHandler::testFormatInCallerThread()
+{
+    OwnThreadHandler<ThreadSafeMockPipeline> handler(false);
+    handler.append(m_mockHandler);
+    handler.addMockSink(m_mockSink);
+    handler.setFormatInCallerThread(true);
+    handler.moveToOwnThread();
+
+    QVERIFY(handler.formatInCallerThread());
+
+    LogMessage msg(QtDebugMsg, QMessageLogContext(), "caller thread test");
+    QVERIFY(handler.process(msg));
+
+    // Leading handler runs synchronously in the calling thread
+    QCOMPARE(m_mockHandler->processCallCount(), 1);
+    QCOMPARE(m_mockHandler->lastProcessingThreadId(), ThreadTester::currentThreadId());
+
+    // Sink runs in the own thread
+    QVERIFY(m_mockSink->waitForSending(2000));
+    QCOMPARE(m_mockSink->sendCallCount(), 1);
+    QCOMPARE(m_mockSink->lastMessage(), QString("caller thread test"));
+    QVERIFY(ThreadTester::isDifferentThread(m_mockSink->lastSendingThreadId()));
+
+    handler.resetOwnThread();
+}
+
+void TestOwnThreadHandler::testFormatInCallerThreadFiltered()
+{
+    OwnThreadHandler<ThreadSafeMockPipeline> handler(false);
+    m_mockHandler->setReturnValue(false);
+    handler.append(m_mockHandler);
+    handler.addMockSink(m_mockSink);
+    handler.setFormatInCallerThread(true);
+    handler.moveToOwnThread();
+
+    LogMessage msg(QtDebugMsg, QMessageLogContext(), "filtered");
+    QVERIFY(handler.process(msg));
+
+    QCOMPARE(m_mockHandler->processCallCount(), 1);
+
+    // Nothing is queued when the leading handlers stop the message
+    waitForEventProcessing(100);
+    QCOMPARE(m_mockSink->sendCallCount(), 0);
+
+    handler.resetOwnThread();
+}
+
+void TestOwnThreadHandler::testFormatInCallerThreadLeadingSink()
+{
+    auto leadingSink = QSharedPointer<ThreadSafeMockSinkHandler>::create();
+
+    OwnThreadHandler<ThreadSafeMockPipeline> handler(false);
+    handler.append(leadingSink);
+    handler.append(m_mockHandler);
+    handler.append(FunctionFormatterPtr::create(
+            [](const LogMessage &lmsg) { return QStringLiteral("formatted ") + lmsg.message(); }));
+    handler.addMockSink(m_mockSink);
+    handler.setFormatInCallerThread(true);
+    handler.moveToOwnThread();
+
+    LogMessage msg(QtDebugMsg, QMessageLogContext(), "leading sink");
+    QVERIFY(handler.process(msg));
+
+    // A sink at the start doesn't keep the following handlers out of the calling thread
+    QCOMPARE(m_mockHandler->processCallCount(), 1);
+    QCOMPARE(m_mockHandler->lastProcessingThreadId(), ThreadTester::currentThreadId());
+
+    QVERIFY(ThreadTester::waitFor([this]() { return m_mockSink->sendCallCount() == 1; }));
+    QCOMPARE(m_mockSink->lastMessage(), QString("formatted leading sink"));
+
+    // The leading sink gets the message before the formatter, in the own thread
+    QCOMPARE(leadingSink->sendCallCount(), 1);
+    QVERIFY(leadingSink->lastMessage() != QString("formatted leading sink"));
+    QVERIFY(ThreadTester::isDifferentThread(leadingSink->lastSendingThreadId()));
+
+    // and also the messages the following handlers stop
+    m_mockHandler->setReturnValue(false);
+    LogMessage filtered(QtDebugMsg, QMessageLogContext(), "filtered");
+    QVERIFY(handler.process(filtered));
+
+    QVERIFY(ThreadTester::waitFor([&leadingSink]() { return leadingSink->sendCallCount() == 2; }));
+    waitForEventProcessing(100);
+    QCOMPARE(m_mockSink->sendCallCount(), 1);
+
+    handler.resetOwnThread();
+}
+
+void TestOwnThreadHandler::testPriorityLane()
+{
+    OwnThreadHandler<ThreadSafeMockPipeline> handler(false);
+    handler.addMockSink(m_mockSink);
+    handler.setPriorityLane(QtWarningMsg);
+    handler.moveToOwnThread();
+
+    QVERIFY(handler.hasPriorityLane());
+    QCOMPARE(handler.priorityLaneLevel(), QtWarningMsg);
+    QVERIFY(!handler.priorityLaneOrdered());
+
+    // A backlog the own thread needs a while for
+    m_mockSink->setSendDelay(5);
+    for (int i = 0; i < 100; ++i) {
+        LogMessage msg(QtDebugMsg, QMessageLogContext(), QStringLiteral("debug %1").arg(i));
+        handler.process(msg);
+    }
+
+    LogMessage critical(QtCriticalMsg, QMessageLogContext(), "critical");
+    handler.process(critical);
+
+    QVERIFY(ThreadTester::waitFor([this]() { return m_mockSink->sendCallCount() == 101; }));
+
+    // Written ahead of the queued messages, all of them are still written
+    const auto messages = m_mockSink->sentMessages();
+    QVERIFY(messages.indexOf(QStringLiteral("critical")) < 50);
+    QCOMPARE(messages.last(), QStringLiteral("debug 99"));
+
+    handler.disablePriorityLane();
+    QVERIFY(!handler.hasPriorityLane());
+
+    handler.resetOwnThread();
+}
+
+void TestOwnThreadHandler::testPriorityLaneOrdered()
+{
+    OwnThreadHandler<ThreadSafeMockPipeline> handler(false);
+    handler.addMockSink(m_mockSink);
+    handler.setPriorityLane(QtCriticalMsg, true);
+    handler.moveToOwnThread();
+
+    QVERIFY(handler.priorityLaneOrdered());
+
+    m_mockSink->setSendDelay(5);
+    for (int i = 0; i < 20; ++i) {
+        LogMessage msg(QtWarningMsg, QMessageLogContext(), QStringLiteral("warning %1").arg(i));
+        handler.process(msg);
+    }
+
+    LogMessage critical(QtCriticalMsg, QMessageLogContext(), "critical");
+    handler.process(critical);
+
+    QVERIFY(ThreadTester::waitFor([this]() { return m_mockSink->sendCallCount() == 21; }));
+
+    // Keeps its place after the warnings below the level
+    const auto messages = m_mockSink->sentMessages();
+    QCOMPARE(messages.indexOf(QStringLiteral("critical")), 20);
+
+    handler.resetOwnThread();
+}
+
 void TestOwnThreadHandler::testMultipleHandlersInOwnThreads()
 {
     OwnThreadHandler<ThreadSafeMockHandler> handler1;
@@ -56,6 +56,7 @@ private slots:
     // Edge cases
     void testEmptyMessage();
     void testVeryLargeMessage();
+    void testFileNotOpened();
 
 private:
     LogMessage createLogMessage(const QString &message);
@@ -511,5 +512,23 @@ void TestRotatingFileSink::testVeryLargeMessage()
     QVERIFY(content.contains(largeContent));
 }
 
+void TestRotatingFileSink::testFileNotOpened()
+{
+    // A directory in place of the log file can't be opened for writing
+    auto logPath = m_tempDir->filePath("not_a_file.log");
+    QVERIFY(QDir(m_tempDir->path()).mkdir("not_a_file.log"));
+
+    auto sink = RotatingFileSink(logPath, 1024, 5, RotatingFileSink::TimeIndex);
+
+    for (int i = 0; i < 10; ++i) {
+        auto lmsg = createLogMessage(QString("Message %1").arg(i));
+        sink.send(lmsg);
+    }
+    sink.flush();
+
+    QVERIFY(QFileInfo(logPath).isDir());
+    QVERIFY(findRotatedFiles(logPath).isEmpty());
+}
+
 QTEST_MAIN(TestRotatingFileSink)
 #include "test_rotatingfilesink.moc"
\ No newline at end of file
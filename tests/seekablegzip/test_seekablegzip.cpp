@@ -0,0 +1,289 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtEndian>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/seekablegzip.h"
+#include "qtlogger/sinks/rotatingfilesink.h"
+#include "qtlogger/timeindex.h"
+
+using namespace QtLogger;
+
+class TestSeekableGzip : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testMember();
+    void testRoundTrip();
+    void testBlocksAtLineBoundaries();
+    void testRandomAccess();
+    void testReadLine();
+    void testEmptyFile();
+    void testMissingIndex();
+
+    // RotatingFileSink::BlockCompression
+    void testRotatedBlockCompression();
+    void testSeekInCompressedFiles();
+
+private:
+    QByteArray createLog(int lines);
+    QString writeFile(const QString &name, const QByteArray &data);
+    LogMessage createLogMessage(const QString &message, const QDateTime &time);
+
+    QTemporaryDir *m_tempDir = nullptr;
+};
+
+void TestSeekableGzip::init()
+{
+    m_tempDir = new QTemporaryDir();
+    QVERIFY(m_tempDir->isValid());
+}
+
+void TestSeekableGzip::cleanup()
+{
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+QByteArray TestSeekableGzip::createLog(int lines)
+{
+    QByteArray data;
+    for (int i = 0; i < lines; ++i) {
+        data += QByteArray("Message number ") + QByteArray::number(i) + "\n";
+    }
+    return data;
+}
+
+QString TestSeekableGzip::writeFile(const QString &name, const QByteArray &data)
+{
+    const auto path = m_tempDir->filePath(name);
+    auto file = QFile(path);
+    if (file.open(QIODevice::WriteOnly))
+        file.write(data);
+    return path;
+}
+
+LogMessage TestSeekableGzip::createLogMessage(const QString &message, const QDateTime &time)
+{
+    QMessageLogContext context("test.cpp", 42, "testFunction", "test.category");
+    auto lmsg = LogMessage(QtDebugMsg, context, message, time);
+    lmsg.setFormattedMessage(message);
+    return lmsg;
+}
+
+void TestSeekableGzip::testMember()
+{
+    const auto data = createLog(10);
+    const auto gzip = SeekableGzip::member(data);
+
+    QVERIFY(gzip.startsWith("\x1f\x8b\x08"));
+    QVERIFY(gzip.size() < data.size());
+
+    // ISIZE trailer
+    QCOMPARE(qFromLittleEndian<quint32>(gzip.constData() + gzip.size() - 4),
+             static_cast<quint32>(data.size()));
+}
+
+void TestSeekableGzip::testRoundTrip()
+{
+    const auto data = createLog(1000);
+    const auto path = writeFile("app.log", data);
+
+    QVERIFY(SeekableGzip::compress(path, 1024));
+    QVERIFY(QFile::exists(path + ".gz"));
+    QVERIFY(QFile::exists(path + ".gz.gzi"));
+
+    auto file = SeekableGzipFile(path + ".gz");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.size(), qint64(data.size()));
+    QVERIFY(file.blocks().size() > 10);
+
+    QCOMPARE(file.readAll(), data);
+
+    // Blocks are independent and concatenate to the file
+    QByteArray blocks;
+    for (int i = 0; i < file.blocks().size(); ++i) {
+        blocks += file.block(i);
+    }
+    QCOMPARE(blocks, data);
+}
+
+void TestSeekableGzip::testBlocksAtLineBoundaries()
+{
+    const auto data = createLog(200);
+    const auto path = writeFile("lines.log", data);
+
+    QVERIFY(SeekableGzip::compress(path, 100));
+
+    auto file = SeekableGzipFile(path + ".gz");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    const auto &blocks = file.blocks();
+    QCOMPARE(blocks.first().uncompressedOffset, qint64(0));
+    QCOMPARE(blocks.first().compressedOffset, qint64(0));
+
+    for (int i = 1; i < blocks.size(); ++i) {
+        QVERIFY(blocks.at(i).uncompressedOffset - blocks.at(i - 1).uncompressedOffset >= 100);
+        QVERIFY(blocks.at(i).compressedOffset > blocks.at(i - 1).compressedOffset);
+        QCOMPARE(data.at(static_cast<int>(blocks.at(i).uncompressedOffset) - 1), '\n');
+    }
+}
+
+void TestSeekableGzip::testRandomAccess()
+{
+    const auto data = createLog(2000);
+    const auto path = writeFile("random.log", data);
+
+    QVERIFY(SeekableGzip::compress(path, 4096));
+
+    auto file = SeekableGzipFile(path + ".gz");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    const qint64 offsets[] = { data.size() - 10, 0, 12345, 4095, 4096, 20000 };
+    for (const auto offset : offsets) {
+        QVERIFY(file.seek(offset));
+        QCOMPARE(file.read(100), data.mid(static_cast<int>(offset), 100));
+    }
+
+    QCOMPARE(file.blockAt(0), 0);
+    QCOMPARE(file.blockAt(-1), -1);
+    QCOMPARE(file.blockAt(data.size()), -1);
+    QCOMPARE(file.blockAt(data.size() - 1), static_cast<int>(file.blocks().size()) - 1);
+}
+
+void TestSeekableGzip::testReadLine()
+{
+    const auto data = createLog(500);
+    const auto path = writeFile("readline.log", data);
+
+    QVERIFY(SeekableGzip::compress(path, 256));
+
+    auto file = SeekableGzipFile(path + ".gz");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    auto lines = 0;
+    while (!file.atEnd()) {
+        QCOMPARE(file.readLine(), QByteArray("Message number ") + QByteArray::number(lines) + "\n");
+        ++lines;
+    }
+    QCOMPARE(lines, 500);
+}
+
+void TestSeekableGzip::testEmptyFile()
+{
+    const auto path = writeFile("empty.log", QByteArray());
+
+    QVERIFY(SeekableGzip::compress(path));
+
+    auto file = SeekableGzipFile(path + ".gz");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.size(), qint64(0));
+    QCOMPARE(file.blocks().size(), 1);
+    QVERIFY(file.atEnd());
+    QVERIFY(file.readAll().isEmpty());
+}
+
+void TestSeekableGzip::testMissingIndex()
+{
+    const auto path = writeFile("plain.log.gz", SeekableGzip::member(createLog(10)));
+
+    auto file = SeekableGzipFile(path);
+    QVERIFY(!file.open(QIODevice::ReadOnly));
+    QVERIFY(!file.isOpen());
+}
+
+void TestSeekableGzip::testRotatedBlockCompression()
+{
+    const auto logPath = m_tempDir->filePath("rotated.log");
+    const auto baseTime = QDateTime::currentDateTime().addSecs(-3600);
+
+    {
+        auto sink = RotatingFileSink(logPath, 2000, 0, RotatingFileSink::BlockCompression);
+        sink.setCompressionBlockSize(300);
+        sink.setTimeIndexInterval(50, 3600 * 1000);
+
+        for (int i = 0; i < 150; ++i) {
+            const auto message =
+                    QStringLiteral("Message number %1").arg(i, 3, 10, QLatin1Char('0'));
+            sink.send(createLogMessage(message, baseTime.addSecs(i)));
+        }
+    }
+
+    auto dir = QDir(m_tempDir->path());
+    const auto archives = dir.entryList({ QStringLiteral("rotated.*.log.gz") }, QDir::Files);
+    QVERIFY(!archives.isEmpty());
+    QCOMPARE(dir.entryList({ QStringLiteral("rotated.*.log.gz.gzi") }, QDir::Files).size(),
+             archives.size());
+    QVERIFY(dir.entryList({ QStringLiteral("rotated.*.log") }, QDir::Files).isEmpty());
+
+    for (const auto &archive : archives) {
+        auto file = SeekableGzipFile(dir.filePath(archive));
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QVERIFY(file.blocks().size() > 1);
+
+        // Block times come from the time index, which keeps the name of the uncompressed file
+        const auto entries = TimeIndex::readEntries(
+                TimeIndex::indexFileName(dir.filePath(archive.left(archive.size() - 3))));
+        QVERIFY(!entries.isEmpty());
+        QCOMPARE(file.blocks().first().time, entries.first().time);
+
+        for (int i = 1; i < file.blocks().size(); ++i) {
+            QVERIFY(file.blocks().at(i).time > file.blocks().at(i - 1).time);
+        }
+    }
+}
+
+void TestSeekableGzip::testSeekInCompressedFiles()
+{
+    const auto logPath = m_tempDir->filePath("seek.log");
+    const auto baseTime = QDateTime::currentDateTime().addSecs(-3600);
+
+    {
+        auto sink = RotatingFileSink(logPath, 400, 0, RotatingFileSink::BlockCompression);
+        sink.setCompressionBlockSize(100);
+        sink.setTimeIndexInterval(40, 3600 * 1000);
+
+        for (int i = 0; i < 200; ++i) {
+            sink.send(createLogMessage(QStringLiteral("msg %1").arg(i, 3, 10, QLatin1Char('0')),
+                                       baseTime.addSecs(i)));
+        }
+    }
+
+    auto reader = TimeIndexReader(logPath);
+    const auto files = reader.files();
+    QVERIFY(files.size() > 3);
+    QVERIFY(files.first().endsWith(".gz"));
+    QVERIFY(!files.last().endsWith(".gz"));
+
+    QVERIFY(reader.seek(baseTime.addSecs(77)));
+    QVERIFY(reader.fileName().endsWith(".gz"));
+
+    auto first = -1;
+    auto expected = -1;
+    while (!reader.atEnd()) {
+        const auto line = reader.readLine().trimmed();
+        const auto number = line.mid(4).toInt();
+        if (first < 0) {
+            first = number;
+            expected = number;
+        }
+        QCOMPARE(number, expected);
+        ++expected;
+    }
+
+    QVERIFY(first <= 77);
+    QVERIFY(first > 70);
+    QCOMPARE(expected, 200);
+}
+
+QTEST_MAIN(TestSeekableGzip)
+#include "test_seekablegzip.moc"
@@ -0,0 +1,358 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <thread>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/segmentedlog.h"
+#include "qtlogger/sinks/segmentedlogsink.h"
+
+using namespace QtLogger;
+
+class TestSegmentedLog : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testWriteAndConsume();
+    void testSegments();
+    void testCursors();
+    void testCursorPosition();
+    void testRetentionBySlowestCursor();
+    void testMaxSize();
+    void testReopen();
+    void testIncompleteRecord();
+    void testWaitForReadyRead();
+    void testInvalidName();
+
+private:
+    LogMessage createLogMessage(const QString &message);
+    void writeMessages(SegmentedLogSink &sink, int first, int count);
+    QStringList readMessages(SegmentedLogConsumer &consumer, int maxCount = -1);
+
+    QTemporaryDir *m_tempDir = nullptr;
+    QString m_path;
+};
+
+void TestSegmentedLog::init()
+{
+    m_tempDir = new QTemporaryDir();
+    QVERIFY(m_tempDir->isValid());
+    m_path = m_tempDir->filePath("log");
+}
+
+void TestSegmentedLog::cleanup()
+{
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+LogMessage TestSegmentedLog::createLogMessage(const QString &message)
+{
+    QMessageLogContext context("test.cpp", 42, "testFunction", "test.category");
+    return LogMessage(QtInfoMsg, context, message);
+}
+
+void TestSegmentedLog::writeMessages(SegmentedLogSink &sink, int first, int count)
+{
+    for (int i = first; i < first + count; ++i) {
+        sink.send(createLogMessage(QStringLiteral("message %1").arg(i)));
+    }
+}
+
+QStringList TestSegmentedLog::readMessages(SegmentedLogConsumer &consumer, int maxCount)
+{
+    QStringList messages;
+    while (maxCount < 0 || messages.size() < maxCount) {
+        const auto lmsg = consumer.next();
+        if (!lmsg)
+            break;
+        messages.append(lmsg->message());
+    }
+    return messages;
+}
+
+void TestSegmentedLog::testWriteAndConsume()
+{
+    auto sink = SegmentedLogSink(m_path);
+    QVERIFY(sink.isValid());
+
+    auto lmsg = createLogMessage(QStringLiteral("with attributes"));
+    lmsg.setAttribute(QStringLiteral("user"), QStringLiteral("john"));
+    sink.send(lmsg);
+    writeMessages(sink, 1, 99);
+    QCOMPARE(sink.nextOffset(), qint64(100));
+
+    auto consumer = SegmentedLogConsumer(m_path, QStringLiteral("shipper"));
+    QVERIFY(consumer.isValid());
+    QCOMPARE(consumer.position(), qint64(0));
+
+    const auto first = consumer.next();
+    QVERIFY(first);
+    QCOMPARE(first->message(), QStringLiteral("with attributes"));
+    QCOMPARE(first->type(), QtInfoMsg);
+    QCOMPARE(QString::fromUtf8(first->category()), QStringLiteral("test.category"));
+    QCOMPARE(first->attribute(QStringLiteral("user")).toString(), QStringLiteral("john"));
+
+    const auto messages = readMessages(consumer);
+    QCOMPARE(static_cast<int>(messages.size()), 99);
+    QCOMPARE(messages.last(), QStringLiteral("message 99"));
+    QCOMPARE(consumer.position(), qint64(100));
+
+    // Messages written later are read on
+    QVERIFY(!consumer.next());
+    writeMessages(sink, 100, 1);
+    QCOMPARE(consumer.next()->message(), QStringLiteral("message 100"));
+}
+
+void TestSegmentedLog::testSegments()
+{
+    auto sink = SegmentedLogSink(m_path, 1024);
+    writeMessages(sink, 0, 200);
+
+    const auto bases = SegmentedLog::segments(m_path);
+    QVERIFY(bases.size() > 5);
+    QCOMPARE(bases.first(), qint64(0));
+
+    // Every segment starts with the offset after the last record of the previous one
+    auto consumer = SegmentedLogConsumer(m_path, QStringLiteral("reader"));
+    for (int i = 0; i < 200; ++i) {
+        if (bases.contains(consumer.position())) {
+            auto file = QFile(SegmentedLog::segmentFileName(m_path, consumer.position()));
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            QVERIFY(file.size() <= 1024);
+        }
+
+        const auto lmsg = consumer.next();
+        QVERIFY(lmsg);
+        QCOMPARE(lmsg->message(), QStringLiteral("message %1").arg(i));
+    }
+    QVERIFY(!consumer.next());
+
+    // Seeking opens the segment with the offset
+    consumer.seek(150);
+    QCOMPARE(consumer.next()->message(), QStringLiteral("message 150"));
+}
+
+void TestSegmentedLog::testCursors()
+{
+    auto sink = SegmentedLogSink(m_path, 1024);
+    writeMessages(sink, 0, 100);
+
+    {
+        auto shipper = SegmentedLogConsumer(m_path, QStringLiteral("shipper"));
+        auto metrics = SegmentedLogConsumer(m_path, QStringLiteral("metrics"));
+
+        QCOMPARE(static_cast<int>(readMessages(shipper, 60).size()), 60);
+        QVERIFY(shipper.commit());
+        QCOMPARE(shipper.committedOffset(), qint64(60));
+
+        // Read, but not committed
+        readMessages(metrics, 30);
+        metrics.seek(20);
+        QVERIFY(metrics.commit());
+        readMessages(metrics, 5);
+    }
+
+    auto shipper = SegmentedLogConsumer(m_path, QStringLiteral("shipper"));
+    QCOMPARE(shipper.position(), qint64(60));
+    QCOMPARE(shipper.next()->message(), QStringLiteral("message 60"));
+
+    auto metrics = SegmentedLogConsumer(m_path, QStringLiteral("metrics"));
+    QCOMPARE(metrics.position(), qint64(20));
+    QCOMPARE(metrics.next()->message(), QStringLiteral("message 20"));
+
+    auto committed = SegmentedLog::committedOffsets(m_path);
+    std::sort(committed.begin(), committed.end());
+    QCOMPARE(committed, QList<qint64>({ 20, 60 }));
+
+    QVERIFY(SegmentedLog::removeCursor(m_path, QStringLiteral("metrics")));
+    QCOMPARE(SegmentedLog::committedOffsets(m_path), QList<qint64>({ 60 }));
+}
+
+void TestSegmentedLog::testCursorPosition()
+{
+    auto sink = SegmentedLogSink(m_path);
+    writeMessages(sink, 0, 1000);
+
+    const auto cursorFileName = SegmentedLog::cursorFileName(m_path, QStringLiteral("shipper"));
+    const auto writeCursor = [&](const QByteArray &text) {
+        auto file = QFile(cursorFileName);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(text);
+    };
+
+    QByteArray committed;
+    {
+        auto shipper = SegmentedLogConsumer(m_path, QStringLiteral("shipper"));
+        readMessages(shipper, 600);
+        QVERIFY(shipper.commit());
+
+        // Seeking ahead in the segment and back again
+        shipper.seek(700);
+        QCOMPARE(shipper.next()->message(), QStringLiteral("message 700"));
+        shipper.seek(5);
+        QCOMPARE(shipper.next()->message(), QStringLiteral("message 5"));
+    }
+
+    // The cursor stores where the record with the offset starts in its segment
+    {
+        auto file = QFile(cursorFileName);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        committed = file.readAll();
+    }
+    const auto fields = committed.split(' ');
+    QCOMPARE(fields.size(), 3);
+    QCOMPARE(fields.at(0), QByteArray("600"));
+    QCOMPARE(fields.at(1), QByteArray("0"));
+    QVERIFY(fields.at(2).toLongLong() > SegmentedLog::HeaderSize);
+
+    {
+        auto shipper = SegmentedLogConsumer(m_path, QStringLiteral("shipper"));
+        QCOMPARE(shipper.position(), qint64(600));
+        QCOMPARE(shipper.next()->message(), QStringLiteral("message 600"));
+    }
+
+    // Cursors with only the offset or with a position past the segment skip from its start
+    for (const auto &text : { QByteArray("600"), QByteArray("600 0 999999999") }) {
+        writeCursor(text);
+        auto shipper = SegmentedLogConsumer(m_path, QStringLiteral("shipper"));
+        QCOMPARE(shipper.next()->message(), QStringLiteral("message 600"));
+    }
+    QCOMPARE(SegmentedLog::committedOffsets(m_path), QList<qint64>({ 600 }));
+}
+
+void TestSegmentedLog::testRetentionBySlowestCursor()
+{
+    auto sink = SegmentedLogSink(m_path, 1024);
+
+    auto fast = SegmentedLogConsumer(m_path, QStringLiteral("fast"));
+    auto slow = SegmentedLogConsumer(m_path, QStringLiteral("slow"));
+
+    writeMessages(sink, 0, 200);
+
+    readMessages(fast);
+    QVERIFY(fast.commit());
+
+    // The slow consumer holds back the retention
+    writeMessages(sink, 200, 50);
+    QCOMPARE(SegmentedLog::segments(m_path).first(), qint64(0));
+
+    readMessages(slow, 100);
+    QVERIFY(slow.commit());
+    writeMessages(sink, 250, 50);
+
+    const auto bases = SegmentedLog::segments(m_path);
+    QVERIFY(bases.first() > 0);
+    QVERIFY(bases.first() <= 100);
+    QVERIFY(bases.size() > 1);
+
+    // Nothing the slow consumer hasn't read was removed
+    QCOMPARE(slow.next()->message(), QStringLiteral("message 100"));
+    QCOMPARE(slow.lostCount(), quint64(0));
+}
+
+void TestSegmentedLog::testMaxSize()
+{
+    auto sink = SegmentedLogSink(m_path, 1024, 4096);
+    QCOMPARE(sink.maxSize(), qint64(4096));
+
+    auto slow = SegmentedLogConsumer(m_path, QStringLiteral("slow"));
+
+    writeMessages(sink, 0, 500);
+
+    auto totalSize = qint64(0);
+    const auto bases = SegmentedLog::segments(m_path);
+    for (const auto base : bases) {
+        totalSize += QFileInfo(SegmentedLog::segmentFileName(m_path, base)).size();
+    }
+    QVERIFY(totalSize <= 4096 + 1024);
+
+    // The consumer continues with the oldest message left
+    const auto lmsg = slow.next();
+    QVERIFY(lmsg);
+    QCOMPARE(lmsg->message(), QStringLiteral("message %1").arg(bases.first()));
+    QCOMPARE(slow.lostCount(), static_cast<quint64>(bases.first()));
+}
+
+void TestSegmentedLog::testReopen()
+{
+    {
+        auto sink = SegmentedLogSink(m_path, 1024);
+        writeMessages(sink, 0, 30);
+    }
+
+    auto sink = SegmentedLogSink(m_path, 1024);
+    QCOMPARE(sink.nextOffset(), qint64(30));
+    writeMessages(sink, 30, 30);
+
+    auto consumer = SegmentedLogConsumer(m_path, QStringLiteral("reader"));
+    const auto messages = readMessages(consumer);
+    QCOMPARE(static_cast<int>(messages.size()), 60);
+    for (int i = 0; i < messages.size(); ++i) {
+        QCOMPARE(messages.at(i), QStringLiteral("message %1").arg(i));
+    }
+}
+
+void TestSegmentedLog::testIncompleteRecord()
+{
+    {
+        auto sink = SegmentedLogSink(m_path);
+        writeMessages(sink, 0, 10);
+    }
+
+    // A record cut short by a crash
+    auto file = QFile(SegmentedLog::segmentFileName(m_path, 0));
+    QVERIFY(file.open(QIODevice::Append));
+    file.write(QByteArray("\x40\x00\x00\x00partial", 11));
+    file.close();
+
+    auto consumer = SegmentedLogConsumer(m_path, QStringLiteral("reader"));
+    QCOMPARE(static_cast<int>(readMessages(consumer).size()), 10);
+
+    auto sink = SegmentedLogSink(m_path);
+    QCOMPARE(sink.nextOffset(), qint64(10));
+    writeMessages(sink, 10, 1);
+
+    QCOMPARE(consumer.next()->message(), QStringLiteral("message 10"));
+}
+
+void TestSegmentedLog::testWaitForReadyRead()
+{
+    auto sink = SegmentedLogSink(m_path);
+    auto consumer = SegmentedLogConsumer(m_path, QStringLiteral("reader"));
+
+    QVERIFY(!consumer.waitForReadyRead(50));
+
+    auto thread = std::thread([this, &sink]() {
+        QThread::msleep(100);
+        writeMessages(sink, 0, 1);
+    });
+
+    QVERIFY(consumer.waitForReadyRead(5000));
+    thread.join();
+
+    QCOMPARE(consumer.next()->message(), QStringLiteral("message 0"));
+}
+
+void TestSegmentedLog::testInvalidName()
+{
+    auto consumer = SegmentedLogConsumer(m_path, QStringLiteral("../shipper"));
+    QVERIFY(!consumer.isValid());
+    QVERIFY(!consumer.next());
+    QVERIFY(!consumer.commit());
+    QVERIFY(SegmentedLog::committedOffsets(m_path).isEmpty());
+}
+
+QTEST_MAIN(TestSegmentedLog)
+#include "test_segmentedlog.moc"
@@ -0,0 +1,308 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QCoreApplication>
+#include <QSharedMemory>
+
+#include <atomic>
+#include <thread>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/sharedmemoryring.h"
+#include "qtlogger/sinks/sharedmemorysink.h"
+
+using namespace QtLogger;
+
+class TestSharedMemorySink : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+
+    void testRoundTrip();
+    void testMultiSlotRecord();
+    void testOverruns();
+    void testDroppedRecord();
+    void testSkipToLatest();
+    void testWriterRestart();
+    void testSecondWriter();
+    void testDeadWriterTakeover();
+    void testReaderWithoutSegment();
+    void testConcurrentReader();
+
+private:
+    LogMessage createLogMessage(const QString &message, QtMsgType type = QtDebugMsg);
+
+    QString m_key;
+};
+
+void TestSharedMemorySink::init()
+{
+    static int counter = 0;
+    m_key = QStringLiteral("qtlogger-test-%1-%2")
+                    .arg(QCoreApplication::applicationPid())
+                    .arg(++counter);
+}
+
+LogMessage TestSharedMemorySink::createLogMessage(const QString &message, QtMsgType type)
+{
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", "test.category");
+    return LogMessage(type, context, message);
+}
+
+void TestSharedMemorySink::testRoundTrip()
+{
+    SharedMemorySink sink(m_key, 64, 256);
+    QVERIFY2(sink.isValid(), qPrintable(sink.errorString()));
+    QCOMPARE(sink.slotCount(), 64);
+    QCOMPARE(sink.slotSize(), 256);
+
+    SharedMemoryReader reader(m_key);
+    QVERIFY2(reader.isValid(), qPrintable(reader.errorString()));
+    QVERIFY(!reader.next());
+
+    auto lmsg = createLogMessage("Hello ring", QtWarningMsg);
+    lmsg.setAttribute("request", 17);
+    sink.send(lmsg);
+    sink.send(createLogMessage("Second"));
+
+    const auto first = reader.next();
+    QVERIFY(first);
+    QCOMPARE(first->message(), QString("Hello ring"));
+    QCOMPARE(first->type(), QtWarningMsg);
+    QCOMPARE(QString(first->category()), QString("test.category"));
+    QCOMPARE(QString(first->file()), QString("test.cpp"));
+    QCOMPARE(first->line(), 42);
+    QCOMPARE(first->time().toMSecsSinceEpoch(), lmsg.time().toMSecsSinceEpoch());
+    QCOMPARE(first->attribute("request").toLongLong(), 17LL);
+
+    const auto second = reader.next();
+    QVERIFY(second);
+    QCOMPARE(second->message(), QString("Second"));
+
+    QVERIFY(!reader.next());
+    QCOMPARE(reader.overruns(), quint64(0));
+}
+
+void TestSharedMemorySink::testMultiSlotRecord()
+{
+    SharedMemorySink sink(m_key, 64, 64);
+    QVERIFY(sink.isValid());
+
+    SharedMemoryReader reader(m_key);
+    QVERIFY(reader.isValid());
+
+    const auto message = QString(1000, QLatin1Char('x'));
+    sink.send(createLogMessage(message));
+    sink.send(createLogMessage("Short"));
+
+    const auto first = reader.next();
+    QVERIFY(first);
+    QCOMPARE(first->message(), message);
+
+    const auto second = reader.next();
+    QVERIFY(second);
+    QCOMPARE(second->message(), QString("Short"));
+}
+
+void TestSharedMemorySink::testOverruns()
+{
+    SharedMemorySink sink(m_key, 16, 256);
+    QVERIFY(sink.isValid());
+
+    SharedMemoryReader reader(m_key);
+    QVERIFY(reader.isValid());
+
+    sink.send(createLogMessage("Message 0"));
+    QCOMPARE(reader.next()->message(), QString("Message 0"));
+
+    // The writer doesn't wait for the reader and overwrites the oldest records
+    for (int i = 1; i <= 100; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1").arg(i)));
+
+    QStringList messages;
+    while (auto lmsg = reader.next())
+        messages.append(lmsg->message());
+
+    QVERIFY(!messages.isEmpty());
+    QVERIFY(messages.size() <= 16);
+    QCOMPARE(messages.last(), QString("Message 100"));
+    QCOMPARE(reader.overruns() + static_cast<quint64>(messages.size()), quint64(100));
+
+    const auto firstIndex = messages.first().mid(8).toInt();
+    for (int i = 0; i < messages.size(); ++i)
+        QCOMPARE(messages.at(i), QStringLiteral("Message %1").arg(firstIndex + i));
+}
+
+void TestSharedMemorySink::testDroppedRecord()
+{
+    SharedMemorySink sink(m_key, 4, 64);
+    QVERIFY(sink.isValid());
+
+    SharedMemoryReader reader(m_key);
+    QVERIFY(reader.isValid());
+
+    sink.send(createLogMessage(QString(1000, QLatin1Char('x'))));
+    sink.send(createLogMessage("Fits"));
+
+    QCOMPARE(sink.dropped(), quint64(1));
+    QCOMPARE(reader.dropped(), quint64(1));
+
+    const auto lmsg = reader.next();
+    QVERIFY(lmsg);
+    QCOMPARE(lmsg->message(), QString("Fits"));
+    QCOMPARE(reader.overruns(), quint64(0));
+}
+
+void TestSharedMemorySink::testSkipToLatest()
+{
+    SharedMemorySink sink(m_key, 64, 256);
+    QVERIFY(sink.isValid());
+
+    sink.send(createLogMessage("Old 1"));
+    sink.send(createLogMessage("Old 2"));
+
+    // A new reader starts with the oldest message in the ring
+    SharedMemoryReader reader(m_key);
+    QVERIFY(reader.isValid());
+    QCOMPARE(reader.next()->message(), QString("Old 1"));
+
+    reader.skipToLatest();
+    QVERIFY(!reader.next());
+
+    sink.send(createLogMessage("New"));
+    QCOMPARE(reader.next()->message(), QString("New"));
+}
+
+void TestSharedMemorySink::testWriterRestart()
+{
+    auto sink = QSharedPointer<SharedMemorySink>::create(m_key, 64, 256);
+    QVERIFY(sink->isValid());
+
+    SharedMemoryReader reader(m_key);
+    QVERIFY(reader.isValid());
+
+    sink->send(createLogMessage("Before restart"));
+    QCOMPARE(reader.next()->message(), QString("Before restart"));
+
+    // The segment is kept alive by the reader and continued by the new writer
+    sink.reset();
+    sink = QSharedPointer<SharedMemorySink>::create(m_key, 64, 256);
+    QVERIFY(sink->isValid());
+
+    sink->send(createLogMessage("After restart"));
+
+    const auto lmsg = reader.next();
+    QVERIFY(lmsg);
+    QCOMPARE(lmsg->message(), QString("After restart"));
+    QCOMPARE(reader.overruns(), quint64(0));
+}
+
+void TestSharedMemorySink::testSecondWriter()
+{
+    auto sink = QSharedPointer<SharedMemorySink>::create(m_key, 64, 256);
+    QVERIFY(sink->isValid());
+
+    SharedMemoryReader reader(m_key);
+    QVERIFY(reader.isValid());
+
+    // The ring has a live writer, a second one would interleave its records
+    SharedMemorySink second(m_key, 64, 256);
+    QVERIFY(!second.isValid());
+    QVERIFY(!second.errorString().isEmpty());
+    second.send(createLogMessage("Ignored"));
+
+    sink->send(createLogMessage("First"));
+    QCOMPARE(reader.next()->message(), QString("First"));
+    QVERIFY(!reader.next());
+
+    // Released by the destroyed writer
+    sink.reset();
+    SharedMemorySink third(m_key, 64, 256);
+    QVERIFY2(third.isValid(), qPrintable(third.errorString()));
+}
+
+void TestSharedMemorySink::testDeadWriterTakeover()
+{
+    auto first = QSharedPointer<SharedMemorySink>::create(m_key, 64, 256);
+    QVERIFY(first->isValid());
+
+    SharedMemoryReader reader(m_key);
+    QVERIFY(reader.isValid());
+
+    first->send(createLogMessage("Before crash"));
+    QCOMPARE(reader.next()->message(), QString("Before crash"));
+    first.reset();
+
+    // A writer token left by an earlier process with the same id, as after a crash
+    QSharedMemory memory(m_key);
+    QVERIFY(memory.attach());
+    auto *header = static_cast<SharedMemoryRing::Header *>(memory.data());
+    header->writer.store(static_cast<quint64>(QCoreApplication::applicationPid()) << 32
+                         | 0xffffffff);
+
+    SharedMemorySink sink(m_key, 64, 256);
+    QVERIFY2(sink.isValid(), qPrintable(sink.errorString()));
+    sink.send(createLogMessage("After crash"));
+    QCOMPARE(reader.next()->message(), QString("After crash"));
+}
+
+void TestSharedMemorySink::testReaderWithoutSegment()
+{
+    SharedMemoryReader reader(m_key);
+    QVERIFY(!reader.isValid());
+    QVERIFY(!reader.errorString().isEmpty());
+    QVERIFY(!reader.next());
+}
+
+void TestSharedMemorySink::testConcurrentReader()
+{
+    constexpr int MessageCount = 20000;
+
+    SharedMemorySink sink(m_key, 256, 256);
+    QVERIFY(sink.isValid());
+
+    SharedMemoryReader reader(m_key);
+    QVERIFY(reader.isValid());
+
+    std::atomic<bool> done { false };
+
+    std::thread writer([&] {
+        for (int i = 0; i < MessageCount; ++i)
+            sink.send(createLogMessage(QString::number(i)));
+        done = true;
+    });
+
+    int received = 0;
+    int last = -1;
+    bool ordered = true;
+
+    while (true) {
+        const bool finished = done;
+        auto lmsg = reader.next();
+        if (!lmsg) {
+            if (finished)
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        const auto index = lmsg->message().toInt();
+        ordered = ordered && index > last;
+        last = index;
+        ++received;
+    }
+
+    writer.join();
+
+    // Every message is either received intact or counted as lost, never both
+    QVERIFY(ordered);
+    QCOMPARE(last, MessageCount - 1);
+    QCOMPARE(static_cast<quint64>(received) + reader.overruns(),
+             static_cast<quint64>(MessageCount));
+}
+
+QTEST_MAIN(TestSharedMemorySink)
+#include "test_sharedmemorysink.moc"
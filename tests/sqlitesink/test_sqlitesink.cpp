@@ -0,0 +1,271 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+
+#include <thread>
+#include <vector>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/sinks/sqlitesink.h"
+
+using namespace QtLogger;
+
+class TestSqliteSink : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void testColumns();
+    void testDatabaseMode();
+    void testBatchSize();
+    void testBatchInterval();
+    void testMaxRowCount();
+    void testMaxAge();
+    void testReopen();
+    void testSendingThreads();
+
+private:
+    LogMessage createLogMessage(const QString &message, QtMsgType type = QtDebugMsg);
+    QString dbPath() const { return m_tempDir->filePath("logs.db"); }
+    QSqlDatabase reader();
+    qlonglong queryValue(const QString &sql);
+
+    QScopedPointer<QTemporaryDir> m_tempDir;
+};
+
+void TestSqliteSink::initTestCase()
+{
+    if (!QSqlDatabase::isDriverAvailable("QSQLITE"))
+        QSKIP("QSQLITE driver is not available");
+}
+
+void TestSqliteSink::init()
+{
+    m_tempDir.reset(new QTemporaryDir());
+    QVERIFY(m_tempDir->isValid());
+}
+
+void TestSqliteSink::cleanup()
+{
+    if (QSqlDatabase::contains("reader")) {
+        QSqlDatabase::database("reader").close();
+        QSqlDatabase::removeDatabase("reader");
+    }
+    m_tempDir.reset();
+}
+
+LogMessage TestSqliteSink::createLogMessage(const QString &message, QtMsgType type)
+{
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", "test.category");
+    return LogMessage(type, context, message);
+}
+
+// A separate connection sees the committed rows only
+QSqlDatabase TestSqliteSink::reader()
+{
+    if (QSqlDatabase::contains("reader"))
+        return QSqlDatabase::database("reader");
+
+    auto db = QSqlDatabase::addDatabase("QSQLITE", "reader");
+    db.setDatabaseName(dbPath());
+    db.open();
+    return db;
+}
+
+qlonglong TestSqliteSink::queryValue(const QString &sql)
+{
+    QSqlQuery query(reader());
+    if (!query.exec(sql) || !query.next())
+        return -1;
+    return query.value(0).toLongLong();
+}
+
+void TestSqliteSink::testColumns()
+{
+    const auto time = QDateTime::fromMSecsSinceEpoch(1700000000123LL);
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", "test.category");
+    LogMessage lmsg(QtWarningMsg, context, "Disk is almost full", time);
+    lmsg.setAttribute("free", 42);
+    lmsg.setAttribute("mount", "/data");
+    lmsg.setFormattedMessage("Formatted messages are not stored");
+
+    {
+        SqliteSink sink(dbPath());
+        QCOMPARE(sink.fileName(), dbPath());
+        QVERIFY(!sink.isOpen());
+
+        sink.send(lmsg);
+        sink.send(LogMessage(QtInfoMsg, QMessageLogContext(), "No context"));
+        QVERIFY(sink.isOpen());
+        QVERIFY(sink.flush());
+    }
+
+    QSqlQuery query(reader());
+    QVERIFY(query.exec("SELECT time, level, category, file, line, function, thread, message, "
+                       "attributes FROM logs ORDER BY id"));
+
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toLongLong(), 1700000000123LL);
+    QCOMPARE(query.value(1).toString(), QString("warning"));
+    QCOMPARE(query.value(2).toString(), QString("test.category"));
+    QCOMPARE(query.value(3).toString(), QString("test.cpp"));
+    QCOMPARE(query.value(4).toInt(), 42);
+    QCOMPARE(query.value(5).toString(), QString("void testFunction()"));
+    QCOMPARE(query.value(6).toULongLong(), static_cast<qulonglong>(lmsg.threadId()));
+    QCOMPARE(query.value(7).toString(), QString("Disk is almost full"));
+
+    const auto attrs = QJsonDocument::fromJson(query.value(8).toString().toUtf8()).object();
+    QCOMPARE(attrs.value("free").toInt(), 42);
+    QCOMPARE(attrs.value("mount").toString(), QString("/data"));
+
+    QVERIFY(query.next());
+    QCOMPARE(query.value(1).toString(), QString("info"));
+    QVERIFY(query.value(2).isNull());
+    QVERIFY(query.value(3).isNull());
+    QVERIFY(query.value(4).isNull());
+    QVERIFY(query.value(8).isNull());
+
+    QVERIFY(!query.next());
+}
+
+void TestSqliteSink::testDatabaseMode()
+{
+    SqliteSink sink(dbPath());
+    sink.send(createLogMessage("Message"));
+    sink.flush();
+
+    QSqlQuery query(reader());
+    QVERIFY(query.exec("PRAGMA journal_mode"));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toString(), QString("wal"));
+
+    // 2 is incremental auto-vacuum
+    QCOMPARE(queryValue("PRAGMA auto_vacuum"), 2LL);
+    QCOMPARE(queryValue("SELECT COUNT(*) FROM sqlite_master WHERE type = 'index' "
+                        "AND tbl_name = 'logs'"),
+             3LL);
+}
+
+void TestSqliteSink::testBatchSize()
+{
+    SqliteSink sink(dbPath());
+    sink.setBatchSize(10);
+    sink.setBatchInterval(60000);
+    QCOMPARE(sink.batchSize(), 10);
+    QCOMPARE(sink.batchInterval(), 60000);
+
+    for (int i = 0; i < 25; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1").arg(i)));
+
+    QCOMPARE(queryValue("SELECT COUNT(*) FROM logs"), 20LL);
+
+    QVERIFY(sink.flush());
+    QCOMPARE(queryValue("SELECT COUNT(*) FROM logs"), 25LL);
+}
+
+void TestSqliteSink::testBatchInterval()
+{
+    SqliteSink sink(dbPath());
+    sink.setBatchInterval(50);
+
+    sink.send(createLogMessage("One"));
+    sink.send(createLogMessage("Two"));
+    QCOMPARE(queryValue("SELECT COUNT(*) FROM logs"), 0LL);
+
+    // An incomplete batch is committed by the timer
+    QTRY_COMPARE(queryValue("SELECT COUNT(*) FROM logs"), 2LL);
+
+    // also for rows sent from a thread without an event loop
+    auto thread = std::thread([this, &sink]() {
+        sink.send(createLogMessage("Three"));
+        sink.send(createLogMessage("Four"));
+    });
+    thread.join();
+
+    QTRY_COMPARE(queryValue("SELECT COUNT(*) FROM logs"), 4LL);
+}
+
+void TestSqliteSink::testMaxRowCount()
+{
+    SqliteSink sink(dbPath());
+    sink.setBatchSize(5);
+    sink.setMaxRowCount(10);
+    QCOMPARE(sink.maxRowCount(), 10LL);
+
+    for (int i = 0; i < 30; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1").arg(i)));
+
+    QCOMPARE(queryValue("SELECT COUNT(*) FROM logs"), 10LL);
+
+    QSqlQuery query(reader());
+    QVERIFY(query.exec("SELECT message FROM logs ORDER BY id LIMIT 1"));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toString(), QString("Message 20"));
+}
+
+void TestSqliteSink::testMaxAge()
+{
+    SqliteSink sink(dbPath());
+    sink.setMaxAge(60);
+    QCOMPARE(sink.maxAge(), 60);
+
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", "test.category");
+    const auto old = QDateTime::currentDateTime().addSecs(-120);
+    sink.send(LogMessage(QtDebugMsg, context, "Old 1", old));
+    sink.send(LogMessage(QtDebugMsg, context, "Old 2", old));
+    sink.send(createLogMessage("New 1"));
+    sink.send(createLogMessage("New 2"));
+    sink.flush();
+
+    QCOMPARE(queryValue("SELECT COUNT(*) FROM logs"), 2LL);
+    QCOMPARE(queryValue("SELECT COUNT(*) FROM logs WHERE message LIKE 'New%'"), 2LL);
+}
+
+void TestSqliteSink::testReopen()
+{
+    {
+        SqliteSink sink(dbPath());
+        sink.send(createLogMessage("First"));
+    }
+    {
+        SqliteSink sink(dbPath());
+        sink.send(createLogMessage("Second"));
+    }
+
+    // Pending rows are committed when the sink is destroyed
+    QCOMPARE(queryValue("SELECT COUNT(*) FROM logs"), 2LL);
+}
+
+void TestSqliteSink::testSendingThreads()
+{
+    SqliteSink sink(dbPath());
+    sink.setBatchSize(100);
+
+    // Like a synchronous logger called from several threads
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([this, &sink, t]() {
+            for (int i = 0; i < 250; ++i)
+                sink.send(createLogMessage(QStringLiteral("Thread %1 message %2").arg(t).arg(i)));
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    QVERIFY(sink.flush());
+    QCOMPARE(queryValue("SELECT COUNT(*) FROM logs"), 1000LL);
+    QCOMPARE(queryValue("SELECT COUNT(DISTINCT message) FROM logs"), 1000LL);
+}
+
+QTEST_MAIN(TestSqliteSink)
+#include "test_sqlitesink.moc"
@@ -0,0 +1,260 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtEndian>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/sinks/tcpsink.h"
+
+using namespace QtLogger;
+
+class TestTcpSink : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testFrame();
+    void testNewlineFraming();
+    void testLengthPrefixedFraming();
+    void testBufferUntilConnected();
+    void testDropOldest();
+    void testDropNewest();
+    void testReconnect();
+
+private:
+    LogMessage createLogMessage(const QString &message, QtMsgType type = QtDebugMsg);
+    QList<QByteArray> readLines() const;
+    QList<QByteArray> readFrames() const;
+
+    QTcpServer *m_server = nullptr;
+    QList<QTcpSocket *> m_connections;
+    QByteArray m_received;
+};
+
+void TestTcpSink::init()
+{
+    m_received.clear();
+    m_connections.clear();
+
+    m_server = new QTcpServer();
+    QVERIFY(m_server->listen(QHostAddress::LocalHost));
+
+    connect(m_server, &QTcpServer::newConnection, this, [this] {
+        while (auto *connection = m_server->nextPendingConnection()) {
+            m_connections.append(connection);
+            connect(connection, &QIODevice::readyRead, this,
+                    [this, connection] { m_received.append(connection->readAll()); });
+        }
+    });
+}
+
+void TestTcpSink::cleanup()
+{
+    delete m_server;
+    m_server = nullptr;
+    m_connections.clear();
+}
+
+LogMessage TestTcpSink::createLogMessage(const QString &message, QtMsgType type)
+{
+    QMessageLogContext context("test.cpp", 42, "void testFunction()", "test.category");
+    return LogMessage(type, context, message);
+}
+
+QList<QByteArray> TestTcpSink::readLines() const
+{
+    auto lines = m_received.split('\n');
+    if (!lines.isEmpty() && lines.last().isEmpty())
+        lines.removeLast();
+    return lines;
+}
+
+QList<QByteArray> TestTcpSink::readFrames() const
+{
+    QList<QByteArray> frames;
+    int pos = 0;
+    while (pos + 4 <= m_received.size()) {
+        const auto size = qFromBigEndian<quint32>(m_received.constData() + pos);
+        if (pos + 4 + static_cast<int>(size) > m_received.size())
+            break;
+        frames.append(m_received.mid(pos + 4, static_cast<int>(size)));
+        pos += 4 + static_cast<int>(size);
+    }
+    return frames;
+}
+
+void TestTcpSink::testFrame()
+{
+    auto lmsg = createLogMessage("Hello");
+    QCOMPARE(IODeviceSink::frame(lmsg, TcpSink::Framing::Newline, true), QByteArray("Hello\n"));
+    QCOMPARE(IODeviceSink::frame(lmsg, TcpSink::Framing::LengthPrefixed, true),
+             QByteArray("\x00\x00\x00\x05Hello", 9));
+
+    lmsg.setFormattedMessage(QString::fromUtf8("Привет"));
+    QCOMPARE(IODeviceSink::frame(lmsg, TcpSink::Framing::Newline, true),
+             QString::fromUtf8("Привет\n").toLocal8Bit());
+    QCOMPARE(IODeviceSink::frame(lmsg, TcpSink::Framing::Newline, true, true),
+             QString::fromUtf8("Привет\n").toUtf8());
+    QCOMPARE(IODeviceSink::frame(lmsg, TcpSink::Framing::LengthPrefixed, true),
+             QByteArray("\x00\x00\x00\x0c", 4) + QString::fromUtf8("Привет").toUtf8());
+
+    // Terminal colors are only kept without plain text
+    lmsg.setFormattedMessage(QStringLiteral("\x1b[31mRed\x1b[0m"), QStringLiteral("Red"));
+    QCOMPARE(IODeviceSink::frame(lmsg, TcpSink::Framing::Newline, true), QByteArray("Red\n"));
+    QCOMPARE(IODeviceSink::frame(lmsg, TcpSink::Framing::Newline, false),
+             QByteArray("\x1b[31mRed\x1b[0m\n"));
+
+    // Binary formatter output is not terminated
+    lmsg.setFormattedData(QByteArray("\x01\x02", 2));
+    QCOMPARE(IODeviceSink::frame(lmsg, TcpSink::Framing::Newline, true),
+             QByteArray("\x01\x02", 2));
+    QCOMPARE(IODeviceSink::frame(lmsg, TcpSink::Framing::LengthPrefixed, true),
+             QByteArray("\x00\x00\x00\x02\x01\x02", 6));
+}
+
+void TestTcpSink::testNewlineFraming()
+{
+    TcpSink sink(QStringLiteral("127.0.0.1"), m_server->serverPort());
+    QCOMPARE(sink.host(), QString("127.0.0.1"));
+    QCOMPARE(sink.port(), m_server->serverPort());
+    QCOMPARE(sink.framing(), TcpSink::Framing::Newline);
+
+    for (int i = 0; i < 100; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1").arg(i)));
+
+    QTRY_COMPARE(readLines().size(), 100);
+    QVERIFY(sink.isConnected());
+    QCOMPARE(m_connections.size(), 1);
+
+    const auto lines = readLines();
+    for (int i = 0; i < lines.size(); ++i)
+        QCOMPARE(lines.at(i), QStringLiteral("Message %1").arg(i).toUtf8());
+
+    // In UTF-8 whatever the locale of the process
+    sink.send(createLogMessage(QString::fromUtf8("Привет")));
+    QTRY_COMPARE(readLines().size(), 101);
+    QCOMPARE(readLines().last(), QString::fromUtf8("Привет").toUtf8());
+}
+
+void TestTcpSink::testLengthPrefixedFraming()
+{
+    TcpSink sink(QStringLiteral("127.0.0.1"), m_server->serverPort(),
+                 TcpSink::Framing::LengthPrefixed);
+
+    sink.send(createLogMessage("Line 1\nLine 2"));
+    sink.send(createLogMessage(""));
+    sink.send(createLogMessage("Last"));
+
+    QTRY_COMPARE(readFrames().size(), 3);
+
+    const auto frames = readFrames();
+    QCOMPARE(frames.at(0), QByteArray("Line 1\nLine 2"));
+    QCOMPARE(frames.at(1), QByteArray());
+    QCOMPARE(frames.at(2), QByteArray("Last"));
+}
+
+void TestTcpSink::testBufferUntilConnected()
+{
+    const auto port = m_server->serverPort();
+    m_server->close();
+
+    TcpSink sink(QStringLiteral("127.0.0.1"), port);
+    sink.setReconnectDelay(10, 50);
+    QCOMPARE(sink.minReconnectDelay(), 10);
+    QCOMPARE(sink.maxReconnectDelay(), 50);
+
+    sink.send(createLogMessage("Before listen 1"));
+    sink.send(createLogMessage("Before listen 2"));
+    QTest::qWait(100);
+    QVERIFY(!sink.isConnected());
+
+    QVERIFY(m_server->listen(QHostAddress::LocalHost, port));
+
+    QTRY_COMPARE(readLines().size(), 2);
+    sink.send(createLogMessage("After listen"));
+    QTRY_COMPARE(readLines().size(), 3);
+
+    const auto lines = readLines();
+    QCOMPARE(lines.at(0), QByteArray("Before listen 1"));
+    QCOMPARE(lines.at(1), QByteArray("Before listen 2"));
+    QCOMPARE(lines.at(2), QByteArray("After listen"));
+    QCOMPARE(sink.droppedCount(), quint64(0));
+}
+
+void TestTcpSink::testDropOldest()
+{
+    const auto port = m_server->serverPort();
+    m_server->close();
+
+    TcpSink sink(QStringLiteral("127.0.0.1"), port);
+    sink.setReconnectDelay(10, 50);
+    sink.setMaxBufferSize(20);
+    QCOMPARE(sink.maxBufferSize(), 20);
+    QCOMPARE(sink.dropPolicy(), TcpSink::DropPolicy::DropOldest);
+
+    // Every frame takes 10 bytes
+    for (int i = 0; i < 5; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1").arg(i)));
+    QCOMPARE(sink.droppedCount(), quint64(3));
+
+    QVERIFY(m_server->listen(QHostAddress::LocalHost, port));
+
+    QTRY_COMPARE(readLines().size(), 2);
+    QCOMPARE(readLines().at(0), QByteArray("Message 3"));
+    QCOMPARE(readLines().at(1), QByteArray("Message 4"));
+}
+
+void TestTcpSink::testDropNewest()
+{
+    const auto port = m_server->serverPort();
+    m_server->close();
+
+    TcpSink sink(QStringLiteral("127.0.0.1"), port);
+    sink.setReconnectDelay(10, 50);
+    sink.setMaxBufferSize(20);
+    sink.setDropPolicy(TcpSink::DropPolicy::DropNewest);
+    QCOMPARE(sink.dropPolicy(), TcpSink::DropPolicy::DropNewest);
+
+    for (int i = 0; i < 5; ++i)
+        sink.send(createLogMessage(QStringLiteral("Message %1").arg(i)));
+    QCOMPARE(sink.droppedCount(), quint64(3));
+
+    // A frame larger than the whole buffer is never queued
+    sink.send(createLogMessage(QString(32, QLatin1Char('x'))));
+    QCOMPARE(sink.droppedCount(), quint64(4));
+
+    QVERIFY(m_server->listen(QHostAddress::LocalHost, port));
+
+    QTRY_COMPARE(readLines().size(), 2);
+    QCOMPARE(readLines().at(0), QByteArray("Message 0"));
+    QCOMPARE(readLines().at(1), QByteArray("Message 1"));
+}
+
+void TestTcpSink::testReconnect()
+{
+    TcpSink sink(QStringLiteral("127.0.0.1"), m_server->serverPort());
+    sink.setReconnectDelay(10, 50);
+
+    sink.send(createLogMessage("First connection"));
+    QTRY_COMPARE(readLines().size(), 1);
+    QCOMPARE(m_connections.size(), 1);
+
+    // The server drops the connection, the sink connects again on its own
+    m_connections.first()->disconnectFromHost();
+    QTRY_VERIFY(!sink.isConnected());
+    QTRY_COMPARE(m_connections.size(), 2);
+    QTRY_VERIFY(sink.isConnected());
+
+    sink.send(createLogMessage("Second connection"));
+    QTRY_COMPARE(readLines().size(), 2);
+    QCOMPARE(readLines().at(1), QByteArray("Second connection"));
+}
+
+QTEST_MAIN(TestTcpSink)
+#include "test_tcpsink.moc"
@@ -0,0 +1,372 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/logsearch.h"
+#include "qtlogger/sinks/binaryfilesink.h"
+#include "qtlogger/sinks/rotatingfilesink.h"
+#include "qtlogger/termindex.h"
+
+using namespace QtLogger;
+
+class TestTermIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testTokenize();
+    void testWriteAndRead();
+    void testBloomFilter();
+    void testAttributes();
+    void testMissingFile();
+    void testRangeLimit();
+
+    // RotatingFileSink::TermIndex
+    void testRotatedFiles();
+    void testAppendedFileNotIndexed();
+    void testSearchTerms();
+    void testSearchAttributeTerms();
+    void testSearchWithAndWithoutIndex();
+
+private:
+    LogMessage createLogMessage(const QString &message, const QDateTime &time);
+    void writeRequests(const QString &logPath, int messages);
+
+    QTemporaryDir *m_tempDir = nullptr;
+    QDateTime m_baseTime;
+};
+
+void TestTermIndex::init()
+{
+    m_tempDir = new QTemporaryDir();
+    QVERIFY(m_tempDir->isValid());
+    m_baseTime = QDateTime::currentDateTime().addSecs(-3600);
+}
+
+void TestTermIndex::cleanup()
+{
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+LogMessage TestTermIndex::createLogMessage(const QString &message, const QDateTime &time)
+{
+    QMessageLogContext context("test.cpp", 42, "testFunction", "test.category");
+    auto lmsg = LogMessage(QtDebugMsg, context, message, time);
+    lmsg.setFormattedMessage(message);
+    return lmsg;
+}
+
+// Ten messages per request id
+void TestTermIndex::writeRequests(const QString &logPath, int messages)
+{
+    auto sink = RotatingFileSink(logPath, 400, 0, RotatingFileSink::TermIndex);
+    sink.setTimeIndexInterval(40, 3600 * 1000);
+
+    for (int i = 0; i < messages; ++i) {
+        const auto message = QStringLiteral("request req-%1 step %2").arg(i / 10).arg(i % 10);
+        sink.send(createLogMessage(message, m_baseTime.addSecs(i)));
+    }
+}
+
+void TestTermIndex::testTokenize()
+{
+    const auto text = QStringLiteral("Request a1b2-c3 done. user_id=42, -x- app.network");
+    QCOMPARE(TermIndex::tokenize(text),
+             QStringList({ "request", "a1b2-c3", "done", "user_id", "42", "x", "app.network" }));
+    QVERIFY(TermIndex::tokenize(QStringLiteral(" ... -- !")).isEmpty());
+    QCOMPARE(TermIndex::normalizeTerm(QStringLiteral(" ABC ")), QStringLiteral("abc"));
+    QCOMPARE(static_cast<int>(TermIndex::normalizeTerm(QString(500, QLatin1Char('a'))).size()),
+             TermIndex::MaxTermLength);
+}
+
+void TestTermIndex::testWriteAndRead()
+{
+    const auto path = m_tempDir->filePath("app.log.tix");
+
+    auto writer = TermIndexWriter();
+    writer.add(createLogMessage(QStringLiteral("connected to host"), m_baseTime), 0);
+    writer.add(createLogMessage(QStringLiteral("Connected again"), m_baseTime), 0);
+    writer.add(createLogMessage(QStringLiteral("sending data to host"), m_baseTime), 100);
+    writer.add(createLogMessage(QStringLiteral("disconnected"), m_baseTime), 250);
+    QVERIFY(writer.write(path));
+
+    auto reader = TermIndexReader(path);
+    QVERIFY(reader.isValid());
+
+    QCOMPARE(reader.ranges(QStringLiteral("connected")), QList<qint64>({ 0 }));
+    QCOMPARE(reader.ranges(QStringLiteral("HOST")), QList<qint64>({ 0, 100 }));
+    QCOMPARE(reader.ranges(QStringLiteral("disconnected")), QList<qint64>({ 250 }));
+    QVERIFY(reader.ranges(QStringLiteral("missing")).isEmpty());
+
+    // The terms are collected again after a reset
+    writer.reset();
+    writer.add(createLogMessage(QStringLiteral("other"), m_baseTime), 0);
+    QVERIFY(writer.write(path));
+
+    auto newReader = TermIndexReader(path);
+    QVERIFY(newReader.ranges(QStringLiteral("host")).isEmpty());
+    QCOMPARE(newReader.ranges(QStringLiteral("other")), QList<qint64>({ 0 }));
+}
+
+void TestTermIndex::testBloomFilter()
+{
+    const auto path = m_tempDir->filePath("bloom.log.tix");
+
+    auto writer = TermIndexWriter();
+    for (int i = 0; i < 1000; ++i) {
+        writer.add(createLogMessage(QStringLiteral("term%1").arg(i), m_baseTime), i);
+    }
+    QVERIFY(writer.write(path));
+
+    auto reader = TermIndexReader(path);
+    QVERIFY(reader.isValid());
+
+    for (int i = 0; i < 1000; ++i) {
+        QVERIFY(reader.mayContain(QStringLiteral("term%1").arg(i)));
+    }
+
+    // About 1% false positives with 10 bits per term
+    auto falsePositives = 0;
+    for (int i = 0; i < 1000; ++i) {
+        if (reader.mayContain(QStringLiteral("absent%1").arg(i)))
+            ++falsePositives;
+    }
+    QVERIFY(falsePositives < 50);
+}
+
+void TestTermIndex::testAttributes()
+{
+    const auto path = m_tempDir->filePath("attrs.log.tix");
+
+    auto writer = TermIndexWriter();
+
+    auto lmsg = createLogMessage(QStringLiteral("handled"), m_baseTime);
+    lmsg.setAttribute(QStringLiteral("request_id"), QStringLiteral("ABC-123"));
+    lmsg.setAttribute(QStringLiteral("user"), QStringLiteral("John Smith"));
+    writer.add(lmsg, 64);
+
+    // Text is indexed as written, without attributes
+    writer.addText(QStringLiteral("[app.net] Connected to host-1"), 128);
+    QVERIFY(writer.write(path));
+
+    auto reader = TermIndexReader(path);
+    QCOMPARE(reader.ranges(QStringLiteral("handled")), QList<qint64>({ 64 }));
+    QCOMPARE(reader.ranges(QStringLiteral("abc-123")), QList<qint64>({ 64 }));
+    QCOMPARE(reader.ranges(QStringLiteral("John Smith")), QList<qint64>({ 64 }));
+    QCOMPARE(reader.ranges(QStringLiteral("smith")), QList<qint64>({ 64 }));
+    QCOMPARE(reader.ranges(QStringLiteral("app.net")), QList<qint64>({ 128 }));
+    QCOMPARE(reader.ranges(QStringLiteral("host-1")), QList<qint64>({ 128 }));
+}
+
+void TestTermIndex::testMissingFile()
+{
+    auto reader = TermIndexReader(m_tempDir->filePath("missing.tix"));
+    QVERIFY(!reader.isValid());
+    QVERIFY(reader.mayContain(QStringLiteral("anything")));
+    QVERIFY(reader.ranges(QStringLiteral("anything")).isEmpty());
+}
+
+void TestTermIndex::testRangeLimit()
+{
+    const auto path = m_tempDir->filePath("ids.log.tix");
+
+    auto writer = TermIndexWriter();
+    QCOMPARE(writer.maxRangeCount(), TermIndexWriter::DefaultMaxRangeCount);
+    writer.setMaxRangeCount(1000);
+
+    // Repeated terms in the same range are kept once
+    for (int i = 0; i < 100; ++i) {
+        writer.add(createLogMessage(QStringLiteral("request started"), m_baseTime), 0);
+    }
+    QCOMPARE(writer.rangeCount(), 2);
+
+    // Every message has a new id and number
+    for (int i = 0; i < 10000; ++i) {
+        writer.add(createLogMessage(QStringLiteral("request id-%1 took %2").arg(i).arg(i * 7),
+                                    m_baseTime),
+                   i / 10 * 40);
+        QVERIFY(writer.rangeCount() <= 1000);
+    }
+
+    QVERIFY(!writer.isComplete());
+    QCOMPARE(writer.rangeCount(), 0);
+    QVERIFY(!writer.write(path));
+    QVERIFY(!QFile::exists(path));
+
+    writer.reset();
+    QVERIFY(writer.isComplete());
+    writer.add(createLogMessage(QStringLiteral("request id-1"), m_baseTime), 0);
+    QCOMPARE(writer.rangeCount(), 2);
+    QVERIFY(writer.write(path));
+    QCOMPARE(TermIndexReader(path).ranges(QStringLiteral("id-1")), QList<qint64>({ 0 }));
+}
+
+void TestTermIndex::testRotatedFiles()
+{
+    const auto logPath = m_tempDir->filePath("app.log");
+    writeRequests(logPath, 200);
+
+    auto dir = QDir(m_tempDir->path());
+    const auto rotated = dir.entryList({ QStringLiteral("app.*.log") }, QDir::Files);
+    QVERIFY(rotated.size() > 3);
+    QCOMPARE(dir.entryList({ QStringLiteral("app.*.log.tix") }, QDir::Files).size(),
+             rotated.size());
+    QVERIFY(!QFile::exists(TermIndex::indexFileName(logPath)));
+
+    // Only the files with messages of the request have it in their index
+    auto filesWithTerm = 0;
+    for (const auto &fileName : rotated) {
+        auto file = QFile(dir.filePath(fileName));
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        const auto hasTerm = file.readAll().contains("req-7 ");
+
+        auto reader = TermIndexReader(TermIndex::indexFileName(dir.filePath(fileName)));
+        QVERIFY(reader.isValid());
+        QCOMPARE(!reader.ranges(QStringLiteral("req-7")).isEmpty(), hasTerm);
+
+        if (hasTerm)
+            ++filesWithTerm;
+    }
+    QVERIFY(filesWithTerm > 0);
+}
+
+void TestTermIndex::testAppendedFileNotIndexed()
+{
+    const auto logPath = m_tempDir->filePath("append.log");
+
+    {
+        auto sink = RotatingFileSink(logPath, 400, 0, RotatingFileSink::TermIndex);
+        sink.send(createLogMessage(QStringLiteral("first session"), m_baseTime));
+    }
+
+    {
+        auto sink = RotatingFileSink(logPath, 400, 0, RotatingFileSink::TermIndex);
+        for (int i = 0; i < 60; ++i) {
+            sink.send(createLogMessage(QStringLiteral("second session %1").arg(i),
+                                       m_baseTime.addSecs(i)));
+        }
+    }
+
+    auto dir = QDir(m_tempDir->path());
+    const auto rotated = dir.entryList({ QStringLiteral("append.*.log") }, QDir::Files, QDir::Name);
+    QVERIFY(rotated.size() >= 2);
+
+    // The first file was started by the other sink, its terms are unknown
+    QVERIFY(!QFile::exists(TermIndex::indexFileName(dir.filePath(rotated.first()))));
+    QVERIFY(QFile::exists(TermIndex::indexFileName(dir.filePath(rotated.at(1)))));
+}
+
+void TestTermIndex::testSearchTerms()
+{
+    const auto logPath = m_tempDir->filePath("search.log");
+    writeRequests(logPath, 200);
+
+    auto search = LogSearch(logPath);
+
+    LogSearch::Query query;
+    query.terms = QStringList { QStringLiteral("REQ-7") };
+
+    auto matches = search.search(query);
+    QCOMPARE(static_cast<int>(matches.size()), 10);
+    for (int i = 0; i < matches.size(); ++i) {
+        QCOMPARE(matches.at(i).line, QStringLiteral("request req-7 step %1").arg(i));
+    }
+
+    query.terms.append(QStringLiteral("3"));
+    matches = search.search(query);
+    QCOMPARE(static_cast<int>(matches.size()), 1);
+    QCOMPARE(matches.first().line, QStringLiteral("request req-7 step 3"));
+
+    query.terms = QStringList { QStringLiteral("req-999") };
+    QVERIFY(search.search(query).isEmpty());
+
+    // Terms are whole words
+    query.terms = QStringList { QStringLiteral("req") };
+    QVERIFY(search.search(query).isEmpty());
+}
+
+void TestTermIndex::testSearchAttributeTerms()
+{
+    const auto logPath = m_tempDir->filePath("app.qtlb");
+
+    {
+        auto sink = BinaryFileSink(logPath, 600, 0, RotatingFileSink::TermIndex);
+
+        for (int i = 0; i < 100; ++i) {
+            auto lmsg = createLogMessage(QStringLiteral("handled"), m_baseTime.addSecs(i));
+            lmsg.setAttribute(QStringLiteral("request_id"), QStringLiteral("id-%1").arg(i / 5));
+            sink.send(lmsg);
+        }
+    }
+
+    QVERIFY(!QDir(m_tempDir->path())
+                     .entryList({ QStringLiteral("app.*.qtlb.tix") }, QDir::Files)
+                     .isEmpty());
+
+    LogSearch::Query query;
+    query.terms = QStringList { QStringLiteral("id-3") };
+
+    const auto matches = LogSearch(logPath).search(query);
+    QCOMPARE(static_cast<int>(matches.size()), 5);
+    for (const auto &match : matches) {
+        QVERIFY(match.message);
+        QCOMPARE(match.message->attribute(QStringLiteral("request_id")).toString(),
+                 QStringLiteral("id-3"));
+    }
+}
+
+void TestTermIndex::testSearchWithAndWithoutIndex()
+{
+    const auto logPath = m_tempDir->filePath("prefix.log");
+
+    {
+        auto sink = RotatingFileSink(logPath, 400, 0, RotatingFileSink::TermIndex);
+        sink.setTimeIndexInterval(40, 3600 * 1000);
+
+        // The category is only in the formatted line, not in the message
+        for (int i = 0; i < 200; ++i) {
+            auto lmsg = createLogMessage(QStringLiteral("request %1").arg(i),
+                                         m_baseTime.addSecs(i));
+            const auto category = i % 4 == 0 ? QStringLiteral("app.net") : QStringLiteral("app.db");
+            lmsg.setFormattedMessage(QStringLiteral("[%1] %2").arg(category, lmsg.message()));
+            sink.send(lmsg);
+        }
+    }
+
+    auto dir = QDir(m_tempDir->path());
+    const auto indexes = dir.entryList({ QStringLiteral("prefix.*.log.tix") }, QDir::Files);
+    QVERIFY(!indexes.isEmpty());
+
+    LogSearch::Query query;
+    query.terms = QStringList { QStringLiteral("app.net") };
+
+    const auto lines = [&query, &logPath] {
+        QStringList result;
+        const auto matches = LogSearch(logPath).search(query);
+        for (const auto &match : matches) {
+            result.append(match.line);
+        }
+        return result;
+    };
+
+    const auto indexed = lines();
+    QCOMPARE(static_cast<int>(indexed.size()), 50);
+
+    for (const auto &index : indexes) {
+        QVERIFY(QFile::remove(dir.filePath(index)));
+    }
+
+    QCOMPARE(lines(), indexed);
+}
+
+QTEST_MAIN(TestTermIndex)
+#include "test_termindex.moc"
@@ -0,0 +1,335 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "qtlogger/logmessage.h"
+#include "qtlogger/sinks/rotatingfilesink.h"
+#include "qtlogger/timeindex.h"
+
+using namespace QtLogger;
+
+class TestTimeIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    // Writer tests
+    void testEntriesByBytes();
+    void testEntriesByTime();
+    void testNonDecreasingTimes();
+    void testContinueAfterReopen();
+    void testIndexRotatedAndRemoved();
+
+    // Reader tests
+    void testFilesOrder();
+    void testSeekAcrossRotatedFiles();
+    void testSeekBeforeStart();
+    void testSeekWithoutActiveIndex();
+    void testReadWithoutSeek();
+
+private:
+    LogMessage createLogMessage(const QString &message, const QDateTime &time);
+    QByteArray readFile(const QString &path);
+
+    QTemporaryDir *m_tempDir = nullptr;
+    QDateTime m_baseTime;
+};
+
+void TestTimeIndex::init()
+{
+    m_tempDir = new QTemporaryDir();
+    QVERIFY(m_tempDir->isValid());
+    m_baseTime = QDateTime::currentDateTime().addSecs(-3600);
+}
+
+void TestTimeIndex::cleanup()
+{
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+LogMessage TestTimeIndex::createLogMessage(const QString &message, const QDateTime &time)
+{
+    QMessageLogContext context("test.cpp", 42, "testFunction", "test.category");
+    auto lmsg = LogMessage(QtDebugMsg, context, message, time);
+    lmsg.setFormattedMessage(message);
+    return lmsg;
+}
+
+QByteArray TestTimeIndex::readFile(const QString &path)
+{
+    auto file = QFile(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    return file.readAll();
+}
+
+void TestTimeIndex::testEntriesByBytes()
+{
+    auto logPath = m_tempDir->filePath("bytes.log");
+
+    {
+        auto sink = RotatingFileSink(logPath, 0, 5, RotatingFileSink::TimeIndex);
+        sink.setTimeIndexInterval(100, 3600 * 1000);
+
+        for (int i = 0; i < 50; ++i) {
+            const auto message =
+                    QStringLiteral("Message number %1").arg(i, 3, 10, QLatin1Char('0'));
+            sink.send(createLogMessage(message, m_baseTime));
+        }
+        sink.flush();
+    }
+
+    const auto entries = TimeIndex::readEntries(TimeIndex::indexFileName(logPath));
+    const auto content = readFile(logPath);
+
+    QVERIFY(entries.size() > 5);
+    QCOMPARE(entries.first().offset, qint64(0));
+    QCOMPARE(entries.first().time, m_baseTime.toMSecsSinceEpoch());
+
+    for (int i = 1; i < entries.size(); ++i) {
+        QVERIFY(entries.at(i).offset - entries.at(i - 1).offset >= 100);
+        // Every entry points at the start of a message
+        QCOMPARE(content.at(static_cast<int>(entries.at(i).offset) - 1), '\n');
+    }
+}
+
+void TestTimeIndex::testEntriesByTime()
+{
+    auto logPath = m_tempDir->filePath("time.log");
+
+    {
+        auto sink = RotatingFileSink(logPath, 0, 5, RotatingFileSink::TimeIndex);
+        sink.setTimeIndexInterval(1024 * 1024, 1000);
+
+        for (int i = 0; i < 20; ++i) {
+            sink.send(createLogMessage(QStringLiteral("Message"), m_baseTime.addMSecs(i * 250)));
+        }
+    }
+
+    const auto entries = TimeIndex::readEntries(TimeIndex::indexFileName(logPath));
+
+    QCOMPARE(entries.size(), 5);
+    for (int i = 0; i < entries.size(); ++i) {
+        QCOMPARE(entries.at(i).time, m_baseTime.addMSecs(i * 1000).toMSecsSinceEpoch());
+    }
+}
+
+void TestTimeIndex::testNonDecreasingTimes()
+{
+    auto logPath = m_tempDir->filePath("order.log");
+
+    {
+        auto sink = RotatingFileSink(logPath, 0, 5, RotatingFileSink::TimeIndex);
+        sink.setTimeIndexInterval(1, 3600 * 1000);
+
+        const int offsets[] = { 0, 2000, 1000, 3000, 500, 4000 };
+        for (const auto offset : offsets) {
+            sink.send(createLogMessage(QStringLiteral("Message"), m_baseTime.addMSecs(offset)));
+        }
+    }
+
+    const auto entries = TimeIndex::readEntries(TimeIndex::indexFileName(logPath));
+
+    QCOMPARE(entries.size(), 6);
+    for (int i = 1; i < entries.size(); ++i) {
+        QVERIFY(entries.at(i).time >= entries.at(i - 1).time);
+    }
+    QCOMPARE(entries.at(2).time, m_baseTime.addMSecs(2000).toMSecsSinceEpoch());
+}
+
+void TestTimeIndex::testContinueAfterReopen()
+{
+    auto logPath = m_tempDir->filePath("reopen.log");
+    qint64 firstRunSize = 0;
+
+    for (int run = 0; run < 2; ++run) {
+        {
+            auto sink = RotatingFileSink(logPath, 0, 5, RotatingFileSink::TimeIndex);
+            sink.setTimeIndexInterval(1, 3600 * 1000);
+
+            for (int i = 0; i < 3; ++i) {
+                sink.send(createLogMessage(QStringLiteral("Message"),
+                                           m_baseTime.addSecs(run * 10 + i)));
+            }
+        }
+
+        if (run == 0)
+            firstRunSize = QFileInfo(logPath).size();
+    }
+
+    const auto entries = TimeIndex::readEntries(TimeIndex::indexFileName(logPath));
+
+    QCOMPARE(entries.size(), 6);
+    QCOMPARE(entries.first().offset, qint64(0));
+    QCOMPARE(entries.at(3).offset, firstRunSize);
+    QCOMPARE(entries.last().time, m_baseTime.addSecs(12).toMSecsSinceEpoch());
+}
+
+void TestTimeIndex::testIndexRotatedAndRemoved()
+{
+    auto logPath = m_tempDir->filePath("rotated.log");
+
+    {
+        auto sink = RotatingFileSink(logPath, 100, 3, RotatingFileSink::TimeIndex);
+
+        for (int i = 0; i < 40; ++i) {
+            sink.send(createLogMessage(QStringLiteral("Message number %1").arg(i),
+                                       m_baseTime.addSecs(i)));
+        }
+    }
+
+    auto dir = QDir(m_tempDir->path());
+    const auto logs = dir.entryList({ QStringLiteral("rotated*.log") }, QDir::Files);
+    const auto indexes = dir.entryList({ QStringLiteral("rotated*.log.idx") }, QDir::Files);
+
+    QCOMPARE(logs.size(), 3);
+    QCOMPARE(indexes.size(), logs.size());
+
+    for (const auto &log : logs) {
+        const auto entries = TimeIndex::readEntries(TimeIndex::indexFileName(dir.filePath(log)));
+        QVERIFY(!entries.isEmpty());
+        QCOMPARE(entries.first().offset, qint64(0));
+    }
+}
+
+void TestTimeIndex::testFilesOrder()
+{
+    auto logPath = m_tempDir->filePath("app.log");
+
+    const char *names[] = { "app.log", "app.2024-05-15.10.log", "app.2024-05-15.2.log",
+                            "app.2024-05-14.1.log", "app.2024-05-13.1.log.gz",
+                            "app.2024-05-15.2.log.idx", "other.2024-05-15.1.log" };
+    for (const auto name : names) {
+        auto file = QFile(m_tempDir->filePath(QString::fromLatin1(name)));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+
+    auto reader = TimeIndexReader(logPath);
+    const auto files = reader.files();
+
+    QCOMPARE(files.size(), 4);
+    QCOMPARE(QFileInfo(files.at(0)).fileName(), QStringLiteral("app.2024-05-14.1.log"));
+    QCOMPARE(QFileInfo(files.at(1)).fileName(), QStringLiteral("app.2024-05-15.2.log"));
+    QCOMPARE(QFileInfo(files.at(2)).fileName(), QStringLiteral("app.2024-05-15.10.log"));
+    QCOMPARE(QFileInfo(files.at(3)).fileName(), QStringLiteral("app.log"));
+}
+
+void TestTimeIndex::testSeekAcrossRotatedFiles()
+{
+    auto logPath = m_tempDir->filePath("seek.log");
+
+    {
+        auto sink = RotatingFileSink(logPath, 200, 0, RotatingFileSink::TimeIndex);
+        sink.setTimeIndexInterval(40, 3600 * 1000);
+
+        for (int i = 0; i < 100; ++i) {
+            sink.send(createLogMessage(QStringLiteral("msg %1").arg(i, 3, 10, QLatin1Char('0')),
+                                       m_baseTime.addSecs(i)));
+        }
+    }
+
+    auto reader = TimeIndexReader(logPath);
+    QVERIFY(reader.files().size() > 3);
+
+    QVERIFY(reader.seek(m_baseTime.addSecs(57)));
+    QVERIFY(reader.fileName() != reader.files().first());
+
+    // Reading starts shortly before the time and continues to the active file
+    auto first = -1;
+    auto expected = -1;
+    while (!reader.atEnd()) {
+        const auto line = reader.readLine().trimmed();
+        QVERIFY(line.startsWith("msg "));
+        const auto number = line.mid(4).toInt();
+
+        if (first < 0) {
+            first = number;
+            expected = number;
+        }
+        QCOMPARE(number, expected);
+        ++expected;
+    }
+
+    QVERIFY(first <= 57);
+    QVERIFY(first > 50);
+    QCOMPARE(expected, 100);
+}
+
+void TestTimeIndex::testSeekBeforeStart()
+{
+    auto logPath = m_tempDir->filePath("early.log");
+
+    {
+        auto sink = RotatingFileSink(logPath, 100, 0, RotatingFileSink::TimeIndex);
+        for (int i = 0; i < 20; ++i) {
+            sink.send(createLogMessage(QStringLiteral("msg %1").arg(i), m_baseTime.addSecs(i)));
+        }
+    }
+
+    auto reader = TimeIndexReader(logPath);
+    QVERIFY(reader.seek(m_baseTime.addSecs(-10)));
+    QCOMPARE(reader.fileName(), reader.files().first());
+    QCOMPARE(reader.offset(), qint64(0));
+    QCOMPARE(reader.readLine().trimmed(), QByteArray("msg 0"));
+}
+
+void TestTimeIndex::testSeekWithoutActiveIndex()
+{
+    auto logPath = m_tempDir->filePath("unindexed.log");
+
+    {
+        auto sink = RotatingFileSink(logPath, 200, 0, RotatingFileSink::TimeIndex);
+        sink.setTimeIndexInterval(40, 3600 * 1000);
+
+        for (int i = 0; i < 100; ++i) {
+            sink.send(createLogMessage(QStringLiteral("msg %1").arg(i, 3, 10, QLatin1Char('0')),
+                                       m_baseTime.addSecs(i)));
+        }
+    }
+
+    // The active file can't be placed, the time is found in the rotated files
+    QVERIFY(QFile::remove(TimeIndex::indexFileName(logPath)));
+
+    auto reader = TimeIndexReader(logPath);
+    QVERIFY(reader.seek(m_baseTime.addSecs(57)));
+    QVERIFY(reader.fileName() != logPath);
+
+    const auto first = reader.readLine().trimmed().mid(4).toInt();
+    QVERIFY(first <= 57);
+    QVERIFY(first > 50);
+
+    // Before all entries, everything is read
+    QVERIFY(reader.seek(m_baseTime.addSecs(-10)));
+    QCOMPARE(reader.fileName(), reader.files().first());
+    QCOMPARE(reader.offset(), qint64(0));
+}
+
+void TestTimeIndex::testReadWithoutSeek()
+{
+    auto logPath = m_tempDir->filePath("plain.log");
+
+    {
+        auto file = QFile(logPath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write("first\nsecond\n");
+    }
+
+    auto reader = TimeIndexReader(logPath);
+
+    QCOMPARE(reader.readLine(), QByteArray("first\n"));
+    QCOMPARE(reader.readLine(), QByteArray("second\n"));
+    QVERIFY(reader.atEnd());
+    QVERIFY(reader.readLine().isEmpty());
+}
+
+QTEST_MAIN(TestTimeIndex)
+#include "test_timeindex.moc"
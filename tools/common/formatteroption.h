@@ -0,0 +1,26 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <qtlogger/qtlogger.h>
+
+namespace QtLogger {
+
+// Formatter of the --format option of the tools: default, pretty, json, logfmt or a message pattern
+inline FormatterPtr createFormatter(const QString &format,
+                                    const QString &defaultPattern =
+                                            QString::fromUtf8(DefaultMessagePattern))
+{
+    if (format == QLatin1String("json"))
+        return JsonFormatterPtr::create(/* compact */ true);
+    if (format == QLatin1String("logfmt"))
+        return LogfmtFormatterPtr::create(/* withCallsite */ true);
+    if (format == QLatin1String("pretty"))
+        return PrettyFormatterPtr::create();
+    if (format == QLatin1String("default"))
+        return PatternFormatterPtr::create(defaultPattern);
+    return PatternFormatterPtr::create(format);
+}
+
+} // namespace QtLogger
@@ -94,6 +94,7 @@ def main():
         file.write("// #define QTLOGGER_ANDROIDLOG\n")
         file.write("// #define QTLOGGER_SYSLOG\n")
         file.write("// #define QTLOGGER_JOURNAL\n")
+        file.write("// #define QTLOGGER_SQL\n")
         file.write("\n")
         file.write("#define QTLOGGER_DECL_SPEC inline\n")
         file.write(result_code)
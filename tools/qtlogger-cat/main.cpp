@@ -0,0 +1,109 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// qtlogger-cat - prints binary logs written by BinaryFileSink using any QtLogger formatter
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QThread>
+
+#include <iostream>
+
+#include <qtlogger/qtlogger.h>
+
+#include "formatteroption.h"
+
+using namespace QtLogger;
+
+#ifndef QT_NO_SHAREDMEMORY
+// Follows the ring buffer of a SharedMemorySink until the process is terminated
+static int followSharedMemory(const QString &key, const FormatterPtr &formatter)
+{
+    SharedMemoryReader reader(key);
+    if (!reader.isValid()) {
+        std::cerr << qPrintable(key) << ": " << qPrintable(reader.errorString()) << std::endl;
+        return 1;
+    }
+
+    quint64 overruns = 0;
+
+    while (true) {
+        auto lmsg = reader.next();
+        if (!lmsg) {
+            std::cout.flush();
+            QThread::msleep(10);
+            continue;
+        }
+
+        if (reader.overruns() != overruns) {
+            std::cerr << qPrintable(key) << ": " << reader.overruns() - overruns
+                      << " messages lost" << std::endl;
+            overruns = reader.overruns();
+        }
+
+        std::cout << formatter->format(*lmsg).toUtf8().constData() << '\n';
+    }
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("qtlogger-cat"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Decodes QtLogger binary log files."));
+    parser.addHelpOption();
+    parser.addOption({ { QStringLiteral("f"), QStringLiteral("format") },
+                       QStringLiteral("Output format: pretty, json, logfmt, default or a message pattern."),
+                       QStringLiteral("format"), QStringLiteral("pretty") });
+#ifndef QT_NO_SHAREDMEMORY
+    parser.addOption({ QStringLiteral("shm"),
+                       QStringLiteral("Follow the ring buffer of a SharedMemorySink instead of reading files."),
+                       QStringLiteral("key") });
+#endif
+    parser.addPositionalArgument(QStringLiteral("files"), QStringLiteral("Binary log files."),
+                                 QStringLiteral("files..."));
+    parser.process(app);
+
+    const auto formatter = createFormatter(parser.value(QStringLiteral("format")));
+
+#ifndef QT_NO_SHAREDMEMORY
+    if (parser.isSet(QStringLiteral("shm"))) {
+        return followSharedMemory(parser.value(QStringLiteral("shm")), formatter);
+    }
+#endif
+
+    const auto files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    int result = 0;
+
+    for (const auto &path : files) {
+        BinaryLogReader reader(path);
+        if (!reader.isValid()) {
+            std::cerr << qPrintable(path) << ": " << qPrintable(reader.errorString()) << std::endl;
+            result = 1;
+            continue;
+        }
+
+        while (auto lmsg = reader.next()) {
+            std::cout << formatter->format(*lmsg).toUtf8().constData() << '\n';
+        }
+
+        if (!reader.isValid()) {
+            std::cerr << qPrintable(path) << ": " << qPrintable(reader.errorString()) << std::endl;
+            result = 1;
+        } else if (reader.damagedFrames() > 0) {
+            std::cerr << qPrintable(path) << ": " << reader.damagedFrames()
+                      << " damaged frames skipped" << std::endl;
+            result = 1;
+        }
+    }
+
+    std::cout.flush();
+
+    return result;
+}
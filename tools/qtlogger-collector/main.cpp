@@ -0,0 +1,94 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// qtlogger-collector - receives messages from the LocalSocketSinks of many processes and writes
+// them through a single set of sinks
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include <iostream>
+
+#include <qtlogger/qtlogger.h>
+
+#include "formatteroption.h"
+
+using namespace QtLogger;
+
+constexpr char CollectorMessagePattern[] = "%{time yyyy-MM-dd hh:mm:ss.zzz} "
+                                           "%{appname}[%{pid}] %{type} "
+                                           "%{if-category}[%{category}] %{endif}"
+                                           "%{message}";
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("qtlogger-collector"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+            QStringLiteral("Collects messages of QtLogger LocalSocketSinks into one log."));
+    parser.addHelpOption();
+    parser.addOption({ { QStringLiteral("n"), QStringLiteral("name") },
+                       QStringLiteral("Local server name or socket path."),
+                       QStringLiteral("name"), QStringLiteral("qtlogger") });
+    parser.addOption({ { QStringLiteral("c"), QStringLiteral("config") },
+                       QStringLiteral("INI file with the [logger] settings of the output pipeline."),
+                       QStringLiteral("file") });
+    parser.addOption({ { QStringLiteral("f"), QStringLiteral("format") },
+                       QStringLiteral("Output format: default, pretty, json, logfmt or a message pattern."),
+                       QStringLiteral("format"), QStringLiteral("default") });
+    parser.addOption({ QStringLiteral("binary"),
+                       QStringLiteral("Write a binary log, see qtlogger-cat.") });
+    parser.addOption({ QStringLiteral("max-file-size"),
+                       QStringLiteral("Rotate the output file at this size in bytes."),
+                       QStringLiteral("bytes"),
+                       QString::number(RotatingFileSink::DefaultMaxFileSize) });
+    parser.addOption({ QStringLiteral("max-file-count"),
+                       QStringLiteral("Number of rotated files to keep."), QStringLiteral("count"),
+                       QString::number(RotatingFileSink::DefaultMaxFileCount) });
+    parser.addOption({ QStringLiteral("compress"),
+                       QStringLiteral("Compress rotated files with gzip.") });
+    parser.addPositionalArgument(QStringLiteral("output"),
+                                 QStringLiteral("Output file, stdout if not set."),
+                                 QStringLiteral("[output]"));
+    parser.process(app);
+
+    LogCollector collector;
+    auto &pipeline = collector.pipeline();
+
+    if (parser.isSet(QStringLiteral("config"))) {
+        configureFromIniFile(&pipeline, parser.value(QStringLiteral("config")));
+    } else {
+        const auto output = parser.positionalArguments().value(0);
+
+        RotatingFileSink::Options options = RotatingFileSink::Option::None;
+        if (parser.isSet(QStringLiteral("compress")))
+            options |= RotatingFileSink::Compression;
+
+        const auto maxFileSize = parser.value(QStringLiteral("max-file-size")).toInt();
+        const auto maxFileCount = parser.value(QStringLiteral("max-file-count")).toInt();
+
+        if (parser.isSet(QStringLiteral("binary"))) {
+            if (output.isEmpty()) {
+                std::cerr << "qtlogger-collector: --binary requires an output file" << std::endl;
+                return 1;
+            }
+            pipeline.sendToBinaryFile(output, maxFileSize, maxFileCount, options);
+        } else {
+            pipeline << createFormatter(parser.value(QStringLiteral("format")),
+                                        QString::fromUtf8(CollectorMessagePattern));
+            if (output.isEmpty())
+                pipeline.sendToStdOut();
+            else
+                pipeline.sendToFile(output, maxFileSize, maxFileCount, options);
+        }
+    }
+
+    if (!collector.listen(parser.value(QStringLiteral("name")))) {
+        std::cerr << "qtlogger-collector: " << qPrintable(collector.errorString()) << std::endl;
+        return 1;
+    }
+
+    return app.exec();
+}
@@ -0,0 +1,154 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// qtlogger-grep - searches a log and its rotated, compressed files in parallel
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include <iostream>
+
+#include <qtlogger/qtlogger.h>
+
+#include "formatteroption.h"
+
+using namespace QtLogger;
+
+static bool parseTime(const QString &value, QDateTime *time)
+{
+    if (value.isEmpty())
+        return true;
+
+    *time = QDateTime::fromString(value, Qt::ISODateWithMs);
+    if (!time->isValid())
+        *time = QDateTime::fromString(value, Qt::ISODate);
+
+    return time->isValid();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("qtlogger-grep"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+            QStringLiteral("Searches a log file and its rotated and compressed files."));
+    parser.addHelpOption();
+    parser.addOption({ QStringLiteral("from"),
+                       QStringLiteral("Messages at or after the time (ISO 8601)."),
+                       QStringLiteral("time") });
+    parser.addOption({ QStringLiteral("to"),
+                       QStringLiteral("Messages at or before the time (ISO 8601)."),
+                       QStringLiteral("time") });
+    parser.addOption({ { QStringLiteral("l"), QStringLiteral("level") },
+                       QStringLiteral("Minimum level of binary log messages: debug, info, warning, critical or fatal. Text logs can't be searched by level."),
+                       QStringLiteral("level") });
+    parser.addOption({ { QStringLiteral("c"), QStringLiteral("category") },
+                       QStringLiteral("Category of binary log messages, '*' matches any characters. Text logs can't be searched by category."),
+                       QStringLiteral("category") });
+    parser.addOption({ { QStringLiteral("e"), QStringLiteral("regexp") },
+                       QStringLiteral("Regular expression the message must match."),
+                       QStringLiteral("pattern") });
+    parser.addOption({ { QStringLiteral("t"), QStringLiteral("term") },
+                       QStringLiteral("Term the message must contain as a word or attribute value, looked up in the term indexes. Can be repeated."),
+                       QStringLiteral("term") });
+    parser.addOption({ { QStringLiteral("i"), QStringLiteral("ignore-case") },
+                       QStringLiteral("Ignore case of the text and the regular expression.") });
+    parser.addOption({ { QStringLiteral("j"), QStringLiteral("jobs") },
+                       QStringLiteral("Number of threads, all cores by default."),
+                       QStringLiteral("count"), QStringLiteral("0") });
+    parser.addOption({ { QStringLiteral("f"), QStringLiteral("format") },
+                       QStringLiteral("Output format of binary log messages: pretty, json, logfmt, default or a message pattern."),
+                       QStringLiteral("format"), QStringLiteral("pretty") });
+    parser.addOption({ { QStringLiteral("H"), QStringLiteral("with-filename") },
+                       QStringLiteral("Print the file name of each match.") });
+    parser.addPositionalArgument(QStringLiteral("log"),
+                                 QStringLiteral("Path of the active log file of the sink."));
+    parser.addPositionalArgument(QStringLiteral("text"),
+                                 QStringLiteral("Text the message must contain."),
+                                 QStringLiteral("[text]"));
+    parser.process(app);
+
+    const auto arguments = parser.positionalArguments();
+    if (arguments.isEmpty() || arguments.size() > 2) {
+        parser.showHelp(1);
+    }
+
+    LogSearch::Query query;
+
+    if (!parseTime(parser.value(QStringLiteral("from")), &query.from)
+        || !parseTime(parser.value(QStringLiteral("to")), &query.to)) {
+        std::cerr << "qtlogger-grep: invalid time" << std::endl;
+        return 2;
+    }
+
+    if (parser.isSet(QStringLiteral("level"))) {
+        const auto level = parser.value(QStringLiteral("level")).toLower();
+        if (qtMsgTypeToString(stringToQtMsgType(level), QString()) != level) {
+            std::cerr << "qtlogger-grep: invalid level " << qPrintable(level) << std::endl;
+            return 2;
+        }
+        query.minLevel = stringToQtMsgType(level);
+    }
+
+    query.category = parser.value(QStringLiteral("category"));
+
+    if (parser.isSet(QStringLiteral("ignore-case")))
+        query.caseSensitivity = Qt::CaseInsensitive;
+
+    if (arguments.size() > 1)
+        query.text = arguments.at(1);
+
+    query.terms = parser.values(QStringLiteral("term"));
+
+    if (parser.isSet(QStringLiteral("regexp"))) {
+        query.regex = QRegularExpression(parser.value(QStringLiteral("regexp")),
+                                         query.caseSensitivity == Qt::CaseInsensitive
+                                                 ? QRegularExpression::CaseInsensitiveOption
+                                                 : QRegularExpression::NoPatternOption);
+        if (!query.regex.isValid()) {
+            std::cerr << "qtlogger-grep: " << qPrintable(query.regex.errorString()) << std::endl;
+            return 2;
+        }
+    }
+
+    const auto formatter = createFormatter(parser.value(QStringLiteral("format")));
+    const auto withFileName = parser.isSet(QStringLiteral("with-filename"));
+
+    LogSearch search(arguments.first());
+    search.setMaxThreadCount(parser.value(QStringLiteral("jobs")).toInt());
+
+    if (search.files().isEmpty()) {
+        std::cerr << qPrintable(arguments.first()) << ": no log files" << std::endl;
+        return 2;
+    }
+
+    bool found = false;
+
+    search.search(query, [&](const LogSearch::Match &match) {
+        found = true;
+
+        if (withFileName)
+            std::cout << qPrintable(match.fileName) << ':';
+
+        const auto text = match.message ? formatter->format(*match.message) : match.line;
+        std::cout << text.toUtf8().constData() << '\n';
+    });
+
+    std::cout.flush();
+
+    for (const auto &warning : search.warnings()) {
+        std::cerr << qPrintable(warning) << std::endl;
+    }
+
+    for (const auto &error : search.errors()) {
+        std::cerr << qPrintable(error) << std::endl;
+    }
+
+    // Exit codes of grep
+    if (!search.errors().isEmpty())
+        return 2;
+
+    return found ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+// Copyright (C) 2026 Mikhail Yatsenko <mikhail.yatsenko@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// qtlogger-replay - replays a recorded workload into a logger configuration and measures it
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <qtlogger/qtlogger.h>
+
+using namespace QtLogger;
+
+static std::string formatDuration(qint64 nsecs)
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+
+    if (nsecs < 1000)
+        out << nsecs << " ns";
+    else if (nsecs < 1000000)
+        out << static_cast<double>(nsecs) / 1e3 << " us";
+    else if (nsecs < 1000000000)
+        out << static_cast<double>(nsecs) / 1e6 << " ms";
+    else
+        out << static_cast<double>(nsecs) / 1e9 << " s";
+
+    return out.str();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("qtlogger-replay"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+            QStringLiteral("Replays a workload recorded by RecordingSink into a logger "
+                           "configuration and reports throughput and latency."));
+    parser.addHelpOption();
+    parser.addOption({ { QStringLiteral("c"), QStringLiteral("config") },
+                       QStringLiteral("INI file with the logger configuration, the default configuration if not set."),
+                       QStringLiteral("file") });
+    parser.addOption({ { QStringLiteral("g"), QStringLiteral("group") },
+                       QStringLiteral("Group of the logger configuration in the INI file."),
+                       QStringLiteral("group"), QStringLiteral("logger") });
+    parser.addOption({ { QStringLiteral("p"), QStringLiteral("paced") },
+                       QStringLiteral("Send the messages at the recorded intervals instead of as fast as possible.") });
+    parser.addOption({ { QStringLiteral("s"), QStringLiteral("speed") },
+                       QStringLiteral("Factor for the recorded intervals, e.g. 2 replays twice as fast."),
+                       QStringLiteral("factor"), QStringLiteral("1") });
+    parser.addPositionalArgument(QStringLiteral("recording"),
+                                 QStringLiteral("Recording or binary log file."));
+    parser.process(app);
+
+    const auto args = parser.positionalArguments();
+    if (args.size() != 1) {
+        parser.showHelp(1);
+    }
+
+    const auto &path = args.first();
+
+    LogReplay replay(path);
+    if (!replay.isValid()) {
+        std::cerr << qPrintable(path) << ": " << qPrintable(replay.errorString()) << std::endl;
+        if (replay.count() == 0)
+            return 1;
+    }
+
+    auto ok = false;
+    const auto speed = parser.value(QStringLiteral("speed")).toDouble(&ok);
+    if (!ok || speed <= 0) {
+        std::cerr << "Invalid speed: " << qPrintable(parser.value(QStringLiteral("speed")))
+                  << std::endl;
+        return 1;
+    }
+
+    replay.setPacing(parser.isSet(QStringLiteral("paced")) ? LogReplay::Pacing::Original
+                                                           : LogReplay::Pacing::Fast);
+    replay.setSpeed(speed);
+
+    Logger logger;
+    if (parser.isSet(QStringLiteral("config"))) {
+        logger.configureFromIniFile(parser.value(QStringLiteral("config")),
+                                    parser.value(QStringLiteral("group")));
+    } else {
+        logger.configure();
+    }
+
+    const auto stats = replay.run(logger);
+
+    auto drain = qint64(0);
+#ifndef QTLOGGER_NO_THREAD
+    // The messages queued to the own thread of the logger are processed before it stops
+    if (logger.ownThreadIsRunning()) {
+        QElapsedTimer timer;
+        timer.start();
+        logger.resetOwnThread();
+        drain = timer.nsecsElapsed();
+    }
+#endif
+
+    std::cout << "recording:  " << qPrintable(path) << ", " << replay.count() << " messages in "
+              << formatDuration(replay.duration() * 1000000) << '\n'
+              << "pacing:     "
+              << (replay.pacing() == LogReplay::Pacing::Original ? "original" : "fast");
+    if (replay.pacing() == LogReplay::Pacing::Original)
+        std::cout << " x" << speed;
+    std::cout << '\n'
+              << "elapsed:    " << formatDuration(stats.elapsed) << '\n'
+              << "throughput: " << std::fixed << std::setprecision(0) << stats.throughput
+              << " msg/s\n"
+              << "latency:    min " << formatDuration(stats.minLatency) << ", mean "
+              << formatDuration(stats.meanLatency) << ", p50 " << formatDuration(stats.p50Latency)
+              << ", p90 " << formatDuration(stats.p90Latency) << ", p99 "
+              << formatDuration(stats.p99Latency) << ", p99.9 "
+              << formatDuration(stats.p999Latency) << ", max " << formatDuration(stats.maxLatency)
+              << '\n';
+    if (drain > 0) {
+        std::cout << "drain:      " << formatDuration(drain) << " (own thread, "
+                  << std::setprecision(0)
+                  << static_cast<double>(stats.count) * 1e9 / static_cast<double>(stats.elapsed + drain)
+                  << " msg/s overall)\n";
+    }
+    std::cout.flush();
+
+    return 0;
+}